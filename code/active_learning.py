@@ -0,0 +1,750 @@
+# -*- coding: utf-8 -*-
+
+"""
+Batched and resumable active learning of the first Laplace eigenvalue on
+triangles.
+
+Instead of computing the eigenvalue of every generated triangle, the
+eigenvalues are computed only for the triangles on which the current surrogate
+model is the least certain.  Each round of the loop:
+    1.  fits an ensemble of polynomial models (of the same form as the models
+        "models/polynomial_4.gz" and "models/polynomial_5.gz", i. e. linear
+        regressions of the inverse of the eigenvalue on the polynomial terms of
+        the coordinates of the second vertex) on bootstrap resamples of the
+        triangles labelled so far,
+    2.  scores the triangles of the candidate pool which are not labelled yet
+        by the disagreement of the ensemble (the standard deviation of the
+        predicted eigenvalues relative to their mean),
+    3.  selects the k triangles with the largest scores (skipping triangles
+        closer than a given distance to the triangles already selected in the
+        round so that a batch does not collapse to a single region),
+    4.  computes their eigenvalues by the function `label` from
+        "eigen_runner.py",
+    5.  evaluates the ensemble fitted on all labelled triangles on a held-out
+        set and appends the errors to the history.
+The first round selects k triangles from the pool uniformly randomly.  The
+candidate pool is generated by the program compiled from
+"generators/triangles_generator.c" (triangles with vertices (1 / 2, 0), V_2,
+(-1 / 2, 0), as in the datasets "data/numerical/*").  The saved polynomial
+models may be added to the ensemble as fixed members if Joblib is available.
+
+All files of the loop are kept in a single directory:
+    pool.tsv                candidate pool,
+    round_r/indices.tsv     indices of the triangles of the pool selected in
+                            the r-th round,
+    round_r/coordinates.tsv coordinates of vertices of the selected triangles,
+    round_r/eigenvalues.tsv eigenvalues of the selected triangles,
+    round_r/errors.json     errors on the held-out set after the r-th round,
+    history.csv             errors and numbers of labelled triangles of all
+                            completed rounds,
+    model.npz               coefficients of the last fitted ensemble,
+    state.json              number of completed rounds,
+    .pipeline               stored shards of the eigenvalues (see
+                            "eigen_runner.py").
+Each file is written atomically and the number of completed rounds is updated
+last, so an interrupted loop is resumed by running it again:  files already
+written are reused (the selection is deterministic given the seed) and the
+eigenvalues are resumed from the completed shards.  The labelled set is always
+rebuilt from the completed rounds, so no triangle is labelled twice.
+
+Usage:
+    $ python active_learning.py directory rounds k [--generator generator] \
+          [-m m] [--valid coordinates eigenvalues] [--members members] \
+          [--degrees degrees] [--radius radius] [--seed seed] \
+          [--target target] [--saved] [-P processes] [-s shard] \
+          [--script script] [--freefem freefem]
+where:
+    directory   is the directory of the files of the loop,
+    rounds      is the maximal number of rounds (including the first one),
+    k           is the number of triangles labelled in each round,
+    --generator is the compiled "generators/triangles_generator.c" (default is
+                "bin/triangles_generator"),
+    -m          is the number of discretisation points of the generator
+                (default is 1001),
+    --valid     are the paths to the held-out coordinates and eigenvalues
+                (default is "data/numerical/validation"),
+    --members   is the number of members of the ensemble (default is 8),
+    --degrees   are the degrees of the polynomials of the members, used
+                cyclically (default is 4 and 5),
+    --radius    is the minimal distance between the second vertices of
+                triangles selected in the same round (default is 0),
+    --seed      is the seed of the bootstrap and of the first round (default is
+                0),
+    --target    is the mean absolute percentage error on the held-out set at
+                which the loop stops (default is none),
+    --saved     adds the saved polynomial models to the ensemble,
+    -P          is the number of concurrent processes computing eigenvalues
+                (default is 1),
+    -s          is the number of triangles in a shard (default is 1000),
+    --script    is the FreeFEM++ script (default is "numeric/computer3.edp"),
+    --freefem   is the FreeFEM++ executable (default is "FreeFem++").
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import argparse as _argparse
+import json as _json
+import os as _os
+import subprocess as _subprocess
+
+# Import SciPy packages.
+import numpy as _np
+
+# Import package modules.
+from eigen_runner import SCRIPT as _SCRIPT
+from eigen_runner import label as _label
+
+# Define the default paths.
+ROOT = _os.path.dirname(_os.path.abspath(__file__))
+GENERATOR = _os.path.join(ROOT, 'bin', 'triangles_generator')
+VALID = (
+    _os.path.join(ROOT, 'data', 'numerical', 'validation', 'coordinates.tsv'),
+    _os.path.join(ROOT, 'data', 'numerical', 'validation', 'eigenvalues.tsv')
+)
+SAVED = (
+    _os.path.join(ROOT, 'models', 'polynomial_4.gz'),
+    _os.path.join(ROOT, 'models', 'polynomial_5.gz')
+)
+
+# Define the function to write an array atomically.
+def _save (path, x, fmt = '%.8f'):
+    """
+    Save an array to a text file atomically.
+
+    """
+
+    with open(path + '.tmp', 'w') as f:
+        _np.savetxt(f, x, fmt = fmt, delimiter = '\t')
+    _os.rename(path + '.tmp', path)
+
+# Define the function to read a text file of rows.
+def _load (path, columns):
+    """
+    Load a text file of rows as a 2-dimensional array.
+
+    """
+
+    x = _np.loadtxt(path, dtype = float, ndmin = 2)
+
+    return x.reshape((-1, columns))
+
+# Define the function to create polynomial terms.
+def polynomial_terms (P, degree):
+    """
+    Create the polynomial terms of the coordinates of the second vertices.
+
+    The terms are ordered as in the notebook "Models.ipynb" (x, y, x^2, x y,
+    y^2, x^3, ...), so that the saved polynomial models may be applied to
+    them directly.
+
+    Parameters
+    ==========
+    P : (N, 6) array
+        Coordinates of vertices of triangles.
+
+    degree : int
+        Degree of the polynomial.
+
+    Returns
+    =======
+    (N, (degree + 1) * (degree + 2) / 2 - 1) array
+        Polynomial terms (without the constant term).
+
+    """
+
+    x = P[:, 2]
+    y = P[:, 3]
+
+    return _np.stack(
+        [
+            x ** (k - r) * y ** r
+                for k in range(1, degree + 1)
+                    for r in range(k + 1)
+        ],
+        axis = 1
+    )
+
+# Define the class of ensembles of polynomial models.
+class Ensemble (object):
+    """
+    Ensemble of polynomial models of the first eigenvalue on triangles.
+
+    Each member is a linear regression of the inverse of the eigenvalue on the
+    polynomial terms of the coordinates of the second vertex, fitted by the
+    least squares on a bootstrap resample of the labelled triangles.
+
+    Parameters
+    ==========
+    members : int, optional
+        Number of fitted members (default is 8).
+
+    degrees : tuple of int, optional
+        Degrees of the polynomials of the members, used cyclically (default is
+        (4, 5)).
+
+    saved : list, optional
+        Fixed members with the method `predict` of the inverse of the
+        eigenvalue from the polynomial terms, such as the saved models loaded
+        by Joblib, given as tuples (model, degree) (default is none).
+
+    """
+
+    def __init__ (self, members = 8, degrees = (4, 5), saved = None):
+        # Sanitise the parameters.
+        if not int(members) > 0:
+            raise ValueError('Parameter `members` must be positive.')
+        if not degrees:
+            raise ValueError('Parameter `degrees` must not be empty.')
+
+        # Set the attributes.
+        self.members = int(members)
+        self.degrees = tuple(int(d) for d in degrees)
+        self.saved = list() if saved is None else list(saved)
+        self.coefficients = list()
+
+    def fit (self, P, ev, rng):
+        """
+        Fit the members on bootstrap resamples.
+
+        Triangles with non-finite eigenvalues (failed computations) are
+        ignored.
+
+        Parameters
+        ==========
+        P : (N, 6) array
+            Coordinates of vertices of the labelled triangles.
+
+        ev : (N,) array
+            Eigenvalues of the labelled triangles.
+
+        rng : numpy.random.RandomState
+            Random generator of the resamples.
+
+        Returns
+        =======
+        Ensemble
+            The ensemble itself.
+
+        """
+
+        # Keep only the triangles with finite eigenvalues.
+        ok = _np.isfinite(ev) & (ev > 0.0)
+        P = P[ok]
+        y = 1.0 / ev[ok]
+
+        # Fit the members.
+        self.coefficients = list()
+        for i in range(self.members):
+            degree = self.degrees[i % len(self.degrees)]
+            X = _np.hstack(
+                [_np.ones((P.shape[0], 1)), polynomial_terms(P, degree)]
+            )
+            sample = rng.randint(0, P.shape[0], size = P.shape[0])
+            c = _np.linalg.lstsq(X[sample], y[sample], rcond = None)[0]
+            self.coefficients.append(c)
+
+        # Return the ensemble.
+        return self
+
+    def predict (self, P):
+        """
+        Predict the eigenvalues by all members.
+
+        Parameters
+        ==========
+        P : (N, 6) array
+            Coordinates of vertices of triangles.
+
+        Returns
+        =======
+        (M, N) array
+            Eigenvalues predicted by each of the M members (the fitted members
+            followed by the saved members).
+
+        """
+
+        predictions = list()
+        for c in self.coefficients:
+            degree = int(round((_np.sqrt(8 * c.size + 1) - 3) / 2))
+            predictions.append(
+                c[0] + _np.dot(polynomial_terms(P, degree), c[1:])
+            )
+        for model, degree in self.saved:
+            predictions.append(model.predict(polynomial_terms(P, degree)))
+
+        return 1.0 / _np.array(predictions, dtype = float)
+
+    def score (self, P):
+        """
+        Score triangles by the disagreement of the members.
+
+        Parameters
+        ==========
+        P : (N, 6) array
+            Coordinates of vertices of triangles.
+
+        Returns
+        =======
+        (N,) array
+            Standard deviations of the predicted eigenvalues relative to their
+            means (infinity where any of the predictions is not a positive
+            finite number).
+
+        """
+
+        predictions = self.predict(P)
+        ok = _np.all(_np.isfinite(predictions) & (predictions > 0.0), axis = 0)
+        scores = _np.full(P.shape[0], _np.inf)
+        scores[ok] = (
+            _np.std(predictions[:, ok], axis = 0) /
+                _np.mean(predictions[:, ok], axis = 0)
+        )
+
+        return scores
+
+    def save (self, path):
+        """
+        Save the coefficients of the fitted members to a NumPy archive.
+
+        """
+
+        _np.savez(
+            path,
+            **dict(
+                ('member_{0:d}'.format(i), c)
+                    for i, c in enumerate(self.coefficients)
+            )
+        )
+
+# Define the function to select a batch.
+def select (P, scores, k, radius = 0.0):
+    """
+    Select the triangles with the largest scores.
+
+    A triangle is skipped if its second vertex is closer than `radius` to the
+    second vertex of any triangle already selected.
+
+    Parameters
+    ==========
+    P : (N, 6) array
+        Coordinates of vertices of the candidate triangles.
+
+    scores : (N,) array
+        Scores of the candidate triangles.
+
+    k : int
+        Maximal number of triangles to select.
+
+    radius : float, optional
+        Minimal distance between selected second vertices (default is 0).
+
+    Returns
+    =======
+    (M,) array of int
+        Indices of the selected triangles (M <= k), sorted by the score
+        descendingly.
+
+    """
+
+    order = _np.argsort(-scores, kind = 'mergesort')
+    if not radius > 0.0:
+        return order[:k]
+
+    selected = list()
+    for i in order:
+        if len(selected) >= k:
+            break
+        if selected:
+            d = P[selected, 2:4] - P[i, 2:4]
+            if _np.min(_np.sum(d * d, axis = 1)) < radius * radius:
+                continue
+        selected.append(i)
+
+    return _np.array(selected, dtype = int)
+
+# Define the function to evaluate an ensemble.
+def evaluate (ensemble, P, ev):
+    """
+    Compute the errors of the mean prediction of an ensemble.
+
+    Returns
+    =======
+    dict
+        Mean absolute error ("MAE") and mean absolute percentage error
+        ("MAPE") on the triangles with finite eigenvalues.
+
+    """
+
+    ok = _np.isfinite(ev)
+    predicted = _np.mean(ensemble.predict(P[ok]), axis = 0)
+
+    return {
+        'MAE': float(_np.mean(_np.abs(predicted - ev[ok]))),
+        'MAPE': float(
+            100.0 * _np.mean(_np.abs((predicted - ev[ok]) / ev[ok]))
+        )
+    }
+
+# Define the active learning loop.
+def learn (
+    directory,
+    rounds,
+    k,
+    generator = GENERATOR,
+    m = 1001,
+    valid = VALID,
+    members = 8,
+    degrees = (4, 5),
+    radius = 0.0,
+    seed = 0,
+    target = None,
+    saved = False,
+    processes = 1,
+    shard = 1000,
+    script = _SCRIPT,
+    freefem = 'FreeFem++',
+    verbose = True
+):
+    """
+    Run (or resume) the active learning loop.
+
+    Parameters
+    ==========
+    directory : str
+        Directory of the files of the loop.
+
+    rounds : int
+        Maximal number of rounds (including the first, random, round).
+
+    k : int
+        Number of triangles labelled in each round.
+
+    generator : str, optional
+        Compiled program "generators/triangles_generator.c" (default is
+        "bin/triangles_generator").
+
+    m : int, optional
+        Number of discretisation points of the generator (default is 1001).
+
+    valid : tuple of str, optional
+        Paths to the held-out coordinates and eigenvalues (default is the
+        dataset "data/numerical/validation").
+
+    members : int, optional
+        Number of fitted members of the ensemble (default is 8).
+
+    degrees : tuple of int, optional
+        Degrees of the polynomials of the members (default is (4, 5)).
+
+    radius : float, optional
+        Minimal distance between the second vertices of triangles selected in
+        the same round (default is 0).
+
+    seed : int, optional
+        Seed of the random generators (default is 0).
+
+    target : float, optional
+        Mean absolute percentage error on the held-out set at which the loop
+        stops.  If `None`, all rounds are run (default is `None`).
+
+    saved : bool, optional
+        True if the saved polynomial models should be added to the ensemble,
+        false otherwise (default is false).
+
+    processes : int, optional
+        Number of concurrent processes computing eigenvalues (default is 1).
+
+    shard : int, optional
+        Number of triangles in a shard (default is 1000).
+
+    script : str, optional
+        Path to the FreeFEM++ script (default is "numeric/computer3.edp").
+
+    freefem : str, optional
+        FreeFEM++ executable (default is "FreeFem++").
+
+    verbose : bool, optional
+        True if the progress should be printed, false otherwise (default is
+        true).
+
+    Returns
+    =======
+    list of dict
+        History of the completed rounds (numbers of labelled triangles and
+        errors on the held-out set).
+
+    Raises
+    ======
+    subprocess.CalledProcessError
+        Generating the pool or computing the eigenvalues has failed.  The loop
+        is resumed by calling the function again.
+
+    """
+
+    # Prepare the directory and read the state.
+    if not _os.path.isdir(directory):
+        _os.makedirs(directory)
+    path_state = _os.path.join(directory, 'state.json')
+    state = {'rounds': 0}
+    if _os.path.isfile(path_state):
+        with open(path_state, 'r') as f:
+            state = _json.load(f)
+
+    # Generate the candidate pool if it does not exist.
+    path_pool = _os.path.join(directory, 'pool.tsv')
+    if not _os.path.isfile(path_pool):
+        if verbose:
+            print('Generating the pool.')
+        _subprocess.check_call([generator, str(m), path_pool + '.tmp.tsv'])
+        _os.rename(path_pool + '.tmp.tsv', path_pool)
+    pool = _load(path_pool, 6)
+
+    # Load the held-out set.
+    P_valid = _load(valid[0], 6)
+    ev_valid = _load(valid[1], 1)[:, 0]
+
+    # Load the saved models.
+    fixed = list()
+    if saved:
+        import joblib as _joblib
+        fixed = [(_joblib.load(SAVED[0]), 4), (_joblib.load(SAVED[1]), 5)]
+
+    # Rebuild the labelled set and the history from the completed rounds.
+    labelled = _np.zeros(pool.shape[0], dtype = bool)
+    P = _np.zeros((0, 6), dtype = float)
+    ev = _np.zeros((0, ), dtype = float)
+    history = list()
+    for r in range(state['rounds']):
+        d = _os.path.join(directory, 'round_{0:d}'.format(r))
+        batch = _load(_os.path.join(d, 'indices.tsv'), 1)[:, 0].astype(int)
+        labelled[batch] = True
+        P = _np.vstack([P, _load(_os.path.join(d, 'coordinates.tsv'), 6)])
+        ev = _np.concatenate(
+            [ev, _load(_os.path.join(d, 'eigenvalues.tsv'), 1)[:, 0]]
+        )
+        with open(_os.path.join(d, 'errors.json'), 'r') as f:
+            history.append(_json.load(f))
+
+    # Run the remaining rounds.
+    ensemble = Ensemble(members, degrees, fixed)
+    for r in range(state['rounds'], int(rounds)):
+        # Stop if the target error has been reached.
+        if (
+            target is not None and
+            history and
+            history[-1]['MAPE'] <= float(target)
+        ):
+            break
+
+        # Stop if the pool is exhausted.
+        candidates = _np.flatnonzero(~labelled)
+        if not candidates.size:
+            break
+
+        # Select the batch (uniformly randomly in the first round).
+        d = _os.path.join(directory, 'round_{0:d}'.format(r))
+        if not _os.path.isdir(d):
+            _os.makedirs(d)
+        path_indices = _os.path.join(d, 'indices.tsv')
+        path_coordinates = _os.path.join(d, 'coordinates.tsv')
+        path_eigenvalues = _os.path.join(d, 'eigenvalues.tsv')
+        if not _os.path.isfile(path_indices):
+            rng = _np.random.RandomState([int(seed), r])
+            if r == 0 and not fixed:
+                batch = rng.permutation(candidates)[:int(k)]
+            else:
+                if r:
+                    ensemble.fit(P, ev, rng)
+                batch = candidates[
+                    select(
+                        pool[candidates],
+                        ensemble.score(pool[candidates]),
+                        int(k),
+                        radius
+                    )
+                ]
+            _save(path_coordinates, pool[batch])
+            _save(path_indices, batch, '%d')
+        batch = _load(path_indices, 1)[:, 0].astype(int)
+
+        # Compute the eigenvalues of the batch.
+        if verbose:
+            print(
+                'Round {0:d}: labelling {1:d} triangles.'.format(
+                    r,
+                    batch.size
+                )
+            )
+        if not _os.path.isfile(path_eigenvalues):
+            _label(
+                path_coordinates,
+                path_eigenvalues,
+                processes,
+                shard,
+                _os.path.join(directory, '.pipeline'),
+                script,
+                freefem,
+                verbose = verbose
+            )
+
+        # Add the batch to the labelled set.
+        labelled[batch] = True
+        P = _np.vstack([P, pool[batch]])
+        ev = _np.concatenate([ev, _load(path_eigenvalues, 1)[:, 0]])
+
+        # Fit the ensemble on all labelled triangles and evaluate it.
+        ensemble.fit(P, ev, _np.random.RandomState([int(seed), r, 1]))
+        errors = evaluate(ensemble, P_valid, ev_valid)
+        errors['round'] = r
+        errors['labelled'] = int(P.shape[0])
+        with open(_os.path.join(d, 'errors.json.tmp'), 'w') as f:
+            _json.dump(errors, f)
+        _os.rename(
+            _os.path.join(d, 'errors.json.tmp'),
+            _os.path.join(d, 'errors.json')
+        )
+        history.append(errors)
+        ensemble.save(_os.path.join(directory, 'model.tmp.npz'))
+        _os.rename(
+            _os.path.join(directory, 'model.tmp.npz'),
+            _os.path.join(directory, 'model.npz')
+        )
+        if verbose:
+            print(
+                'Round {round:d}: {labelled:d} labelled, MAE {MAE:.8f}, ' \
+                    'MAPE {MAPE:.4f} %.'.format(**errors)
+            )
+
+        # Write the history and complete the round.
+        with open(_os.path.join(directory, 'history.csv.tmp'), 'w') as f:
+            f.write('round,labelled,MAE,MAPE\n')
+            for h in history:
+                f.write(
+                    '{0:d},{1:d},{2:.8f},{3:.8f}\n'.format(
+                        h['round'],
+                        h['labelled'],
+                        h['MAE'],
+                        h['MAPE']
+                    )
+                )
+        _os.rename(
+            _os.path.join(directory, 'history.csv.tmp'),
+            _os.path.join(directory, 'history.csv')
+        )
+        state['rounds'] = r + 1
+        with open(path_state + '.tmp', 'w') as f:
+            _json.dump(state, f)
+        _os.rename(path_state + '.tmp', path_state)
+
+    # Return the history.
+    return history
+
+# Run the loop from the command line.
+if __name__ == '__main__':
+    parser = _argparse.ArgumentParser(
+        description = 'Active learning of Laplace eigenvalues on triangles.'
+    )
+    parser.add_argument('directory', help = 'directory of the files')
+    parser.add_argument(
+        'rounds',
+        type = int,
+        help = 'maximal number of rounds'
+    )
+    parser.add_argument('k', type = int, help = 'triangles labelled per round')
+    parser.add_argument(
+        '--generator',
+        default = GENERATOR,
+        help = 'compiled triangles generator'
+    )
+    parser.add_argument(
+        '-m',
+        type = int,
+        default = 1001,
+        help = 'number of discretisation points of the generator'
+    )
+    parser.add_argument(
+        '--valid',
+        nargs = 2,
+        default = VALID,
+        help = 'held-out coordinates and eigenvalues'
+    )
+    parser.add_argument(
+        '--members',
+        type = int,
+        default = 8,
+        help = 'number of members of the ensemble'
+    )
+    parser.add_argument(
+        '--degrees',
+        type = int,
+        nargs = '+',
+        default = [4, 5],
+        help = 'degrees of the polynomials of the members'
+    )
+    parser.add_argument(
+        '--radius',
+        type = float,
+        default = 0.0,
+        help = 'minimal distance between selected second vertices'
+    )
+    parser.add_argument(
+        '--seed',
+        type = int,
+        default = 0,
+        help = 'seed of the random generators'
+    )
+    parser.add_argument(
+        '--target',
+        type = float,
+        help = 'mean absolute percentage error at which to stop'
+    )
+    parser.add_argument(
+        '--saved',
+        action = 'store_true',
+        help = 'add the saved polynomial models to the ensemble'
+    )
+    parser.add_argument(
+        '-P',
+        dest = 'processes',
+        type = int,
+        default = 1,
+        help = 'number of concurrent processes'
+    )
+    parser.add_argument(
+        '-s',
+        dest = 'shard',
+        type = int,
+        default = 1000,
+        help = 'number of triangles in a shard'
+    )
+    parser.add_argument(
+        '--script',
+        default = _SCRIPT,
+        help = 'FreeFEM++ script'
+    )
+    parser.add_argument(
+        '--freefem',
+        default = 'FreeFem++',
+        help = 'FreeFEM++ executable'
+    )
+    arguments = parser.parse_args()
+    learn(
+        arguments.directory,
+        arguments.rounds,
+        arguments.k,
+        arguments.generator,
+        arguments.m,
+        arguments.valid,
+        arguments.members,
+        arguments.degrees,
+        arguments.radius,
+        arguments.seed,
+        arguments.target,
+        arguments.saved,
+        arguments.processes,
+        arguments.shard,
+        arguments.script,
+        arguments.freefem
+    )
@@ -0,0 +1,156 @@
+#!/usr/bin/env bash
+
+##  Check the eigenvalues computed by the script "numeric/computer.edp".
+##
+##  This file is part of Davor Penzar's master thesis programing.
+##
+##  Possible usage:
+##     ./benchmarks/computer.sh dir N [tol]
+##  where "dir" is the directory of a dataset of triangles (for instance
+##  "data/numerical/test", containing "coordinates.tsv" and
+##  "eigenvalues.tsv"), "N" is the number of triangles to sample and "tol" is
+##  the tolerance of the script "computer.edp" (default is 1.0e-6).  The script
+##  must be run from the root directory of the code (the directory containing
+##  "include").
+##
+##  Every k-th triangle of the dataset is sampled (k is the number of triangles
+##  divided by "N"), so the sample spans the whole dataset.  The eigenvalues of
+##  the sample are computed by the script "computer.edp" (with a report) and by
+##  the program "numeric/mps_solver.c" (with `MPS_BASIS` basis functions per
+##  vertex, 24 by default), whose eigenvalues are used as the reference.  The
+##  stored labels "eigenvalues.tsv" were computed by the script
+##  "computer3.edp" on a single uniform mesh, so they are only compared (as
+##  upper bounds).  A line
+##      size	failed	max_stored	mean_stored	above	max_ref	exceeding	\
+##      mean_ndof	max_ndof	mean_levels	max_levels	mean_time	max_time
+##  is printed, where size is the number of sampled triangles, failed is the
+##  number of NaN eigenvalues, max_stored and mean_stored are the largest and
+##  the mean relative difference of the stored labels from the computed
+##  eigenvalues, above is the number of computed eigenvalues above the stored
+##  labels by more than "tol" (a finer conforming mesh may not give a larger
+##  eigenvalue), max_ref is the largest relative difference from the reference,
+##  exceeding is the number of eigenvalues whose relative difference from the
+##  reference exceeds "tol", and the rest summarise the columns of the report
+##  (the numbers of degrees of freedom, of meshes and the times).  The script
+##  exits with a non-zero value if any eigenvalue failed or exceeded the
+##  tolerance, if any eigenvalue is above its stored label or if the report is
+##  not complete, so it may be used as a test.
+##
+##  The command running FreeFEM++ is given by the variable `FREEFEM` (default
+##  is "FreeFem++ -nw") and the flags in the variable `FLAGS` are added to the
+##  compilation of the program "mps_solver.c".
+##
+
+# Check the arguments.
+if [ $# -ne 2 ] && [ $# -ne 3 ]
+then
+    echo "Number of arguments must be 2 or 3: dataset directory, number of \
+triangles to sample and (optional) tolerance." >&2
+    exit 1
+fi
+
+# Read the arguments.
+data="$1"
+N="$2"
+tol="${3:-1.0e-6}"
+
+# Create a temporary directory for the program and the files.
+dir=$(mktemp -d)
+
+# Compile the program.
+gcc \
+    -std=c89 \
+    -pedantic-errors \
+    -Wall \
+    -O \
+    $FLAGS \
+    numeric/mps_solver.c \
+    -o "$dir/mps_solver" \
+    -pthread \
+    -lblas \
+    -llapack \
+    -lm \
+    -Iinclude \
+    || { rm -rf "$dir"; exit 1; }
+
+# Sample the triangles and their stored labels.
+total=$(wc -l < "$data/coordinates.tsv")
+step=$(( total > N ? total / N : 1 ))
+awk -v k="$step" -v N="$N" '(NR - 1) % k == 0 && n++ < N' \
+    "$data/coordinates.tsv" > "$dir/coordinates.tsv"
+awk -v k="$step" -v N="$N" '(NR - 1) % k == 0 && n++ < N' \
+    "$data/eigenvalues.tsv" > "$dir/stored.tsv"
+size=$(wc -l < "$dir/coordinates.tsv")
+
+# Compute the eigenvalues.
+${FREEFEM:-FreeFem++ -nw} \
+    numeric/computer.edp \
+    -nv 3 \
+    -tol "$tol" \
+    -report "$dir/report.tsv" \
+    "$dir/coordinates.tsv" \
+    "$dir/computed.tsv" \
+    > /dev/null \
+    || { rm -rf "$dir"; exit 1; }
+"$dir/mps_solver" \
+    "$dir/coordinates.tsv" \
+    "$size" \
+    3 \
+    "${MPS_BASIS:-24}" \
+    "$(nproc)" \
+    "$dir/reference.tsv" \
+    > /dev/null \
+    || { rm -rf "$dir"; exit 1; }
+
+# Print the header.
+echo -e "size\tfailed\tmax_stored\tmean_stored\tabove\tmax_ref\texceeding\t\
+mean_ndof\tmax_ndof\tmean_levels\tmax_levels\tmean_time\tmax_time"
+
+# Compare the eigenvalues and summarise the report.
+paste \
+    "$dir/computed.tsv" \
+    "$dir/stored.tsv" \
+    "$dir/reference.tsv" \
+    "$dir/report.tsv" \
+    | awk -v size="$size" -v tol="$tol" '
+        # Columns:  computed, stored, reference and its indicator, ndof,
+        # levels and time.
+        function abs (x) { return x < 0 ? -x : x }
+        NF == 7 {
+            ++n
+            if (tolower($1) ~ /nan/ || !($5 > 0 && $6 >= 1 && $7 >= 0))
+            {
+                ++failed
+                next
+            }
+            s = abs($2 - $1) / $1
+            r = abs($1 - $3) / $3
+            if (s > ms) ms = s
+            if (r > mr) mr = r
+            if ($1 > $2 * (1.0 + tol)) ++above
+            if (r > tol) ++exceeding
+            if ($5 > md) md = $5
+            if ($6 > ml) ml = $6
+            if ($7 > mt) mt = $7
+            ss += s
+            sd += $5
+            sl += $6
+            st += $7
+            ++m
+        }
+        END {
+            failed += size - n
+            printf "%d\t%d\t%.3e\t%.3e\t%d\t%.3e\t%d\t", \
+                size, failed, ms, m ? ss / m : 0, above, mr, exceeding
+            printf "%.1f\t%d\t%.2f\t%d\t%.6f\t%.6f\n", \
+                m ? sd / m : 0, md, m ? sl / m : 0, ml, m ? st / m : 0, mt
+            exit (failed || above || exceeding) ? 1 : 0
+        }
+    '
+ret=$?
+
+# Remove the temporary directory.
+rm -rf "$dir"
+
+# Exit with the result of the comparison.
+exit $ret
@@ -0,0 +1,150 @@
+#!/usr/bin/env bash
+
+##  Check the error estimates of the script "numeric/extrapolator.edp".
+##
+##  This file is part of Davor Penzar's master thesis programing.
+##
+##  Possible usage:
+##     ./benchmarks/extrapolator.sh dir N
+##  where "dir" is the directory of a dataset of triangles (for instance
+##  "data/numerical/test", containing "coordinates.tsv" and
+##  "eigenvalues.tsv") and "N" is the number of triangles to sample.  The
+##  script must be run from the root directory of the code (the directory
+##  containing "include").
+##
+##  Every k-th triangle of the dataset is sampled as in the script
+##  "computer.sh".  The eigenvalues of the sample are extrapolated by the
+##  script "extrapolator.edp" from 2 and from 3 nested meshes and computed by
+##  the program "numeric/mps_solver.c" (with `MPS_BASIS` basis functions per
+##  vertex, 24 by default) as the reference.  For each number of meshes a line
+##      levels	size	failed	bracketed	max_ratio	max_error	\
+##      min_stored	max_stored
+##  is printed, where size is the number of sampled triangles, failed is the
+##  number of NaN eigenvalues, bracketed is the number of extrapolated
+##  eigenvalues whose estimated error is at least their difference from the
+##  reference, max_ratio is the largest ratio of the difference to the
+##  estimate, max_error is the largest estimated relative error, and
+##  min_stored and max_stored are the smallest and the largest ratio of the
+##  difference of the stored labels from the extrapolated eigenvalues to the
+##  estimate.
+##
+##  The stored labels were computed by the script "computer3.edp" on the first
+##  of the nested meshes, so they must lie outside of the bracket (the ratio
+##  must be greater than 1).  For 2 meshes the ratio is exactly 2^alpha (see
+##  "extrapolator.edp"), between 4 and 16 for triangles, if the first mesh
+##  reproduces the stored label.  The script exits with a non-zero value if
+##  any eigenvalue failed, if any estimate does not bracket the difference
+##  from the reference or if any stored label lies inside the bracket, so it
+##  may be used as a test.
+##
+##  The command running FreeFEM++ is given by the variable `FREEFEM` (default
+##  is "FreeFem++ -nw") and the flags in the variable `FLAGS` are added to the
+##  compilation of the program "mps_solver.c".
+##
+
+# Check the arguments.
+if [ $# -ne 2 ]
+then
+    echo "Number of arguments must be 2: dataset directory and number of \
+triangles to sample." >&2
+    exit 1
+fi
+
+# Read the arguments.
+data="$1"
+N="$2"
+
+# Create a temporary directory for the program and the files.
+dir=$(mktemp -d)
+
+# Compile the program.
+gcc \
+    -std=c89 \
+    -pedantic-errors \
+    -Wall \
+    -O \
+    $FLAGS \
+    numeric/mps_solver.c \
+    -o "$dir/mps_solver" \
+    -pthread \
+    -lblas \
+    -llapack \
+    -lm \
+    -Iinclude \
+    || { rm -rf "$dir"; exit 1; }
+
+# Sample the triangles and their stored labels.
+total=$(wc -l < "$data/coordinates.tsv")
+step=$(( total > N ? total / N : 1 ))
+awk -v k="$step" -v N="$N" '(NR - 1) % k == 0 && n++ < N' \
+    "$data/coordinates.tsv" > "$dir/coordinates.tsv"
+awk -v k="$step" -v N="$N" '(NR - 1) % k == 0 && n++ < N' \
+    "$data/eigenvalues.tsv" > "$dir/stored.tsv"
+size=$(wc -l < "$dir/coordinates.tsv")
+
+# Compute the reference eigenvalues.
+"$dir/mps_solver" \
+    "$dir/coordinates.tsv" \
+    "$size" \
+    3 \
+    "${MPS_BASIS:-24}" \
+    "$(nproc)" \
+    "$dir/reference.tsv" \
+    > /dev/null \
+    || { rm -rf "$dir"; exit 1; }
+
+# Print the header.
+echo -e "levels\tsize\tfailed\tbracketed\tmax_ratio\tmax_error\t\
+min_stored\tmax_stored"
+
+# Extrapolate the eigenvalues and compare them.
+ret=0
+for levels in 2 3
+do
+    ${FREEFEM:-FreeFem++ -nw} \
+        numeric/extrapolator.edp \
+        -nv 3 \
+        -levels "$levels" \
+        "$dir/coordinates.tsv" \
+        "$dir/extrapolated_$levels.tsv" \
+        > /dev/null \
+        || { rm -rf "$dir"; exit 1; }
+    paste \
+        "$dir/extrapolated_$levels.tsv" \
+        "$dir/stored.tsv" \
+        "$dir/reference.tsv" \
+        | awk -v levels="$levels" -v size="$size" '
+            # Columns:  extrapolated, estimate, stored, reference and its
+            # indicator.
+            function abs (x) { return x < 0 ? -x : x }
+            NF == 5 {
+                ++n
+                if (tolower($1 $2) ~ /nan/ || !($2 > 0))
+                {
+                    ++failed
+                    next
+                }
+                r = abs($1 - $4) / $2
+                s = abs($3 - $1) / $2
+                if (r <= 1.0) ++bracketed
+                if (r > mr) mr = r
+                if ($2 / $1 > me) me = $2 / $1
+                if (!m || s < mins) mins = s
+                if (s > maxs) maxs = s
+                ++m
+            }
+            END {
+                failed += size - n
+                printf "%d\t%d\t%d\t%d\t%.3f\t%.3e\t%.3f\t%.3f\n", \
+                    levels, size, failed, bracketed, mr, me, mins, maxs
+                exit (failed || bracketed < size || !(mins > 1.0)) ? 1 : 0
+            }
+        ' \
+        || ret=1
+done
+
+# Remove the temporary directory.
+rm -rf "$dir"
+
+# Exit with the result of the comparisons.
+exit $ret
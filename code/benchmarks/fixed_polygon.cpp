@@ -0,0 +1,312 @@
+/**
+ * Program for comparing the functions for polygons of a compile-time number of
+ * vertices with the runtime functions.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./fixed_polygon N seed
+ * where:
+ *     N    is the number of polygons of each number of vertices and each kind
+ *          (at least 1),
+ *     seed is the seed of the pseudorandom number generator.
+ *
+ * For each number of vertices n from 3 to 8, the program generates N random
+ * polygons (vertices uniformly distributed in the square [-1, 1]^2, so most of
+ * them are self-intersecting) and N near-degenerate polygons (a vertex of a
+ * random polygon is moved to the line through its neighbours, or to one of
+ * them, and perturbed by at most 1e-12 relatively, or not at all).  On each
+ * polygon the templated functions from "fixed_polygon.h" are compared with the
+ * corresponding functions from "polygon.h":
+ *     check<n>                     with check_polygon,
+ *     simplify_check_polygon_fixed with simplify_check_polygon (the answer,
+ *                                  the number of points and the points),
+ *     describe_polygon_fixed       with describe_polygon (all values exactly).
+ * The program prints to the console a line
+ *     n	kind	check	simplify_check	describe
+ * of the numbers of disagreements for each number of vertices and each kind,
+ * followed by the time elapsed.  The program exits with a non-zero value if
+ * there is any disagreement, so it may be used as a test.
+ *
+ * Compile the program as C++14, for instance
+ *     g++ -std=c++14 -pedantic-errors -Wall -O benchmarks/fixed_polygon.cpp \
+ *         -o fixed_polygon -lm -Iinclude
+ * from the root directory of the code (the directory containing "include").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with mathematical constants from "math.h". */
+#define _USE_MATH_DEFINES   1
+
+/* Include standard library headers. */
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+#include "fixed_polygon.h"
+
+/**
+ * Largest number of vertices of the templated functions.
+ *
+ */
+#define FIXED_POLYGON_MAX 8U
+
+/**
+ * Check a polygon by the templated function `check`.
+ *
+ * @param n
+ *     Number of vertices (at least 3 and at most `FIXED_POLYGON_MAX`).
+ *
+ * @param P
+ *     Array of coordinates of the vertices of size 2 `n`.
+ *
+ * @return
+ *     The value of the function `check<n>`.
+ *
+ * @see check
+ *
+ */
+inline bool check_fixed (::size_t n, const real_t* P)
+{
+    switch (n)
+    {
+        case 3U:
+            return check<3U>(P);
+        case 4U:
+            return check<4U>(P);
+        case 5U:
+            return check<5U>(P);
+        case 6U:
+            return check<6U>(P);
+        case 7U:
+            return check<7U>(P);
+        case 8U:
+            return check<8U>(P);
+        default:
+            return check_polygon(n, P);
+    }
+}
+
+/**
+ * Generate a random polygon.
+ *
+ * @param n
+ *     Number of vertices.
+ *
+ * @param degenerate
+ *     Value `true` if the polygon should be near-degenerate; value `false`
+ *     otherwise.
+ *
+ * @param P
+ *     Array of size 2 `n` to store the coordinates of the vertices.
+ *
+ */
+inline void generate (::size_t n, bool degenerate, real_t* P)
+{
+    /* Indices of a vertex and of its neighbours. */
+    ::size_t i = 0U;
+    ::size_t h = 0U;
+    ::size_t j = 0U;
+
+    /* Parameter of the point on the line and the scale of the
+     * perturbation. */
+    real_t t = 0.0;
+    real_t e = 0.0;
+
+    /* Generate the vertices. */
+    for (i = 0U; i < (n << 1U); ++i)
+        P[i] = 2.0 * rrand() - 1.0;
+
+    /* Move a vertex to the line through its neighbours (or to one of them)
+     * and perturb it. */
+    if (degenerate)
+    {
+        i = static_cast< ::size_t>(std::rand()) % n;
+        h = (i + n - 1U) % n;
+        j = (i + 1U) % n;
+        switch (std::rand() % 4)
+        {
+            case 0:
+                t = 0.0;
+                break;
+            case 1:
+                t = 0.5;
+                break;
+            case 2:
+                t = 1.0 + rrand();
+                break;
+            default:
+                t = rrand();
+                break;
+        }
+        e = (std::rand() % 3) ? rpow(10.0, -12.0 - 5.0 * rrand()) : 0.0;
+        P[i << 1U] = P[h << 1U] + t * (P[j << 1U] - P[h << 1U]) + e * rrandn();
+        P[(i << 1U) + 1U] =
+            P[(h << 1U) + 1U] +
+            t * (P[(j << 1U) + 1U] - P[(h << 1U) + 1U]) +
+            e * rrandn();
+    }
+}
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 2: number of polygons and "
+            "seed.";
+
+    /* Error message for the illegal number of polygons. */
+    const char* const err_msg_np = "Number of polygons must be at least 1.";
+
+    /* Names of the kinds of polygons. */
+    const char* const kinds[2U] = { "random", "degenerate" };
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the numbers of disagreements. */
+    const char* const format_row = "%lu\t%s\t%lu\t%lu\t%lu\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of polygons. */
+    ::size_t N = 0U;
+
+    /* Clock ticks. */
+    std::clock_t t0 = 0;
+    std::clock_t t1 = 0;
+
+    /* Polygon and its copies. */
+    real_t P[FIXED_POLYGON_MAX << 1U];
+    real_t Q[FIXED_POLYGON_MAX << 1U];
+    real_t R[FIXED_POLYGON_MAX << 1U];
+
+    /* Descriptions of the polygon by both functions. */
+    real_t D[FIXED_POLYGON_MAX << 2U];
+    real_t E[FIXED_POLYGON_MAX << 2U];
+
+    /* Numbers of points after the simplification. */
+    ::size_t m_q = 0U;
+    ::size_t m_r = 0U;
+
+    /* Answers of the simplification. */
+    bool a_q = false;
+    bool a_r = false;
+
+    /* Numbers of disagreements. */
+    unsigned long c_check = 0UL;
+    unsigned long c_simplify = 0UL;
+    unsigned long c_describe = 0UL;
+    unsigned long total = 0UL;
+
+    /* Iteration indices. */
+    ::size_t n = 0U;
+    ::size_t k = 0U;
+    ::size_t i = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 2, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 3 && argv && argv[1] && argv[2]))
+    {
+        std::fprintf(stderr, format_err_msg, err_msg_argc);
+
+        std::exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of polygons and seed the pseudorandom number
+     * generator. */
+    N = static_cast< ::size_t>(std::atoi(argv[1]));
+    if (!N)
+    {
+        std::fprintf(stderr, format_err_msg, err_msg_np);
+
+        std::exit(EXIT_FAILURE);
+    }
+    std::srand(static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)));
+
+    /* Get the current clock ticks. */
+    t0 = std::clock();
+
+    /* Compare the functions on all numbers of vertices and kinds. */
+    for (n = 3U; n <= FIXED_POLYGON_MAX; ++n)
+        for (k = 0U; k < 2U; ++k)
+        {
+            c_check = 0UL;
+            c_simplify = 0UL;
+            c_describe = 0UL;
+            for (i = 0U; i < N; ++i)
+            {
+                /* Generate the polygon. */
+                generate(n, k ? true : false, P);
+
+                /* Compare the checks. */
+                if (!(check_fixed(n, P) == check_polygon(n, P)))
+                    ++c_check;
+
+                /* Compare the simplifications and the checks. */
+                std::memcpy(Q, P, (n << 1U) * sizeof *Q);
+                std::memcpy(R, P, (n << 1U) * sizeof *R);
+                m_q = n;
+                m_r = n;
+                a_q = simplify_check_polygon_fixed(&m_q, Q);
+                a_r = simplify_check_polygon(&m_r, R);
+                if (
+                    !(
+                        a_q == a_r &&
+                        m_q == m_r &&
+                        !std::memcmp(Q, R, (m_q << 1U) * sizeof *Q)
+                    )
+                )
+                    ++c_simplify;
+
+                /* Compare the descriptions. */
+                std::memset(D, 0, (n << 2U) * sizeof *D);
+                std::memset(E, 0, (n << 2U) * sizeof *E);
+                describe_polygon_fixed(n, P, D, D + n, D + 2U * n, D + 3U * n);
+                describe_polygon(n, P, E, E + n, E + 2U * n, E + 3U * n);
+                if (std::memcmp(D, E, (n << 2U) * sizeof *D))
+                    ++c_describe;
+            }
+
+            /* Print the numbers of disagreements. */
+            std::printf(
+                format_row,
+                static_cast<unsigned long>(n),
+                kinds[k],
+                c_check,
+                c_simplify,
+                c_describe
+            );
+            total += c_check + c_simplify + c_describe;
+        }
+
+    /* Get the current clock ticks. */
+    t1 = std::clock();
+
+    /* Print the time elapsed. */
+    std::printf(
+        format_time,
+        static_cast<double>(t1 - t0) / static_cast<double>(CLOCKS_PER_SEC)
+    );
+
+    /* Return a zero value (exit with a zero value) if there is no
+     * disagreement. */
+    return total ? EXIT_FAILURE : EXIT_SUCCESS;
+}
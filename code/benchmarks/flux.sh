@@ -0,0 +1,246 @@
+#!/usr/bin/env bash
+
+##  Check the moments of the squared flux computed by the script
+##  "numeric/computer.edp".
+##
+##  This file is part of Davor Penzar's master thesis programing.
+##
+##  Possible usage:
+##     ./benchmarks/flux.sh dir N [tol]
+##  where "dir" is the directory of a dataset of triangles (for instance
+##  "data/numerical/test", containing "coordinates.tsv"), "N" is the number of
+##  triangles to sample and "tol" is the tolerance of the relative error of the
+##  moments and of the gradients (default is 1.0e-3).  The script must be run
+##  from the root directory of the code (the directory containing "include").
+##
+##  The script "computer.edp" is run with the option "-flux" on the unit
+##  square and on every k-th triangle of the dataset (sampled as in the script
+##  "computer.sh").  On the unit square the first eigenfunction is
+##  u = 2 sin(pi x) sin(pi y) with the eigenvalue 2 pi^2, so all 8 moments of
+##  its squared flux are pi^2.  On the triangles the gradient of the
+##  eigenvalue with respect to the coordinates of the vertices is computed
+##  from the moments by Hadamard's formula (as by the function
+##  `hadamard_gradient` from "hadamard.h") and compared to the central finite
+##  differences of the eigenvalues computed by the program
+##  "numeric/mps_solver.c" (with `MPS_BASIS` basis functions per vertex, 24 by
+##  default), with the step of 1.0e-3 of the shortest edge.  For each domain a
+##  line
+##      domain	size	failed	max_ev	max_flux	max_rellich
+##  is printed, where size is the number of polygons, failed is the number of
+##  polygons with NaN values, max_ev is the largest relative error of the
+##  eigenvalue of the unit square (0 for the triangles), max_flux is the
+##  largest relative error of the moments of the unit square or of the
+##  gradients of the triangles (relative to the largest component), and
+##  max_rellich is the largest relative error of Rellich's identity
+##      sum_e (M_(e, 0) + M_(e, 1)) (P_e . nu_e) = 2 lambda,
+##  where P_e is the e-th vertex and nu_e is the outer unit normal of the e-th
+##  edge.  The script exits with a non-zero value if any polygon failed or if
+##  any relative error exceeds "tol" (the eigenvalue of the unit square must
+##  be within 1.0e-6), so it may be used as a test.
+##
+##  The command running FreeFEM++ is given by the variable `FREEFEM` (default
+##  is "FreeFem++ -nw") and the flags in the variable `FLAGS` are added to the
+##  compilation of the program "mps_solver.c".
+##
+
+# Check the arguments.
+if [ $# -ne 2 ] && [ $# -ne 3 ]
+then
+    echo "Number of arguments must be 2 or 3: dataset directory, number of \
+triangles to sample and (optional) tolerance." >&2
+    exit 1
+fi
+
+# Read the arguments.
+data="$1"
+N="$2"
+tol="${3:-1.0e-3}"
+
+# Create a temporary directory for the program and the files.
+dir=$(mktemp -d)
+
+# Compile the program.
+gcc \
+    -std=c89 \
+    -pedantic-errors \
+    -Wall \
+    -O \
+    $FLAGS \
+    numeric/mps_solver.c \
+    -o "$dir/mps_solver" \
+    -pthread \
+    -lblas \
+    -llapack \
+    -lm \
+    -Iinclude \
+    || { rm -rf "$dir"; exit 1; }
+
+# Write the unit square and sample the triangles.
+echo -e "0\t0\t1\t0\t1\t1\t0\t1" > "$dir/square.tsv"
+total=$(wc -l < "$data/coordinates.tsv")
+step=$(( total > N ? total / N : 1 ))
+awk -v k="$step" -v N="$N" '(NR - 1) % k == 0 && n++ < N' \
+    "$data/coordinates.tsv" > "$dir/coordinates.tsv"
+size=$(wc -l < "$dir/coordinates.tsv")
+
+# Compute the eigenvalues and the moments.
+${FREEFEM:-FreeFem++ -nw} \
+    numeric/computer.edp \
+    -nv 4 \
+    -flux "$dir/square_flux.tsv" \
+    "$dir/square.tsv" \
+    "$dir/square_ev.tsv" \
+    > /dev/null \
+    || { rm -rf "$dir"; exit 1; }
+${FREEFEM:-FreeFem++ -nw} \
+    numeric/computer.edp \
+    -nv 3 \
+    -flux "$dir/flux.tsv" \
+    "$dir/coordinates.tsv" \
+    "$dir/ev.tsv" \
+    > /dev/null \
+    || { rm -rf "$dir"; exit 1; }
+
+# Perturb each coordinate of each triangle in both directions (12 triangles
+# per triangle) and save the steps.
+awk -v perturbed="$dir/perturbed.tsv" '
+    function dist (x, y) { return sqrt(x * x + y * y) }
+    NF == 6 {
+        h = dist($3 - $1, $4 - $2)
+        if (dist($5 - $3, $6 - $4) < h) h = dist($5 - $3, $6 - $4)
+        if (dist($1 - $5, $2 - $6) < h) h = dist($1 - $5, $2 - $6)
+        h *= 1.0e-3
+        print h
+        for (c = 1; c <= 6; ++c)
+            for (s = 1; s >= -1; s -= 2)
+                for (j = 1; j <= 6; ++j)
+                    printf "%.17g%s", $j + (j == c ? s * h : 0), \
+                        j < 6 ? "\t" : "\n" > perturbed
+    }
+' "$dir/coordinates.tsv" > "$dir/steps.tsv"
+
+# Compute the eigenvalues of the perturbed triangles and their finite
+# differences (6 per triangle).
+"$dir/mps_solver" \
+    "$dir/perturbed.tsv" \
+    $(( 12 * size )) \
+    3 \
+    "${MPS_BASIS:-24}" \
+    "$(nproc)" \
+    "$dir/perturbed_ev.tsv" \
+    > /dev/null \
+    || { rm -rf "$dir"; exit 1; }
+awk '
+    NR == FNR { h[NR] = $1; next }
+    {
+        i = int((FNR - 1) / 12) + 1
+        c = int(((FNR - 1) % 12) / 2) + 1
+        if ((FNR - 1) % 2 == 0)
+            p = $1
+        else
+            printf "%.17g%s", (p - $1) / (2.0 * h[i]), c < 6 ? "\t" : "\n"
+    }
+' "$dir/steps.tsv" "$dir/perturbed_ev.tsv" > "$dir/differences.tsv"
+
+# Print the header.
+echo -e "domain\tsize\tfailed\tmax_ev\tmax_flux\tmax_rellich"
+
+# Compare the moments of the unit square to pi^2 and the gradients of the
+# triangles to the finite differences.  Vertices of a polygon of `nv` vertices
+# are in the columns 1 to 2 `nv`, the eigenvalue is in the column 2 `nv` + 1,
+# the moments are in the columns 2 `nv` + 2 to 4 `nv` + 1 and the finite
+# differences (if any) follow.
+ret=0
+for domain in square triangles
+do
+    if [ "$domain" = square ]
+    then
+        set -- 4 1 "$dir/square.tsv" "$dir/square_ev.tsv" \
+            "$dir/square_flux.tsv"
+    else
+        set -- 3 "$size" "$dir/coordinates.tsv" "$dir/ev.tsv" \
+            "$dir/flux.tsv" "$dir/differences.tsv"
+    fi
+    paste "${@:3}" \
+        | awk \
+            -v domain="$domain" \
+            -v nv="$1" \
+            -v size="$2" \
+            -v tol="$tol" \
+            '
+            function abs (x) { return x < 0 ? -x : x }
+            NF >= 4 * nv + 1 {
+                ++n
+                if (tolower($0) ~ /nan/)
+                {
+                    ++failed
+                    next
+                }
+                pi = atan2(0.0, -1.0)
+                ev = $(2 * nv + 1)
+                if (domain == "square")
+                {
+                    q = abs(ev - 2.0 * pi * pi) / (2.0 * pi * pi)
+                    if (q > mev) mev = q
+                }
+
+                # Compute the gradient by the formula of Hadamard and the sum
+                # of the identity of Rellich.
+                for (k = 1; k <= 2 * nv; ++k)
+                    g[k] = 0.0
+                r = 0.0
+                for (e = 0; e < nv; ++e)
+                {
+                    k = (e + 1) % nv
+                    lx = $(2 * k + 1) - $(2 * e + 1)
+                    ly = $(2 * k + 2) - $(2 * e + 2)
+                    l = sqrt(lx * lx + ly * ly)
+                    nx = ly / l
+                    ny = -lx / l
+                    m0 = $(2 * nv + 2 + 2 * e)
+                    m1 = $(2 * nv + 3 + 2 * e)
+                    g[2 * e + 1] -= m0 * nx
+                    g[2 * e + 2] -= m0 * ny
+                    g[2 * k + 1] -= m1 * nx
+                    g[2 * k + 2] -= m1 * ny
+                    r += (m0 + m1) * ($(2 * e + 1) * nx + $(2 * e + 2) * ny)
+                    if (domain == "square")
+                    {
+                        f = abs(m0 - pi * pi) / (pi * pi)
+                        if (f > mf) mf = f
+                        f = abs(m1 - pi * pi) / (pi * pi)
+                        if (f > mf) mf = f
+                    }
+                }
+                r = abs(r - 2.0 * ev) / (2.0 * ev)
+                if (r > mr) mr = r
+
+                # Compare the gradient to the finite differences.
+                if (domain != "square")
+                {
+                    d = 0.0
+                    a = 0.0
+                    for (k = 1; k <= 2 * nv; ++k)
+                    {
+                        fd = $(4 * nv + 1 + k)
+                        if (abs(g[k] - fd) > d) d = abs(g[k] - fd)
+                        if (abs(fd) > a) a = abs(fd)
+                    }
+                    if (d / a > mf) mf = d / a
+                }
+            }
+            END {
+                failed += size - n
+                printf "%s\t%d\t%d\t%.3e\t%.3e\t%.3e\n", \
+                    domain, size, failed, mev, mf, mr
+                exit (failed || mev > 1.0e-6 || mf > tol || mr > tol) ? 1 : 0
+            }
+        ' \
+        || ret=1
+done
+
+# Remove the temporary directory.
+rm -rf "$dir"
+
+# Exit with the result of the comparisons.
+exit $ret
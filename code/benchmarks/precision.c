@@ -0,0 +1,585 @@
+/**
+ * Program for benchmarking the precision of real numbers.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./precision in N R
+ * where:
+ *     in  is the path to the input file to read the coordinates of vertices of
+ *         triangles,
+ *     N   is the number of triangles to read (at least 1),
+ *     R   is the number of repetitions of the computation (at least 1).
+ *
+ * Each triangle must be formated in the input file as
+ *     x_0	y_0	x_1	y_1	x_2	y_2
+ * where (x_i, y_i) are the coordinates of the i-th vertex.  It is believed that
+ * each input triangle truly represents a triangle ---this is not checked and if
+ * any input triangle does not satisfy this, results may be unexpected.
+ *
+ * The program describes the triangles and computes their characteristic points
+ * (see the `char_triangle` function) in the precision of `real_t` chosen at
+ * compile time (see the macro `_REAL_PRECISION` in "numeric.h").  The
+ * characteristic points are compared to the reference characteristic points
+ * computed from the input coordinates in `long double` without trigonometric
+ * functions.  The program prints to the console:
+ *     precision	size	time	err_x	err_y	tolerance	exceeding
+ * where precision is the name of the type `real_t`, size is its size in
+ * bytes, time is the average time elapsed during a single repetition of the
+ * computation in seconds, err_x and err_y are the maximal absolute errors of
+ * the characteristic points' coordinates, tolerance is the constant
+ * `tolerance` from "numeric.h" and exceeding is the number of triangles whose
+ * characteristic point differs from the reference by more than the tolerance.
+ *
+ * To compare the precisions, compile and run the program using the script
+ * "precision.sh".
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with mathematical constants from "math.h". */
+#define _USE_MATH_DEFINES   1
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "array.h"
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+#include "triangle.h"
+#include "batch.h"
+
+/**
+ * Compute the reference characteristic point of a triangle.
+ *
+ * The characteristic point is computed in `long double` without trigonometric
+ * functions: if U W is the longest edge, U is its end-point shared with the
+ * shortest edge and C is the third vertex, the characteristic point is
+ * (1 / 2 - (C - U) . (W - U) / |W - U|^2, |(W - U) x (C - U)| / |W - U|^2).
+ *
+ * @param T
+ *     Array of coordinates of the vertices of size 6.
+ *
+ * @param x
+ *     Memory location to store the x-coordinate of the characteristic point.
+ *
+ * @param y
+ *     Memory location to store the y-coordinate of the characteristic point.
+ *
+ * @see char_triangle
+ *
+ */
+void reference_char_triangle (const long double* T, long double* x, long double* y)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Squared lengths of edges opposite to the vertices. */
+    long double d[3U];
+
+    /* Indices of the vertices U, W and C. */
+    size_t u;
+    size_t w;
+    size_t c;
+
+    /* Differences in coordinates. */
+    long double dx_w;
+    long double dy_w;
+    long double dx_c;
+    long double dy_c;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Squared lengths of edges opposite to the vertices. */
+    memset(d, 0, 3U * sizeof *d);
+
+    /* Indices of the vertices U, W and C. */
+    u = 0U;
+    w = 0U;
+    c = 0U;
+
+    /* Differences in coordinates. */
+    dx_w = 0.0;
+    dy_w = 0.0;
+    dx_c = 0.0;
+    dy_c = 0.0;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* Compute the squared lengths of edges. */
+    for (i = 0U; i < 3U; ++i)
+        *(d + i) =
+            (
+                *(T + (((i + 2U) % 3U) << 1U)) -
+                *(T + (((i + 1U) % 3U) << 1U))
+            ) *
+            (
+                *(T + (((i + 2U) % 3U) << 1U)) -
+                *(T + (((i + 1U) % 3U) << 1U))
+            ) +
+            (
+                *(T + (((i + 2U) % 3U) << 1U) + 1U) -
+                *(T + (((i + 1U) % 3U) << 1U) + 1U)
+            ) *
+            (
+                *(T + (((i + 2U) % 3U) << 1U) + 1U) -
+                *(T + (((i + 1U) % 3U) << 1U) + 1U)
+            );
+
+    /* The vertex C is opposite to the longest edge and the vertex W is opposite
+     * to the shortest edge. */
+    c = (*d < *(d + 1U)) ? 1U : 0U;
+    if (*(d + c) < *(d + 2U))
+        c = 2U;
+    w = (*(d + (c + 1U) % 3U) < *(d + (c + 2U) % 3U)) ?
+        (c + 1U) % 3U :
+        (c + 2U) % 3U;
+    u = 3U - c - w;
+
+    /* Compute the differences in coordinates. */
+    dx_w = *(T + (w << 1U)) - *(T + (u << 1U));
+    dy_w = *(T + (w << 1U) + 1U) - *(T + (u << 1U) + 1U);
+    dx_c = *(T + (c << 1U)) - *(T + (u << 1U));
+    dy_c = *(T + (c << 1U) + 1U) - *(T + (u << 1U) + 1U);
+
+    /* Compute the coordinates of the characteristic point. */
+    if (*(d + c) == 0.0)
+    {
+        *x = 0.0;
+        *y = 0.0;
+    }
+    else
+    {
+        *x = 0.5 - (dx_c * dx_w + dy_c * dy_w) / *(d + c);
+        *y = (dx_w * dy_c - dy_w * dx_c) / *(d + c);
+        if (*y < 0.0)
+            *y = -*y;
+    }
+}
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Number of clock ticks per second as `double`. */
+    const double clocks_per_sec = (double)(CLOCKS_PER_SEC);
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 3: input file path, number of "
+            "triangles to read and number of repetitions.";
+
+    /* Error message for the illegal number of triangles to read. */
+    const char* const err_msg_npr =
+        "Number of triangles to read must be at least 1.";
+
+    /* Error message for the illegal number of repetitions. */
+    const char* const err_msg_nrep =
+        "Number of repetitions must be at least 1.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for failing to read a number. */
+    const char* const err_msg_rn = "Reading a number failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Mode of the input file to open. */
+    const char* const file_in_open_mode = "rt";
+
+    /* Format string for reading the numbers (in `long double`). */
+    const char* const format_input = " %Lf";
+
+    /* Format string for printing the results. */
+    const char* const format_result = "%s\t%u\t%.9f\t%.3e\t%.3e\t%.3e\t%u\n";
+
+    /* Name of the type `real_t`. */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+    const char* const precision = "float";
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+    const char* const precision = "long double";
+#else
+    const char* const precision = "double";
+#endif /* _REAL_PRECISION */
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Clock ticks. */
+    clock_t t0;
+    clock_t t1;
+
+    /* Number of triangles to read. */
+    size_t N;
+
+    /* Number of repetitions. */
+    size_t R;
+
+    /* Array of the input coordinates and the reference characteristic points
+     * (in `long double`). */
+    long double* T;
+
+    /* Array of the coordinates (in `real_t`) and the batch of the
+     * descriptions and the characteristic points of triangles. */
+    real_t* P;
+
+    /* Pointers to the parts of the batch. */
+    real_t* X;
+    real_t* Y;
+    real_t* dx;
+    real_t* dy;
+    real_t* l;
+    real_t* phi;
+    real_t* x;
+    real_t* y;
+
+    /* Maximal absolute errors of the characteristic points' coordinates. */
+    long double err_x;
+    long double err_y;
+
+    /* Absolute errors of the current characteristic point's coordinates. */
+    long double e_x;
+    long double e_y;
+
+    /* Number of triangles exceeding the tolerance. */
+    size_t exceeding;
+
+    /* Input file. */
+    FILE* in;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Clock ticks. */
+    t0 = 0U;
+    t1 = 0U;
+
+    /* Number of triangles to read. */
+    N = 0U;
+
+    /* Number of repetitions. */
+    R = 0U;
+
+    /* Array of the input coordinates and the reference characteristic
+     * points. */
+    T = (long double*)(NULL);
+
+    /* Array of the coordinates and the batch. */
+    P = (real_t*)(NULL);
+
+    /* Pointers to the parts of the batch. */
+    X = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+    dx = (real_t*)(NULL);
+    dy = (real_t*)(NULL);
+    l = (real_t*)(NULL);
+    phi = (real_t*)(NULL);
+    x = (real_t*)(NULL);
+    y = (real_t*)(NULL);
+
+    /* Maximal absolute errors of the characteristic points' coordinates. */
+    err_x = 0.0;
+    err_y = 0.0;
+
+    /* Absolute errors of the current characteristic point's coordinates. */
+    e_x = 0.0;
+    e_y = 0.0;
+
+    /* Number of triangles exceeding the tolerance. */
+    exceeding = 0U;
+
+    /* Input file. */
+    in = (FILE*)(NULL);
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 3, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 4))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` is a null-pointer or if any of the 4 command line arguments is
+     * a null-pointer, print the error message and exit with a non-zero
+     * value. */
+    if (!(argv && *argv && *(argv + 1U) && *(argv + 2U) && *(argv + 3U)))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of triangles to read and the number of repetitions. */
+    N = (size_t)atoi(*(argv + 2U));
+    R = (size_t)atoi(*(argv + 3U));
+
+    /* If the number of triangles to read is 0, print the error message and exit
+     * with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of repetitions is 0, print the error message and exit with
+     * a non-zero value. */
+    if (!R)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nrep);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory for the input coordinates and the reference
+     * characteristic points. */
+    T = (long double*)malloc((N << 3U) * sizeof *T);
+
+    /* If the memory allocation has failed, print the error message and exit
+     * with a non-zero value. */
+    if (!T)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the input coordinates and the reference characteristic points
+     * to zeros. */
+    memset(T, 0, (N << 3U) * sizeof *T);
+
+    /* Allocate memory for the coordinates and the batch:  6 * `N` coordinates,
+     * 6 * `N` transposed coordinates, 6 * `N` differences in coordinates,
+     * 6 * `N` lengths of edges and outer angles and 2 * `N` coordinates of
+     * characteristic points. */
+    P = (real_t*)malloc(26U * N * sizeof *P);
+
+    /* If the memory allocation has failed, deallocate memory, print the error
+     * message and exit with a non-zero value. */
+    if (!P)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Clear the memory in the input coordinates. */
+        memset(T, 0, (N << 3U) * sizeof *T);
+
+        /* Deallocate memory for the input coordinates. */
+        free(T);
+        T = (long double*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the coordinates and the batch to zeros. */
+    memset(P, 0, 26U * N * sizeof *P);
+
+    /* Set the pointers to the parts of the batch. */
+    X = P + 6U * N;
+    Y = X + 3U * N;
+    dx = Y + 3U * N;
+    dy = dx + 3U * N;
+    l = dy + 3U * N;
+    phi = l + 3U * N;
+    x = phi + 3U * N;
+    y = x + N;
+
+    /* Open the input file. */
+    in = fopen(*(argv + 1U), file_in_open_mode);
+
+    /* If the input file could not be opened, print the error message,
+     * deallocate memory and exit with a non-zero value. */
+    if (!in)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Clear the memory in the coordinates and the batch. */
+        memset(P, 0, 26U * N * sizeof *P);
+
+        /* Deallocate memory for the coordinates and the batch. */
+        free(P);
+        P = (real_t*)(NULL);
+
+        /* Clear the memory in the input coordinates. */
+        memset(T, 0, (N << 3U) * sizeof *T);
+
+        /* Deallocate memory for the input coordinates. */
+        free(T);
+        T = (long double*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Read the input triangles.  If any of the coordinates could not be read,
+     * print the error message, close the input file, deallocate memory and
+     * exit with a non-zero value. */
+    for (i = 0U; i < 6U * N; ++i)
+        if (!(fscanf(in, format_input, T + i) == 1))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_rn);
+
+            /* Close the input file. */
+            fclose(in);
+            in = (FILE*)(NULL);
+
+            /* Clear the memory in the coordinates and the batch. */
+            memset(P, 0, 26U * N * sizeof *P);
+
+            /* Deallocate memory for the coordinates and the batch. */
+            free(P);
+            P = (real_t*)(NULL);
+
+            /* Clear the memory in the input coordinates. */
+            memset(T, 0, (N << 3U) * sizeof *T);
+
+            /* Deallocate memory for the input coordinates. */
+            free(T);
+            T = (long double*)(NULL);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+
+    /* Close the input file. */
+    fclose(in);
+    in = (FILE*)(NULL);
+
+    /* Round the input coordinates to `real_t` and compute the reference
+     * characteristic points. */
+    for (i = 0U; i < N; ++i)
+    {
+        for (j = 0U; j < 6U; ++j)
+            *(P + 6U * i + j) = (real_t)(*(T + 6U * i + j));
+        reference_char_triangle(
+            T + 6U * i,
+            T + 6U * N + (i << 1U),
+            T + 6U * N + (i << 1U) + 1U
+        );
+    }
+
+    /* Get the current clock ticks. */
+    t0 = clock();
+
+    /* Repeat the computation. */
+    for (j = 0U; j < R; ++j)
+    {
+        /* Transpose the coordinates into the batch. */
+        batch_transpose_polygons(3U, N, P, X, Y);
+
+        /* Describe all triangles. */
+        batch_describe_polygon(3U, N, X, Y, dx, dy, l, phi);
+
+        /* Characterise all triangles. */
+        batch_char_triangle(N, l, phi, x, y, false);
+    }
+
+    /* Get the current clock ticks. */
+    t1 = clock();
+
+    /* Compare the characteristic points to the reference characteristic
+     * points. */
+    for (i = 0U; i < N; ++i)
+    {
+        /* Compute the absolute errors. */
+        e_x = (long double)(*(x + i)) - *(T + 6U * N + (i << 1U));
+        e_y = (long double)(*(y + i)) - *(T + 6U * N + (i << 1U) + 1U);
+        if (e_x < 0.0)
+            e_x = -e_x;
+        if (e_y < 0.0)
+            e_y = -e_y;
+
+        /* Update the maximal absolute errors. */
+        if (err_x < e_x)
+            err_x = e_x;
+        if (err_y < e_y)
+            err_y = e_y;
+
+        /* Count the triangle if it exceeds the tolerance. */
+        if (e_x > tolerance || e_y > tolerance)
+            ++exceeding;
+    }
+
+    /* Print the results. */
+    printf(
+        format_result,
+            precision,
+            (unsigned int)(sizeof(real_t)),
+            (double)(t1 - t0) / clocks_per_sec / (double)R,
+            (double)err_x,
+            (double)err_y,
+            (double)tolerance,
+            (unsigned int)exceeding
+    );
+
+    /* Clear the memory in the coordinates and the batch. */
+    memset(P, 0, 26U * N * sizeof *P);
+
+    /* Deallocate memory for the coordinates and the batch. */
+    free(P);
+    P = (real_t*)(NULL);
+    X = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+    dx = (real_t*)(NULL);
+    dy = (real_t*)(NULL);
+    l = (real_t*)(NULL);
+    phi = (real_t*)(NULL);
+    x = (real_t*)(NULL);
+    y = (real_t*)(NULL);
+
+    /* Clear the memory in the input coordinates and the reference
+     * characteristic points. */
+    memset(T, 0, (N << 3U) * sizeof *T);
+
+    /* Deallocate memory for the input coordinates and the reference
+     * characteristic points. */
+    free(T);
+    T = (long double*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+
+##  Compare the precisions of real numbers.
+##
+##  This file is part of Davor Penzar's master thesis programing.
+##
+##  Possible usage:
+##     ./benchmarks/precision.sh in N R
+##  where "in" is the path to the input file of coordinates of vertices of
+##  triangles, "N" is the number of triangles to read and "R" is the number of
+##  repetitions (see "precision.c").  The script must be run from the root
+##  directory of the code (the directory containing "include").
+##
+##  The program "precision.c" is compiled three times with `real_t` being
+##  `float`, `double` and `long double` (by defining the macro
+##  `_REAL_PRECISION`).  The `float` and the `long double` variants are compiled
+##  in C99 so that the mathematical functions for `float` and `long double` are
+##  used (C89 provides them only for `double`).  The flags in the variable
+##  `FLAGS` are added to all compilations (for instance "-O3 -march=native").
+##
+
+# Check the arguments.
+if [ $# -ne 3 ]
+then
+    echo "Number of arguments must be 3: input file path, number of triangles \
+to read and number of repetitions." >&2
+    exit 1
+fi
+
+# Create a temporary directory for the programs.
+dir=$(mktemp -d)
+
+# Compile the programs.
+for precision in "1 -std=c99" "2 -std=c89" "3 -std=c99"
+do
+    set -- $precision "$@"
+    gcc \
+        $2 \
+        -pedantic-errors \
+        -Wall \
+        -O \
+        $FLAGS \
+        -D_REAL_PRECISION=$1 \
+        benchmarks/precision.c \
+        -o "$dir/precision_$1" \
+        -lm \
+        -Iinclude \
+        || { rm -rf "$dir"; exit 1; }
+    shift 2
+done
+
+# Print the header.
+echo -e "precision\tsize\ttime\terr_x\terr_y\ttolerance\texceeding"
+
+# Run the programs.
+for precision in 1 2 3
+do
+    "$dir/precision_$precision" "$@" || { rm -rf "$dir"; exit 1; }
+done
+
+# Remove the temporary directory.
+rm -rf "$dir"
@@ -0,0 +1,317 @@
+/**
+ * Program for testing the numbers of families of bins assigned to the sets.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./split_quotas N seed
+ * where:
+ *     N    is the number of random splits (at least 1),
+ *     seed is the seed of the pseudorandom number generator.
+ *
+ * The program computes the numbers of families of the bins of a split by the
+ * function `split_quotas` from "split.h", as the program compiled from
+ * "preprocessors/splitter.c" does, for the split of 200 families in 20 bins of
+ * 10 families in the proportions 0.7, 0.15 and 0.15 (which must be split into
+ * 140, 30 and 30 families), for the split of 47 families in small bins of
+ * 1, 2, 3, 5, 7, 1, 4, 6, 2, 3, 1, 5, 7 families (which do not divide evenly)
+ * in the same proportions and for N random splits (of at most 50 bins of at
+ * most 20 families in random proportions).  In each split the numbers of
+ * families of each bin must sum to the number of families of the bin and,
+ * after each bin, the total number of families of each set must differ from
+ * its exact proportion by less than 1.  The program prints to the console a
+ * line
+ *     split	bins	families	n_0	n_1	n_2	error
+ * for the first two splits, where n_s is the total number of families of the
+ * s-th set and error is the largest difference from the exact proportions,
+ * followed by the number of failed splits and the time elapsed.  The program
+ * exits with a non-zero value if any split fails, so it may be used as a test.
+ *
+ * Compile the program with the script "compile.sh", for instance
+ *     ./compile.sh benchmarks/split_quotas.c -o split_quotas
+ * from the root directory of the code (the directory containing "include").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with mathematical constants from "math.h". */
+#define _USE_MATH_DEFINES   1
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "split.h"
+
+/**
+ * Largest number of bins of a split.
+ *
+ */
+#define SPLIT_QUOTAS_BINS 50U
+
+/**
+ * Split families of bins and check the numbers of families of the sets.
+ *
+ * @param B
+ *     Number of bins (at most `SPLIT_QUOTAS_BINS`).
+ *
+ * @param m
+ *     Array of the numbers of families of the bins of size at least `B`.
+ *
+ * @param p
+ *     Array of the proportions of the sets of size `SPLIT_SETS`.
+ *
+ * @param T
+ *     Array of size at least `SPLIT_SETS` to store the total numbers of
+ *     families of the sets.
+ *
+ * @param e
+ *     Memory location to store the largest difference of the total numbers
+ *     from the exact proportions after any bin.
+ *
+ * @return
+ *     Value `true` if the split is correct; value `false` otherwise.
+ *
+ * @see split_quotas
+ *
+ */
+bool check_split (
+    size_t B,
+    const size_t* m,
+    const real_t* p,
+    size_t* T,
+    real_t* e
+)
+{
+    /* Numbers of families of a bin and the cumulative numbers. */
+    size_t Q[SPLIT_SETS];
+    size_t C[SPLIT_SETS];
+
+    /* Total number of families and the sum of the numbers of a bin. */
+    size_t M;
+    size_t q;
+
+    /* Difference from the exact proportion. */
+    real_t d;
+
+    /* Indicator of correctness. */
+    bool correct;
+
+    /* Iteration indices. */
+    size_t b;
+    size_t s;
+
+    /* Initialise the variables. */
+    memset(Q, 0, SPLIT_SETS * sizeof *Q);
+    memset(C, 0, SPLIT_SETS * sizeof *C);
+    M = 0U;
+    q = 0U;
+    d = 0.0;
+    correct = true;
+    b = 0U;
+    s = 0U;
+
+    /* Split the bins, sum the numbers of families of the sets and find the
+     * largest difference from the exact proportions after each bin. */
+    memset(T, 0, SPLIT_SETS * sizeof *T);
+    *e = 0.0;
+    for (b = 0U; b < B; ++b)
+    {
+        split_quotas(*(m + b), p, C, Q);
+        M += *(m + b);
+        for (q = 0U, s = 0U; s < SPLIT_SETS; ++s)
+        {
+            q += *(Q + s);
+            *(T + s) += *(Q + s);
+            d = rabs((real_t)(*(T + s)) - (real_t)M * *(p + s));
+            if (d > *e)
+                *e = d;
+        }
+        if (!(q == *(m + b) && *(T + s - 1U) == *(C + s - 1U)))
+            correct = false;
+    }
+    if (!(*e < 1.0))
+        correct = false;
+
+    return correct;
+}
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 2: number of splits and seed.";
+
+    /* Error message for the illegal number of splits. */
+    const char* const err_msg_ns = "Number of splits must be at least 1.";
+
+    /* Numbers of families of the bins of the uneven split. */
+    const size_t uneven[13U] = { 1U, 2U, 3U, 5U, 7U, 1U, 4U, 6U, 2U, 3U, 1U, 5U,
+        7U };
+
+    /* Proportions of the fixed splits. */
+    const real_t proportions[SPLIT_SETS] = { 0.7, 0.15, 0.15 };
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing a split. */
+    const char* const format_split = "%s\t%lu\t%lu\t%lu\t%lu\t%lu\t%.3f\n";
+
+    /* Format string for printing the number of failed splits. */
+    const char* const format_failed = "Failed splits: %lu.\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of random splits. */
+    size_t N;
+
+    /* Clock ticks. */
+    clock_t t0;
+    clock_t t1;
+
+    /* Number of bins and the numbers of families of the bins. */
+    size_t B;
+    size_t m[SPLIT_QUOTAS_BINS];
+
+    /* Proportions of the sets. */
+    real_t p[SPLIT_SETS];
+
+    /* Total numbers of families of the sets and the largest error. */
+    size_t T[SPLIT_SETS];
+    real_t e;
+
+    /* Number of failed splits. */
+    unsigned long failed;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t b;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of random splits. */
+    N = 0U;
+
+    /* Clock ticks. */
+    t0 = 0;
+    t1 = 0;
+
+    /* Bins. */
+    B = 0U;
+    memset(m, 0, SPLIT_QUOTAS_BINS * sizeof *m);
+
+    /* Proportions. */
+    memset(p, 0, SPLIT_SETS * sizeof *p);
+
+    /* Totals and the error. */
+    memset(T, 0, SPLIT_SETS * sizeof *T);
+    e = 0.0;
+
+    /* Number of failed splits. */
+    failed = 0UL;
+
+    /* Iteration indices. */
+    i = 0U;
+    b = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 2, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 3 && argv && *(argv + 1U) && *(argv + 2U)))
+    {
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of splits and seed the pseudorandom number
+     * generator. */
+    N = (size_t)atoi(*(argv + 1U));
+    if (!N)
+    {
+        fprintf(stderr, format_err_msg, err_msg_ns);
+
+        exit(EXIT_FAILURE);
+    }
+    srand((unsigned int)strtoul(*(argv + 2U), (char**)(NULL), 10));
+
+    /* Get the current clock ticks. */
+    t0 = clock();
+
+    /* Check the split of 200 families in 20 bins of 10 families. */
+    B = 20U;
+    for (b = 0U; b < B; ++b)
+        *(m + b) = 10U;
+    if (
+        !(
+            check_split(B, m, proportions, T, &e) &&
+            *T == 140U &&
+            *(T + 1U) == 30U &&
+            *(T + 2U) == 30U
+        )
+    )
+        ++failed;
+    printf(
+        format_split,
+        "even",
+        (unsigned long)B,
+        200UL,
+        (unsigned long)(*T),
+        (unsigned long)(*(T + 1U)),
+        (unsigned long)(*(T + 2U)),
+        (double)e
+    );
+
+    /* Check the split of small bins which do not divide evenly. */
+    if (!check_split(13U, uneven, proportions, T, &e))
+        ++failed;
+    printf(
+        format_split,
+        "uneven",
+        13UL,
+        47UL,
+        (unsigned long)(*T),
+        (unsigned long)(*(T + 1U)),
+        (unsigned long)(*(T + 2U)),
+        (double)e
+    );
+
+    /* Check the random splits. */
+    for (i = 0U; i < N; ++i)
+    {
+        B = 1U + (size_t)rand() % SPLIT_QUOTAS_BINS;
+        for (b = 0U; b < B; ++b)
+            *(m + b) = (size_t)rand() % 21U;
+        *p = rrand();
+        *(p + 1U) = (1.0 - *p) * rrand();
+        *(p + 2U) = 1.0 - *p - *(p + 1U);
+        if (!check_split(B, m, p, T, &e))
+            ++failed;
+    }
+
+    /* Get the current clock ticks. */
+    t1 = clock();
+
+    /* Print the number of failed splits and the time elapsed. */
+    printf(format_failed, failed);
+    printf(format_time, (double)(t1 - t0) / (double)(CLOCKS_PER_SEC));
+
+    /* Return a zero value (exit with a zero value) if no split has failed. */
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,273 @@
+# -*- coding: utf-8 -*-
+
+"""
+Export of the convolutional neural network to a flat table of parameters.
+
+The model "models/convolutional_neural_network.h5" is a Keras `Sequential`
+model of convolutional layers, a flattening and dense layers (created by the
+function `MST_CNN_sequential` from "MST_CNN.py" in the notebook
+"Models.ipynb").  The script exports the shape of the input, the descriptions
+of the layers and their kernels and biases as a single row
+    H	W	C	L	kh_1	kw_1	sh_1	sw_1	p_1	f_1	a_1	...	K_L	b_L
+(see "include/cnn.h"), so that the model is evaluated by the program compiled
+from "numeric/cnn_predictor.c" without Python.  Dense layers are exported as
+convolutional layers:  a dense layer following the flattening as a layer with
+the kernel of the size of its input and no padding, and any other dense layer
+as a 1 x 1 convolutional layer.  The normalisation factor of the images is
+multiplied into the kernel of the first layer.  The weights are read from the
+HDF5 file by H5py, so neither Keras nor TensorFlow are needed.
+
+Usage:
+    $ python cnn_exporter.py model factor out
+where:
+    model  is the path to the Keras model (such as
+           "models/convolutional_neural_network.h5"),
+    factor is the path to the normalisation factor of the images (such as
+           "models/convolutional_neural_network_normalisation_factor.txt"),
+    out    is the path to the output file (a NumPy array of shape (1, m) if it
+           ends with ".npy", a text file otherwise).
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import argparse as _argparse
+import json as _json
+import os as _os
+
+# Import SciPy packages.
+import numpy as _np
+
+# Import H5py.
+import h5py as _h5py
+
+# Define the codes of the activations (as in "include/mlp.h").
+_activations = {'linear': 0, 'relu': 1, 'relu_mult_inv': 2}
+
+# Define the codes of the paddings (as in "include/cnn.h").
+_paddings = {'valid': 0, 'same': 1}
+
+# Define the function to compute the size of the output of a convolution.
+def _output_size (n, k, s, p):
+    """
+    Compute the number of output pixels of a convolution along an axis.
+
+    Parameters
+    ==========
+    n : int
+        Number of input pixels.
+
+    k : int
+        Size of the kernel.
+
+    s : int
+        Stride.
+
+    p : int
+        Code of the padding.
+
+    Returns
+    =======
+    int
+        Number of output pixels.
+
+    """
+
+    return (n + s - 1) // s if p == _paddings['same'] else (n - k) // s + 1
+
+# Define the function to read the layers of a model.
+def layers (path):
+    """
+    Read the layers of a Keras model as convolutional layers.
+
+    Parameters
+    ==========
+    path : str
+        Path to the Keras model saved in the HDF5 format.
+
+    Returns
+    =======
+    shape : tuple of ints
+        Shape (H, W, C) of the input.
+
+    result : list
+        List of tuples `(description, K, b)` of the description
+        `(kh, kw, sh, sw, p, f, a)`, the kernel of shape (kh, kw, C, f) and the
+        bias of each convolutional layer in the order of the model.
+
+    Raises
+    ======
+    ValueError
+        The model has a layer which is not supported (other than an input, a
+        convolutional, a flattening or a dense layer), uses the channels first
+        format, a dilation or an unsupported activation.
+
+    """
+
+    with _h5py.File(path, 'r') as f:
+        # Read the configuration of the model.
+        config = f.attrs['model_config']
+        if isinstance(config, bytes):
+            config = config.decode('utf-8')
+        config = _json.loads(config)['config']
+        if isinstance(config, dict):
+            config = config['layers']
+
+        # Find the shape of the input.
+        shape = None
+        for layer in config:
+            if 'batch_input_shape' in layer['config']:
+                shape = tuple(
+                    int(n) for n in layer['config']['batch_input_shape'][1:]
+                )
+                break
+        if shape is None or not len(shape) == 3:
+            raise ValueError('Input of the model must be an image.')
+        H, W, C = shape
+
+        # Read the layers.
+        weights = f['model_weights']
+        flattened = False
+        result = list()
+        for layer in config:
+            name = layer['config']['name']
+            kind = layer['class_name']
+            if kind == 'InputLayer':
+                continue
+            if layer['config'].get('data_format', 'channels_last') != \
+                    'channels_last':
+                raise ValueError(
+                    'Layer {0:s} does not use the channels last '
+                        'format.'.format(repr(name))
+                )
+            if kind == 'Flatten':
+                flattened = True
+                continue
+            if kind not in ('Conv2D', 'Dense'):
+                raise ValueError(
+                    'Layer {0:s} is not supported.'.format(repr(name))
+                )
+            activation = layer['config']['activation']
+            if activation not in _activations:
+                raise ValueError(
+                    'Activation {0:s} of the layer {1:s} is not '
+                        'supported.'.format(repr(activation), repr(name))
+                )
+            group = weights[name][name]
+            K = _np.array(group['kernel:0'], dtype = float)
+            b = _np.array(group['bias:0'], dtype = float)
+
+            # Describe the layer as a convolutional layer.
+            if kind == 'Conv2D':
+                if tuple(layer['config'].get('dilation_rate', (1, 1))) != \
+                        (1, 1):
+                    raise ValueError(
+                        'Layer {0:s} uses a dilation.'.format(repr(name))
+                    )
+                kh, kw = K.shape[:2]
+                sh, sw = layer['config']['strides']
+                p = _paddings[layer['config']['padding']]
+            elif flattened:
+                kh, kw, sh, sw, p = H, W, 1, 1, _paddings['valid']
+                K = K.reshape((H, W, C, -1))
+            else:
+                kh, kw, sh, sw, p = 1, 1, 1, 1, _paddings['valid']
+                K = K.reshape((1, 1, C, -1))
+            result.append(
+                (
+                    (kh, kw, sh, sw, p, b.size, _activations[activation]),
+                    K,
+                    b
+                )
+            )
+
+            # Compute the shape of the output.
+            H = _output_size(H, kh, sh, p)
+            W = _output_size(W, kw, sw, p)
+            C = b.size
+
+    # Return the shape of the input and the layers.
+    return (shape, result)
+
+# Define the function to export a model.
+def export (path_model, path_factor, path_out):
+    """
+    Export a convolutional neural network to a table of parameters.
+
+    Parameters
+    ==========
+    path_model : str
+        Path to the Keras model.
+
+    path_factor : str
+        Path to the normalisation factor of the images.
+
+    path_out : str
+        Path to the output file.
+
+    Returns
+    =======
+    tuple
+        Shape of the input and the numbers of filters of the layers.
+
+    """
+
+    # Read the layers and the normalisation factor.
+    shape, model = layers(path_model)
+    with open(path_factor, 'rt') as f:
+        factor = float(f.readline().strip())
+
+    # Multiply the normalisation factor into the first kernel.
+    if model:
+        model[0] = (model[0][0], factor * model[0][1], model[0][2])
+
+    # Concatenate the parameters.
+    F = _np.concatenate(
+        [
+            _np.array(
+                list(shape) + [len(model)] +
+                    [v for description, K, b in model for v in description],
+                dtype = float
+            )
+        ] +
+        [_np.concatenate([_np.ravel(K), b]) for description, K, b in model]
+    )
+
+    # Save the parameters atomically.
+    temporary = path_out + '.tmp' + _os.path.splitext(path_out)[1]
+    if path_out.endswith('.npy'):
+        _np.save(temporary, F.reshape((1, -1)))
+    else:
+        _np.savetxt(
+            temporary,
+            F.reshape((1, -1)),
+            fmt = '%.18e',
+            delimiter = '\t'
+        )
+    _os.rename(temporary, path_out)
+
+    # Return the shape of the input and the numbers of filters.
+    return shape + tuple(description[5] for description, K, b in model)
+
+# Export the model from the command line.
+if __name__ == '__main__':
+    parser = _argparse.ArgumentParser(
+        description = 'Export a convolutional neural network to a table of '
+            'parameters.'
+    )
+    parser.add_argument('model', help = 'Keras model')
+    parser.add_argument('factor', help = 'normalisation factor of the images')
+    parser.add_argument('out', help = 'output file of parameters')
+    arguments = parser.parse_args()
+    print(
+        'Input shape and numbers of filters: {0:s}.'.format(
+            ', '.join(
+                str(n) for n in export(
+                    arguments.model,
+                    arguments.factor,
+                    arguments.out
+                )
+            )
+        )
+    )
@@ -22,6 +22,12 @@
 ##      -lm                 --  link mathematical functions (math.h or cmath),
 ##      -Iinclude           --  add "include" directory as directory of headers.
 ##
+##  The type of real numbers is `double` by default.  To use `float` or
+##  `long double`, add the flag "-D_REAL_PRECISION=1" or "-D_REAL_PRECISION=3"
+##  respectively (see "include/numeric.h"), preferably with "-std=c99" so that
+##  the mathematical functions of the chosen precision are used.  Programs
+##  using SVD drivers may not be compiled with `long double`.
+##
 
 # Compile the C code.
 gcc \
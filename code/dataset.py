@@ -0,0 +1,633 @@
+# -*- coding: utf-8 -*-
+
+"""
+Datasets of polygons with derived columns computed on demand.
+
+A dataset is a directory of columns (tables with a single polygon per row),
+such as "data/numerical/test".  Only the columns which cannot be computed (the
+coordinates of vertices and the eigenvalues) need to be stored.  All other
+columns are declared as functions of other columns (for instance, the
+descriptions are computed from the coordinates by the program compiled from
+"preprocessors/descriptor.c") and computed lazily:  when rows of a derived
+column are read for the first time, only the chunks of rows containing them are
+computed and the results are cached as NumPy arrays in the directory ".cache"
+of the dataset.  Cached chunks are named by a hash of everything the values
+depend on (the code of the function or the compiled program, the parameters and
+the hashes of the columns it is computed from) and by the size of the chunks,
+so changing any of these invalidates the cache automatically.  Cached arrays
+are written to unique temporary files and renamed, so several processes may
+share the cache.
+
+Stored columns are read from files "name.npy", "name.pcz" (see
+"include/codec.h") or "name.tsv" in the directory of the dataset, in that
+order of preference.  A text file is parsed only once and then cached as a
+NumPy array as well.  By default, a stored file of a derived column is
+preferred over computing the column so that datasets without stored
+coordinates (such as "data/numerical/train") remain readable.
+
+Example:
+    >>> dataset = Dataset('data/numerical/test', triangle_columns('bin'))
+    >>> df = dataset.frame('sorted_descriptions', 'eigenvalues')
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import hashlib as _hashlib
+import inspect as _inspect
+import os as _os
+import shutil as _shutil
+import six as _six
+import subprocess as _subprocess
+import tempfile as _tempfile
+
+# Import SciPy packages.
+import numpy as _np
+import pandas as _pd
+
+# Import package modules.
+from pcz import read_pcz as _read_pcz
+
+# Define the class of columns of datasets.
+class Column (object):
+    """
+    Column of a dataset.
+
+    Parameters
+    ==========
+    name : str
+        Name of the column (the name of the stored file without the extension
+        and the name of the cached chunks).
+
+    names : list of str
+        Names of the values in each row (the names of columns of dataframes).
+
+    function : callable, optional
+        Function computing a chunk of rows of the column from chunks of the
+        same rows of the columns `depends` (given in that order as positional
+        arguments) and the keyword arguments `parameters`.  If `None`, the
+        column is stored (default is `None`).
+
+    depends : tuple of str, optional
+        Names of the columns from which the column is computed (default is an
+        empty tuple).
+
+    parameters : dict, optional
+        Additional keyword arguments passed to the function `function`.  They
+        must be representable by the `repr` function in a deterministic way
+        since they are hashed (default is no additional arguments).
+
+    """
+
+    def __init__ (
+        self,
+        name,
+        names,
+        function = None,
+        depends = tuple(),
+        parameters = None
+    ):
+        # Sanitise the parameters.
+        if not isinstance(name, _six.string_types):
+            raise TypeError('Parameter `name` must be a string.')
+        if not (function is None or callable(function)):
+            raise TypeError('Parameter `function` must be callable.')
+
+        # Set the attributes.
+        self.name = name
+        self.names = list(names)
+        self.function = function
+        self.depends = tuple(depends)
+        self.parameters = dict() if parameters is None else dict(parameters)
+
+    @property
+    def derived (self):
+        """
+        True if the column is computed from other columns, false otherwise.
+
+        """
+
+        return self.function is not None
+
+# Define the function to hash a file.
+def _hash_file (path):
+    """
+    Compute the SHA-256 hash of the contents of a file.
+
+    """
+
+    h = _hashlib.sha256()
+    with open(path, 'rb') as f:
+        for block in iter(lambda: f.read(1 << 20), b''):
+            h.update(block)
+
+    return h.hexdigest()
+
+# Define the function to create functions running the C programs.
+def program (executable, arguments):
+    """
+    Create a function running a compiled C program on chunks of rows.
+
+    The created function saves its argument (a two-dimensional array) to a
+    temporary NumPy array, runs the program with the arguments `arguments` and
+    returns the NumPy array dumped by the program (see "include/table.h").  The
+    contents of the file `executable` are included in the hash of the derived
+    column, so recompiling the program invalidates the cached chunks.
+
+    Parameters
+    ==========
+    executable : str
+        Path to the compiled program.
+
+    arguments : tuple of str
+        Arguments of the program, in which "{in}", "{N}" and "{out}" are
+        replaced by the path to the input array, by the number of rows and by
+        the path to the output array respectively.
+
+    Returns
+    =======
+    callable
+        Function of a single two-dimensional array returning a two-dimensional
+        array with the same number of rows.
+
+    Examples
+    ========
+    >>> describe = program('bin/describe', ('{in}', '{N}', '3', '{out}'))
+
+    """
+
+    # Define the function running the program.
+    def run (x):
+        # Convert the input to a two-dimensional array.
+        x = _np.ascontiguousarray(x, dtype = float)
+        x = x.reshape((x.shape[0], -1))
+
+        # Run the program in a temporary directory and load the output.
+        directory = _tempfile.mkdtemp()
+        try:
+            path_in = _os.path.join(directory, 'in.npy')
+            path_out = _os.path.join(directory, 'out.npy')
+            _np.save(path_in, x)
+            with open(_os.devnull, 'w') as devnull:
+                _subprocess.check_call(
+                    [executable] + [
+                        a.format(
+                            **{'in': path_in, 'N': x.shape[0], 'out': path_out}
+                        ) for a in arguments
+                    ],
+                    stdout = devnull
+                )
+            y = _np.load(path_out)
+        finally:
+            _shutil.rmtree(directory, ignore_errors = True)
+
+        # Return the output as a two-dimensional array.
+        return y.reshape((x.shape[0], -1))
+
+    # Remember the program and its arguments for hashing.
+    run.executable = executable
+    run.arguments = tuple(arguments)
+
+    # Return the function.
+    return run
+
+# Define the function to create the columns of datasets of triangles.
+def triangle_columns (programs = 'bin'):
+    """
+    Create the columns of datasets of triangles in "data".
+
+    The derived columns are computed by the programs compiled from
+    "preprocessors/descriptor.c", "preprocessors/sorter.c",
+    "preprocessors/svd.c" and "preprocessors/triangles_characteriser.c" (for
+    instance, by running
+        ./compile.sh preprocessors/descriptor.c -o bin/describe
+    and similarly for the others).
+
+    Parameters
+    ==========
+    programs : str, optional
+        Directory of the compiled programs named "describe", "sort", "svd" and
+        "characterise" (default is "bin").
+
+    Returns
+    =======
+    dict
+        Dictionary of columns (instances of the class `Column`) by their names.
+
+    """
+
+    # Define the path to a program.
+    def executable (name):
+        return _os.path.join(programs, name)
+
+    # Create the columns.
+    columns = [
+        Column('coordinates', ['x_0', 'y_0', 'x_1', 'y_1', 'x_2', 'y_2']),
+        Column('eigenvalues', ['l_0']),
+        Column(
+            'descriptions',
+            ['edge_0', 'edge_1', 'edge_2', 'angle_1', 'angle_2', 'angle_0'],
+            program(executable('describe'), ('{in}', '{N}', '3', '{out}')),
+            ('coordinates', )
+        ),
+        Column(
+            'sorted_descriptions',
+            ['a', 'c', 'b', 'alpha', 'gamma', 'beta'],
+            program(executable('sort'), ('{in}', '{N}', '3', '{out}')),
+            ('descriptions', )
+        ),
+        Column(
+            'singular_values',
+            [
+                'sv_edge_0',
+                'sv_edge_1',
+                'sv_edge_2',
+                'sv_angle_0',
+                'sv_angle_1',
+                'sv_angle_2'
+            ],
+            program(executable('svd'), ('{in}', '{N}', '3', '{out}')),
+            ('descriptions', )
+        ),
+        Column(
+            'characteristics',
+            ['x_char', 'y_char'],
+            program(executable('characterise'), ('{in}', '{N}', '{out}')),
+            ('descriptions', )
+        )
+    ]
+
+    # Return the dictionary of columns.
+    return dict((column.name, column) for column in columns)
+
+# Define the class of datasets.
+class Dataset (object):
+    """
+    Dataset of polygons with derived columns computed on demand.
+
+    Parameters
+    ==========
+    directory : str
+        Directory of the stored columns.
+
+    columns : dict
+        Dictionary of columns (instances of the class `Column`) by their names
+        (for instance, the result of the function `triangle_columns`).
+
+    chunk : int, optional
+        Number of rows in a chunk of a derived column computed at once (default
+        is 65536).
+
+    cache : str, optional
+        Directory of the cached chunks (default is ".cache" in the directory
+        `directory`).
+
+    stored : bool, optional
+        True if stored files of derived columns should be read instead of
+        computing the columns, false otherwise (default is true).
+
+    """
+
+    def __init__ (
+        self,
+        directory,
+        columns,
+        chunk = 65536,
+        cache = None,
+        stored = True
+    ):
+        # Sanitise the parameters.
+        chunk = int(chunk)
+        if not (chunk > 0):
+            raise ValueError('Parameter `chunk` must be positive.')
+
+        # Set the attributes.
+        self.directory = directory
+        self.columns = dict(columns)
+        self.chunk = chunk
+        self.cache = (
+            _os.path.join(directory, '.cache') if cache is None else cache
+        )
+        self.stored = bool(stored)
+
+        # Initialise the memoised hashes and the number of rows.
+        self._keys = dict()
+        self._rows = None
+
+    def path (self, name):
+        """
+        Find the stored file of a column.
+
+        Returns
+        =======
+        str or None
+            Path to the stored file of the column if it exists (and should be
+            read), `None` otherwise.
+
+        """
+
+        if self.columns[name].derived and not self.stored:
+            return None
+        for extension in ('.npy', '.pcz', '.tsv'):
+            path = _os.path.join(self.directory, name + extension)
+            if _os.path.isfile(path):
+                return path
+
+        return None
+
+    def key (self, name):
+        """
+        Compute the hash of a column.
+
+        The hash of a stored column depends on the path, the size and the time
+        of the last modification of its file.  The hash of a derived column
+        depends on the code of its function (or the compiled program), its
+        parameters and the hashes of the columns from which it is computed.
+
+        Returns
+        =======
+        str
+            Hexadecimal SHA-256 hash.
+
+        """
+
+        # Return the memoised hash if it exists.
+        if name in self._keys:
+            return self._keys[name]
+
+        # Compute the hash.
+        column = self.columns[name]
+        h = _hashlib.sha256()
+        h.update(name.encode('utf-8'))
+        path = self.path(name)
+        if path is not None:
+            info = _os.stat(path)
+            h.update(
+                repr(
+                    (_os.path.abspath(path), info.st_size, info.st_mtime)
+                ).encode('utf-8')
+            )
+        elif column.derived:
+            function = column.function
+            if hasattr(function, 'executable'):
+                h.update(_hash_file(function.executable).encode('utf-8'))
+                h.update(repr(function.arguments).encode('utf-8'))
+            else:
+                try:
+                    h.update(_inspect.getsource(function).encode('utf-8'))
+                except (TypeError, OSError, IOError):
+                    h.update(
+                        repr(
+                            (
+                                getattr(function, '__module__', None),
+                                getattr(function, '__name__', None)
+                            )
+                        ).encode('utf-8')
+                    )
+            h.update(repr(sorted(column.parameters.items())).encode('utf-8'))
+            for depend in column.depends:
+                h.update(self.key(depend).encode('utf-8'))
+        else:
+            raise IOError(
+                'Stored column `{0:s}` does not exist.'.format(name)
+            )
+
+        # Memoise and return the hash.
+        self._keys[name] = h.hexdigest()
+
+        return self._keys[name]
+
+    def _save (self, path, x):
+        """
+        Save an array to the cache atomically.
+
+        """
+
+        # Save the array to a unique temporary file in the same directory (so
+        # that concurrent writers do not collide) and rename it.
+        if not _os.path.isdir(self.cache):
+            try:
+                _os.makedirs(self.cache)
+            except OSError:
+                if not _os.path.isdir(self.cache):
+                    raise
+        descriptor, temporary = _tempfile.mkstemp(
+            suffix = '.tmp',
+            prefix = '.' + _os.path.basename(path) + '.',
+            dir = self.cache
+        )
+        try:
+            with _os.fdopen(descriptor, 'wb') as f:
+                _np.save(f, x)
+            _os.rename(temporary, path)
+        except BaseException:
+            if _os.path.isfile(temporary):
+                _os.remove(temporary)
+            raise
+
+    def _load (self, name):
+        """
+        Load a stored column (as an array mapped to memory if possible).
+
+        """
+
+        # Load a NumPy array or a compressed table.
+        path = self.path(name)
+        if path is None:
+            raise IOError(
+                'Stored column `{0:s}` does not exist.'.format(name)
+            )
+        if path.endswith('.npy'):
+            x = _np.load(path, mmap_mode = 'r')
+        elif path.endswith('.pcz'):
+            x = _read_pcz(path)
+
+        # Parse a text file only once and cache it as a NumPy array.
+        else:
+            cached = _os.path.join(
+                self.cache,
+                '{0:s}-{1:.16s}.npy'.format(name, self.key(name))
+            )
+            if not _os.path.isfile(cached):
+                self._save(cached, _np.loadtxt(path, dtype = float, ndmin = 2))
+            x = _np.load(cached, mmap_mode = 'r')
+
+        # Return the column as a two-dimensional array.
+        return x.reshape((x.shape[0], -1))
+
+    def __len__ (self):
+        """
+        Find the number of rows (polygons) in the dataset.
+
+        The number of rows is the number of rows of the first stored column
+        found.
+
+        """
+
+        if self._rows is None:
+            for name in sorted(self.columns):
+                if self.path(name) is not None:
+                    self._rows = int(self._load(name).shape[0])
+
+                    break
+            else:
+                raise IOError('No stored column exists.')
+
+        return self._rows
+
+    def _chunk (self, name, c):
+        """
+        Load the `c`-th chunk of a derived column, computing it if needed.
+
+        """
+
+        # Load the cached chunk if it exists and has the expected number of
+        # rows (the name includes the size of the chunks, so chunks of stores
+        # reused with a different size are not mixed up).
+        start = c * self.chunk
+        stop = min(start + self.chunk, len(self))
+        path = _os.path.join(
+            self.cache,
+            '{0:s}-{1:.16s}-{2:d}-{3:d}.npy'.format(
+                name,
+                self.key(name),
+                self.chunk,
+                c
+            )
+        )
+        if _os.path.isfile(path):
+            x = _np.load(path, mmap_mode = 'r')
+            if x.shape[0] == stop - start:
+                return x
+
+        # Compute the chunk from the same rows of the columns it depends on.
+        column = self.columns[name]
+        x = column.function(
+            *[self.read(depend, start, stop) for depend in column.depends],
+            **column.parameters
+        )
+        x = _np.ascontiguousarray(x, dtype = float).reshape((stop - start, -1))
+
+        # Cache and return the chunk.
+        self._save(path, x)
+
+        return x
+
+    def read (self, name, start = 0, stop = None):
+        """
+        Read rows of a column.
+
+        Parameters
+        ==========
+        name : str
+            Name of the column.
+
+        start : int, optional
+            Index of the first row to read (default is 0).
+
+        stop : int, optional
+            Index of the row after the last row to read (default is the number
+            of rows).
+
+        Returns
+        =======
+        ndarray
+            Two-dimensional array of the rows (possibly mapped to memory, it
+            should not be modified).
+
+        """
+
+        # Sanitise the range of rows.
+        n = len(self)
+        stop = n if stop is None else max(0, min(int(stop), n))
+        start = max(0, min(int(start), stop))
+
+        # Read a stored column.
+        if self.path(name) is not None:
+            return self._load(name)[start:stop]
+
+        # Read the chunks of a derived column containing the rows.
+        if not self.columns[name].derived:
+            raise IOError(
+                'Stored column `{0:s}` does not exist.'.format(name)
+            )
+        blocks = list()
+        for c in range(start // self.chunk, -(-stop // self.chunk)):
+            x = self._chunk(name, c)
+            blocks.append(
+                x[
+                    max(start - c * self.chunk, 0):
+                    min(stop - c * self.chunk, x.shape[0])
+                ]
+            )
+
+        # Return the rows.
+        return (
+            _np.concatenate(blocks) if len(blocks) > 1
+                else blocks[0] if blocks
+                else _np.zeros(
+                    (0, len(self.columns[name].names)),
+                    dtype = float
+                )
+        )
+
+    def frame (self, *names):
+        """
+        Read columns as a Pandas dataframe.
+
+        Parameters
+        ==========
+        names
+            Names of the columns to read (in that order).
+
+        Returns
+        =======
+        DataFrame
+            Dataframe of the columns with the values named as in the columns.
+
+        """
+
+        return (
+            _pd.concat(
+                [
+                    _pd.DataFrame(
+                        _np.asarray(self.read(name)),
+                        columns = self.columns[name].names
+                    ) for name in names
+                ],
+                axis = 1
+            ) if names
+                else _pd.DataFrame(_np.zeros((0, 0), dtype = float))
+        )
+
+    def prune (self):
+        """
+        Remove cached arrays which are no longer valid.
+
+        Returns
+        =======
+        int
+            Number of removed files.
+
+        """
+
+        # Find the prefixes of valid cached arrays.
+        prefixes = list()
+        for name in self.columns:
+            try:
+                prefixes.append('{0:s}-{1:.16s}'.format(name, self.key(name)))
+            except (IOError, OSError):
+                pass
+
+        # Remove all other cached arrays.
+        removed = 0
+        if _os.path.isdir(self.cache):
+            for f in _os.listdir(self.cache):
+                if not any(
+                    f == p + '.npy' or f.startswith(p + '-') for p in prefixes
+                ):
+                    _os.remove(_os.path.join(self.cache, f))
+                    removed += 1
+
+        return removed
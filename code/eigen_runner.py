@@ -0,0 +1,621 @@
+# -*- coding: utf-8 -*-
+
+"""
+Shardable and resumable computation of Laplace eigenvalues on polygons.
+
+The input file of polygons is split into shards of a fixed number of polygons
+and the FreeFEM++ script "numeric/computer3.edp" is run on the shards by
+several concurrent processes (see the class `Pipeline` in "pipeline.py").
+Each shard is stored atomically as soon as its eigenvalues are computed, under
+a hash of the contents of the shard, of the script and of the FreeFEM++
+executable.  An interrupted run (or a run in which some shards failed) is thus
+resumed by running it again, and only the shards whose polygons have changed
+are recomputed.  The eigenvalues of all shards are finally merged in the
+original order of the polygons.
+
+Usage:
+    $ python eigen_runner.py in out [-P processes] [-s shard] [--store dir] \
+          [--script script] [--nv nv] [--tol tol] [--levels levels] \
+          [--flux flux] [--sketch sketch] [--quantiles quantiles] \
+          [--log10-quantiles log10_quantiles] [--dedup tol --novel novel] \
+          [--known known] [--deduplicator deduplicator] \
+          [--features-mean features_mean] [--features-std features_std] \
+          [--features c [c ...]] [--describer describer] [--sorter sorter] \
+          [--svd svd]
+where:
+    in       is the path to the input file of polygons (as read by the script),
+    out      is the path to the output file of eigenvalues,
+    -P       is the number of concurrent processes (default is 1),
+    -s       is the number of polygons in a shard (default is 1000),
+    --store  is the directory of the stored shards (default is ".pipeline"),
+    --script is the FreeFEM++ script (default is "numeric/computer3.edp"),
+    --nv     is the number of vertices of polygons (passed to the script),
+    --tol    is the tolerance for the relative error (passed to the script),
+    --levels is the number of nested meshes (passed to the script),
+    --flux   is the path to the output file of boundary fluxes,
+    --sketch is the path to the output file of the sketch of the eigenvalues,
+    --quantiles
+             is the path to the output file of the 5 % quantiles of the
+             eigenvalues,
+    --log10-quantiles
+             is the path to the output file of the 5 % quantiles of the
+             logarithms (to the base 10) of the eigenvalues,
+    --dedup  is the tolerance of near duplicates of polygons,
+    --novel  is the path to the output file of the novel polygons,
+    --known  is the path to the file of already labelled polygons,
+    --deduplicator
+             is the compiled program "preprocessors/deduplicator.c" (default
+             is "bin/dedup"),
+    --features-mean
+             is the path to the output file of the mean of the features,
+    --features-std
+             is the path to the output file of the standard deviation of the
+             features,
+    --features
+             are the indices of the columns of the features (default is all
+             columns),
+    --describer
+             is the compiled program "preprocessors/descriptor.c" (default is
+             "bin/describe"),
+    --sorter is the compiled program "preprocessors/sorter.c" (default is
+             "bin/sort"),
+    --svd    is the compiled program "preprocessors/svd.c" (default is
+             "bin/svd").
+Option `--nv` is read by the scripts "numeric/computer.edp" and
+"numeric/extrapolator.edp", which compute the eigenvalues for polygons with any
+number of vertices on adaptive meshes and by the Richardson extrapolation from
+nested meshes respectively.  Option `--tol` is read only by the former and
+option `--levels` only by the latter (whose output also contains an estimate of
+the error of each eigenvalue).  Option `--flux` is supported only by the
+script "numeric/computer.edp":  the moments of the squared normal derivative
+of the eigenfunction on the edges of each polygon are merged into the given
+file in the same order as the eigenvalues (see "include/hadamard.h").
+
+The eigenvalues of each shard are sketched as soon as they are computed (see
+"sketch.py"), so the quantiles (as "data/arrays/l_quantiles.npy" and
+"data/arrays/l_log10_quantiles.npy") are saved from the merged sketches of the
+shards.  The sketch itself (a ".npz" file) may be saved as well and merged with
+the sketches of other runs by the script "sketch.py".
+
+If option `--features-mean` or `--features-std` is given, the features of the
+polygons are computed by the feature stages of the pipeline (the descriptions,
+the sorted descriptions and the singular values, see "preprocessors/"), which
+are sharded and sketched in the same way as the eigenvalues.  The features are
+the columns of the sorted descriptions followed by the columns of the singular
+values, so the features of the neural network of triangles (as
+"models/neural_network_features_mean.npy" and
+"models/neural_network_features_std.npy", see "numeric/mlp_predictor.c") are
+given by `--features 1 2 3 4 5 6 7 10`.
+
+If option `--dedup` is given, near duplicates of polygons (polygons of nearly
+the same shape as a preceding polygon of the input file or as a polygon of the
+file `--known`) are filtered out before the eigenvalues are computed (see
+"preprocessors/deduplicator.c").  Only the novel polygons are labelled:  they
+are copied to the file `--novel` and the eigenvalues are in their order.  The
+filtering is a stage of the pipeline, so it is not repeated when a run is
+resumed.
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import argparse as _argparse
+import os as _os
+import shutil as _shutil
+
+# Import SciPy packages.
+import numpy as _np
+
+# Import package modules.
+from pipeline import Pipeline as _Pipeline
+from pipeline import Stage as _Stage
+from pcz import read_pcz as _read_pcz
+from sketch import save as _save
+from sketch import table_format as _table_format
+
+# Define the default path to the script.
+SCRIPT = _os.path.join(
+    _os.path.dirname(_os.path.abspath(__file__)),
+    'numeric',
+    'computer3.edp'
+)
+
+# Define the default path to the program filtering out near duplicates.
+DEDUPLICATOR = _os.path.join('bin', 'dedup')
+
+# Define the default paths to the programs computing the features.
+DESCRIBER = _os.path.join('bin', 'describe')
+SORTER = _os.path.join('bin', 'sort')
+SVD = _os.path.join('bin', 'svd')
+
+# Define the function to count the polygons of a table.
+def _shape (path):
+    """
+    Count the polygons of a table and the coordinates of each polygon.
+
+    Parameters
+    ==========
+    path : str
+        Path to the table of polygons, a NumPy array, a compressed table or a
+        text file of a polygon per line (see the function `table_format` in
+        "sketch.py").
+
+    Returns
+    =======
+    tuple
+        Tuple (rows, values) of the number of polygons and of the number of
+        coordinates of each of them.
+
+    Raises
+    ======
+    ValueError
+        The table is not a table of polygons, or it is a text file whose
+        non-empty lines do not all contain the same number of values (the C
+        programs read any layout of whitespaces, but the number of polygons of
+        a text file is counted by its lines).
+
+    """
+
+    # Count the rows and the values of a NumPy array or a compressed table.
+    form = _table_format(path)
+    if form == 'npy':
+        shape = _np.load(path, mmap_mode = 'r').shape
+        rows = shape[0] if shape else 0
+        values = int(_np.prod(shape[1:])) if len(shape) > 1 else 1
+    elif form == 'pcz':
+        rows, values = _read_pcz(path).shape
+
+    # Count the rows and the values of a text file.
+    else:
+        rows = 0
+        values = 0
+        with open(path, 'rb') as f:
+            for line in f:
+                m = len(line.split())
+                if not m:
+                    continue
+                if rows and not (m == values):
+                    raise ValueError(
+                        'File `{0:s}` must contain a polygon per line (line '
+                        'of {1:d} values after lines of {2:d} values).'.format(
+                            path,
+                            m,
+                            values
+                        )
+                    )
+                values = m
+                rows += 1
+
+    # Check the number of coordinates.
+    if rows and not (values >= 6 and not (values & 1)):
+        raise ValueError(
+            'Table `{0:s}` must contain polygons of at least 3 vertices (rows '
+            'of {1:d} values).'.format(path, values)
+        )
+
+    # Return the numbers.
+    return (rows, values)
+
+# Define the function to compute the eigenvalues.
+def label (
+    path_in,
+    path_out,
+    processes = 1,
+    shard = 1000,
+    store = '.pipeline',
+    script = SCRIPT,
+    freefem = 'FreeFem++',
+    options = None,
+    verbose = True,
+    path_flux = None,
+    path_sketch = None,
+    path_quantiles = None,
+    path_log10_quantiles = None,
+    dedup = None,
+    path_novel = None,
+    path_known = None,
+    deduplicator = DEDUPLICATOR,
+    path_features_mean = None,
+    path_features_std = None,
+    features = None,
+    describer = DESCRIBER,
+    sorter = SORTER,
+    svd = SVD
+):
+    """
+    Compute the first Laplace eigenvalues on polygons in shards.
+
+    Parameters
+    ==========
+    path_in : str
+        Path to the input file of polygons (each polygon in its own line).
+
+    path_out : str
+        Path to the output file of eigenvalues (each in its own line, in the
+        order of the polygons).
+
+    processes : int, optional
+        Number of concurrent processes (default is 1).
+
+    shard : int, optional
+        Number of polygons in a shard (default is 1000).
+
+    store : str, optional
+        Directory of the stored shards (default is ".pipeline").
+
+    script : str, optional
+        Path to the FreeFEM++ script (default is "numeric/computer3.edp").
+
+    freefem : str, optional
+        FreeFEM++ executable (default is "FreeFem++").
+
+    options : list of str, optional
+        Additional arguments to the script (such as `['-nv', '5']` for the
+        script "numeric/computer.edp"), given before the paths to the input
+        and the output files.  Default is none.
+
+    verbose : bool, optional
+        True if the progress should be printed, false otherwise (default is
+        true).
+
+    path_flux : str, optional
+        Path to the output file of the moments of the squared boundary flux
+        (each polygon in its own line, in the order of the polygons), exported
+        by the script "numeric/computer.edp".  Default is none (no fluxes are
+        computed).
+
+    path_sketch : str, optional
+        Path to the output file of the sketch of the eigenvalues (see
+        "sketch.py").  Default is none.
+
+    path_quantiles : str, optional
+        Path to the output file of the 5 % quantiles of the eigenvalues (a
+        NumPy array of 21 values from the minimum to the maximum).  Default is
+        none.
+
+    path_log10_quantiles : str, optional
+        Path to the output file of the 5 % quantiles of the logarithms (to the
+        base 10) of the eigenvalues.  Default is none.
+
+    dedup : float, optional
+        Tolerance of near duplicates of polygons (see
+        "preprocessors/deduplicator.c").  If given, only novel polygons are
+        labelled.  Default is none (all polygons are labelled).
+
+    path_novel : str, optional
+        Path to the output file of the novel polygons (in the order of the
+        eigenvalues).  Required if `dedup` is given.
+
+    path_known : str, optional
+        Path to the file of already labelled polygons, whose near duplicates
+        are filtered out as well.  Default is none.
+
+    deduplicator : str, optional
+        Compiled program "preprocessors/deduplicator.c" (default is
+        "bin/dedup").
+
+    path_features_mean : str, optional
+        Path to the output file of the mean of the features (a NumPy array).
+        Default is none.
+
+    path_features_std : str, optional
+        Path to the output file of the standard deviation of the features (a
+        NumPy array).  Default is none.
+
+    features : list of int, optional
+        Indices of the columns of the features among the columns of the sorted
+        descriptions followed by the columns of the singular values (default
+        is all columns).
+
+    describer : str, optional
+        Compiled program "preprocessors/descriptor.c" (default is
+        "bin/describe").
+
+    sorter : str, optional
+        Compiled program "preprocessors/sorter.c" (default is "bin/sort").
+
+    svd : str, optional
+        Compiled program "preprocessors/svd.c" (default is "bin/svd").
+
+    Returns
+    =======
+    str
+        Path to the output file.
+
+    Raises
+    ======
+    subprocess.CalledProcessError
+        Computation on a shard has failed.  All completed shards remain stored
+        and are reused by the next run.
+
+    RuntimeError
+        Computation on a shard has not produced an eigenvalue for each polygon.
+
+    ValueError
+        Parameter `dedup` is given without the parameter `path_novel`, or the
+        polygons (or the already labelled polygons) are not counted because
+        the file is not a NumPy array, a compressed table or a text file of a
+        polygon per line.
+
+    """
+
+    # Define the stage filtering out near duplicates of polygons.
+    stages = list()
+    coordinates = path_in
+    if dedup is not None:
+        if path_novel is None:
+            raise ValueError(
+                'Parameter `path_novel` must be given with `dedup`.'
+            )
+        rows, values = _shape(path_in)
+        command = [
+            deduplicator,
+            '{coordinates}',
+            '{rows}',
+            '{n}',
+            '{tol}',
+            '{K}',
+            '{seed}',
+            '{out}'
+        ]
+        inputs = {'coordinates': path_in}
+        parameters = {
+            'rows': rows,
+            'n': values // 2,
+            'tol': float(dedup),
+            'K': 8,
+            'seed': 0
+        }
+        if path_known is not None:
+            command += ['{known}', '{known_rows}']
+            inputs['known'] = path_known
+            parameters['known_rows'] = _shape(path_known)[0]
+        stages.append(
+            _Stage(
+                'novel',
+                command,
+                inputs = inputs,
+                outputs = {'out': 'coordinates.tsv'},
+                parameters = parameters
+            )
+        )
+        coordinates = ('novel', 'out')
+
+    # Define the stage computing the eigenvalues.
+    executables = [script]
+    if _shutil.which(freefem) is not None:
+        executables.append(_shutil.which(freefem))
+    outputs = {'out': 'eigenvalues.tsv'}
+    if path_flux is not None:
+        outputs['flux'] = 'flux.tsv'
+    stages.append(
+        _Stage(
+            'eigenvalues',
+            [freefem, '-nw', '-v', '0', script] +
+                ([] if options is None else [str(o) for o in options]) +
+                ([] if path_flux is None else ['-flux', '{flux}']) +
+                ['{coordinates}', '{out}'],
+            inputs = {'coordinates': coordinates},
+            outputs = outputs,
+            executables = executables,
+            shard = ('coordinates', shard),
+            sketches = {'out': [0]}
+        )
+    )
+
+    # Define the stages computing the features.
+    sketch_features = not (
+        path_features_mean is None and path_features_std is None
+    )
+    if sketch_features:
+        n = str(_shape(path_in)[1] // 2)
+        for name, program, source, sketches in [
+            ('descriptions', describer, coordinates, None),
+            ('sorted_descriptions', sorter, ('descriptions', 'out'), []),
+            ('singular_values', svd, ('descriptions', 'out'), [])
+        ]:
+            stages.append(
+                _Stage(
+                    name,
+                    [program, '{in}', '{N}', n, '{out}'],
+                    inputs = {'in': source},
+                    outputs = {'out': name + '.tsv'},
+                    shard = ('in', shard),
+                    sketches = None if sketches is None else {'out': sketches}
+                )
+            )
+
+    # Run (or resume) the computation.
+    pipeline = _Pipeline(stages, store, verbose, processes)
+    paths = pipeline.run()
+
+    # Copy the merged eigenvalues (and the novel polygons) to the output files
+    # atomically.
+    _shutil.copyfile(paths['eigenvalues']['out'], path_out + '.tmp')
+    _os.rename(path_out + '.tmp', path_out)
+    if path_flux is not None:
+        _shutil.copyfile(paths['eigenvalues']['flux'], path_flux + '.tmp')
+        _os.rename(path_flux + '.tmp', path_flux)
+    if dedup is not None:
+        _shutil.copyfile(paths['novel']['out'], path_novel + '.tmp')
+        _os.rename(path_novel + '.tmp', path_novel)
+
+    # Save the sketch and the quantiles of the eigenvalues.
+    sketch = pipeline.sketch('eigenvalues')
+    if path_sketch is not None:
+        sketch.save(path_sketch)
+    q = _np.linspace(0.0, 1.0, 21)
+    if path_quantiles is not None:
+        _save(path_quantiles, sketch.quantiles(0, q))
+    if path_log10_quantiles is not None:
+        _save(path_log10_quantiles, _np.log10(sketch.quantiles(0, q)))
+
+    # Save the mean and the standard deviation of the features.
+    if sketch_features:
+        sketches = [
+            pipeline.sketch('sorted_descriptions'),
+            pipeline.sketch('singular_values')
+        ]
+        mean = _np.concatenate([s.mean for s in sketches])
+        std = _np.concatenate([s.std() for s in sketches])
+        if features is not None:
+            mean = mean[[int(c) for c in features]]
+            std = std[[int(c) for c in features]]
+        if path_features_mean is not None:
+            _save(path_features_mean, mean)
+        if path_features_std is not None:
+            _save(path_features_std, std)
+
+    # Return the path to the output file.
+    return path_out
+
+# Run the computation from the command line.
+if __name__ == '__main__':
+    parser = _argparse.ArgumentParser(
+        description = 'Compute Laplace eigenvalues on polygons in shards.'
+    )
+    parser.add_argument('path_in', help = 'input file of polygons')
+    parser.add_argument('path_out', help = 'output file of eigenvalues')
+    parser.add_argument(
+        '-P',
+        dest = 'processes',
+        type = int,
+        default = 1,
+        help = 'number of concurrent processes'
+    )
+    parser.add_argument(
+        '-s',
+        dest = 'shard',
+        type = int,
+        default = 1000,
+        help = 'number of polygons in a shard'
+    )
+    parser.add_argument(
+        '--store',
+        default = '.pipeline',
+        help = 'directory of the stored shards'
+    )
+    parser.add_argument(
+        '--script',
+        default = SCRIPT,
+        help = 'FreeFEM++ script'
+    )
+    parser.add_argument(
+        '--freefem',
+        default = 'FreeFem++',
+        help = 'FreeFEM++ executable'
+    )
+    parser.add_argument(
+        '--nv',
+        type = int,
+        help = 'number of vertices of polygons'
+    )
+    parser.add_argument(
+        '--tol',
+        type = float,
+        help = 'tolerance for the relative error of eigenvalues'
+    )
+    parser.add_argument(
+        '--levels',
+        type = int,
+        help = 'number of nested meshes'
+    )
+    parser.add_argument(
+        '--flux',
+        help = 'output file of boundary fluxes'
+    )
+    parser.add_argument(
+        '--sketch',
+        help = 'output file of the sketch of eigenvalues'
+    )
+    parser.add_argument(
+        '--quantiles',
+        help = 'output file of the quantiles of eigenvalues'
+    )
+    parser.add_argument(
+        '--log10-quantiles',
+        dest = 'log10_quantiles',
+        help = 'output file of the quantiles of logarithms of eigenvalues'
+    )
+    parser.add_argument(
+        '--dedup',
+        type = float,
+        help = 'tolerance of near duplicates of polygons'
+    )
+    parser.add_argument(
+        '--novel',
+        help = 'output file of novel polygons'
+    )
+    parser.add_argument(
+        '--known',
+        help = 'file of already labelled polygons'
+    )
+    parser.add_argument(
+        '--deduplicator',
+        default = DEDUPLICATOR,
+        help = 'program filtering out near duplicates of polygons'
+    )
+    parser.add_argument(
+        '--features-mean',
+        dest = 'features_mean',
+        help = 'output file of the mean of features'
+    )
+    parser.add_argument(
+        '--features-std',
+        dest = 'features_std',
+        help = 'output file of the standard deviation of features'
+    )
+    parser.add_argument(
+        '--features',
+        type = int,
+        nargs = '+',
+        help = 'columns of the features'
+    )
+    parser.add_argument(
+        '--describer',
+        default = DESCRIBER,
+        help = 'program describing polygons'
+    )
+    parser.add_argument(
+        '--sorter',
+        default = SORTER,
+        help = 'program sorting descriptions of polygons'
+    )
+    parser.add_argument(
+        '--svd',
+        default = SVD,
+        help = 'program computing singular values of polygons'
+    )
+    arguments = parser.parse_args()
+    options = list()
+    if arguments.nv is not None:
+        options += ['-nv', arguments.nv]
+    if arguments.tol is not None:
+        options += ['-tol', arguments.tol]
+    if arguments.levels is not None:
+        options += ['-levels', arguments.levels]
+    label(
+        arguments.path_in,
+        arguments.path_out,
+        arguments.processes,
+        arguments.shard,
+        arguments.store,
+        arguments.script,
+        arguments.freefem,
+        options,
+        path_flux = arguments.flux,
+        path_sketch = arguments.sketch,
+        path_quantiles = arguments.quantiles,
+        path_log10_quantiles = arguments.log10_quantiles,
+        dedup = arguments.dedup,
+        path_novel = arguments.novel,
+        path_known = arguments.known,
+        deduplicator = arguments.deduplicator,
+        path_features_mean = arguments.features_mean,
+        path_features_std = arguments.features_std,
+        features = arguments.features,
+        describer = arguments.describer,
+        sorter = arguments.sorter,
+        svd = arguments.svd
+    )
@@ -39,12 +39,19 @@
  * simultaneously to consume less memory.  Do not set the same path for the
  * input and the output file.
  *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single polygon per row instead of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -60,6 +67,7 @@
 #include "boolean.h"
 #include "numeric.h"
 #include "polygon.h"
+#include "table.h"
 
 int main (int argc, char** argv)
 {
@@ -95,15 +103,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the input file to open. */
-    const char* const file_in_open_mode = "rt";
-
-    /* Mode of the output file to open. */
-    const char* const file_out_open_mode = "wt";
-
-    /* Format string for reading the coordinates. */
-    const char* const format_input = " %lf";
-
     /* DECLARATION OF VARIABLES */
 
     /* Number of polygons to read. */
@@ -116,10 +115,10 @@ int main (int argc, char** argv)
     real_t* P;
 
     /* Input file. */
-    FILE* in;
+    table_t in;
 
     /* Output file. */
-    FILE* out;
+    table_t out;
 
     /* Iteration indices. */
     size_t i;
@@ -137,10 +136,10 @@ int main (int argc, char** argv)
     P = (real_t*)(NULL);
 
     /* Input file. */
-    in = (FILE*)(NULL);
+    memset(&in, 0, sizeof in);
 
     /* Output file. */
-    out = (FILE*)(NULL);
+    memset(&out, 0, sizeof out);
 
     /* Iteration indices. */
     i = 0U;
@@ -237,12 +236,9 @@ int main (int argc, char** argv)
     /* Initialise coordinates of vertices of polygons to zeros. */
     memset(P, 0, (n << 3U) * sizeof *P);
 
-    /* Open the input file. */
-    in = fopen(*(argv + 3U), file_in_open_mode);
-
-    /* If the input file could not be opened, print the error message,
+    /* Open the input file.  If it could not be opened, print the error message,
      * deallocate memory and exit with a non-zero value. */
-    if (!in)
+    if (!table_open(&in, *(argv + 3U), false))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_in);
@@ -258,20 +254,16 @@ int main (int argc, char** argv)
         exit(EXIT_FAILURE);
     }
 
-    /* Open the output file. */
-    out = fopen(*(argv + 4U), file_out_open_mode);
-
-    /* If the output file could not be opened, print the error message,
-     * close the input file, deallocate memory and exit with a non-zero
+    /* Open the output file.  If it could not be opened, print the error
+     * message, close the input file, deallocate memory and exit with a non-zero
      * value. */
-    if (!out)
+    if (!table_open(&out, *(argv + 4U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
 
         /* Close the input file. */
-        fclose(in);
-        in = (FILE*)(NULL);
+        table_close(&in);
 
         /* Clear the memory in the array of points. */
         memset(P, 0, (n << 3U) * sizeof *P);
@@ -295,18 +287,16 @@ int main (int argc, char** argv)
          * output and the input files, deallocate memory and exit with a
          * non-zero value. */
         for (j = 0U; (j >> 1U) < n; ++j)
-            if (!(fscanf(in, format_input, P + j) == 1))
+            if (!(table_scan(&in, 1U, P + j) == 1U))
             {
                 /* Print the error message. */
                 fprintf(stderr, format_err_msg, err_msg_rc);
 
                 /* Close the output file. */
-                fclose(out);
-                out = (FILE*)(NULL);
+                table_close(&out);
 
                 /* Close the input file. */
-                fclose(in);
-                in = (FILE*)(NULL);
+                table_close(&in);
 
                 /* Clear the memory in the array of points. */
                 memset(P, 0, (n << 3U) * sizeof *P);
@@ -335,16 +325,14 @@ int main (int argc, char** argv)
         correct_polygon_orientation(n, P + 6U * n);
 
         /* Dump the polygons to the output file. */
-        dump_polygons(out, n, P, 4U);
+        table_dump_polygons(&out, n, P, 4U);
     }
 
     /* Close the output file. */
-    fclose(out);
-    out = (FILE*)(NULL);
+    table_close(&out);
 
     /* Close the input file. */
-    fclose(in);
-    in = (FILE*)(NULL);
+    table_close(&in);
 
     /* Clear the memory in the array of points. */
     memset(P, 0, (n << 3U) * sizeof *P);
@@ -28,12 +28,19 @@
  * diameter 1 (up to a numerical precision) and that they fit in the
  * [-1 / 2, 1 / 2] x [-1 / 2, 1 / 2] square in the plane.
  *
+ * If the path to the output file ends with ".npy" or ".pcz", the polygons are
+ * dumped as a NumPy array of shape (N, 2 * n) or as a compressed table instead
+ * of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -50,6 +57,7 @@
 #include "numeric.h"
 #include "polygon.h"
 #include "playground.h"
+#include "table.h"
 
 /* Define constants for maximal numbers of iterations. */
 #define IN_ITER_MAX     1024U
@@ -91,9 +99,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the output file to open. */
-    const char* const file_open_mode = "wt";
-
     /* DECLARATION OF VARIABLES */
 
     /* Number of polygons. */
@@ -117,7 +122,7 @@ int main (int argc, char** argv)
     real_t* phi;
 
     /* Output file. */
-    FILE* out;
+    table_t out;
 
     /* Iteration indices. */
     size_t i;
@@ -146,7 +151,7 @@ int main (int argc, char** argv)
     phi = (real_t*)(NULL);
 
     /* Output file. */
-    out = (FILE*)(NULL);
+    memset(&out, 0, sizeof out);
 
     /* Iteration indices. */
     i = 0U;
@@ -401,12 +406,9 @@ int main (int argc, char** argv)
     /* Normalise the first polygon. */
     normalise_polygon(n, P);
 
-    /* Open the output file. */
-    out = fopen(*(argv + 4U), file_open_mode);
-
-    /* If the output file could not be opened, print the error message,
-     * deallocate memory and exit with a non-zero value. */
-    if (!out)
+    /* Open the output file.  If it could not be opened, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!table_open(&out, *(argv + 4U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
@@ -441,11 +443,10 @@ int main (int argc, char** argv)
     }
 
     /* Dump the polygons to the output file. */
-    dump_polygons(out, n, P, N);
+    table_dump_polygons(&out, n, P, N);
 
     /* Close the output file. */
-    fclose(out);
-    out = (FILE*)(NULL);
+    table_close(&out);
 
     /* Clear the memory in the arrays of the differences in coordinates,
      * the lengths of edges and the outer angles. */
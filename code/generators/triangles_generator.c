@@ -30,12 +30,19 @@
  * triangles are sorted lexicographically according to coordinates of the second
  * vertex.
  *
+ * If the path to the output file ends with ".npy" or ".pcz", the polygons are
+ * dumped as a NumPy array of shape (N, 6) or as a compressed table instead
+ * of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -51,6 +58,7 @@
 #include "boolean.h"
 #include "numeric.h"
 #include "polygon.h"
+#include "table.h"
 
 int main (int argc, char** argv)
 {
@@ -93,9 +101,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the output file to open. */
-    const char* const file_open_mode = "wt";
-
     /* Format string for printing the number of generated triangles. */
     const char* const format_number_triangles = "Number of triangles: %lu.\n";
 
@@ -112,7 +117,7 @@ int main (int argc, char** argv)
     real_t T[6U];
 
     /* Output file. */
-    FILE* out;
+    table_t out;
 
     /* Auxiliary decremented numbers of discretisation points on x-axis and
      * y-axis (of type `real_t`). */
@@ -136,7 +141,7 @@ int main (int argc, char** argv)
     n = 0U;
 
     /* Output file. */
-    out = (FILE*)(NULL);
+    memset(&out, 0, sizeof out);
 
     /* Auxiliary decremented numbers of discretisation points on x-axis and
      * y-axis (of type `real_t`). */
@@ -194,7 +199,7 @@ int main (int argc, char** argv)
     /* Read the number of discretisation points on x-axis and compute the number
      * of discretisation points on y-axis. */
     m = (size_t)atoi(*(argv + 1U));
-    n = (size_t)(sqrt_3 * (double)m + half_minus_sqrt_3) + 1U;
+    n = (size_t)(sqrt_3 * (real_t)m + half_minus_sqrt_3) + 1U;
 
     /* If the number of discretisation points on x-axis is 0, print the error
      * message and exit with a non-zero value. */
@@ -220,15 +225,12 @@ int main (int argc, char** argv)
     }
 
     /* Extract the auxiliary decremented numbers of discretisation points. */
-    real_m_ = (double)(m - 1U);
-    real_n_ = (double)(n - 1U);
-
-    /* Open the output file. */
-    out = fopen(*(argv + 2U), file_open_mode);
+    real_m_ = (real_t)(m - 1U);
+    real_n_ = (real_t)(n - 1U);
 
-    /* If the output file could not be opened, print the error message and exit
-     * with a non-zero value. */
-    if (!out)
+    /* Open the output file.  If it could not be opened, print the error message
+     * and exit with a non-zero value. */
+    if (!table_open(&out, *(argv + 2U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
@@ -271,7 +273,7 @@ int main (int argc, char** argv)
                 break;
 
             /* Print the current triangle to the output file. */
-            dump_polygons(out, 3U, T, 1U);
+            table_dump_polygons(&out, 3U, T, 1U);
 
             /* Increment the number of generated triangles. */
             ++N;
@@ -279,8 +281,7 @@ int main (int argc, char** argv)
     }
 
     /* Close the output file. */
-    fclose(out);
-    out = (FILE*)(NULL);
+    table_close(&out);
 
     /* Print the number of generated triangles. */
     printf(format_number_triangles, N);
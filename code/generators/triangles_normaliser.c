@@ -46,12 +46,19 @@
  * simultaneously to consume less memory.  Do not set the same path for the
  * input and the output file.
  *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single polygon per row instead of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -69,6 +76,7 @@
 #include "polygon.h"
 #include "playground.h"
 #include "triangle.h"
+#include "table.h"
 
 int main (int argc, char** argv)
 {
@@ -98,15 +106,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the input file to open. */
-    const char* const file_in_open_mode = "rt";
-
-    /* Mode of the output file to open. */
-    const char* const file_out_open_mode = "wt";
-
-    /* Format string for reading the coordinates. */
-    const char* const format_input = " %lf";
-
     /* DECLARATION OF VARIABLES */
 
     /* Number of triangles. */
@@ -123,10 +122,10 @@ int main (int argc, char** argv)
     real_t phi[3U];
 
     /* Input file. */
-    FILE* in;
+    table_t in;
 
     /* Output file. */
-    FILE* out;
+    table_t out;
 
     /* Iteration indices. */
     size_t i;
@@ -138,10 +137,10 @@ int main (int argc, char** argv)
     N = 0U;
 
     /* Input file. */
-    in = (FILE*)(NULL);
+    memset(&in, 0, sizeof in);
 
     /* Output file. */
-    out = (FILE*)(NULL);
+    memset(&out, 0, sizeof out);
 
     /* Iteration indices. */
     i = 0U;
@@ -216,12 +215,9 @@ int main (int argc, char** argv)
         exit(EXIT_FAILURE);
     }
 
-    /* Open the input file. */
-    in = fopen(*(argv + 2U), file_in_open_mode);
-
-    /* If the input file could not be opened, print the error message, clear
-     * memory and exit with a non-zero value. */
-    if (!in)
+    /* Open the input file.  If it could not be opened, print the error message,
+     * clear memory and exit with a non-zero value. */
+    if (!table_open(&in, *(argv + 2U), false))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_in);
@@ -240,19 +236,16 @@ int main (int argc, char** argv)
         exit(EXIT_FAILURE);
     }
 
-    /* Open the output file. */
-    out = fopen(*(argv + 3U), file_out_open_mode);
-
-    /* If the output file could not be opened, print the error message,
-     * close the input file, clear memory and exit with a non-zero value. */
-    if (!out)
+    /* Open the output file.  If it could not be opened, print the error
+     * message, close the input file, clear memory and exit with a non-zero
+     * value. */
+    if (!table_open(&out, *(argv + 3U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
 
         /* Close the input file. */
-        fclose(in);
-        in = (FILE*)(NULL);
+        table_close(&in);
 
         /* Clear the memory in the arrays of the differences in coordinates,
          * the lengths of edges and the outer angles. */
@@ -279,18 +272,16 @@ int main (int argc, char** argv)
          * output and the input files, clear memory and exit with a non-zero
          * value. */
         for (j = 0U; (j >> 1U) < 3U; ++j)
-            if (!(fscanf(in, format_input, T + j) == 1))
+            if (!(table_scan(&in, 1U, T + j) == 1U))
             {
                 /* Print the error message. */
                 fprintf(stderr, format_err_msg, err_msg_rc);
 
                 /* Close the output file. */
-                fclose(out);
-                out = (FILE*)(NULL);
+                table_close(&out);
 
                 /* Close the input file. */
-                fclose(in);
-                in = (FILE*)(NULL);
+                table_close(&in);
 
                 /* Clear the memory in the arrays of the differences in
                  * coordinates, the lengths of edges and the outer angles. */
@@ -319,16 +310,14 @@ int main (int argc, char** argv)
         centralise_triangle(T, l);
 
         /* Dump the triangle to the output file. */
-        dump_polygons(out, 3U, T, 1U);
+        table_dump_polygons(&out, 3U, T, 1U);
     }
 
     /* Close the output file. */
-    fclose(out);
-    out = (FILE*)(NULL);
+    table_close(&out);
 
     /* Close the input file. */
-    fclose(in);
-    in = (FILE*)(NULL);
+    table_close(&in);
 
     /* Clear the memory in the arrays of the differences in coordinates,
      * the lengths of edges and the outer angles. */
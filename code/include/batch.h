@@ -0,0 +1,2075 @@
+/**
+ * Batch functions for polygons of a fixed number of vertices stored as a
+ * structure of arrays.
+ *
+ * A batch of B polygons of n vertices is stored in two arrays `X` and `Y` of
+ * size n * B each such that `X[k * B + b]` is the x-coordinate and
+ * `Y[k * B + b]` is the y-coordinate of the `k`-th vertex of the `b`-th
+ * polygon.  In other words, the `k`-th row of `X` (or `Y`) holds the
+ * coordinates of the `k`-th vertices of all polygons in the batch.  Other
+ * per-vertex values (lengths of edges, outer angles...) are stored in the same
+ * manner.  The functions iterate over the vertices in the outer loop and over
+ * the polygons in the inner loop, which enables processing a group of
+ * neighbouring polygons in a single vector register.
+ *
+ * If the code is compiled with support for AVX-512 (`__AVX512F__`), AVX
+ * (`__AVX__`) or SSE2 (`__SSE2__`) instructions, the arithmetic parts of the
+ * functions are computed on groups of 8, 4 or 2 polygons respectively if
+ * `real_t` is `double`, or on groups of 16, 8 or 4 polygons (AVX-512, AVX or
+ * SSE) if `real_t` is `float`.  The
+ * remaining polygons (and all polygons if no vector instructions are
+ * available) are processed one by one.  Vector instructions compute exactly the
+ * same values as the corresponding scalar code (only IEEE-754 addition,
+ * subtraction, multiplication, division and square root are used), so the
+ * results are the same as the results of the functions from "polygon.h" and
+ * "triangle.h".  Trigonometric functions are always computed by the scalar
+ * functions from "numeric.h".
+ *
+ * The functions `batch_segment_crossing` and `batch_check_polygon` are an
+ * exception to the layout:  they test a single line segment against a block of
+ * consecutive line segments of a single polygon (a chain of points stored in
+ * two contiguous arrays of coordinates), so neighbouring line segments are
+ * processed in a single vector register.
+ *
+ * Vector instructions are used only if `real_t` is `float` or `double` and the
+ * macro `_BATCH_NO_SIMD` is not defined.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__BATCH_H__INCLUDED) && (__BATCH_H__INCLUDED) == 1)
+
+/* Undefine __BATCH_H__INCLUDED if it has already been defined. */
+#if defined(__BATCH_H__INCLUDED)
+#undef __BATCH_H__INCLUDED
+#endif /* __BATCH_H__INCLUDED */
+
+/* Define __BATCH_H__INCLUDED as 1. */
+#define __BATCH_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+#include "predicate.h"
+#include "triangle.h"
+
+/* Define vector types and operations. */
+
+/* Undefine `BATCH_LANES` if it has already been defined. */
+#if defined(BATCH_LANES)
+#undef BATCH_LANES
+#endif /* BATCH_LANES */
+
+#if ( \
+    !defined(_BATCH_NO_SIMD) && \
+    (_REAL_PRECISION) == (_REAL_DOUBLE) && \
+    defined(__AVX512F__) \
+)
+
+#include <immintrin.h>
+
+/**
+ * Number of polygons processed in a single vector register.
+ *
+ */
+#define BATCH_LANES 8U
+
+/* Vector of real values and vector of comparison results. */
+typedef __m512d batch_vector_t;
+typedef __mmask8 batch_mask_t;
+
+/* Load/store operations. */
+#define BATCH_LOAD(p)           _mm512_loadu_pd(p)
+#define BATCH_STORE(p, a)       _mm512_storeu_pd((p), (a))
+#define BATCH_SET1(x)           _mm512_set1_pd(x)
+
+/* Arithmetic operations. */
+#define BATCH_ADD(a, b)         _mm512_add_pd((a), (b))
+#define BATCH_SUB(a, b)         _mm512_sub_pd((a), (b))
+#define BATCH_MUL(a, b)         _mm512_mul_pd((a), (b))
+#define BATCH_DIV(a, b)         _mm512_div_pd((a), (b))
+#define BATCH_SQRT(a)           _mm512_sqrt_pd(a)
+#define BATCH_MIN(a, b)         _mm512_min_pd((a), (b))
+#define BATCH_MAX(a, b)         _mm512_max_pd((a), (b))
+#define BATCH_ABS(a)            _mm512_abs_pd(a)
+
+/* Comparison and selection operations. */
+#define BATCH_LT(a, b)          _mm512_cmp_pd_mask((a), (b), _CMP_LT_OQ)
+#define BATCH_BITS(m)           ((int)(m))
+#define BATCH_BLEND(m, a, b)    _mm512_mask_blend_pd((m), (a), (b))
+#define BATCH_DIV_NZ(a, b) \
+    _mm512_maskz_div_pd( \
+        _mm512_cmp_pd_mask((b), _mm512_setzero_pd(), _CMP_NEQ_UQ), \
+        (a), \
+        (b) \
+    )
+
+#elif ( \
+    !defined(_BATCH_NO_SIMD) && \
+    (_REAL_PRECISION) == (_REAL_DOUBLE) && \
+    defined(__AVX__) \
+)
+
+#include <immintrin.h>
+
+/**
+ * Number of polygons processed in a single vector register.
+ *
+ */
+#define BATCH_LANES 4U
+
+/* Vector of real values and vector of comparison results. */
+typedef __m256d batch_vector_t;
+typedef __m256d batch_mask_t;
+
+/* Load/store operations. */
+#define BATCH_LOAD(p)           _mm256_loadu_pd(p)
+#define BATCH_STORE(p, a)       _mm256_storeu_pd((p), (a))
+#define BATCH_SET1(x)           _mm256_set1_pd(x)
+
+/* Arithmetic operations. */
+#define BATCH_ADD(a, b)         _mm256_add_pd((a), (b))
+#define BATCH_SUB(a, b)         _mm256_sub_pd((a), (b))
+#define BATCH_MUL(a, b)         _mm256_mul_pd((a), (b))
+#define BATCH_DIV(a, b)         _mm256_div_pd((a), (b))
+#define BATCH_SQRT(a)           _mm256_sqrt_pd(a)
+#define BATCH_MIN(a, b)         _mm256_min_pd((a), (b))
+#define BATCH_MAX(a, b)         _mm256_max_pd((a), (b))
+#define BATCH_ABS(a)            _mm256_andnot_pd(_mm256_set1_pd(-0.0), (a))
+
+/* Comparison and selection operations. */
+#define BATCH_LT(a, b)          _mm256_cmp_pd((a), (b), _CMP_LT_OQ)
+#define BATCH_BITS(m)           _mm256_movemask_pd(m)
+#define BATCH_BLEND(m, a, b)    _mm256_blendv_pd((a), (b), (m))
+#define BATCH_DIV_NZ(a, b) \
+    _mm256_and_pd( \
+        _mm256_div_pd((a), (b)), \
+        _mm256_cmp_pd((b), _mm256_setzero_pd(), _CMP_NEQ_UQ) \
+    )
+
+#elif ( \
+    !defined(_BATCH_NO_SIMD) && \
+    (_REAL_PRECISION) == (_REAL_DOUBLE) && \
+    defined(__SSE2__) \
+)
+
+#include <emmintrin.h>
+
+/**
+ * Number of polygons processed in a single vector register.
+ *
+ */
+#define BATCH_LANES 2U
+
+/* Vector of real values and vector of comparison results. */
+typedef __m128d batch_vector_t;
+typedef __m128d batch_mask_t;
+
+/* Load/store operations. */
+#define BATCH_LOAD(p)           _mm_loadu_pd(p)
+#define BATCH_STORE(p, a)       _mm_storeu_pd((p), (a))
+#define BATCH_SET1(x)           _mm_set1_pd(x)
+
+/* Arithmetic operations. */
+#define BATCH_ADD(a, b)         _mm_add_pd((a), (b))
+#define BATCH_SUB(a, b)         _mm_sub_pd((a), (b))
+#define BATCH_MUL(a, b)         _mm_mul_pd((a), (b))
+#define BATCH_DIV(a, b)         _mm_div_pd((a), (b))
+#define BATCH_SQRT(a)           _mm_sqrt_pd(a)
+#define BATCH_MIN(a, b)         _mm_min_pd((a), (b))
+#define BATCH_MAX(a, b)         _mm_max_pd((a), (b))
+#define BATCH_ABS(a)            _mm_andnot_pd(_mm_set1_pd(-0.0), (a))
+
+/* Comparison and selection operations. */
+#define BATCH_LT(a, b)          _mm_cmplt_pd((a), (b))
+#define BATCH_BITS(m)           _mm_movemask_pd(m)
+#define BATCH_BLEND(m, a, b) \
+    _mm_or_pd(_mm_and_pd((m), (b)), _mm_andnot_pd((m), (a)))
+#define BATCH_DIV_NZ(a, b) \
+    _mm_and_pd(_mm_div_pd((a), (b)), _mm_cmpneq_pd((b), _mm_setzero_pd()))
+
+#elif ( \
+    !defined(_BATCH_NO_SIMD) && \
+    (_REAL_PRECISION) == (_REAL_FLOAT) && \
+    defined(__AVX512F__) \
+)
+
+#include <immintrin.h>
+
+/**
+ * Number of polygons processed in a single vector register.
+ *
+ */
+#define BATCH_LANES 16U
+
+/* Vector of real values and vector of comparison results. */
+typedef __m512 batch_vector_t;
+typedef __mmask16 batch_mask_t;
+
+/* Load/store operations. */
+#define BATCH_LOAD(p)           _mm512_loadu_ps(p)
+#define BATCH_STORE(p, a)       _mm512_storeu_ps((p), (a))
+#define BATCH_SET1(x)           _mm512_set1_ps(x)
+
+/* Arithmetic operations. */
+#define BATCH_ADD(a, b)         _mm512_add_ps((a), (b))
+#define BATCH_SUB(a, b)         _mm512_sub_ps((a), (b))
+#define BATCH_MUL(a, b)         _mm512_mul_ps((a), (b))
+#define BATCH_DIV(a, b)         _mm512_div_ps((a), (b))
+#define BATCH_SQRT(a)           _mm512_sqrt_ps(a)
+#define BATCH_MIN(a, b)         _mm512_min_ps((a), (b))
+#define BATCH_MAX(a, b)         _mm512_max_ps((a), (b))
+#define BATCH_ABS(a)            _mm512_abs_ps(a)
+
+/* Comparison and selection operations. */
+#define BATCH_LT(a, b)          _mm512_cmp_ps_mask((a), (b), _CMP_LT_OQ)
+#define BATCH_BITS(m)           ((int)(m))
+#define BATCH_BLEND(m, a, b)    _mm512_mask_blend_ps((m), (a), (b))
+#define BATCH_DIV_NZ(a, b) \
+    _mm512_maskz_div_ps( \
+        _mm512_cmp_ps_mask((b), _mm512_setzero_ps(), _CMP_NEQ_UQ), \
+        (a), \
+        (b) \
+    )
+
+#elif ( \
+    !defined(_BATCH_NO_SIMD) && \
+    (_REAL_PRECISION) == (_REAL_FLOAT) && \
+    defined(__AVX__) \
+)
+
+#include <immintrin.h>
+
+/**
+ * Number of polygons processed in a single vector register.
+ *
+ */
+#define BATCH_LANES 8U
+
+/* Vector of real values and vector of comparison results. */
+typedef __m256 batch_vector_t;
+typedef __m256 batch_mask_t;
+
+/* Load/store operations. */
+#define BATCH_LOAD(p)           _mm256_loadu_ps(p)
+#define BATCH_STORE(p, a)       _mm256_storeu_ps((p), (a))
+#define BATCH_SET1(x)           _mm256_set1_ps(x)
+
+/* Arithmetic operations. */
+#define BATCH_ADD(a, b)         _mm256_add_ps((a), (b))
+#define BATCH_SUB(a, b)         _mm256_sub_ps((a), (b))
+#define BATCH_MUL(a, b)         _mm256_mul_ps((a), (b))
+#define BATCH_DIV(a, b)         _mm256_div_ps((a), (b))
+#define BATCH_SQRT(a)           _mm256_sqrt_ps(a)
+#define BATCH_MIN(a, b)         _mm256_min_ps((a), (b))
+#define BATCH_MAX(a, b)         _mm256_max_ps((a), (b))
+#define BATCH_ABS(a)            _mm256_andnot_ps(_mm256_set1_ps(-0.0F), (a))
+
+/* Comparison and selection operations. */
+#define BATCH_LT(a, b)          _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+#define BATCH_BITS(m)           _mm256_movemask_ps(m)
+#define BATCH_BLEND(m, a, b)    _mm256_blendv_ps((a), (b), (m))
+#define BATCH_DIV_NZ(a, b) \
+    _mm256_and_ps( \
+        _mm256_div_ps((a), (b)), \
+        _mm256_cmp_ps((b), _mm256_setzero_ps(), _CMP_NEQ_UQ) \
+    )
+
+#elif ( \
+    !defined(_BATCH_NO_SIMD) && \
+    (_REAL_PRECISION) == (_REAL_FLOAT) && \
+    defined(__SSE__) \
+)
+
+#include <xmmintrin.h>
+
+/**
+ * Number of polygons processed in a single vector register.
+ *
+ */
+#define BATCH_LANES 4U
+
+/* Vector of real values and vector of comparison results. */
+typedef __m128 batch_vector_t;
+typedef __m128 batch_mask_t;
+
+/* Load/store operations. */
+#define BATCH_LOAD(p)           _mm_loadu_ps(p)
+#define BATCH_STORE(p, a)       _mm_storeu_ps((p), (a))
+#define BATCH_SET1(x)           _mm_set1_ps(x)
+
+/* Arithmetic operations. */
+#define BATCH_ADD(a, b)         _mm_add_ps((a), (b))
+#define BATCH_SUB(a, b)         _mm_sub_ps((a), (b))
+#define BATCH_MUL(a, b)         _mm_mul_ps((a), (b))
+#define BATCH_DIV(a, b)         _mm_div_ps((a), (b))
+#define BATCH_SQRT(a)           _mm_sqrt_ps(a)
+#define BATCH_MIN(a, b)         _mm_min_ps((a), (b))
+#define BATCH_MAX(a, b)         _mm_max_ps((a), (b))
+#define BATCH_ABS(a)            _mm_andnot_ps(_mm_set1_ps(-0.0F), (a))
+
+/* Comparison and selection operations. */
+#define BATCH_LT(a, b)          _mm_cmplt_ps((a), (b))
+#define BATCH_BITS(m)           _mm_movemask_ps(m)
+#define BATCH_BLEND(m, a, b) \
+    _mm_or_ps(_mm_and_ps((m), (b)), _mm_andnot_ps((m), (a)))
+#define BATCH_DIV_NZ(a, b) \
+    _mm_and_ps(_mm_div_ps((a), (b)), _mm_cmpneq_ps((b), _mm_setzero_ps()))
+
+#else
+
+/**
+ * Number of polygons processed in a single vector register.
+ *
+ */
+#define BATCH_LANES 1U
+
+#endif /* _BATCH_NO_SIMD, _REAL_PRECISION, __AVX512F__, __AVX__, __SSE2__ */
+
+/* Mark that vector instructions are used. */
+#if (BATCH_LANES) > 1U
+#define _BATCH_SIMD 1
+#endif /* BATCH_LANES */
+
+/**
+ * Transpose an array of polygons into a batch.
+ *
+ * The array `{x_0, y_0, ..., x_n_minus_1, y_n_minus_1}` of the `b`-th polygon
+ * is found at `P + 2 * n * b` and its coordinates are copied into the `b`-th
+ * columns of the arrays `X` and `Y`.
+ *
+ * No memory locations may overlap to avoid unexpected results.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param B
+ *     Number of polygons.
+ *
+ * @param P
+ *     Array of polygons of size at least 2 * `n` * `B`.
+ *
+ * @param X
+ *     Array of x-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `X` is mutated in the function.
+ *
+ * @param Y
+ *     Array of y-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `Y` is mutated in the function.
+ *
+ * @see batch_untranspose_polygons
+ *
+ */
+void batch_transpose_polygons (
+    size_t n,
+    size_t B,
+    const real_t* P,
+    real_t* X,
+    real_t* Y
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+    size_t k;
+
+    /* Pointer to the current polygon. */
+    const real_t* P_b;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+    k = 0U;
+
+    /* Pointer to the current polygon. */
+    P_b = (const real_t*)(NULL);
+
+    /* ALGORITHM */
+
+    /* If any of the pointers `P`, `X` and `Y` is a null-pointer, set the
+     * number `B` to 0. */
+    if (!(P && X && Y))
+        B = 0U;
+
+    /* Iterate over the polygons and copy their coordinates. */
+    for (b = 0U; b < B; ++b)
+    {
+        /* Extract the `b`-th polygon. */
+        P_b = P + ((b * n) << 1U);
+
+        /* Copy the coordinates of the vertices of the `b`-th polygon. */
+        for (k = 0U; k < n; ++k)
+        {
+            *(X + k * B + b) = *(P_b + (k << 1U));
+            *(Y + k * B + b) = *(P_b + (k << 1U) + 1U);
+        }
+    }
+}
+
+/**
+ * Transpose a batch into an array of polygons.
+ *
+ * The function is the inverse of the `batch_transpose_polygons` function.
+ *
+ * No memory locations may overlap to avoid unexpected results.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param B
+ *     Number of polygons.
+ *
+ * @param X
+ *     Array of x-coordinates of size at least `n` * `B`.
+ *
+ * @param Y
+ *     Array of y-coordinates of size at least `n` * `B`.
+ *
+ * @param P
+ *     Array of polygons of size at least 2 * `n` * `B`.
+ *
+ *     Caution: the array `P` is mutated in the function.
+ *
+ * @see batch_transpose_polygons
+ *
+ */
+void batch_untranspose_polygons (
+    size_t n,
+    size_t B,
+    const real_t* X,
+    const real_t* Y,
+    real_t* P
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+    size_t k;
+
+    /* Pointer to the current polygon. */
+    real_t* P_b;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+    k = 0U;
+
+    /* Pointer to the current polygon. */
+    P_b = (real_t*)(NULL);
+
+    /* ALGORITHM */
+
+    /* If any of the pointers `X`, `Y` and `P` is a null-pointer, set the
+     * number `B` to 0. */
+    if (!(X && Y && P))
+        B = 0U;
+
+    /* Iterate over the polygons and copy their coordinates. */
+    for (b = 0U; b < B; ++b)
+    {
+        /* Extract the `b`-th polygon. */
+        P_b = P + ((b * n) << 1U);
+
+        /* Copy the coordinates of the vertices of the `b`-th polygon. */
+        for (k = 0U; k < n; ++k)
+        {
+            *(P_b + (k << 1U)) = *(X + k * B + b);
+            *(P_b + (k << 1U) + 1U) = *(Y + k * B + b);
+        }
+    }
+}
+
+/**
+ * Transpose an array of rows into a batch.
+ *
+ * The `b`-th row of `m` values found at `A + lda * b` is copied into the
+ * `b`-th column of the array `X`, i. e. `X[k * B + b] = A[lda * b + k]` for
+ * all `k` < `m`.
+ *
+ * No memory locations may overlap to avoid unexpected results.
+ *
+ * @param m
+ *     Number of values in each row.
+ *
+ * @param B
+ *     Number of rows.
+ *
+ * @param A
+ *     Array of rows of size at least `lda` * `B`.
+ *
+ * @param lda
+ *     Distance between the beginnings of two consecutive rows in the array
+ *     `A` (at least `m`).
+ *
+ * @param X
+ *     Array of size at least `m` * `B`.
+ *
+ *     Caution: the array `X` is mutated in the function.
+ *
+ * @see batch_untranspose
+ *
+ */
+void batch_transpose (
+    size_t m,
+    size_t B,
+    const real_t* A,
+    size_t lda,
+    real_t* X
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers `A` and `X` is a null-pointer, set the number `B`
+     * to 0. */
+    if (!(A && X))
+        B = 0U;
+
+    /* Copy the values. */
+    for (b = 0U; b < B; ++b)
+        for (k = 0U; k < m; ++k)
+            *(X + k * B + b) = *(A + lda * b + k);
+}
+
+/**
+ * Transpose a batch into an array of rows.
+ *
+ * The function is the inverse of the `batch_transpose` function.
+ *
+ * No memory locations may overlap to avoid unexpected results.
+ *
+ * @param m
+ *     Number of values in each row.
+ *
+ * @param B
+ *     Number of rows.
+ *
+ * @param X
+ *     Array of size at least `m` * `B`.
+ *
+ * @param A
+ *     Array of rows of size at least `lda` * `B`.
+ *
+ *     Caution: the array `A` is mutated in the function.
+ *
+ * @param lda
+ *     Distance between the beginnings of two consecutive rows in the array
+ *     `A` (at least `m`).
+ *
+ * @see batch_transpose
+ *
+ */
+void batch_untranspose (
+    size_t m,
+    size_t B,
+    const real_t* X,
+    real_t* A,
+    size_t lda
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers `X` and `A` is a null-pointer, set the number `B`
+     * to 0. */
+    if (!(X && A))
+        B = 0U;
+
+    /* Copy the values. */
+    for (b = 0U; b < B; ++b)
+        for (k = 0U; k < m; ++k)
+            *(A + lda * b + k) = *(X + k * B + b);
+}
+
+/**
+ * Reorder the vertices of all polygons in a batch into the conventional order.
+ *
+ * The result for each polygon is the same as the result of the
+ * `correct_polygon_orientation` function.  Unlike the function, memory is
+ * allocated only once for the whole batch and no memory is allocated if all
+ * polygons are already in the conventional order.
+ *
+ * Caution: the function may fail if memory cannot be allocated for the
+ * auxiliary arrays.  If that happens, the polygons remain unchanged.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param B
+ *     Number of polygons.
+ *
+ * @param X
+ *     Array of x-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `X` is mutated in the function.
+ *
+ * @param Y
+ *     Array of y-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `Y` is mutated in the function.
+ *
+ * @see correct_polygon_orientation
+ *
+ */
+void batch_correct_polygon_orientation (
+    size_t n,
+    size_t B,
+    real_t* X,
+    real_t* Y
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Indices of the first points and orientation flags of the polygons. */
+    size_t* v;
+
+    /* Auxiliary arrays of coordinates. */
+    real_t* Q;
+
+    /* Number of polygons that must be reordered. */
+    size_t r;
+
+    /* Iteration indices. */
+    size_t b;
+    size_t k;
+
+    /* Index of the point to copy. */
+    size_t s;
+
+    /* Indices of the neighbours of the first point. */
+    size_t i;
+    size_t j;
+
+    /* Coordinates of the first point and its neighbours. */
+    real_t x_v;
+    real_t y_v;
+    real_t x_i;
+    real_t y_i;
+    real_t x_j;
+    real_t y_j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Indices of the first points and orientation flags of the polygons. */
+    v = (size_t*)(NULL);
+
+    /* Auxiliary arrays of coordinates. */
+    Q = (real_t*)(NULL);
+
+    /* Number of polygons that must be reordered. */
+    r = 0U;
+
+    /* Iteration indices. */
+    b = 0U;
+    k = 0U;
+
+    /* Index of the point to copy. */
+    s = 0U;
+
+    /* Indices of the neighbours of the first point. */
+    i = 0U;
+    j = 0U;
+
+    /* Coordinates of the first point and its neighbours. */
+    x_v = 0.0;
+    y_v = 0.0;
+    x_i = 0.0;
+    y_i = 0.0;
+    x_j = 0.0;
+    y_j = 0.0;
+
+    /* ALGORITHM */
+
+    /* To avoid using the `goto` command and additional `return` commands, the
+     * algorithm is enclosed in a `do while`-loop with a false terminating
+     * statement. */
+    do
+    {
+        /* If any of the pointers `X` and `Y` is a null-pointer or if the
+         * number of points is less than 2, break the `do while`-loop. */
+        if (!(X && Y && B && n >= 2U))
+            break;
+
+        /* Allocate memory for the indices of the first points. */
+        v = (size_t*)malloc(B * sizeof *v);
+
+        /* If the memory allocation has failed, break the `do while`-loop. */
+        if (!v)
+            break;
+
+        /* Initialise all indices to zeros. */
+        memset(v, 0, B * sizeof *v);
+
+        /* Find the first point of each polygon.  The comparison is the same as
+         * in the `correct_polygon_orientation` function. */
+        for (k = 1U; k < n; ++k)
+            for (b = 0U; b < B; ++b)
+                if (
+                    *(Y + k * B + b) < *(Y + *(v + b) * B + b) ||
+                    (
+                        *(Y + k * B + b) == *(Y + *(v + b) * B + b) &&
+                        *(X + *(v + b) * B + b) < *(X + k * B + b)
+                    )
+                )
+                    *(v + b) = k;
+
+        /* Encode the orientation of each polygon in the index of its first
+         * point: the index `v` is replaced by `v` + `n` if the vertices must
+         * be flipped.  Also count the polygons that must be reordered. */
+        for (b = 0U; b < B; ++b)
+        {
+            /* Compute the indices of the neighbours of the first point. */
+            i = decmod(*(v + b), n);
+            j = incmod(*(v + b), n);
+
+            /* Extract the coordinates of the first point and its
+             * neighbours. */
+            x_v = *(X + *(v + b) * B + b);
+            y_v = *(Y + *(v + b) * B + b);
+            x_i = *(X + i * B + b);
+            y_i = *(Y + i * B + b);
+            x_j = *(X + j * B + b);
+            y_j = *(Y + j * B + b);
+
+            /* If the sign of the cross product of the last and the first edge
+             * is -1 (`minus`), mark the polygon as flipped. */
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+            if (
+                rsign((x_v - x_i) * (y_j - y_i) - (x_j - x_i) * (y_v - y_i)) ==
+                minus
+            )
+#else
+            if (
+                rsign((x_v - x_i) * (y_j - y_i) - (x_j - x_i) * (y_v - y_i)) ==
+                sign_t::minus
+            )
+#endif /* __cplusplus */
+                *(v + b) += n;
+
+            /* If the polygon must be reordered, increment the counter. */
+            if (*(v + b))
+                ++r;
+        }
+
+        /* If no polygon must be reordered, break the `do while`-loop. */
+        if (!r)
+            break;
+
+        /* Allocate memory for the auxiliary array of coordinates. */
+        Q = (real_t*)malloc(n * B * sizeof *Q);
+
+        /* If the memory allocation has failed, break the `do while`-loop. */
+        if (!Q)
+            break;
+
+        /* Initialise the auxiliary array to zeros. */
+        memset(Q, 0, n * B * sizeof *Q);
+
+        /* Reorder the x-coordinates and then the y-coordinates.  The `k`-th
+         * point in the conventional order is the (`v` + `k`)-th point if the
+         * polygon is not flipped and the (`v` - `k`)-th point otherwise (modulo
+         * `n`). */
+        for (k = 0U; k < n; ++k)
+            for (b = 0U; b < B; ++b)
+            {
+                /* Compute the index of the point to copy. */
+                s =
+                    (*(v + b) < n) ?
+                        (*(v + b) + k) % n :
+                        (*(v + b) + n - k) % n;
+
+                /* Copy the x-coordinate of the point. */
+                *(Q + k * B + b) = *(X + s * B + b);
+            }
+        memcpy(X, Q, n * B * sizeof *X);
+        for (k = 0U; k < n; ++k)
+            for (b = 0U; b < B; ++b)
+            {
+                /* Compute the index of the point to copy. */
+                s =
+                    (*(v + b) < n) ?
+                        (*(v + b) + k) % n :
+                        (*(v + b) + n - k) % n;
+
+                /* Copy the y-coordinate of the point. */
+                *(Q + k * B + b) = *(Y + s * B + b);
+            }
+        memcpy(Y, Q, n * B * sizeof *Y);
+    }
+    while (false);
+
+    /* Deallocate memory for the auxiliary array of coordinates. */
+    if (Q)
+    {
+        /* Clear the memory in the auxiliary array. */
+        memset(Q, 0, n * B * sizeof *Q);
+
+        /* Deallocate memory for the auxiliary array. */
+        free(Q);
+        Q = (real_t*)(NULL);
+    }
+
+    /* Deallocate memory for the indices of the first points. */
+    if (v)
+    {
+        /* Clear the memory in the array of indices. */
+        memset(v, 0, B * sizeof *v);
+
+        /* Deallocate memory for the array of indices. */
+        free(v);
+        v = (size_t*)(NULL);
+    }
+}
+
+/**
+ * Centralise all polygons in a batch.
+ *
+ * The result for each polygon is the same as the result of the
+ * `centralise_polygon` function.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param B
+ *     Number of polygons.
+ *
+ * @param X
+ *     Array of x-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `X` is mutated in the function.
+ *
+ * @param Y
+ *     Array of y-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `Y` is mutated in the function.
+ *
+ * @see centralise_polygon
+ *
+ */
+void batch_centralise_polygon (size_t n, size_t B, real_t* X, real_t* Y)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+    size_t k;
+
+    /* Extreme and middle coordinates. */
+    real_t x_min;
+    real_t y_min;
+    real_t x_max;
+    real_t y_max;
+    real_t x_mid;
+    real_t y_mid;
+
+#if defined(_BATCH_SIMD)
+    /* Vectors of extreme and middle coordinates. */
+    batch_vector_t vx_min;
+    batch_vector_t vy_min;
+    batch_vector_t vx_max;
+    batch_vector_t vy_max;
+    batch_vector_t vx_mid;
+    batch_vector_t vy_mid;
+
+    /* Vectors of coordinates. */
+    batch_vector_t vx;
+    batch_vector_t vy;
+#endif /* _BATCH_SIMD */
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+    k = 0U;
+
+    /* Extreme and middle coordinates. */
+    x_min = 0.0;
+    y_min = 0.0;
+    x_max = 0.0;
+    y_max = 0.0;
+    x_mid = 0.0;
+    y_mid = 0.0;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers `X` and `Y` is a null-pointer or if the number of
+     * points is 0, set the number `B` to 0. */
+    if (!(X && Y && n))
+        B = 0U;
+
+#if defined(_BATCH_SIMD)
+    /* Centralise groups of `BATCH_LANES` polygons. */
+    for (b = 0U; b + BATCH_LANES <= B; b += BATCH_LANES)
+    {
+        /* Initialise the extreme coordinates to the coordinates of the first
+         * points. */
+        vx_min = BATCH_LOAD(X + b);
+        vy_min = BATCH_LOAD(Y + b);
+        vx_max = vx_min;
+        vy_max = vy_min;
+
+        /* Find the most extreme coordinates. */
+        for (k = 1U; k < n; ++k)
+        {
+            /* Load the coordinates of the `k`-th points. */
+            vx = BATCH_LOAD(X + k * B + b);
+            vy = BATCH_LOAD(Y + k * B + b);
+
+            /* Update the extreme coordinates. */
+            vx_min = BATCH_MIN(vx, vx_min);
+            vx_max = BATCH_MAX(vx, vx_max);
+            vy_min = BATCH_MIN(vy, vy_min);
+            vy_max = BATCH_MAX(vy, vy_max);
+        }
+
+        /* Compute the middle coordinates. */
+        vx_mid =
+            BATCH_ADD(
+                vx_min,
+                BATCH_MUL(BATCH_SET1(0.5), BATCH_SUB(vx_max, vx_min))
+            );
+        vy_mid =
+            BATCH_ADD(
+                vy_min,
+                BATCH_MUL(BATCH_SET1(0.5), BATCH_SUB(vy_max, vy_min))
+            );
+
+        /* Translate the coordinates. */
+        for (k = 0U; k < n; ++k)
+        {
+            BATCH_STORE(
+                X + k * B + b,
+                BATCH_SUB(BATCH_LOAD(X + k * B + b), vx_mid)
+            );
+            BATCH_STORE(
+                Y + k * B + b,
+                BATCH_SUB(BATCH_LOAD(Y + k * B + b), vy_mid)
+            );
+        }
+    }
+#endif /* _BATCH_SIMD */
+
+    /* Centralise the remaining polygons one by one. */
+    for (; b < B; ++b)
+    {
+        /* Initialise the extreme coordinates to the coordinates of the first
+         * point. */
+        x_min = *(X + b);
+        y_min = *(Y + b);
+        x_max = x_min;
+        y_max = y_min;
+
+        /* Find the most extreme coordinates. */
+        for (k = 1U; k < n; ++k)
+        {
+            if (*(X + k * B + b) < x_min)
+                x_min = *(X + k * B + b);
+            if (x_max < *(X + k * B + b))
+                x_max = *(X + k * B + b);
+            if (*(Y + k * B + b) < y_min)
+                y_min = *(Y + k * B + b);
+            if (y_max < *(Y + k * B + b))
+                y_max = *(Y + k * B + b);
+        }
+
+        /* Compute the middle coordinates. */
+        x_mid = x_min + 0.5 * (x_max - x_min);
+        y_mid = y_min + 0.5 * (y_max - y_min);
+
+        /* Translate the coordinates. */
+        for (k = 0U; k < n; ++k)
+        {
+            *(X + k * B + b) -= x_mid;
+            *(Y + k * B + b) -= y_mid;
+        }
+    }
+}
+
+/**
+ * Standardise all polygons in a batch.
+ *
+ * The result for each polygon is the same as the result of the
+ * `standardise_polygon` function.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param B
+ *     Number of polygons.
+ *
+ * @param X
+ *     Array of x-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `X` is mutated in the function.
+ *
+ * @param Y
+ *     Array of y-coordinates of size at least `n` * `B`.
+ *
+ *     Caution: the array `Y` is mutated in the function.
+ *
+ * @see standardise_polygon
+ * @see diameter_polygon
+ *
+ */
+void batch_standardise_polygon (size_t n, size_t B, real_t* X, real_t* Y)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+    size_t i;
+    size_t j;
+
+    /* Differences in coordinates. */
+    real_t dx;
+    real_t dy;
+
+    /* Squared distance and squared diameter, and diameter. */
+    real_t d;
+    real_t D;
+
+#if defined(_BATCH_SIMD)
+    /* Vectors of differences in coordinates. */
+    batch_vector_t vdx;
+    batch_vector_t vdy;
+
+    /* Vector of squared diameters and diameters. */
+    batch_vector_t vD;
+#endif /* _BATCH_SIMD */
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+    i = 0U;
+    j = 0U;
+
+    /* Differences in coordinates. */
+    dx = 0.0;
+    dy = 0.0;
+
+    /* Squared distance and squared diameter, and diameter. */
+    d = 0.0;
+    D = 0.0;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers `X` and `Y` is a null-pointer, set the number `B`
+     * to 0. */
+    if (!(X && Y))
+        B = 0U;
+
+#if defined(_BATCH_SIMD)
+    /* Standardise groups of `BATCH_LANES` polygons. */
+    for (b = 0U; b + BATCH_LANES <= B; b += BATCH_LANES)
+    {
+        /* Initialise the squared diameters to zeros. */
+        vD = BATCH_SET1(0.0);
+
+        /* Find the largest squared distance between two points. */
+        for (i = 0U; i < n; ++i)
+            for (j = i + 1U; j < n; ++j)
+            {
+                /* Compute the differences in coordinates. */
+                vdx =
+                    BATCH_SUB(
+                        BATCH_LOAD(X + j * B + b),
+                        BATCH_LOAD(X + i * B + b)
+                    );
+                vdy =
+                    BATCH_SUB(
+                        BATCH_LOAD(Y + j * B + b),
+                        BATCH_LOAD(Y + i * B + b)
+                    );
+
+                /* Update the squared diameters. */
+                vD =
+                    BATCH_MAX(
+                        BATCH_ADD(BATCH_MUL(vdx, vdx), BATCH_MUL(vdy, vdy)),
+                        vD
+                    );
+            }
+
+        /* Compute the diameters. */
+        vD = BATCH_SQRT(vD);
+
+        /* Divide the coordinates by the diameters (or set them to 0 if the
+         * diameter is 0). */
+        for (i = 0U; i < n; ++i)
+        {
+            BATCH_STORE(
+                X + i * B + b,
+                BATCH_DIV_NZ(BATCH_LOAD(X + i * B + b), vD)
+            );
+            BATCH_STORE(
+                Y + i * B + b,
+                BATCH_DIV_NZ(BATCH_LOAD(Y + i * B + b), vD)
+            );
+        }
+    }
+#endif /* _BATCH_SIMD */
+
+    /* Standardise the remaining polygons one by one. */
+    for (; b < B; ++b)
+    {
+        /* Initialise the squared diameter to 0. */
+        D = 0.0;
+
+        /* Find the largest squared distance between two points. */
+        for (i = 0U; i < n; ++i)
+            for (j = i + 1U; j < n; ++j)
+            {
+                /* Compute the squared distance. */
+                dx = *(X + j * B + b) - *(X + i * B + b);
+                dy = *(Y + j * B + b) - *(Y + i * B + b);
+                d = dx * dx + dy * dy;
+
+                /* Update the squared diameter. */
+                if (d > D)
+                    D = d;
+            }
+
+        /* Compute the diameter. */
+        D = rsqrt(D);
+
+        /* Divide the coordinates by the diameter (or set them to 0 if the
+         * diameter is 0). */
+        for (i = 0U; i < n; ++i)
+        {
+            if (D == 0.0)
+            {
+                *(X + i * B + b) = 0.0;
+                *(Y + i * B + b) = 0.0;
+            }
+            else
+            {
+                *(X + i * B + b) /= D;
+                *(Y + i * B + b) /= D;
+            }
+        }
+    }
+}
+
+/**
+ * Describe all polygons in a batch.
+ *
+ * The result for each polygon is the same as the result of the
+ * `describe_polygon` function: `dx[k * B + b]`, `dy[k * B + b]` and
+ * `l[k * B + b]` describe the edge from the `k`-th to the (`k` + 1)-th vertex
+ * of the `b`-th polygon, and `phi[k * B + b]` is the outer angle at its
+ * (`k` + 1)-th vertex.
+ *
+ * No memory locations may overlap to avoid unexpected results.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param B
+ *     Number of polygons.
+ *
+ * @param X
+ *     Array of x-coordinates of size at least `n` * `B`.
+ *
+ * @param Y
+ *     Array of y-coordinates of size at least `n` * `B`.
+ *
+ * @param dx
+ *     Array of size at least `n` * `B` for the differences in x-coordinates.
+ *
+ *     Caution: the array `dx` is mutated in the function.
+ *
+ * @param dy
+ *     Array of size at least `n` * `B` for the differences in y-coordinates.
+ *
+ *     Caution: the array `dy` is mutated in the function.
+ *
+ * @param l
+ *     Array of size at least `n` * `B` for the lengths of edges.
+ *
+ *     Caution: the array `l` is mutated in the function.
+ *
+ * @param phi
+ *     Array of size at least `n` * `B` for the outer angles.
+ *
+ *     Caution: the array `phi` is mutated in the function.
+ *
+ * @see describe_polygon
+ *
+ */
+void batch_describe_polygon (
+    size_t n,
+    size_t B,
+    const real_t* X,
+    const real_t* Y,
+    real_t* dx,
+    real_t* dy,
+    real_t* l,
+    real_t* phi
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+    size_t i;
+    size_t j;
+    size_t k;
+
+    /* Offsets of the rows. */
+    size_t I;
+    size_t J;
+    size_t K;
+
+#if defined(_BATCH_SIMD)
+    /* Vectors of differences in coordinates. */
+    batch_vector_t vdx;
+    batch_vector_t vdy;
+#endif /* _BATCH_SIMD */
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+    i = 0U;
+    j = 0U;
+    k = 0U;
+
+    /* Offsets of the rows. */
+    I = 0U;
+    J = 0U;
+    K = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, set the number `B` to 0. */
+    if (!(X && Y && dx && dy && l && phi))
+        B = 0U;
+
+    /* Compute the differences in coordinates and the lengths of edges. */
+    for (i = 0U; i < n; ++i)
+    {
+        /* Compute the offsets of the `i`-th and the (`i` + 1)-th row. */
+        I = i * B;
+        J = incmod(i, n) * B;
+
+#if defined(_BATCH_SIMD)
+        /* Process groups of `BATCH_LANES` polygons. */
+        for (b = 0U; b + BATCH_LANES <= B; b += BATCH_LANES)
+        {
+            /* Compute the differences in coordinates. */
+            vdx = BATCH_SUB(BATCH_LOAD(X + J + b), BATCH_LOAD(X + I + b));
+            vdy = BATCH_SUB(BATCH_LOAD(Y + J + b), BATCH_LOAD(Y + I + b));
+
+            /* Save the differences and compute the lengths of edges. */
+            BATCH_STORE(dx + I + b, vdx);
+            BATCH_STORE(dy + I + b, vdy);
+            BATCH_STORE(
+                l + I + b,
+                BATCH_SQRT(BATCH_ADD(BATCH_MUL(vdx, vdx), BATCH_MUL(vdy, vdy)))
+            );
+        }
+#else
+        /* Start with the first polygon. */
+        b = 0U;
+#endif /* _BATCH_SIMD */
+
+        /* Process the remaining polygons one by one. */
+        for (; b < B; ++b)
+        {
+            *(dx + I + b) = *(X + J + b) - *(X + I + b);
+            *(dy + I + b) = *(Y + J + b) - *(Y + I + b);
+            *(l + I + b) =
+                rsqrt(
+                    *(dx + I + b) * *(dx + I + b) +
+                        *(dy + I + b) * *(dy + I + b)
+                );
+        }
+    }
+
+    /* Compute the cosines of the outer angles. */
+    for (i = 0U; i < n; ++i)
+    {
+        /* Compute the offsets of the rows of the `i`-th and the
+         * (`i` + 1)-th edge. */
+        I = i * B;
+        J = incmod(i, n) * B;
+
+#if defined(_BATCH_SIMD)
+        /* Process groups of `BATCH_LANES` polygons. */
+        for (b = 0U; b + BATCH_LANES <= B; b += BATCH_LANES)
+            BATCH_STORE(
+                phi + I + b,
+                BATCH_DIV(
+                    BATCH_ADD(
+                        BATCH_MUL(BATCH_LOAD(dx + I + b), BATCH_LOAD(dx + J + b)),
+                        BATCH_MUL(BATCH_LOAD(dy + I + b), BATCH_LOAD(dy + J + b))
+                    ),
+                    BATCH_MUL(BATCH_LOAD(l + I + b), BATCH_LOAD(l + J + b))
+                )
+            );
+#else
+        /* Start with the first polygon. */
+        b = 0U;
+#endif /* _BATCH_SIMD */
+
+        /* Process the remaining polygons one by one. */
+        for (; b < B; ++b)
+            *(phi + I + b) =
+                (
+                    *(dx + I + b) * *(dx + J + b) +
+                        *(dy + I + b) * *(dy + J + b)
+                ) /
+                (*(l + I + b) * *(l + J + b));
+    }
+
+    /* Compute the outer angles from their cosines and orient them. */
+    for (i = 0U; i < n; ++i)
+    {
+        /* Compute the indices of the (`i` + 1)-th and the (`i` + 2)-th
+         * vertex. */
+        j = incmod(i, n);
+        k = incmod(j, n);
+
+        /* Compute the offsets of the rows. */
+        I = i * B;
+        K = k * B;
+
+        /* Compute the outer angles. */
+        for (b = 0U; b < B; ++b)
+        {
+            *(phi + I + b) = racos(*(phi + I + b));
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+            if (
+                rsign(
+                    *(dx + I + b) * (*(Y + K + b) - *(Y + I + b)) -
+                        (*(X + K + b) - *(X + I + b)) * *(dy + I + b)
+                ) == minus
+            )
+#else
+            if (
+                rsign(
+                    *(dx + I + b) * (*(Y + K + b) - *(Y + I + b)) -
+                        (*(X + K + b) - *(X + I + b)) * *(dy + I + b)
+                ) == sign_t::minus
+            )
+#endif /* __cplusplus */
+                *(phi + I + b) = -*(phi + I + b);
+        }
+    }
+}
+
+/**
+ * Characterise all triangles in a batch.
+ *
+ * The result for each triangle is the same as the result of the
+ * `char_triangle` function.  The arrays `l` and `phi` are organised as the
+ * arrays computed by the `batch_describe_polygon` function for `n` == 3.
+ *
+ * No memory locations may overlap to avoid unexpected results.
+ *
+ * @param B
+ *     Number of triangles.
+ *
+ * @param l
+ *     Array of the edges' lengths of size at least 3 * `B`.
+ *
+ * @param phi
+ *     Array of the outer angles of size at least 3 * `B`.
+ *
+ * @param x
+ *     Array of size at least `B` for the x-coordinates of the characteristic
+ *     points.
+ *
+ *     Caution: the array `x` is mutated in the function.
+ *
+ * @param y
+ *     Array of size at least `B` for the y-coordinates of the characteristic
+ *     points.
+ *
+ *     Caution: the array `y` is mutated in the function.
+ *
+ * @param norm
+ *     Are the triangles normed or not (see the `char_triangle` function).
+ *
+ * @see char_triangle
+ * @see batch_describe_polygon
+ *
+ */
+void batch_char_triangle (
+    size_t B,
+    const real_t* l,
+    const real_t* phi,
+    real_t* x,
+    real_t* y,
+    bool norm
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration index. */
+    size_t b;
+
+    /* Lengths of edges. */
+    real_t a;
+    real_t c;
+    real_t d;
+
+    /* Outer angles. */
+    real_t alpha;
+    real_t beta;
+    real_t gamma;
+
+    /* Auxiliary variable. */
+    real_t aux;
+
+#if defined(_BATCH_SIMD)
+    /* Vectors of lengths of edges. */
+    batch_vector_t va;
+    batch_vector_t vb;
+    batch_vector_t vc;
+
+    /* Vectors of outer angles. */
+    batch_vector_t valpha;
+    batch_vector_t vbeta;
+    batch_vector_t vgamma;
+
+    /* Auxiliary vector. */
+    batch_vector_t vaux;
+
+    /* Vector of comparison results. */
+    batch_mask_t m;
+#endif /* _BATCH_SIMD */
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration index. */
+    b = 0U;
+
+    /* Lengths of edges. */
+    a = 0.0;
+    c = 0.0;
+    d = 0.0;
+
+    /* Outer angles. */
+    alpha = 0.0;
+    beta = 0.0;
+    gamma = 0.0;
+
+    /* Auxiliary variable. */
+    aux = 0.0;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers `l`, `phi`, `x` and `y` is a null-pointer, set
+     * the number `B` to 0. */
+    if (!(l && phi && x && y))
+        B = 0U;
+
+    /* Order the edges and the angles, and compute the relative length of the
+     * edge `b`.  The values of b and gamma are temporarily saved in the arrays
+     * `x` and `y` respectively. */
+
+#if defined(_BATCH_SIMD)
+    /* Process groups of `BATCH_LANES` triangles. */
+    for (b = 0U; b + BATCH_LANES <= B; b += BATCH_LANES)
+    {
+        /* Initialise lengths of edges to given lengths. */
+        va = BATCH_ABS(BATCH_LOAD(l + b));
+        vb = BATCH_ABS(BATCH_LOAD(l + B + b));
+        vc = BATCH_ABS(BATCH_LOAD(l + (B << 1U) + b));
+
+        /* Initialise outer angles to given angles. */
+        valpha = BATCH_ABS(BATCH_LOAD(phi + B + b));
+        vbeta = BATCH_ABS(BATCH_LOAD(phi + (B << 1U) + b));
+        vgamma = BATCH_ABS(BATCH_LOAD(phi + b));
+
+        /* Where `a` < `b`, swap `a` and `b` and swap `alpha` and `beta`. */
+        m = BATCH_LT(va, vb);
+        vaux = va;
+        va = BATCH_BLEND(m, va, vb);
+        vb = BATCH_BLEND(m, vb, vaux);
+        vaux = valpha;
+        valpha = BATCH_BLEND(m, valpha, vbeta);
+        vbeta = BATCH_BLEND(m, vbeta, vaux);
+
+        /* Where `a` < `c`, swap `a` and `c` and swap `alpha` and `gamma`. */
+        m = BATCH_LT(va, vc);
+        vaux = va;
+        va = BATCH_BLEND(m, va, vc);
+        vc = BATCH_BLEND(m, vc, vaux);
+        vaux = valpha;
+        valpha = BATCH_BLEND(m, valpha, vgamma);
+        vgamma = BATCH_BLEND(m, vgamma, vaux);
+
+        /* Where `c` < `b`, swap `b` and `c` and swap `beta` and `gamma`. */
+        m = BATCH_LT(vc, vb);
+        vaux = vb;
+        vb = BATCH_BLEND(m, vb, vc);
+        vc = BATCH_BLEND(m, vc, vaux);
+        vaux = vbeta;
+        vbeta = BATCH_BLEND(m, vbeta, vgamma);
+        vgamma = BATCH_BLEND(m, vgamma, vaux);
+
+        /* If the triangles are not normed, divide `b` by `a` (or set it to 0 if
+         * `a` is 0). */
+        if (!norm)
+            vb = BATCH_DIV_NZ(vb, va);
+
+        /* Temporarily save `b` and `gamma`. */
+        BATCH_STORE(x + b, vb);
+        BATCH_STORE(y + b, vgamma);
+    }
+#endif /* _BATCH_SIMD */
+
+    /* Process the remaining triangles one by one. */
+    for (; b < B; ++b)
+    {
+        /* Initialise lengths of edges to given lengths.  Note that the
+         * variable `d` represents the edge b. */
+        a = rabs(*(l + b));
+        d = rabs(*(l + B + b));
+        c = rabs(*(l + (B << 1U) + b));
+
+        /* Initialise outer angles to given angles. */
+        alpha = rabs(*(phi + B + b));
+        beta = rabs(*(phi + (B << 1U) + b));
+        gamma = rabs(*(phi + b));
+
+        /* If `a` < `b`, swap `a` and `b` and swap `alpha` and `beta`. */
+        if (a < d)
+        {
+            aux = a;
+            a = d;
+            d = aux;
+            aux = alpha;
+            alpha = beta;
+            beta = aux;
+        }
+
+        /* If `a` < `c`, swap `a` and `c` and swap `alpha` and `gamma`. */
+        if (a < c)
+        {
+            aux = a;
+            a = c;
+            c = aux;
+            aux = alpha;
+            alpha = gamma;
+            gamma = aux;
+        }
+
+        /* If `c` < `b`, swap `b` and `c` and swap `beta` and `gamma`. */
+        if (c < d)
+        {
+            aux = d;
+            d = c;
+            c = aux;
+            aux = beta;
+            beta = gamma;
+            gamma = aux;
+        }
+
+        /* If the triangle is not normed, divide `b` by `a` if `a` is not 0. */
+        if (!norm)
+        {
+            if (a)
+                d /= a;
+            else
+                d = 0.0;
+        }
+
+        /* Temporarily save `b` and `gamma`. */
+        *(x + b) = d;
+        *(y + b) = gamma;
+    }
+
+    /* Compute the coordinates of the characteristic points.  Note that `gamma`
+     * represents the OUTER angle (see the `char_triangle` function). */
+    for (b = 0U; b < B; ++b)
+    {
+        /* Extract the saved values of `b` and `gamma`. */
+        d = *(x + b);
+        gamma = *(y + b);
+
+        /* Compute the coordinates of the characteristic point. */
+        *(x + b) = 0.5 + d * rcos(gamma);
+        *(y + b) = d * rsin(gamma);
+    }
+}
+
+/**
+ * Find the first line segment in a chain crossing a given line segment.
+ *
+ * The chain consists of the line segments from the point (`X[k]`, `Y[k]`) to
+ * the point (`X[k + 1]`, `Y[k + 1]`) for 0 <= k < `m`.  Crossing is defined as
+ * in the `segments_cross` function (touching and collinear line segments are
+ * not crossing).  The orientations of points are first computed in vector
+ * registers using the same error bound as the `orient2d` function.  Only the
+ * line segments for which any of the orientations is inconclusive are tested
+ * again using the `segments_cross` function, so the result is exact.
+ *
+ * @param a0
+ *     Coordinates of the first end-point of the given line segment (array of
+ *     size 2).
+ *
+ * @param a1
+ *     Coordinates of the second end-point of the given line segment (array of
+ *     size 2).
+ *
+ * @param m
+ *     Number of line segments in the chain.
+ *
+ * @param X
+ *     Array of x-coordinates of the points of the chain of size at least
+ *     `m` + 1.
+ *
+ * @param Y
+ *     Array of y-coordinates of the points of the chain of size at least
+ *     `m` + 1.
+ *
+ * @return
+ *     Index k of the first line segment in the chain crossing the given line
+ *     segment, or `m` if no line segment is crossing it.  If any of the
+ *     pointers is a null-pointer, `m` is returned.
+ *
+ * @see segments_cross
+ * @see orient2d
+ *
+ */
+size_t batch_segment_crossing (
+    const real_t* a0,
+    const real_t* a1,
+    size_t m,
+    const real_t* X,
+    const real_t* Y
+)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Index of the first crossing line segment. */
+    size_t crossing;
+
+    /* Iteration index. */
+    size_t k;
+
+    /* Coordinates of the end-points of a line segment in the chain. */
+    real_t b0[2U];
+    real_t b1[2U];
+
+#if defined(_BATCH_SIMD)
+    /* Vectors of the coordinates of the end-points of the line segments in the
+     * chain. */
+    batch_vector_t vx0;
+    batch_vector_t vy0;
+    batch_vector_t vx1;
+    batch_vector_t vy1;
+
+    /* Vectors of the products in the determinants and of the determinants. */
+    batch_vector_t vleft;
+    batch_vector_t vright;
+    batch_vector_t vdet[4U];
+
+    /* Vectors of the zeros and of the error bounds. */
+    batch_vector_t vzero;
+    batch_vector_t verr;
+
+    /* Bits of the negative and the positive determinants. */
+    int neg[4U];
+    int pos[4U];
+
+    /* Bits of the crossing line segments and of the inconclusive line
+     * segments. */
+    int cross;
+    int unsure;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t l;
+#endif /* _BATCH_SIMD */
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Index of the first crossing line segment. */
+    crossing = m;
+
+    /* Iteration index. */
+    k = 0U;
+
+    /* Coordinates of the end-points of a line segment in the chain. */
+    memset(b0, 0, 2U * sizeof *b0);
+    memset(b1, 0, 2U * sizeof *b1);
+
+#if defined(_BATCH_SIMD)
+    /* Vectors of the zeros and of the error bounds. */
+    vzero = BATCH_SET1(0.0);
+    verr = BATCH_SET1(predicate_err_bound);
+
+    /* Bits of the negative and the positive determinants. */
+    memset(neg, 0, 4U * sizeof *neg);
+    memset(pos, 0, 4U * sizeof *pos);
+
+    /* Bits of the crossing line segments and of the inconclusive line
+     * segments. */
+    cross = 0;
+    unsure = 0;
+
+    /* Iteration indices. */
+    i = 0U;
+    l = 0U;
+#endif /* _BATCH_SIMD */
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, set the number `m` to 0. */
+    if (!(a0 && a1 && X && Y))
+        m = 0U;
+
+#if defined(_BATCH_SIMD)
+    /* Test groups of `BATCH_LANES` line segments. */
+    for (k = 0U; crossing == m && k + BATCH_LANES <= m; k += BATCH_LANES)
+    {
+        /* Load the coordinates of the end-points of the line segments. */
+        vx0 = BATCH_LOAD(X + k);
+        vy0 = BATCH_LOAD(Y + k);
+        vx1 = BATCH_LOAD(X + k + 1U);
+        vy1 = BATCH_LOAD(Y + k + 1U);
+
+        /* Compute the determinants of the orientations of the points A_0 and
+         * A_1 with respect to the line segments (the point A_i is the point
+         * "c" in the `orient2d` function).  The determinants are conclusive
+         * if they are not smaller than the error bounds. */
+        for (i = 0U; i < 2U; ++i)
+        {
+            vleft =
+                BATCH_MUL(
+                    BATCH_SUB(vx0, BATCH_SET1(*(i ? a1 : a0))),
+                    BATCH_SUB(vy1, BATCH_SET1(*((i ? a1 : a0) + 1U)))
+                );
+            vright =
+                BATCH_MUL(
+                    BATCH_SUB(vy0, BATCH_SET1(*((i ? a1 : a0) + 1U))),
+                    BATCH_SUB(vx1, BATCH_SET1(*(i ? a1 : a0)))
+                );
+            vdet[i] = BATCH_SUB(vleft, vright);
+            unsure |=
+                BATCH_BITS(
+                    BATCH_LT(
+                        BATCH_ABS(vdet[i]),
+                        BATCH_MUL(
+                            verr,
+                            BATCH_ADD(BATCH_ABS(vleft), BATCH_ABS(vright))
+                        )
+                    )
+                );
+        }
+
+        /* Compute the determinants of the orientations of the end-points of
+         * the line segments with respect to the line A_0 A_1 (the end-points
+         * are the points "c" in the `orient2d` function). */
+        for (i = 2U; i < 4U; ++i)
+        {
+            vleft =
+                BATCH_MUL(
+                    BATCH_SUB(BATCH_SET1(*a0), (i == 2U) ? vx0 : vx1),
+                    BATCH_SUB(BATCH_SET1(*(a1 + 1U)), (i == 2U) ? vy0 : vy1)
+                );
+            vright =
+                BATCH_MUL(
+                    BATCH_SUB(BATCH_SET1(*(a0 + 1U)), (i == 2U) ? vy0 : vy1),
+                    BATCH_SUB(BATCH_SET1(*a1), (i == 2U) ? vx0 : vx1)
+                );
+            vdet[i] = BATCH_SUB(vleft, vright);
+            unsure |=
+                BATCH_BITS(
+                    BATCH_LT(
+                        BATCH_ABS(vdet[i]),
+                        BATCH_MUL(
+                            verr,
+                            BATCH_ADD(BATCH_ABS(vleft), BATCH_ABS(vright))
+                        )
+                    )
+                );
+        }
+
+        /* Extract the signs of the determinants. */
+        for (i = 0U; i < 4U; ++i)
+        {
+            neg[i] = BATCH_BITS(BATCH_LT(vdet[i], vzero));
+            pos[i] = BATCH_BITS(BATCH_LT(vzero, vdet[i]));
+        }
+
+        /* The line segments are crossing if both pairs of points are strictly
+         * on the opposite sides. */
+        cross =
+            ((neg[0U] & pos[1U]) | (pos[0U] & neg[1U])) &
+            ((neg[2U] & pos[3U]) | (pos[2U] & neg[3U]));
+
+        /* Find the first crossing line segment in the group.  The inconclusive
+         * line segments are tested exactly. */
+        for (l = 0U; crossing == m && (cross | unsure) && l < BATCH_LANES; ++l)
+        {
+            /* If the line segment is inconclusive, test it exactly. */
+            if ((unsure >> l) & 1)
+            {
+                *b0 = *(X + k + l);
+                *(b0 + 1U) = *(Y + k + l);
+                *b1 = *(X + k + l + 1U);
+                *(b1 + 1U) = *(Y + k + l + 1U);
+                if (segments_cross(a0, a1, b0, b1))
+                    crossing = k + l;
+            }
+
+            /* Otherwise check the vector result. */
+            else if ((cross >> l) & 1)
+                crossing = k + l;
+        }
+
+        /* Reset the bits of the inconclusive line segments. */
+        unsure = 0;
+    }
+#endif /* _BATCH_SIMD */
+
+    /* Test the remaining line segments one by one. */
+    for (; crossing == m && k < m; ++k)
+    {
+        *b0 = *(X + k);
+        *(b0 + 1U) = *(Y + k);
+        *b1 = *(X + k + 1U);
+        *(b1 + 1U) = *(Y + k + 1U);
+        if (segments_cross(a0, a1, b0, b1))
+            crossing = k;
+    }
+
+    /* Return the index of the first crossing line segment. */
+    return crossing;
+}
+
+/**
+ * Check if an array of points is an ordered set of true vertices of a polygon.
+ *
+ * The result is the same as the result of the `check_polygon` function, but
+ * the coordinates are first copied into two contiguous arrays and each edge is
+ * tested against the block of the successive non-neighbouring edges using the
+ * `batch_segment_crossing` function.  If the memory for the arrays cannot be
+ * allocated, the `check_polygon` function is called instead.
+ *
+ * @param n
+ *     Number of points.
+ *
+ * @param P
+ *     Array of points of size at least 2 * `n`.  The array is organised as
+ *     `{x_0, y_0, x_1, y_1, ..., x_n_minus_1, y_n_minus_1}`, where `x_i` is the
+ *     x-coordinate of the `i`-th point and `y_i` is its y-coordinate.  Note
+ *     that the first and the last points are neighbouring.
+ *
+ * @return
+ *     Value `true` if `P` is not a null-pointer, the number of points is at
+ *     least 3, no three consecutive points are on the same line and no two
+ *     line segments that do not share a same end-point intersect; otherwise
+ *     value `false`.
+ *
+ * @see check_polygon
+ * @see batch_segment_crossing
+ *
+ */
+bool batch_check_polygon (size_t n, const real_t* P)
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Answer. */
+    bool answer;
+
+    /* Arrays of x-coordinates and y-coordinates of the points (the first
+     * point is repeated at the end). */
+    real_t* X;
+    real_t* Y;
+
+    /* Number of the non-neighbouring successive edges. */
+    size_t m;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Answer. */
+    answer = false;
+
+    /* Arrays of x-coordinates and y-coordinates of the points. */
+    X = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+
+    /* Number of the non-neighbouring successive edges. */
+    m = 0U;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* To avoid using the `goto` command and additional `return` commands, the
+     * algorithm is enclosed in a `do while`-loop with a false terminating
+     * statement. */
+    do
+    {
+        /* If the pointer `P` is a null-pointer or if the number of points is
+         * strictly less than 3, break the `do while`-loop. */
+        if (!P || n < 3U)
+            break;
+
+        /* Allocate memory for the arrays of coordinates. */
+        X = (real_t*)malloc(((n + 1U) << 1U) * sizeof *X);
+
+        /* If the memory allocation has failed, check the polygon using the
+         * `check_polygon` function and break the `do while`-loop. */
+        if (!X)
+        {
+            /* Check the polygon. */
+            answer = check_polygon(n, P);
+
+            /* Break the `do while`-loop. */
+            break;
+        }
+
+        /* Initialise the arrays of coordinates to zeros. */
+        memset(X, 0, ((n + 1U) << 1U) * sizeof *X);
+        Y = X + n + 1U;
+
+        /* Copy the coordinates. */
+        for (i = 0U; i < n; ++i)
+        {
+            *(X + i) = *(P + (i << 1U));
+            *(Y + i) = *(P + (i << 1U) + 1U);
+        }
+        *(X + n) = *X;
+        *(Y + n) = *Y;
+
+        /* Initialise the answer to `true` (assume the points define a true
+         * polygon). */
+        answer = true;
+
+        /* Iterate over the points.  If the answer becomes `false`, immediately
+         * break the `for`-loop. */
+        for (i = 0U; answer && i < n; ++i)
+        {
+            /* If the points P_i and P_(i + 1) are coordinately the same, or if
+             * the point P_i is on the line through its neighbouring points, set
+             * the answer to `false` and break the `for`-loop. */
+            if (
+                (
+                    *(P + (incmod(i, n) << 1U)) == *(P + (i << 1U)) &&
+                    *(P + (incmod(i, n) << 1U) + 1U) == *(P + (i << 1U) + 1U)
+                ) ||
+#if !defined(__cplusplus)
+                !(int)orient2d(
+#else
+                !static_cast<int>(orient2d(
+#endif /* __cplusplus */
+                    P + (decmod(i, n) << 1U),
+                    P + (i << 1U),
+                    P + (incmod(i, n) << 1U)
+#if !defined(__cplusplus)
+                )
+#else
+                ))
+#endif /* __cplusplus */
+            )
+            {
+                /* Set the answer to `false`. */
+                answer = false;
+
+                /* Break the `for`-loop. */
+                break;
+            }
+
+            /* Compute the number of the successive edges not neighbouring the
+             * edge P_i P_(i + 1) (the last edge neighbours the 0th edge). */
+            m = (i + 2U < n) ? n - i - 2U : 0U;
+            if (!i)
+                --m;
+
+            /* If any of the successive non-neighbouring edges crosses the edge
+             * P_i P_(i + 1), set the answer to `false`. */
+            if (
+                m &&
+                batch_segment_crossing(
+                    P + (i << 1U),
+                    P + (incmod(i, n) << 1U),
+                    m,
+                    X + i + 2U,
+                    Y + i + 2U
+                ) != m
+            )
+                answer = false;
+        }
+
+        /* Clear the memory in the arrays of coordinates. */
+        memset(X, 0, ((n + 1U) << 1U) * sizeof *X);
+
+        /* Deallocate memory for the arrays of coordinates. */
+        free(X);
+        X = (real_t*)(NULL);
+        Y = (real_t*)(NULL);
+    }
+    while (false);
+
+    /* Return the answer. */
+    return answer;
+}
+
+#endif /* __BATCH_H__INCLUDED */
@@ -0,0 +1,540 @@
+/**
+ * Analytic bounds and estimates of the first Laplace eigenvalue on convex
+ * polygons.
+ *
+ * The bounds are computed in closed form from the area S, the perimeter L, the
+ * inradius rho and the diameter D of the polygon, so they are by orders of
+ * magnitude cheaper than any numerical solution.  The first Dirichlet
+ * eigenvalue lambda of a convex polygon satisfies
+ *     max { pi j_0^2 / S, pi^2 / (4 rho^2) } <= lambda,
+ *     lambda <= min { pi^2 L^2 / (4 S^2), j_0^2 / rho^2 },
+ * where j_0 is the first zero of the Bessel function J_0:  the lower bounds
+ * are the Faber-Krahn inequality (the disc of the same area has the smallest
+ * eigenvalue) and Hersch's inequality for convex domains, and the upper bounds
+ * are Polya's inequality for convex domains and the domain monotonicity
+ * applied to the incircle.  The point estimate is the geometric mean of the
+ * bounds, which is off by at most the factor sqrt(upper / lower) (on the
+ * triangles of "data/numerical/test" the bracket is about a factor of 2 wide
+ * and the estimate is typically within 5 %).
+ *
+ * The bounds are intended as a cheap tier before any numerical solution:  to
+ * screen out degenerate polygons, to sanity-check computed eigenvalues (see
+ * the function `bounds_check`) and to start the iterative solvers at tight
+ * shifts (see "mps.h").
+ *
+ * Only convex polygons with vertices in the mathematically positive order are
+ * supported (no three consecutive vertices may be collinear).
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__BOUNDS_H__INCLUDED) && (__BOUNDS_H__INCLUDED) == 1)
+
+/* Undefine __BOUNDS_H__INCLUDED if it has already been defined. */
+#if defined(__BOUNDS_H__INCLUDED)
+#undef __BOUNDS_H__INCLUDED
+#endif /* __BOUNDS_H__INCLUDED */
+
+/* Define __BOUNDS_H__INCLUDED as 1. */
+#define __BOUNDS_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+
+/* Define constants. */
+
+/**
+ * Ratio of the area to the squared diameter below which a polygon is
+ * considered degenerate (2^6 relative tolerances `tolerance` from "numeric.h",
+ * approximately 9.1e-13 for `double`).
+ *
+ */
+#define BOUNDS_DEGENERACY (64.0 * tolerance)
+
+/**
+ * Relative slack of the bounds in the function `bounds_check` (the bounds are
+ * rigorous, the slack only absorbs the rounding errors).  The slack is the
+ * larger of 1.0e-9, the relative rounding error of eigenvalues stored with 8
+ * decimals, and 2^6 relative tolerances `tolerance` from "numeric.h" (the
+ * rounding error of the bounds themselves, larger in `float`).
+ *
+ */
+#define BOUNDS_SLACK \
+    ((1.0e-9 < 64.0 * tolerance) ? 64.0 * tolerance : 1.0e-9)
+
+/* Define types. */
+
+/**
+ * Geometric quantities of a polygon and the bounds and the estimate of its
+ * first eigenvalue.
+ *
+ */
+typedef struct bounds_struct
+{
+    /* Area and perimeter. */
+    real_t area;
+    real_t perimeter;
+
+    /* Radius and coordinates of the centre of the largest inscribed
+     * circle. */
+    real_t inradius;
+    real_t cx;
+    real_t cy;
+
+    /* Diameter. */
+    real_t diameter;
+
+    /* Lower and upper bound and the point estimate of the first
+     * eigenvalue. */
+    real_t lower;
+    real_t upper;
+    real_t estimate;
+}
+bounds_t;
+
+/* Define functions. */
+
+/**
+ * Compute the line of an edge of a polygon.
+ *
+ * The line is represented as a x + b y = c, where (a, b) is the inner unit
+ * normal of the edge, so that a x + b y - c is the signed distance of a point
+ * (x, y) from the line (positive inside a polygon in the mathematically
+ * positive order).
+ *
+ * @param n
+ *     Number of vertices.
+ *
+ * @param P
+ *     Array of vertices of size at least 2 * `n` organised as in the
+ *     `describe_polygon` function.
+ *
+ * @param k
+ *     Index of the edge (from the `k`-th to the next vertex).
+ *
+ * @param a
+ *     Memory location to store the x-coordinate of the normal.
+ *
+ * @param b
+ *     Memory location to store the y-coordinate of the normal.
+ *
+ * @param c
+ *     Memory location to store the right-hand side.
+ *
+ * @see describe_polygon
+ *
+ */
+#if !defined(__cplusplus)
+void bounds_line (
+    size_t n,
+    const real_t* P,
+    size_t k,
+    real_t* a,
+    real_t* b,
+    real_t* c
+)
+#else
+inline void bounds_line (
+    ::size_t n,
+    const real_t* P,
+    ::size_t k,
+    real_t* a,
+    real_t* b,
+    real_t* c
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Differences of coordinates and length of the edge. */
+    real_t dx;
+    real_t dy;
+    real_t l;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Differences of coordinates and length of the edge. */
+    dx = *(P + (incmod(k, n) << 1U)) - *(P + (k << 1U));
+    dy = *(P + (incmod(k, n) << 1U) + 1U) - *(P + (k << 1U) + 1U);
+    l = rsqrt(dx * dx + dy * dy);
+
+    /* ALGORITHM */
+
+    /* Compute the line. */
+    *a = -dy / l;
+    *b = dx / l;
+    *c = *a * *(P + (k << 1U)) + *b * *(P + (k << 1U) + 1U);
+}
+
+/**
+ * Compute the bounds and the estimate of the first eigenvalue of a polygon.
+ *
+ * The inradius is the largest distance from the boundary of a point inside the
+ * polygon.  The distance from the boundary of a convex polygon is the minimum
+ * of the (concave) distances from the lines of the edges, so its maximum is
+ * attained at a point equidistant from three of the lines;  all triples of
+ * edges are therefore tried, which is O(n^4) but negligible for the polygons
+ * of the package (for triangles there is only one triple, the incircle).
+ *
+ * @param n
+ *     Number of vertices (at least 3).
+ *
+ * @param P
+ *     Array of vertices of size at least 2 * `n` organised as in the
+ *     `describe_polygon` function.
+ *
+ * @param B
+ *     Memory location to store the quantities of the polygon.
+ *
+ * @return
+ *     Value `true` if the bounds were computed, `false` if the polygon is not
+ *     convex or not in the mathematically positive order, or if it is
+ *     degenerate (see the macro `BOUNDS_DEGENERACY`).  If `false` is returned,
+ *     the memory location `B` is filled with zeros.
+ *
+ * @see describe_polygon
+ * @see diameter_polygon
+ *
+ */
+#if !defined(__cplusplus)
+bool bounds_polygon (size_t n, const real_t* P, bounds_t* B)
+#else
+inline bool bounds_polygon (::size_t n, const real_t* P, bounds_t* B)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Numerical approximation of the mathematical constant pi. */
+    const real_t pi =
+        3.1415926535897932384626433832795028841971693993751058209749445923;
+
+    /* The first zero of the Bessel function J_0. */
+    const real_t j0 = 2.4048255576957727686216318793264546431242449091460;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Differences of coordinates of two consecutive edges. */
+    real_t ex;
+    real_t ey;
+    real_t fx;
+    real_t fy;
+
+    /* Lines of three edges. */
+    real_t ai;
+    real_t bi;
+    real_t ci;
+    real_t aj;
+    real_t bj;
+    real_t cj;
+    real_t ak;
+    real_t bk;
+    real_t ck;
+
+    /* Line of an arbitrary edge. */
+    real_t am;
+    real_t bm;
+    real_t cm;
+
+    /* Determinant of the system and the point equidistant from the lines. */
+    real_t D;
+    real_t x;
+    real_t y;
+
+    /* Distance of the point from the boundary. */
+    real_t r;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t k;
+    size_t m;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Differences of coordinates of two consecutive edges. */
+    ex = 0.0;
+    ey = 0.0;
+    fx = 0.0;
+    fy = 0.0;
+
+    /* Lines of three edges. */
+    ai = 0.0;
+    bi = 0.0;
+    ci = 0.0;
+    aj = 0.0;
+    bj = 0.0;
+    cj = 0.0;
+    ak = 0.0;
+    bk = 0.0;
+    ck = 0.0;
+
+    /* Line of an arbitrary edge. */
+    am = 0.0;
+    bm = 0.0;
+    cm = 0.0;
+
+    /* Determinant of the system and the point equidistant from the lines. */
+    D = 0.0;
+    x = 0.0;
+    y = 0.0;
+
+    /* Distance of the point from the boundary. */
+    r = 0.0;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    k = 0U;
+    m = 0U;
+
+    /* ALGORITHM */
+
+    /* If the pointer `B` is a null-pointer, return `false`. */
+    if (!B)
+        return false;
+
+    /* Initialise the quantities to zeros. */
+    memset(B, 0, sizeof *B);
+
+    /* If the pointer `P` is a null-pointer or if there are less than 3
+     * vertices, return `false`. */
+    if (!(P && n >= 3U))
+        return false;
+
+    /* Check the convexity (all turns must be strictly to the left) and compute
+     * the area and the perimeter. */
+    for (k = 0U; k < n; ++k)
+    {
+        ex = *(P + (incmod(k, n) << 1U)) - *(P + (k << 1U));
+        ey = *(P + (incmod(k, n) << 1U) + 1U) - *(P + (k << 1U) + 1U);
+        fx =
+            *(P + (incmod(incmod(k, n), n) << 1U)) -
+            *(P + (incmod(k, n) << 1U));
+        fy =
+            *(P + (incmod(incmod(k, n), n) << 1U) + 1U) -
+            *(P + (incmod(k, n) << 1U) + 1U);
+        if (!(0.0 < ex * fy - ey * fx))
+        {
+            memset(B, 0, sizeof *B);
+
+            return false;
+        }
+        B->area += *(P + (k << 1U)) * ey - *(P + (k << 1U) + 1U) * ex;
+        B->perimeter += rsqrt(ex * ex + ey * ey);
+    }
+    B->area *= 0.5;
+
+    /* Compute the diameter and screen out degenerate polygons. */
+    B->diameter = diameter_polygon(n, P, false);
+    if (!(B->area > BOUNDS_DEGENERACY * B->diameter * B->diameter))
+    {
+        memset(B, 0, sizeof *B);
+
+        return false;
+    }
+
+    /* Find the largest inscribed circle among the circles tangent to the lines
+     * of three edges. */
+    for (i = 0U; i < n; ++i)
+    {
+        bounds_line(n, P, i, &ai, &bi, &ci);
+        for (j = i + 1U; j < n; ++j)
+        {
+            bounds_line(n, P, j, &aj, &bj, &cj);
+            for (k = j + 1U; k < n; ++k)
+            {
+                bounds_line(n, P, k, &ak, &bk, &ck);
+
+                /* Solve the system a x + b y - r = c for the three lines by
+                 * eliminating r. */
+                D = (ai - aj) * (bi - bk) - (bi - bj) * (ai - ak);
+                if (D == 0.0)
+                    continue;
+                x = ((ci - cj) * (bi - bk) - (bi - bj) * (ci - ck)) / D;
+                y = ((ai - aj) * (ci - ck) - (ci - cj) * (ai - ak)) / D;
+
+                /* Compute the distance of the point from the boundary. */
+                r = lambda;
+                for (m = 0U; m < n; ++m)
+                {
+                    bounds_line(n, P, m, &am, &bm, &cm);
+                    r = rmin(r, am * x + bm * y - cm);
+                }
+
+                /* Update the largest circle. */
+                if (r > B->inradius)
+                {
+                    B->inradius = r;
+                    B->cx = x;
+                    B->cy = y;
+                }
+            }
+        }
+    }
+    if (!(0.0 < B->inradius))
+    {
+        memset(B, 0, sizeof *B);
+
+        return false;
+    }
+
+    /* Compute the bounds and the estimate. */
+    B->lower = rmax(
+        pi * j0 * j0 / B->area,
+        pi * pi / (4.0 * B->inradius * B->inradius)
+    );
+    B->upper = rmin(
+        pi * pi * B->perimeter * B->perimeter / (4.0 * B->area * B->area),
+        j0 * j0 / (B->inradius * B->inradius)
+    );
+    B->estimate = rsqrt(B->lower * B->upper);
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Check if an eigenvalue is consistent with the bounds.
+ *
+ * @param B
+ *     Pointer to the quantities of a polygon computed by the function
+ *     `bounds_polygon`.
+ *
+ * @param ev
+ *     Eigenvalue to check.
+ *
+ * @return
+ *     Value `true` if the eigenvalue is between the bounds (up to the relative
+ *     slack `BOUNDS_SLACK`), `false` otherwise.
+ *
+ * @see bounds_polygon
+ *
+ */
+#if !defined(__cplusplus)
+bool bounds_check (const bounds_t* B, real_t ev)
+#else
+inline bool bounds_check (const bounds_t* B, real_t ev)
+#endif /* __cplusplus */
+{
+    /* If the pointer `B` is a null-pointer or if the bounds were not
+     * computed, return `false`. */
+    if (!(B && 0.0 < B->lower))
+        return false;
+
+    /* Return the answer. */
+    return
+        B->lower * (1.0 - BOUNDS_SLACK) <= ev &&
+        ev <= B->upper * (1.0 + BOUNDS_SLACK);
+}
+
+/**
+ * Compute the bounds and the estimates of the first eigenvalues of polygons.
+ *
+ * For each polygon the values
+ *     lower, upper, estimate, delta
+ * are saved, where delta = sqrt(upper / lower) - 1 is the largest possible
+ * relative error of the estimate.  All four values are the undefined real
+ * number for unsupported polygons.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param N
+ *     Number of polygons.
+ *
+ * @param P
+ *     Array of vertices of size at least `N` * 2 * `n` organised as in the
+ *     `dump_polygons` function.
+ *
+ * @param E
+ *     Array of size at least 4 * `N` to store the values.
+ *
+ * @return
+ *     Number of unsupported polygons.
+ *
+ * @see bounds_polygon
+ * @see dump_polygons
+ *
+ */
+#if !defined(__cplusplus)
+size_t bounds_batch (size_t n, size_t N, const real_t* P, real_t* E)
+#else
+inline ::size_t bounds_batch (
+    ::size_t n,
+    ::size_t N,
+    const real_t* P,
+    real_t* E
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Quantities of a polygon. */
+    bounds_t B;
+
+    /* Number of unsupported polygons. */
+    size_t failed;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Quantities of a polygon. */
+    memset(&B, 0, sizeof B);
+
+    /* Number of unsupported polygons. */
+    failed = 0U;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* Compute the values polygon by polygon. */
+    for (i = 0U; i < N; ++i)
+    {
+        if (bounds_polygon(n, P + ((i * n) << 1U), &B))
+        {
+            *(E + (i << 2U)) = B.lower;
+            *(E + (i << 2U) + 1U) = B.upper;
+            *(E + (i << 2U) + 2U) = B.estimate;
+            *(E + (i << 2U) + 3U) = rsqrt(B.upper / B.lower) - 1.0;
+        }
+        else
+        {
+            *(E + (i << 2U)) = lambda;
+            *(E + (i << 2U) + 1U) = lambda;
+            *(E + (i << 2U) + 2U) = lambda;
+            *(E + (i << 2U) + 3U) = lambda;
+            ++failed;
+        }
+    }
+
+    /* Return the number of unsupported polygons. */
+    return failed;
+}
+
+#endif /* __BOUNDS_H__INCLUDED */
@@ -0,0 +1,920 @@
+/**
+ * Batched inference of convolutional neural networks by BLAS.
+ *
+ * A network maps an image of H x W pixels of C channels (stored by rows of
+ * pixels and with the channels of a pixel stored consecutively, the NHWC order
+ * of Keras' "channels_last" format) through L convolutional layers.  The l-th
+ * layer has a kernel of kh x kw pixels, strides sh and sw, f filters, the
+ * padding p (`CNN_VALID` or `CNN_SAME` as in Keras) and an activation a (the
+ * codes are the same as in "mlp.h").  A dense layer following a flattening is
+ * a convolutional layer with the kernel of the size of its input and no
+ * padding, and a dense layer of a 1 x 1 image is a 1 x 1 convolutional layer,
+ * so the convolutional neural network of the script "MST_CNN.py" is exported
+ * by the script "cnn_exporter.py" as a single row of values
+ *     H	W	C	L	kh_1	kw_1	sh_1	sw_1	p_1	f_1	a_1	...
+ *         kh_L	kw_L	sh_L	sw_L	p_L	f_L	a_L	K_1	b_1	...	K_L	b_L
+ * where each kernel K_l is stored in Keras' order (kh, kw, C, f) and b_l is
+ * the bias of the layer.  The normalisation factor of the images (see the
+ * notebook "Models.ipynb") is multiplied into the first kernel, so the images
+ * are given to the network as they are rasterised.
+ *
+ * A convolution is computed as a matrix product:  the patches of the input
+ * under the kernel at a tile of `CNN_TILE` output pixels are copied as rows of
+ * a matrix (im2col) and multiplied by the kernel, which in Keras' order
+ * already is a matrix of kh kw C rows and f columns, by a single call of the
+ * BLAS routine xGEMM into the tile of the output initialised to the bias.  The
+ * activation is applied while the tile is still in the cache.  If the patches
+ * are the rows of the input itself (a 1 x 1 kernel with unit strides or a
+ * kernel of the size of the input), the input is multiplied directly.  Images
+ * are split among POSIX threads as in the function `mlp_batch` (see
+ * "mlp.h").
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__CNN_H__INCLUDED) && (__CNN_H__INCLUDED) == 1)
+
+/* Undefine __CNN_H__INCLUDED if it has already been defined. */
+#if defined(__CNN_H__INCLUDED)
+#undef __CNN_H__INCLUDED
+#endif /* __CNN_H__INCLUDED */
+
+/* Define __CNN_H__INCLUDED as 1. */
+#define __CNN_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import POSIX threads. */
+#include <pthread.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "mlp.h"
+
+/* Define constants. */
+
+/**
+ * Code of the padding "valid" (no padding).
+ *
+ */
+#define CNN_VALID 0
+
+/**
+ * Code of the padding "same" (the output has ceil(H / sh) x ceil(W / sw)
+ * pixels and the input is padded by zeros evenly, with the extra row or column
+ * at the bottom or on the right).
+ *
+ */
+#define CNN_SAME 1
+
+/**
+ * Number of values describing a layer in the header.
+ *
+ */
+#define CNN_LAYER 7U
+
+/**
+ * Number of output pixels of a tile.
+ *
+ */
+#define CNN_TILE 256U
+
+/* Define types. */
+
+/**
+ * Job of a thread evaluating a network.
+ *
+ */
+typedef struct cnn_job_struct
+{
+    /* Exported network. */
+    const real_t* F;
+
+    /* Number of images. */
+    size_t N;
+
+    /* Images and outputs. */
+    const real_t* X;
+    real_t* Y;
+
+    /* Indicator of a successful evaluation. */
+    bool done;
+}
+cnn_job_t;
+
+/* Define functions. */
+
+/**
+ * Compute the number of output pixels of a convolution along an axis.
+ *
+ * @param n
+ *     Number of input pixels.
+ *
+ * @param k
+ *     Size of the kernel.
+ *
+ * @param s
+ *     Stride.
+ *
+ * @param p
+ *     Code of the padding (`CNN_VALID` or `CNN_SAME`).
+ *
+ * @return
+ *     Number of output pixels, or 0 if the kernel is larger than the input
+ *     without padding.
+ *
+ */
+#if !defined(__cplusplus)
+size_t cnn_output_size (size_t n, size_t k, size_t s, int p)
+#else
+inline ::size_t cnn_output_size (::size_t n, ::size_t k, ::size_t s, int p)
+#endif /* __cplusplus */
+{
+    return
+        (p == CNN_SAME) ? (n + s - 1U) / s : ((n < k) ? 0U : (n - k) / s + 1U);
+}
+
+/**
+ * Compute the padding before the first pixel of a convolution along an axis.
+ *
+ * @param n
+ *     Number of input pixels.
+ *
+ * @param k
+ *     Size of the kernel.
+ *
+ * @param s
+ *     Stride.
+ *
+ * @param p
+ *     Code of the padding (`CNN_VALID` or `CNN_SAME`).
+ *
+ * @return
+ *     Number of zeros padded before the first pixel.
+ *
+ */
+#if !defined(__cplusplus)
+size_t cnn_padding (size_t n, size_t k, size_t s, int p)
+#else
+inline ::size_t cnn_padding (::size_t n, ::size_t k, ::size_t s, int p)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of pixels covered by the kernels. */
+    size_t m;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of pixels covered by the kernels. */
+    m = 0U;
+
+    /* ALGORITHM */
+
+    /* Without padding, return 0. */
+    if (!(p == CNN_SAME))
+        return 0U;
+
+    /* Return a half of the total padding (rounded down). */
+    m = (cnn_output_size(n, k, s, p) - 1U) * s + k;
+
+    return (m > n) ? (m - n) >> 1U : 0U;
+}
+
+/**
+ * Compute the length of an exported network from its header.
+ *
+ * @param F
+ *     Array of the exported network (see the description of the header).  Only
+ *     the first 4 + `CNN_LAYER` L values are read.
+ *
+ * @param a
+ *     Memory location to store the largest number of values of an image
+ *     between the layers (may be a null-pointer).
+ *
+ * @param k
+ *     Memory location to store the largest number of values of a patch (may be
+ *     a null-pointer).
+ *
+ * @param o
+ *     Memory location to store the number of values of the output (may be a
+ *     null-pointer).
+ *
+ * @return
+ *     Number of values of the exported network, or 0 if the header is not
+ *     valid (any of the sizes, the strides or the numbers of filters is not a
+ *     positive integer, any of the paddings or the activations is unknown or
+ *     the input of a layer is smaller than its kernel without padding).
+ *
+ */
+#if !defined(__cplusplus)
+size_t cnn_length (const real_t* F, size_t* a, size_t* k, size_t* o)
+#else
+inline ::size_t cnn_length (
+    const real_t* F,
+    ::size_t* a,
+    ::size_t* k,
+    ::size_t* o
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of layers and the pointer to the description of a layer. */
+    size_t L;
+    const real_t* q;
+
+    /* Sizes of the image, sizes of the kernel, strides and the number of
+     * filters. */
+    size_t H;
+    size_t W;
+    size_t C;
+    size_t kh;
+    size_t kw;
+    size_t sh;
+    size_t sw;
+    size_t f;
+
+    /* Largest number of values of an image and of a patch. */
+    size_t a_max;
+    size_t k_max;
+
+    /* Number of values. */
+    size_t length;
+
+    /* Iteration indices. */
+    size_t l;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of layers and the pointer to the description of a layer. */
+    L = 0U;
+    q = (const real_t*)(NULL);
+
+    /* Sizes. */
+    H = 0U;
+    W = 0U;
+    C = 0U;
+    kh = 0U;
+    kw = 0U;
+    sh = 0U;
+    sw = 0U;
+    f = 0U;
+
+    /* Largest number of values of an image and of a patch. */
+    a_max = 0U;
+    k_max = 0U;
+
+    /* Number of values. */
+    length = 0U;
+
+    /* Iteration indices. */
+    l = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* Initialise the numbers to 0. */
+    if (a)
+        *a = 0U;
+    if (k)
+        *k = 0U;
+    if (o)
+        *o = 0U;
+
+    /* If the pointer `F` is a null-pointer, return 0. */
+    if (!F)
+        return 0U;
+
+    /* If any of the sizes of the input or the number of layers is not a
+     * positive integer, return 0. */
+    for (j = 0U; j < 4U; ++j)
+        if (!(*(F + j) >= 1.0 && *(F + j) == (real_t)((size_t)*(F + j))))
+            return 0U;
+    H = (size_t)*F;
+    W = (size_t)*(F + 1U);
+    C = (size_t)*(F + 2U);
+    L = (size_t)*(F + 3U);
+    a_max = H * W * C;
+
+    /* Check the layers and count their values. */
+    for (l = 0U; l < L; ++l)
+    {
+        q = F + 4U + CNN_LAYER * l;
+
+        /* If any of the sizes of the kernel, the strides or the number of
+         * filters is not a positive integer, or if the padding or the
+         * activation is unknown, return 0. */
+        for (j = 0U; j < 6U; ++j)
+            if (
+                !(j == 4U) &&
+                !(*(q + j) >= 1.0 && *(q + j) == (real_t)((size_t)*(q + j)))
+            )
+                return 0U;
+        if (!(*(q + 4U) == CNN_VALID || *(q + 4U) == CNN_SAME))
+            return 0U;
+        if (
+            !(
+                *(q + 6U) == MLP_LINEAR ||
+                *(q + 6U) == MLP_RELU ||
+                *(q + 6U) == MLP_RELU_INV
+            )
+        )
+            return 0U;
+        kh = (size_t)*q;
+        kw = (size_t)*(q + 1U);
+        sh = (size_t)*(q + 2U);
+        sw = (size_t)*(q + 3U);
+        f = (size_t)*(q + 5U);
+
+        /* Count the values of the kernel and of the bias. */
+        length += kh * kw * C * f + f;
+        if (kh * kw * C > k_max)
+            k_max = kh * kw * C;
+
+        /* Compute the sizes of the output.  If the input is smaller than the
+         * kernel, return 0. */
+        H = cnn_output_size(H, kh, sh, (int)*(q + 4U));
+        W = cnn_output_size(W, kw, sw, (int)*(q + 4U));
+        C = f;
+        if (!(H && W))
+            return 0U;
+        if (H * W * C > a_max)
+            a_max = H * W * C;
+    }
+
+    /* Store the numbers. */
+    if (a)
+        *a = a_max;
+    if (k)
+        *k = k_max;
+    if (o)
+        *o = H * W * C;
+
+    /* Return the number of values. */
+    return 4U + CNN_LAYER * L + length;
+}
+
+/**
+ * Evaluate a network on an image.
+ *
+ * @param F
+ *     Array of the exported network (see the description of the header).  The
+ *     header must be valid (see the function `cnn_length`).
+ *
+ * @param X
+ *     Array of the H W C values of the image.
+ *
+ * @param Y
+ *     Array to store the output of the network.
+ *
+ * @param A
+ *     Workspace of size at least 2 a + `CNN_TILE` k, where a and k are the
+ *     numbers computed by the function `cnn_length`.
+ *
+ * @see cnn_length
+ *
+ */
+#if !defined(__cplusplus)
+void cnn_image (const real_t* F, const real_t* X, real_t* Y, real_t* A)
+#else
+inline void cnn_image (const real_t* F, const real_t* X, real_t* Y, real_t* A)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Arguments of the BLAS routine. */
+    char no;
+    int m;
+    int n;
+    int k;
+    real_t one;
+
+    /* Number of layers and the largest numbers of values of an image and of a
+     * patch. */
+    size_t L;
+    size_t a_max;
+    size_t k_max;
+
+    /* Sizes of the input, sizes of the output, paddings and the number of
+     * values of a patch. */
+    size_t H;
+    size_t W;
+    size_t C;
+    size_t H_out;
+    size_t W_out;
+    size_t pt;
+    size_t pl;
+    size_t K;
+
+    /* Description of the layer. */
+    const real_t* q;
+    size_t kh;
+    size_t kw;
+    size_t sh;
+    size_t sw;
+    size_t f;
+
+    /* Indicator of multiplying the input directly. */
+    bool direct;
+
+    /* Pointers to the kernel, to the bias, to the input, to the output, to the
+     * patches and to the output tile. */
+    const real_t* K_l;
+    const real_t* b_l;
+    real_t* U;
+    real_t* V;
+    real_t* P;
+    real_t* S;
+
+    /* Index of the first pixel of the tile and the number of its pixels. */
+    size_t o;
+    size_t t;
+
+    /* Coordinates of pixels. */
+    size_t i;
+    size_t j;
+    size_t y;
+    size_t x;
+
+    /* Iteration indices. */
+    size_t l;
+    size_t r;
+    size_t u;
+    size_t v;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Arguments of the BLAS routine. */
+    no = 'N';
+    m = 0;
+    n = 0;
+    k = 0;
+    one = 1.0;
+
+    /* Number of layers and the largest numbers of values. */
+    L = (size_t)*(F + 3U);
+    a_max = 0U;
+    k_max = 0U;
+    cnn_length(F, &a_max, &k_max, NULL);
+
+    /* Sizes. */
+    H = (size_t)*F;
+    W = (size_t)*(F + 1U);
+    C = (size_t)*(F + 2U);
+    H_out = 0U;
+    W_out = 0U;
+    pt = 0U;
+    pl = 0U;
+    K = 0U;
+
+    /* Description of the layer. */
+    q = F + 4U;
+    kh = 0U;
+    kw = 0U;
+    sh = 0U;
+    sw = 0U;
+    f = 0U;
+
+    /* Indicator of multiplying the input directly. */
+    direct = false;
+
+    /* Pointers. */
+    K_l = F + 4U + CNN_LAYER * L;
+    b_l = (const real_t*)(NULL);
+    U = A;
+    V = A + a_max;
+    P = A + (a_max << 1U);
+    S = (real_t*)(NULL);
+
+    /* Tile. */
+    o = 0U;
+    t = 0U;
+
+    /* Coordinates of pixels. */
+    i = 0U;
+    j = 0U;
+    y = 0U;
+    x = 0U;
+
+    /* Iteration indices. */
+    l = 0U;
+    r = 0U;
+    u = 0U;
+    v = 0U;
+
+    /* ALGORITHM */
+
+    /* Copy the image. */
+    memcpy(U, X, H * W * C * sizeof *U);
+
+    /* Evaluate the layers. */
+    for (l = 0U; l < L; ++l, q += CNN_LAYER)
+    {
+        /* Read the description of the layer. */
+        kh = (size_t)*q;
+        kw = (size_t)*(q + 1U);
+        sh = (size_t)*(q + 2U);
+        sw = (size_t)*(q + 3U);
+        f = (size_t)*(q + 5U);
+        H_out = cnn_output_size(H, kh, sh, (int)*(q + 4U));
+        W_out = cnn_output_size(W, kw, sw, (int)*(q + 4U));
+        pt = cnn_padding(H, kh, sh, (int)*(q + 4U));
+        pl = cnn_padding(W, kw, sw, (int)*(q + 4U));
+        K = kh * kw * C;
+        b_l = K_l + K * f;
+
+        /* Check if the patches are the rows of the input. */
+        direct =
+            (kh == 1U && kw == 1U && sh == 1U && sw == 1U) ||
+            (*(q + 4U) == CNN_VALID && kh == H && kw == W);
+
+        /* Compute the output tile by tile. */
+        for (o = 0U; o < H_out * W_out; o += t)
+        {
+            t = (H_out * W_out - o < CNN_TILE) ? H_out * W_out - o : CNN_TILE;
+
+            /* Copy the patches of the tile (the pixels outside of the input
+             * are zeros). */
+            if (!direct)
+                for (r = 0U; r < t; ++r)
+                {
+                    i = (o + r) / W_out;
+                    j = (o + r) % W_out;
+                    for (u = 0U; u < kh; ++u)
+                    {
+                        y = i * sh + u;
+                        for (v = 0U; v < kw; ++v)
+                        {
+                            x = j * sw + v;
+                            if (y >= pt && y - pt < H && x >= pl && x - pl < W)
+                                memcpy(
+                                    P + r * K + (u * kw + v) * C,
+                                    U + ((y - pt) * W + (x - pl)) * C,
+                                    C * sizeof *P
+                                );
+                            else
+                                memset(
+                                    P + r * K + (u * kw + v) * C,
+                                    0,
+                                    C * sizeof *P
+                                );
+                        }
+                    }
+                }
+
+            /* Initialise the output tile to the bias. */
+            S = V + o * f;
+            for (r = 0U; r < t; ++r)
+                memcpy(S + r * f, b_l, f * sizeof *S);
+
+            /* Add the product of the patches and the kernel.  In the
+             * column-major order of BLAS, the matrices are stored transposed,
+             * so the product is S^T += K_l^T P^T. */
+            m = (int)f;
+            n = (int)t;
+            k = (int)K;
+            _MLP_GEMM(
+                &no,
+                &no,
+                &m,
+                &n,
+                &k,
+                &one,
+                (real_t*)K_l,
+                &m,
+                direct ? U + o * K : P,
+                &k,
+                &one,
+                S,
+                &m
+            );
+
+            /* Apply the activation. */
+            mlp_activate((int)*(q + 6U), t * f, S);
+        }
+
+        /* Move to the next layer. */
+        K_l = b_l + f;
+        H = H_out;
+        W = W_out;
+        C = f;
+        S = U;
+        U = V;
+        V = S;
+    }
+
+    /* Copy the output. */
+    memcpy(Y, U, H * W * C * sizeof *Y);
+}
+
+/**
+ * Evaluate a network on the images of a job one by one.
+ *
+ * The function is the starting routine of the threads of the function
+ * `cnn_batch`.
+ *
+ * @param job
+ *     Pointer to the job (of the type `cnn_job_t`).
+ *
+ * @return
+ *     The null-pointer.
+ *
+ * @see cnn_image
+ * @see cnn_batch
+ *
+ */
+#if !defined(__cplusplus)
+void* cnn_job (void* job)
+#else
+extern "C" inline void* cnn_job (void* job)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Job. */
+    cnn_job_t* J;
+
+    /* Workspace. */
+    real_t* A;
+
+    /* Numbers of values of the input, of the output, of an image between the
+     * layers and of a patch. */
+    size_t n_in;
+    size_t n_out;
+    size_t a;
+    size_t k;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Job. */
+    J = (cnn_job_t*)job;
+
+    /* Workspace. */
+    A = (real_t*)(NULL);
+
+    /* Numbers of values. */
+    n_in = 0U;
+    n_out = 0U;
+    a = 0U;
+    k = 0U;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If there is no job, return the null-pointer. */
+    if (!J)
+        return NULL;
+
+    /* Find the numbers of values. */
+    J->done = false;
+    cnn_length(J->F, &a, &k, &n_out);
+    n_in = (size_t)*J->F * (size_t)*(J->F + 1U) * (size_t)*(J->F + 2U);
+
+    /* Allocate the workspace.  If the allocation failed, the job fails. */
+#if !defined(__cplusplus)
+    A = (real_t*)malloc(((a << 1U) + CNN_TILE * k) * sizeof *A);
+#else
+    A = static_cast<real_t*>(
+        ::malloc(((a << 1U) + CNN_TILE * k) * sizeof *A)
+    );
+#endif /* __cplusplus */
+    if (!A)
+        return NULL;
+
+    /* Evaluate the network image by image. */
+    for (i = 0U; i < J->N; ++i)
+        cnn_image(J->F, J->X + i * n_in, J->Y + i * n_out, A);
+    J->done = true;
+
+    /* Free the workspace. */
+    free(A);
+    A = (real_t*)(NULL);
+
+    /* Return the null-pointer. */
+    return NULL;
+}
+
+/**
+ * Evaluate a network on images in parallel.
+ *
+ * Images are split into `T` contiguous groups of (almost) the same size and
+ * each group is evaluated in its own thread with its own workspace (the first
+ * group is evaluated in the calling thread).  If the memory for the jobs
+ * cannot be allocated or if a thread cannot be created, the images are
+ * evaluated in the calling thread.
+ *
+ * @param F
+ *     Array of the exported network (see the description of the header).
+ *
+ * @param N
+ *     Number of images.
+ *
+ * @param X
+ *     Array of `N` images of H W C values.
+ *
+ * @param Y
+ *     Array to store the `N` outputs (see the function `cnn_length`).
+ *
+ * @param T
+ *     Number of threads (if 0, a single thread is used).
+ *
+ * @return
+ *     Value `true` if all images were evaluated, `false` if the header of the
+ *     network is not valid or if a workspace could not be allocated.
+ *
+ * @see cnn_length
+ * @see cnn_job
+ *
+ */
+#if !defined(__cplusplus)
+bool cnn_batch (
+    const real_t* F,
+    size_t N,
+    const real_t* X,
+    real_t* Y,
+    size_t T
+)
+#else
+inline bool cnn_batch (
+    const real_t* F,
+    ::size_t N,
+    const real_t* X,
+    real_t* Y,
+    ::size_t T
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Single job (if the memory allocation fails). */
+    cnn_job_t single;
+
+    /* Array of jobs. */
+    cnn_job_t* jobs;
+
+    /* Array of threads. */
+    pthread_t* threads;
+
+    /* Array of indicators of successfully created threads. */
+    bool* created;
+
+    /* Numbers of values of the input and of the output. */
+    size_t n_in;
+    size_t n_out;
+
+    /* Number of images in the jobs so far and the indicator of success. */
+    size_t done;
+    bool success;
+
+    /* Iteration index. */
+    size_t t;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Single job. */
+    memset(&single, 0, sizeof single);
+
+    /* Array of jobs. */
+    jobs = (cnn_job_t*)(NULL);
+
+    /* Array of threads. */
+    threads = (pthread_t*)(NULL);
+
+    /* Array of indicators of successfully created threads. */
+    created = (bool*)(NULL);
+
+    /* Numbers of values of the input and of the output. */
+    n_in = 0U;
+    n_out = 0U;
+
+    /* Number of images in the jobs so far and the indicator of success. */
+    done = 0U;
+    success = true;
+
+    /* Iteration index. */
+    t = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer or if the header of the network
+     * is not valid, return `false`. */
+    if (!(F && X && Y && cnn_length(F, NULL, NULL, &n_out)))
+        return false;
+    n_in = (size_t)*F * (size_t)*(F + 1U) * (size_t)*(F + 2U);
+
+    /* Use at least 1 and at most `N` threads. */
+    if (T > N)
+        T = N;
+    if (!T)
+        T = 1U;
+
+    /* Allocate memory for the jobs, the threads and the indicators. */
+#if !defined(__cplusplus)
+    jobs = (cnn_job_t*)malloc(T * sizeof *jobs);
+    threads = (pthread_t*)malloc(T * sizeof *threads);
+    created = (bool*)malloc(T * sizeof *created);
+#else
+    jobs = static_cast<cnn_job_t*>(::malloc(T * sizeof *jobs));
+    threads = static_cast<pthread_t*>(::malloc(T * sizeof *threads));
+    created = static_cast<bool*>(::malloc(T * sizeof *created));
+#endif /* __cplusplus */
+
+    /* If the memory allocation has failed, deallocate memory and evaluate all
+     * images in the calling thread. */
+    if (!(jobs && threads && created))
+    {
+        /* Deallocate memory for the jobs, the threads and the indicators. */
+        free(jobs);
+        jobs = (cnn_job_t*)(NULL);
+        free(threads);
+        threads = (pthread_t*)(NULL);
+        free(created);
+        created = (bool*)(NULL);
+
+        /* Evaluate the images. */
+        single.F = F;
+        single.N = N;
+        single.X = X;
+        single.Y = Y;
+        cnn_job((void*)(&single));
+
+        /* Return the indicator of success. */
+        return single.done;
+    }
+
+    /* Initialise the jobs. */
+    for (t = 0U; t < T; ++t)
+    {
+        (jobs + t)->F = F;
+        (jobs + t)->N = N / T + (t < N % T);
+        (jobs + t)->X = X + done * n_in;
+        (jobs + t)->Y = Y + done * n_out;
+        (jobs + t)->done = false;
+        *(created + t) = false;
+
+        done += (jobs + t)->N;
+    }
+
+    /* Start the threads for all jobs but the first one. */
+    for (t = 1U; t < T; ++t)
+        *(created + t) =
+            !pthread_create(threads + t, NULL, cnn_job, (void*)(jobs + t));
+
+    /* Do the first job and the jobs whose threads could not be created in the
+     * calling thread. */
+    for (t = 0U; t < T; ++t)
+        if (!*(created + t))
+            cnn_job((void*)(jobs + t));
+
+    /* Wait for the threads to finish. */
+    for (t = 0U; t < T; ++t)
+    {
+        if (t && *(created + t))
+            pthread_join(*(threads + t), NULL);
+        success = success && (jobs + t)->done;
+    }
+
+    /* Clear the memory in the array of jobs. */
+    memset(jobs, 0, T * sizeof *jobs);
+
+    /* Deallocate memory for the jobs, the threads and the indicators. */
+    free(jobs);
+    jobs = (cnn_job_t*)(NULL);
+    free(threads);
+    threads = (pthread_t*)(NULL);
+    free(created);
+    created = (bool*)(NULL);
+
+    /* Return the indicator of success. */
+    return success;
+}
+
+#endif /* __CNN_H__INCLUDED */
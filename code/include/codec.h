@@ -0,0 +1,1125 @@
+/**
+ * Functions for reading and writing losslessly compressed tables of real
+ * numbers (".pcz" files).
+ *
+ * A table is a sequence of rows of the same number of values (for instance,
+ * polygons dumped by the function `codec_dump_polygons` as an alternative to
+ * the `dump_polygons` function from "polygon.h").  Rows are compressed in
+ * blocks of `CODEC_BLOCK_VALUES` values (rounded down to whole rows) so that
+ * tables are streamed in both directions and only a single block is ever held
+ * in memory.  Each column of a block is compressed independently:
+ *     1. each value is represented by its bytes in the little-endian byte
+ *        order (as `float32` if `real_t` is `float` and as `float64`
+ *        otherwise) and replaced by the exclusive disjunction (XOR) of its
+ *        bytes and the bytes of the previous value in the column (of zero for
+ *        the first row in the block),
+ *     2. the resulting bytes are shuffled into byte planes---the k-th plane
+ *        holds the k-th byte of all values in the column,
+ *     3. each plane is stored either as a single byte if it consists of zeros
+ *        only, as a bitmap of its non-zero bytes followed by the non-zero bytes
+ *        if that is shorter than the plane, or as it is otherwise.
+ * Equal consecutive values (such as the repeated vertices (1 / 2, 0) and
+ * (-1 / 2, 0), or the unit diameters of normalised polygons) are thus reduced
+ * to zeros, and similar values (smooth sweeps over a grid) share their signs,
+ * exponents and leading bits of mantissas, which become planes of (mostly)
+ * zeros.  Decoding reverses the steps block by block with simple loops over
+ * contiguous planes.
+ *
+ * The file begins with a header of `CODEC_HEADER_LENGTH` bytes:  the magic
+ * string "\x93PCZ", the version (1), the size of a value in bytes (4 or 8),
+ * two zero bytes, the number of columns and the number of rows in a full block
+ * (both 4 bytes, little-endian).  Each block begins with the number of its rows
+ * and the number of bytes of its compressed planes (both 4 bytes,
+ * little-endian) followed by the planes of the first column, of the second
+ * column etc.  Compression is lossless:  values read are exactly the values
+ * dumped (if their types match).
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__CODEC_H__INCLUDED) && (__CODEC_H__INCLUDED) == 1)
+
+/* Undefine __CODEC_H__INCLUDED if it has already been defined. */
+#if defined(__CODEC_H__INCLUDED)
+#undef __CODEC_H__INCLUDED
+#endif /* __CODEC_H__INCLUDED */
+
+/* Define __CODEC_H__INCLUDED as 1. */
+#define __CODEC_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define constants. */
+
+/**
+ * Length of the header of a file in bytes.
+ *
+ */
+#define CODEC_HEADER_LENGTH 16U
+
+/**
+ * Length of the header of a block in bytes.
+ *
+ */
+#define CODEC_BLOCK_HEADER_LENGTH 8U
+
+/**
+ * Maximal number of values in a block (unless a single row is longer).
+ *
+ */
+#define CODEC_BLOCK_VALUES 65536U
+
+/**
+ * Size of a value written to a file in bytes.
+ *
+ */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define CODEC_VALUE_SIZE 4U
+#else
+#define CODEC_VALUE_SIZE 8U
+#endif /* _REAL_PRECISION */
+
+/**
+ * Modes of storing a byte plane.
+ *
+ */
+#define CODEC_PLANE_ZERO 0U
+#define CODEC_PLANE_SPARSE 1U
+#define CODEC_PLANE_RAW 2U
+
+/* Define types. */
+
+/**
+ * Compressed table opened for reading or for dumping.
+ *
+ */
+typedef struct codec_struct
+{
+    /* File. */
+    FILE* file;
+
+    /* Indicator of a table opened for dumping. */
+    bool output;
+
+    /* Indicator of the header dumped to the file. */
+    bool header;
+
+    /* Size of a value in the file in bytes (4 or 8). */
+    size_t size;
+
+    /* Number of values in each row. */
+    size_t columns;
+
+    /* Number of rows in a full block. */
+    size_t block;
+
+    /* Number of rows in the current block and the number of values of the
+     * block already read (when reading) or buffered (when dumping). */
+    size_t rows;
+    size_t position;
+
+    /* Values of the current block (row by row). */
+    real_t* values;
+
+    /* Byte planes of the current block. */
+    unsigned char* planes;
+
+    /* Compressed byte planes of the current block. */
+    unsigned char* bytes;
+}
+codec_t;
+
+/* Define functions. */
+
+/**
+ * Check if a path is a path to a compressed table.
+ *
+ * @param path
+ *     Path to check.
+ *
+ * @return
+ *     Value `true` if `path` is not a null-pointer and ends with ".pcz";
+ *     value `false` otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+bool codec_path (const char* path)
+#else
+inline bool codec_path (const char* path)
+#endif /* __cplusplus */
+{
+    /* Length of the path. */
+    size_t m;
+
+    /* Compute the length of the path. */
+    m = path ? strlen(path) : 0U;
+
+    /* Return `true` if the path ends with ".pcz". */
+    return (m >= 4U && !strcmp(path + m - 4U, ".pcz")) ? true : false;
+}
+
+/**
+ * Store a number as 4 bytes in the little-endian byte order.
+ *
+ * @param b
+ *     Array of size at least 4 to store the bytes.
+ *
+ * @param x
+ *     Number to store (less than 2^32).
+ *
+ */
+#if !defined(__cplusplus)
+void codec_put (unsigned char* b, size_t x)
+#else
+inline void codec_put (unsigned char* b, ::size_t x)
+#endif /* __cplusplus */
+{
+    /* Store the bytes. */
+    *b = (unsigned char)(x & 0xFFU);
+    *(b + 1U) = (unsigned char)((x >> 8U) & 0xFFU);
+    *(b + 2U) = (unsigned char)((x >> 16U) & 0xFFU);
+    *(b + 3U) = (unsigned char)((x >> 24U) & 0xFFU);
+}
+
+/**
+ * Load a number stored as 4 bytes in the little-endian byte order.
+ *
+ * @param b
+ *     Array of the 4 bytes.
+ *
+ * @return
+ *     The stored number.
+ *
+ */
+#if !defined(__cplusplus)
+size_t codec_get (const unsigned char* b)
+#else
+inline ::size_t codec_get (const unsigned char* b)
+#endif /* __cplusplus */
+{
+    /* Return the number. */
+    return
+        (size_t)(*b) |
+        ((size_t)(*(b + 1U)) << 8U) |
+        ((size_t)(*(b + 2U)) << 16U) |
+        ((size_t)(*(b + 3U)) << 24U);
+}
+
+/**
+ * Compress a block of values.
+ *
+ * @param size
+ *     Size of a value in bytes (4 or 8).
+ *
+ * @param columns
+ *     Number of values in each row.
+ *
+ * @param rows
+ *     Number of rows.
+ *
+ * @param x
+ *     Array of values of size at least `rows` * `columns` (row by row).
+ *
+ * @param planes
+ *     Auxiliary array of size at least `rows` * `columns` * `size`.
+ *
+ * @param out
+ *     Array of size at least `columns` * `size` * (`rows` + 1) to store the
+ *     compressed planes.
+ *
+ * @return
+ *     Number of bytes stored in the array `out`.
+ *
+ * @see codec_decode
+ *
+ */
+#if !defined(__cplusplus)
+size_t codec_encode (
+    size_t size,
+    size_t columns,
+    size_t rows,
+    const real_t* x,
+    unsigned char* planes,
+    unsigned char* out
+)
+#else
+inline ::size_t codec_encode (
+    ::size_t size,
+    ::size_t columns,
+    ::size_t rows,
+    const real_t* x,
+    unsigned char* planes,
+    unsigned char* out
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Bytes of the current and of the previous value. */
+    unsigned char current[8U];
+    unsigned char previous[8U];
+
+    /* Values of types `float32` and `float64`. */
+    float f;
+    double g;
+
+    /* Indicator of the little-endian host. */
+    bool little;
+
+    /* Pointer to the current plane. */
+    const unsigned char* plane;
+
+    /* Number of non-zero bytes in the current plane. */
+    size_t z;
+
+    /* Length of the bitmap of a plane. */
+    size_t m;
+
+    /* Number of bytes stored. */
+    size_t length;
+
+    /* Iteration indices. */
+    size_t c;
+    size_t i;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Bytes of the current and of the previous value. */
+    memset(current, 0, sizeof current);
+    memset(previous, 0, sizeof previous);
+
+    /* Values of types `float32` and `float64`. */
+    f = 0.0F;
+    g = 0.0;
+
+    /* Indicator of the little-endian host. */
+    i = 1U;
+    little = *(unsigned char*)(&i) ? true : false;
+
+    /* Pointer to the current plane. */
+    plane = (const unsigned char*)(NULL);
+
+    /* Number of non-zero bytes in the current plane. */
+    z = 0U;
+
+    /* Length of the bitmap of a plane. */
+    m = (rows + 7U) >> 3U;
+
+    /* Number of bytes stored. */
+    length = 0U;
+
+    /* Iteration indices. */
+    c = 0U;
+    i = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer or if the size is illegal,
+     * there is nothing to compress. */
+    if (!(x && planes && out && (size == 4U || size == 8U)))
+        return length;
+
+    /* Shuffle the exclusive disjunctions of consecutive values in each column
+     * into byte planes. */
+    for (c = 0U; c < columns; ++c)
+    {
+        /* The first value is compared to zero. */
+        memset(previous, 0, sizeof previous);
+
+        for (i = 0U; i < rows; ++i)
+        {
+            /* Find the bytes of the value in the little-endian byte order. */
+            if (size == 4U)
+            {
+                f = (float)(*(x + i * columns + c));
+                for (k = 0U; k < 4U; ++k)
+                    *(current + k) =
+                        *((unsigned char*)(&f) + (little ? k : 3U - k));
+            }
+            else
+            {
+                g = (double)(*(x + i * columns + c));
+                for (k = 0U; k < 8U; ++k)
+                    *(current + k) =
+                        *((unsigned char*)(&g) + (little ? k : 7U - k));
+            }
+
+            /* Store the exclusive disjunction to the planes. */
+            for (k = 0U; k < size; ++k)
+            {
+                *(planes + (c * size + k) * rows + i) =
+                    (unsigned char)(*(current + k) ^ *(previous + k));
+                *(previous + k) = *(current + k);
+            }
+        }
+    }
+
+    /* Store the planes. */
+    for (k = 0U; k < columns * size; ++k)
+    {
+        /* Count the non-zero bytes in the plane. */
+        plane = planes + k * rows;
+        for (z = 0U, i = 0U; i < rows; ++i)
+            z += *(plane + i) ? 1U : 0U;
+
+        /* Store a plane of zeros as a single byte. */
+        if (!z)
+            *(out + length++) = (unsigned char)(CODEC_PLANE_ZERO);
+
+        /* Store a sparse plane as the bitmap followed by non-zero bytes. */
+        else if (m + z < rows)
+        {
+            *(out + length++) = (unsigned char)(CODEC_PLANE_SPARSE);
+            memset(out + length, 0, m);
+            for (i = 0U; i < rows; ++i)
+                if (*(plane + i))
+                    *(out + length + (i >> 3U)) |=
+                        (unsigned char)(1U << (i & 7U));
+            length += m;
+            for (i = 0U; i < rows; ++i)
+                if (*(plane + i))
+                    *(out + length++) = *(plane + i);
+        }
+
+        /* Store any other plane as it is. */
+        else
+        {
+            *(out + length++) = (unsigned char)(CODEC_PLANE_RAW);
+            memcpy(out + length, plane, rows);
+            length += rows;
+        }
+    }
+
+    /* Return the number of bytes stored. */
+    return length;
+}
+
+/**
+ * Decompress a block of values.
+ *
+ * @param size
+ *     Size of a value in bytes (4 or 8).
+ *
+ * @param columns
+ *     Number of values in each row.
+ *
+ * @param rows
+ *     Number of rows.
+ *
+ * @param in
+ *     Array of compressed planes.
+ *
+ * @param length
+ *     Number of bytes in the array `in`.
+ *
+ * @param planes
+ *     Auxiliary array of size at least `rows` * `columns` * `size`.
+ *
+ * @param x
+ *     Array of size at least `rows` * `columns` to store the values (row by
+ *     row).
+ *
+ * @return
+ *     Value 0 if the block was decompressed successfully; a non-zero value if
+ *     the compressed planes are corrupted.
+ *
+ * @see codec_encode
+ *
+ */
+#if !defined(__cplusplus)
+int codec_decode (
+    size_t size,
+    size_t columns,
+    size_t rows,
+    const unsigned char* in,
+    size_t length,
+    unsigned char* planes,
+    real_t* x
+)
+#else
+inline int codec_decode (
+    ::size_t size,
+    ::size_t columns,
+    ::size_t rows,
+    const unsigned char* in,
+    ::size_t length,
+    unsigned char* planes,
+    real_t* x
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Bytes of the current value. */
+    unsigned char current[8U];
+
+    /* Values of types `float32` and `float64`. */
+    float f;
+    double g;
+
+    /* Indicator of the little-endian host. */
+    bool little;
+
+    /* Pointers to the current plane and to its bitmap. */
+    unsigned char* plane;
+    const unsigned char* bitmap;
+
+    /* Length of the bitmap of a plane. */
+    size_t m;
+
+    /* Number of bytes loaded. */
+    size_t p;
+
+    /* Iteration indices. */
+    size_t c;
+    size_t i;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Bytes of the current value. */
+    memset(current, 0, sizeof current);
+
+    /* Values of types `float32` and `float64`. */
+    f = 0.0F;
+    g = 0.0;
+
+    /* Indicator of the little-endian host. */
+    i = 1U;
+    little = *(unsigned char*)(&i) ? true : false;
+
+    /* Pointers to the current plane and to its bitmap. */
+    plane = (unsigned char*)(NULL);
+    bitmap = (const unsigned char*)(NULL);
+
+    /* Length of the bitmap of a plane. */
+    m = (rows + 7U) >> 3U;
+
+    /* Number of bytes loaded. */
+    p = 0U;
+
+    /* Iteration indices. */
+    c = 0U;
+    i = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer or if the size is illegal,
+     * return a non-zero value. */
+    if (!(in && planes && x && (size == 4U || size == 8U)))
+        return 1;
+
+    /* Load the planes. */
+    for (k = 0U; k < columns * size; ++k)
+    {
+        plane = planes + k * rows;
+
+        /* Load the mode of the plane. */
+        if (p >= length)
+            return 1;
+        switch (*(in + p++))
+        {
+            case CODEC_PLANE_ZERO:
+                memset(plane, 0, rows);
+
+                break;
+
+            case CODEC_PLANE_SPARSE:
+                if (p + m > length)
+                    return 1;
+                bitmap = in + p;
+                p += m;
+                for (i = 0U; i < rows; ++i)
+                    if ((*(bitmap + (i >> 3U)) >> (i & 7U)) & 1U)
+                    {
+                        if (p >= length)
+                            return 1;
+                        *(plane + i) = *(in + p++);
+                    }
+                    else
+                        *(plane + i) = 0U;
+
+                break;
+
+            case CODEC_PLANE_RAW:
+                if (p + rows > length)
+                    return 1;
+                memcpy(plane, in + p, rows);
+                p += rows;
+
+                break;
+
+            default:
+                return 1;
+        }
+    }
+
+    /* Accumulate the exclusive disjunctions in each plane. */
+    for (k = 0U; k < columns * size; ++k)
+    {
+        plane = planes + k * rows;
+        for (i = 1U; i < rows; ++i)
+            *(plane + i) ^= *(plane + i - 1U);
+    }
+
+    /* Gather the bytes of the values from the planes. */
+    for (c = 0U; c < columns; ++c)
+        for (i = 0U; i < rows; ++i)
+        {
+            for (k = 0U; k < size; ++k)
+                *(current + k) = *(planes + (c * size + k) * rows + i);
+            if (size == 4U)
+            {
+                for (k = 0U; k < 4U; ++k)
+                    *((unsigned char*)(&f) + (little ? k : 3U - k)) =
+                        *(current + k);
+                *(x + i * columns + c) = (real_t)f;
+            }
+            else
+            {
+                for (k = 0U; k < 8U; ++k)
+                    *((unsigned char*)(&g) + (little ? k : 7U - k)) =
+                        *(current + k);
+                *(x + i * columns + c) = (real_t)g;
+            }
+        }
+
+    /* Return 0 if all bytes were loaded. */
+    return (p == length) ? 0 : 1;
+}
+
+/**
+ * Allocate memory for the buffers of a table.
+ *
+ * The number of rows in a full block is computed from the number of columns
+ * if it is not set.
+ *
+ * @param C
+ *     Pointer to the table with the number of columns and the size of a value
+ *     set.
+ *
+ * @return
+ *     Value 0 if the memory was allocated successfully; a non-zero value
+ *     otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+int codec_allocate (codec_t* C)
+#else
+inline int codec_allocate (codec_t* C)
+#endif /* __cplusplus */
+{
+    /* If the pointer `C` is a null-pointer or if there are no columns, return
+     * a non-zero value. */
+    if (!(C && C->columns))
+        return 1;
+
+    /* Compute the number of rows in a full block. */
+    if (!C->block)
+        C->block = (C->columns < CODEC_BLOCK_VALUES) ?
+            CODEC_BLOCK_VALUES / C->columns :
+            1U;
+
+    /* Allocate memory for the values, the planes and the compressed
+     * planes. */
+#if !defined(__cplusplus)
+    C->values = (real_t*)malloc(C->block * C->columns * sizeof *C->values);
+    C->planes =
+        (unsigned char*)malloc(C->block * C->columns * C->size);
+    C->bytes =
+        (unsigned char*)malloc(C->columns * C->size * (C->block + 1U));
+#else
+    C->values =
+        static_cast<real_t*>(
+            ::malloc(C->block * C->columns * sizeof *C->values)
+        );
+    C->planes =
+        static_cast<unsigned char*>(::malloc(C->block * C->columns * C->size));
+    C->bytes =
+        static_cast<unsigned char*>(
+            ::malloc(C->columns * C->size * (C->block + 1U))
+        );
+#endif /* __cplusplus */
+
+    /* Return 0 if all memory was allocated. */
+    return (C->values && C->planes && C->bytes) ? 0 : 1;
+}
+
+/**
+ * Open a compressed table.
+ *
+ * A table opened for reading is prepared to read its first value.  The header
+ * of a table opened for dumping is dumped when the number of columns is known
+ * (by the function `codec_dump_polygons`, or by the function `codec_close` if
+ * nothing was dumped).
+ *
+ * @param C
+ *     Pointer to the table to open.
+ *
+ * @param path
+ *     Path to the file.
+ *
+ * @param output
+ *     If `true`, the table is opened for dumping (the file is truncated);
+ *     otherwise it is opened for reading.
+ *
+ * @return
+ *     Value 0 if the table was opened successfully; a non-zero value
+ *     otherwise.
+ *
+ * @see codec_close
+ *
+ */
+#if !defined(__cplusplus)
+int codec_open (codec_t* C, const char* path, bool output)
+#else
+inline int codec_open (codec_t* C, const char* path, bool output)
+#endif /* __cplusplus */
+{
+    /* Header of the file. */
+    unsigned char header[CODEC_HEADER_LENGTH];
+
+    /* If any of the pointers is a null-pointer, return a non-zero value. */
+    if (!(C && path))
+        return 1;
+
+    /* Initialise the table. */
+    memset(C, 0, sizeof *C);
+    C->output = output;
+    C->size = CODEC_VALUE_SIZE;
+
+    /* Open the file. */
+    C->file = fopen(path, output ? "wb" : "rb");
+    if (!C->file)
+        return 1;
+
+    /* A table opened for dumping is ready. */
+    if (output)
+        return 0;
+
+    /* Load and check the header and allocate memory for the buffers. */
+    if (
+        fread(header, 1U, CODEC_HEADER_LENGTH, C->file) !=
+            CODEC_HEADER_LENGTH ||
+        memcmp(header, "\x93PCZ", 4U) ||
+        *(header + 4U) != 1U ||
+        !(*(header + 5U) == 4U || *(header + 5U) == 8U)
+    )
+    {
+        fclose(C->file);
+        memset(C, 0, sizeof *C);
+
+        return 1;
+    }
+    C->size = (size_t)(*(header + 5U));
+    C->columns = codec_get(header + 8U);
+    C->block = codec_get(header + 12U);
+    if (C->columns && (!C->block || codec_allocate(C)))
+    {
+        free(C->values);
+        free(C->planes);
+        free(C->bytes);
+        fclose(C->file);
+        memset(C, 0, sizeof *C);
+
+        return 1;
+    }
+
+    /* Return 0. */
+    return 0;
+}
+
+/**
+ * Compress and dump the buffered rows of a table opened for dumping.
+ *
+ * @param C
+ *     Pointer to the table.
+ *
+ * @return
+ *     Value 0 if the rows were dumped successfully; a non-zero value
+ *     otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+int codec_flush (codec_t* C)
+#else
+inline int codec_flush (codec_t* C)
+#endif /* __cplusplus */
+{
+    /* Header of the block. */
+    unsigned char header[CODEC_BLOCK_HEADER_LENGTH];
+
+    /* Number of compressed bytes. */
+    size_t length;
+
+    /* If nothing is buffered, return 0. */
+    if (!(C && C->file && C->output && C->position))
+        return 0;
+
+    /* Compress the rows. */
+    C->rows = C->position / C->columns;
+    length =
+        codec_encode(
+            C->size,
+            C->columns,
+            C->rows,
+            C->values,
+            C->planes,
+            C->bytes
+        );
+
+    /* Dump the header of the block and the compressed planes. */
+    codec_put(header, C->rows);
+    codec_put(header + 4U, length);
+    C->rows = 0U;
+    C->position = 0U;
+
+    return
+        (
+            fwrite(header, 1U, CODEC_BLOCK_HEADER_LENGTH, C->file) ==
+                CODEC_BLOCK_HEADER_LENGTH &&
+            fwrite(C->bytes, 1U, length, C->file) == length
+        ) ?
+            0 :
+            1;
+}
+
+/**
+ * Dump the header of a table opened for dumping.
+ *
+ * @param C
+ *     Pointer to the table.
+ *
+ * @param columns
+ *     Number of values in each row.
+ *
+ * @return
+ *     Value 0 if the header was dumped successfully (or if it had already been
+ *     dumped with the same number of columns); a non-zero value otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+int codec_begin (codec_t* C, size_t columns)
+#else
+inline int codec_begin (codec_t* C, ::size_t columns)
+#endif /* __cplusplus */
+{
+    /* Header of the file. */
+    unsigned char header[CODEC_HEADER_LENGTH];
+
+    /* If the pointer `C` is a null-pointer or if the table is not opened for
+     * dumping, return a non-zero value. */
+    if (!(C && C->file && C->output))
+        return 1;
+
+    /* If the header has already been dumped, check the number of columns. */
+    if (C->header)
+        return (columns == C->columns) ? 0 : 1;
+
+    /* Allocate memory for the buffers. */
+    C->columns = columns;
+    if (columns && codec_allocate(C))
+        return 1;
+
+    /* Dump the header. */
+    memset(header, 0, sizeof header);
+    memcpy(header, "\x93PCZ", 4U);
+    *(header + 4U) = 1U;
+    *(header + 5U) = (unsigned char)(C->size);
+    codec_put(header + 8U, C->columns);
+    codec_put(header + 12U, C->block);
+    C->header = true;
+
+    return
+        (fwrite(header, 1U, CODEC_HEADER_LENGTH, C->file) ==
+            CODEC_HEADER_LENGTH) ?
+            0 :
+            1;
+}
+
+/**
+ * Dump rows to a compressed table.
+ *
+ * @param C
+ *     Pointer to the table opened for dumping.
+ *
+ * @param m
+ *     Number of values in each row.
+ *
+ * @param x
+ *     Array of the values of size at least `N` * `m`, row by row.
+ *
+ * @param N
+ *     Number of rows.
+ *
+ * @return
+ *     Value 0 if all values were dumped successfully (the last block may be
+ *     buffered until the function `codec_close` is called); a non-zero value
+ *     otherwise.
+ *
+ * @see codec_dump_polygons
+ *
+ */
+#if !defined(__cplusplus)
+int codec_dump (codec_t* C, size_t m, const real_t* x, size_t N)
+#else
+inline int codec_dump (codec_t* C, ::size_t m, const real_t* x, ::size_t N)
+#endif /* __cplusplus */
+{
+    /* Number of values to dump. */
+    size_t M;
+
+    /* Number of values copied to the buffer. */
+    size_t k;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* If any of the pointers is a null-pointer, if there is nothing to dump or
+     * if the rows are not of the same length as the rows already dumped,
+     * return a non-zero value. */
+    if (!(C && x && m) || codec_begin(C, m))
+        return 1;
+
+    /* Copy the values to the buffer and dump each full block. */
+    M = N * m;
+    for (i = 0U; i < M; i += k)
+    {
+        k = C->block * C->columns - C->position;
+        if (M - i < k)
+            k = M - i;
+        memcpy(C->values + C->position, x + i, k * sizeof *x);
+        C->position += k;
+        if (C->position == C->block * C->columns && codec_flush(C))
+            return 1;
+    }
+
+    /* Return 0. */
+    return 0;
+}
+
+/**
+ * Dump polygons to a compressed table.
+ *
+ * Each polygon is a row of the table.  The function is an alternative to the
+ * `dump_polygons` function from "polygon.h".
+ *
+ * @param C
+ *     Pointer to the table opened for dumping.
+ *
+ * @param n
+ *     Number of points in each set.
+ *
+ * @param P
+ *     Array of points of size at least `N` * 2 * `n` organised as in the
+ *     `dump_polygons` function.
+ *
+ * @param N
+ *     Number of polygons.
+ *
+ * @return
+ *     Value 0 if all values were dumped successfully (the last block may be
+ *     buffered until the function `codec_close` is called); a non-zero value
+ *     otherwise.
+ *
+ * @see dump_polygons
+ * @see codec_dump
+ *
+ */
+#if !defined(__cplusplus)
+int codec_dump_polygons (codec_t* C, size_t n, const real_t* P, size_t N)
+#else
+inline int codec_dump_polygons (
+    codec_t* C,
+    ::size_t n,
+    const real_t* P,
+    ::size_t N
+)
+#endif /* __cplusplus */
+{
+    /* Dump the polygons as rows of 2 `n` values. */
+    return codec_dump(C, n << 1U, P, N);
+}
+
+/**
+ * Read values from a compressed table.
+ *
+ * The values are read row by row from the current position in the table.
+ * Blocks are loaded and decompressed as they are needed.
+ *
+ * @param C
+ *     Pointer to the table opened for reading.
+ *
+ * @param m
+ *     Number of values to read.
+ *
+ * @param x
+ *     Array of size at least `m` to store the values.
+ *
+ * @return
+ *     Number of values read (less than `m` if the end of the table has been
+ *     reached or if a block is corrupted).
+ *
+ */
+#if !defined(__cplusplus)
+size_t codec_read (codec_t* C, size_t m, real_t* x)
+#else
+inline ::size_t codec_read (codec_t* C, ::size_t m, real_t* x)
+#endif /* __cplusplus */
+{
+    /* Header of a block. */
+    unsigned char header[CODEC_BLOCK_HEADER_LENGTH];
+
+    /* Number of compressed bytes of a block. */
+    size_t length;
+
+    /* Number of values copied from the current block. */
+    size_t k;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* If any of the pointers is a null-pointer or if the table is not opened
+     * for reading, there is nothing to read. */
+    if (!(C && C->file && x) || C->output || !C->columns)
+        return 0U;
+
+    /* Copy the values from the blocks. */
+    for (i = 0U; i < m; i += k)
+    {
+        /* Load and decompress the next block if the current block has been
+         * read. */
+        if (C->position == C->rows * C->columns)
+        {
+            C->rows = 0U;
+            C->position = 0U;
+            if (
+                fread(header, 1U, CODEC_BLOCK_HEADER_LENGTH, C->file) !=
+                    CODEC_BLOCK_HEADER_LENGTH
+            )
+                break;
+            length = codec_get(header + 4U);
+            if (
+                !codec_get(header) ||
+                codec_get(header) > C->block ||
+                length > C->columns * C->size * (C->block + 1U) ||
+                fread(C->bytes, 1U, length, C->file) != length ||
+                codec_decode(
+                    C->size,
+                    C->columns,
+                    codec_get(header),
+                    C->bytes,
+                    length,
+                    C->planes,
+                    C->values
+                )
+            )
+                break;
+            C->rows = codec_get(header);
+        }
+
+        /* Copy the values. */
+        k = C->rows * C->columns - C->position;
+        if (m - i < k)
+            k = m - i;
+        memcpy(x + i, C->values + C->position, k * sizeof *x);
+        C->position += k;
+    }
+
+    /* Return the number of values read. */
+    return (i < m) ? i : m;
+}
+
+/**
+ * Close a compressed table.
+ *
+ * The buffered rows of a table opened for dumping are dumped before the file
+ * is closed.
+ *
+ * @param C
+ *     Pointer to the table.
+ *
+ * @return
+ *     Value 0 if the table was closed successfully; a non-zero value
+ *     otherwise.
+ *
+ * @see codec_open
+ *
+ */
+#if !defined(__cplusplus)
+int codec_close (codec_t* C)
+#else
+inline int codec_close (codec_t* C)
+#endif /* __cplusplus */
+{
+    /* Value to return. */
+    int ret;
+
+    /* Initialise the value to return. */
+    ret = 0;
+
+    /* If the pointer `C` is a null-pointer, return 0. */
+    if (!C)
+        return ret;
+
+    /* Dump the header (of an empty table) and the buffered rows. */
+    if (C->file && C->output)
+    {
+        if (!C->header && codec_begin(C, 0U))
+            ret = 1;
+        if (codec_flush(C))
+            ret = 1;
+    }
+
+    /* Close the file. */
+    if (C->file && fclose(C->file))
+        ret = 1;
+
+    /* Clear and deallocate memory for the buffers. */
+    if (C->values)
+        memset(C->values, 0, C->block * C->columns * sizeof *C->values);
+    free(C->values);
+    free(C->planes);
+    free(C->bytes);
+
+    /* Reset the table. */
+    memset(C, 0, sizeof *C);
+    C->file = (FILE*)(NULL);
+    C->values = (real_t*)(NULL);
+    C->planes = (unsigned char*)(NULL);
+    C->bytes = (unsigned char*)(NULL);
+
+    /* Return the value. */
+    return ret;
+}
+
+#endif /* __CODEC_H__INCLUDED */
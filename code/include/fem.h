@@ -0,0 +1,708 @@
+/**
+ * Functions for the finite element solution of the Laplace eigenvalue problem
+ * on triangles.
+ *
+ * The reference triangle with vertices (0, 0), (1, 0), (0, 1) is divided into
+ * m * m congruent right triangles by the lines x = i / m, y = j / m and
+ * x + y = k / m, and the problem is discretised by P1 (piecewise linear)
+ * finite elements on this mesh with the homogeneous Dirichlet condition.  The
+ * unknowns are the values at the interior nodes (i / m, j / m), where i, j > 0
+ * and i + j < m, enumerated row by row (by j, and by i in each row); there are
+ * (m - 1) * (m - 2) / 2 of them.
+ *
+ * A triangle with vertices T_0, T_1, T_2 is the image of the reference
+ * triangle by the affine map x -> T_0 + J x, where the columns of the matrix J
+ * are T_1 - T_0 and T_2 - T_0.  Let G = J^(-1) J^(-T).  Pulled back to the
+ * reference triangle, the stiffness matrix of the triangle is
+ *     |det J| (G_11 K_0 + G_12 K_1 + G_22 K_2),
+ * where K_0, K_1, K_2 are the matrices of the bilinear forms
+ *     (u, v) -> int dx u dx v,
+ *     (u, v) -> int (dx u dy v + dy u dx v),
+ *     (u, v) -> int dy u dy v
+ * on the reference mesh, and the mass matrix is |det J| M, where M is the
+ * mass matrix on the reference mesh.  The factor |det J| cancels in the
+ * eigenvalue problem, so the eigenvalues on the triangle are the eigenvalues
+ * of the pencil (G_11 K_0 + G_12 K_1 + G_22 K_2, M), which depends on the
+ * triangle only through the coefficients G_11, G_12, G_22 (see
+ * `fem_coefficients`).  This affine dependence is exploited in
+ * "reduced_basis.h".
+ *
+ * Matrices are stored densely in row-major order.  The number of unknowns
+ * grows quadratically with m, so m should not be much larger than 64.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__FEM_H__INCLUDED) && (__FEM_H__INCLUDED) == 1)
+
+/* Undefine __FEM_H__INCLUDED if it has already been defined. */
+#if defined(__FEM_H__INCLUDED)
+#undef __FEM_H__INCLUDED
+#endif /* __FEM_H__INCLUDED */
+
+/* Define __FEM_H__INCLUDED as 1. */
+#define __FEM_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define functions. */
+
+/**
+ * Compute the number of unknowns on the reference mesh.
+ *
+ * @param m
+ *     Number of divisions of each edge of the reference triangle.
+ *
+ * @return
+ *     The number (m - 1) * (m - 2) / 2 of interior nodes if `m` is at least 3,
+ *     0 otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+size_t fem_size (size_t m)
+#else
+inline ::size_t fem_size (::size_t m)
+#endif /* __cplusplus */
+{
+    return (m < 3U) ? 0U : (((m - 1U) * (m - 2U)) >> 1U);
+}
+
+/**
+ * Find the index of the unknown at a node of the reference mesh.
+ *
+ * @param m
+ *     Number of divisions of each edge of the reference triangle.
+ *
+ * @param i
+ *     Index of the node along the x-axis.
+ *
+ * @param j
+ *     Index of the node along the y-axis.
+ *
+ * @return
+ *     Index of the unknown at the node (i / m, j / m) if the node is interior,
+ *     `fem_size(m)` otherwise (the node is on the boundary).
+ *
+ */
+#if !defined(__cplusplus)
+size_t fem_index (size_t m, size_t i, size_t j)
+#else
+inline ::size_t fem_index (::size_t m, ::size_t i, ::size_t j)
+#endif /* __cplusplus */
+{
+    /* Nodes on the boundary have no unknown. */
+    if (!(i && j && i + j < m))
+        return fem_size(m);
+
+    /* Rows 1, ..., j - 1 precede the node, the row k has m - 1 - k nodes. */
+    return (j - 1U) * (m - 1U) - (((j - 1U) * j) >> 1U) + i - 1U;
+}
+
+/**
+ * Add the contribution of an element to the reference matrices.
+ *
+ * All elements are right triangles with legs of length 1 / m.  The gradients
+ * of the basis functions on an element are multiplied by 1 / m, so the
+ * entries of the stiffness matrices do not depend on `m`, while the entries of
+ * the mass matrix are (1 + [a == b]) / (24 m^2).
+ *
+ * @param m
+ *     Number of divisions of each edge of the reference triangle.
+ *
+ * @param I
+ *     Array of indices of the nodes of the element along the x-axis of size 3.
+ *
+ * @param J
+ *     Array of indices of the nodes of the element along the y-axis of size 3.
+ *
+ * @param gx
+ *     Array of the x-components of the scaled gradients of size 3.
+ *
+ * @param gy
+ *     Array of the y-components of the scaled gradients of size 3.
+ *
+ * @param K
+ *     Array of the stiffness matrices K_0, K_1, K_2 of size at least
+ *     3 * n * n, where n is `fem_size(m)`.
+ *
+ * @param M
+ *     Mass matrix of size at least n * n.
+ *
+ */
+#if !defined(__cplusplus)
+void fem_element (
+    size_t m,
+    const size_t* I,
+    const size_t* J,
+    const real_t* gx,
+    const real_t* gy,
+    real_t* K,
+    real_t* M
+)
+#else
+inline void fem_element (
+    ::size_t m,
+    const ::size_t* I,
+    const ::size_t* J,
+    const real_t* gx,
+    const real_t* gy,
+    real_t* K,
+    real_t* M
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of unknowns and its square. */
+    size_t n;
+    size_t nn;
+
+    /* Entry of the mass matrix on the diagonal of an element. */
+    real_t mass;
+
+    /* Indices of the unknowns. */
+    size_t p;
+    size_t q;
+
+    /* Iteration indices. */
+    size_t a;
+    size_t b;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of unknowns and its square. */
+    n = fem_size(m);
+    nn = n * n;
+
+    /* Entry of the mass matrix on the diagonal of an element. */
+    mass = 1.0 / (12.0 * (real_t)m * (real_t)m);
+
+    /* Indices of the unknowns. */
+    p = 0U;
+    q = 0U;
+
+    /* Iteration indices. */
+    a = 0U;
+    b = 0U;
+
+    /* ALGORITHM */
+
+    /* Add the contributions of all pairs of interior nodes of the element. */
+    for (a = 0U; a < 3U; ++a)
+    {
+        p = fem_index(m, *(I + a), *(J + a));
+        if (!(p < n))
+            continue;
+        for (b = 0U; b < 3U; ++b)
+        {
+            q = fem_index(m, *(I + b), *(J + b));
+            if (!(q < n))
+                continue;
+            *(K + p * n + q) += 0.5 * *(gx + a) * *(gx + b);
+            *(K + nn + p * n + q) +=
+                0.5 * (*(gx + a) * *(gy + b) + *(gy + a) * *(gx + b));
+            *(K + (nn << 1U) + p * n + q) += 0.5 * *(gy + a) * *(gy + b);
+            *(M + p * n + q) += (a == b) ? mass : 0.5 * mass;
+        }
+    }
+}
+
+/**
+ * Assemble the reference matrices.
+ *
+ * The square [i / m, (i + 1) / m] x [j / m, (j + 1) / m] is divided into the
+ * lower element with nodes (i, j), (i + 1, j), (i, j + 1) and the upper element
+ * with nodes (i + 1, j), (i + 1, j + 1), (i, j + 1) (in units of 1 / m); the
+ * upper element belongs to the reference triangle only if i + j + 2 <= m.
+ *
+ * @param m
+ *     Number of divisions of each edge of the reference triangle (at least 3).
+ *
+ * @param K
+ *     Array of size at least 3 * n * n, where n is `fem_size(m)`, to store the
+ *     stiffness matrices K_0, K_1, K_2 (in this order).
+ *
+ * @param M
+ *     Array of size at least n * n to store the mass matrix.
+ *
+ */
+#if !defined(__cplusplus)
+void fem_assemble (size_t m, real_t* K, real_t* M)
+#else
+inline void fem_assemble (::size_t m, real_t* K, real_t* M)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Scaled gradients of the basis functions on the lower element. */
+    static const real_t lower_gx[3] = { -1.0, 1.0, 0.0 };
+    static const real_t lower_gy[3] = { -1.0, 0.0, 1.0 };
+
+    /* Scaled gradients of the basis functions on the upper element. */
+    static const real_t upper_gx[3] = { 0.0, 1.0, -1.0 };
+    static const real_t upper_gy[3] = { -1.0, 1.0, 0.0 };
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of unknowns. */
+    size_t n;
+
+    /* Indices of the nodes of an element. */
+    size_t I[3];
+    size_t J[3];
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of unknowns. */
+    n = fem_size(m);
+
+    /* Indices of the nodes of an element. */
+    memset(I, 0, sizeof I);
+    memset(J, 0, sizeof J);
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If there are no unknowns or if any of the pointers is a null-pointer,
+     * there is nothing to assemble. */
+    if (!(n && K && M))
+        return;
+
+    /* Initialise the matrices to zeros. */
+    memset(K, 0, 3U * n * n * sizeof *K);
+    memset(M, 0, n * n * sizeof *M);
+
+    /* Add the contributions of the elements. */
+    for (j = 0U; j < m; ++j)
+        for (i = 0U; i + j < m; ++i)
+        {
+            /* Add the lower element. */
+            I[0] = i;
+            J[0] = j;
+            I[1] = i + 1U;
+            J[1] = j;
+            I[2] = i;
+            J[2] = j + 1U;
+            fem_element(m, I, J, lower_gx, lower_gy, K, M);
+
+            /* Add the upper element. */
+            if (i + j + 2U <= m)
+            {
+                I[0] = i + 1U;
+                J[0] = j;
+                I[1] = i + 1U;
+                J[1] = j + 1U;
+                I[2] = i;
+                J[2] = j + 1U;
+                fem_element(m, I, J, upper_gx, upper_gy, K, M);
+            }
+        }
+}
+
+/**
+ * Compute the coefficients of the stiffness matrix of a triangle.
+ *
+ * @param T
+ *     Array of coordinates of the vertices of size 6.  The array is organised
+ *     as `{x_0, y_0, x_1, y_1, x_2, y_2}`, where `x_i` is the x-coordinate of
+ *     the `i`-th vertex and `y_i` is its y-coordinate.
+ *
+ * @param theta
+ *     Array of size 3 to store the coefficients G_11, G_12, G_22 of the
+ *     matrices K_0, K_1, K_2.
+ *
+ * @return
+ *     Value `true` if the triangle is not degenerate, `false` otherwise (the
+ *     coefficients are not computed).
+ *
+ */
+#if !defined(__cplusplus)
+bool fem_coefficients (const real_t* T, real_t* theta)
+#else
+inline bool fem_coefficients (const real_t* T, real_t* theta)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Entries of the matrix J. */
+    real_t j11;
+    real_t j12;
+    real_t j21;
+    real_t j22;
+
+    /* Square of the determinant of the matrix J. */
+    real_t det2;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Entries of the matrix J. */
+    j11 = *(T + 2U) - *T;
+    j12 = *(T + 4U) - *T;
+    j21 = *(T + 3U) - *(T + 1U);
+    j22 = *(T + 5U) - *(T + 1U);
+
+    /* Square of the determinant of the matrix J. */
+    det2 = j11 * j22 - j12 * j21;
+    det2 *= det2;
+
+    /* ALGORITHM */
+
+    /* If the triangle is degenerate, return `false`. */
+    if (!det2)
+        return false;
+
+    /* Compute the entries of the matrix J^(-1) J^(-T). */
+    *theta = (j12 * j12 + j22 * j22) / det2;
+    *(theta + 1U) = -(j11 * j12 + j21 * j22) / det2;
+    *(theta + 2U) = (j11 * j11 + j21 * j21) / det2;
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Combine the reference stiffness matrices.
+ *
+ * @param n
+ *     Size of the matrices.
+ *
+ * @param K
+ *     Array of the matrices K_0, K_1, K_2 of size at least 3 * `n` * `n`.
+ *
+ * @param theta
+ *     Array of the coefficients of size 3.
+ *
+ * @param A
+ *     Array of size at least `n` * `n` to store the matrix
+ *     theta_0 K_0 + theta_1 K_1 + theta_2 K_2.
+ *
+ */
+#if !defined(__cplusplus)
+void fem_combine (size_t n, const real_t* K, const real_t* theta, real_t* A)
+#else
+inline void fem_combine (
+    ::size_t n,
+    const real_t* K,
+    const real_t* theta,
+    real_t* A
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of entries of a matrix. */
+    size_t nn;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of entries of a matrix. */
+    nn = n * n;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* Combine the matrices. */
+    for (i = 0U; i < nn; ++i)
+        *(A + i) =
+            *theta * *(K + i) +
+            *(theta + 1U) * *(K + nn + i) +
+            *(theta + 2U) * *(K + (nn << 1U) + i);
+}
+
+/**
+ * Compute the Cholesky factorisation of a symmetric positive definite matrix.
+ *
+ * The lower triangle of the matrix is overwritten by the factor L such that
+ * the matrix equals L L^T; the upper triangle (without the diagonal) is not
+ * accessed.
+ *
+ * @param n
+ *     Size of the matrix.
+ *
+ * @param A
+ *     Matrix of size at least `n` * `n`.
+ *
+ *     Caution: the array `A` is mutated in the function.
+ *
+ * @return
+ *     Value `true` if the factorisation succeeded, `false` if the matrix is
+ *     not (numerically) positive definite.
+ *
+ */
+#if !defined(__cplusplus)
+bool fem_cholesky (size_t n, real_t* A)
+#else
+inline bool fem_cholesky (::size_t n, real_t* A)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Accumulated value. */
+    real_t s;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Accumulated value. */
+    s = 0.0;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Factorise the matrix row by row. */
+    for (i = 0U; i < n; ++i)
+        for (j = 0U; j <= i; ++j)
+        {
+            s = *(A + i * n + j);
+            for (k = 0U; k < j; ++k)
+                s -= *(A + i * n + k) * *(A + j * n + k);
+            if (i == j)
+            {
+                if (!(0.0 < s))
+                    return false;
+                *(A + i * n + i) = rsqrt(s);
+            }
+            else
+                *(A + i * n + j) = s / *(A + j * n + j);
+        }
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Solve a linear system using the Cholesky factorisation of its matrix.
+ *
+ * @param n
+ *     Size of the system.
+ *
+ * @param L
+ *     Matrix factorised by the `fem_cholesky` function.
+ *
+ * @param b
+ *     Array of size at least `n` of the right-hand side.
+ *
+ *     Caution: the array `b` is overwritten by the solution.
+ *
+ * @see fem_cholesky
+ *
+ */
+#if !defined(__cplusplus)
+void fem_cholesky_solve (size_t n, const real_t* L, real_t* b)
+#else
+inline void fem_cholesky_solve (::size_t n, const real_t* L, real_t* b)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t i;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    i = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Solve the system L y = b. */
+    for (i = 0U; i < n; ++i)
+    {
+        for (k = 0U; k < i; ++k)
+            *(b + i) -= *(L + i * n + k) * *(b + k);
+        *(b + i) /= *(L + i * n + i);
+    }
+
+    /* Solve the system L^T x = y. */
+    for (i = n; i--; )
+    {
+        for (k = i + 1U; k < n; ++k)
+            *(b + i) -= *(L + k * n + i) * *(b + k);
+        *(b + i) /= *(L + i * n + i);
+    }
+}
+
+/**
+ * Compute the smallest eigenvalue of a symmetric positive definite pencil.
+ *
+ * The smallest eigenvalue of the pencil (A, M) and its eigenvector are
+ * computed by the inverse iteration x_(k + 1) = A^(-1) M x_k starting from the
+ * vector of ones, which is not orthogonal to the first eigenvector on a
+ * triangle (the first eigenfunction does not change its sign).  The
+ * eigenvalue is approximated by the Rayleigh quotient of the iterate, and the
+ * iteration stops when its relative change is at most `tol`.  The iteration
+ * converges linearly with the ratio of the first two eigenvalues.
+ *
+ * @param n
+ *     Size of the matrices.
+ *
+ * @param L
+ *     Matrix A factorised by the `fem_cholesky` function.
+ *
+ * @param M
+ *     Matrix M of size at least `n` * `n`.
+ *
+ * @param tol
+ *     Tolerance for the relative change of the eigenvalue.
+ *
+ * @param maxit
+ *     Maximal number of iterations.
+ *
+ * @param u
+ *     Array of size at least `n` to store the eigenvector normalised so that
+ *     u^T M u = 1.
+ *
+ * @param w
+ *     Array of size at least `n` for auxiliary computations.
+ *
+ * @return
+ *     The smallest eigenvalue.
+ *
+ * @see fem_cholesky
+ *
+ */
+#if !defined(__cplusplus)
+real_t fem_eigen (
+    size_t n,
+    const real_t* L,
+    const real_t* M,
+    real_t tol,
+    size_t maxit,
+    real_t* u,
+    real_t* w
+)
+#else
+inline real_t fem_eigen (
+    ::size_t n,
+    const real_t* L,
+    const real_t* M,
+    real_t tol,
+    ::size_t maxit,
+    real_t* u,
+    real_t* w
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Current and previous approximation of the eigenvalue. */
+    real_t ev;
+    real_t ev_prev;
+
+    /* Products x^T M y and y^T M y of the iterates x and y = A^(-1) M x. */
+    real_t xy;
+    real_t yy;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Current and previous approximation of the eigenvalue. */
+    ev = 0.0;
+    ev_prev = 0.0;
+
+    /* Products of the iterates. */
+    xy = 0.0;
+    yy = 0.0;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Initialise the iterate to ones. */
+    for (i = 0U; i < n; ++i)
+        *(u + i) = 1.0;
+
+    /* Iterate. */
+    for (k = 0U; k < maxit; ++k)
+    {
+        /* Compute M x. */
+        for (i = 0U; i < n; ++i)
+        {
+            *(w + i) = 0.0;
+            for (j = 0U; j < n; ++j)
+                *(w + i) += *(M + i * n + j) * *(u + j);
+        }
+
+        /* Compute y = A^(-1) M x (stored in `u`) and x^T M y as
+         * (M x)^T y. */
+        memcpy(u, w, n * sizeof *u);
+        fem_cholesky_solve(n, L, u);
+        xy = 0.0;
+        for (i = 0U; i < n; ++i)
+            xy += *(w + i) * *(u + i);
+
+        /* Compute y^T M y. */
+        yy = 0.0;
+        for (i = 0U; i < n; ++i)
+            for (j = 0U; j < n; ++j)
+                yy += *(u + i) * *(M + i * n + j) * *(u + j);
+
+        /* Compute the Rayleigh quotient y^T A y / y^T M y, which equals
+         * x^T M y / y^T M y, and normalise the iterate. */
+        ev_prev = ev;
+        ev = xy / yy;
+        yy = rsqrt(yy);
+        for (i = 0U; i < n; ++i)
+            *(u + i) /= yy;
+
+        /* Stop if the relative change of the eigenvalue is small enough. */
+        if (k && !(tol * ev < rabs(ev - ev_prev)))
+            break;
+    }
+
+    /* Return the eigenvalue. */
+    return ev;
+}
+
+#endif /* __FEM_H__INCLUDED */
@@ -0,0 +1,711 @@
+/**
+ * Functions for polygons of a number of vertices known at compile time.
+ *
+ * The functions are templated on the number of vertices `N` so that all loops
+ * and all modular indexing are resolved at compile time (the loops are
+ * unrolled using the `unroll` structure and the indices are constant
+ * expressions).  The results are the same as the results of the corresponding
+ * functions from "polygon.h" and "triangle.h" except for the singular values
+ * and the characteristic points, which are computed in closed form and may
+ * therefore differ in the last few bits.
+ *
+ * The functions `describe_polygon_fixed`, `simplify_check_polygon_fixed` and
+ * `svd_polygon_fixed` take the number of vertices at runtime as the functions
+ * from "polygon.h" do, but dispatch the common numbers of vertices to the
+ * templated functions.
+ *
+ * The program "benchmarks/fixed_polygon.cpp" compares the templated functions
+ * with the functions from "polygon.h" on random and near-degenerate polygons.
+ *
+ * The header may be used only in C++14 or newer.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__FIXED_POLYGON_H__INCLUDED) && (__FIXED_POLYGON_H__INCLUDED) == 1)
+
+/* Undefine __FIXED_POLYGON_H__INCLUDED if it has already been defined. */
+#if defined(__FIXED_POLYGON_H__INCLUDED)
+#undef __FIXED_POLYGON_H__INCLUDED
+#endif /* __FIXED_POLYGON_H__INCLUDED */
+
+/* Define __FIXED_POLYGON_H__INCLUDED as 1. */
+#define __FIXED_POLYGON_H__INCLUDED 1
+
+/* Check the language and its standard. */
+#if !defined(__cplusplus) || (__cplusplus) < 201402L
+#error "Header fixed_polygon.h may be used only in C++14 or newer."
+#endif /* __cplusplus */
+
+/* Import standard library headers. */
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+
+/**
+ * Compile-time loop over indices `I`, `I` + 1, ..., `N` - 1.
+ *
+ * Calling `unroll<I, N>::apply(f)` is equivalent to calling `f(i)` for all
+ * values of `i` from `I` to `N` - 1, but the value `i` is passed as
+ * `std::integral_constant<std::size_t, i>` so it may be used in constant
+ * expressions inside `f`.
+ *
+ */
+template <std::size_t I, std::size_t N>
+struct unroll
+{
+    template <typename F>
+    static inline void apply (F&& f)
+    {
+        f(std::integral_constant<std::size_t, I>());
+        unroll<I + 1U, N>::apply(std::forward<F>(f));
+    }
+};
+
+/**
+ * End of the compile-time loop (see the general template).
+ *
+ */
+template <std::size_t N>
+struct unroll<N, N>
+{
+    template <typename F>
+    static inline void apply (F&&)
+    {
+    }
+};
+
+/**
+ * Polygon of a number of vertices known at compile time.
+ *
+ * The coordinates are stored in the same order as in the functions from
+ * "polygon.h", i. e. `{x_0, y_0, x_1, y_1, ..., x_N_minus_1, y_N_minus_1}`.
+ *
+ */
+template <std::size_t N, typename Real = real_t>
+struct polygon
+{
+    static_assert(N >= 3U, "Polygon must have at least 3 vertices.");
+
+    /* Number of vertices. */
+    static constexpr std::size_t n = N;
+
+    /* Array of coordinates of the vertices. */
+    std::array<Real, (N << 1U)> P;
+
+    /* Coordinates of the `i`-th vertex. */
+    constexpr Real& x (std::size_t i)
+    {
+        return P[i << 1U];
+    }
+    constexpr const Real& x (std::size_t i) const
+    {
+        return P[i << 1U];
+    }
+    constexpr Real& y (std::size_t i)
+    {
+        return P[(i << 1U) + 1U];
+    }
+    constexpr const Real& y (std::size_t i) const
+    {
+        return P[(i << 1U) + 1U];
+    }
+
+    /* Pointer to the first coordinate. */
+    Real* data ()
+    {
+        return P.data();
+    }
+    const Real* data () const
+    {
+        return P.data();
+    }
+};
+
+/**
+ * Describe a polygon of `N` vertices.
+ *
+ * The result is the same as the result of the `describe_polygon` function.
+ *
+ * @param P
+ *     Array of coordinates of the vertices of size 2 * `N`.
+ *
+ * @param dx
+ *     Array of size `N` for the differences in x-coordinates.
+ *
+ * @param dy
+ *     Array of size `N` for the differences in y-coordinates.
+ *
+ * @param l
+ *     Array of size `N` for the lengths of edges.
+ *
+ * @param phi
+ *     Array of size `N` for the outer angles.
+ *
+ * @see describe_polygon
+ *
+ */
+template <std::size_t N, typename Real = real_t>
+inline void describe (
+    const Real* P,
+    Real* dx,
+    Real* dy,
+    Real* l,
+    Real* phi
+)
+{
+    /* Compute the differences in coordinates and the lengths of edges. */
+    unroll<0U, N>::apply(
+        [&] (auto i)
+        {
+            constexpr std::size_t I = decltype(i)::value;
+            constexpr std::size_t J = (I + 1U) % N;
+
+            dx[I] = P[J << 1U] - P[I << 1U];
+            dy[I] = P[(J << 1U) + 1U] - P[(I << 1U) + 1U];
+            l[I] = static_cast<Real>(std::sqrt(dx[I] * dx[I] + dy[I] * dy[I]));
+        }
+    );
+
+    /* Compute the outer angles.  The angle at the (`i` + 1)-th vertex is saved
+     * on the `i`-th place. */
+    unroll<0U, N>::apply(
+        [&] (auto i)
+        {
+            constexpr std::size_t I = decltype(i)::value;
+            constexpr std::size_t J = (I + 1U) % N;
+            constexpr std::size_t K = (I + 2U) % N;
+
+            phi[I] =
+                static_cast<Real>(
+                    std::acos((dx[I] * dx[J] + dy[I] * dy[J]) / (l[I] * l[J]))
+                );
+            if (
+                dx[I] * (P[(K << 1U) + 1U] - P[(I << 1U) + 1U]) -
+                    (P[K << 1U] - P[I << 1U]) * dy[I] <
+                0.0
+            )
+                phi[I] = -phi[I];
+        }
+    );
+}
+
+/**
+ * Describe a polygon of `N` vertices.
+ *
+ * @see describe
+ *
+ */
+template <std::size_t N, typename Real>
+inline void describe (
+    const polygon<N, Real>& P,
+    std::array<Real, N>& dx,
+    std::array<Real, N>& dy,
+    std::array<Real, N>& l,
+    std::array<Real, N>& phi
+)
+{
+    describe<N, Real>(P.data(), dx.data(), dy.data(), l.data(), phi.data());
+}
+
+/**
+ * Check if an array of `N` points is an ordered set of true vertices of a
+ * polygon.
+ *
+ * The result is the same as the result of the `check_polygon` function:  the
+ * orientations of the points are computed exactly by the functions `orient2d`
+ * and `segments_cross` (see "predicate.h").  If the type `Real` is not
+ * `real_t`, the coordinates are converted to `real_t` first, as they would be
+ * for the `check_polygon` function.
+ *
+ * @param P
+ *     Array of coordinates of the points of size 2 * `N`.
+ *
+ * @return
+ *     The same value as `check_polygon(N, P)`.
+ *
+ * @see check_polygon
+ * @see orient2d
+ * @see segments_cross
+ *
+ */
+template <std::size_t N, typename Real = real_t>
+inline bool check (const Real* P)
+{
+    /* Coordinates of the points as `real_t`. */
+    real_t Q[N << 1U];
+
+    /* Answer. */
+    bool answer = N >= 3U;
+
+    /* Convert the coordinates. */
+    unroll<0U, (N << 1U)>::apply(
+        [&] (auto i)
+        {
+            Q[decltype(i)::value] =
+                static_cast<real_t>(P[decltype(i)::value]);
+        }
+    );
+
+    /* Check consecutive points and edges. */
+    unroll<0U, N>::apply(
+        [&] (auto i)
+        {
+            constexpr std::size_t I = decltype(i)::value;
+            constexpr std::size_t I1 = (I + 1U) % N;
+            constexpr std::size_t H = (I + N - 1U) % N;
+
+            /* The points P_i0 and P_i1 must be different and the point P_i0
+             * must not be on the line through its neighbours. */
+            answer =
+                answer &&
+                !(
+                    Q[I1 << 1U] == Q[I << 1U] &&
+                    Q[(I1 << 1U) + 1U] == Q[(I << 1U) + 1U]
+                ) &&
+                static_cast<int>(
+                    orient2d(Q + (H << 1U), Q + (I << 1U), Q + (I1 << 1U))
+                );
+
+            /* Bounds of the indices of the non-neighbouring edges. */
+            constexpr std::size_t E = (I == 0U) ? N - 1U : N;
+            constexpr std::size_t S = (I + 2U < E) ? I + 2U : E;
+
+            /* The edge P_i0 P_i1 must not cross any non-neighbouring edge. */
+            unroll<S, E>::apply(
+                [&] (auto j)
+                {
+                    constexpr std::size_t J = decltype(j)::value;
+                    constexpr std::size_t J1 = (J + 1U) % N;
+
+                    answer =
+                        answer &&
+                        !segments_cross(
+                            Q + (I << 1U),
+                            Q + (I1 << 1U),
+                            Q + (J << 1U),
+                            Q + (J1 << 1U)
+                        );
+                }
+            );
+        }
+    );
+
+    /* Return the answer. */
+    return answer;
+}
+
+/**
+ * Simplify and check if an array of `N` points is an ordered set of true
+ * vertices of a polygon.
+ *
+ * If no point would be deleted by the `simplify_polygon` function (no two
+ * consecutive points are the same and no point is on the directed line through
+ * its two predecessors after them), the array is only checked via the `check`
+ * function.  Otherwise the function falls back to the `simplify_check_polygon`
+ * function.  The result is the same as the result of the
+ * `simplify_check_polygon` function in both cases.
+ *
+ * @param n
+ *     Variable for the number of points after the simplification.
+ *
+ * @param P
+ *     Array of coordinates of the points of size 2 * `N`.
+ *
+ *     Caution: the array `P` may be mutated in the function.
+ *
+ * @return
+ *     The same value as `simplify_check_polygon(&n, P)` with `n` == `N`.
+ *
+ * @see simplify_check_polygon
+ * @see check
+ *
+ */
+template <std::size_t N>
+inline bool simplify_check (::size_t& n, real_t* P)
+{
+    /* Would the array be simplified. */
+    bool simplify = false;
+
+    /* Check all triples of consecutive points. */
+    unroll<0U, N>::apply(
+        [&] (auto i)
+        {
+            constexpr std::size_t I = decltype(i)::value;
+            constexpr std::size_t J = (I + 1U) % N;
+            constexpr std::size_t K = (I + 2U) % N;
+
+            /* Differences in coordinates. */
+            const real_t dx_0_1 = P[J << 1U] - P[I << 1U];
+            const real_t dy_0_1 = P[(J << 1U) + 1U] - P[(I << 1U) + 1U];
+
+            /* The point P_j would be deleted if it is the same as the point
+             * P_i or if the point P_k is on the directed line P_i P_j after
+             * the point P_j (the orientation is computed exactly as in the
+             * `simplify_polygon` function). */
+            simplify =
+                simplify ||
+                (
+                    P[J << 1U] == P[I << 1U] &&
+                    P[(J << 1U) + 1U] == P[(I << 1U) + 1U]
+                ) ||
+                (
+                    !static_cast<int>(
+                        orient2d(P + (I << 1U), P + (J << 1U), P + (K << 1U))
+                    ) &&
+                    rsign(P[K << 1U] - P[J << 1U]) == rsign(dx_0_1) &&
+                    rsign(P[(K << 1U) + 1U] - P[(J << 1U) + 1U]) ==
+                        rsign(dy_0_1)
+                );
+        }
+    );
+
+    /* If the array would be simplified, fall back to the runtime function. */
+    if (simplify)
+    {
+        n = N;
+
+        return simplify_check_polygon(&n, P);
+    }
+
+    /* Otherwise only check the array. */
+    n = N;
+
+    return check<N, real_t>(P);
+}
+
+/**
+ * Compute the singular values of the unoriented circular matrix of an array of
+ * `N` values.
+ *
+ * The unoriented circular matrix (see the `build_unorient_circ_matrix`
+ * function) consists of the circulant matrix of the array and the circulant
+ * matrix of the reversed array.  Both circulant matrices are diagonalised by
+ * the discrete Fourier transform and their eigenvalues are of the same
+ * absolute values, hence the singular values are sqrt(2) * |a_hat_k|, where
+ * a_hat is the discrete Fourier transform of the array.  For `N` == 3 and
+ * `N` == 4 the absolute values are computed in closed form; for other numbers
+ * the function falls back to the `svd_polygon` function.
+ *
+ * The singular values are sorted descendingly as in the `svd_polygon`
+ * function.
+ *
+ * @param a
+ *     Array of size `N`.
+ *
+ * @param s
+ *     Array of size `N` for the singular values.
+ *
+ * @return
+ *     Value of the `info` variable of the SVD driver (0 if the closed form is
+ *     used).
+ *
+ * @see svd_polygon
+ *
+ */
+template <std::size_t N, typename Real = real_t>
+inline int svd (const Real* a, Real* s)
+{
+    static_assert(
+        N <= 4U || std::is_same<Real, real_t>::value,
+        "Only `real_t` is supported by the SVD driver."
+    );
+
+    /* Value of the `info` variable. */
+    int info = 0;
+
+    /* Square root of 2. */
+    const Real sqrt_2 = static_cast<Real>(std::sqrt(2.0));
+
+    /* Auxiliary variable for sorting. */
+    Real aux = 0.0;
+
+    if (N == 3U)
+    {
+        /* |a_hat_0| and |a_hat_1| == |a_hat_2|. */
+        s[0U] = sqrt_2 * std::abs(a[0U] + a[1U] + a[2U]);
+        s[1U] =
+            static_cast<Real>(
+                std::sqrt(
+                    (a[0U] - a[1U]) * (a[0U] - a[1U]) +
+                        (a[1U] - a[2U]) * (a[1U] - a[2U]) +
+                        (a[2U] - a[0U]) * (a[2U] - a[0U])
+                )
+            );
+        s[2U] = s[1U];
+
+        /* Sort the singular values. */
+        if (s[0U] < s[1U])
+        {
+            aux = s[0U];
+            s[0U] = s[1U];
+            s[2U] = aux;
+        }
+    }
+    else if (N == 4U)
+    {
+        /* |a_hat_0|, |a_hat_2| and |a_hat_1| == |a_hat_3|. */
+        s[0U] = sqrt_2 * std::abs(a[0U] + a[1U] + a[2U] + a[3U]);
+        s[1U] =
+            sqrt_2 *
+            static_cast<Real>(
+                std::sqrt(
+                    (a[0U] - a[2U]) * (a[0U] - a[2U]) +
+                        (a[1U] - a[3U]) * (a[1U] - a[3U])
+                )
+            );
+        s[2U] = s[1U];
+        s[3U] = sqrt_2 * std::abs(a[0U] - a[1U] + a[2U] - a[3U]);
+
+        /* Sort the singular values (`s[1]` == `s[2]`). */
+        if (s[0U] < s[3U])
+        {
+            aux = s[0U];
+            s[0U] = s[3U];
+            s[3U] = aux;
+        }
+        if (s[0U] < s[1U])
+        {
+            aux = s[0U];
+            s[0U] = s[1U];
+            s[2U] = aux;
+        }
+        else if (s[1U] < s[3U])
+        {
+            aux = s[3U];
+            s[3U] = s[1U];
+            s[1U] = aux;
+        }
+    }
+    else
+        svd_polygon(
+            N,
+            reinterpret_cast<const real_t*>(a),
+            reinterpret_cast<real_t*>(s),
+            nullptr,
+            &info
+        );
+
+    /* Return the value of the `info` variable. */
+    return info;
+}
+
+/**
+ * Compute the characteristic point of a triangle directly from the
+ * coordinates of its vertices.
+ *
+ * The characteristic point is the same as the one computed by the
+ * `char_triangle` function (see "triangle.h"), but no trigonometric functions
+ * are used: if U W is the longest edge, U is its end-point shared with the
+ * shortest edge and C is the third vertex, the characteristic point is
+ * (1 / 2 - (C - U) . (W - U) / |W - U|^2, |(W - U) x (C - U)| / |W - U|^2).
+ *
+ * @param P
+ *     Array of coordinates of the vertices of size 6.
+ *
+ * @param x
+ *     Variable for the x-coordinate of the characteristic point.
+ *
+ * @param y
+ *     Variable for the y-coordinate of the characteristic point.
+ *
+ * @see char_triangle
+ *
+ */
+template <typename Real = real_t>
+inline void characterise (const Real* P, Real& x, Real& y)
+{
+    /* Squared lengths of edges opposite to the vertices. */
+    Real d[3U];
+
+    /* Indices of the vertices U, W and C. */
+    std::size_t u = 0U;
+    std::size_t w = 0U;
+    std::size_t c = 0U;
+
+    /* Differences in coordinates. */
+    Real dx_w = 0.0;
+    Real dy_w = 0.0;
+    Real dx_c = 0.0;
+    Real dy_c = 0.0;
+
+    /* Compute the squared lengths of edges. */
+    unroll<0U, 3U>::apply(
+        [&] (auto i)
+        {
+            constexpr std::size_t I = decltype(i)::value;
+            constexpr std::size_t J = (I + 1U) % 3U;
+            constexpr std::size_t K = (I + 2U) % 3U;
+
+            d[I] =
+                (P[K << 1U] - P[J << 1U]) * (P[K << 1U] - P[J << 1U]) +
+                (P[(K << 1U) + 1U] - P[(J << 1U) + 1U]) *
+                    (P[(K << 1U) + 1U] - P[(J << 1U) + 1U]);
+        }
+    );
+
+    /* The vertex C is opposite to the longest edge and the vertex W is
+     * opposite to the shortest edge. */
+    c = (d[0U] < d[1U]) ? 1U : 0U;
+    if (d[c] < d[2U])
+        c = 2U;
+    w = (d[(c + 1U) % 3U] < d[(c + 2U) % 3U]) ?
+        (c + 1U) % 3U :
+        (c + 2U) % 3U;
+    u = 3U - c - w;
+
+    /* Compute the differences in coordinates. */
+    dx_w = P[w << 1U] - P[u << 1U];
+    dy_w = P[(w << 1U) + 1U] - P[(u << 1U) + 1U];
+    dx_c = P[c << 1U] - P[u << 1U];
+    dy_c = P[(c << 1U) + 1U] - P[(u << 1U) + 1U];
+
+    /* Compute the coordinates of the characteristic point. */
+    if (d[c] == 0.0)
+    {
+        x = 0.0;
+        y = 0.0;
+    }
+    else
+    {
+        x = 0.5 - (dx_c * dx_w + dy_c * dy_w) / d[c];
+        y = std::abs(dx_w * dy_c - dy_w * dx_c) / d[c];
+    }
+}
+
+/**
+ * Describe a polygon of `n` vertices.
+ *
+ * The function dispatches to the function `describe<n>` if 3 <= `n` <= 8,
+ * otherwise to the `describe_polygon` function.  The arguments are the same as
+ * the arguments of the `describe_polygon` function.
+ *
+ * @see describe_polygon
+ * @see describe
+ *
+ */
+inline void describe_polygon_fixed (
+    ::size_t n,
+    const real_t* P,
+    real_t* dx,
+    real_t* dy,
+    real_t* l,
+    real_t* phi
+)
+{
+    if (!(P && dx && dy && l && phi))
+        return;
+
+    switch (n)
+    {
+        case 3U:
+            describe<3U>(P, dx, dy, l, phi);
+            break;
+        case 4U:
+            describe<4U>(P, dx, dy, l, phi);
+            break;
+        case 5U:
+            describe<5U>(P, dx, dy, l, phi);
+            break;
+        case 6U:
+            describe<6U>(P, dx, dy, l, phi);
+            break;
+        case 7U:
+            describe<7U>(P, dx, dy, l, phi);
+            break;
+        case 8U:
+            describe<8U>(P, dx, dy, l, phi);
+            break;
+        default:
+            describe_polygon(n, P, dx, dy, l, phi);
+            break;
+    }
+}
+
+/**
+ * Simplify and check if an array of `*n` points is an ordered set of true
+ * vertices of a polygon.
+ *
+ * The function dispatches to the function `simplify_check<*n>` if
+ * 3 <= `*n` <= 8, otherwise to the `simplify_check_polygon` function.  The
+ * arguments are the same as the arguments of the `simplify_check_polygon`
+ * function.
+ *
+ * @see simplify_check_polygon
+ * @see simplify_check
+ *
+ */
+inline bool simplify_check_polygon_fixed (::size_t* n, real_t* P)
+{
+    if (!(n && P))
+        return simplify_check_polygon(n, P);
+
+    switch (*n)
+    {
+        case 3U:
+            return simplify_check<3U>(*n, P);
+        case 4U:
+            return simplify_check<4U>(*n, P);
+        case 5U:
+            return simplify_check<5U>(*n, P);
+        case 6U:
+            return simplify_check<6U>(*n, P);
+        case 7U:
+            return simplify_check<7U>(*n, P);
+        case 8U:
+            return simplify_check<8U>(*n, P);
+        default:
+            return simplify_check_polygon(n, P);
+    }
+}
+
+/**
+ * Compute the singular values of the lengths or the outer edges of a polygon.
+ *
+ * The function dispatches to the function `svd<n>` if `n` is 3 or 4 and `s`
+ * is not a null-pointer, otherwise to the `svd_polygon` function.  The
+ * arguments and the returned value are the same as in the `svd_polygon`
+ * function, except that the array `A` is not used in the closed form.
+ *
+ * @see svd_polygon
+ * @see svd
+ *
+ */
+inline real_t* svd_polygon_fixed (
+    ::size_t n,
+    const real_t* a,
+    real_t* s,
+    real_t* A,
+    int* info
+)
+{
+    if (a && s && info)
+        switch (n)
+        {
+            case 3U:
+                *info = svd<3U>(a, s);
+                return s;
+            case 4U:
+                *info = svd<4U>(a, s);
+                return s;
+            default:
+                break;
+        }
+
+    return svd_polygon(n, a, s, A, info);
+}
+
+#endif /* __FIXED_POLYGON_H__INCLUDED */
@@ -0,0 +1,892 @@
+/**
+ * Streamed least squares by Gram matrices with k-fold cross-validation.
+ *
+ * A linear least squares problem of m features is solved from the Gram
+ * matrix X^T X, the vector X^T y and the value y^T y, which are sums over the
+ * rows of the data, so the rows are streamed block by block and never stored
+ * at once.  For the cross-validation the rows are split into k folds (the
+ * i-th row of the data belongs to the fold i mod k) and the sums are
+ * accumulated for each fold separately:  the model of the j-th fold is fitted
+ * on the sums of all folds minus the sums of the j-th fold, and its squared
+ * error on the j-th fold is
+ *     b^T G_j b - 2 b^T (X^T y)_j + (y^T y)_j,
+ * where b are the coefficients of the model and G_j is the Gram matrix of the
+ * fold, so the cross-validation needs a single pass through the data.
+ *
+ * If the features are ordered so that the features of a smaller model are the
+ * first features of a larger model (as the monomials of polynomials of
+ * increasing degrees, see the function `polynomial_terms` in "polynomial.h"),
+ * the Gram matrix of the smaller model is the leading block of the Gram
+ * matrix of the larger model, and so is the Cholesky factor.  Hence the sums
+ * are accumulated and factorised once for the largest model, and every
+ * smaller model is solved from the leading block of the factor.
+ *
+ * The sums of a fold (a slot) are stored consecutively as
+ *     G	X^T y	y^T y	n
+ * where G is the m x m Gram matrix in column-major order (only its upper
+ * triangle is used) and n is the number of rows.  An accumulator holds
+ * k + 1 slots, the last one being the sum of the slots of all folds (see the
+ * function `gram_reduce`).  The matrix products are computed by the BLAS
+ * routines xSYRK and xGEMV in threads, each accumulating a contiguous part of
+ * a block to its own accumulator as in the function `mps_solve_batch` (see
+ * "mps.h"), and the systems are solved by the LAPACK routines xPOTRF and
+ * xPOTRS after scaling the matrices to a unit diagonal.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__GRAM_H__INCLUDED) && (__GRAM_H__INCLUDED) == 1)
+
+/* Undefine __GRAM_H__INCLUDED if it has already been defined. */
+#if defined(__GRAM_H__INCLUDED)
+#undef __GRAM_H__INCLUDED
+#endif /* __GRAM_H__INCLUDED */
+
+/* Define __GRAM_H__INCLUDED as 1. */
+#define __GRAM_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import POSIX threads. */
+#include <pthread.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define names of the BLAS and LAPACK routines of the symmetric rank-k update,
+ * of the matrix-vector multiplication and of the Cholesky factorisation and
+ * solution for the type `real_t`. */
+#if defined(_GRAM_SYRK)
+#undef _GRAM_SYRK
+#endif /* _GRAM_SYRK */
+#if defined(_GRAM_GEMV)
+#undef _GRAM_GEMV
+#endif /* _GRAM_GEMV */
+#if defined(_GRAM_POTRF)
+#undef _GRAM_POTRF
+#endif /* _GRAM_POTRF */
+#if defined(_GRAM_POTRS)
+#undef _GRAM_POTRS
+#endif /* _GRAM_POTRS */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define _GRAM_SYRK ssyrk_
+#define _GRAM_GEMV sgemv_
+#define _GRAM_POTRF spotrf_
+#define _GRAM_POTRS spotrs_
+#else
+#define _GRAM_SYRK dsyrk_
+#define _GRAM_GEMV dgemv_
+#define _GRAM_POTRF dpotrf_
+#define _GRAM_POTRS dpotrs_
+#endif /* _REAL_PRECISION */
+
+/* Import the BLAS and LAPACK routines.  In C++ the routines must be declared
+ * with the C linkage. */
+#if defined(__cplusplus)
+extern "C"
+{
+#endif /* __cplusplus */
+extern void _GRAM_SYRK (
+    char* UPLO,
+    char* TRANS,
+    int* N,
+    int* K,
+    real_t* ALPHA,
+    real_t* A,
+    int* LDA,
+    real_t* BETA,
+    real_t* C,
+    int* LDC
+);
+extern void _GRAM_GEMV (
+    char* TRANS,
+    int* M,
+    int* N,
+    real_t* ALPHA,
+    real_t* A,
+    int* LDA,
+    real_t* X,
+    int* INCX,
+    real_t* BETA,
+    real_t* Y,
+    int* INCY
+);
+extern void _GRAM_POTRF (
+    char* UPLO,
+    int* N,
+    real_t* A,
+    int* LDA,
+    int* INFO
+);
+extern void _GRAM_POTRS (
+    char* UPLO,
+    int* N,
+    int* NRHS,
+    real_t* A,
+    int* LDA,
+    real_t* B,
+    int* LDB,
+    int* INFO
+);
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/* Define types. */
+
+/**
+ * Job of a thread accumulating a part of a block of rows.
+ *
+ */
+typedef struct gram_job_struct
+{
+    /* Number of features and number of folds. */
+    size_t m;
+    size_t k;
+
+    /* Index (in the data) of the first row and the number of rows. */
+    size_t offset;
+    size_t n;
+
+    /* Features (a column of `m` values per row) and targets. */
+    const real_t* Z;
+    const real_t* y;
+
+    /* Accumulator. */
+    real_t* A;
+
+    /* Workspace of size at least (`m` + 1) `n`. */
+    real_t* W;
+}
+gram_job_t;
+
+/* Define functions. */
+
+/**
+ * Compute the number of values of a slot of an accumulator.
+ *
+ * @param m
+ *     Number of features.
+ *
+ * @return
+ *     Number of values of a slot, m^2 + m + 2.
+ *
+ */
+#if !defined(__cplusplus)
+size_t gram_slot (size_t m)
+#else
+inline ::size_t gram_slot (::size_t m)
+#endif /* __cplusplus */
+{
+    return m * m + m + 2U;
+}
+
+/**
+ * Accumulate a part of a block of rows to an accumulator.
+ *
+ * The function is the starting routine of the threads of the function
+ * `gram_accumulate`.  The rows of each fold are gathered in the workspace and
+ * added to the slot of the fold by a single call of each of the BLAS routines.
+ *
+ * @param job
+ *     Pointer to the job (of the type `gram_job_t`).
+ *
+ * @return
+ *     The null-pointer.
+ *
+ * @see gram_accumulate
+ *
+ */
+#if !defined(__cplusplus)
+void* gram_job (void* job)
+#else
+extern "C" inline void* gram_job (void* job)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Job. */
+    gram_job_t* J;
+
+    /* Arguments of the BLAS routines. */
+    char uplo;
+    char no;
+    int m;
+    int n;
+    int one_int;
+    real_t one;
+
+    /* Pointer to the slot of the fold and the pointer to the targets of the
+     * fold in the workspace. */
+    real_t* S;
+    real_t* w;
+
+    /* Number of rows of the fold. */
+    size_t n_f;
+
+    /* Iteration indices. */
+    size_t f;
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Job. */
+    J = (gram_job_t*)job;
+
+    /* Arguments of the BLAS routines. */
+    uplo = 'U';
+    no = 'N';
+    m = 0;
+    n = 0;
+    one_int = 1;
+    one = 1.0;
+
+    /* Pointers. */
+    S = (real_t*)(NULL);
+    w = (real_t*)(NULL);
+
+    /* Number of rows of the fold. */
+    n_f = 0U;
+
+    /* Iteration indices. */
+    f = 0U;
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If there is no job or no rows, return the null-pointer. */
+    if (!(J && J->n))
+        return NULL;
+    m = (int)J->m;
+    w = J->W + J->m * J->n;
+
+    /* Accumulate the rows fold by fold. */
+    for (f = 0U; f < J->k; ++f)
+    {
+        /* Gather the rows of the fold. */
+        n_f = 0U;
+        for (
+            i = (f + J->k - J->offset % J->k) % J->k;
+            i < J->n;
+            i += J->k, ++n_f
+        )
+        {
+            memcpy(J->W + n_f * J->m, J->Z + i * J->m, J->m * sizeof *J->W);
+            *(w + n_f) = *(J->y + i);
+        }
+        if (!n_f)
+            continue;
+        n = (int)n_f;
+
+        /* Add the Gram matrix, the vector X^T y, the value y^T y and the
+         * number of rows of the fold. */
+        S = J->A + f * gram_slot(J->m);
+        _GRAM_SYRK(&uplo, &no, &m, &n, &one, J->W, &m, &one, S, &m);
+        _GRAM_GEMV(
+            &no,
+            &m,
+            &n,
+            &one,
+            J->W,
+            &m,
+            w,
+            &one_int,
+            &one,
+            S + J->m * J->m,
+            &one_int
+        );
+        for (i = 0U; i < n_f; ++i)
+            *(S + J->m * J->m + J->m) += *(w + i) * *(w + i);
+        *(S + J->m * J->m + J->m + 1U) += (real_t)n_f;
+    }
+
+    /* Return the null-pointer. */
+    return NULL;
+}
+
+/**
+ * Accumulate a block of rows in parallel.
+ *
+ * Rows are split into `T` contiguous groups of (almost) the same size and
+ * each group is accumulated in its own thread to its own accumulator (the
+ * first group is accumulated in the calling thread).  If the memory for the
+ * jobs cannot be allocated or if a thread cannot be created, the rows are
+ * accumulated in the calling thread.
+ *
+ * @param m
+ *     Number of features.
+ *
+ * @param k
+ *     Number of folds (at least 1).
+ *
+ * @param offset
+ *     Index (in the data) of the first row of the block.
+ *
+ * @param n
+ *     Number of rows of the block.
+ *
+ * @param Z
+ *     Array of the features of size at least `m` `n` (a column of `m` values
+ *     per row, in column-major order).
+ *
+ * @param y
+ *     Array of the targets of size at least `n`.
+ *
+ * @param T
+ *     Number of threads (if 0, a single thread is used).
+ *
+ * @param A
+ *     Array of `T` accumulators of (`k` + 1) `gram_slot(m)` values each,
+ *     initialised to zeros before the first block.
+ *
+ * @param W
+ *     Workspace of size at least (`m` + 1) `n`.
+ *
+ * @see gram_slot
+ * @see gram_job
+ * @see gram_reduce
+ *
+ */
+#if !defined(__cplusplus)
+void gram_accumulate (
+    size_t m,
+    size_t k,
+    size_t offset,
+    size_t n,
+    const real_t* Z,
+    const real_t* y,
+    size_t T,
+    real_t* A,
+    real_t* W
+)
+#else
+inline void gram_accumulate (
+    ::size_t m,
+    ::size_t k,
+    ::size_t offset,
+    ::size_t n,
+    const real_t* Z,
+    const real_t* y,
+    ::size_t T,
+    real_t* A,
+    real_t* W
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Single job (if the memory allocation fails). */
+    gram_job_t single;
+
+    /* Array of jobs. */
+    gram_job_t* jobs;
+
+    /* Array of threads. */
+    pthread_t* threads;
+
+    /* Array of indicators of successfully created threads. */
+    bool* created;
+
+    /* Number of rows in the jobs so far. */
+    size_t done;
+
+    /* Iteration index. */
+    size_t t;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Single job. */
+    memset(&single, 0, sizeof single);
+
+    /* Array of jobs. */
+    jobs = (gram_job_t*)(NULL);
+
+    /* Array of threads. */
+    threads = (pthread_t*)(NULL);
+
+    /* Array of indicators of successfully created threads. */
+    created = (bool*)(NULL);
+
+    /* Number of rows in the jobs so far. */
+    done = 0U;
+
+    /* Iteration index. */
+    t = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer or if there are no features or
+     * no folds, there is nothing to accumulate. */
+    if (!(Z && y && A && W && m && k))
+        return;
+
+    /* Use at least 1 and at most `n` threads. */
+    if (T > n)
+        T = n;
+    if (!T)
+        T = 1U;
+
+    /* Allocate memory for the jobs, the threads and the indicators. */
+#if !defined(__cplusplus)
+    jobs = (gram_job_t*)malloc(T * sizeof *jobs);
+    threads = (pthread_t*)malloc(T * sizeof *threads);
+    created = (bool*)malloc(T * sizeof *created);
+#else
+    jobs = static_cast<gram_job_t*>(::malloc(T * sizeof *jobs));
+    threads = static_cast<pthread_t*>(::malloc(T * sizeof *threads));
+    created = static_cast<bool*>(::malloc(T * sizeof *created));
+#endif /* __cplusplus */
+
+    /* If the memory allocation has failed, deallocate memory and accumulate
+     * all rows in the calling thread. */
+    if (!(jobs && threads && created))
+    {
+        /* Deallocate memory for the jobs, the threads and the indicators. */
+        free(jobs);
+        jobs = (gram_job_t*)(NULL);
+        free(threads);
+        threads = (pthread_t*)(NULL);
+        free(created);
+        created = (bool*)(NULL);
+
+        /* Accumulate the rows. */
+        single.m = m;
+        single.k = k;
+        single.offset = offset;
+        single.n = n;
+        single.Z = Z;
+        single.y = y;
+        single.A = A;
+        single.W = W;
+        gram_job((void*)(&single));
+
+        return;
+    }
+
+    /* Initialise the jobs. */
+    for (t = 0U; t < T; ++t)
+    {
+        (jobs + t)->m = m;
+        (jobs + t)->k = k;
+        (jobs + t)->offset = offset + done;
+        (jobs + t)->n = n / T + (t < n % T);
+        (jobs + t)->Z = Z + done * m;
+        (jobs + t)->y = y + done;
+        (jobs + t)->A = A + t * (k + 1U) * gram_slot(m);
+        (jobs + t)->W = W + done * (m + 1U);
+        *(created + t) = false;
+
+        done += (jobs + t)->n;
+    }
+
+    /* Start the threads for all jobs but the first one. */
+    for (t = 1U; t < T; ++t)
+        *(created + t) =
+            !pthread_create(threads + t, NULL, gram_job, (void*)(jobs + t));
+
+    /* Do the first job and the jobs whose threads could not be created in the
+     * calling thread. */
+    for (t = 0U; t < T; ++t)
+        if (!*(created + t))
+            gram_job((void*)(jobs + t));
+
+    /* Wait for the threads to finish. */
+    for (t = 1U; t < T; ++t)
+        if (*(created + t))
+            pthread_join(*(threads + t), NULL);
+
+    /* Clear the memory in the array of jobs. */
+    memset(jobs, 0, T * sizeof *jobs);
+
+    /* Deallocate memory for the jobs, the threads and the indicators. */
+    free(jobs);
+    jobs = (gram_job_t*)(NULL);
+    free(threads);
+    threads = (pthread_t*)(NULL);
+    free(created);
+    created = (bool*)(NULL);
+}
+
+/**
+ * Reduce the accumulators of threads to the first accumulator.
+ *
+ * The accumulators are added to the first accumulator, and its last slot is
+ * set to the sum of the slots of all folds.
+ *
+ * @param m
+ *     Number of features.
+ *
+ * @param k
+ *     Number of folds.
+ *
+ * @param T
+ *     Number of accumulators.
+ *
+ * @param A
+ *     Array of `T` accumulators of (`k` + 1) `gram_slot(m)` values each.
+ *
+ * @see gram_accumulate
+ *
+ */
+#if !defined(__cplusplus)
+void gram_reduce (size_t m, size_t k, size_t T, real_t* A)
+#else
+inline void gram_reduce (::size_t m, ::size_t k, ::size_t T, real_t* A)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of values of a slot. */
+    size_t s;
+
+    /* Iteration indices. */
+    size_t t;
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of values of a slot. */
+    s = gram_slot(m);
+
+    /* Iteration indices. */
+    t = 0U;
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If the pointer `A` is a null-pointer, there is nothing to reduce. */
+    if (!A)
+        return;
+
+    /* Add the accumulators of the other threads. */
+    for (t = 1U; t < T; ++t)
+        for (i = 0U; i < k * s; ++i)
+            *(A + i) += *(A + t * (k + 1U) * s + i);
+
+    /* Sum the slots of the folds. */
+    memset(A + k * s, 0, s * sizeof *A);
+    for (t = 0U; t < k; ++t)
+        for (i = 0U; i < s; ++i)
+            *(A + k * s + i) += *(A + t * s + i);
+}
+
+/**
+ * Factorise the Gram matrix of the training rows of a fold.
+ *
+ * The Gram matrix of all folds but the `j`-th (or of all folds if `j` is
+ * `k`) is scaled to a unit diagonal and factorised by the Cholesky
+ * factorisation.  If the matrix is singular, its largest nonsingular leading
+ * block is still factorised.
+ *
+ * @param m
+ *     Number of features.
+ *
+ * @param k
+ *     Number of folds.
+ *
+ * @param j
+ *     Index of the fold left out (`k` for none).
+ *
+ * @param A
+ *     Accumulator reduced by the function `gram_reduce`.
+ *
+ * @param L
+ *     Array of size at least `m` * `m` to store the Cholesky factor (the upper
+ *     triangle in column-major order).
+ *
+ * @param s
+ *     Array of size at least `m` to store the scaling factors.
+ *
+ * @return
+ *     Number of features of the largest factorised leading block (`m` if the
+ *     matrix is positive definite).
+ *
+ * @see gram_reduce
+ * @see gram_solve
+ *
+ */
+#if !defined(__cplusplus)
+size_t gram_factor (
+    size_t m,
+    size_t k,
+    size_t j,
+    const real_t* A,
+    real_t* L,
+    real_t* s
+)
+#else
+inline ::size_t gram_factor (
+    ::size_t m,
+    ::size_t k,
+    ::size_t j,
+    const real_t* A,
+    real_t* L,
+    real_t* s
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Arguments of the LAPACK routine. */
+    char uplo;
+    int n;
+    int info;
+
+    /* Gram matrices of all folds and of the left out fold. */
+    const real_t* G;
+    const real_t* G_j;
+
+    /* Iteration indices. */
+    size_t p;
+    size_t q;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Arguments of the LAPACK routine. */
+    uplo = 'U';
+    n = (int)m;
+    info = 0;
+
+    /* Gram matrices. */
+    G = A + k * gram_slot(m);
+    G_j = (j < k) ? A + j * gram_slot(m) : (const real_t*)(NULL);
+
+    /* Iteration indices. */
+    p = 0U;
+    q = 0U;
+
+    /* ALGORITHM */
+
+    /* Compute the training Gram matrix and the scaling factors (a
+     * non-positive diagonal element is left unscaled so that the factorisation
+     * stops at it). */
+    for (q = 0U; q < m; ++q)
+        for (p = 0U; p <= q; ++p)
+            *(L + p + q * m) =
+                *(G + p + q * m) - (G_j ? *(G_j + p + q * m) : 0.0);
+    for (p = 0U; p < m; ++p)
+        *(s + p) =
+            (*(L + p + p * m) > 0.0) ? 1.0 / rsqrt(*(L + p + p * m)) : 1.0;
+
+    /* Scale and factorise the matrix. */
+    for (q = 0U; q < m; ++q)
+        for (p = 0U; p <= q; ++p)
+            *(L + p + q * m) *= *(s + p) * *(s + q);
+    _GRAM_POTRF(&uplo, &n, L, &n, &info);
+
+    /* Return the number of features of the factorised leading block. */
+    return info ? (size_t)(info - 1) : m;
+}
+
+/**
+ * Solve the least squares problem of the first features of a fold.
+ *
+ * @param m
+ *     Number of features.
+ *
+ * @param k
+ *     Number of folds.
+ *
+ * @param j
+ *     Index of the fold left out (`k` for none), the same as in the call of
+ *     the function `gram_factor`.
+ *
+ * @param M
+ *     Number of the first features of the model (at most the number returned
+ *     by the function `gram_factor`).
+ *
+ * @param A
+ *     Accumulator reduced by the function `gram_reduce`.
+ *
+ * @param L
+ *     Cholesky factor computed by the function `gram_factor`.
+ *
+ * @param s
+ *     Scaling factors computed by the function `gram_factor`.
+ *
+ * @param b
+ *     Array of size at least `M` to store the coefficients of the model.
+ *
+ * @return
+ *     Value `true` if the system was solved, `false` otherwise.
+ *
+ * @see gram_factor
+ *
+ */
+#if !defined(__cplusplus)
+bool gram_solve (
+    size_t m,
+    size_t k,
+    size_t j,
+    size_t M,
+    const real_t* A,
+    const real_t* L,
+    const real_t* s,
+    real_t* b
+)
+#else
+inline bool gram_solve (
+    ::size_t m,
+    ::size_t k,
+    ::size_t j,
+    ::size_t M,
+    const real_t* A,
+    const real_t* L,
+    const real_t* s,
+    real_t* b
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Arguments of the LAPACK routine. */
+    char uplo;
+    int n;
+    int lda;
+    int nrhs;
+    int info;
+
+    /* Vectors X^T y of all folds and of the left out fold. */
+    const real_t* c;
+    const real_t* c_j;
+
+    /* Iteration index. */
+    size_t p;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Arguments of the LAPACK routine. */
+    uplo = 'U';
+    n = (int)M;
+    lda = (int)m;
+    nrhs = 1;
+    info = 0;
+
+    /* Vectors X^T y. */
+    c = A + k * gram_slot(m) + m * m;
+    c_j = (j < k) ? A + j * gram_slot(m) + m * m : (const real_t*)(NULL);
+
+    /* Iteration index. */
+    p = 0U;
+
+    /* ALGORITHM */
+
+    /* If there are no features, return `false`. */
+    if (!M)
+        return false;
+
+    /* Solve the scaled system and scale the solution back. */
+    for (p = 0U; p < M; ++p)
+        *(b + p) = *(s + p) * (*(c + p) - (c_j ? *(c_j + p) : 0.0));
+    _GRAM_POTRS(&uplo, &n, &nrhs, (real_t*)L, &lda, b, &n, &info);
+    for (p = 0U; p < M; ++p)
+        *(b + p) *= *(s + p);
+
+    /* Return the indicator of success. */
+    return !info;
+}
+
+/**
+ * Compute the squared error of a model on the rows of a fold.
+ *
+ * @param m
+ *     Number of features.
+ *
+ * @param j
+ *     Index of the fold (or of the last slot for all rows).
+ *
+ * @param M
+ *     Number of the first features of the model.
+ *
+ * @param A
+ *     Accumulator reduced by the function `gram_reduce`.
+ *
+ * @param b
+ *     Array of the `M` coefficients of the model.
+ *
+ * @return
+ *     Sum of the squared errors of the model on the rows of the fold.
+ *
+ */
+#if !defined(__cplusplus)
+real_t gram_error (
+    size_t m,
+    size_t j,
+    size_t M,
+    const real_t* A,
+    const real_t* b
+)
+#else
+inline real_t gram_error (
+    ::size_t m,
+    ::size_t j,
+    ::size_t M,
+    const real_t* A,
+    const real_t* b
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Slot of the fold. */
+    const real_t* S;
+
+    /* Squared error and the product of a row of the Gram matrix and the
+     * coefficients. */
+    real_t e;
+    real_t g;
+
+    /* Iteration indices. */
+    size_t p;
+    size_t q;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Slot of the fold. */
+    S = A + j * gram_slot(m);
+
+    /* Squared error and the product. */
+    e = *(S + m * m + m);
+    g = 0.0;
+
+    /* Iteration indices. */
+    p = 0U;
+    q = 0U;
+
+    /* ALGORITHM */
+
+    /* Compute b^T G b - 2 b^T (X^T y) + y^T y from the upper triangle of G. */
+    for (p = 0U; p < M; ++p)
+    {
+        g = *(S + p + p * m) * *(b + p);
+        for (q = p + 1U; q < M; ++q)
+            g += 2.0 * *(S + p + q * m) * *(b + q);
+        e += *(b + p) * (g - 2.0 * *(S + m * m + p));
+    }
+
+    /* Return the squared error (non-negative up to rounding). */
+    return e;
+}
+
+#endif /* __GRAM_H__INCLUDED */
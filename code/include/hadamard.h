@@ -0,0 +1,476 @@
+/**
+ * First-order prediction of the first Laplace eigenvalue of perturbed polygons
+ * by Hadamard's formula.
+ *
+ * If the boundary of a domain moves with the normal velocity V, the first
+ * Dirichlet eigenvalue changes as
+ *     d lambda = -int_boundary (du / dnu)^2 V ds,
+ * where u is the first eigenfunction normalised in L^2 and nu is the outer
+ * normal (Hadamard's formula).  If the vertices of a polygon are displaced by
+ * the vectors delta_k, the points of the e-th edge (from the e-th vertex at
+ * t = 0 to the next vertex at t = 1) move by (1 - t) delta_e + t delta_(e + 1),
+ * so the change of the eigenvalue depends on the squared flux only through its
+ * two moments
+ *     M_(e, 0) = int_e (du / dnu)^2 (1 - t) ds,
+ *     M_(e, 1) = int_e (du / dnu)^2 t ds
+ * per edge.  The moments are exported by the script "computer.edp" (option
+ * "-flux"), and the function `hadamard_gradient` turns them into the gradient
+ * of the eigenvalue with respect to the coordinates of the vertices.  A single
+ * eigenvalue solution of a base polygon then predicts the eigenvalues of all
+ * its small perturbations (see "generators/perturbator.c") by the function
+ * `hadamard_predict`.
+ *
+ * Since the perturbed polygons are normalised (translated, rotated, scaled
+ * and their vertices renumbered), each perturbed polygon is first aligned to
+ * the base polygon by the best similarity transformation (see the function
+ * `hadamard_align`);  the eigenvalue is invariant to translations, rotations
+ * and reflections, and it scales by the inverse square of the scale, so only
+ * the residual displacement of the vertices enters the formula.
+ *
+ * The neglected second-order term is estimated by
+ * 3 / 4 (sum_k |g_k| |delta_k|)^2 / lambda, where g_k is the gradient at the
+ * k-th vertex.  The estimate is
+ * exact for a displacement which scales the polygon (when the eigenvalue
+ * behaves as lambda / (1 + epsilon)^2), and the absolute values make it
+ * conservative for displacements whose first-order effects cancel out.
+ * Polygons whose estimated relative error exceeds a tolerance should be
+ * solved by a full solver.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__HADAMARD_H__INCLUDED) && (__HADAMARD_H__INCLUDED) == 1)
+
+/* Undefine __HADAMARD_H__INCLUDED if it has already been defined. */
+#if defined(__HADAMARD_H__INCLUDED)
+#undef __HADAMARD_H__INCLUDED
+#endif /* __HADAMARD_H__INCLUDED */
+
+/* Define __HADAMARD_H__INCLUDED as 1. */
+#define __HADAMARD_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define functions. */
+
+/**
+ * Compute the gradient of the first eigenvalue with respect to the
+ * coordinates of the vertices of a polygon.
+ *
+ * The gradient at the k-th vertex is
+ *     g_k = -(M_(k, 0) nu_k + M_(k - 1, 1) nu_(k - 1)),
+ * where nu_e is the outer unit normal of the e-th edge.
+ *
+ * @param n
+ *     Number of vertices.
+ *
+ * @param P
+ *     Array of vertices of size at least 2 * `n` organised as in the
+ *     `describe_polygon` function (in the mathematically positive order).
+ *
+ * @param M
+ *     Array of the moments of the squared flux of size at least 2 * `n`
+ *     organised as `{M_(0, 0), M_(0, 1), M_(1, 0), M_(1, 1), ...}`.
+ *
+ * @param G
+ *     Array of size at least 2 * `n` to store the gradient (organised as the
+ *     array `P`).
+ *
+ * @see describe_polygon
+ *
+ */
+#if !defined(__cplusplus)
+void hadamard_gradient (size_t n, const real_t* P, const real_t* M, real_t* G)
+#else
+inline void hadamard_gradient (
+    ::size_t n,
+    const real_t* P,
+    const real_t* M,
+    real_t* G
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Outer unit normal of an edge. */
+    real_t nx;
+    real_t ny;
+    real_t l;
+
+    /* Iteration index and the index of the next vertex. */
+    size_t e;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Outer unit normal of an edge. */
+    nx = 0.0;
+    ny = 0.0;
+    l = 0.0;
+
+    /* Iteration index and the index of the next vertex. */
+    e = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Initialise the gradient to zeros. */
+    memset(G, 0, (n << 1U) * sizeof *G);
+
+    /* Add the contributions of the edges to the gradients at their ends. */
+    for (e = 0U; e < n; ++e)
+    {
+        k = incmod(e, n);
+        nx = *(P + (k << 1U) + 1U) - *(P + (e << 1U) + 1U);
+        ny = *(P + (e << 1U)) - *(P + (k << 1U));
+        l = rsqrt(nx * nx + ny * ny);
+        if (!(0.0 < l))
+            continue;
+        nx /= l;
+        ny /= l;
+        *(G + (e << 1U)) -= *(M + (e << 1U)) * nx;
+        *(G + (e << 1U) + 1U) -= *(M + (e << 1U)) * ny;
+        *(G + (k << 1U)) -= *(M + (e << 1U) + 1U) * nx;
+        *(G + (k << 1U) + 1U) -= *(M + (e << 1U) + 1U) * ny;
+    }
+}
+
+/**
+ * Align a polygon to a base polygon by a similarity transformation.
+ *
+ * Points are treated as complex numbers.  For each of the `n` cyclic
+ * renumberings of the vertices of the polygon Q, with and without a
+ * reflection, the similarity z -> a z + b (or z -> a conj(z) + b) of the base
+ * polygon P closest to Q in the least squares sense is computed in closed
+ * form, and the best one is used to map Q back to the frame of P.
+ *
+ * @param n
+ *     Number of vertices.
+ *
+ * @param P
+ *     Array of vertices of the base polygon of size at least 2 * `n`
+ *     organised as in the `describe_polygon` function.
+ *
+ * @param Q
+ *     Array of vertices of the polygon to align of size at least 2 * `n`
+ *     organised as the array `P`.
+ *
+ * @param R
+ *     Array of size at least 2 * `n` to store the polygon Q mapped to the frame
+ *     of P (its `k`-th vertex corresponds to the `k`-th vertex of P).
+ *
+ * @return
+ *     Scale |a| of the similarity (the polygon Q is |a| times larger than the
+ *     polygon `R`), or 0 if the base polygon is degenerate.
+ *
+ * @see describe_polygon
+ *
+ */
+#if !defined(__cplusplus)
+real_t hadamard_align (size_t n, const real_t* P, const real_t* Q, real_t* R)
+#else
+inline real_t hadamard_align (
+    ::size_t n,
+    const real_t* P,
+    const real_t* Q,
+    real_t* R
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Centroids of the vertices of the polygons. */
+    real_t px;
+    real_t py;
+    real_t qx;
+    real_t qy;
+
+    /* Centred vertices. */
+    real_t ux;
+    real_t uy;
+    real_t vx;
+    real_t vy;
+
+    /* Sum of squared norms of the centred vertices of P. */
+    real_t norm;
+
+    /* Correlation of the renumbered polygons and its best value. */
+    real_t cx;
+    real_t cy;
+    real_t best;
+
+    /* Coefficient a of the best similarity. */
+    real_t ax;
+    real_t ay;
+    real_t a2;
+
+    /* Best renumbering (the shift and the reflection). */
+    size_t shift;
+    bool reflect;
+
+    /* Index of the corresponding vertex of Q. */
+    size_t j;
+
+    /* Iteration indices. */
+    size_t s;
+    size_t f;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Centroids of the vertices of the polygons. */
+    px = 0.0;
+    py = 0.0;
+    qx = 0.0;
+    qy = 0.0;
+
+    /* Centred vertices. */
+    ux = 0.0;
+    uy = 0.0;
+    vx = 0.0;
+    vy = 0.0;
+
+    /* Sum of squared norms of the centred vertices of P. */
+    norm = 0.0;
+
+    /* Correlation of the renumbered polygons and its best value. */
+    cx = 0.0;
+    cy = 0.0;
+    best = -1.0;
+
+    /* Coefficient a of the best similarity. */
+    ax = 0.0;
+    ay = 0.0;
+    a2 = 0.0;
+
+    /* Best renumbering (the shift and the reflection). */
+    shift = 0U;
+    reflect = false;
+
+    /* Index of the corresponding vertex of Q. */
+    j = 0U;
+
+    /* Iteration indices. */
+    s = 0U;
+    f = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Compute the centroids of the vertices. */
+    for (k = 0U; k < n; ++k)
+    {
+        px += *(P + (k << 1U));
+        py += *(P + (k << 1U) + 1U);
+        qx += *(Q + (k << 1U));
+        qy += *(Q + (k << 1U) + 1U);
+    }
+    px /= (real_t)n;
+    py /= (real_t)n;
+    qx /= (real_t)n;
+    qy /= (real_t)n;
+
+    /* Compute the sum of squared norms of the centred vertices of P. */
+    for (k = 0U; k < n; ++k)
+    {
+        ux = *(P + (k << 1U)) - px;
+        uy = *(P + (k << 1U) + 1U) - py;
+        norm += ux * ux + uy * uy;
+    }
+    if (!(0.0 < norm))
+        return 0.0;
+
+    /* Find the renumbering of the best correlation sum_k conj(p_k) q_j(k)
+     * (with p_k replaced by conj(p_k) in the case of the reflection, which
+     * reverses the order of the vertices). */
+    for (f = 0U; f < 2U; ++f)
+        for (s = 0U; s < n; ++s)
+        {
+            cx = 0.0;
+            cy = 0.0;
+            for (k = 0U; k < n; ++k)
+            {
+                j = f ? (s + n - k) % n : (s + k) % n;
+                ux = *(P + (k << 1U)) - px;
+                uy = f ?
+                    py - *(P + (k << 1U) + 1U) :
+                    *(P + (k << 1U) + 1U) - py;
+                vx = *(Q + (j << 1U)) - qx;
+                vy = *(Q + (j << 1U) + 1U) - qy;
+                cx += ux * vx + uy * vy;
+                cy += ux * vy - uy * vx;
+            }
+            if (cx * cx + cy * cy > best)
+            {
+                best = cx * cx + cy * cy;
+                ax = cx / norm;
+                ay = cy / norm;
+                shift = s;
+                reflect = f ? true : false;
+            }
+        }
+
+    /* Map the vertices of Q back by the inverse of the best similarity:
+     * p = (q - b) / a (conjugated in the case of the reflection). */
+    a2 = ax * ax + ay * ay;
+    for (k = 0U; k < n; ++k)
+    {
+        j = reflect ? (shift + n - k) % n : (shift + k) % n;
+        vx = *(Q + (j << 1U)) - qx;
+        vy = *(Q + (j << 1U) + 1U) - qy;
+        ux = (vx * ax + vy * ay) / a2;
+        uy = (vy * ax - vx * ay) / a2;
+        *(R + (k << 1U)) = px + ux;
+        *(R + (k << 1U) + 1U) = reflect ? py - uy : py + uy;
+    }
+
+    /* Return the scale. */
+    return rsqrt(a2);
+}
+
+/**
+ * Predict the first eigenvalue of a perturbed polygon.
+ *
+ * @param n
+ *     Number of vertices.
+ *
+ * @param P
+ *     Array of vertices of the base polygon of size at least 2 * `n`
+ *     organised as in the `describe_polygon` function.
+ *
+ * @param ev
+ *     First eigenvalue of the base polygon.
+ *
+ * @param G
+ *     Gradient of the first eigenvalue of the base polygon computed by the
+ *     function `hadamard_gradient`.
+ *
+ * @param Q
+ *     Array of vertices of the perturbed polygon of size at least 2 * `n`
+ *     organised as the array `P` (possibly translated, rotated, reflected,
+ *     scaled and with the vertices renumbered).
+ *
+ * @param R
+ *     Workspace of size at least 2 * `n`.
+ *
+ * @param err
+ *     Memory location to store the estimate of the absolute error of the
+ *     prediction (the second-order term).
+ *
+ * @return
+ *     Predicted first eigenvalue of the polygon Q, or the undefined real number
+ *     if the base polygon is degenerate.
+ *
+ * @see hadamard_gradient
+ * @see hadamard_align
+ *
+ */
+#if !defined(__cplusplus)
+real_t hadamard_predict (
+    size_t n,
+    const real_t* P,
+    real_t ev,
+    const real_t* G,
+    const real_t* Q,
+    real_t* R,
+    real_t* err
+)
+#else
+inline real_t hadamard_predict (
+    ::size_t n,
+    const real_t* P,
+    real_t ev,
+    const real_t* G,
+    const real_t* Q,
+    real_t* R,
+    real_t* err
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Scale of the polygon Q relative to the polygon P. */
+    real_t scale;
+
+    /* Displacement of a vertex. */
+    real_t dx;
+    real_t dy;
+
+    /* First-order change of the eigenvalue and the sum of the absolute
+     * contributions of the vertices. */
+    real_t d;
+    real_t a;
+
+    /* Iteration index. */
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Scale of the polygon Q relative to the polygon P. */
+    scale = 0.0;
+
+    /* Displacement of a vertex. */
+    dx = 0.0;
+    dy = 0.0;
+
+    /* First-order change of the eigenvalue and the sum of the absolute
+     * contributions of the vertices. */
+    d = 0.0;
+    a = 0.0;
+
+    /* Iteration index. */
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Align the polygon Q to the polygon P.  If the base polygon is
+     * degenerate, return the undefined real number. */
+    *err = lambda;
+    scale = hadamard_align(n, P, Q, R);
+    if (!(0.0 < scale && 0.0 < ev))
+        return lambda;
+
+    /* Compute the first-order change of the eigenvalue. */
+    for (k = 0U; k < n; ++k)
+    {
+        dx = *(R + (k << 1U)) - *(P + (k << 1U));
+        dy = *(R + (k << 1U) + 1U) - *(P + (k << 1U) + 1U);
+        d += *(G + (k << 1U)) * dx + *(G + (k << 1U) + 1U) * dy;
+        a +=
+            rsqrt(
+                *(G + (k << 1U)) * *(G + (k << 1U)) +
+                *(G + (k << 1U) + 1U) * *(G + (k << 1U) + 1U)
+            ) *
+            rsqrt(dx * dx + dy * dy);
+    }
+
+    /* Estimate the error and return the prediction (both scaled to the size
+     * of the polygon Q). */
+    *err = 0.75 * a * a / ev / (scale * scale);
+
+    return (ev + d) / (scale * scale);
+}
+
+#endif /* __HADAMARD_H__INCLUDED */
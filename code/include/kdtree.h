@@ -0,0 +1,1253 @@
+/**
+ * KD-trees of points in feature spaces stored as files mapped to memory.
+ *
+ * A KD-tree is built once from the rows of a feature table (such as the
+ * singular values, the sorted descriptions or the characteristic points of
+ * the datasets in "data/numerical") and answers queries of the k nearest
+ * neighbours of a point (optionally within a radius) and of the number of
+ * points within a radius, in the Euclidean distance.  The tree is implicit:
+ * the points are permuted so that the point of a node of the range [l, u) of
+ * points is the median point m = (l + u) / 2 along the dimension of the
+ * largest spread of the range, its left subtree is the range [l, m) and its
+ * right subtree is the range [m + 1, u).  Ranges of at most `KDTREE_LEAF`
+ * points are leaves searched exhaustively.  Only the permuted points, their
+ * original indices and the dimensions of the nodes are stored, so the tree is
+ * a single block of memory
+ *     header	points	indices	dimensions
+ * which is dumped to a file as it is and mapped to memory from the file
+ * without parsing (see the functions `kdtree_save` and `kdtree_open`).  The
+ * file stores values in the byte order and the sizes of the host that built
+ * it, which are checked when it is opened.
+ *
+ * Batches of queries are answered in threads, each answering a contiguous
+ * part of the batch as in the function `mps_solve_batch` (see "mps.h").
+ *
+ * As "npy.h" is included, the macro `_POSIX_C_SOURCE` must be defined (as at
+ * least 200112L) before any standard header is included.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__KDTREE_H__INCLUDED) && (__KDTREE_H__INCLUDED) == 1)
+
+/* Undefine __KDTREE_H__INCLUDED if it has already been defined. */
+#if defined(__KDTREE_H__INCLUDED)
+#undef __KDTREE_H__INCLUDED
+#endif /* __KDTREE_H__INCLUDED */
+
+/* Define __KDTREE_H__INCLUDED as 1. */
+#define __KDTREE_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import POSIX headers. */
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "npy.h"
+
+/* Define constants. */
+
+/**
+ * Length of the header of a tree in bytes.
+ *
+ */
+#define KDTREE_HEADER_LENGTH 64U
+
+/**
+ * Alignment of the arrays of a tree in bytes.
+ *
+ */
+#define KDTREE_ALIGNMENT 16U
+
+/**
+ * Largest number of points of a leaf.
+ *
+ */
+#define KDTREE_LEAF 8U
+
+/* Define types. */
+
+/**
+ * KD-tree.
+ *
+ */
+typedef struct kdtree_struct
+{
+    /* Block of the header and the arrays (allocated or mapped to memory) and
+     * its size in bytes. */
+    unsigned char* block;
+    size_t length;
+
+    /* Indicator of the block mapped to memory. */
+    bool mapped;
+
+    /* Number of dimensions and the number of points. */
+    size_t d;
+    size_t n;
+
+    /* Points in the order of the tree, their original indices and the
+     * dimensions of the nodes. */
+    const real_t* P;
+    const size_t* I;
+    const unsigned char* D;
+}
+kdtree_t;
+
+/**
+ * State of a query.
+ *
+ */
+typedef struct kdtree_query_struct
+{
+    /* Point of the query. */
+    const real_t* q;
+
+    /* Number of neighbours (0 to count the points within the radius). */
+    size_t k;
+
+    /* Squared radius and the indicator of the radius. */
+    real_t r2;
+    bool bounded;
+
+    /* Number of neighbours found so far, their original indices and their
+     * squared distances (sorted ascendingly). */
+    size_t count;
+    size_t* I;
+    real_t* D2;
+}
+kdtree_query_t;
+
+/**
+ * Job of a thread answering a part of a batch of queries.
+ *
+ */
+typedef struct kdtree_job_struct
+{
+    /* Tree. */
+    const kdtree_t* T;
+
+    /* Number of queries and their points. */
+    size_t n;
+    const real_t* Q;
+
+    /* Number of neighbours and the radius. */
+    size_t k;
+    real_t r;
+
+    /* Numbers of neighbours found, their indices and their distances. */
+    size_t* C;
+    size_t* I;
+    real_t* D;
+}
+kdtree_job_t;
+
+/* Define functions. */
+
+/**
+ * Compute the offsets of the arrays of a tree.
+ *
+ * @param d
+ *     Number of dimensions.
+ *
+ * @param n
+ *     Number of points.
+ *
+ * @param I
+ *     Pointer to store the offset of the indices in bytes.
+ *
+ * @param D
+ *     Pointer to store the offset of the dimensions in bytes.
+ *
+ * @return
+ *     Size of the block in bytes.
+ *
+ */
+#if !defined(__cplusplus)
+size_t kdtree_offsets (size_t d, size_t n, size_t* I, size_t* D)
+#else
+inline ::size_t kdtree_offsets (
+    ::size_t d,
+    ::size_t n,
+    ::size_t* I,
+    ::size_t* D
+)
+#endif /* __cplusplus */
+{
+    /* Offsets of the arrays. */
+    *I = KDTREE_HEADER_LENGTH + n * d * sizeof(real_t);
+    *I += (KDTREE_ALIGNMENT - *I % KDTREE_ALIGNMENT) % KDTREE_ALIGNMENT;
+    *D = *I + n * sizeof(size_t);
+
+    /* Return the size of the block. */
+    return *D + n;
+}
+
+/**
+ * Write a number to 8 bytes in the little-endian byte order.
+ *
+ * @param b
+ *     Array of at least 8 bytes.
+ *
+ * @param x
+ *     Number.
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_put (unsigned char* b, size_t x)
+#else
+inline void kdtree_put (unsigned char* b, ::size_t x)
+#endif /* __cplusplus */
+{
+    /* Iteration index. */
+    size_t i;
+
+    /* Write the bytes. */
+    for (i = 0U; i < 8U; ++i, x >>= 8U)
+        *(b + i) = (unsigned char)(x & 0xFFU);
+}
+
+/**
+ * Read a number from 8 bytes in the little-endian byte order.
+ *
+ * @param b
+ *     Array of at least 8 bytes.
+ *
+ * @return
+ *     Number.
+ *
+ */
+#if !defined(__cplusplus)
+size_t kdtree_get (const unsigned char* b)
+#else
+inline ::size_t kdtree_get (const unsigned char* b)
+#endif /* __cplusplus */
+{
+    /* Number. */
+    size_t x;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* Read the bytes. */
+    for (x = 0U, i = 8U; i--; )
+        x = (x << 8U) | (size_t)(*(b + i));
+
+    return x;
+}
+
+/**
+ * Set the pointers of a tree to the arrays of its block.
+ *
+ * @param T
+ *     Pointer to the tree whose block, number of dimensions and number of
+ *     points are set.
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_attach (kdtree_t* T)
+#else
+inline void kdtree_attach (kdtree_t* T)
+#endif /* __cplusplus */
+{
+    /* Offsets of the arrays. */
+    size_t I;
+    size_t D;
+
+    /* Compute the offsets and set the pointers. */
+    I = 0U;
+    D = 0U;
+    kdtree_offsets(T->d, T->n, &I, &D);
+#if !defined(__cplusplus)
+    T->P = (const real_t*)(T->block + KDTREE_HEADER_LENGTH);
+    T->I = (const size_t*)(T->block + I);
+#else
+    T->P = reinterpret_cast<const real_t*>(T->block + KDTREE_HEADER_LENGTH);
+    T->I = reinterpret_cast<const ::size_t*>(T->block + I);
+#endif /* __cplusplus */
+    T->D = T->block + D;
+}
+
+/**
+ * Select the median of a range of points along a dimension.
+ *
+ * The indices of the points in the range are partitioned (by the quickselect
+ * algorithm with the three-way partitioning) so that the point at the index
+ * `m` is the one which would be there if the range were sorted along the
+ * dimension, the points before it are not greater and the points after it are
+ * not less than it along the dimension.
+ *
+ * @param d
+ *     Number of dimensions.
+ *
+ * @param X
+ *     Array of the points (`d` values per point).
+ *
+ * @param c
+ *     Dimension.
+ *
+ * @param J
+ *     Array of the indices of the points.
+ *
+ * @param l
+ *     The first index of the range.
+ *
+ * @param u
+ *     The index after the last index of the range.
+ *
+ * @param m
+ *     Index to select (l <= m < u).
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_select (
+    size_t d,
+    const real_t* X,
+    size_t c,
+    size_t* J,
+    size_t l,
+    size_t u,
+    size_t m
+)
+#else
+inline void kdtree_select (
+    ::size_t d,
+    const real_t* X,
+    ::size_t c,
+    ::size_t* J,
+    ::size_t l,
+    ::size_t u,
+    ::size_t m
+)
+#endif /* __cplusplus */
+{
+    /* Pivot and the value of a point. */
+    real_t p;
+    real_t v;
+
+    /* Bounds of the points less than and greater than the pivot, the current
+     * index and an index to swap. */
+    size_t lt;
+    size_t gt;
+    size_t i;
+    size_t s;
+
+    /* Initialise the values and the indices. */
+    p = 0.0;
+    v = 0.0;
+    lt = 0U;
+    gt = 0U;
+    i = 0U;
+    s = 0U;
+
+    /* Partition the range around the middle point until the index `m` is in
+     * the part equal to the pivot. */
+    while (u - l > 1U)
+    {
+        p = *(X + *(J + l + ((u - l) >> 1U)) * d + c);
+        for (lt = l, i = l, gt = u; i < gt; )
+        {
+            v = *(X + *(J + i) * d + c);
+            if (v < p)
+            {
+                s = *(J + lt);
+                *(J + lt++) = *(J + i);
+                *(J + i++) = s;
+            }
+            else if (v > p)
+            {
+                s = *(J + --gt);
+                *(J + gt) = *(J + i);
+                *(J + i) = s;
+            }
+            else
+                ++i;
+        }
+        if (m < lt)
+            u = lt;
+        else if (m >= gt)
+            l = gt;
+        else
+            break;
+    }
+}
+
+/**
+ * Build the subtree of a range of points.
+ *
+ * @param d
+ *     Number of dimensions.
+ *
+ * @param X
+ *     Array of the points (`d` values per point).
+ *
+ * @param J
+ *     Array of the indices of the points (permuted to the order of the tree).
+ *
+ * @param D
+ *     Array of the dimensions of the nodes.
+ *
+ * @param l
+ *     The first index of the range.
+ *
+ * @param u
+ *     The index after the last index of the range.
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_divide (
+    size_t d,
+    const real_t* X,
+    size_t* J,
+    unsigned char* D,
+    size_t l,
+    size_t u
+)
+#else
+inline void kdtree_divide (
+    ::size_t d,
+    const real_t* X,
+    ::size_t* J,
+    unsigned char* D,
+    ::size_t l,
+    ::size_t u
+)
+#endif /* __cplusplus */
+{
+    /* Index of the node and the dimension of the largest spread. */
+    size_t m;
+    size_t c;
+
+    /* Spread of the current and of the largest spread, and the bounds of the
+     * range along the current dimension. */
+    real_t s;
+    real_t s_max;
+    real_t lo;
+    real_t hi;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* Initialise the variables. */
+    m = 0U;
+    c = 0U;
+    s = 0.0;
+    s_max = -1.0;
+    lo = 0.0;
+    hi = 0.0;
+    i = 0U;
+    j = 0U;
+
+    /* Divide the ranges which are not leaves. */
+    while (u - l > KDTREE_LEAF)
+    {
+        /* Find the dimension of the largest spread. */
+        for (s_max = -1.0, j = 0U; j < d; ++j)
+        {
+            lo = hi = *(X + *(J + l) * d + j);
+            for (i = l + 1U; i < u; ++i)
+            {
+                s = *(X + *(J + i) * d + j);
+                if (s < lo)
+                    lo = s;
+                else if (s > hi)
+                    hi = s;
+            }
+            if (hi - lo > s_max)
+            {
+                s_max = hi - lo;
+                c = j;
+            }
+        }
+
+        /* Select the median, divide the left range recursively and the right
+         * range in the loop. */
+        m = l + ((u - l) >> 1U);
+        kdtree_select(d, X, c, J, l, u, m);
+        *(D + m) = (unsigned char)c;
+        kdtree_divide(d, X, J, D, l, m);
+        l = m + 1U;
+    }
+}
+
+/**
+ * Close a tree.
+ *
+ * @param T
+ *     Pointer to the tree built by the function `kdtree_build` or opened by
+ *     the function `kdtree_open`.
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_close (kdtree_t* T)
+#else
+inline void kdtree_close (kdtree_t* T)
+#endif /* __cplusplus */
+{
+    /* If the pointer `T` is a null-pointer, there is nothing to close. */
+    if (!T)
+        return;
+
+    /* Unmap or deallocate the block. */
+    if (T->block)
+    {
+        if (T->mapped)
+            munmap((void*)(T->block), T->length);
+        else
+            free(T->block);
+    }
+
+    /* Reset the tree. */
+    memset(T, 0, sizeof *T);
+    T->block = (unsigned char*)(NULL);
+    T->P = (const real_t*)(NULL);
+    T->I = (const size_t*)(NULL);
+    T->D = (const unsigned char*)(NULL);
+}
+
+/**
+ * Build a tree.
+ *
+ * @param T
+ *     Pointer to the tree to build.
+ *
+ * @param d
+ *     Number of dimensions (at least 1 and at most 255).
+ *
+ * @param n
+ *     Number of points (at least 1).
+ *
+ * @param X
+ *     Array of the points of size at least `n` `d` (`d` values per point).
+ *     The index of a point is its index in the array.
+ *
+ * @return
+ *     Value 0 if the tree was built successfully; a non-zero value otherwise
+ *     (in which case nothing remains allocated).
+ *
+ * @see kdtree_close
+ *
+ */
+#if !defined(__cplusplus)
+int kdtree_build (kdtree_t* T, size_t d, size_t n, const real_t* X)
+#else
+inline int kdtree_build (kdtree_t* T, ::size_t d, ::size_t n, const real_t* X)
+#endif /* __cplusplus */
+{
+    /* Offsets of the arrays. */
+    size_t o_I;
+    size_t o_D;
+
+    /* Indices of the points in the order of the tree. */
+    size_t* J;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* Initialise the variables. */
+    o_I = 0U;
+    o_D = 0U;
+    J = (size_t*)(NULL);
+    i = 0U;
+
+    /* If any of the pointers is a null-pointer or if the numbers are illegal,
+     * return a non-zero value. */
+    if (!(T && X && d && d < 256U && n))
+        return 1;
+
+    /* Initialise the tree and allocate memory for the block. */
+    memset(T, 0, sizeof *T);
+    T->d = d;
+    T->n = n;
+    T->length = kdtree_offsets(d, n, &o_I, &o_D);
+    T->mapped = false;
+#if !defined(__cplusplus)
+    T->block = (unsigned char*)malloc(T->length);
+#else
+    T->block = static_cast<unsigned char*>(::malloc(T->length));
+#endif /* __cplusplus */
+    if (!T->block)
+    {
+        kdtree_close(T);
+
+        return 1;
+    }
+    memset(T->block, 0, T->length);
+
+    /* Write the header:  the magic string, the version, the sizes of the
+     * values and of the indices, the byte order, the number of dimensions and
+     * the number of points. */
+    memcpy(T->block, "\x93KDT", 4U);
+    *(T->block + 4U) = 1U;
+    *(T->block + 5U) = (unsigned char)sizeof(real_t);
+    *(T->block + 6U) = (unsigned char)sizeof(size_t);
+    *(T->block + 7U) = npy_little_endian() ? 1U : 0U;
+    kdtree_put(T->block + 8U, d);
+    kdtree_put(T->block + 16U, n);
+
+    /* Build the tree in the array of indices and copy the points in its
+     * order. */
+#if !defined(__cplusplus)
+    J = (size_t*)(T->block + o_I);
+#else
+    J = reinterpret_cast< ::size_t*>(T->block + o_I);
+#endif /* __cplusplus */
+    for (i = 0U; i < n; ++i)
+        *(J + i) = i;
+    kdtree_divide(d, X, J, T->block + o_D, 0U, n);
+    for (i = 0U; i < n; ++i)
+        memcpy(
+            T->block + KDTREE_HEADER_LENGTH + i * d * sizeof(real_t),
+            X + *(J + i) * d,
+            d * sizeof(real_t)
+        );
+    kdtree_attach(T);
+
+    /* Return 0. */
+    return 0;
+}
+
+/**
+ * Save a tree to a file.
+ *
+ * @param T
+ *     Pointer to the tree.
+ *
+ * @param path
+ *     Path to the file.
+ *
+ * @return
+ *     Value 0 if the tree was saved successfully; a non-zero value otherwise.
+ *
+ * @see kdtree_open
+ *
+ */
+#if !defined(__cplusplus)
+int kdtree_save (const kdtree_t* T, const char* path)
+#else
+inline int kdtree_save (const kdtree_t* T, const char* path)
+#endif /* __cplusplus */
+{
+    /* File. */
+    FILE* out;
+
+    /* Value to return. */
+    int ret;
+
+    /* If any of the pointers is a null-pointer, return a non-zero value. */
+    if (!(T && T->block && path))
+        return 1;
+
+    /* Dump the block. */
+    out = fopen(path, "wb");
+    if (!out)
+        return 1;
+    ret = (fwrite(T->block, 1U, T->length, out) == T->length) ? 0 : 1;
+    if (fclose(out))
+        ret = 1;
+
+    return ret;
+}
+
+/**
+ * Open a tree saved to a file by mapping the file to memory.
+ *
+ * @param T
+ *     Pointer to the tree to open.
+ *
+ * @param path
+ *     Path to the file.
+ *
+ * @return
+ *     Value 0 if the tree was opened successfully; a non-zero value otherwise
+ *     (in which case nothing remains mapped).  The file must be saved by the
+ *     function `kdtree_save` on a host of the same byte order and of the same
+ *     sizes of values and indices.
+ *
+ * @see kdtree_save
+ * @see kdtree_close
+ *
+ */
+#if !defined(__cplusplus)
+int kdtree_open (kdtree_t* T, const char* path)
+#else
+inline int kdtree_open (kdtree_t* T, const char* path)
+#endif /* __cplusplus */
+{
+    /* File descriptor. */
+    int fd;
+
+    /* Information about the file. */
+    struct stat info;
+
+    /* Mapped block. */
+    void* map;
+
+    /* Offsets of the arrays. */
+    size_t o_I;
+    size_t o_D;
+
+    /* Initialise the variables. */
+    fd = -1;
+    memset(&info, 0, sizeof info);
+    map = NULL;
+    o_I = 0U;
+    o_D = 0U;
+
+    /* If any of the pointers is a null-pointer, return a non-zero value. */
+    if (!(T && path))
+        return 1;
+
+    /* Initialise the tree. */
+    memset(T, 0, sizeof *T);
+
+    /* Open the file and map it to memory (the mapping remains valid after the
+     * file descriptor is closed). */
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 1;
+    if (fstat(fd, &info) || info.st_size < (off_t)(KDTREE_HEADER_LENGTH))
+    {
+        close(fd);
+
+        return 1;
+    }
+    map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return 1;
+#if !defined(__cplusplus)
+    T->block = (unsigned char*)map;
+#else
+    T->block = static_cast<unsigned char*>(map);
+#endif /* __cplusplus */
+    T->length = (size_t)info.st_size;
+    T->mapped = true;
+
+    /* Check the header and the size of the file. */
+    T->d = kdtree_get(T->block + 8U);
+    T->n = kdtree_get(T->block + 16U);
+    if (
+        memcmp(T->block, "\x93KDT", 4U) ||
+        !(*(T->block + 4U) == 1U) ||
+        !(*(T->block + 5U) == sizeof(real_t)) ||
+        !(*(T->block + 6U) == sizeof(size_t)) ||
+        !(*(T->block + 7U) == (npy_little_endian() ? 1U : 0U)) ||
+        !(T->d && T->d < 256U && T->n) ||
+        !(kdtree_offsets(T->d, T->n, &o_I, &o_D) == T->length)
+    )
+    {
+        kdtree_close(T);
+
+        return 1;
+    }
+    kdtree_attach(T);
+
+    /* Return 0. */
+    return 0;
+}
+
+/**
+ * Offer a point to a query.
+ *
+ * @param S
+ *     Pointer to the state of the query.
+ *
+ * @param i
+ *     Original index of the point.
+ *
+ * @param d2
+ *     Squared distance of the point to the point of the query.
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_offer (kdtree_query_t* S, size_t i, real_t d2)
+#else
+inline void kdtree_offer (kdtree_query_t* S, ::size_t i, real_t d2)
+#endif /* __cplusplus */
+{
+    /* Position of the point. */
+    size_t j;
+
+    /* Ignore the points outside the radius. */
+    if (S->bounded && d2 > S->r2)
+        return;
+
+    /* Count the points within the radius. */
+    if (!S->k)
+    {
+        ++S->count;
+
+        return;
+    }
+
+    /* Insert the point into the sorted neighbours if it is nearer than the
+     * farthest of them. */
+    if (S->count == S->k && !(d2 < *(S->D2 + S->k - 1U)))
+        return;
+    if (S->count < S->k)
+        ++S->count;
+    for (j = S->count - 1U; j && *(S->D2 + j - 1U) > d2; --j)
+    {
+        *(S->D2 + j) = *(S->D2 + j - 1U);
+        *(S->I + j) = *(S->I + j - 1U);
+    }
+    *(S->D2 + j) = d2;
+    *(S->I + j) = i;
+}
+
+/**
+ * Search the subtree of a range of points.
+ *
+ * @param T
+ *     Pointer to the tree.
+ *
+ * @param S
+ *     Pointer to the state of the query.
+ *
+ * @param l
+ *     The first index of the range.
+ *
+ * @param u
+ *     The index after the last index of the range.
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_visit (const kdtree_t* T, kdtree_query_t* S, size_t l, size_t u)
+#else
+inline void kdtree_visit (
+    const kdtree_t* T,
+    kdtree_query_t* S,
+    ::size_t l,
+    ::size_t u
+)
+#endif /* __cplusplus */
+{
+    /* Index of the node, its dimension and the difference of the query from
+     * the node along the dimension. */
+    size_t m;
+    size_t c;
+    real_t delta;
+
+    /* Squared distance. */
+    real_t d2;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* Initialise the variables. */
+    m = 0U;
+    c = 0U;
+    delta = 0.0;
+    d2 = 0.0;
+    i = 0U;
+    j = 0U;
+
+    /* Search the nodes, descending to the side of the query in the loop and
+     * to the other side recursively if it may contain nearer points. */
+    while (u - l > KDTREE_LEAF)
+    {
+        m = l + ((u - l) >> 1U);
+        c = (size_t)(*(T->D + m));
+        delta = *(S->q + c) - *(T->P + m * T->d + c);
+        for (d2 = 0.0, j = 0U; j < T->d; ++j)
+            d2 +=
+                (*(S->q + j) - *(T->P + m * T->d + j)) *
+                (*(S->q + j) - *(T->P + m * T->d + j));
+        kdtree_offer(S, *(T->I + m), d2);
+        if (delta < 0.0)
+        {
+            kdtree_visit(T, S, l, m);
+            if (
+                (S->bounded && delta * delta > S->r2) ||
+                (S->k && S->count == S->k &&
+                    !(delta * delta < *(S->D2 + S->k - 1U)))
+            )
+                return;
+            l = m + 1U;
+        }
+        else
+        {
+            kdtree_visit(T, S, m + 1U, u);
+            if (
+                (S->bounded && delta * delta > S->r2) ||
+                (S->k && S->count == S->k &&
+                    !(delta * delta < *(S->D2 + S->k - 1U)))
+            )
+                return;
+            u = m;
+        }
+    }
+
+    /* Search the leaf exhaustively. */
+    for (i = l; i < u; ++i)
+    {
+        for (d2 = 0.0, j = 0U; j < T->d; ++j)
+            d2 +=
+                (*(S->q + j) - *(T->P + i * T->d + j)) *
+                (*(S->q + j) - *(T->P + i * T->d + j));
+        kdtree_offer(S, *(T->I + i), d2);
+    }
+}
+
+/**
+ * Find the nearest neighbours of a point.
+ *
+ * @param T
+ *     Pointer to the tree.
+ *
+ * @param q
+ *     Array of the `T->d` coordinates of the point.
+ *
+ * @param k
+ *     Number of neighbours to find.  If 0, the points within the radius are
+ *     counted instead.
+ *
+ * @param r
+ *     Radius.  Only points of distance at most `r` from the point are found
+ *     (or counted).  If negative, the radius is unbounded.
+ *
+ * @param I
+ *     Array of size at least `k` to store the original indices of the
+ *     neighbours, from the nearest to the farthest.
+ *
+ * @param D
+ *     Array of size at least `k` to store the distances of the neighbours.
+ *
+ * @return
+ *     Number of neighbours found (at most `k`), or the number of points
+ *     within the radius if `k` is 0.
+ *
+ */
+#if !defined(__cplusplus)
+size_t kdtree_search (
+    const kdtree_t* T,
+    const real_t* q,
+    size_t k,
+    real_t r,
+    size_t* I,
+    real_t* D
+)
+#else
+inline ::size_t kdtree_search (
+    const kdtree_t* T,
+    const real_t* q,
+    ::size_t k,
+    real_t r,
+    ::size_t* I,
+    real_t* D
+)
+#endif /* __cplusplus */
+{
+    /* State of the query. */
+    kdtree_query_t S;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* Initialise the state and the iteration index. */
+    memset(&S, 0, sizeof S);
+    S.q = q;
+    S.k = k;
+    S.bounded = !(r < 0.0);
+    S.r2 = S.bounded ? r * r : 0.0;
+    S.count = 0U;
+    S.I = I;
+    S.D2 = D;
+    i = 0U;
+
+    /* If any of the pointers is a null-pointer, nothing is found. */
+    if (!(T && T->block && q && (!k || (I && D))))
+        return 0U;
+
+    /* Search the tree and compute the distances. */
+    kdtree_visit(T, &S, 0U, T->n);
+    for (i = 0U; i < S.count && k; ++i)
+        *(D + i) = rsqrt(*(D + i));
+
+    /* Return the number of neighbours found. */
+    return S.count;
+}
+
+/**
+ * Answer a part of a batch of queries.
+ *
+ * The function is the starting routine of the threads of the function
+ * `kdtree_batch`.
+ *
+ * @param job
+ *     Pointer to the job (of the type `kdtree_job_t`).
+ *
+ * @return
+ *     The null-pointer.
+ *
+ * @see kdtree_batch
+ *
+ */
+#if !defined(__cplusplus)
+void* kdtree_job (void* job)
+#else
+extern "C" inline void* kdtree_job (void* job)
+#endif /* __cplusplus */
+{
+    /* Job. */
+    kdtree_job_t* J;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* Initialise the job and the iteration index. */
+#if !defined(__cplusplus)
+    J = (kdtree_job_t*)job;
+#else
+    J = static_cast<kdtree_job_t*>(job);
+#endif /* __cplusplus */
+    i = 0U;
+
+    /* If there is no job, return the null-pointer. */
+    if (!J)
+        return NULL;
+
+    /* Answer the queries. */
+    for (i = 0U; i < J->n; ++i)
+        *(J->C + i) =
+            kdtree_search(
+                J->T,
+                J->Q + i * J->T->d,
+                J->k,
+                J->r,
+                J->I + i * J->k,
+                J->D + i * J->k
+            );
+
+    return NULL;
+}
+
+/**
+ * Answer a batch of queries in threads.
+ *
+ * @param T
+ *     Pointer to the tree.
+ *
+ * @param n
+ *     Number of queries.
+ *
+ * @param Q
+ *     Array of the points of the queries of size at least `n` `T->d`.
+ *
+ * @param k
+ *     Number of neighbours of each query (0 to count the points within the
+ *     radius).
+ *
+ * @param r
+ *     Radius (negative if unbounded).
+ *
+ * @param C
+ *     Array of size at least `n` to store the numbers returned by the function
+ *     `kdtree_search` for the queries.
+ *
+ * @param I
+ *     Array of size at least `n` `k` to store the original indices of the
+ *     neighbours of the queries (`k` per query).
+ *
+ * @param D
+ *     Array of size at least `n` `k` to store the distances of the neighbours
+ *     of the queries (`k` per query).
+ *
+ * @param threads
+ *     Number of threads.
+ *
+ * @see kdtree_search
+ *
+ */
+#if !defined(__cplusplus)
+void kdtree_batch (
+    const kdtree_t* T,
+    size_t n,
+    const real_t* Q,
+    size_t k,
+    real_t r,
+    size_t* C,
+    size_t* I,
+    real_t* D,
+    size_t threads
+)
+#else
+inline void kdtree_batch (
+    const kdtree_t* T,
+    ::size_t n,
+    const real_t* Q,
+    ::size_t k,
+    real_t r,
+    ::size_t* C,
+    ::size_t* I,
+    real_t* D,
+    ::size_t threads
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Single job (if the memory allocation fails). */
+    kdtree_job_t single;
+
+    /* Array of jobs. */
+    kdtree_job_t* jobs;
+
+    /* Array of threads. */
+    pthread_t* ids;
+
+    /* Array of indicators of successfully created threads. */
+    bool* created;
+
+    /* Number of queries in the jobs so far. */
+    size_t done;
+
+    /* Iteration index. */
+    size_t t;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Single job. */
+    memset(&single, 0, sizeof single);
+
+    /* Array of jobs. */
+    jobs = (kdtree_job_t*)(NULL);
+
+    /* Array of threads. */
+    ids = (pthread_t*)(NULL);
+
+    /* Array of indicators of successfully created threads. */
+    created = (bool*)(NULL);
+
+    /* Number of queries in the jobs so far. */
+    done = 0U;
+
+    /* Iteration index. */
+    t = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer or if there are no queries,
+     * there is nothing to answer. */
+    if (!(T && T->block && Q && C && (!k || (I && D)) && n))
+        return;
+
+    /* Use at least 1 and at most `n` threads. */
+    if (threads > n)
+        threads = n;
+    if (!threads)
+        threads = 1U;
+
+    /* Allocate memory for the jobs, the threads and the indicators. */
+#if !defined(__cplusplus)
+    jobs = (kdtree_job_t*)malloc(threads * sizeof *jobs);
+    ids = (pthread_t*)malloc(threads * sizeof *ids);
+    created = (bool*)malloc(threads * sizeof *created);
+#else
+    jobs = static_cast<kdtree_job_t*>(::malloc(threads * sizeof *jobs));
+    ids = static_cast<pthread_t*>(::malloc(threads * sizeof *ids));
+    created = static_cast<bool*>(::malloc(threads * sizeof *created));
+#endif /* __cplusplus */
+
+    /* If the memory allocation has failed, deallocate memory and answer all
+     * queries in the calling thread. */
+    if (!(jobs && ids && created))
+    {
+        /* Deallocate memory for the jobs, the threads and the indicators. */
+        free(jobs);
+        jobs = (kdtree_job_t*)(NULL);
+        free(ids);
+        ids = (pthread_t*)(NULL);
+        free(created);
+        created = (bool*)(NULL);
+
+        /* Answer the queries. */
+        single.T = T;
+        single.n = n;
+        single.Q = Q;
+        single.k = k;
+        single.r = r;
+        single.C = C;
+        single.I = I;
+        single.D = D;
+        kdtree_job((void*)(&single));
+
+        return;
+    }
+
+    /* Initialise the jobs. */
+    for (t = 0U; t < threads; ++t)
+    {
+        (jobs + t)->T = T;
+        (jobs + t)->n = n / threads + (t < n % threads);
+        (jobs + t)->Q = Q + done * T->d;
+        (jobs + t)->k = k;
+        (jobs + t)->r = r;
+        (jobs + t)->C = C + done;
+        (jobs + t)->I = I + done * k;
+        (jobs + t)->D = D + done * k;
+        *(created + t) = false;
+
+        done += (jobs + t)->n;
+    }
+
+    /* Start the threads for all jobs but the first one. */
+    for (t = 1U; t < threads; ++t)
+        *(created + t) =
+            !pthread_create(ids + t, NULL, kdtree_job, (void*)(jobs + t));
+
+    /* Do the first job and the jobs whose threads could not be created in the
+     * calling thread. */
+    for (t = 0U; t < threads; ++t)
+        if (!*(created + t))
+            kdtree_job((void*)(jobs + t));
+
+    /* Wait for the threads to finish. */
+    for (t = 1U; t < threads; ++t)
+        if (*(created + t))
+            pthread_join(*(ids + t), NULL);
+
+    /* Clear the memory in the array of jobs. */
+    memset(jobs, 0, threads * sizeof *jobs);
+
+    /* Deallocate memory for the jobs, the threads and the indicators. */
+    free(jobs);
+    jobs = (kdtree_job_t*)(NULL);
+    free(ids);
+    ids = (pthread_t*)(NULL);
+    free(created);
+    created = (bool*)(NULL);
+}
+
+#endif /* __KDTREE_H__INCLUDED */
@@ -0,0 +1,613 @@
+/**
+ * Locality-sensitive hashing of polygons for filtering near duplicates.
+ *
+ * Each polygon is mapped to a signature (see the function `lsh_signature`)
+ * invariant to translations, rotations, scaling, reflections and the choice of
+ * the first vertex, so polygons of the same shape have equal signatures and
+ * polygons of nearly the same shape have near signatures.  Two polygons are
+ * near duplicates if the Euclidean distance of their signatures is at most a
+ * tolerance `tol`.
+ *
+ * The signatures are hashed by K random projections (unit vectors a_j and
+ * offsets b_j) to the cells
+ *     c_j = floor((a_j x + b_j) / w),	j = 1, 2, ..., K,
+ * of the width w = `LSH_WIDTH` tol.  The projections of signatures within the
+ * tolerance differ by at most tol < w / 2, so each of them lies either in the
+ * same cell or in the neighbouring cell on the side of the nearer border of
+ * the cell.  Searching (multi-probing) the cell of the signature and all cells
+ * reached by moving to the neighbouring cells of the projections nearer than
+ * tol to a border of their cells thus finds every stored signature within the
+ * tolerance, while searching only (1 + 2 / `LSH_WIDTH`)^K cells on average.
+ * The candidates from the probed cells are checked by their true distance, so
+ * a larger K only saves the checks of signatures which are near in the
+ * projections but not in the full space.
+ *
+ * The signatures are stored in a hash table of chains of the indices of the
+ * signatures by the hashes of their cells.  The capacity is fixed when the
+ * table is created, as the numbers of polygons to filter are known.
+ *
+ * The function `lsh_signature` calls the function `svd_polygon` (see
+ * "polygon.h"), so the macro `_USE_SVD_DRIVER` must be defined before this
+ * header is included and the program must be linked with LAPACK.  The random
+ * projections are generated by the functions `rrand` and `rrandn` (see
+ * "numeric.h"), so they are reproduced by seeding the function `rand`.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__LSH_H__INCLUDED) && (__LSH_H__INCLUDED) == 1)
+
+/* Undefine __LSH_H__INCLUDED if it has already been defined. */
+#if defined(__LSH_H__INCLUDED)
+#undef __LSH_H__INCLUDED
+#endif /* __LSH_H__INCLUDED */
+
+/* Define __LSH_H__INCLUDED as 1. */
+#define __LSH_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+
+/* Define constants. */
+
+/**
+ * Largest number of projections.
+ *
+ */
+#if defined(LSH_PROJECTIONS)
+#undef LSH_PROJECTIONS
+#endif /* LSH_PROJECTIONS */
+#define LSH_PROJECTIONS 16U
+
+/**
+ * Width of the cells relative to the tolerance (greater than 2).
+ *
+ */
+#if defined(LSH_WIDTH)
+#undef LSH_WIDTH
+#endif /* LSH_WIDTH */
+#define LSH_WIDTH 4.0
+
+/* Define types. */
+
+/**
+ * Hash table of signatures.
+ *
+ */
+typedef struct lsh_struct
+{
+    /* Length of the signatures and the number of projections. */
+    size_t d;
+    size_t K;
+
+    /* Tolerance and the width of the cells. */
+    real_t tol;
+    real_t w;
+
+    /* Projections (`K` unit vectors of length `d`) and their offsets. */
+    real_t* A;
+    real_t* b;
+
+    /* Capacity and the number of stored signatures. */
+    size_t capacity;
+    size_t n;
+
+    /* Stored signatures (`d` values per signature), the hashes of their cells
+     * and the next signatures in their chains. */
+    real_t* X;
+    size_t* H;
+    size_t* next;
+
+    /* First signatures of the chains and the mask of the hashes (the number of
+     * chains less 1). */
+    size_t* heads;
+    size_t mask;
+}
+lsh_t;
+
+/* Define functions. */
+
+/**
+ * Compute the signature of a polygon.
+ *
+ * The signature of a polygon of n vertices consists of 4 n values:  the
+ * lengths of the edges divided by the perimeter and the outer angles divided
+ * by pi (see the function `describe_polygon`), each sorted ascendingly, and
+ * the singular values of the same normalised lengths of the edges and outer
+ * angles (see the function `svd_polygon`), each sorted descendingly.  The
+ * sorted values and the singular values of the unoriented circular matrices
+ * do not depend on the first vertex and on the orientation of the polygon,
+ * while the sorted values only lose the order of the edges and the angles
+ * which the singular values partly retain.  If the singular values could not
+ * be computed, they are set to zeros.
+ *
+ * The polygon must be simple and its vertices must be enumerated positively
+ * (as required by the function `describe_polygon`).
+ *
+ * @param n
+ *     Number of vertices.
+ *
+ * @param P
+ *     Array of the vertices of size at least 2 `n`, organised as in the
+ *     function `describe_polygon`.
+ *
+ * @param W
+ *     Workspace array of size at least 4 `n`.
+ *
+ * @param A
+ *     Workspace array of size at least 2 `n` ld, where ld is `n` rounded up
+ *     to a multiple of 64 (see the function `build_unorient_circ_matrix`).
+ *
+ * @param s
+ *     Array of size at least 4 `n` to store the signature.
+ *
+ * @see describe_polygon
+ * @see svd_polygon
+ *
+ */
+#if !defined(__cplusplus)
+void lsh_signature (size_t n, const real_t* P, real_t* W, real_t* A, real_t* s)
+#else
+inline void lsh_signature (
+    ::size_t n,
+    const real_t* P,
+    real_t* W,
+    real_t* A,
+    real_t* s
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Numerical approximation of the mathematical constant pi. */
+    const real_t pi =
+        3.1415926535897932384626433832795028841971693993751058209749445923;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Arrays of the lengths of edges and of the outer angles. */
+    real_t* l;
+    real_t* phi;
+
+    /* Perimeter. */
+    real_t p;
+
+    /* Information from the SVD driver. */
+    int info;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Arrays of the lengths of edges and of the outer angles. */
+    l = W + (n << 1U);
+    phi = l + n;
+
+    /* Perimeter. */
+    p = 0.0;
+
+    /* Information from the SVD driver. */
+    info = 0;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* Describe the polygon and normalise the lengths of the edges and the
+     * outer angles. */
+    describe_polygon(n, P, W, W + n, l, phi);
+    for (i = 0U; i < n; ++i)
+        p += *(l + i);
+    for (i = 0U; i < n; ++i)
+    {
+        *(l + i) = (p > 0.0) ? *(l + i) / p : 0.0;
+        *(phi + i) /= pi;
+    }
+
+    /* Copy and sort the lengths of the edges and the outer angles. */
+    memcpy(s, l, n * sizeof *s);
+    memcpy(s + n, phi, n * sizeof *s);
+    qsort(s, n, sizeof *s, rcompar);
+    qsort(s + n, n, sizeof *s, rcompar);
+
+    /* Compute and sort the singular values of the lengths of the edges (if
+     * `j` is 0) and of the outer angles (if `j` is 1). */
+    for (j = 0U; j < 2U; ++j)
+    {
+        svd_polygon(n, j ? phi : l, s + ((2U + j) * n), A, &info);
+        if (info)
+            memset(s + ((2U + j) * n), 0, n * sizeof *s);
+        else
+            qsort(s + ((2U + j) * n), n, sizeof *s, ricompar);
+    }
+}
+
+/**
+ * Free the memory of a hash table.
+ *
+ * @param L
+ *     Pointer to the hash table.
+ *
+ */
+#if !defined(__cplusplus)
+void lsh_free (lsh_t* L)
+#else
+inline void lsh_free (lsh_t* L)
+#endif /* __cplusplus */
+{
+    /* If the pointer `L` is a null-pointer, there is nothing to free. */
+    if (!L)
+        return;
+
+    /* Clear the memory in the arrays and deallocate it. */
+    if (L->A)
+        memset(L->A, 0, L->K * L->d * sizeof *L->A);
+    free(L->A);
+    if (L->b)
+        memset(L->b, 0, L->K * sizeof *L->b);
+    free(L->b);
+    if (L->X)
+        memset(L->X, 0, L->capacity * L->d * sizeof *L->X);
+    free(L->X);
+    free(L->H);
+    free(L->next);
+    free(L->heads);
+
+    /* Reset the hash table. */
+    memset(L, 0, sizeof *L);
+    L->A = (real_t*)(NULL);
+    L->b = (real_t*)(NULL);
+    L->X = (real_t*)(NULL);
+    L->H = (size_t*)(NULL);
+    L->next = (size_t*)(NULL);
+    L->heads = (size_t*)(NULL);
+}
+
+/**
+ * Create an empty hash table.
+ *
+ * @param L
+ *     Pointer to the hash table to create.
+ *
+ * @param d
+ *     Length of the signatures (at least 1).
+ *
+ * @param K
+ *     Number of projections (at least 1 and at most `LSH_PROJECTIONS`).
+ *
+ * @param tol
+ *     Tolerance (positive).
+ *
+ * @param capacity
+ *     Largest number of signatures to store (at least 1).
+ *
+ * @return
+ *     Value 0 if the hash table was created successfully; a non-zero value
+ *     otherwise (in which case nothing remains allocated).
+ *
+ * @see lsh_free
+ *
+ */
+#if !defined(__cplusplus)
+int lsh_init (lsh_t* L, size_t d, size_t K, real_t tol, size_t capacity)
+#else
+inline int lsh_init (
+    lsh_t* L,
+    ::size_t d,
+    ::size_t K,
+    real_t tol,
+    ::size_t capacity
+)
+#endif /* __cplusplus */
+{
+    /* Norm of a projection. */
+    real_t norm;
+
+    /* Number of chains. */
+    size_t chains;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* Initialise the variables. */
+    norm = 0.0;
+    chains = 1U;
+    i = 0U;
+    j = 0U;
+
+    /* If the pointer `L` is a null-pointer or if any of the numbers is
+     * illegal, return a non-zero value. */
+    if (!(L && d && K && K <= LSH_PROJECTIONS && tol > 0.0 && capacity))
+        return 1;
+
+    /* Use at least twice as many chains as signatures (a power of 2). */
+    while (chains < (capacity << 1U))
+        chains <<= 1U;
+
+    /* Initialise the hash table and allocate memory for the arrays. */
+    memset(L, 0, sizeof *L);
+    L->d = d;
+    L->K = K;
+    L->tol = tol;
+    L->w = LSH_WIDTH * tol;
+    L->capacity = capacity;
+    L->n = 0U;
+    L->mask = chains - 1U;
+#if !defined(__cplusplus)
+    L->A = (real_t*)malloc(K * d * sizeof *L->A);
+    L->b = (real_t*)malloc(K * sizeof *L->b);
+    L->X = (real_t*)malloc(capacity * d * sizeof *L->X);
+    L->H = (size_t*)malloc(capacity * sizeof *L->H);
+    L->next = (size_t*)malloc(capacity * sizeof *L->next);
+    L->heads = (size_t*)malloc(chains * sizeof *L->heads);
+#else
+    L->A = static_cast<real_t*>(::malloc(K * d * sizeof *L->A));
+    L->b = static_cast<real_t*>(::malloc(K * sizeof *L->b));
+    L->X = static_cast<real_t*>(::malloc(capacity * d * sizeof *L->X));
+    L->H = static_cast< ::size_t*>(::malloc(capacity * sizeof *L->H));
+    L->next = static_cast< ::size_t*>(::malloc(capacity * sizeof *L->next));
+    L->heads = static_cast< ::size_t*>(::malloc(chains * sizeof *L->heads));
+#endif /* __cplusplus */
+    if (!(L->A && L->b && L->X && L->H && L->next && L->heads))
+    {
+        lsh_free(L);
+
+        return 1;
+    }
+    memset(L->X, 0, capacity * d * sizeof *L->X);
+    memset(L->H, 0, capacity * sizeof *L->H);
+    memset(L->next, 0, capacity * sizeof *L->next);
+
+    /* Mark all chains empty (by the index `capacity`). */
+    for (i = 0U; i < chains; ++i)
+        *(L->heads + i) = capacity;
+
+    /* Generate the projections as normalised standard normal vectors and the
+     * offsets uniformly from [0, w). */
+    for (j = 0U; j < K; ++j)
+    {
+        do
+        {
+            for (norm = 0.0, i = 0U; i < d; ++i)
+            {
+                *(L->A + j * d + i) = rrandn();
+                norm += *(L->A + j * d + i) * *(L->A + j * d + i);
+            }
+        }
+        while (!(norm > 0.0));
+        for (norm = rsqrt(norm), i = 0U; i < d; ++i)
+            *(L->A + j * d + i) /= norm;
+        *(L->b + j) = L->w * rrand();
+    }
+
+    /* Return 0. */
+    return 0;
+}
+
+/**
+ * Hash the cells of a signature.
+ *
+ * @param K
+ *     Number of projections.
+ *
+ * @param c
+ *     Array of the `K` cells (integral values).
+ *
+ * @return
+ *     Hash of the cells.
+ *
+ */
+#if !defined(__cplusplus)
+size_t lsh_hash (size_t K, const real_t* c)
+#else
+inline ::size_t lsh_hash (::size_t K, const real_t* c)
+#endif /* __cplusplus */
+{
+    /* Hash. */
+    size_t h;
+
+    /* Iteration index. */
+    size_t j;
+
+    /* Combine the cells (as two's complement integers) into the hash. */
+    for (h = 0U, j = 0U; j < K; ++j)
+        h ^=
+            (size_t)((long)(*(c + j))) + 0x9E3779B9U + (h << 6U) + (h >> 2U);
+
+    return h;
+}
+
+/**
+ * Find a stored signature within the tolerance of a signature.
+ *
+ * @param L
+ *     Pointer to the hash table.
+ *
+ * @param x
+ *     Array of the `L->d` values of the signature.
+ *
+ * @param h
+ *     Pointer to store the hash of the cells of the signature (if not a
+ *     null-pointer).
+ *
+ * @return
+ *     Index of the first stored signature found within the tolerance, or
+ *     `L->n` if there is none.
+ *
+ */
+#if !defined(__cplusplus)
+size_t lsh_find (const lsh_t* L, const real_t* x, size_t* h)
+#else
+inline ::size_t lsh_find (const lsh_t* L, const real_t* x, ::size_t* h)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Cells of the signature, the probed cells and the moves to the
+     * neighbouring cells (-1, 0 or 1). */
+    real_t c[LSH_PROJECTIONS];
+    real_t probe[LSH_PROJECTIONS];
+    real_t move[LSH_PROJECTIONS];
+
+    /* Projections with a move and their number. */
+    size_t M[LSH_PROJECTIONS];
+    size_t m;
+
+    /* Projection and the hash of a probe. */
+    real_t y;
+    size_t g;
+
+    /* Squared distance and the squared tolerance. */
+    real_t d2;
+    real_t tol2;
+
+    /* Set of the moves of a probe (as bits). */
+    size_t bits;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Cells, moves and projections with a move. */
+    memset(c, 0, sizeof c);
+    memset(probe, 0, sizeof probe);
+    memset(move, 0, sizeof move);
+    memset(M, 0, sizeof M);
+    m = 0U;
+
+    /* Projection and the hash of a probe. */
+    y = 0.0;
+    g = 0U;
+
+    /* Squared distance and the squared tolerance. */
+    d2 = 0.0;
+    tol2 = L->tol * L->tol;
+
+    /* Set of the moves of a probe. */
+    bits = 0U;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* Project the signature and find the cells and the moves. */
+    for (j = 0U; j < L->K; ++j)
+    {
+        for (y = *(L->b + j), i = 0U; i < L->d; ++i)
+            y += *(L->A + j * L->d + i) * *(x + i);
+        *(c + j) = rfloor(y / L->w);
+        y -= *(c + j) * L->w;
+        if (y < L->tol)
+            *(move + j) = -1.0;
+        else if (L->w - y < L->tol)
+            *(move + j) = 1.0;
+        if (!(*(move + j) == 0.0))
+            *(M + m++) = j;
+    }
+    if (h)
+        *h = lsh_hash(L->K, c);
+
+    /* Probe the cells reached by all subsets of the moves. */
+    for (bits = 0U; !(bits >> m); ++bits)
+    {
+        memcpy(probe, c, L->K * sizeof *probe);
+        for (j = 0U; j < m; ++j)
+            if ((bits >> j) & 1U)
+                *(probe + *(M + j)) += *(move + *(M + j));
+        g = lsh_hash(L->K, probe);
+
+        /* Check the signatures of the chain of the same hash. */
+        for (i = *(L->heads + (g & L->mask)); i < L->n; i = *(L->next + i))
+        {
+            if (!(*(L->H + i) == g))
+                continue;
+            for (d2 = 0.0, j = 0U; j < L->d && !(d2 > tol2); ++j)
+                d2 +=
+                    (*(x + j) - *(L->X + i * L->d + j)) *
+                    (*(x + j) - *(L->X + i * L->d + j));
+            if (!(d2 > tol2))
+                return i;
+        }
+    }
+
+    /* Return `L->n` (no signature was found). */
+    return L->n;
+}
+
+/**
+ * Store a signature unless a stored signature is within the tolerance.
+ *
+ * @param L
+ *     Pointer to the hash table.
+ *
+ * @param x
+ *     Array of the `L->d` values of the signature.
+ *
+ * @return
+ *     Value `true` if the signature is novel and it was stored; `false` if a
+ *     stored signature is within the tolerance or if the hash table is full.
+ *
+ * @see lsh_find
+ *
+ */
+#if !defined(__cplusplus)
+bool lsh_insert (lsh_t* L, const real_t* x)
+#else
+inline bool lsh_insert (lsh_t* L, const real_t* x)
+#endif /* __cplusplus */
+{
+    /* Hash of the cells of the signature. */
+    size_t h;
+
+    /* Initialise the hash. */
+    h = 0U;
+
+    /* If a signature within the tolerance is stored or if the hash table is
+     * full, return `false`. */
+    if (!(lsh_find(L, x, &h) == L->n && L->n < L->capacity))
+        return false;
+
+    /* Store the signature at the head of its chain. */
+    memcpy(L->X + L->n * L->d, x, L->d * sizeof *L->X);
+    *(L->H + L->n) = h;
+    *(L->next + L->n) = *(L->heads + (h & L->mask));
+    *(L->heads + (h & L->mask)) = L->n;
+    ++L->n;
+
+    return true;
+}
+
+#endif /* __LSH_H__INCLUDED */
@@ -0,0 +1,747 @@
+/**
+ * Batched inference of fully connected neural networks by BLAS.
+ *
+ * A network of L dense layers maps n_0 features to n_L outputs.  The features
+ * are standardised by their means and standard deviations, and the l-th layer
+ * computes a(h W_l + b_l), where h is the row of the n_(l - 1) values of the
+ * previous layer, W_l is the kernel of n_(l - 1) rows and n_l columns, b_l is
+ * the bias and a is the activation of the layer (see the macros `MLP_LINEAR`,
+ * `MLP_RELU` and `MLP_RELU_INV`).  The model "models/neural_network.h5" (see
+ * the notebook "Models.ipynb") is exported by the script "mlp_exporter.py" as
+ * a single row of values
+ *     L	n_0	...	n_L	a_1	...	a_L	mean	std	W_1	b_1	...	W_L	b_L
+ * where the means and the standard deviations are the n_0 values of the files
+ * "models/neural_network_features_mean.npy" and
+ * "models/neural_network_features_std.npy", and each kernel is stored by rows
+ * (as in Keras).
+ *
+ * Rows are evaluated in blocks of `MLP_BLOCK` rows:  for each layer, the
+ * output block is initialised to the bias, the product of the input block and
+ * the kernel is added to it by a single call of the BLAS routine xGEMM, and
+ * the activation is applied while the block is still in the cache.  Blocks
+ * are split among POSIX threads as in the `mps_solve_batch` function (see
+ * "mps.h").  If the BLAS library is itself multithreaded, its number of
+ * threads should be set to 1 when more than 1 thread is used here.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__MLP_H__INCLUDED) && (__MLP_H__INCLUDED) == 1)
+
+/* Undefine __MLP_H__INCLUDED if it has already been defined. */
+#if defined(__MLP_H__INCLUDED)
+#undef __MLP_H__INCLUDED
+#endif /* __MLP_H__INCLUDED */
+
+/* Define __MLP_H__INCLUDED as 1. */
+#define __MLP_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import POSIX threads. */
+#include <pthread.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define the name of the BLAS routine of the matrix multiplication for the
+ * type `real_t`. */
+#if defined(_MLP_GEMM)
+#undef _MLP_GEMM
+#endif /* _MLP_GEMM */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define _MLP_GEMM sgemm_
+#else
+#define _MLP_GEMM dgemm_
+#endif /* _REAL_PRECISION */
+
+/* Import the BLAS routine.  In C++ the routine must be declared with the C
+ * linkage. */
+#if defined(__cplusplus)
+extern "C"
+{
+#endif /* __cplusplus */
+extern void _MLP_GEMM (
+    char* TRANSA,
+    char* TRANSB,
+    int* M,
+    int* N,
+    int* K,
+    real_t* ALPHA,
+    real_t* A,
+    int* LDA,
+    real_t* B,
+    int* LDB,
+    real_t* BETA,
+    real_t* C,
+    int* LDC
+);
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/* Define constants. */
+
+/**
+ * Code of the linear activation (identity).
+ *
+ */
+#define MLP_LINEAR 0
+
+/**
+ * Code of the rectified linear activation max(x, 0).
+ *
+ */
+#define MLP_RELU 1
+
+/**
+ * Code of the activation max(1 / x, 0) (the function `relu_mult_inv` in the
+ * notebook "Models.ipynb";  the value at 0 is 0 instead of infinity).
+ *
+ */
+#define MLP_RELU_INV 2
+
+/**
+ * Number of rows evaluated in a single block.
+ *
+ */
+#define MLP_BLOCK 512U
+
+/* Define types. */
+
+/**
+ * Job of a thread evaluating a network.
+ *
+ */
+typedef struct mlp_job_struct
+{
+    /* Exported network. */
+    const real_t* F;
+
+    /* Number of rows. */
+    size_t N;
+
+    /* Rows of features and rows of outputs. */
+    const real_t* X;
+    real_t* Y;
+
+    /* Indicator of a successful evaluation. */
+    bool done;
+}
+mlp_job_t;
+
+/* Define functions. */
+
+/**
+ * Compute the length of an exported network from its header.
+ *
+ * @param F
+ *     Array of the exported network (see the description of the header).  Only
+ *     the first 2 + 2 L values (the number of layers, the widths and the
+ *     activations) are read.
+ *
+ * @param w
+ *     Memory location to store the largest width of a layer (may be a
+ *     null-pointer).
+ *
+ * @return
+ *     Number of values of the exported network, or 0 if the header is not
+ *     valid (the number of layers or any of the widths is not a positive
+ *     integer or any of the activations is unknown).
+ *
+ */
+#if !defined(__cplusplus)
+size_t mlp_length (const real_t* F, size_t* w)
+#else
+inline ::size_t mlp_length (const real_t* F, ::size_t* w)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of layers, width of a layer and the largest width. */
+    size_t L;
+    size_t n;
+    size_t m;
+
+    /* Number of values. */
+    size_t length;
+
+    /* Iteration index. */
+    size_t l;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of layers, width of a layer and the largest width. */
+    L = 0U;
+    n = 0U;
+    m = 0U;
+
+    /* Number of values. */
+    length = 0U;
+
+    /* Iteration index. */
+    l = 0U;
+
+    /* ALGORITHM */
+
+    /* Initialise the largest width to 0. */
+    if (w)
+        *w = 0U;
+
+    /* If the pointer `F` is a null-pointer or the number of layers is not a
+     * positive integer, return 0. */
+    if (!(F && *F >= 1.0 && *F == (real_t)((size_t)*F)))
+        return 0U;
+    L = (size_t)*F;
+
+    /* Check the widths and count the values of the layers. */
+    for (l = 0U; l <= L; ++l)
+    {
+        if (
+            !(
+                *(F + 1U + l) >= 1.0 &&
+                *(F + 1U + l) == (real_t)((size_t)*(F + 1U + l))
+            )
+        )
+            return 0U;
+        n = (size_t)*(F + 1U + l);
+        if (n > m)
+            m = n;
+        length += l ? (size_t)*(F + l) * n + n : n << 1U;
+    }
+
+    /* Check the activations. */
+    for (l = 0U; l < L; ++l)
+        if (
+            !(
+                *(F + 2U + L + l) == MLP_LINEAR ||
+                *(F + 2U + L + l) == MLP_RELU ||
+                *(F + 2U + L + l) == MLP_RELU_INV
+            )
+        )
+            return 0U;
+
+    /* Store the largest width. */
+    if (w)
+        *w = m;
+
+    /* Return the number of values. */
+    return 2U + (L << 1U) + length;
+}
+
+/**
+ * Apply an activation to an array in place.
+ *
+ * @param a
+ *     Code of the activation (`MLP_LINEAR`, `MLP_RELU` or `MLP_RELU_INV`).
+ *
+ * @param n
+ *     Number of values.
+ *
+ * @param x
+ *     Array of size at least `n`.
+ *
+ */
+#if !defined(__cplusplus)
+void mlp_activate (int a, size_t n, real_t* x)
+#else
+inline void mlp_activate (int a, ::size_t n, real_t* x)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* Apply the activation (the linear activation leaves the values). */
+    if (a == MLP_RELU)
+        for (i = 0U; i < n; ++i)
+            *(x + i) = (*(x + i) > 0.0) ? *(x + i) : 0.0;
+    else if (a == MLP_RELU_INV)
+        for (i = 0U; i < n; ++i)
+            *(x + i) = (*(x + i) > 0.0) ? 1.0 / *(x + i) : 0.0;
+}
+
+/**
+ * Evaluate a network on a block of rows.
+ *
+ * @param F
+ *     Array of the exported network (see the description of the header).  The
+ *     header must be valid (see the function `mlp_length`).
+ *
+ * @param B
+ *     Number of rows.
+ *
+ * @param X
+ *     Array of `B` rows of n_0 features.
+ *
+ * @param Y
+ *     Array of size at least `B` * n_L to store the rows of outputs.
+ *
+ * @param W
+ *     Workspace of size at least 2 * `B` * w, where w is the largest width of
+ *     a layer.
+ *
+ * @see mlp_length
+ *
+ */
+#if !defined(__cplusplus)
+void mlp_block (
+    const real_t* F,
+    size_t B,
+    const real_t* X,
+    real_t* Y,
+    real_t* W
+)
+#else
+inline void mlp_block (
+    const real_t* F,
+    ::size_t B,
+    const real_t* X,
+    real_t* Y,
+    real_t* W
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Arguments of the BLAS routine. */
+    char no;
+    int m;
+    int n;
+    int k;
+    int b;
+    real_t one;
+
+    /* Number of layers, widths of the input and of the output of a layer and
+     * the largest width. */
+    size_t L;
+    size_t n_in;
+    size_t n_out;
+    size_t w;
+
+    /* Pointers to the values of the current layer, to the input block and to
+     * the output block. */
+    const real_t* p;
+    real_t* A;
+    real_t* C;
+    real_t* S;
+
+    /* Activation of the layer. */
+    int a;
+
+    /* Iteration indices. */
+    size_t l;
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Arguments of the BLAS routine. */
+    no = 'N';
+    m = 0;
+    n = 0;
+    k = 0;
+    b = (int)B;
+    one = 1.0;
+
+    /* Number of layers, widths and the largest width. */
+    L = (size_t)*F;
+    n_in = (size_t)*(F + 1U);
+    n_out = 0U;
+    w = 0U;
+    mlp_length(F, &w);
+
+    /* Pointers. */
+    p = F + 2U + (L << 1U);
+    A = W;
+    C = W + B * w;
+    S = (real_t*)(NULL);
+
+    /* Activation of the layer. */
+    a = MLP_LINEAR;
+
+    /* Iteration indices. */
+    l = 0U;
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* Standardise the features. */
+    for (i = 0U; i < B; ++i)
+        for (j = 0U; j < n_in; ++j)
+            *(A + i * n_in + j) =
+                (*(X + i * n_in + j) - *(p + j)) / *(p + n_in + j);
+    p += n_in << 1U;
+
+    /* Evaluate the layers. */
+    for (l = 0U; l < L; ++l)
+    {
+        n_out = (size_t)*(F + 2U + l);
+        a = (int)*(F + 2U + L + l);
+
+        /* Initialise the output block to the bias. */
+        for (i = 0U; i < B; ++i)
+            memcpy(
+                C + i * n_out,
+                p + n_in * n_out,
+                n_out * sizeof *C
+            );
+
+        /* Add the product of the input block and the kernel.  In the
+         * column-major order of BLAS, the blocks and the kernel are stored
+         * transposed, so the product is C^T += W^T A^T. */
+        m = (int)n_out;
+        n = b;
+        k = (int)n_in;
+        _MLP_GEMM(
+            &no,
+            &no,
+            &m,
+            &n,
+            &k,
+            &one,
+            (real_t*)p,
+            &m,
+            A,
+            &k,
+            &one,
+            C,
+            &m
+        );
+
+        /* Apply the activation. */
+        mlp_activate(a, B * n_out, C);
+
+        /* Move to the next layer. */
+        p += n_in * n_out + n_out;
+        n_in = n_out;
+        S = A;
+        A = C;
+        C = S;
+    }
+
+    /* Copy the outputs. */
+    memcpy(Y, A, B * n_in * sizeof *Y);
+}
+
+/**
+ * Evaluate a network on the rows of a job block by block.
+ *
+ * The function is the starting routine of the threads of the function
+ * `mlp_batch`.
+ *
+ * @param job
+ *     Pointer to the job (of the type `mlp_job_t`).
+ *
+ * @return
+ *     The null-pointer.
+ *
+ * @see mlp_block
+ * @see mlp_batch
+ *
+ */
+#if !defined(__cplusplus)
+void* mlp_job (void* job)
+#else
+extern "C" inline void* mlp_job (void* job)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Job. */
+    mlp_job_t* J;
+
+    /* Workspace. */
+    real_t* W;
+
+    /* Widths of the input and of the output and the largest width. */
+    size_t n_in;
+    size_t n_out;
+    size_t w;
+
+    /* Index of the first row of the block. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Job. */
+    J = (mlp_job_t*)job;
+
+    /* Workspace. */
+    W = (real_t*)(NULL);
+
+    /* Widths. */
+    n_in = 0U;
+    n_out = 0U;
+    w = 0U;
+
+    /* Index of the first row of the block. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If there is no job, return the null-pointer. */
+    if (!J)
+        return NULL;
+
+    /* Find the widths. */
+    J->done = false;
+    mlp_length(J->F, &w);
+    n_in = (size_t)*(J->F + 1U);
+    n_out = (size_t)*(J->F + 1U + (size_t)*J->F);
+
+    /* Allocate the workspace.  If the allocation failed, the job fails. */
+#if !defined(__cplusplus)
+    W = (real_t*)malloc((MLP_BLOCK << 1U) * w * sizeof *W);
+#else
+    W = static_cast<real_t*>(::malloc((MLP_BLOCK << 1U) * w * sizeof *W));
+#endif /* __cplusplus */
+    if (!W)
+        return NULL;
+
+    /* Evaluate the network block by block. */
+    for (i = 0U; i < J->N; i += MLP_BLOCK)
+        mlp_block(
+            J->F,
+            (J->N - i < MLP_BLOCK) ? J->N - i : MLP_BLOCK,
+            J->X + i * n_in,
+            J->Y + i * n_out,
+            W
+        );
+    J->done = true;
+
+    /* Free the workspace. */
+    free(W);
+    W = (real_t*)(NULL);
+
+    /* Return the null-pointer. */
+    return NULL;
+}
+
+/**
+ * Evaluate a network on rows of features in parallel.
+ *
+ * Rows are split into `T` contiguous groups of (almost) the same size and
+ * each group is evaluated in its own thread with its own workspace (the first
+ * group is evaluated in the calling thread).  If the memory for the jobs
+ * cannot be allocated or if a thread cannot be created, the rows are
+ * evaluated in the calling thread.
+ *
+ * @param F
+ *     Array of the exported network (see the description of the header).
+ *
+ * @param N
+ *     Number of rows.
+ *
+ * @param X
+ *     Array of `N` rows of n_0 features.
+ *
+ * @param Y
+ *     Array of size at least `N` * n_L to store the rows of outputs.
+ *
+ * @param T
+ *     Number of threads (if 0, a single thread is used).
+ *
+ * @return
+ *     Value `true` if all rows were evaluated, `false` if the header of the
+ *     network is not valid or if a workspace could not be allocated.
+ *
+ * @see mlp_length
+ * @see mlp_job
+ *
+ */
+#if !defined(__cplusplus)
+bool mlp_batch (
+    const real_t* F,
+    size_t N,
+    const real_t* X,
+    real_t* Y,
+    size_t T
+)
+#else
+inline bool mlp_batch (
+    const real_t* F,
+    ::size_t N,
+    const real_t* X,
+    real_t* Y,
+    ::size_t T
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Single job (if the memory allocation fails). */
+    mlp_job_t single;
+
+    /* Array of jobs. */
+    mlp_job_t* jobs;
+
+    /* Array of threads. */
+    pthread_t* threads;
+
+    /* Array of indicators of successfully created threads. */
+    bool* created;
+
+    /* Widths of the input and of the output. */
+    size_t n_in;
+    size_t n_out;
+
+    /* Number of rows in the jobs so far and the indicator of success. */
+    size_t done;
+    bool success;
+
+    /* Iteration index. */
+    size_t t;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Single job. */
+    memset(&single, 0, sizeof single);
+
+    /* Array of jobs. */
+    jobs = (mlp_job_t*)(NULL);
+
+    /* Array of threads. */
+    threads = (pthread_t*)(NULL);
+
+    /* Array of indicators of successfully created threads. */
+    created = (bool*)(NULL);
+
+    /* Widths of the input and of the output. */
+    n_in = 0U;
+    n_out = 0U;
+
+    /* Number of rows in the jobs so far and the indicator of success. */
+    done = 0U;
+    success = true;
+
+    /* Iteration index. */
+    t = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer or if the header of the network
+     * is not valid, return `false`. */
+    if (!(F && X && Y && mlp_length(F, NULL)))
+        return false;
+    n_in = (size_t)*(F + 1U);
+    n_out = (size_t)*(F + 1U + (size_t)*F);
+
+    /* Use at least 1 and at most `N` threads. */
+    if (T > N)
+        T = N;
+    if (!T)
+        T = 1U;
+
+    /* Allocate memory for the jobs, the threads and the indicators. */
+#if !defined(__cplusplus)
+    jobs = (mlp_job_t*)malloc(T * sizeof *jobs);
+    threads = (pthread_t*)malloc(T * sizeof *threads);
+    created = (bool*)malloc(T * sizeof *created);
+#else
+    jobs = static_cast<mlp_job_t*>(::malloc(T * sizeof *jobs));
+    threads = static_cast<pthread_t*>(::malloc(T * sizeof *threads));
+    created = static_cast<bool*>(::malloc(T * sizeof *created));
+#endif /* __cplusplus */
+
+    /* If the memory allocation has failed, deallocate memory and evaluate all
+     * rows in the calling thread. */
+    if (!(jobs && threads && created))
+    {
+        /* Deallocate memory for the jobs, the threads and the indicators. */
+        free(jobs);
+        jobs = (mlp_job_t*)(NULL);
+        free(threads);
+        threads = (pthread_t*)(NULL);
+        free(created);
+        created = (bool*)(NULL);
+
+        /* Evaluate the rows. */
+        single.F = F;
+        single.N = N;
+        single.X = X;
+        single.Y = Y;
+        mlp_job((void*)(&single));
+
+        /* Return the indicator of success. */
+        return single.done;
+    }
+
+    /* Initialise the jobs. */
+    for (t = 0U; t < T; ++t)
+    {
+        (jobs + t)->F = F;
+        (jobs + t)->N = N / T + (t < N % T);
+        (jobs + t)->X = X + done * n_in;
+        (jobs + t)->Y = Y + done * n_out;
+        (jobs + t)->done = false;
+        *(created + t) = false;
+
+        done += (jobs + t)->N;
+    }
+
+    /* Start the threads for all jobs but the first one. */
+    for (t = 1U; t < T; ++t)
+        *(created + t) =
+            !pthread_create(threads + t, NULL, mlp_job, (void*)(jobs + t));
+
+    /* Do the first job and the jobs whose threads could not be created in the
+     * calling thread. */
+    for (t = 0U; t < T; ++t)
+        if (!*(created + t))
+            mlp_job((void*)(jobs + t));
+
+    /* Wait for the threads to finish. */
+    for (t = 0U; t < T; ++t)
+    {
+        if (t && *(created + t))
+            pthread_join(*(threads + t), NULL);
+        success = success && (jobs + t)->done;
+    }
+
+    /* Clear the memory in the array of jobs. */
+    memset(jobs, 0, T * sizeof *jobs);
+
+    /* Deallocate memory for the jobs, the threads and the indicators. */
+    free(jobs);
+    jobs = (mlp_job_t*)(NULL);
+    free(threads);
+    threads = (pthread_t*)(NULL);
+    free(created);
+    created = (bool*)(NULL);
+
+    /* Return the indicator of success. */
+    return success;
+}
+
+#endif /* __MLP_H__INCLUDED */
@@ -0,0 +1,1573 @@
+/**
+ * Method of particular solutions for the first Laplace eigenvalue on convex
+ * polygons.
+ *
+ * The eigenfunction is approximated by a linear combination of corner-adapted
+ * Fourier-Bessel functions
+ *     phi_kj(r, theta) = J_nu(sqrt(lambda) r) sin(nu theta),
+ *     nu = j pi / alpha_k,  j = 1, 2, ..., p,
+ * where (r, theta) are the polar coordinates around the k-th vertex (the angle
+ * theta is measured from the edge to the next vertex towards the inside of the
+ * polygon) and alpha_k is the interior angle at the vertex.  Each function
+ * solves the Helmholtz equation and vanishes on the two edges adjacent to its
+ * vertex, so no mesh is needed.  Following Betcke and Trefethen, the functions
+ * are evaluated on points on the boundary (the matrix A_B(lambda)) and on
+ * points in the interior (the matrix A_I(lambda)) of the polygon, and the
+ * eigenvalue is the minimiser of
+ *     sigma(lambda) = min { |A_B c| / |A c| : c != 0 },
+ * the sine of the angle between the space of the trial functions and the
+ * space of functions vanishing on the boundary, where A = [A_B; A_I].  The
+ * value sigma(lambda) is the smallest singular value of the rows Q_B of an
+ * orthonormal basis Q = [Q_B; Q_I] of the range of A; the basis is computed by
+ * the QR factorisation of A with column pivoting (columns of negligible
+ * diagonal entries of R are discarded, which makes the computation stable even
+ * if the functions are almost linearly dependent).
+ *
+ * The first eigenvalue lies between the analytic bounds computed by the
+ * function `bounds_polygon` (see "bounds.h").  The function sigma is sampled
+ * on a geometric grid from the lower bound up to its first local minimum,
+ * which is then refined by the parabolic interpolation of sigma^2 safeguarded
+ * by the golden section search.  The value of sigma at the minimum is
+ * returned as the error indicator:  it is small if the boundary values of the
+ * approximate eigenfunction are small compared to its interior values, and by
+ * the Moler-Payne theorem it bounds the relative error of the eigenvalue up to
+ * a constant depending on the polygon.
+ *
+ * To avoid overflow and underflow for large orders, the Bessel functions are
+ * scaled by their behaviour at zero:  the function
+ *     (r / rho)^nu F_nu(sqrt(lambda) r),
+ *     F_nu(x) = Gamma(nu + 1) J_nu(x) / (x / 2)^nu,
+ * where rho is the largest distance from the vertex to other vertices, is used
+ * instead of J_nu(sqrt(lambda) r) (the columns of A are only scaled by
+ * constants, which does not change the function sigma).  The entire function
+ * F_nu is computed by its power series for small arguments and by Miller's
+ * backward recurrence normalised by the Neumann series of (x / 2)^nu
+ * otherwise.
+ *
+ * Only convex polygons with vertices in the mathematically positive order are
+ * supported.  The SVD driver is chosen by the macro `_USE_SVD_DRIVER` (see
+ * "polygon.h"), which must be defined before any package header is included,
+ * and the program must be linked with LAPACK (see "compile.sh").  The batch
+ * function `mps_solve_batch` uses POSIX threads.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__MPS_H__INCLUDED) && (__MPS_H__INCLUDED) == 1)
+
+/* Undefine __MPS_H__INCLUDED if it has already been defined. */
+#if defined(__MPS_H__INCLUDED)
+#undef __MPS_H__INCLUDED
+#endif /* __MPS_H__INCLUDED */
+
+/* Define __MPS_H__INCLUDED as 1. */
+#define __MPS_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import POSIX threads. */
+#include <pthread.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+#include "bounds.h"
+
+/* The method needs an SVD driver. */
+#if !( \
+    defined(_USE_SVD_DRIVER) && \
+    ( \
+        (_USE_SVD_DRIVER) == (_DGESVD_DRIVER) || \
+        (_USE_SVD_DRIVER) == (_DGESDD_DRIVER) \
+    ) \
+)
+#error "The macro _USE_SVD_DRIVER must be defined as an SVD driver."
+#endif /* _USE_SVD_DRIVER */
+
+/* Define names of the LAPACK routines of the QR factorisation with column
+ * pivoting and of the generation of Q for the type `real_t`. */
+#if defined(_MPS_GEQP3)
+#undef _MPS_GEQP3
+#endif /* _MPS_GEQP3 */
+#if defined(_MPS_ORGQR)
+#undef _MPS_ORGQR
+#endif /* _MPS_ORGQR */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define _MPS_GEQP3 sgeqp3_
+#define _MPS_ORGQR sorgqr_
+#else
+#define _MPS_GEQP3 dgeqp3_
+#define _MPS_ORGQR dorgqr_
+#endif /* _REAL_PRECISION */
+
+/* Import the LAPACK routines.  In C++ the routines must be declared with the C
+ * linkage. */
+#if defined(__cplusplus)
+extern "C"
+{
+#endif /* __cplusplus */
+extern void _MPS_GEQP3 (
+    int* M,
+    int* N,
+    real_t* A,
+    int* LDA,
+    int* JPVT,
+    real_t* TAU,
+    real_t* WORK,
+    int* LWORK,
+    int* INFO
+);
+extern void _MPS_ORGQR (
+    int* M,
+    int* N,
+    int* K,
+    real_t* A,
+    int* LDA,
+    real_t* TAU,
+    real_t* WORK,
+    int* LWORK,
+    int* INFO
+);
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/* Define constants. */
+
+/**
+ * Default number of basis functions per vertex.
+ *
+ */
+#define MPS_TERMS 12U
+
+/**
+ * Ratio of consecutive values of the eigenvalue on the grid of the search.
+ *
+ */
+#define MPS_STEP 1.03
+
+/**
+ * Relative tolerance of the refinement of the minimum (2^6 relative tolerances
+ * `tolerance` from "numeric.h", approximately 9.1e-13 for `double`).
+ *
+ */
+#define MPS_TOLERANCE (64.0 * tolerance)
+
+/**
+ * Relative threshold for discarding negligible singular values (the relative
+ * tolerance `tolerance` from "numeric.h", approximately 1.4e-14 for
+ * `double`).
+ *
+ */
+#define MPS_CUTOFF (tolerance)
+
+/* Define types. */
+
+/**
+ * Workspace of the method of particular solutions for polygons of a fixed
+ * number of vertices.
+ *
+ * Matrices are stored in column-major order (as expected by LAPACK).  The
+ * first `n` * `mb` rows correspond to the points on the boundary, and the
+ * remaining `n` * `mi` rows to the points in the interior of the polygon.
+ * The `n` * `p` columns are distributed among the vertices (see the function
+ * `mps_setup`); the columns of each vertex are consecutive and ordered by the
+ * order of the Bessel function.
+ *
+ */
+typedef struct mps_solver_struct
+{
+    /* Number of vertices. */
+    size_t n;
+
+    /* Number of basis functions per vertex. */
+    size_t p;
+
+    /* Numbers of points per edge on the boundary and in the interior. */
+    size_t mb;
+    size_t mi;
+
+    /* Numbers of rows and columns of the matrix A. */
+    size_t rows;
+    size_t columns;
+
+    /* Numbers of the basis functions of the vertices (of size `n`). */
+    size_t* count;
+
+    /* Vertices of the basis functions (of size `columns`). */
+    size_t* vertex;
+
+    /* Orders of the Bessel functions (of size `columns`). */
+    real_t* nu;
+
+    /* Distances of the points from the vertices (of size `rows` * `n`, the
+     * distance of the `i`-th point from the `k`-th vertex is at the index
+     * `k` * `rows` + `i`). */
+    real_t* r;
+
+    /* Factors of the entries independent of the eigenvalue (of size `rows` *
+     * `columns`). */
+    real_t* G;
+
+    /* Matrix A (of size `rows` * `columns`). */
+    real_t* A;
+
+    /* Rows Q_B of the orthonormal basis (of size `n` * `mb` * `columns`). */
+    real_t* B;
+
+    /* Scalar factors of the elementary reflectors of the QR factorisation
+     * (of size `columns`). */
+    real_t* tau;
+
+    /* Permutation of the columns of the QR factorisation (of size
+     * `columns`). */
+    int* jpvt;
+
+    /* Singular values (of size `columns`). */
+    real_t* s;
+
+    /* Workspace for the SVD driver. */
+    real_t* work;
+    int lwork;
+
+    /* Integer workspace for the SVD driver (of size 8 * `columns`). */
+    int* iwork;
+
+    /* Bounds of the first eigenvalue of the current polygon. */
+    real_t lower;
+    real_t upper;
+}
+mps_solver_t;
+
+/**
+ * Job of approximating the eigenvalues (an argument of the `mps_job`
+ * function).
+ *
+ */
+typedef struct mps_job_struct
+{
+    /* Number of vertices of each polygon. */
+    size_t n;
+
+    /* Number of polygons. */
+    size_t N;
+
+    /* Number of basis functions per vertex. */
+    size_t p;
+
+    /* Array of polygons. */
+    const real_t* P;
+
+    /* Array of eigenvalues and their error indicators. */
+    real_t* E;
+
+    /* Number of polygons on which the approximation failed. */
+    size_t failed;
+}
+mps_job_t;
+
+/**
+ * Compute the normalised Bessel function of the first kind.
+ *
+ * The function F_nu(x) = Gamma(nu + 1) J_nu(x) / (x / 2)^nu is computed (it
+ * is entire in x and F_nu(0) = 1).  If x^2 / 4 <= nu + 5, the power series
+ *     F_nu(x) = sum_k (-x^2 / 4)^k / (k! (nu + 1) (nu + 2) ... (nu + k))
+ * is summed (its terms are at most of order 1, so no accuracy is lost by
+ * cancellation).  Otherwise the values f_k proportional to J_(nu + k)(x) are
+ * computed by the backward recurrence
+ *     f_(k - 1) = 2 (nu + k) / x f_k - f_(k + 1)
+ * starting far above the order nu, and normalised by the identity
+ *     (x / 2)^nu = Gamma(nu) sum_k (nu + 2 k) (nu)_k / k! J_(nu + 2 k)(x),
+ * where (nu)_k = nu (nu + 1) ... (nu + k - 1).
+ *
+ * @param nu
+ *     Order (positive).
+ *
+ * @param x
+ *     Argument (nonnegative).
+ *
+ * @return
+ *     Value F_nu(x).
+ *
+ */
+#if !defined(__cplusplus)
+real_t mps_bessel (real_t nu, real_t x)
+#else
+inline real_t mps_bessel (real_t nu, real_t x)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Threshold and factor for rescaling the recurrence. */
+    const real_t big = 1.0e30;
+    const real_t small = 1.0e-30;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Quarter of the square of the argument. */
+    real_t q;
+
+    /* Term and sum of the series. */
+    real_t t;
+    real_t s;
+
+    /* Values of the recurrence. */
+    real_t f0;
+    real_t f1;
+    real_t f2;
+
+    /* Normalising sum and half of the index. */
+    real_t T;
+    real_t h;
+
+    /* Number of steps of the recurrence. */
+    size_t M;
+
+    /* Iteration index. */
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Quarter of the square of the argument. */
+    q = 0.25 * x * x;
+
+    /* Term and sum of the series. */
+    t = 1.0;
+    s = 1.0;
+
+    /* Values of the recurrence. */
+    f0 = 0.0;
+    f1 = small;
+    f2 = 0.0;
+
+    /* Normalising sum and half of the index. */
+    T = 0.0;
+    h = 0.0;
+
+    /* Number of steps of the recurrence. */
+    M = 0U;
+
+    /* Iteration index. */
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Sum the power series for small arguments. */
+    if (q <= nu + 5.0)
+    {
+        for (k = 1U; ; ++k)
+        {
+            t *= -q / ((real_t)k * (nu + (real_t)k));
+            if (s + t == s)
+                break;
+            s += t;
+        }
+
+        return s;
+    }
+
+    /* Compute the (even) number of steps of the recurrence. */
+    M = (size_t)(((x > nu) ? x - nu : 0.0) + 20.0 + 2.0 * rsqrt(10.0 * x));
+    M = (M + 1U) & ~(size_t)1U;
+
+    /* Run the recurrence and accumulate the normalising sum. */
+    for (k = M; ; --k)
+    {
+        if (!(k & 1U))
+        {
+            h = 0.5 * (real_t)k;
+            T = (nu + (real_t)k) * f1 + (nu + h) / (h + 1.0) * T;
+        }
+        if (!k)
+            break;
+        f0 = 2.0 * (nu + (real_t)k) / x * f1 - f2;
+        f2 = f1;
+        f1 = f0;
+        if (rabs(f1) > big || rabs(T) > big)
+        {
+            f1 *= small;
+            f2 *= small;
+            T *= small;
+        }
+    }
+
+    return nu * f1 / T;
+}
+
+/**
+ * Free a workspace.
+ *
+ * @param S
+ *     Pointer to the workspace.
+ *
+ */
+#if !defined(__cplusplus)
+void mps_free (mps_solver_t* S)
+#else
+inline void mps_free (mps_solver_t* S)
+#endif /* __cplusplus */
+{
+    /* Deallocate memory. */
+    free(S->count);
+    free(S->vertex);
+    free(S->nu);
+    free(S->r);
+    free(S->G);
+    free(S->A);
+    free(S->B);
+    free(S->tau);
+    free(S->jpvt);
+    free(S->s);
+    free(S->work);
+    free(S->iwork);
+
+    /* Reset the workspace. */
+    memset(S, 0, sizeof *S);
+}
+
+/**
+ * Allocate a workspace.
+ *
+ * The matrix A has `n` * `p` columns.  The number of points on the boundary
+ * is (`n` + 1) * `p` per edge (more than the number of columns, since all
+ * basis functions of a vertex may vanish on all edges but one), and the
+ * number of points in the interior is `p` per edge.  The optimal size of the
+ * workspace of the SVD driver is queried.
+ *
+ * @param S
+ *     Pointer to the workspace.
+ *
+ * @param n
+ *     Number of vertices (at least 3).
+ *
+ * @param p
+ *     Number of basis functions per vertex (at least 1).
+ *
+ * @return
+ *     Value `true` if the workspace was allocated, `false` otherwise (illegal
+ *     arguments or the memory allocation has failed).
+ *
+ */
+#if !defined(__cplusplus)
+bool mps_allocate (mps_solver_t* S, size_t n, size_t p)
+#else
+inline bool mps_allocate (mps_solver_t* S, ::size_t n, ::size_t p)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Job string for the SVD driver. */
+    char job[2U];
+
+    /* Dimensions of the matrices (of type `int`). */
+    int int_m;
+    int int_b;
+    int int_c;
+
+    /* Queried sizes of the workspace and their maximum. */
+    real_t query;
+    real_t size;
+
+    /* Information from the SVD driver. */
+    int info;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Job string for the SVD driver. */
+    memset(job, 0, sizeof job);
+
+    /* Dimensions of the matrices (of type `int`). */
+    int_m = 0;
+    int_b = 0;
+    int_c = 0;
+
+    /* Queried sizes of the workspace and their maximum. */
+    query = 0.0;
+    size = 0.0;
+
+    /* Information from the SVD driver. */
+    info = 0;
+
+    /* ALGORITHM */
+
+    /* Reset the workspace. */
+    memset(S, 0, sizeof *S);
+
+    /* If the arguments are illegal, return `false`. */
+    if (n < 3U || !p)
+        return false;
+
+    /* Set the dimensions. */
+    S->n = n;
+    S->p = p;
+    S->mb = (n + 1U) * p;
+    S->mi = p;
+    S->rows = n * (S->mb + S->mi);
+    S->columns = n * p;
+
+    /* Allocate memory. */
+#if !defined(__cplusplus)
+    S->count = (size_t*)malloc(n * sizeof *S->count);
+    S->vertex = (size_t*)malloc(S->columns * sizeof *S->vertex);
+    S->nu = (real_t*)malloc(S->columns * sizeof *S->nu);
+    S->r = (real_t*)malloc(S->rows * n * sizeof *S->r);
+    S->G = (real_t*)malloc(S->rows * S->columns * sizeof *S->G);
+    S->A = (real_t*)malloc(S->rows * S->columns * sizeof *S->A);
+    S->B = (real_t*)malloc(n * S->mb * S->columns * sizeof *S->B);
+    S->tau = (real_t*)malloc(S->columns * sizeof *S->tau);
+    S->jpvt = (int*)malloc(S->columns * sizeof *S->jpvt);
+    S->s = (real_t*)malloc(S->columns * sizeof *S->s);
+    S->iwork = (int*)malloc((S->columns << 3U) * sizeof *S->iwork);
+#else
+    S->count = static_cast< ::size_t* >(::malloc(n * sizeof *S->count));
+    S->vertex =
+        static_cast< ::size_t* >(::malloc(S->columns * sizeof *S->vertex));
+    S->nu = static_cast<real_t*>(::malloc(S->columns * sizeof *S->nu));
+    S->r = static_cast<real_t*>(::malloc(S->rows * n * sizeof *S->r));
+    S->G =
+        static_cast<real_t*>(::malloc(S->rows * S->columns * sizeof *S->G));
+    S->A =
+        static_cast<real_t*>(::malloc(S->rows * S->columns * sizeof *S->A));
+    S->B =
+        static_cast<real_t*>(
+            ::malloc(n * S->mb * S->columns * sizeof *S->B)
+        );
+    S->tau = static_cast<real_t*>(::malloc(S->columns * sizeof *S->tau));
+    S->jpvt = static_cast<int*>(::malloc(S->columns * sizeof *S->jpvt));
+    S->s = static_cast<real_t*>(::malloc(S->columns * sizeof *S->s));
+    S->iwork =
+        static_cast<int*>(::malloc((S->columns << 3U) * sizeof *S->iwork));
+#endif /* __cplusplus */
+    if (
+        !(
+            S->count &&
+            S->vertex &&
+            S->nu &&
+            S->r &&
+            S->G &&
+            S->A &&
+            S->B &&
+            S->tau &&
+            S->jpvt &&
+            S->s &&
+            S->iwork
+        )
+    )
+    {
+        mps_free(S);
+
+        return false;
+    }
+
+    /* Query the sizes of the workspaces for the QR factorisation of A, for
+     * the computation of Q and for the SVD of Q_B, and use the largest. */
+    int_m = (int)S->rows;
+    int_b = (int)(n * S->mb);
+    int_c = (int)S->columns;
+    S->lwork = -1;
+    _MPS_GEQP3(
+        &int_m,
+        &int_c,
+        S->A,
+        &int_m,
+        S->jpvt,
+        S->tau,
+        &query,
+        &S->lwork,
+        &info
+    );
+    S->lwork = -1;
+    size = rmax(size, query);
+    _MPS_ORGQR(
+        &int_m,
+        &int_c,
+        &int_c,
+        S->A,
+        &int_m,
+        S->tau,
+        &query,
+        &S->lwork,
+        &info
+    );
+    S->lwork = -1;
+    size = rmax(size, query);
+    *job = 'N';
+#if (_USE_SVD_DRIVER) == (_DGESVD_DRIVER)
+    _SVD_GESVD(
+        job,
+        job,
+        &int_b,
+        &int_c,
+        S->B,
+        &int_b,
+        S->s,
+        S->A,
+        &int_b,
+        S->A,
+        &int_c,
+        &query,
+        &S->lwork,
+        &info
+    );
+#else
+    _SVD_GESDD(
+        job,
+        &int_b,
+        &int_c,
+        S->B,
+        &int_b,
+        S->s,
+        S->A,
+        &int_b,
+        S->A,
+        &int_c,
+        &query,
+        &S->lwork,
+        S->iwork,
+        &info
+    );
+#endif /* _USE_SVD_DRIVER */
+    size = rmax(size, query);
+    S->lwork = (int)size + 1;
+
+    /* Allocate memory for the workspace. */
+#if !defined(__cplusplus)
+    S->work = (real_t*)malloc((size_t)S->lwork * sizeof *S->work);
+#else
+    S->work =
+        static_cast<real_t*>(
+            ::malloc(static_cast< ::size_t >(S->lwork) * sizeof *S->work)
+        );
+#endif /* __cplusplus */
+    if (info || !S->work)
+    {
+        mps_free(S);
+
+        return false;
+    }
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Prepare a workspace for a polygon.
+ *
+ * The orders of the Bessel functions, the points, their distances from the
+ * vertices, the factors of the entries of the matrix A independent of the
+ * eigenvalue and the bounds of the first eigenvalue are computed.  The points
+ * on the boundary are the Chebyshev points of each edge, and the points in the
+ * interior are quasi-random points (the Halton sequence of bases 2 and 3)
+ * mapped uniformly to the triangles between the average of the vertices and
+ * the edges.
+ *
+ * @param S
+ *     Pointer to the allocated workspace.
+ *
+ * @param P
+ *     Array of vertices of the polygon of size at least 2 * `S->n`, organised
+ *     as in the `describe_polygon` function.
+ *
+ * @return
+ *     Value `true` if the workspace was prepared, `false` if the polygon is
+ *     not convex or not in the mathematically positive order, or if it is
+ *     degenerate.
+ *
+ * @see bounds_polygon
+ * @see describe_polygon
+ *
+ */
+#if !defined(__cplusplus)
+bool mps_setup (mps_solver_t* S, const real_t* P)
+#else
+inline bool mps_setup (mps_solver_t* S, const real_t* P)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Numerical approximation of the mathematical constant pi. */
+    const real_t pi =
+        3.1415926535897932384626433832795028841971693993751058209749445923;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Bounds of the first eigenvalue. */
+    bounds_t bounds;
+
+    /* Differences of coordinates, lengths of edges and outer angles. */
+    real_t* dx;
+    real_t* dy;
+    real_t* l;
+    real_t* phi;
+
+    /* Average of the vertices. */
+    real_t cx;
+    real_t cy;
+
+    /* Interior angle and the largest distance from a vertex. */
+    real_t alpha;
+    real_t rho;
+
+    /* Coordinates of a point relative to a vertex and the cosine of its
+     * angle. */
+    real_t x;
+    real_t y;
+    real_t c;
+
+    /* Parameters of a point. */
+    real_t t;
+    real_t u;
+    real_t f;
+    size_t b;
+
+    /* Total number of distributed basis functions. */
+    size_t total;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t k;
+    size_t e;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Bounds of the first eigenvalue. */
+    memset(&bounds, 0, sizeof bounds);
+
+    /* Differences of coordinates, lengths of edges and outer angles (the
+     * arrays are placed in the matrix B, which is unused until the search). */
+    dx = S->B;
+    dy = S->B + S->n;
+    l = S->B + (S->n << 1U);
+    phi = S->B + 3U * S->n;
+
+    /* Average of the vertices. */
+    cx = 0.0;
+    cy = 0.0;
+
+    /* Interior angle and the largest distance from a vertex. */
+    alpha = 0.0;
+    rho = 0.0;
+
+    /* Coordinates of a point relative to a vertex and the cosine of its
+     * angle. */
+    x = 0.0;
+    y = 0.0;
+    c = 0.0;
+
+    /* Parameters of a point. */
+    t = 0.0;
+    u = 0.0;
+    f = 0.0;
+    b = 0U;
+
+    /* Total number of distributed basis functions. */
+    total = 0U;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    k = 0U;
+    e = 0U;
+
+    /* ALGORITHM */
+
+    /* Compute the bounds of the first eigenvalue.  If the polygon is not
+     * supported, return `false`. */
+    if (!bounds_polygon(S->n, P, &bounds))
+        return false;
+    S->lower = bounds.lower;
+    S->upper = bounds.upper;
+
+    /* Describe the polygon and compute the average of the vertices. */
+    describe_polygon(S->n, P, dx, dy, l, phi);
+    for (k = 0U; k < S->n; ++k)
+    {
+        cx += *(P + (k << 1U));
+        cy += *(P + (k << 1U) + 1U);
+    }
+    cx /= (real_t)S->n;
+    cy /= (real_t)S->n;
+
+    /* Compute the points:  the `b`-th point on the boundary of the `e`-th
+     * edge is the `b`-th Chebyshev point of the edge, and the `b`-th point in
+     * the interior of the `e`-th triangle between the average of the vertices
+     * and an edge is computed from the `b`-th Halton point (t, u) as
+     * c + sqrt(u) (V_e + t (V_(e + 1) - V_e) - c).  The coordinates are stored
+     * temporarily in the matrix A. */
+    for (i = 0U; i < S->rows; ++i)
+    {
+        if (i < S->n * S->mb)
+        {
+            e = i / S->mb;
+            b = i % S->mb;
+            t =
+                0.5 * (
+                    1.0 -
+                    rcos(pi * ((real_t)b + 0.5) / (real_t)S->mb)
+                );
+            x = *(P + (e << 1U)) + t * *(dx + e);
+            y = *(P + (e << 1U) + 1U) + t * *(dy + e);
+        }
+        else
+        {
+            e = (i - S->n * S->mb) / S->mi;
+            b = (i - S->n * S->mb) % S->mi + 1U;
+            for (t = 0.0, f = 0.5, j = b; j; j >>= 1U, f *= 0.5)
+                t += f * (real_t)(j & 1U);
+            for (u = 0.0, f = 1.0 / 3.0, j = b; j; j /= 3U, f /= 3.0)
+                u += f * (real_t)(j % 3U);
+            u = rsqrt(u);
+            x = cx + u * (*(P + (e << 1U)) + t * *(dx + e) - cx);
+            y = cy + u * (*(P + (e << 1U) + 1U) + t * *(dy + e) - cy);
+        }
+        *(S->A + (i << 1U)) = x;
+        *(S->A + (i << 1U) + 1U) = y;
+    }
+
+    /* Distribute the basis functions among the vertices proportionally to
+     * the interior angles (the orders at a vertex are multiples of pi divided
+     * by its angle, so the functions of larger angles oscillate slower and
+     * reach further into the polygon), at least one function per vertex.  The
+     * remainder of the rounding is given to the vertex of the largest
+     * angle. */
+    e = 0U;
+    total = 0U;
+    for (k = 0U; k < S->n; ++k)
+    {
+        alpha = pi - *(phi + (k ? k - 1U : S->n - 1U));
+        b = (size_t)(
+            (real_t)S->columns * alpha / ((real_t)(S->n - 2U) * pi) + 0.5
+        );
+        *(S->count + k) = b ? b : 1U;
+        total += *(S->count + k);
+        if (alpha > pi - *(phi + (e ? e - 1U : S->n - 1U)))
+            e = k;
+    }
+    if (total > S->columns)
+    {
+        for (k = 0U; total > S->columns; k = incmod(k, S->n))
+            if (*(S->count + k) > 1U)
+            {
+                --*(S->count + k);
+                --total;
+            }
+    }
+    else
+        *(S->count + e) += S->columns - total;
+
+    /* Compute the orders, the distances and the factors independent of the
+     * eigenvalue for each vertex.  The outer angle at the `k`-th vertex is
+     * stored at the index `k` - 1 (cyclically), and the angle theta is
+     * measured from the `k`-th edge. */
+    for (k = 0U, e = 0U; k < S->n; e += *(S->count + k), ++k)
+    {
+        alpha = pi - *(phi + (k ? k - 1U : S->n - 1U));
+        rho = 0.0;
+        for (j = 0U; j < S->n; ++j)
+        {
+            x = *(P + (j << 1U)) - *(P + (k << 1U));
+            y = *(P + (j << 1U) + 1U) - *(P + (k << 1U) + 1U);
+            rho = rmax(rho, rsqrt(x * x + y * y));
+        }
+        for (j = 0U; j < *(S->count + k); ++j)
+        {
+            *(S->nu + e + j) = (real_t)(j + 1U) * pi / alpha;
+            *(S->vertex + e + j) = k;
+        }
+        for (i = 0U; i < S->rows; ++i)
+        {
+            x = *(S->A + (i << 1U)) - *(P + (k << 1U));
+            y = *(S->A + (i << 1U) + 1U) - *(P + (k << 1U) + 1U);
+            t = rsqrt(x * x + y * y);
+            *(S->r + k * S->rows + i) = t;
+            c =
+                (t > 0.0) ?
+                    (x * *(dx + k) + y * *(dy + k)) / (t * *(l + k)) :
+                    1.0;
+            u = racos(rmax(-1.0, rmin(c, 1.0)));
+            for (j = 0U; j < *(S->count + k); ++j)
+            {
+                f = *(S->nu + e + j);
+                *(S->G + (e + j) * S->rows + i) =
+                    (t > 0.0) ? rpow(t / rho, f) * rsin(f * u) : 0.0;
+            }
+        }
+    }
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Compute the sine of the subspace angle for an approximate eigenvalue.
+ *
+ * @param S
+ *     Pointer to the workspace prepared by the `mps_setup` function.
+ *
+ * @param ev
+ *     Approximate eigenvalue (positive).
+ *
+ * @return
+ *     Value sigma(`ev`), or `lambda` (the undefined real number, see
+ *     "numeric.h") if the SVD driver failed.
+ *
+ * @see mps_setup
+ *
+ */
+#if !defined(__cplusplus)
+real_t mps_sigma (mps_solver_t* S, real_t ev)
+#else
+inline real_t mps_sigma (mps_solver_t* S, real_t ev)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Job string for the SVD driver. */
+    char job[2U];
+
+    /* Dimensions of the matrices (of type `int`). */
+    int int_m;
+    int int_b;
+    int int_c;
+
+    /* Information from the LAPACK routines. */
+    int info;
+
+    /* Square root of the eigenvalue. */
+    real_t kappa;
+
+    /* Number of rows on the boundary and the rank of the matrix A. */
+    size_t mB;
+    size_t rank;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Job string for the SVD driver. */
+    memset(job, 0, sizeof job);
+
+    /* Dimensions of the matrices (of type `int`). */
+    int_m = (int)S->rows;
+    int_b = 0;
+    int_c = (int)S->columns;
+
+    /* Information from the LAPACK routines. */
+    info = 0;
+
+    /* Square root of the eigenvalue. */
+    kappa = rsqrt(ev);
+
+    /* Number of rows on the boundary and the rank of the matrix A. */
+    mB = S->n * S->mb;
+    rank = 0U;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* Fill the matrix A. */
+    for (j = 0U; j < S->columns; ++j)
+        for (i = 0U; i < S->rows; ++i)
+            *(S->A + j * S->rows + i) =
+                *(S->G + j * S->rows + i) *
+                mps_bessel(
+                    *(S->nu + j),
+                    kappa * *(S->r + *(S->vertex + j) * S->rows + i)
+                );
+
+    /* Compute the QR factorisation of A with column pivoting. */
+    memset(S->jpvt, 0, S->columns * sizeof *S->jpvt);
+    _MPS_GEQP3(
+        &int_m,
+        &int_c,
+        S->A,
+        &int_m,
+        S->jpvt,
+        S->tau,
+        S->work,
+        &S->lwork,
+        &info
+    );
+    if (info || !(0.0 < rabs(*S->A)))
+        return lambda;
+
+    /* Discard the columns of negligible diagonal entries of R (the entries
+     * are decreasing in absolute value because of the pivoting). */
+    for (rank = 1U; rank < S->columns; ++rank)
+        if (
+            rabs(*(S->A + rank * S->rows + rank)) <
+            MPS_CUTOFF * rabs(*S->A)
+        )
+            break;
+
+    /* Compute the first `rank` columns of Q (they overwrite A). */
+    int_c = (int)rank;
+    _MPS_ORGQR(
+        &int_m,
+        &int_c,
+        &int_c,
+        S->A,
+        &int_m,
+        S->tau,
+        S->work,
+        &S->lwork,
+        &info
+    );
+    if (info)
+        return lambda;
+
+    /* Copy the rows of the boundary points. */
+    for (j = 0U; j < rank; ++j)
+        memcpy(S->B + j * mB, S->A + j * S->rows, mB * sizeof *S->B);
+
+    /* Compute the singular values of Q_B. */
+    int_b = (int)mB;
+    *job = 'N';
+#if (_USE_SVD_DRIVER) == (_DGESVD_DRIVER)
+    _SVD_GESVD(
+        job,
+        job,
+        &int_b,
+        &int_c,
+        S->B,
+        &int_b,
+        S->s,
+        S->A,
+        &int_b,
+        S->A,
+        &int_c,
+        S->work,
+        &S->lwork,
+        &info
+    );
+#else
+    _SVD_GESDD(
+        job,
+        &int_b,
+        &int_c,
+        S->B,
+        &int_b,
+        S->s,
+        S->A,
+        &int_b,
+        S->A,
+        &int_c,
+        S->work,
+        &S->lwork,
+        S->iwork,
+        &info
+    );
+#endif /* _USE_SVD_DRIVER */
+    if (info)
+        return lambda;
+
+    /* Return the smallest singular value. */
+    return *(S->s + rank - 1U);
+}
+
+/**
+ * Approximate the first eigenvalue on a polygon.
+ *
+ * @param S
+ *     Pointer to the allocated workspace.
+ *
+ * @param P
+ *     Array of vertices of the polygon of size at least 2 * `S->n`, organised
+ *     as in the `describe_polygon` function.
+ *
+ * @param ev
+ *     Memory location to store the approximation of the first eigenvalue.
+ *
+ * @param err
+ *     Memory location to store the error indicator (the value of sigma at the
+ *     approximation).
+ *
+ * @return
+ *     Value `true` if the approximation was computed, `false` otherwise (the
+ *     polygon is not supported or no minimum was found).
+ *
+ * @see mps_setup
+ * @see mps_sigma
+ *
+ */
+#if !defined(__cplusplus)
+bool mps_eigenvalue (mps_solver_t* S, const real_t* P, real_t* ev, real_t* err)
+#else
+inline bool mps_eigenvalue (
+    mps_solver_t* S,
+    const real_t* P,
+    real_t* ev,
+    real_t* err
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Complement of the inverse of the golden ratio. */
+    const real_t g = 0.38196601125010515179541316563436188227969082019424;
+
+    /* Maximal number of steps of the refinement. */
+    const size_t max_steps = 128U;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Bracket of the minimum and the new point. */
+    real_t a;
+    real_t b;
+    real_t c;
+    real_t u;
+
+    /* Values of sigma. */
+    real_t fa;
+    real_t fb;
+    real_t fc;
+    real_t fu;
+
+    /* Auxiliary values of the parabolic interpolation. */
+    real_t pa;
+    real_t pc;
+    real_t den;
+
+    /* Width of the bracket two steps ago and one step ago. */
+    real_t w2;
+    real_t w1;
+
+    /* Iteration index. */
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Bracket of the minimum and the new point. */
+    a = 0.0;
+    b = 0.0;
+    c = 0.0;
+    u = 0.0;
+
+    /* Values of sigma. */
+    fa = lambda;
+    fb = lambda;
+    fc = lambda;
+    fu = lambda;
+
+    /* Auxiliary values of the parabolic interpolation. */
+    pa = 0.0;
+    pc = 0.0;
+    den = 0.0;
+
+    /* Width of the bracket two steps ago and one step ago. */
+    w2 = lambda;
+    w1 = lambda;
+
+    /* Iteration index. */
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Prepare the workspace.  If the polygon is not supported, return
+     * `false`. */
+    if (!mps_setup(S, P))
+        return false;
+
+    /* Walk along the grid from the lower bound until the first local minimum
+     * is bracketed.  If there is no minimum below the upper bound, return
+     * `false`. */
+    b = S->lower / MPS_STEP;
+    c = S->lower;
+    fc = mps_sigma(S, c);
+    do
+    {
+        a = b;
+        fa = fb;
+        b = c;
+        fb = fc;
+        c *= MPS_STEP;
+        fc = mps_sigma(S, c);
+        if (fc == lambda || b > S->upper * MPS_STEP)
+            return false;
+    }
+    while (!(fb < fa && fb <= fc));
+
+    /* Refine the minimum by the successive parabolic interpolation of
+     * sigma^2 (which is smooth and almost quadratic near a simple eigenvalue,
+     * unlike sigma itself).  If the interpolated point is outside of the
+     * bracket or if the bracket did not shrink to a half in the last two
+     * steps, the golden section step into the larger part of the bracket is
+     * made instead. */
+    for (k = 0U; k < max_steps && c - a > 2.0 * MPS_TOLERANCE * b; ++k)
+    {
+        /* Compute the vertex of the parabola through the three points. */
+        pa = (b - a) * (fb * fb - fc * fc);
+        pc = (b - c) * (fb * fb - fa * fa);
+        den = pa - pc;
+        u = (den == 0.0) ? a : b - 0.5 * ((b - a) * pa - (b - c) * pc) / den;
+
+        /* Fall back to the golden section step if needed. */
+        if (!(a < u && u < c) || 2.0 * (c - a) > w2)
+            u = (b - a > c - b) ? b - g * (b - a) : b + g * (c - b);
+        w2 = w1;
+        w1 = c - a;
+
+        /* Move the new point away from the best point if they are too close
+         * (the bracket then shrinks to the tolerance around the best point
+         * in at most two steps). */
+        if (rabs(u - b) < MPS_TOLERANCE * b)
+            u = (b - a > c - b) ? b - MPS_TOLERANCE * b : b + MPS_TOLERANCE * b;
+
+        /* Update the bracket. */
+        fu = mps_sigma(S, u);
+        if (fu == lambda)
+            return false;
+        if (fu < fb)
+        {
+            if (u < b)
+            {
+                c = b;
+                fc = fb;
+            }
+            else
+            {
+                a = b;
+                fa = fb;
+            }
+            b = u;
+            fb = fu;
+        }
+        else if (u < b)
+        {
+            a = u;
+            fa = fu;
+        }
+        else
+        {
+            c = u;
+            fc = fu;
+        }
+    }
+
+    /* Save the approximation and the error indicator. */
+    *ev = b;
+    *err = fb;
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Approximate the first eigenvalues on polygons described by a job.
+ *
+ * The function is intended to be started as a POSIX thread by the
+ * `mps_solve_batch` function.
+ *
+ * @param job
+ *     Pointer to the job (of type `mps_job_t`).
+ *
+ * @return
+ *     Null-pointer.
+ *
+ * @see mps_solve_batch
+ *
+ */
+#if !defined(__cplusplus)
+void* mps_job (void* job)
+#else
+inline void* mps_job (void* job)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Job. */
+    mps_job_t* J;
+
+    /* Workspace. */
+    mps_solver_t S;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Job. */
+    J = (mps_job_t*)job;
+
+    /* Workspace. */
+    memset(&S, 0, sizeof S);
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If there is no job, return the null-pointer. */
+    if (!J)
+        return NULL;
+
+    /* Allocate the workspace.  If the allocation failed, all polygons of the
+     * job fail. */
+    J->failed = 0U;
+    if (!mps_allocate(&S, J->n, J->p))
+    {
+        for (i = 0U; i < J->N; ++i)
+        {
+            *(J->E + (i << 1U)) = lambda;
+            *(J->E + (i << 1U) + 1U) = lambda;
+        }
+        J->failed = J->N;
+
+        return NULL;
+    }
+
+    /* Approximate the eigenvalues. */
+    for (i = 0U; i < J->N; ++i)
+        if (
+            !mps_eigenvalue(
+                &S,
+                J->P + ((i * J->n) << 1U),
+                J->E + (i << 1U),
+                J->E + (i << 1U) + 1U
+            )
+        )
+        {
+            *(J->E + (i << 1U)) = lambda;
+            *(J->E + (i << 1U) + 1U) = lambda;
+            ++J->failed;
+        }
+
+    /* Free the workspace. */
+    mps_free(&S);
+
+    /* Return the null-pointer. */
+    return NULL;
+}
+
+/**
+ * Approximate the first eigenvalues on polygons in parallel.
+ *
+ * Polygons are split into `T` contiguous groups of (almost) the same size and
+ * each group is solved in its own thread with its own workspace (the first
+ * group is solved in the calling thread), as in the `raster_polygons`
+ * function (see "raster.h").  If the memory for the jobs cannot be allocated
+ * or if a thread cannot be created, the polygons are solved in the calling
+ * thread.
+ *
+ * @param n
+ *     Number of vertices of each polygon (at least 3).
+ *
+ * @param N
+ *     Number of polygons.
+ *
+ * @param P
+ *     Array of polygons of size at least 2 * `n` * `N`.  Each polygon is
+ *     organised as in the `describe_polygon` function and the polygons are
+ *     stored one after another.
+ *
+ * @param p
+ *     Number of basis functions per vertex (if 0, `MPS_TERMS` is used).
+ *
+ * @param E
+ *     Array of size at least 2 * `N` to store the approximations of the first
+ *     eigenvalues and their error indicators (interleaved, in this order).
+ *     Both are set to `lambda` (the undefined real number, see "numeric.h")
+ *     for polygons on which the approximation could not be computed.
+ *
+ * @param T
+ *     Number of threads (if 0, a single thread is used).
+ *
+ * @return
+ *     Number of polygons on which the approximation could not be computed.
+ *
+ * @see mps_eigenvalue
+ * @see mps_job
+ *
+ */
+#if !defined(__cplusplus)
+size_t mps_solve_batch (
+    size_t n,
+    size_t N,
+    const real_t* P,
+    size_t p,
+    real_t* E,
+    size_t T
+)
+#else
+inline ::size_t mps_solve_batch (
+    ::size_t n,
+    ::size_t N,
+    const real_t* P,
+    ::size_t p,
+    real_t* E,
+    ::size_t T
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Single job (if the memory allocation fails). */
+    mps_job_t single;
+
+    /* Array of jobs. */
+    mps_job_t* jobs;
+
+    /* Array of threads. */
+    pthread_t* threads;
+
+    /* Array of indicators of successfully created threads. */
+    bool* created;
+
+    /* Number of polygons in the jobs so far and the number of failed
+     * polygons. */
+    size_t done;
+    size_t failed;
+
+    /* Iteration index. */
+    size_t t;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Single job. */
+    memset(&single, 0, sizeof single);
+
+    /* Array of jobs. */
+    jobs = (mps_job_t*)(NULL);
+
+    /* Array of threads. */
+    threads = (pthread_t*)(NULL);
+
+    /* Array of indicators of successfully created threads. */
+    created = (bool*)(NULL);
+
+    /* Number of polygons in the jobs so far and the number of failed
+     * polygons. */
+    done = 0U;
+    failed = 0U;
+
+    /* Iteration index. */
+    t = 0U;
+
+    /* ALGORITHM */
+
+    /* If the pointer `P` or the pointer `E` is a null-pointer, there is
+     * nothing to solve. */
+    if (!(P && E))
+        return N;
+
+    /* Use the default number of basis functions if needed. */
+    if (!p)
+        p = MPS_TERMS;
+
+    /* Use at least 1 and at most `N` threads. */
+    if (T > N)
+        T = N;
+    if (!T)
+        T = 1U;
+
+    /* Allocate memory for the jobs, the threads and the indicators. */
+#if !defined(__cplusplus)
+    jobs = (mps_job_t*)malloc(T * sizeof *jobs);
+    threads = (pthread_t*)malloc(T * sizeof *threads);
+    created = (bool*)malloc(T * sizeof *created);
+#else
+    jobs = static_cast<mps_job_t*>(::malloc(T * sizeof *jobs));
+    threads = static_cast<pthread_t*>(::malloc(T * sizeof *threads));
+    created = static_cast<bool*>(::malloc(T * sizeof *created));
+#endif /* __cplusplus */
+
+    /* If the memory allocation has failed, deallocate memory and solve all
+     * polygons in the calling thread. */
+    if (!(jobs && threads && created))
+    {
+        /* Deallocate memory for the jobs, the threads and the indicators. */
+        free(jobs);
+        jobs = (mps_job_t*)(NULL);
+        free(threads);
+        threads = (pthread_t*)(NULL);
+        free(created);
+        created = (bool*)(NULL);
+
+        /* Solve the polygons. */
+        single.n = n;
+        single.N = N;
+        single.p = p;
+        single.P = P;
+        single.E = E;
+        mps_job((void*)(&single));
+
+        /* Return the number of failed polygons. */
+        return single.failed;
+    }
+
+    /* Initialise the jobs. */
+    for (t = 0U; t < T; ++t)
+    {
+        (jobs + t)->n = n;
+        (jobs + t)->N = N / T + (t < N % T);
+        (jobs + t)->p = p;
+        (jobs + t)->P = P + ((done * n) << 1U);
+        (jobs + t)->E = E + (done << 1U);
+        (jobs + t)->failed = 0U;
+        *(created + t) = false;
+
+        done += (jobs + t)->N;
+    }
+
+    /* Start the threads for all jobs but the first one. */
+    for (t = 1U; t < T; ++t)
+        *(created + t) =
+            !pthread_create(threads + t, NULL, mps_job, (void*)(jobs + t));
+
+    /* Do the first job and the jobs whose threads could not be created in the
+     * calling thread. */
+    for (t = 0U; t < T; ++t)
+        if (!*(created + t))
+            mps_job((void*)(jobs + t));
+
+    /* Wait for the threads to finish and count the failed polygons. */
+    for (t = 0U; t < T; ++t)
+    {
+        if (t && *(created + t))
+            pthread_join(*(threads + t), NULL);
+        failed += (jobs + t)->failed;
+    }
+
+    /* Clear the memory in the array of jobs. */
+    memset(jobs, 0, T * sizeof *jobs);
+
+    /* Deallocate memory for the jobs, the threads and the indicators. */
+    free(jobs);
+    jobs = (mps_job_t*)(NULL);
+    free(threads);
+    threads = (pthread_t*)(NULL);
+    free(created);
+    created = (bool*)(NULL);
+
+    /* Return the number of failed polygons. */
+    return failed;
+}
+
+#endif /* __MPS_H__INCLUDED */
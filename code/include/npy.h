@@ -0,0 +1,1068 @@
+/**
+ * Functions for reading and writing NumPy arrays (".npy" files).
+ *
+ * Arrays are written with a preallocated header of a fixed length
+ * (`NPY_HEADER_LENGTH` bytes, a multiple of 64) so that the values may be
+ * streamed to the file before their number is known:  the function `npy_begin`
+ * reserves the header, the values are dumped by the function
+ * `npy_dump_polygons` (an alternative to the `dump_polygons` function from
+ * "polygon.h") and the function `npy_end` finally writes the header with the
+ * shape computed from the number of dumped values.  Values are written as
+ * little-endian `float32` (`<f4`) if `real_t` is `float` and as little-endian
+ * `float64` (`<f8`) otherwise.
+ *
+ * Arrays are read by mapping the file to memory (`mmap`) without copying it.
+ * Arrays of types `float32` and `float64` of any byte order in C order (and
+ * two-dimensional arrays in Fortran order, such as transposed arrays saved by
+ * NumPy) are supported; the reason why any other array is rejected is given by
+ * the function `npy_error_message`.  Values are converted to `real_t` as they
+ * are read by the function `npy_read` (and by the function `table_scan` from
+ * "table.h"); if the type of the values in the file is the same as `real_t` in
+ * the byte order of the host, the function `npy_values` gives direct access to
+ * the mapped values and they are read without conversion.
+ *
+ * The functions use POSIX functions `open`, `fstat`, `mmap`, `munmap` and
+ * `close`, so the macro `_POSIX_C_SOURCE` must be defined (as at least
+ * 200112L) before any standard header is included.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__NPY_H__INCLUDED) && (__NPY_H__INCLUDED) == 1)
+
+/* Undefine __NPY_H__INCLUDED if it has already been defined. */
+#if defined(__NPY_H__INCLUDED)
+#undef __NPY_H__INCLUDED
+#endif /* __NPY_H__INCLUDED */
+
+/* Define __NPY_H__INCLUDED as 1. */
+#define __NPY_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import POSIX headers. */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define constants. */
+
+/**
+ * Length of the preallocated header (the magic string, the version, the length
+ * of the dictionary and the dictionary) in bytes.
+ *
+ */
+#define NPY_HEADER_LENGTH 192U
+
+/**
+ * Type of values written to arrays and the size of a value in bytes.
+ *
+ */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define NPY_DESCR "<f4"
+#define NPY_VALUE_SIZE 4U
+#else
+#define NPY_DESCR "<f8"
+#define NPY_VALUE_SIZE 8U
+#endif /* _REAL_PRECISION */
+
+/**
+ * Values returned by the function `npy_open` if an array cannot be opened:
+ * the file cannot be opened or mapped, it is not a valid NumPy array, the type
+ * of its values is not supported, the order of its values is not supported or
+ * the memory for parsing its header cannot be allocated.
+ *
+ * @see npy_open
+ * @see npy_error_message
+ *
+ */
+#if defined(NPY_ERROR_FILE)
+#undef NPY_ERROR_FILE
+#endif /* NPY_ERROR_FILE */
+#define NPY_ERROR_FILE 1
+#if defined(NPY_ERROR_FORMAT)
+#undef NPY_ERROR_FORMAT
+#endif /* NPY_ERROR_FORMAT */
+#define NPY_ERROR_FORMAT 2
+#if defined(NPY_ERROR_DTYPE)
+#undef NPY_ERROR_DTYPE
+#endif /* NPY_ERROR_DTYPE */
+#define NPY_ERROR_DTYPE 3
+#if defined(NPY_ERROR_ORDER)
+#undef NPY_ERROR_ORDER
+#endif /* NPY_ERROR_ORDER */
+#define NPY_ERROR_ORDER 4
+#if defined(NPY_ERROR_MEMORY)
+#undef NPY_ERROR_MEMORY
+#endif /* NPY_ERROR_MEMORY */
+#define NPY_ERROR_MEMORY 5
+
+/* Define types. */
+
+/**
+ * Array mapped to memory.
+ *
+ */
+typedef struct npy_array_struct
+{
+    /* Mapped file. */
+    void* map;
+
+    /* Size of the mapped file in bytes. */
+    size_t length;
+
+    /* Pointer to the first value. */
+    const unsigned char* data;
+
+    /* Number of rows (the first dimension) and the number of values in each
+     * row (the product of the remaining dimensions). */
+    size_t rows;
+    size_t columns;
+
+    /* Size of a value in bytes (4 or 8). */
+    size_t size;
+
+    /* Indicator of the byte order different from the byte order of the
+     * host. */
+    bool swap;
+
+    /* Indicator of a two-dimensional array in Fortran order (the values are
+     * stored column by column). */
+    bool fortran;
+
+    /* Index of the next value to read. */
+    size_t position;
+}
+npy_array_t;
+
+/* Define functions. */
+
+/**
+ * Check if the host is little-endian.
+ *
+ * @return
+ *     Value `true` if the host stores numbers in the little-endian byte order,
+ *     value `false` otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+bool npy_little_endian (void)
+#else
+inline bool npy_little_endian ()
+#endif /* __cplusplus */
+{
+    /* Value 1. */
+    unsigned int one;
+
+    /* Initialise the value. */
+    one = 1U;
+
+    /* Return `true` if the first byte is the least significant byte. */
+    return *(unsigned char*)(&one) ? true : false;
+}
+
+/**
+ * Check if a path is a path to a NumPy array.
+ *
+ * @param path
+ *     Path to check.
+ *
+ * @return
+ *     Value `true` if `path` is not a null-pointer and ends with ".npy";
+ *     value `false` otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+bool npy_path (const char* path)
+#else
+inline bool npy_path (const char* path)
+#endif /* __cplusplus */
+{
+    /* Length of the path. */
+    size_t m;
+
+    /* Compute the length of the path. */
+    m = path ? strlen(path) : 0U;
+
+    /* Return `true` if the path ends with ".npy". */
+    return (m >= 4U && !strcmp(path + m - 4U, ".npy")) ? true : false;
+}
+
+/**
+ * Dump the header of a NumPy array to a file.
+ *
+ * The header is of length `NPY_HEADER_LENGTH` (the dictionary is padded by
+ * spaces).  The header is dumped at the current position in the file.
+ *
+ * @param out
+ *     Output file (opened in binary mode).
+ *
+ * @param descr
+ *     Description of the type of values (for instance, "<f8").
+ *
+ * @param d
+ *     Number of dimensions (at most 3).
+ *
+ * @param shape
+ *     Array of dimensions of size at least `d`.
+ *
+ * @return
+ *     Value 0 if the header was dumped successfully; a non-zero value
+ *     otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+int npy_dump_header (
+    FILE* out,
+    const char* descr,
+    size_t d,
+    const size_t* shape
+)
+#else
+inline int npy_dump_header (
+    ::FILE* out,
+    const char* descr,
+    ::size_t d,
+    const ::size_t* shape
+)
+#endif /* __cplusplus */
+{
+    /* Magic string and version of the ".npy" format. */
+    static const char magic[8U] = {
+        '\x93', 'N', 'U', 'M', 'P', 'Y', '\x01', '\x00'
+    };
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Header. */
+    char header[NPY_HEADER_LENGTH + 1U];
+
+    /* Length of the dictionary. */
+    size_t m;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Header. */
+    memset(header, 0, (NPY_HEADER_LENGTH + 1U) * sizeof *header);
+
+    /* Length of the dictionary. */
+    m = 0U;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, if the description is too long
+     * or if the number of dimensions is illegal, return a non-zero value. */
+    if (!(out && descr && shape && strlen(descr) <= 8U && d && d <= 3U))
+        return 1;
+
+    /* Copy the magic string and the version and set the length of the
+     * dictionary (little-endian). */
+    memcpy(header, magic, sizeof magic);
+    *(header + 8U) = (char)((NPY_HEADER_LENGTH - 10U) & 0xFFU);
+    *(header + 9U) = (char)(((NPY_HEADER_LENGTH - 10U) >> 8U) & 0xFFU);
+
+    /* Print the dictionary (each dimension has at most 20 digits, so the
+     * dictionary always fits in the header). */
+    m = 10U;
+    m += (size_t)sprintf(
+        header + m,
+        "{'descr': '%s', 'fortran_order': False, 'shape': (",
+        descr
+    );
+    for (i = 0U; i < d; ++i)
+        m += (size_t)sprintf(
+            header + m,
+            (d == 1U) ? "%lu," : (i ? ", %lu" : "%lu"),
+            (unsigned long)(*(shape + i))
+        );
+    m += (size_t)sprintf(header + m, "), }");
+
+    /* Pad the dictionary by spaces and end it with a new line. */
+    for (; m + 1U < NPY_HEADER_LENGTH; ++m)
+        *(header + m) = ' ';
+    *(header + m) = '\n';
+
+    /* Dump the header. */
+    return
+        (fwrite(header, sizeof *header, NPY_HEADER_LENGTH, out) ==
+            NPY_HEADER_LENGTH) ?
+            0 :
+            1;
+}
+
+/**
+ * Begin dumping an array to a file.
+ *
+ * The header of length `NPY_HEADER_LENGTH` is reserved at the current position
+ * in the file (which should be its beginning).  It is overwritten by the
+ * function `npy_end`.
+ *
+ * @param out
+ *     Output file (opened in binary mode).
+ *
+ * @return
+ *     Value 0 if the header was reserved successfully; a non-zero value
+ *     otherwise.
+ *
+ * @see npy_end
+ *
+ */
+#if !defined(__cplusplus)
+int npy_begin (FILE* out)
+#else
+inline int npy_begin (::FILE* out)
+#endif /* __cplusplus */
+{
+    /* Shape of an empty array. */
+    size_t shape;
+
+    /* Initialise the shape. */
+    shape = 0U;
+
+    /* Dump the header of an empty array. */
+    return npy_dump_header(out, NPY_DESCR, 1U, &shape);
+}
+
+/**
+ * Dump values to an array in a file.
+ *
+ * The values are converted to the type `NPY_DESCR` and dumped in the
+ * little-endian byte order through a small buffer.
+ *
+ * @param out
+ *     Output file (opened in binary mode, the header must have been reserved
+ *     by the function `npy_begin`).
+ *
+ * @param m
+ *     Number of values.
+ *
+ * @param x
+ *     Array of values of size at least `m`.
+ *
+ * @return
+ *     Number of values successfully dumped.
+ *
+ * @see npy_begin
+ * @see npy_dump_polygons
+ *
+ */
+#if !defined(__cplusplus)
+size_t npy_dump (FILE* out, size_t m, const real_t* x)
+#else
+inline ::size_t npy_dump (::FILE* out, ::size_t m, const real_t* x)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Buffer of converted values. */
+    unsigned char buffer[4096U];
+
+    /* Converted value. */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+    float value;
+#else
+    double value;
+#endif /* _REAL_PRECISION */
+
+    /* Indicator of the little-endian host. */
+    bool little;
+
+    /* Number of values in the buffer. */
+    size_t k;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t b;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Buffer of converted values. */
+    memset(buffer, 0, sizeof buffer);
+
+    /* Converted value. */
+    value = 0.0;
+
+    /* Indicator of the little-endian host. */
+    little = npy_little_endian();
+
+    /* Number of values in the buffer. */
+    k = 0U;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    b = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, there is nothing to dump. */
+    if (!(out && x))
+        return 0U;
+
+    /* Convert and dump the values through the buffer. */
+    for (i = 0U; i < m; i += k)
+    {
+        /* Compute the number of values in the buffer. */
+        k = sizeof buffer / NPY_VALUE_SIZE;
+        if (m - i < k)
+            k = m - i;
+
+        /* Convert the values to the little-endian byte order. */
+        for (j = 0U; j < k; ++j)
+        {
+            value = *(x + i + j);
+            for (b = 0U; b < NPY_VALUE_SIZE; ++b)
+                *(buffer + j * NPY_VALUE_SIZE + b) =
+                    *(
+                        (unsigned char*)(&value) +
+                            (little ? b : NPY_VALUE_SIZE - 1U - b)
+                    );
+        }
+
+        /* Dump the values. */
+        if (
+            fwrite(buffer, NPY_VALUE_SIZE, k, out) != k
+        )
+            break;
+    }
+
+    /* Return the number of values dumped. */
+    return (i < m) ? i : m;
+}
+
+/**
+ * Dump polygons to an array in a file.
+ *
+ * Each polygon is a row of the array.  The function is an alternative to the
+ * `dump_polygons` function from "polygon.h".
+ *
+ * @param out
+ *     Output file (opened in binary mode, the header must have been reserved
+ *     by the function `npy_begin`).
+ *
+ * @param n
+ *     Number of points in each set.
+ *
+ * @param P
+ *     Array of points of size at least `N` * 2 * `n` organised as in the
+ *     `dump_polygons` function.
+ *
+ * @param N
+ *     Number of polygons.
+ *
+ * @return
+ *     Value 0 if all values were dumped successfully; a non-zero value
+ *     otherwise.
+ *
+ * @see npy_dump
+ * @see dump_polygons
+ *
+ */
+#if !defined(__cplusplus)
+int npy_dump_polygons (FILE* out, size_t n, const real_t* P, size_t N)
+#else
+inline int npy_dump_polygons (
+    ::FILE* out,
+    ::size_t n,
+    const real_t* P,
+    ::size_t N
+)
+#endif /* __cplusplus */
+{
+    /* Dump the values and return 0 if all values were dumped. */
+    return (npy_dump(out, (N * n) << 1U, P) == ((N * n) << 1U)) ? 0 : 1;
+}
+
+/**
+ * End dumping an array to a file.
+ *
+ * The number of rows is computed from the number of values dumped after the
+ * header and the header is overwritten with the shape (rows, `columns`).  The
+ * position in the file is set to its end afterwards.
+ *
+ * @param out
+ *     Output file (opened in binary mode, the header must have been reserved
+ *     by the function `npy_begin` at the beginning of the file).
+ *
+ * @param columns
+ *     Number of values in each row (if 0, the array is one-dimensional).
+ *
+ * @return
+ *     Value 0 if the header was written successfully; a non-zero value
+ *     otherwise.
+ *
+ * @see npy_begin
+ *
+ */
+#if !defined(__cplusplus)
+int npy_end (FILE* out, size_t columns)
+#else
+inline int npy_end (::FILE* out, ::size_t columns)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Position in the file. */
+    long position;
+
+    /* Shape of the array. */
+    size_t shape[2U];
+
+    /* Value to return. */
+    int ret;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Position in the file. */
+    position = 0L;
+
+    /* Shape of the array. */
+    memset(shape, 0, 2U * sizeof *shape);
+
+    /* Value to return. */
+    ret = 1;
+
+    /* ALGORITHM */
+
+    /* If the pointer `out` is a null-pointer, return the non-zero value. */
+    if (!out)
+        return ret;
+
+    /* Find the end of the file. */
+    if (fseek(out, 0L, SEEK_END))
+        return ret;
+    position = ftell(out);
+    if (position < (long)(NPY_HEADER_LENGTH))
+        return ret;
+
+    /* Compute the shape of the array. */
+    *shape = ((size_t)position - NPY_HEADER_LENGTH) / NPY_VALUE_SIZE;
+    if (columns)
+    {
+        *(shape + 1U) = columns;
+        *shape /= columns;
+    }
+
+    /* Overwrite the header and return to the end of the file. */
+    if (fseek(out, 0L, SEEK_SET))
+        return ret;
+    ret = npy_dump_header(out, NPY_DESCR, columns ? 2U : 1U, shape);
+    if (fseek(out, 0L, SEEK_END))
+        ret = 1;
+
+    /* Return the value. */
+    return ret;
+}
+
+/**
+ * Open an array by mapping a file to memory.
+ *
+ * The header is parsed and the array is prepared for reading from its first
+ * value.  Only arrays of types `float32` and `float64` in C order, and
+ * one-dimensional and two-dimensional arrays of these types in Fortran order
+ * (as NumPy saves transposed arrays), are supported.
+ *
+ * @param path
+ *     Path to the file.
+ *
+ * @param A
+ *     Pointer to the array to open.
+ *
+ * @return
+ *     Value 0 if the array was opened successfully; otherwise one of the
+ *     values `NPY_ERROR_FILE`, `NPY_ERROR_FORMAT`, `NPY_ERROR_DTYPE`,
+ *     `NPY_ERROR_ORDER` and `NPY_ERROR_MEMORY` (in which case nothing remains
+ *     mapped).
+ *
+ * @see npy_close
+ * @see npy_error_message
+ *
+ */
+#if !defined(__cplusplus)
+int npy_open (const char* path, npy_array_t* A)
+#else
+inline int npy_open (const char* path, npy_array_t* A)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* File descriptor. */
+    int fd;
+
+    /* Information about the file. */
+    struct stat info;
+
+    /* Mapped bytes. */
+    const unsigned char* bytes;
+
+    /* Header (the dictionary terminated by the null-character). */
+    char* header;
+
+    /* Length of the header (the dictionary) and the offset of the values. */
+    size_t m;
+    size_t offset;
+
+    /* Pointers to parts of the header. */
+    const char* descr;
+    const char* shape;
+    char* end;
+
+    /* Number of dimensions and the current dimension. */
+    size_t d;
+    unsigned long dim;
+
+    /* Error of the parsing (0 on success). */
+    int error;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* File descriptor. */
+    fd = -1;
+
+    /* Information about the file. */
+    memset(&info, 0, sizeof info);
+
+    /* Mapped bytes. */
+    bytes = (const unsigned char*)(NULL);
+
+    /* Header. */
+    header = (char*)(NULL);
+
+    /* Length of the header and the offset of the values. */
+    m = 0U;
+    offset = 0U;
+
+    /* Pointers to parts of the header. */
+    descr = (const char*)(NULL);
+    shape = (const char*)(NULL);
+    end = (char*)(NULL);
+
+    /* Number of dimensions and the current dimension. */
+    d = 0U;
+    dim = 0UL;
+
+    /* Error of the parsing. */
+    error = NPY_ERROR_FORMAT;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, return a non-zero value. */
+    if (!(path && A))
+        return NPY_ERROR_FILE;
+
+    /* Initialise the array. */
+    memset(A, 0, sizeof *A);
+
+    /* Open the file and find its size.  If the file is smaller than the
+     * smallest possible header, return a non-zero value. */
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NPY_ERROR_FILE;
+    if (fstat(fd, &info))
+    {
+        close(fd);
+
+        return NPY_ERROR_FILE;
+    }
+    if (info.st_size < 16)
+    {
+        close(fd);
+
+        return NPY_ERROR_FORMAT;
+    }
+    A->length = (size_t)info.st_size;
+
+    /* Map the file to memory (the mapping remains valid after the file
+     * descriptor is closed). */
+    A->map = mmap(NULL, A->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    fd = -1;
+    if (A->map == MAP_FAILED)
+    {
+        memset(A, 0, sizeof *A);
+
+        return NPY_ERROR_FILE;
+    }
+    bytes = (const unsigned char*)(A->map);
+
+    /* To avoid using the `goto` command and additional `return` commands, the
+     * parsing is enclosed in a `do while`-loop with a false terminating
+     * statement. */
+    do
+    {
+        /* Check the magic string and find the length of the header (2 bytes
+         * in version 1, 4 bytes in versions 2 and 3). */
+        if (memcmp(bytes, "\x93NUMPY", 6U))
+            break;
+        if (*(bytes + 6U) == 1U)
+        {
+            m = (size_t)(*(bytes + 8U)) | ((size_t)(*(bytes + 9U)) << 8U);
+            offset = 10U;
+        }
+        else if (*(bytes + 6U) == 2U || *(bytes + 6U) == 3U)
+        {
+            m =
+                (size_t)(*(bytes + 8U)) |
+                ((size_t)(*(bytes + 9U)) << 8U) |
+                ((size_t)(*(bytes + 10U)) << 16U) |
+                ((size_t)(*(bytes + 11U)) << 24U);
+            offset = 12U;
+        }
+        else
+            break;
+        if (offset + m > A->length)
+            break;
+
+        /* Copy the header to a null-terminated string. */
+        header = (char*)malloc((m + 1U) * sizeof *header);
+        if (!header)
+        {
+            error = NPY_ERROR_MEMORY;
+
+            break;
+        }
+        memcpy(header, bytes + offset, m);
+        *(header + m) = '\0';
+        offset += m;
+
+        /* Parse the type of values. */
+        descr = strstr(header, "'descr'");
+        if (!descr)
+            break;
+        descr = strchr(descr + 7U, '\'');
+        if (!descr)
+            break;
+        ++descr;
+        error = NPY_ERROR_DTYPE;
+        if (*descr == '>')
+            A->swap = npy_little_endian();
+        else if (*descr == '=' || *descr == '|')
+            A->swap = false;
+        else if (*descr == '<')
+            A->swap = !npy_little_endian();
+        else
+            break;
+        if (!strncmp(descr + 1U, "f4'", 3U))
+            A->size = 4U;
+        else if (!strncmp(descr + 1U, "f8'", 3U))
+            A->size = 8U;
+        else
+            break;
+        error = NPY_ERROR_FORMAT;
+
+        /* Parse the shape. */
+        shape = strstr(header, "'shape'");
+        if (!shape)
+            break;
+        shape = strchr(shape, '(');
+        if (!shape)
+            break;
+        ++shape;
+        A->rows = 1U;
+        A->columns = 1U;
+        for (d = 0U; ; ++d)
+        {
+            while (*shape == ' ' || *shape == ',')
+                ++shape;
+            if (*shape == ')')
+                break;
+            dim = strtoul(shape, &end, 10);
+            if (end == shape)
+                break;
+            shape = end;
+            if (d)
+                A->columns *= (size_t)dim;
+            else
+                A->rows = (size_t)dim;
+        }
+        if (*shape != ')')
+            break;
+
+        /* Arrays of more than two dimensions must be in C order.  The order
+         * of a two-dimensional array of a single row or a single column does
+         * not matter. */
+        if (strstr(header, "'fortran_order': True") && d > 1U)
+        {
+            error = NPY_ERROR_ORDER;
+            if (d > 2U)
+                break;
+            A->fortran = (A->rows > 1U && A->columns > 1U);
+            error = NPY_ERROR_FORMAT;
+        }
+
+        /* Check that the file contains all the values. */
+        if (offset + A->rows * A->columns * A->size > A->length)
+            break;
+
+        /* Set the pointer to the first value. */
+        A->data = bytes + offset;
+
+        /* The array was parsed successfully. */
+        error = 0;
+    }
+    while (false);
+
+    /* Deallocate memory for the header. */
+    free(header);
+    header = (char*)(NULL);
+
+    /* If the parsing has failed, unmap the file and return the error. */
+    if (error)
+    {
+        munmap(A->map, A->length);
+        memset(A, 0, sizeof *A);
+
+        return error;
+    }
+
+    /* Return 0. */
+    return 0;
+}
+
+/**
+ * Describe the error of opening an array.
+ *
+ * @param error
+ *     Value returned by the function `npy_open`.
+ *
+ * @return
+ *     Message describing the error (the null-pointer if `error` is 0).
+ *
+ * @see npy_open
+ *
+ */
+#if !defined(__cplusplus)
+const char* npy_error_message (int error)
+#else
+inline const char* npy_error_message (int error)
+#endif /* __cplusplus */
+{
+    /* Return the message of the error. */
+    switch (error)
+    {
+        case 0:
+            return (const char*)(NULL);
+        case NPY_ERROR_FILE:
+            return "NumPy array cannot be opened or mapped to memory.";
+        case NPY_ERROR_DTYPE:
+            return
+                "Unsupported dtype of a NumPy array (only float32 and "
+                    "float64 are supported).";
+        case NPY_ERROR_ORDER:
+            return
+                "Unsupported fortran_order of a NumPy array (only arrays of "
+                    "at most two dimensions may be in Fortran order).";
+        case NPY_ERROR_MEMORY:
+            return "Memory allocation fail while parsing a NumPy array.";
+        default:
+            return "File is not a valid NumPy array.";
+    }
+}
+
+/**
+ * Access the values of an array directly.
+ *
+ * @param A
+ *     Pointer to the array opened by the function `npy_open`.
+ *
+ * @return
+ *     Pointer to the mapped values if they are of the type `real_t` in the
+ *     byte order of the host (and aligned for the type `real_t`) in C order;
+ *     otherwise the null-pointer.
+ *
+ */
+#if !defined(__cplusplus)
+const real_t* npy_values (const npy_array_t* A)
+#else
+inline const real_t* npy_values (const npy_array_t* A)
+#endif /* __cplusplus */
+{
+    /* Return the pointer to the values if they are of the type `real_t`. */
+    return (
+        A &&
+        A->data &&
+        !A->swap &&
+        !A->fortran &&
+        A->size == sizeof(real_t) &&
+        !((size_t)(A->data) % sizeof(real_t))
+    ) ?
+        (const real_t*)(A->data) :
+        (const real_t*)(NULL);
+}
+
+/**
+ * Read values from an array.
+ *
+ * The values are read from the current position in the array, converted to
+ * `real_t` and the position is moved forward.  If the values are accessible
+ * directly (see the function `npy_values`), they are copied in a single block
+ * without conversion.  Values of an array in Fortran order are read row by
+ * row as well.
+ *
+ * @param A
+ *     Pointer to the array opened by the function `npy_open`.
+ *
+ * @param m
+ *     Number of values to read.
+ *
+ * @param x
+ *     Array of size at least `m` to store the values.
+ *
+ * @return
+ *     Number of values read (less than `m` if the end of the array has been
+ *     reached).
+ *
+ * @see npy_open
+ *
+ */
+#if !defined(__cplusplus)
+size_t npy_read (npy_array_t* A, size_t m, real_t* x)
+#else
+inline ::size_t npy_read (npy_array_t* A, ::size_t m, real_t* x)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Bytes of the current value. */
+    unsigned char value[8U];
+
+    /* Values of types `float32` and `float64`. */
+    float f;
+    double g;
+
+    /* Pointer to the current value in the array. */
+    const unsigned char* v;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t b;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Bytes of the current value. */
+    memset(value, 0, sizeof value);
+
+    /* Values of types `float32` and `float64`. */
+    f = 0.0F;
+    g = 0.0;
+
+    /* Pointer to the current value in the array. */
+    v = (const unsigned char*)(NULL);
+
+    /* Iteration indices. */
+    i = 0U;
+    b = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, there is nothing to read. */
+    if (!(A && A->data && x))
+        return 0U;
+
+    /* Read at most the remaining values. */
+    if (m > A->rows * A->columns - A->position)
+        m = A->rows * A->columns - A->position;
+
+    /* Copy the values directly if they need no conversion. */
+    if (npy_values(A))
+    {
+        memcpy(x, npy_values(A) + A->position, m * sizeof *x);
+        A->position += m;
+
+        return m;
+    }
+
+    /* Read and convert the values. */
+    for (i = 0U; i < m; ++i)
+    {
+        /* Copy the bytes of the value in the byte order of the host. */
+        v =
+            A->data +
+            (
+                A->fortran ?
+                    ((A->position + i) % A->columns) * A->rows +
+                        (A->position + i) / A->columns :
+                    A->position + i
+            ) * A->size;
+        for (b = 0U; b < A->size; ++b)
+            *(value + b) = *(v + (A->swap ? A->size - 1U - b : b));
+
+        /* Convert the value. */
+        if (A->size == 4U)
+        {
+            memcpy(&f, value, sizeof f);
+            *(x + i) = (real_t)f;
+        }
+        else
+        {
+            memcpy(&g, value, sizeof g);
+            *(x + i) = (real_t)g;
+        }
+    }
+
+    /* Move the position. */
+    A->position += m;
+
+    /* Return the number of values read. */
+    return m;
+}
+
+/**
+ * Close an array mapped to memory.
+ *
+ * @param A
+ *     Pointer to the array opened by the function `npy_open`.
+ *
+ * @see npy_open
+ *
+ */
+#if !defined(__cplusplus)
+void npy_close (npy_array_t* A)
+#else
+inline void npy_close (npy_array_t* A)
+#endif /* __cplusplus */
+{
+    /* Unmap the file and reset the array. */
+    if (A)
+    {
+        if (A->map)
+            munmap(A->map, A->length);
+        memset(A, 0, sizeof *A);
+    }
+}
+
+#endif /* __NPY_H__INCLUDED */
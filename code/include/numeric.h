@@ -63,15 +63,138 @@ using   sign_t  =   enum
 };
 #endif /* __cplusplus */
 
+/* Define precisions of real numbers. */
+
+/* Check if the macro _REAL_FLOAT is properly defined. */
+#if !(defined(_REAL_FLOAT) && (_REAL_FLOAT) == 1)
+
+/* If the macro _REAL_FLOAT has been defined unproperly, undefine it. */
+#if defined(_REAL_FLOAT)
+#undef _REAL_FLOAT
+#endif /* _REAL_FLOAT */
+
+/* Define the macro _REAL_FLOAT as 1. */
+#define _REAL_FLOAT 1
+
+#endif /* _REAL_FLOAT */
+
+/* Check if the macro _REAL_DOUBLE is properly defined. */
+#if !(defined(_REAL_DOUBLE) && (_REAL_DOUBLE) == 2)
+
+/* If the macro _REAL_DOUBLE has been defined unproperly, undefine it. */
+#if defined(_REAL_DOUBLE)
+#undef _REAL_DOUBLE
+#endif /* _REAL_DOUBLE */
+
+/* Define the macro _REAL_DOUBLE as 2. */
+#define _REAL_DOUBLE 2
+
+#endif /* _REAL_DOUBLE */
+
+/* Check if the macro _REAL_LONG_DOUBLE is properly defined. */
+#if !(defined(_REAL_LONG_DOUBLE) && (_REAL_LONG_DOUBLE) == 3)
+
+/* If the macro _REAL_LONG_DOUBLE has been defined unproperly, undefine it. */
+#if defined(_REAL_LONG_DOUBLE)
+#undef _REAL_LONG_DOUBLE
+#endif /* _REAL_LONG_DOUBLE */
+
+/* Define the macro _REAL_LONG_DOUBLE as 3. */
+#define _REAL_LONG_DOUBLE 3
+
+#endif /* _REAL_LONG_DOUBLE */
+
+/* If the precision of real numbers has not been chosen (for instance by
+ * compiling with "-D_REAL_PRECISION=1"), or if it has been chosen unproperly,
+ * use `double`. */
+#if !( \
+    defined(_REAL_PRECISION) && \
+    ( \
+        (_REAL_PRECISION) == (_REAL_FLOAT) || \
+        (_REAL_PRECISION) == (_REAL_DOUBLE) || \
+        (_REAL_PRECISION) == (_REAL_LONG_DOUBLE) \
+    ) \
+)
+#if defined(_REAL_PRECISION)
+#undef _REAL_PRECISION
+#endif /* _REAL_PRECISION */
+#define _REAL_PRECISION _REAL_DOUBLE
+#endif /* _REAL_PRECISION */
+
 /**
  * Floating point type for representing real numbers.
  *
+ * The type is `float` if `_REAL_PRECISION` is `_REAL_FLOAT`, `long double` if
+ * `_REAL_PRECISION` is `_REAL_LONG_DOUBLE` and `double` otherwise.
+ *
  */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+typedef float   real_t;
+#else
+using   real_t  =   float;
+#endif /* __cplusplus */
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+typedef long double real_t;
+#else
+using   real_t  =   long double;
+#endif /* __cplusplus */
+#else
 #if !defined(__cplusplus) || (__cplusplus) < 201103L
 typedef double  real_t;
 #else
 using   real_t  =   double;
 #endif /* __cplusplus */
+#endif /* _REAL_PRECISION */
+
+/**
+ * Floating point type of the arguments of the mathematical functions used for
+ * `real_t` in C.
+ *
+ * C89 provides the mathematical functions only for `double`.  Since C99 the
+ * functions for `float` (sqrtf, acosf...) and `long double` (sqrtl, acosl...)
+ * are used instead.  The macro `_REAL_MATH(name)` expands to the name of the
+ * function `name` for `real_math_t`.
+ *
+ */
+#if !defined(__cplusplus)
+#if defined(_REAL_MATH)
+#undef _REAL_MATH
+#endif /* _REAL_MATH */
+#if ( \
+    defined(__STDC_VERSION__) && (__STDC_VERSION__) >= 199901L && \
+    (_REAL_PRECISION) == (_REAL_FLOAT) \
+)
+typedef float real_math_t;
+#define _REAL_MATH(name) name ## f
+#elif ( \
+    defined(__STDC_VERSION__) && (__STDC_VERSION__) >= 199901L && \
+    (_REAL_PRECISION) == (_REAL_LONG_DOUBLE) \
+)
+typedef long double real_math_t;
+#define _REAL_MATH(name) name ## l
+#else
+typedef double real_math_t;
+#define _REAL_MATH(name) name
+#endif /* __STDC_VERSION__, _REAL_PRECISION */
+#endif /* __cplusplus */
+
+/**
+ * Format string for reading a `real_t` value using the `scanf` family of
+ * functions.
+ *
+ */
+#if defined(REAL_FORMAT_INPUT)
+#undef REAL_FORMAT_INPUT
+#endif /* REAL_FORMAT_INPUT */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define REAL_FORMAT_INPUT " %f"
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#define REAL_FORMAT_INPUT " %Lf"
+#else
+#define REAL_FORMAT_INPUT " %lf"
+#endif /* _REAL_PRECISION */
 
 /* Define constants. */
 
@@ -79,21 +202,78 @@ using   real_t  =   double;
  * Undefined real number (maximal value of `real_t`).
  *
  */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  lambda  =   FLT_MAX;
+#else
+constexpr   const   real_t  lambda  =   FLT_MAX;
+#endif /* __cplusplus */
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  lambda  =   LDBL_MAX;
+#else
+constexpr   const   real_t  lambda  =   LDBL_MAX;
+#endif /* __cplusplus */
+#else
 #if !defined(__cplusplus) || (__cplusplus) < 201103L
 const   real_t  lambda  =   DBL_MAX;
 #else
 constexpr   const   real_t  lambda  =   DBL_MAX;
 #endif /* __cplusplus */
+#endif /* _REAL_PRECISION */
 
 /**
  * Minimal real number (minimal absolute value of `real_t`).
  *
  */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  epsilon =   FLT_MIN;
+#else
+constexpr   const   real_t  epsilon =   FLT_MIN;
+#endif /* __cplusplus */
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  epsilon =   LDBL_MIN;
+#else
+constexpr   const   real_t  epsilon =   LDBL_MIN;
+#endif /* __cplusplus */
+#else
 #if !defined(__cplusplus) || (__cplusplus) < 201103L
 const   real_t  epsilon =   DBL_MIN;
 #else
 constexpr   const   real_t  epsilon =   DBL_MIN;
 #endif /* __cplusplus */
+#endif /* _REAL_PRECISION */
+
+/**
+ * Relative tolerance of computations in `real_t`.
+ *
+ * The tolerance is 2^6 machine epsilons of `real_t` (approximately 7.6e-6 for
+ * `float`, 1.4e-14 for `double` and 6.9e-18 for `long double` on x87).  It is
+ * meant for comparing results of a chain of a few dozen operations, for
+ * instance the results of the same computation in different precisions.
+ *
+ */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  tolerance   =   64.0 * FLT_EPSILON;
+#else
+constexpr   const   real_t  tolerance   =   64.0 * FLT_EPSILON;
+#endif /* __cplusplus */
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  tolerance   =   64.0 * LDBL_EPSILON;
+#else
+constexpr   const   real_t  tolerance   =   64.0 * LDBL_EPSILON;
+#endif /* __cplusplus */
+#else
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  tolerance   =   64.0 * DBL_EPSILON;
+#else
+constexpr   const   real_t  tolerance   =   64.0 * DBL_EPSILON;
+#endif /* __cplusplus */
+#endif /* _REAL_PRECISION */
 
 /* Define functions. */
 
@@ -275,9 +455,36 @@ inline real_t rsqrt (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (x == 0.0) ? 0.0 : (real_t)sqrt((double)x);
+    return (x == 0.0) ? 0.0 : (real_t)_REAL_MATH(sqrt)((real_math_t)x);
 #else
-    return (x == 0.0) ? 0.0 : static_cast<real_t>(::sqrt(x));
+    return (x == 0.0) ? 0.0 : static_cast<real_t>(::std::sqrt(x));
+#endif /* __cplusplus */
+}
+
+/**
+ * Get the floor of a real number.
+ *
+ * The value is computed using the `floor` function from the standard library.
+ *
+ * @param x
+ *     Real number.
+ *
+ * @return
+ *     The greatest integer value not greater than `x`.
+ *
+ * @see floor
+ *
+ */
+#if !defined(__cplusplus)
+real_t rfloor (real_t x)
+#else
+inline real_t rfloor (real_t x)
+#endif /* __cplusplus */
+{
+#if !defined(__cplusplus)
+    return (real_t)_REAL_MATH(floor)((real_math_t)x);
+#else
+    return static_cast<real_t>(::std::floor(x));
 #endif /* __cplusplus */
 }
 
@@ -307,11 +514,11 @@ inline real_t rpow (real_t base, real_t exponent)
 #if !defined(__cplusplus)
     return (base == 0.0 && 0.0 < exponent) ?
         0.0 :
-        (real_t)pow((double)base, (double)exponent);
+        (real_t)_REAL_MATH(pow)((real_math_t)base, (real_math_t)exponent);
 #else
     return (base == 0.0 && 0.0 < exponent) ?
         0.0 :
-        static_cast<real_t>(::pow(base, exponent));
+        static_cast<real_t>(::std::pow(base, exponent));
 #endif /* __cplusplus */
 }
 
@@ -336,9 +543,9 @@ inline real_t rexp (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (real_t)exp((double)x);
+    return (real_t)_REAL_MATH(exp)((real_math_t)x);
 #else
-    return static_cast<real_t>(::exp(x));
+    return static_cast<real_t>(::std::exp(x));
 #endif /* __cplusplus */
 }
 
@@ -363,9 +570,9 @@ inline real_t rlog (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (real_t)log((double)x);
+    return (real_t)_REAL_MATH(log)((real_math_t)x);
 #else
-    return static_cast<real_t>(::log(x));
+    return static_cast<real_t>(::std::log(x));
 #endif /* __cplusplus */
 }
 
@@ -390,9 +597,9 @@ inline real_t rlog10 (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (real_t)log10((double)x);
+    return (real_t)_REAL_MATH(log10)((real_math_t)x);
 #else
-    return static_cast<real_t>(::log10(x));
+    return static_cast<real_t>(::std::log10(x));
 #endif /* __cplusplus */
 }
 
@@ -417,9 +624,9 @@ inline real_t rsin (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (x == 0.0) ? 0.0 : (real_t)sin((double)x);
+    return (x == 0.0) ? 0.0 : (real_t)_REAL_MATH(sin)((real_math_t)x);
 #else
-    return (x == 0.0) ? 0.0 : static_cast<real_t>(::sin(x));
+    return (x == 0.0) ? 0.0 : static_cast<real_t>(::std::sin(x));
 #endif /* __cplusplus */
 }
 
@@ -444,9 +651,9 @@ inline real_t rcos (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (real_t)cos((double)x);
+    return (real_t)_REAL_MATH(cos)((real_math_t)x);
 #else
-    return static_cast<real_t>(::cos(x));
+    return static_cast<real_t>(::std::cos(x));
 #endif /* __cplusplus */
 }
 
@@ -471,9 +678,9 @@ inline real_t rtan (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (x == 0.0) ? 0.0 : (real_t)tan((double)x);
+    return (x == 0.0) ? 0.0 : (real_t)_REAL_MATH(tan)((real_math_t)x);
 #else
-    return (x == 0.0) ? 0.0 : static_cast<real_t>(::tan(x));
+    return (x == 0.0) ? 0.0 : static_cast<real_t>(::std::tan(x));
 #endif /* __cplusplus */
 }
 
@@ -498,9 +705,9 @@ inline real_t rasin (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (x == 0.0) ? 0.0 : (real_t)asin((double)x);
+    return (x == 0.0) ? 0.0 : (real_t)_REAL_MATH(asin)((real_math_t)x);
 #else
-    return (x == 0.0) ? 0.0 : static_cast<real_t>(::asin(x));
+    return (x == 0.0) ? 0.0 : static_cast<real_t>(::std::asin(x));
 #endif /* __cplusplus */
 }
 
@@ -525,9 +732,9 @@ inline real_t racos (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (real_t)acos((double)x);
+    return (real_t)_REAL_MATH(acos)((real_math_t)x);
 #else
-    return static_cast<real_t>(::acos(x));
+    return static_cast<real_t>(::std::acos(x));
 #endif /* __cplusplus */
 }
 
@@ -552,9 +759,9 @@ inline real_t ratan (real_t x)
 #endif /* __cplusplus */
 {
 #if !defined(__cplusplus)
-    return (x == 0.0) ? 0.0 : (real_t)atan((double)x);
+    return (x == 0.0) ? 0.0 : (real_t)_REAL_MATH(atan)((real_math_t)x);
 #else
-    return (x == 0.0) ? 0.0 : static_cast<real_t>(::atan(x));
+    return (x == 0.0) ? 0.0 : static_cast<real_t>(::std::atan(x));
 #endif /* __cplusplus */
 }
 
@@ -586,9 +793,11 @@ inline real_t ratan2 (real_t x, real_t y)
 #if !defined(__cplusplus)
     return (y == 0.0 && !(x == 0.0)) ?
         0.0 :
-        (real_t)atan2((double)x, (double)y);
+        (real_t)_REAL_MATH(atan2)((real_math_t)x, (real_math_t)y);
 #else
-    return (x == 0.0 && !(x == 0.0)) ? 0.0 : static_cast<real_t>(::atan2(x, y));
+    return (y == 0.0 && !(x == 0.0)) ?
+        0.0 :
+        static_cast<real_t>(::std::atan2(x, y));
 #endif /* __cplusplus */
 }
 
@@ -585,7 +585,7 @@ real_t scan_coordinate (::size_t i, ::size_t coordinate)
     static const char undef = '?';
 
     /* Format for the input. */
-    static const char* const format_input = " %lf";
+    static const char* const format_input = REAL_FORMAT_INPUT;
 
 #else
 
@@ -1181,7 +1181,7 @@ int display_polygons (::size_t n, const real_t* P, ::size_t N)
                 format,
                     (int)coordinate_length_,
                     (int)prec,
-                    *(P + j)
+                    (double)(*(P + j))
             );
 #else
             command << inner_delim << *(P + j);
@@ -1210,7 +1210,7 @@ int display_polygons (::size_t n, const real_t* P, ::size_t N)
                     format,
                         (int)coordinate_length_,
                         (int)prec,
-                        *(P + ((i * n) << 1U) + j)
+                        (double)(*(P + ((i * n) << 1U) + j))
                 );
 #else
                 command << inner_delim << *(P + ((i * n) << 1U) + j);
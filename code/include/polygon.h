@@ -53,6 +53,7 @@
 #include "array.h"
 #include "boolean.h"
 #include "numeric.h"
+#include "predicate.h"
 
 /* Check if the macro _DGESVD_DRIVER is properly defined. */
 #if !(defined(_DGESVD_DRIVER) && (_DGESVD_DRIVER) == 1)
@@ -80,43 +81,72 @@
 
 #endif /* _DGESDD_DRIVER */
 
-/* Import the SVD driver. */
+/* LAPACK provides SVD drivers only for `float` (SGESVD, SGESDD) and `double`
+ * (DGESVD, DGESDD), therefore SVD drivers may not be used for `long double`. */
+#if defined(_USE_SVD_DRIVER) && (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#error "SVD drivers are not available for real numbers of type long double."
+#endif /* _USE_SVD_DRIVER, _REAL_PRECISION */
+
+/* Define names of the SVD drivers for the type `real_t`. */
+#if defined(_SVD_GESVD)
+#undef _SVD_GESVD
+#endif /* _SVD_GESVD */
+#if defined(_SVD_GESDD)
+#undef _SVD_GESDD
+#endif /* _SVD_GESDD */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define _SVD_GESVD sgesvd_
+#define _SVD_GESDD sgesdd_
+#else
+#define _SVD_GESVD dgesvd_
+#define _SVD_GESDD dgesdd_
+#endif /* _REAL_PRECISION */
+
+/* Import the SVD driver.  In C++ the driver must be declared with the C
+ * linkage. */
 #if defined(_USE_SVD_DRIVER)
+#if defined(__cplusplus)
+extern "C"
+{
+#endif /* __cplusplus */
 #if (_USE_SVD_DRIVER) == (_DGESVD_DRIVER)
-extern void dgesvd_ (
+extern void _SVD_GESVD (
     char* JOBU,
     char* JOBVT,
     int* M,
     int* N,
-    double* A,
+    real_t* A,
     int* LDA,
-    double* S,
-    double* U,
+    real_t* S,
+    real_t* U,
     int* LDU,
-    double* VT,
+    real_t* VT,
     int* LDVT,
-    double* WORK,
+    real_t* WORK,
     int* LWORK,
     int* INFO
 );
 #elif (_USE_SVD_DRIVER) == (_DGESDD_DRIVER)
-extern void dgesdd_ (
+extern void _SVD_GESDD (
     char* JOBZ,
     int* M,
     int* N,
-    double* A,
+    real_t* A,
     int* LDA,
-    double* S,
-    double* U,
+    real_t* S,
+    real_t* U,
     int* LDU,
-    double* VT,
+    real_t* VT,
     int* LDVT,
-    double* WORK,
+    real_t* WORK,
     int* LWORK,
     int* IWORK,
     int* INFO
 );
 #endif /* _USE_SVD_DRIVER */
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
 #endif /* _USE_SVD_DRIVER */
 
 /**
@@ -357,18 +387,6 @@ real_t* smart_random_polygon (
     real_t* x_j1;
     real_t* y_j1;
 
-    /* Differences in coordinates. */
-    real_t dx_i;
-    real_t dy_i;
-    real_t dx_j;
-    real_t dy_j;
-
-    /* Signs of expressions of lines evaluated at certain points. */
-    sign_t s_i0;
-    sign_t s_i1;
-    sign_t s_j0;
-    sign_t s_j1;
-
     /* INITIALISATION OF VARIABLES */
 
     /* Flags for checking if the given pointer is a null-pointer and for
@@ -411,25 +429,6 @@ real_t* smart_random_polygon (
     y_j1 = nullptr;
 #endif /* __cplusplus */
 
-    /* Differences in coordinates. */
-    dx_i = 0.0;
-    dy_i = 0.0;
-    dx_j = 0.0;
-    dy_j = 0.0;
-
-    /* Signs of expressions of lines evaluated at certain points. */
-#if !defined(__cplusplus) || (__cplusplus) < 201103L
-    s_i0 = zero;
-    s_i1 = zero;
-    s_j0 = zero;
-    s_j1 = zero;
-#else
-    s_i0 = sign_t::zero;
-    s_j1 = sign_t::zero;
-    s_i0 = sign_t::zero;
-    s_j1 = sign_t::zero;
-#endif /* __cplusplus */
-
     /* ALGORITHM */
 
     /* If the given pointer `P` is a null-pointer, set the flag for checking it
@@ -553,11 +552,6 @@ real_t* smart_random_polygon (
                     *x_i1 = (*generator)(i, 0U);
                     *y_i1 = (*generator)(i, 1U);
 
-                    /* Compute the differences in coordinates of points P_i0 and
-                     * P_i1. */
-                    dx_i = *x_i1 - *x_i0;
-                    dy_i = *y_i1 - *y_i0;
-
                     /* Iterate over all the previous points and check if any
                      * edge intersects with the line segment P_i0 P_i1. */
                     for (j = 0U; j + 1U < i; ++j)
@@ -580,71 +574,13 @@ real_t* smart_random_polygon (
                         )
                             break;
 
-                        /* Compute the differences in coordinates of points P_j0
-                         * and P_j1. */
-                        dx_j = *x_j1 - *x_j0;
-                        dy_j = *y_j1 - *y_j0;
-
-                        /* Compute the signs of expressions of the line
-                         * P_j0 P_j1 evaluated at points P_i0 and P_i1, and of
-                         * the line P_i0 P_i1 evaluated at points P_j0 and
-                         * P_j1. */
-                        s_i0 = rsign(
-                            dx_j * (*y_i0 - *y_j0) - dy_j * (*x_i0 - *x_j0)
-                        );
-                        s_i1 = rsign(
-                            dx_j * (*y_i1 - *y_j0) - dy_j * (*x_i1 - *x_j0)
-                        );
-                        s_j0 = rsign(
-                            dx_i * (*y_j0 - *y_i0) - dy_i * (*x_j0 - *x_i0)
-                        );
-                        s_j1 = rsign(
-                            dx_i * (*y_j1 - *y_i0) - dy_i * (*x_j1 - *x_i0)
-                        );
-
-                        /* If all four points are on the same line, continue to
-                         * the next iteration (next points P_j0 and P_j1). */
-#if !defined(__cplusplus)
-                        if (!((int)s_i0 && (int)s_i1 && (int)s_j0 && (int)s_j1))
-#else
-                        if (
-                            !(
-                                static_cast<int>(s_i0) &&
-                                static_cast<int>(s_i1) &&
-                                static_cast<int>(s_j0) &&
-                                static_cast<int>(s_j1)
-                            )
-                        )
-#endif /* __cplusplus */
-                            continue;
-
-                        /* If the points P_i0 and P_i1 are on the opposite sides
-                         * of the line P_j0 P_j1 (allowing them to be on the
-                         * line as well), and the points P_j0 and P_j1 are on
-                         * the opposite sides of the line P_i0 P_i1 (again,
-                         * allowing the points to be on the line), the line
-                         * segments P_i0 P_i1 and P_j0 P_j1 are crossing.  If
-                         * that is the case, set the flag `bad` to `true` and
-                         * break the `for`-loop. */
-#if !defined(__cplusplus)
-                        if (
-                            !(
-                                (int)s_i0 * (int)s_i1 == 1 ||
-                                (int)s_j0 * (int)s_j1 == 1
-                            )
-                        )
-#else
-                        if (
-                            !(
-                                static_cast<int>(s_i0) *
-                                    static_cast<int>(s_i1) ==
-                                    1 ||
-                                static_cast<int>(s_j0) *
-                                    static_cast<int>(s_j1) ==
-                                    1
-                            )
-                        )
-#endif /* __cplusplus */
+                        /* If the line segments P_i0 P_i1 and P_j0 P_j1 are
+                         * crossing (the points P_i0 and P_i1 are strictly on
+                         * the opposite sides of the line P_j0 P_j1 and vice
+                         * versa), set the flag `bad` to `true` and break the
+                         * `for`-loop.  The orientations of the points are
+                         * computed exactly (see "predicate.h"). */
+                        if (segments_cross(x_i0, x_i1, x_j0, x_j1))
                         {
                             /* Set the flag `bad` to `true`. */
                             bad = true;
@@ -779,12 +715,6 @@ real_t* simplify_polygon (::size_t n, real_t* P)
     real_t* x_2;
     real_t* y_2;
 
-    /* Differences in coordinates. */
-    real_t dx_0_1;
-    real_t dy_0_1;
-    real_t dx_0_2;
-    real_t dy_0_2;
-
     /* Signs of differences in coordinates. */
     sign_t sdx_1;
     sign_t sdy_1;
@@ -834,12 +764,6 @@ real_t* simplify_polygon (::size_t n, real_t* P)
     y_2 = nullptr;
 #endif /* __cplusplus */
 
-    /* Differences in coordinates. */
-    dx_0_1 = 0.0;
-    dy_0_1 = 0.0;
-    dx_0_2 = 0.0;
-    dy_0_2 = 0.0;
-
     /* Signs of differences in coordinates. */
 #if !defined(__cplusplus) || (__cplusplus) < 201103L
     sdx_1 = zero;
@@ -907,14 +831,10 @@ real_t* simplify_polygon (::size_t n, real_t* P)
             break;
         }
 
-        /* Compute the differences in coordinates of points P_0 and P_1. */
-        dx_0_1 = *x_1 - *x_0;
-        dy_0_1 = *y_1 - *y_0;
-
         /* Compute the signs of the differences in coordinates of points P_0 and
          * P_1. */
-        sdx_1 = rsign(dx_0_1);
-        sdy_1 = rsign(dy_0_1);
+        sdx_1 = rsign(*x_1 - *x_0);
+        sdy_1 = rsign(*y_1 - *y_0);
 
         /* Find the first point that is not on the directed line P_0 P_1 after
          * the point P_1---point P_2.  For all the skipped points, decrement the
@@ -925,11 +845,6 @@ real_t* simplify_polygon (::size_t n, real_t* P)
             x_2 = P + (k << 1U);
             y_2 = x_2 + 1U;
 
-            /* Compute the differences in coordinates of points P_0 and the
-             * `k`-th point. */
-            dx_0_2 = *x_2 - *x_0;
-            dy_0_2 = *y_2 - *y_0;
-
             /* Compute the signs of the differences in coordinates of points P_1
              * and the `k`-th point. */
             sdx_2 = rsign(*x_2 - *x_1);
@@ -939,23 +854,30 @@ real_t* simplify_polygon (::size_t n, real_t* P)
              * the differences in coordinates of points P_1 and the `k`-th point
              * differ from the signs until the `k`-th point, the `k`-th point is
              * not on the directed line P_0 P_1 after the point P_1.  If that is
-             * the case, break the `for`-loop. */
+             * the case, break the `for`-loop.  The orientation of the points
+             * P_0, P_1 and the `k`-th point is computed exactly (see
+             * "predicate.h"). */
+#if !defined(__cplusplus)
+            if (
+                !(
+                    !(int)orient2d(x_0, x_1, x_2) &&
+                    (sdx_2 == sdx_1 && sdy_2 == sdy_1)
+                )
+            )
+#else
             if (
                 !(
-                    dx_0_1 * dy_0_2 == dy_0_1 * dx_0_2 &&
+                    !static_cast<int>(orient2d(x_0, x_1, x_2)) &&
                     (sdx_2 == sdx_1 && sdy_2 == sdy_1)
                 )
             )
+#endif /* __cplusplus */
                 break;
 
             /* Set the coordinates of the point P_1 to (`x_2`, `y_2`). */
             x_1 = x_2;
             y_1 = y_2;
 
-            /* Update the differences in coordinates of points P_0 and P_1. */
-            dx_0_1 = dx_0_2;
-            dy_0_1 = dy_0_2;
-
             /* Update the signs of the differences in the coordinates of the
              * preceeding two points. */
             sdx_1 = sdx_2;
@@ -1428,18 +1350,6 @@ bool check_polygon (::size_t n, const real_t* P)
     const real_t* x_j1;
     const real_t* y_j1;
 
-    /* Differences in coordinates. */
-    real_t dx_i;
-    real_t dy_i;
-    real_t dx_j;
-    real_t dy_j;
-
-    /* Signs of expressions of lines evaluated at certain points. */
-    sign_t s_i0;
-    sign_t s_i1;
-    sign_t s_j0;
-    sign_t s_j1;
-
     /* INITIALISATION OF VARIABLES */
 
     /* Answer. */
@@ -1479,25 +1389,6 @@ bool check_polygon (::size_t n, const real_t* P)
     y_j1 = nullptr;
 #endif /* __cplusplus */
 
-    /* Differences in coordinates. */
-    dx_i = 0.0;
-    dy_i = 0.0;
-    dx_j = 0.0;
-    dy_j = 0.0;
-
-    /* Signs of expressions of lines evaluated at certain points. */
-#if !defined(__cplusplus) || (__cplusplus) < 201103L
-    s_i0 = zero;
-    s_i1 = zero;
-    s_j0 = zero;
-    s_j1 = zero;
-#else
-    s_i0 = sign_t::zero;
-    s_i1 = sign_t::zero;
-    s_j0 = sign_t::zero;
-    s_j1 = sign_t::zero;
-#endif /* __cplusplus */
-
     /* ALGORITHM */
 
     /* Initialise the answer to `true` (assume the points define a true
@@ -1553,11 +1444,13 @@ bool check_polygon (::size_t n, const real_t* P)
         y_j1 = x_j1 + 1U;
 
         /* If the point P_i0 is on the line through the `j`-th point and the
-         * point P_i1, set the answer to `false` and break the `for`-loop. */
-        if (
-            (*x_i1 - *x_j1) * (*y_i0 - *y_j1) ==
-                (*y_i1 - *y_j1) * (*x_i0 - *x_j1)
-        )
+         * point P_i1 (the orientation of the points is computed exactly), set
+         * the answer to `false` and break the `for`-loop. */
+#if !defined(__cplusplus)
+        if (!(int)orient2d(x_j1, x_i0, x_i1))
+#else
+        if (!static_cast<int>(orient2d(x_j1, x_i0, x_i1)))
+#endif /* __cplusplus */
         {
             /* Set the answer to `false`. */
             answer = false;
@@ -1566,10 +1459,6 @@ bool check_polygon (::size_t n, const real_t* P)
             break;
         }
 
-        /* Compute the differences in coordinates of points P_i0 and P_i1. */
-        dx_i = *x_i1 - *x_i0;
-        dy_i = *y_i1 - *y_i0;
-
         /* Iterate over the points after the point P_i1 and check if the edge
          * P_i0 P_i1 intersect with any successive edge. */
         for (j = i + 2U; j < n; ++j)
@@ -1590,56 +1479,12 @@ bool check_polygon (::size_t n, const real_t* P)
             )
                 break;
 
-            /* Compute the differences in coordinates of points P_j0 and
-             * P_j1. */
-            dx_j = *x_j1 - *x_j0;
-            dy_j = *y_j1 - *y_j0;
-
-            /* Compute the signs of expressions of the line P_j0 P_j1 evaluated
-             * at points P_i0 and P_i1, and of the line P_i0 P_i1 evaluated at
-             * points P_j0 and P_j1. */
-            s_i0 = rsign(dx_j * (*y_i0 - *y_j0) - dy_j * (*x_i0 - *x_j0));
-            s_i1 = rsign(dx_j * (*y_i1 - *y_j0) - dy_j * (*x_i1 - *x_j0));
-            s_j0 = rsign(dx_i * (*y_j0 - *y_i0) - dy_i * (*x_j0 - *x_i0));
-            s_j1 = rsign(dx_i * (*y_j1 - *y_i0) - dy_i * (*x_j1 - *x_i0));
-
-            /* If all four points are on the same line, continue to the next
-             * iteration (next points P_j0 and P_j1). */
-#if !defined(__cplusplus)
-            if (!((int)s_i0 && (int)s_i1 && (int)s_j0 && (int)s_j1))
-#else
-            if (
-                !(
-                    static_cast<int>(s_i0) &&
-                    static_cast<int>(s_i1) &&
-                    static_cast<int>(s_j0) &&
-                    static_cast<int>(s_j1)
-                )
-            )
-#endif /* __cplusplus */
-                continue;
-
-            /* If the points P_i0 and P_i1 are on the opposite sides of the line
-             * P_j0 P_j1 (allowing them to be on the line as well), and the
-             * points P_j0 and P_j1 are on the opposite sides of the line P_i0
-             * P_i1 (again, allowing the points to be on the line), the line
-             * segments P_i0 P_i1 and P_j0 P_j1 are crossing.  If that is the
-             * case, set the answer to `false` and break the `for`-loop. */
-#if !defined(__cplusplus)
-            if (
-                !(
-                    (int)s_i0 * (int)s_i1 == 1 ||
-                    (int)s_j0 * (int)s_j1 == 1
-                )
-            )
-#else
-            if (
-                !(
-                    static_cast<int>(s_i0) * static_cast<int>(s_i1) == 1 ||
-                    static_cast<int>(s_j0) * static_cast<int>(s_j1) == 1
-                )
-            )
-#endif /* __cplusplus */
+            /* If the line segments P_i0 P_i1 and P_j0 P_j1 are crossing (the
+             * points P_i0 and P_i1 are strictly on the opposite sides of the
+             * line P_j0 P_j1 and vice versa), set the answer to `false` and
+             * break the `for`-loop.  The orientations of the points are
+             * computed exactly (see "predicate.h"). */
+            if (segments_cross(x_i0, x_i1, x_j0, x_j1))
             {
                 /* Set the answer to `false`. */
                 answer = false;
@@ -3064,7 +2909,7 @@ real_t* svd_polygon (
 
         /* Query the optimal dimension of the workspace. */
 #if !defined(__cplusplus)
-        dgesvd_(
+        _SVD_GESVD(
             job,
             job,
             &int_n,
@@ -3081,7 +2926,7 @@ real_t* svd_polygon (
             info
         );
 #elif (__cplusplus) < 201103L
-        dgesvd_(
+        _SVD_GESVD(
             job,
             job,
             &int_n,
@@ -3098,7 +2943,7 @@ real_t* svd_polygon (
             info
         );
 #else
-        dgesvd_(
+        _SVD_GESVD(
             job,
             job,
             &int_n,
@@ -3191,7 +3036,7 @@ real_t* svd_polygon (
 
         /* Compute the singular values. */
 #if !defined(__cplusplus)
-        dgesvd_(
+        _SVD_GESVD(
             job,
             job,
             &int_n,
@@ -3208,7 +3053,7 @@ real_t* svd_polygon (
             info
         );
 #elif (__cplusplus) < 201103L
-        dgesvd_(
+        _SVD_GESVD(
             job,
             job,
             &int_n,
@@ -3225,7 +3070,7 @@ real_t* svd_polygon (
             info
         );
 #else
-        dgesvd_(
+        _SVD_GESVD(
             job,
             job,
             &int_n,
@@ -3325,7 +3170,7 @@ real_t* svd_polygon (
 
         /* Query the optimal dimension of the workspace. */
 #if !defined(__cplusplus)
-        dgesdd_(
+        _SVD_GESDD(
             job,
             &int_n,
             &int_n2,
@@ -3342,7 +3187,7 @@ real_t* svd_polygon (
             info
         );
 #elif (__cplusplus) < 201103L
-        dgesdd_(
+        _SVD_GESDD(
             job,
             &int_n,
             &int_n2,
@@ -3359,7 +3204,7 @@ real_t* svd_polygon (
             info
         );
 #else
-        dgesdd_(
+        _SVD_GESDD(
             job,
             &int_n,
             &int_n2,
@@ -3476,7 +3321,7 @@ real_t* svd_polygon (
 
         /* Compute the singular values. */
 #if !defined(__cplusplus)
-        dgesdd_(
+        _SVD_GESDD(
             job,
             &int_n,
             &int_n2,
@@ -3493,7 +3338,7 @@ real_t* svd_polygon (
             info
         );
 #elif (__cplusplus) < 201103L
-        dgesdd_(
+        _SVD_GESDD(
             job,
             &int_n,
             &int_n2,
@@ -3510,7 +3355,7 @@ real_t* svd_polygon (
             info
         );
 #else
-        dgesdd_(
+        _SVD_GESDD(
             job,
             &int_n,
             &int_n2,
@@ -3717,7 +3562,12 @@ void dump_polygons (
     {
         /* Dump the x-coordinate of the fisrt point. */
 #if !defined(__cplusplus)
-        fprintf(out, format_first, (int)prec, *(P + ((i * n) << 1U)));
+        fprintf(
+            out,
+            format_first,
+                (int)prec,
+                (double)(*(P + ((i * n) << 1U)))
+        );
 #else
         out << *(P + ((i * n) << 1U));
 #endif /* __cplusplus */
@@ -3730,7 +3580,7 @@ void dump_polygons (
                 format_rest,
                     delim,
                     (int)prec,
-                    *(P + ((i * n) << 1U) + j)
+                    (double)(*(P + ((i * n) << 1U) + j))
             );
 #else
             out << delim << *(P + ((i * n) << 1U) + j);
@@ -0,0 +1,392 @@
+/**
+ * Compiled inference of the polynomial regression models.
+ *
+ * The models "models/polynomial_4.gz" and "models/polynomial_5.gz" (see the
+ * notebook "Models.ipynb") are linear regressions of the inverse of the first
+ * eigenvalue on the monomials of the coordinates (x, y) of the second vertex of
+ * a triangle with vertices (1 / 2, 0), (x, y), (-1 / 2, 0).  A polynomial of
+ * degree d has (d + 1) (d + 2) / 2 coefficients, exported by the script
+ * "polynomial_exporter.py" as a single row
+ *     c_0	c_1_0	c_1_1	c_2_0	c_2_1	c_2_2	...	c_d_d
+ * where c_0 is the intercept and c_k_r is the coefficient of the monomial
+ * x^(k - r) y^r (the order of the columns created by the function
+ * `polynomial_terms_creator` in the notebook).
+ *
+ * Instead of building every monomial, the polynomial is evaluated by the
+ * nested Horner scheme
+ *     p(x, y) = (... (q_d(x) y + q_(d - 1)(x)) y + ...) y + q_0(x),
+ * where q_r(x) is the polynomial of degree d - r in x multiplying y^r, which
+ * takes (d + 1) (d + 2) / 2 multiply-adds per point.  The coefficients are
+ * rearranged to the order in which the scheme reads them once by the function
+ * `polynomial_prepare`, and the function `polynomial_batch` evaluates the
+ * polynomial at a batch of points in vector registers (see "batch.h").
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__POLYNOMIAL_H__INCLUDED) && (__POLYNOMIAL_H__INCLUDED) == 1)
+
+/* Undefine __POLYNOMIAL_H__INCLUDED if it has already been defined. */
+#if defined(__POLYNOMIAL_H__INCLUDED)
+#undef __POLYNOMIAL_H__INCLUDED
+#endif /* __POLYNOMIAL_H__INCLUDED */
+
+/* Define __POLYNOMIAL_H__INCLUDED as 1. */
+#define __POLYNOMIAL_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+
+#else
+
+#include <cstddef>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "numeric.h"
+#include "batch.h"
+
+/* Define functions. */
+
+/**
+ * Compute the number of coefficients of a polynomial in two variables.
+ *
+ * @param d
+ *     Degree of the polynomial.
+ *
+ * @return
+ *     Number of coefficients (d + 1) (d + 2) / 2 (including the intercept).
+ *
+ */
+#if !defined(__cplusplus)
+size_t polynomial_size (size_t d)
+#else
+inline ::size_t polynomial_size (::size_t d)
+#endif /* __cplusplus */
+{
+    return ((d + 1U) * (d + 2U)) >> 1U;
+}
+
+/**
+ * Compute the monomials of a point in the order of the exported models.
+ *
+ * The monomials of degree at most d' < d are the first `polynomial_size(d')`
+ * values, so the terms of a polynomial of a lower degree are a prefix of the
+ * terms of a polynomial of a higher degree.
+ *
+ * @param d
+ *     Degree of the polynomial.
+ *
+ * @param x
+ *     The first coordinate of the point.
+ *
+ * @param y
+ *     The second coordinate of the point.
+ *
+ * @param t
+ *     Array of size at least `polynomial_size(d)` to store the monomials
+ *     1, x, y, x^2, x y, y^2, ..., y^d.
+ *
+ * @see polynomial_size
+ *
+ */
+#if !defined(__cplusplus)
+void polynomial_terms (size_t d, real_t x, real_t y, real_t* t)
+#else
+inline void polynomial_terms (::size_t d, real_t x, real_t y, real_t* t)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Indices of the first monomials of the previous and of the current
+     * degree. */
+    size_t h;
+    size_t j;
+
+    /* Iteration indices. */
+    size_t k;
+    size_t r;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Indices of the first monomials. */
+    h = 0U;
+    j = 1U;
+
+    /* Iteration indices. */
+    k = 0U;
+    r = 0U;
+
+    /* ALGORITHM */
+
+    /* Compute the monomials of degree k from the monomials of degree k - 1:
+     * x^(k - r) y^r = x^(k - 1 - r) y^r x for r < k and y^k = y^(k - 1) y. */
+    *t = 1.0;
+    for (k = 1U; k <= d; ++k)
+    {
+        for (r = 0U; r < k; ++r)
+            *(t + j + r) = *(t + h + r) * x;
+        *(t + j + k) = *(t + h + k - 1U) * y;
+        h = j;
+        j += k + 1U;
+    }
+}
+
+/**
+ * Rearrange the coefficients of a polynomial to the order of the Horner
+ * scheme.
+ *
+ * @param d
+ *     Degree of the polynomial.
+ *
+ * @param c
+ *     Array of the coefficients of size at least `polynomial_size(d)` in the
+ *     order of the exported models (see the description of the header).
+ *
+ * @param H
+ *     Array of size at least `polynomial_size(d)` to store the rearranged
+ *     coefficients:  for r = d, d - 1, ..., 0, the coefficients of
+ *     x^(d - r) y^r, x^(d - r - 1) y^r, ..., y^r.
+ *
+ * @see polynomial_size
+ *
+ */
+#if !defined(__cplusplus)
+void polynomial_prepare (size_t d, const real_t* c, real_t* H)
+#else
+inline void polynomial_prepare (::size_t d, const real_t* c, real_t* H)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Index of the rearranged coefficient. */
+    size_t h;
+
+    /* Degree of the monomial. */
+    size_t k;
+
+    /* Iteration indices. */
+    size_t r;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Index of the rearranged coefficient. */
+    h = 0U;
+
+    /* Degree of the monomial. */
+    k = 0U;
+
+    /* Iteration indices. */
+    r = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* Rearrange the coefficients.  The coefficient of x^j y^r (of degree
+     * k = j + r > 0) is at the index 1 + (k - 1) (k + 2) / 2 + r. */
+    for (r = d + 1U; r--; )
+        for (j = d - r + 1U; j--; )
+        {
+            k = j + r;
+            *(H + h++) = k ? *(c + 1U + (((k - 1U) * (k + 2U)) >> 1U) + r) :
+                *c;
+        }
+}
+
+/**
+ * Evaluate a polynomial at a point.
+ *
+ * @param d
+ *     Degree of the polynomial.
+ *
+ * @param H
+ *     Array of the coefficients rearranged by the function
+ *     `polynomial_prepare`.
+ *
+ * @param x
+ *     The first coordinate of the point.
+ *
+ * @param y
+ *     The second coordinate of the point.
+ *
+ * @return
+ *     Value of the polynomial at the point (x, y).
+ *
+ * @see polynomial_prepare
+ *
+ */
+#if !defined(__cplusplus)
+real_t polynomial_evaluate (size_t d, const real_t* H, real_t x, real_t y)
+#else
+inline real_t polynomial_evaluate (
+    ::size_t d,
+    const real_t* H,
+    real_t x,
+    real_t y
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Value of the polynomial and of the polynomial in x. */
+    real_t p;
+    real_t q;
+
+    /* Iteration indices. */
+    size_t t;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Value of the polynomial and of the polynomial in x. */
+    p = 0.0;
+    q = 0.0;
+
+    /* Iteration indices. */
+    t = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* Evaluate the polynomial by the nested Horner scheme. */
+    for (t = 0U; t <= d; ++t)
+    {
+        for (q = 0.0, j = 0U; j <= t; ++j)
+            q = q * x + *H++;
+        p = p * y + q;
+    }
+
+    /* Return the value of the polynomial. */
+    return p;
+}
+
+/**
+ * Evaluate a polynomial at a batch of points.
+ *
+ * The points are stored as a structure of arrays as in "batch.h" (for
+ * instance, the coordinates of the second vertices of a batch of triangles).
+ * Groups of `BATCH_LANES` points are evaluated in a single vector register and
+ * the remaining points one by one by the function `polynomial_evaluate`;  the
+ * values are the same as the values computed by the function
+ * `polynomial_evaluate` for each point.
+ *
+ * @param d
+ *     Degree of the polynomial.
+ *
+ * @param H
+ *     Array of the coefficients rearranged by the function
+ *     `polynomial_prepare`.
+ *
+ * @param B
+ *     Number of points.
+ *
+ * @param X
+ *     Array of the first coordinates of the points of size at least `B`.
+ *
+ * @param Y
+ *     Array of the second coordinates of the points of size at least `B`.
+ *
+ * @param Z
+ *     Array of size at least `B` to store the values of the polynomial.
+ *
+ * @see polynomial_prepare
+ * @see polynomial_evaluate
+ *
+ */
+#if !defined(__cplusplus)
+void polynomial_batch (
+    size_t d,
+    const real_t* H,
+    size_t B,
+    const real_t* X,
+    const real_t* Y,
+    real_t* Z
+)
+#else
+inline void polynomial_batch (
+    ::size_t d,
+    const real_t* H,
+    ::size_t B,
+    const real_t* X,
+    const real_t* Y,
+    real_t* Z
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Iteration indices. */
+    size_t b;
+
+#if defined(_BATCH_SIMD)
+    /* Index of the coefficient. */
+    size_t h;
+
+    /* Iteration indices. */
+    size_t t;
+    size_t j;
+
+    /* Vectors of coordinates, of values of the polynomial and of values of the
+     * polynomial in x. */
+    batch_vector_t vx;
+    batch_vector_t vy;
+    batch_vector_t vp;
+    batch_vector_t vq;
+#endif /* _BATCH_SIMD */
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Iteration indices. */
+    b = 0U;
+
+#if defined(_BATCH_SIMD)
+    /* Index of the coefficient. */
+    h = 0U;
+
+    /* Iteration indices. */
+    t = 0U;
+    j = 0U;
+#endif /* _BATCH_SIMD */
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, set the number `B` to 0. */
+    if (!(H && X && Y && Z))
+        B = 0U;
+
+#if defined(_BATCH_SIMD)
+    /* Evaluate the polynomial at groups of `BATCH_LANES` points by the nested
+     * Horner scheme. */
+    for (b = 0U; b + BATCH_LANES <= B; b += BATCH_LANES)
+    {
+        vx = BATCH_LOAD(X + b);
+        vy = BATCH_LOAD(Y + b);
+        vp = BATCH_SET1(0.0);
+        for (h = 0U, t = 0U; t <= d; ++t)
+        {
+            vq = BATCH_SET1(0.0);
+            for (j = 0U; j <= t; ++j)
+                vq = BATCH_ADD(BATCH_MUL(vq, vx), BATCH_SET1(*(H + h++)));
+            vp = BATCH_ADD(BATCH_MUL(vp, vy), vq);
+        }
+        BATCH_STORE(Z + b, vp);
+    }
+#endif /* _BATCH_SIMD */
+
+    /* Evaluate the polynomial at the remaining points one by one. */
+    for (; b < B; ++b)
+        *(Z + b) = polynomial_evaluate(d, H, *(X + b), *(Y + b));
+}
+
+#endif /* __POLYNOMIAL_H__INCLUDED */
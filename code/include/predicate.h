@@ -0,0 +1,564 @@
+/**
+ * Robust geometric predicates.
+ *
+ * The orientation of three points is computed in the style of Shewchuk's
+ * adaptive predicates:  the determinant is first evaluated in floating point
+ * arithmetics and its sign is accepted if the absolute value of the
+ * determinant exceeds a forward error bound of the evaluation (which is the
+ * case for almost all calls).  Otherwise the determinant is evaluated exactly
+ * as a nonoverlapping expansion of floating point numbers built from error-free
+ * transformations (`two_sum` and `two_product`).  The sign is therefore always
+ * exact, no tolerance such as `epsilon` is used.
+ *
+ * The exact evaluation assumes IEEE-754 arithmetics with rounding to nearest,
+ * no extended precision of intermediate results (as on x87 for `float` and
+ * `double`) and no contraction of multiplications and additions into fused
+ * multiply-add instructions (GCC does not contract in the ISO C and C++ modes,
+ * i. e. with the flags "-std=c89", "-std=c99", "-std=c++11"...).  Overflow and
+ * underflow in the computations are not handled.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__PREDICATE_H__INCLUDED) && (__PREDICATE_H__INCLUDED) == 1)
+
+/* Undefine __PREDICATE_H__INCLUDED if it has already been defined. */
+#if defined(__PREDICATE_H__INCLUDED)
+#undef __PREDICATE_H__INCLUDED
+#endif /* __PREDICATE_H__INCLUDED */
+
+/* Define __PREDICATE_H__INCLUDED as 1. */
+#define __PREDICATE_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <float.h>
+#include <stddef.h>
+#include <string.h>
+
+#else
+
+#include <cfloat>
+#include <cstddef>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define the number of digits of the mantissa of `real_t`. */
+#if defined(_REAL_MANT_DIG)
+#undef _REAL_MANT_DIG
+#endif /* _REAL_MANT_DIG */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#define _REAL_MANT_DIG FLT_MANT_DIG
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#define _REAL_MANT_DIG LDBL_MANT_DIG
+#else
+#define _REAL_MANT_DIG DBL_MANT_DIG
+#endif /* _REAL_PRECISION */
+
+/**
+ * Splitter of real numbers, 2^ceil(p / 2) + 1, where p is the number of digits
+ * of the mantissa of `real_t`.
+ *
+ * Multiplying a number by the splitter splits it into two halves of at most
+ * p / 2 digits (see the `two_product` function).
+ *
+ */
+#if (_REAL_MANT_DIG) == 24
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  predicate_splitter  =   4097.0;
+#else
+constexpr   const   real_t  predicate_splitter  =   4097.0;
+#endif /* __cplusplus */
+#elif (_REAL_MANT_DIG) == 53
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  predicate_splitter  =   134217729.0;
+#else
+constexpr   const   real_t  predicate_splitter  =   134217729.0;
+#endif /* __cplusplus */
+#elif (_REAL_MANT_DIG) == 64
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  predicate_splitter  =   4294967297.0;
+#else
+constexpr   const   real_t  predicate_splitter  =   4294967297.0;
+#endif /* __cplusplus */
+#else
+#error "Unsupported number of digits of the mantissa of real numbers."
+#endif /* _REAL_MANT_DIG */
+
+/**
+ * Relative error bound of the floating point evaluation of the orientation
+ * determinant, (3 + 16 u) u, where u = 2^(-p) is the unit roundoff of `real_t`.
+ *
+ */
+#if (_REAL_PRECISION) == (_REAL_FLOAT)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  predicate_err_bound =
+    (3.0 + 8.0 * FLT_EPSILON) * (0.5 * FLT_EPSILON);
+#else
+constexpr   const   real_t  predicate_err_bound =
+    (3.0 + 8.0 * FLT_EPSILON) * (0.5 * FLT_EPSILON);
+#endif /* __cplusplus */
+#elif (_REAL_PRECISION) == (_REAL_LONG_DOUBLE)
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  predicate_err_bound =
+    (3.0 + 8.0 * LDBL_EPSILON) * (0.5 * LDBL_EPSILON);
+#else
+constexpr   const   real_t  predicate_err_bound =
+    (3.0 + 8.0 * LDBL_EPSILON) * (0.5 * LDBL_EPSILON);
+#endif /* __cplusplus */
+#else
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  predicate_err_bound =
+    (3.0 + 8.0 * DBL_EPSILON) * (0.5 * DBL_EPSILON);
+#else
+constexpr   const   real_t  predicate_err_bound =
+    (3.0 + 8.0 * DBL_EPSILON) * (0.5 * DBL_EPSILON);
+#endif /* __cplusplus */
+#endif /* _REAL_PRECISION */
+
+/**
+ * Compute the sum of two real numbers and its rounding error.
+ *
+ * The sum `a` + `b` is exactly equal to `*x` + `*y`, where `*x` is the rounded
+ * sum (Knuth's error-free transformation).
+ *
+ * @param a
+ *     Real number.
+ *
+ * @param b
+ *     Real number.
+ *
+ * @param x
+ *     Memory location to store the rounded sum.
+ *
+ * @param y
+ *     Memory location to store the rounding error.
+ *
+ */
+#if !defined(__cplusplus)
+void two_sum (real_t a, real_t b, real_t* x, real_t* y)
+#else
+inline void two_sum (real_t a, real_t b, real_t* x, real_t* y)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Parts of the summands contained in the rounded sum. */
+    real_t a_virt;
+    real_t b_virt;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Parts of the summands contained in the rounded sum. */
+    a_virt = 0.0;
+    b_virt = 0.0;
+
+    /* ALGORITHM */
+
+    /* Compute the rounded sum. */
+    *x = a + b;
+
+    /* Compute the parts of the summands contained in the rounded sum. */
+    b_virt = *x - a;
+    a_virt = *x - b_virt;
+
+    /* Compute the rounding error. */
+    *y = (a - a_virt) + (b - b_virt);
+}
+
+/**
+ * Compute the product of two real numbers and its rounding error.
+ *
+ * The product `a` * `b` is exactly equal to `*x` + `*y`, where `*x` is the
+ * rounded product (Dekker's error-free transformation).
+ *
+ * @param a
+ *     Real number.
+ *
+ * @param b
+ *     Real number.
+ *
+ * @param x
+ *     Memory location to store the rounded product.
+ *
+ * @param y
+ *     Memory location to store the rounding error.
+ *
+ * @see predicate_splitter
+ *
+ */
+#if !defined(__cplusplus)
+void two_product (real_t a, real_t b, real_t* x, real_t* y)
+#else
+inline void two_product (real_t a, real_t b, real_t* x, real_t* y)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Auxiliary variable. */
+    real_t aux;
+
+    /* High and low halves of the factors. */
+    real_t a_hi;
+    real_t a_lo;
+    real_t b_hi;
+    real_t b_lo;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Auxiliary variable. */
+    aux = 0.0;
+
+    /* High and low halves of the factors. */
+    a_hi = 0.0;
+    a_lo = 0.0;
+    b_hi = 0.0;
+    b_lo = 0.0;
+
+    /* ALGORITHM */
+
+    /* Compute the rounded product. */
+    *x = a * b;
+
+    /* Split the factor `a`. */
+    aux = predicate_splitter * a;
+    a_hi = aux - (aux - a);
+    a_lo = a - a_hi;
+
+    /* Split the factor `b`. */
+    aux = predicate_splitter * b;
+    b_hi = aux - (aux - b);
+    b_lo = b - b_hi;
+
+    /* Compute the rounding error. */
+    *y = a_lo * b_lo - (((*x - a_hi * b_hi) - a_lo * b_hi) - a_hi * b_lo);
+}
+
+/**
+ * Add a real number to an expansion.
+ *
+ * An expansion is an array of real numbers whose exact sum is the represented
+ * value.  The components are nonoverlapping and sorted by increasing
+ * magnitude, so the sign of the value is the sign of the last component.  Zero
+ * components are eliminated.
+ *
+ * @param m
+ *     Number of components of the expansion.
+ *
+ * @param e
+ *     Array of components of the expansion of size at least `m` + 1.
+ *
+ *     Caution: the array `e` is mutated in the function.
+ *
+ * @param b
+ *     Real number to add.
+ *
+ * @return
+ *     Number of components of the expansion after the addition.  If the sum is
+ *     0, the expansion consists of a single zero component.
+ *
+ */
+#if !defined(__cplusplus)
+size_t grow_expansion (size_t m, real_t* e, real_t b)
+#else
+inline ::size_t grow_expansion (::size_t m, real_t* e, real_t b)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Partial sum and its rounding error. */
+    real_t q;
+    real_t h;
+
+    /* Iteration indices. */
+#if !defined(__cplusplus)
+    size_t i;
+    size_t k;
+#else
+    ::size_t i;
+    ::size_t k;
+#endif /* __cplusplus */
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Partial sum and its rounding error. */
+    q = b;
+    h = 0.0;
+
+    /* Iteration indices. */
+    i = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Add the components to the partial sum and keep the nonzero rounding
+     * errors.  Note that `k` <= `i`, so the components may be overwritten. */
+    for (i = 0U; i < m; ++i)
+    {
+        two_sum(q, *(e + i), &q, &h);
+        if (h != 0.0)
+            *(e + k++) = h;
+    }
+
+    /* Append the partial sum. */
+    if (q != 0.0 || !k)
+        *(e + k++) = q;
+
+    /* Return the number of components. */
+    return k;
+}
+
+/**
+ * Compute the exact orientation of three points.
+ *
+ * The determinant
+ *     (x_b - x_a) * (y_c - y_a) - (y_b - y_a) * (x_c - x_a)
+ * is expanded into six products of coordinates, which are summed exactly as an
+ * expansion.
+ *
+ * @param a
+ *     Coordinates of the first point (array of size 2).
+ *
+ * @param b
+ *     Coordinates of the second point (array of size 2).
+ *
+ * @param c
+ *     Coordinates of the third point (array of size 2).
+ *
+ * @return
+ *     Value `plus` if the points are listed counterclockwise, `minus` if they
+ *     are listed clockwise and `zero` if they are on the same line.
+ *
+ * @see orient2d
+ *
+ */
+#if !defined(__cplusplus)
+sign_t orient2d_exact (const real_t* a, const real_t* b, const real_t* c)
+#else
+inline sign_t orient2d_exact (const real_t* a, const real_t* b, const real_t* c)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Expansion of the determinant. */
+    real_t e[12U];
+
+    /* Number of components of the expansion. */
+#if !defined(__cplusplus)
+    size_t m;
+#else
+    ::size_t m;
+#endif /* __cplusplus */
+
+    /* Rounded product and its rounding error. */
+    real_t x;
+    real_t y;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Expansion of the determinant. */
+#if !defined(__cplusplus)
+    memset(e, 0, 12U * sizeof *e);
+#else
+    ::memset(e, 0, 12U * sizeof *e);
+#endif /* __cplusplus */
+
+    /* Number of components of the expansion. */
+    m = 0U;
+
+    /* Rounded product and its rounding error. */
+    x = 0.0;
+    y = 0.0;
+
+    /* ALGORITHM */
+
+    /* Add the products x_a * y_b, -x_a * y_c, -y_a * x_b, y_a * x_c,
+     * x_b * y_c and -y_b * x_c to the expansion. */
+    two_product(*a, *(b + 1U), &x, &y);
+    m = grow_expansion(m, e, y);
+    m = grow_expansion(m, e, x);
+    two_product(-*a, *(c + 1U), &x, &y);
+    m = grow_expansion(m, e, y);
+    m = grow_expansion(m, e, x);
+    two_product(-*(a + 1U), *b, &x, &y);
+    m = grow_expansion(m, e, y);
+    m = grow_expansion(m, e, x);
+    two_product(*(a + 1U), *c, &x, &y);
+    m = grow_expansion(m, e, y);
+    m = grow_expansion(m, e, x);
+    two_product(*b, *(c + 1U), &x, &y);
+    m = grow_expansion(m, e, y);
+    m = grow_expansion(m, e, x);
+    two_product(-*(b + 1U), *c, &x, &y);
+    m = grow_expansion(m, e, y);
+    m = grow_expansion(m, e, x);
+
+    /* Return the sign of the last component. */
+    return rsign(*(e + m - 1U));
+}
+
+/**
+ * Compute the orientation of three points.
+ *
+ * The determinant
+ *     (x_a - x_c) * (y_b - y_c) - (y_a - y_c) * (x_b - x_c)
+ * is evaluated in floating point arithmetics.  If the products do not have the
+ * same sign or if the absolute value of the determinant is at least the error
+ * bound `predicate_err_bound` * (|(x_a - x_c) * (y_b - y_c)| +
+ * |(y_a - y_c) * (x_b - x_c)|), the sign of the evaluated determinant is
+ * exact; otherwise the function `orient2d_exact` is called.
+ *
+ * @param a
+ *     Coordinates of the first point (array of size 2).
+ *
+ * @param b
+ *     Coordinates of the second point (array of size 2).
+ *
+ * @param c
+ *     Coordinates of the third point (array of size 2).
+ *
+ * @return
+ *     Value `plus` if the points are listed counterclockwise, `minus` if they
+ *     are listed clockwise and `zero` if they are on the same line.
+ *
+ * @see orient2d_exact
+ *
+ */
+#if !defined(__cplusplus)
+sign_t orient2d (const real_t* a, const real_t* b, const real_t* c)
+#else
+inline sign_t orient2d (const real_t* a, const real_t* b, const real_t* c)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Products in the determinant. */
+    real_t left;
+    real_t right;
+
+    /* Determinant. */
+    real_t det;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Products in the determinant. */
+    left = (*a - *c) * (*(b + 1U) - *(c + 1U));
+    right = (*(a + 1U) - *(c + 1U)) * (*b - *c);
+
+    /* Determinant. */
+    det = left - right;
+
+    /* ALGORITHM */
+
+    /* If the products have the same sign and the determinant is below the
+     * error bound, its sign may be wrong and the exact orientation is
+     * returned.  Otherwise the sign of the determinant is exact. */
+    return (
+        ((0.0 < left && 0.0 < right) || (left < 0.0 && right < 0.0)) &&
+        rabs(det) < predicate_err_bound * (rabs(left) + rabs(right))
+    ) ?
+        orient2d_exact(a, b, c) :
+        rsign(det);
+}
+
+/**
+ * Check if two line segments are crossing.
+ *
+ * The line segments A_0 A_1 and B_0 B_1 are crossing if the points A_0 and A_1
+ * are strictly on the opposite sides of the line B_0 B_1 and the points B_0
+ * and B_1 are strictly on the opposite sides of the line A_0 A_1.  Touching
+ * and collinear line segments are therefore not crossing.  The orientations
+ * are computed exactly using the `orient2d` function.
+ *
+ * @param a0
+ *     Coordinates of the point A_0 (array of size 2).
+ *
+ * @param a1
+ *     Coordinates of the point A_1 (array of size 2).
+ *
+ * @param b0
+ *     Coordinates of the point B_0 (array of size 2).
+ *
+ * @param b1
+ *     Coordinates of the point B_1 (array of size 2).
+ *
+ * @return
+ *     Value `true` if the line segments are crossing; value `false`
+ *     otherwise.
+ *
+ * @see orient2d
+ *
+ */
+#if !defined(__cplusplus)
+bool segments_cross (
+    const real_t* a0,
+    const real_t* a1,
+    const real_t* b0,
+    const real_t* b1
+)
+#else
+inline bool segments_cross (
+    const real_t* a0,
+    const real_t* a1,
+    const real_t* b0,
+    const real_t* b1
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Orientations of the points with respect to the line segments. */
+    int s_0;
+    int s_1;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Orientations of the points with respect to the line segments. */
+    s_0 = 0;
+    s_1 = 0;
+
+    /* ALGORITHM */
+
+    /* Compute the orientations of the points A_0 and A_1 with respect to the
+     * line B_0 B_1. */
+#if !defined(__cplusplus)
+    s_0 = (int)orient2d(b0, b1, a0);
+    s_1 = (int)orient2d(b0, b1, a1);
+#else
+    s_0 = static_cast<int>(orient2d(b0, b1, a0));
+    s_1 = static_cast<int>(orient2d(b0, b1, a1));
+#endif /* __cplusplus */
+
+    /* If the points A_0 and A_1 are strictly on the opposite sides of the line
+     * B_0 B_1, compute the orientations of the points B_0 and B_1 with respect
+     * to the line A_0 A_1. */
+    if (s_0 * s_1 == -1)
+    {
+#if !defined(__cplusplus)
+        s_0 = (int)orient2d(a0, a1, b0);
+        s_1 = (int)orient2d(a0, a1, b1);
+#else
+        s_0 = static_cast<int>(orient2d(a0, a1, b0));
+        s_1 = static_cast<int>(orient2d(a0, a1, b1));
+#endif /* __cplusplus */
+    }
+
+    /* Return `true` if the last computed pair of points is strictly on the
+     * opposite sides of the corresponding line. */
+    return (s_0 * s_1 == -1) ? true : false;
+}
+
+#endif /* __PREDICATE_H__INCLUDED */
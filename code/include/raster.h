@@ -0,0 +1,949 @@
+/**
+ * Functions for rasterising polygons.
+ *
+ * A polygon is rasterised on a square window [-a, a] x [-a, a] divided into
+ * R x R pixels.  The value of each pixel is the exact area of the part of the
+ * pixel covered by the polygon divided by the area of the pixel (a number in
+ * the range [0, 1]), so no supersampling is needed and the result does not
+ * depend on an external renderer.  Images are stored as arrays of R * R values
+ * with rows enumerated from top to bottom (from the largest y-coordinate to
+ * the smallest) and pixels in rows enumerated from left to right, i. e. in the
+ * same order as in PNG images.  Note that the values are coverages of the
+ * polygon (1 inside the polygon, 0 outside), while the PNG images generated by
+ * "preprocessors/direct_pngise.py" and "preprocessors/pngise.sh" show black
+ * polygons on a white background.
+ *
+ * The coverage is computed by the signed area accumulation algorithm:  each
+ * edge of the polygon adds to every pixel it passes through the signed area
+ * between the edge and the right side of the pixel and to the next pixel the
+ * remainder of the height of the edge in the pixel; the coverage is then the
+ * absolute value of the running sum of the accumulated values along the row.
+ * The computation takes time proportional to the number of pixels the edges
+ * pass through plus the number of pixels in the image.
+ *
+ * Images may be dumped as NumPy arrays (".npy" files, see "npy.h") of shape
+ * (N, R, R) and of type `float32` or `uint8` (coverage multiplied by 255 and
+ * rounded).  As "npy.h" is included, the macro `_POSIX_C_SOURCE` must be
+ * defined (as at least 200112L) before any standard header is included.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__RASTER_H__INCLUDED) && (__RASTER_H__INCLUDED) == 1)
+
+/* Undefine __RASTER_H__INCLUDED if it has already been defined. */
+#if defined(__RASTER_H__INCLUDED)
+#undef __RASTER_H__INCLUDED
+#endif /* __RASTER_H__INCLUDED */
+
+/* Define __RASTER_H__INCLUDED as 1. */
+#define __RASTER_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import POSIX threads. */
+#include <pthread.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "npy.h"
+
+/* Define constants. */
+
+/**
+ * Half of the side of the default window, the window is
+ * [-0.64, 0.64] x [-0.64, 0.64].
+ *
+ * The same window is used in "preprocessors/direct_pngise.py".
+ *
+ */
+#if !defined(__cplusplus) || (__cplusplus) < 201103L
+const   real_t  raster_half_side    =   0.64;
+#else
+constexpr   const   real_t  raster_half_side    =   0.64;
+#endif /* __cplusplus */
+
+/* Define types. */
+
+/**
+ * Job of rasterising polygons (an argument of the `raster_job` function).
+ *
+ */
+typedef struct raster_job_struct
+{
+    /* Number of vertices of each polygon. */
+    size_t n;
+
+    /* Number of polygons. */
+    size_t N;
+
+    /* Array of polygons. */
+    const real_t* P;
+
+    /* Half of the side of the window. */
+    real_t a;
+
+    /* Resolution of images. */
+    size_t R;
+
+    /* Array of images. */
+    real_t* A;
+}
+raster_job_t;
+
+/* Define functions. */
+
+/**
+ * Accumulate the signed areas of a line segment in an image.
+ *
+ * The coordinates are given in pixels:  the point (0, 0) is the top left
+ * corner of the image, the x-axis points to the right and the y-axis points
+ * down, and each pixel is a unit square.  The x-coordinates must be in the
+ * range [0, `R`]; the y-coordinates may be arbitrary (the parts of the line
+ * segment above and below the image are ignored).  Values that would be
+ * accumulated right of the image are ignored, since they do not affect the
+ * running sums along the rows.
+ *
+ * @param x0
+ *     The x-coordinate of the first end-point of the line segment.
+ *
+ * @param y0
+ *     The y-coordinate of the first end-point of the line segment.
+ *
+ * @param x1
+ *     The x-coordinate of the second end-point of the line segment.
+ *
+ * @param y1
+ *     The y-coordinate of the second end-point of the line segment.
+ *
+ * @param R
+ *     Resolution of the image.
+ *
+ * @param A
+ *     Array of accumulated values of size at least `R` * `R`.
+ *
+ */
+#if !defined(__cplusplus)
+void raster_line (
+    real_t x0,
+    real_t y0,
+    real_t x1,
+    real_t y1,
+    size_t R,
+    real_t* A
+)
+#else
+inline void raster_line (
+    real_t x0,
+    real_t y0,
+    real_t x1,
+    real_t y1,
+    ::size_t R,
+    real_t* A
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Direction of the line segment (1 if downwards, -1 if upwards). */
+    real_t dir;
+
+    /* Change of the x-coordinate per unit change of the y-coordinate. */
+    real_t dxdy;
+
+    /* The x-coordinates of the line segment at the top and at the bottom of
+     * the current row. */
+    real_t x;
+    real_t x_next;
+
+    /* Smaller and larger of the x-coordinates `x` and `x_next`. */
+    real_t x_left;
+    real_t x_right;
+
+    /* Height of the line segment in the current row and its signed value. */
+    real_t dy;
+    real_t d;
+
+    /* Auxiliary values (distances and areas). */
+    real_t s;
+    real_t f_left;
+    real_t f_right;
+    real_t a_left;
+    real_t a_mid;
+    real_t a_right;
+
+    /* Temporary variable for swapping coordinates. */
+    real_t t;
+
+    /* Current row and the end of the range of rows. */
+    size_t row;
+    size_t rows;
+
+    /* Indices of the pixels containing `x_left` and `x_right` (the index of
+     * the pixel of `x_right` is rounded up). */
+    size_t k_left;
+    size_t k_right;
+
+    /* Iteration index. */
+    size_t k;
+
+    /* Pointer to the current row. */
+    real_t* L;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Direction of the line segment. */
+    dir = 1.0;
+
+    /* Change of the x-coordinate per unit change of the y-coordinate. */
+    dxdy = 0.0;
+
+    /* The x-coordinates of the line segment. */
+    x = 0.0;
+    x_next = 0.0;
+
+    /* Smaller and larger of the x-coordinates. */
+    x_left = 0.0;
+    x_right = 0.0;
+
+    /* Height of the line segment in the current row and its signed value. */
+    dy = 0.0;
+    d = 0.0;
+
+    /* Auxiliary values. */
+    s = 0.0;
+    f_left = 0.0;
+    f_right = 0.0;
+    a_left = 0.0;
+    a_mid = 0.0;
+    a_right = 0.0;
+
+    /* Temporary variable for swapping coordinates. */
+    t = 0.0;
+
+    /* Current row and the end of the range of rows. */
+    row = 0U;
+    rows = 0U;
+
+    /* Indices of the pixels. */
+    k_left = 0U;
+    k_right = 0U;
+
+    /* Iteration index. */
+    k = 0U;
+
+    /* Pointer to the current row. */
+    L = (real_t*)(NULL);
+
+    /* ALGORITHM */
+
+    /* If the pointer `A` is a null-pointer, if the resolution is 0 or if the
+     * line segment is horizontal, there is nothing to accumulate. */
+    if (!A || !R || y0 == y1)
+        return;
+
+    /* Orient the line segment downwards and remember its direction. */
+    if (y1 < y0)
+    {
+        t = x0;
+        x0 = x1;
+        x1 = t;
+        t = y0;
+        y0 = y1;
+        y1 = t;
+        dir = -1.0;
+    }
+
+    /* Compute the change of the x-coordinate per unit change of the
+     * y-coordinate. */
+    dxdy = (x1 - x0) / (y1 - y0);
+
+    /* Compute the x-coordinate of the line segment at the top of the first
+     * row to process. */
+    x = x0;
+    if (y0 < 0.0)
+        x -= y0 * dxdy;
+
+    /* Compute the range of rows to process. */
+    row = (y0 < 0.0) ? 0U : (size_t)y0;
+    if (!(0.0 < y1))
+        rows = 0U;
+    else if (!(y1 < (real_t)R))
+        rows = R;
+    else
+    {
+        rows = (size_t)y1;
+        if ((real_t)rows < y1)
+            ++rows;
+    }
+
+    /* Iterate over the rows. */
+    for (; row < rows; ++row)
+    {
+        /* Compute the height of the line segment in the current row and the
+         * x-coordinate of the line segment at the bottom of the row.  Rounding
+         * errors must not push the x-coordinate out of the range [0, R]. */
+        dy = rmin((real_t)(row + 1U), y1) - rmax((real_t)row, y0);
+        x_next = x + dxdy * dy;
+        if (x_next < 0.0)
+            x_next = 0.0;
+        else if ((real_t)R < x_next)
+            x_next = (real_t)R;
+
+        /* Compute the signed height of the line segment in the current
+         * row. */
+        d = dir * dy;
+
+        /* Find the smaller and the larger x-coordinate and the indices of the
+         * pixels containing them. */
+        x_left = rmin(x, x_next);
+        x_right = rmax(x, x_next);
+        k_left = (size_t)x_left;
+        k_right = (size_t)x_right;
+        if ((real_t)k_right < x_right)
+            ++k_right;
+
+        /* Extract the current row. */
+        L = A + row * R;
+
+        /* If the line segment is contained in a single column of pixels,
+         * split its height between the pixel and the next pixel by the
+         * average distance from the left side of the pixel. */
+        if (k_right <= k_left + 1U)
+        {
+            /* Compute the average distance from the left side of the
+             * pixel. */
+            s = 0.5 * (x + x_next) - (real_t)k_left;
+
+            /* Accumulate the values. */
+            if (k_left < R)
+                *(L + k_left) += d - d * s;
+            if (k_left + 1U < R)
+                *(L + k_left + 1U) += d * s;
+        }
+
+        /* Otherwise distribute the height over the pixels proportionally to the
+         * areas of trapezoids right of the line segment. */
+        else
+        {
+            /* Compute the reciprocal of the width of the line segment in the
+             * current row. */
+            s = 1.0 / (x_right - x_left);
+
+            /* Compute the area right of the line segment in the leftmost
+             * pixel. */
+            f_left = x_left - (real_t)k_left;
+            a_left = 0.5 * s * (1.0 - f_left) * (1.0 - f_left);
+
+            /* Compute the area left of the line segment in the rightmost
+             * pixel. */
+            f_right = x_right - (real_t)k_right + 1.0;
+            a_right = 0.5 * s * f_right * f_right;
+
+            /* Accumulate the value of the leftmost pixel. */
+            *(L + k_left) += d * a_left;
+
+            /* If the line segment passes through only two pixels, the
+             * remaining area belongs to the rightmost pixel. */
+            if (k_right == k_left + 2U)
+            {
+                if (k_left + 1U < R)
+                    *(L + k_left + 1U) += d * (1.0 - a_left - a_right);
+            }
+
+            /* Otherwise accumulate the values of the pixels in between. */
+            else
+            {
+                /* Accumulate the value of the second pixel. */
+                a_mid = s * (1.5 - f_left);
+                *(L + k_left + 1U) += d * (a_mid - a_left);
+
+                /* Accumulate the values of the inner pixels. */
+                for (k = k_left + 2U; k + 1U < k_right; ++k)
+                    *(L + k) += d * s;
+
+                /* Accumulate the value of the pixel before the rightmost
+                 * pixel. */
+                a_mid += (real_t)(k_right - k_left - 3U) * s;
+                *(L + k_right - 1U) += d * (1.0 - a_mid - a_right);
+            }
+
+            /* Accumulate the value of the pixel right of the line segment. */
+            if (k_right < R)
+                *(L + k_right) += d * a_right;
+        }
+
+        /* Move to the next row. */
+        x = x_next;
+    }
+}
+
+/**
+ * Rasterise a polygon.
+ *
+ * Edges of the polygon are split at the left and the right sides of the window
+ * and their parts outside the window are projected onto the sides.  This does
+ * not change the coverage of the pixels, since the number of crossings of the
+ * boundary of the polygon with a horizontal ray pointing to the left from a
+ * point in the window stays the same.
+ *
+ * @param n
+ *     Number of vertices of the polygon.
+ *
+ * @param P
+ *     Array of vertices of the polygon of size at least 2 * `n`.  The array is
+ *     organised as `{x_0, y_0, x_1, y_1, ..., x_n_minus_1, y_n_minus_1}`,
+ *     where `x_i` is the x-coordinate of the `i`-th vertex and `y_i` is its
+ *     y-coordinate.
+ *
+ * @param a
+ *     Half of the side of the window (the window is [-`a`, `a`] x
+ *     [-`a`, `a`]).
+ *
+ * @param R
+ *     Resolution of the image.
+ *
+ * @param A
+ *     Array of size at least `R` * `R` to store the coverage of pixels.
+ *
+ */
+#if !defined(__cplusplus)
+void raster_polygon (size_t n, const real_t* P, real_t a, size_t R, real_t* A)
+#else
+inline void raster_polygon (
+    ::size_t n,
+    const real_t* P,
+    real_t a,
+    ::size_t R,
+    real_t* A
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of pixels per unit length. */
+    real_t scale;
+
+    /* Coordinates of the end-points of the current edge in pixels. */
+    real_t x0;
+    real_t y0;
+    real_t x1;
+    real_t y1;
+
+    /* Parameters of the points splitting the current edge. */
+    real_t t[4U];
+
+    /* Auxiliary variable (a parameter or an absolute value). */
+    real_t u;
+
+    /* Running sum of the accumulated values. */
+    real_t acc;
+
+    /* Number of parameters splitting the current edge. */
+    size_t m;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of pixels per unit length. */
+    scale = 0.0;
+
+    /* Coordinates of the end-points of the current edge in pixels. */
+    x0 = 0.0;
+    y0 = 0.0;
+    x1 = 0.0;
+    y1 = 0.0;
+
+    /* Parameters of the points splitting the current edge. */
+    memset(t, 0, 4U * sizeof *t);
+
+    /* Auxiliary variable. */
+    u = 0.0;
+
+    /* Running sum of the accumulated values. */
+    acc = 0.0;
+
+    /* Number of parameters splitting the current edge. */
+    m = 0U;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the pointer `A` is a null-pointer or if the resolution is 0, there is
+     * nothing to rasterise. */
+    if (!(A && R))
+        return;
+
+    /* Initialise the image to zeros. */
+    memset(A, 0, R * R * sizeof *A);
+
+    /* If the pointer `P` is a null-pointer, if the number of vertices is
+     * strictly less than 3 or if the window is empty, leave the image
+     * empty. */
+    if (!(P && n >= 3U && 0.0 < a))
+        return;
+
+    /* Compute the number of pixels per unit length. */
+    scale = (real_t)R / (a + a);
+
+    /* Iterate over the edges of the polygon. */
+    for (i = 0U; i < n; ++i)
+    {
+        /* Compute the coordinates of the end-points of the edge in pixels. */
+        x0 = (*(P + (i << 1U)) + a) * scale;
+        y0 = (a - *(P + (i << 1U) + 1U)) * scale;
+        x1 = (*(P + (incmod(i, n) << 1U)) + a) * scale;
+        y1 = (a - *(P + (incmod(i, n) << 1U) + 1U)) * scale;
+
+        /* Find the parameters of the points splitting the edge at the left
+         * and the right sides of the window. */
+        m = 0U;
+        *(t + m++) = 0.0;
+        if ((x0 < 0.0) != (x1 < 0.0))
+            *(t + m++) = x0 / (x0 - x1);
+        if ((x0 < (real_t)R) != (x1 < (real_t)R))
+            *(t + m++) = (x0 - (real_t)R) / (x0 - x1);
+        if (m == 3U && *(t + 2U) < *(t + 1U))
+        {
+            u = *(t + 1U);
+            *(t + 1U) = *(t + 2U);
+            *(t + 2U) = u;
+        }
+        *(t + m++) = 1.0;
+
+        /* Accumulate the parts of the edge projected onto the window. */
+        for (j = 0U; j + 1U < m; ++j)
+            raster_line(
+                rmin(rmax(x0 + *(t + j) * (x1 - x0), 0.0), (real_t)R),
+                y0 + *(t + j) * (y1 - y0),
+                rmin(rmax(x0 + *(t + j + 1U) * (x1 - x0), 0.0), (real_t)R),
+                y0 + *(t + j + 1U) * (y1 - y0),
+                R,
+                A
+            );
+    }
+
+    /* Compute the coverage of pixels as the absolute values of the running
+     * sums of the accumulated values along the rows (rounding errors must not
+     * push the coverage above 1). */
+    for (i = 0U; i < R; ++i)
+    {
+        acc = 0.0;
+        for (j = 0U; j < R; ++j)
+        {
+            acc += *(A + i * R + j);
+            u = (acc < 0.0) ? -acc : acc;
+            *(A + i * R + j) = (u < 1.0) ? u : 1.0;
+        }
+    }
+}
+
+/**
+ * Rasterise polygons described by a job.
+ *
+ * The function is intended to be started as a POSIX thread by the
+ * `raster_polygons` function.
+ *
+ * @param job
+ *     Pointer to the job (of type `raster_job_t`).
+ *
+ * @return
+ *     Null-pointer.
+ *
+ * @see raster_polygons
+ *
+ */
+#if !defined(__cplusplus)
+void* raster_job (void* job)
+#else
+inline void* raster_job (void* job)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Job. */
+    const raster_job_t* J;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Job. */
+    J = (const raster_job_t*)job;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* Rasterise the polygons. */
+    if (J)
+        for (i = 0U; i < J->N; ++i)
+            raster_polygon(
+                J->n,
+                J->P + ((i * J->n) << 1U),
+                J->a,
+                J->R,
+                J->A + i * J->R * J->R
+            );
+
+    /* Return the null-pointer. */
+    return NULL;
+}
+
+/**
+ * Rasterise polygons in parallel.
+ *
+ * Polygons are split into `T` contiguous groups of (almost) the same size and
+ * each group is rasterised in its own thread (the first group is rasterised in
+ * the calling thread).  If the memory for the jobs cannot be allocated or if a
+ * thread cannot be created, the polygons are rasterised in the calling thread.
+ *
+ * @param n
+ *     Number of vertices of each polygon.
+ *
+ * @param N
+ *     Number of polygons.
+ *
+ * @param P
+ *     Array of polygons of size at least 2 * `n` * `N`.  Each polygon is
+ *     organised as in the `raster_polygon` function and the polygons are
+ *     stored one after another.
+ *
+ * @param a
+ *     Half of the side of the window.
+ *
+ * @param R
+ *     Resolution of images.
+ *
+ * @param A
+ *     Array of size at least `N` * `R` * `R` to store the images.
+ *
+ * @param T
+ *     Number of threads (if 0, a single thread is used).
+ *
+ * @see raster_polygon
+ * @see raster_job
+ *
+ */
+#if !defined(__cplusplus)
+void raster_polygons (
+    size_t n,
+    size_t N,
+    const real_t* P,
+    real_t a,
+    size_t R,
+    real_t* A,
+    size_t T
+)
+#else
+inline void raster_polygons (
+    ::size_t n,
+    ::size_t N,
+    const real_t* P,
+    real_t a,
+    ::size_t R,
+    real_t* A,
+    ::size_t T
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Array of jobs. */
+    raster_job_t* jobs;
+
+    /* Array of threads. */
+    pthread_t* threads;
+
+    /* Array of indicators of successfully created threads. */
+    bool* created;
+
+    /* Number of polygons in the jobs rasterised so far. */
+    size_t done;
+
+    /* Iteration index. */
+    size_t t;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Array of jobs. */
+    jobs = (raster_job_t*)(NULL);
+
+    /* Array of threads. */
+    threads = (pthread_t*)(NULL);
+
+    /* Array of indicators of successfully created threads. */
+    created = (bool*)(NULL);
+
+    /* Number of polygons in the jobs rasterised so far. */
+    done = 0U;
+
+    /* Iteration index. */
+    t = 0U;
+
+    /* ALGORITHM */
+
+    /* If the pointer `P` or the pointer `A` is a null-pointer, there is
+     * nothing to rasterise. */
+    if (!(P && A))
+        return;
+
+    /* Use at least 1 and at most `N` threads. */
+    if (T > N)
+        T = N;
+    if (!T)
+        T = 1U;
+
+    /* Allocate memory for the jobs, the threads and the indicators. */
+    jobs = (raster_job_t*)malloc(T * sizeof *jobs);
+    threads = (pthread_t*)malloc(T * sizeof *threads);
+    created = (bool*)malloc(T * sizeof *created);
+
+    /* If the memory allocation has failed, deallocate memory and rasterise
+     * all polygons in the calling thread. */
+    if (!(jobs && threads && created))
+    {
+        /* Deallocate memory for the jobs, the threads and the indicators. */
+        free(jobs);
+        jobs = (raster_job_t*)(NULL);
+        free(threads);
+        threads = (pthread_t*)(NULL);
+        free(created);
+        created = (bool*)(NULL);
+
+        /* Rasterise the polygons. */
+        for (t = 0U; t < N; ++t)
+            raster_polygon(n, P + ((t * n) << 1U), a, R, A + t * R * R);
+
+        /* Return from the function. */
+        return;
+    }
+
+    /* Initialise the jobs. */
+    for (t = 0U; t < T; ++t)
+    {
+        (jobs + t)->n = n;
+        (jobs + t)->N = N / T + (t < N % T);
+        (jobs + t)->P = P + ((done * n) << 1U);
+        (jobs + t)->a = a;
+        (jobs + t)->R = R;
+        (jobs + t)->A = A + done * R * R;
+        *(created + t) = false;
+
+        done += (jobs + t)->N;
+    }
+
+    /* Start the threads for all jobs but the first one. */
+    for (t = 1U; t < T; ++t)
+        *(created + t) =
+            !pthread_create(threads + t, NULL, raster_job, (void*)(jobs + t));
+
+    /* Do the first job and the jobs whose threads could not be created in the
+     * calling thread. */
+    for (t = 0U; t < T; ++t)
+        if (!*(created + t))
+            raster_job((void*)(jobs + t));
+
+    /* Wait for the threads to finish. */
+    for (t = 1U; t < T; ++t)
+        if (*(created + t))
+            pthread_join(*(threads + t), NULL);
+
+    /* Clear the memory in the array of jobs. */
+    memset(jobs, 0, T * sizeof *jobs);
+
+    /* Deallocate memory for the jobs, the threads and the indicators. */
+    free(jobs);
+    jobs = (raster_job_t*)(NULL);
+    free(threads);
+    threads = (pthread_t*)(NULL);
+    free(created);
+    created = (bool*)(NULL);
+}
+
+/**
+ * Dump the header of a NumPy array of images to a file.
+ *
+ * The header describes an array (in the ".npy" format, see "npy.h") of shape
+ * (`N`, `R`, `R`) in C order of type `uint8` or `float32` (in the byte order of
+ * the host), so the images dumped by the `dump_raster` function may follow it
+ * directly.
+ *
+ * @param out
+ *     Output file (opened in binary mode).
+ *
+ * @param N
+ *     Number of images.
+ *
+ * @param R
+ *     Resolution of images.
+ *
+ * @param bytes
+ *     If `true`, the type is `uint8`; otherwise the type is `float32`.
+ *
+ * @return
+ *     Value 0 if the header was dumped successfully; a non-zero value
+ *     otherwise.
+ *
+ * @see dump_raster
+ *
+ */
+#if !defined(__cplusplus)
+int dump_raster_header (FILE* out, size_t N, size_t R, bool bytes)
+#else
+inline int dump_raster_header (::FILE* out, ::size_t N, ::size_t R, bool bytes)
+#endif /* __cplusplus */
+{
+    /* Shape of the array. */
+    size_t shape[3U];
+
+    /* Set the shape of the array. */
+    *shape = N;
+    *(shape + 1U) = R;
+    *(shape + 2U) = R;
+
+    /* Dump the header. */
+    return npy_dump_header(
+        out,
+        bytes ? "|u1" : (npy_little_endian() ? "<f4" : ">f4"),
+        3U,
+        shape
+    );
+}
+
+/**
+ * Dump images to a file.
+ *
+ * The values are converted to `float32` or to `uint8` (multiplied by 255 and
+ * rounded) and dumped in the byte order of the host through a small buffer, so
+ * no additional memory is allocated.
+ *
+ * @param out
+ *     Output file (opened in binary mode).
+ *
+ * @param m
+ *     Number of values to dump (number of images times the number of pixels).
+ *
+ * @param A
+ *     Array of values in the range [0, 1] of size at least `m`.
+ *
+ * @param bytes
+ *     If `true`, the values are dumped as `uint8`; otherwise they are dumped
+ *     as `float32`.
+ *
+ * @return
+ *     Number of values successfully dumped.
+ *
+ * @see dump_raster_header
+ *
+ */
+#if !defined(__cplusplus)
+size_t dump_raster (FILE* out, size_t m, const real_t* A, bool bytes)
+#else
+inline ::size_t dump_raster (
+    ::FILE* out,
+    ::size_t m,
+    const real_t* A,
+    bool bytes
+)
+#endif /* __cplusplus */
+{
+    /* Size of the buffers. */
+#if !defined(__cplusplus)
+    static const size_t buffer_size = 4096U;
+#else
+    static const ::size_t buffer_size = 4096U;
+#endif /* __cplusplus */
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Buffers of converted values. */
+    unsigned char buffer_u1[4096U];
+    float buffer_f4[4096U];
+
+    /* Number of values in the buffer. */
+    size_t k;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Buffers of converted values. */
+    memset(buffer_u1, 0, buffer_size * sizeof *buffer_u1);
+    memset(buffer_f4, 0, buffer_size * sizeof *buffer_f4);
+
+    /* Number of values in the buffer. */
+    k = 0U;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, there is nothing to dump. */
+    if (!(out && A))
+        return 0U;
+
+    /* Convert and dump the values through the buffer. */
+    for (i = 0U; i < m; i += k)
+    {
+        /* Compute the number of values in the buffer. */
+        k = (m - i < buffer_size) ? m - i : buffer_size;
+
+        /* Convert and dump the values. */
+        if (bytes)
+        {
+            for (j = 0U; j < k; ++j)
+                *(buffer_u1 + j) = (unsigned char)(255.0 * *(A + i + j) + 0.5);
+            if (fwrite(buffer_u1, sizeof *buffer_u1, k, out) != k)
+                break;
+        }
+        else
+        {
+            for (j = 0U; j < k; ++j)
+                *(buffer_f4 + j) = (float)(*(A + i + j));
+            if (fwrite(buffer_f4, sizeof *buffer_f4, k, out) != k)
+                break;
+        }
+    }
+
+    /* Return the number of values dumped (the values in the buffer that failed
+     * to be dumped are not counted). */
+    return (i < m) ? i : m;
+}
+
+#endif /* __RASTER_H__INCLUDED */
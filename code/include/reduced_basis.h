@@ -0,0 +1,1586 @@
+/**
+ * Functions for the reduced basis approximation of the first Laplace
+ * eigenvalue on triangles.
+ *
+ * Up to similarity, a triangle is determined by its characteristic point
+ * (x, y) (see the function `char_triangle` in "triangle.h"): the triangle is
+ * similar to the canonical triangle with vertices (-1 / 2, 0), (1 / 2, 0),
+ * (x, y), where 0 <= x <= 1 / 2, 0 < y and (x + 1 / 2)^2 + y^2 <= 1.  If the
+ * longest edge of a triangle is of length a, its eigenvalues are the
+ * eigenvalues of its canonical triangle divided by a^2.  By "fem.h", the
+ * finite element eigenvalue problem on the canonical triangle is
+ *     (theta_0 K_0 + theta_1 K_1 + theta_2 K_2) u = lambda M u,
+ * with the coefficients theta_q depending only on (x, y) (an affine
+ * dependence on the parameters theta_q).
+ *
+ * OFFLINE (the function `rb_train`), the characteristic points are sampled on
+ * a grid, and the basis is built greedily:  the finite element eigenvector of
+ * the point with the largest relative error estimate is computed,
+ * orthonormalised in the M-inner product against the basis and added to the
+ * basis, until the largest relative error estimate falls below a tolerance.
+ * The first point is the one of the equilateral triangle.  The projections
+ * A_q = V^T K_q V of the stiffness matrices on the basis V and the Gram
+ * matrices needed for the error estimate are stored in the model.
+ *
+ * ONLINE (the function `rb_online`), the first eigenvalue lambda_N of the small
+ * matrix theta_0 A_0 + theta_1 A_1 + theta_2 A_2 (the basis is orthonormal, so
+ * the reduced mass matrix is the identity) is computed by the QL algorithm
+ * after the Householder reduction to a tridiagonal matrix (the reduced
+ * eigenvector is then recovered by a shifted inverse iteration), in time
+ * independent of the size of the finite element problem.  By the Rayleigh-Ritz
+ * principle lambda_N is an upper bound of the finite element eigenvalue
+ * lambda.  The error is estimated by
+ *     Delta = |r|^2 / (alpha * (1 - lambda_N / lambda_N2)),
+ * where r = (theta_0 K_0 + theta_1 K_1 + theta_2 K_2 - lambda_N M) V c is the
+ * residual of the reduced eigenvector c, |r|^2 is its squared dual norm
+ * r^T X^(-1) r with respect to the reference Laplacian X = K_0 + K_2, alpha is
+ * the smaller eigenvalue of the matrix [theta_0, theta_1; theta_1, theta_2]
+ * (a lower bound of the coercivity constant of the stiffness matrix with
+ * respect to X), and lambda_N2 is the second reduced eigenvalue (1 is used
+ * instead of the fraction if the basis consists of a single vector).  If the
+ * reduced eigenvector is close enough to the finite element eigenvector, the
+ * estimate is an upper bound of lambda_N - lambda.  The dual norm is computed
+ * from the affine decomposition of the residual and the precomputed Gram
+ * matrices C_qp = (K_q V)^T X^(-1) (K_p V), where K_3 denotes M, in time
+ * independent of the size of the finite element problem as well.
+ *
+ * The approximation is of the finite element eigenvalue on the reference mesh
+ * of `m` divisions (see "fem.h"), so its error with respect to the exact
+ * eigenvalue is at least the error of the finite element method.
+ *
+ * A model is dumped as a text file:  the first line contains m and N (the
+ * size of the basis), followed by the matrices A_0, A_1, A_2 and the matrices
+ * C_qp (ordered by q, and by p for the same q), each as N lines of N values.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__REDUCED_BASIS_H__INCLUDED) && (__REDUCED_BASIS_H__INCLUDED) == 1)
+
+/* Undefine __REDUCED_BASIS_H__INCLUDED if it has already been defined. */
+#if defined(__REDUCED_BASIS_H__INCLUDED)
+#undef __REDUCED_BASIS_H__INCLUDED
+#endif /* __REDUCED_BASIS_H__INCLUDED */
+
+/* Define __REDUCED_BASIS_H__INCLUDED as 1. */
+#define __REDUCED_BASIS_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+#include "triangle.h"
+#include "fem.h"
+
+/* Define constants. */
+
+/**
+ * Number of terms of the affine decomposition of the residual (3 stiffness
+ * matrices and the mass matrix).
+ *
+ */
+#define RB_TERMS 4U
+
+/* Define types. */
+
+/**
+ * Reduced basis model.
+ *
+ * The reduced matrices are stored in row-major order with the leading
+ * dimension `L` (the capacity of the basis), so that the model can grow
+ * during the training.
+ *
+ */
+typedef struct rb_model_struct
+{
+    /* Number of divisions of each edge of the reference triangle. */
+    size_t m;
+
+    /* Size of the basis. */
+    size_t N;
+
+    /* Capacity of the basis. */
+    size_t L;
+
+    /* Reduced stiffness matrices A_0, A_1, A_2 (each of size `L` * `L`). */
+    real_t* A;
+
+    /* Gram matrices C_qp (each of size `L` * `L`, the matrix C_qp is the
+     * (RB_TERMS * q + p)-th matrix). */
+    real_t* C;
+}
+rb_model_t;
+
+/* Define functions. */
+
+/**
+ * Allocate memory for a model.
+ *
+ * @param model
+ *     Pointer to the model.
+ *
+ * @param m
+ *     Number of divisions of each edge of the reference triangle.
+ *
+ * @param L
+ *     Capacity of the basis (at least 1).
+ *
+ * @return
+ *     Value `true` if the memory was allocated, `false` otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+bool rb_allocate (rb_model_t* model, size_t m, size_t L)
+#else
+inline bool rb_allocate (rb_model_t* model, ::size_t m, ::size_t L)
+#endif /* __cplusplus */
+{
+    /* If the pointer `model` is a null-pointer or if the capacity is 0, return
+     * `false`. */
+    if (!(model && L))
+        return false;
+
+    /* Set the sizes. */
+    model->m = m;
+    model->N = 0U;
+    model->L = L;
+
+    /* Allocate memory for the matrices. */
+#if !defined(__cplusplus)
+    model->A = (real_t*)calloc(3U * L * L, sizeof *model->A);
+    model->C = (real_t*)calloc(RB_TERMS * RB_TERMS * L * L, sizeof *model->C);
+#else
+    model->A = static_cast<real_t*>(::calloc(3U * L * L, sizeof *model->A));
+    model->C =
+        static_cast<real_t*>(
+            ::calloc(RB_TERMS * RB_TERMS * L * L, sizeof *model->C)
+        );
+#endif /* __cplusplus */
+
+    /* If the memory allocation has failed, deallocate memory and return
+     * `false`. */
+    if (!(model->A && model->C))
+    {
+        free(model->A);
+        model->A = (real_t*)(NULL);
+        free(model->C);
+        model->C = (real_t*)(NULL);
+
+        return false;
+    }
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Deallocate memory of a model.
+ *
+ * @param model
+ *     Pointer to the model.
+ *
+ */
+#if !defined(__cplusplus)
+void rb_free (rb_model_t* model)
+#else
+inline void rb_free (rb_model_t* model)
+#endif /* __cplusplus */
+{
+    /* If the pointer `model` is a null-pointer, there is nothing to
+     * deallocate. */
+    if (!model)
+        return;
+
+    /* Deallocate memory for the matrices. */
+    if (model->A)
+        memset(model->A, 0, 3U * model->L * model->L * sizeof *model->A);
+    free(model->A);
+    model->A = (real_t*)(NULL);
+    if (model->C)
+        memset(
+            model->C,
+            0,
+            RB_TERMS * RB_TERMS * model->L * model->L * sizeof *model->C
+        );
+    free(model->C);
+    model->C = (real_t*)(NULL);
+
+    /* Reset the sizes. */
+    model->m = 0U;
+    model->N = 0U;
+    model->L = 0U;
+}
+
+/**
+ * Compute the coefficients of the canonical triangle.
+ *
+ * @param x
+ *     The x-coordinate of the characteristic point.
+ *
+ * @param y
+ *     The y-coordinate of the characteristic point (strictly positive).
+ *
+ * @param theta
+ *     Array of size 3 to store the coefficients theta_0, theta_1, theta_2.
+ *
+ * @return
+ *     Lower bound of the coercivity constant with respect to the reference
+ *     Laplacian (the smaller eigenvalue of the matrix
+ *     [theta_0, theta_1; theta_1, theta_2]), or 0 if the triangle is
+ *     degenerate.
+ *
+ * @see fem_coefficients
+ *
+ */
+#if !defined(__cplusplus)
+real_t rb_coefficients (real_t x, real_t y, real_t* theta)
+#else
+inline real_t rb_coefficients (real_t x, real_t y, real_t* theta)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Vertices of the canonical triangle. */
+    real_t T[6];
+
+    /* Half of the trace and the determinant of the coefficient matrix. */
+    real_t h;
+    real_t d;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Vertices of the canonical triangle. */
+    T[0] = -0.5;
+    T[1] = 0.0;
+    T[2] = 0.5;
+    T[3] = 0.0;
+    T[4] = x;
+    T[5] = y;
+
+    /* Half of the trace and the determinant of the coefficient matrix. */
+    h = 0.0;
+    d = 0.0;
+
+    /* ALGORITHM */
+
+    /* Compute the coefficients.  If the triangle is degenerate, return 0. */
+    if (!fem_coefficients(T, theta))
+        return 0.0;
+
+    /* Compute the smaller eigenvalue of the coefficient matrix. */
+    h = 0.5 * (*theta + *(theta + 2U));
+    d = *theta * *(theta + 2U) - *(theta + 1U) * *(theta + 1U);
+
+    return d / (h + rsqrt(rmax(h * h - d, 0.0)));
+}
+
+/**
+ * Reduce a small symmetric matrix to a tridiagonal matrix.
+ *
+ * The Householder reduction is used (without accumulating the orthogonal
+ * transformation, since only the eigenvalues are needed).
+ *
+ * @param N
+ *     Size of the matrix.
+ *
+ * @param S
+ *     Symmetric matrix of size at least `N` * `N`.
+ *
+ *     Caution: the array `S` is mutated in the function.
+ *
+ * @param d
+ *     Array of size at least `N` to store the diagonal of the tridiagonal
+ *     matrix.
+ *
+ * @param e
+ *     Array of size at least `N` to store the subdiagonal of the tridiagonal
+ *     matrix (the entry `e[i]` is the entry left of `d[i]`, `e[0]` is 0).
+ *
+ */
+#if !defined(__cplusplus)
+void rb_tridiagonalise (size_t N, real_t* S, real_t* d, real_t* e)
+#else
+inline void rb_tridiagonalise (::size_t N, real_t* S, real_t* d, real_t* e)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Auxiliary values of the Householder reflection. */
+    real_t scale;
+    real_t h;
+    real_t hh;
+    real_t f;
+    real_t g;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t k;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Auxiliary values of the Householder reflection. */
+    scale = 0.0;
+    h = 0.0;
+    hh = 0.0;
+    f = 0.0;
+    g = 0.0;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    k = 0U;
+
+    /* ALGORITHM */
+
+    /* Annihilate the rows from the last to the third by reflecting the
+     * entries left of the subdiagonal. */
+    for (i = N; i-- > 1U; )
+    {
+        h = 0.0;
+        scale = 0.0;
+        if (i > 1U)
+        {
+            for (k = 0U; k < i; ++k)
+                scale += rabs(*(S + i * N + k));
+        }
+        if (!(i > 1U) || scale == 0.0)
+        {
+            *(e + i) = *(S + i * N + i - 1U);
+            *(d + i) = 0.0;
+
+            continue;
+        }
+
+        /* Compute the Householder vector (stored in the row `i`). */
+        for (k = 0U; k < i; ++k)
+        {
+            *(S + i * N + k) /= scale;
+            h += *(S + i * N + k) * *(S + i * N + k);
+        }
+        f = *(S + i * N + i - 1U);
+        g = (f < 0.0) ? rsqrt(h) : -rsqrt(h);
+        *(e + i) = scale * g;
+        h -= f * g;
+        *(S + i * N + i - 1U) = f - g;
+
+        /* Compute p = S u / h (stored in `e`) and K = u^T p / (2 h). */
+        f = 0.0;
+        for (j = 0U; j < i; ++j)
+        {
+            g = 0.0;
+            for (k = 0U; k <= j; ++k)
+                g += *(S + j * N + k) * *(S + i * N + k);
+            for (k = j + 1U; k < i; ++k)
+                g += *(S + k * N + j) * *(S + i * N + k);
+            *(e + j) = g / h;
+            f += *(e + j) * *(S + i * N + j);
+        }
+        hh = f / (h + h);
+
+        /* Reduce the leading submatrix as S - q u^T - u q^T, where
+         * q = p - K u (the lower triangle is updated). */
+        for (j = 0U; j < i; ++j)
+        {
+            f = *(S + i * N + j);
+            g = *(e + j) - hh * f;
+            *(e + j) = g;
+            for (k = 0U; k <= j; ++k)
+                *(S + j * N + k) -= f * *(e + k) + g * *(S + i * N + k);
+        }
+        *(d + i) = h;
+    }
+
+    /* Extract the diagonal. */
+    *e = 0.0;
+    for (i = 0U; i < N; ++i)
+        *(d + i) = *(S + i * N + i);
+}
+
+/**
+ * Compute the eigenvalues of a symmetric tridiagonal matrix.
+ *
+ * The QL algorithm with implicit shifts is used.
+ *
+ * @param N
+ *     Size of the matrix.
+ *
+ * @param d
+ *     Array of size at least `N` of the diagonal of the matrix.  On return,
+ *     it contains the eigenvalues (not sorted).
+ *
+ *     Caution: the array `d` is mutated in the function.
+ *
+ * @param e
+ *     Array of size at least `N` of the subdiagonal of the matrix as returned
+ *     by the function `rb_tridiagonalise`.
+ *
+ *     Caution: the array `e` is mutated in the function.
+ *
+ * @return
+ *     Value `true` if the algorithm converged, `false` otherwise.
+ *
+ * @see rb_tridiagonalise
+ *
+ */
+#if !defined(__cplusplus)
+bool rb_tridiagonal_eigenvalues (size_t N, real_t* d, real_t* e)
+#else
+inline bool rb_tridiagonal_eigenvalues (::size_t N, real_t* d, real_t* e)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Maximal number of iterations per eigenvalue. */
+    const size_t max_iterations = 64U;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Auxiliary values of the rotations. */
+    real_t s;
+    real_t c;
+    real_t p;
+    real_t r;
+    real_t f;
+    real_t g;
+    real_t b;
+    real_t dd;
+
+    /* Has an underflow occured? */
+    bool underflow;
+
+    /* Number of iterations. */
+    size_t iterations;
+
+    /* Iteration indices. */
+    size_t l;
+    size_t m;
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Auxiliary values of the rotations. */
+    s = 0.0;
+    c = 0.0;
+    p = 0.0;
+    r = 0.0;
+    f = 0.0;
+    g = 0.0;
+    b = 0.0;
+    dd = 0.0;
+
+    /* Has an underflow occured? */
+    underflow = false;
+
+    /* Number of iterations. */
+    iterations = 0U;
+
+    /* Iteration indices. */
+    l = 0U;
+    m = 0U;
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* Renumber the subdiagonal so that `e[i]` is the entry right of `d[i]`. */
+    for (i = 1U; i < N; ++i)
+        *(e + i - 1U) = *(e + i);
+    if (N)
+        *(e + N - 1U) = 0.0;
+
+    /* Find the eigenvalues one by one. */
+    for (l = 0U; l < N; ++l)
+        for (iterations = 0U; ; )
+        {
+            /* Find a negligible subdiagonal entry to split the matrix. */
+            for (m = l; m + 1U < N; ++m)
+            {
+                dd = rabs(*(d + m)) + rabs(*(d + m + 1U));
+                if (rabs(*(e + m)) + dd == dd)
+                    break;
+            }
+            if (m == l)
+                break;
+            if (++iterations > max_iterations)
+                return false;
+
+            /* Compute the shift. */
+            g = (*(d + l + 1U) - *(d + l)) / (2.0 * *(e + l));
+            r = rsqrt(g * g + 1.0);
+            g = *(d + m) - *(d + l) + *(e + l) / (g + ((g < 0.0) ? -r : r));
+
+            /* Chase the bulge with plane rotations. */
+            s = 1.0;
+            c = 1.0;
+            p = 0.0;
+            underflow = false;
+            for (i = m; i-- > l; )
+            {
+                f = s * *(e + i);
+                b = c * *(e + i);
+                r = rsqrt(f * f + g * g);
+                *(e + i + 1U) = r;
+                if (r == 0.0)
+                {
+                    *(d + i + 1U) -= p;
+                    *(e + m) = 0.0;
+                    underflow = true;
+
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = *(d + i + 1U) - p;
+                r = (*(d + i) - g) * s + 2.0 * c * b;
+                p = s * r;
+                *(d + i + 1U) = g + p;
+                g = c * r - b;
+            }
+            if (underflow)
+                continue;
+            *(d + l) -= p;
+            *(e + l) = g;
+            *(e + m) = 0.0;
+        }
+
+    /* Return `true`. */
+    return true;
+}
+/**
+ * Approximate the first eigenvalue on a canonical triangle.
+ *
+ * @param model
+ *     Pointer to the model with a nonempty basis.
+ *
+ * @param x
+ *     The x-coordinate of the characteristic point.
+ *
+ * @param y
+ *     The y-coordinate of the characteristic point.
+ *
+ * @param ev
+ *     Memory location to store the approximation of the first eigenvalue.
+ *
+ * @param err
+ *     Memory location to store the estimate of its error.
+ *
+ * @param work
+ *     Array of size at least 2 * N * N + 3 * N, where N is the size of the
+ *     basis, for auxiliary computations.  If the reduced eigenvector is
+ *     needed, it is stored in the first N entries on return.
+ *
+ * @return
+ *     Value `true` if the approximation was computed, `false` otherwise (the
+ *     triangle is degenerate or the basis is empty).
+ *
+ */
+#if !defined(__cplusplus)
+bool rb_online (
+    const rb_model_t* model,
+    real_t x,
+    real_t y,
+    real_t* ev,
+    real_t* err,
+    real_t* work
+)
+#else
+inline bool rb_online (
+    const rb_model_t* model,
+    real_t x,
+    real_t y,
+    real_t* ev,
+    real_t* err,
+    real_t* work
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Size and capacity of the basis. */
+    size_t N;
+    size_t L;
+
+    /* Coefficients of the affine decomposition of the residual. */
+    real_t theta[RB_TERMS];
+
+    /* Lower bound of the coercivity constant. */
+    real_t alpha;
+
+    /* The first two reduced eigenvalues. */
+    real_t l1;
+    real_t l2;
+
+    /* Shift of the inverse iteration. */
+    real_t shift;
+
+    /* Squared dual norm of the residual and its term. */
+    real_t r2;
+    real_t r;
+
+    /* Reduced eigenvector, matrix, its tridiagonal reduction and the
+     * diagonal and the subdiagonal of the reduction. */
+    real_t* c;
+    real_t* S;
+    real_t* T;
+    real_t* d;
+    real_t* e;
+
+    /* Pointer to the current Gram matrix. */
+    const real_t* C;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t q;
+    size_t p;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Size and capacity of the basis. */
+    N = model->N;
+    L = model->L;
+
+    /* Coefficients of the affine decomposition of the residual. */
+    memset(theta, 0, sizeof theta);
+
+    /* Lower bound of the coercivity constant. */
+    alpha = 0.0;
+
+    /* The first two reduced eigenvalues. */
+    l1 = 0.0;
+    l2 = 0.0;
+
+    /* Shift of the inverse iteration. */
+    shift = 0.0;
+
+    /* Squared dual norm of the residual and its term. */
+    r2 = 0.0;
+    r = 0.0;
+
+    /* Reduced eigenvector, matrix, its tridiagonal reduction and the
+     * diagonal and the subdiagonal of the reduction. */
+    c = work;
+    S = work + N;
+    T = work + N + N * N;
+    d = work + N + ((N * N) << 1U);
+    e = work + (N << 1U) + ((N * N) << 1U);
+
+    /* Pointer to the current Gram matrix. */
+    C = (const real_t*)(NULL);
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    q = 0U;
+    p = 0U;
+
+    /* ALGORITHM */
+
+    /* If the basis is empty, return `false`. */
+    if (!N)
+        return false;
+
+    /* Compute the coefficients.  If the triangle is degenerate, return
+     * `false`. */
+    alpha = rb_coefficients(x, y, theta);
+    if (!(0.0 < alpha))
+        return false;
+
+    /* Combine the lower triangles of the reduced stiffness matrices. */
+    for (i = 0U; i < N; ++i)
+        for (j = 0U; j <= i; ++j)
+        {
+            *(S + i * N + j) =
+                theta[0] * *(model->A + i * L + j) +
+                theta[1] * *(model->A + L * L + i * L + j) +
+                theta[2] * *(model->A + ((L * L) << 1U) + i * L + j);
+            *(T + i * N + j) = *(S + i * N + j);
+        }
+
+    /* Compute the eigenvalues and find the first two.  If the algorithm did
+     * not converge, return `false`. */
+    rb_tridiagonalise(N, T, d, e);
+    if (!rb_tridiagonal_eigenvalues(N, d, e))
+        return false;
+    l1 = *d;
+    l2 = *d;
+    for (i = 1U; i < N; ++i)
+        if (*(d + i) < l1)
+        {
+            l2 = l1;
+            l1 = *(d + i);
+        }
+        else if (l2 == l1 || *(d + i) < l2)
+            l2 = *(d + i);
+
+    /* Compute the reduced eigenvector by the inverse iteration shifted
+     * slightly below the first eigenvalue, so that the shifted matrix is
+     * positive definite and the iteration converges in a few steps.  If the
+     * shifted matrix is numerically singular, the shift is enlarged. */
+    for (
+        shift = 1.0e-6 * ((l1 < l2) ? l2 - l1 : rabs(l1));
+        ;
+        shift *= 1.0e3
+    )
+    {
+        for (i = 0U; i < N; ++i)
+            for (j = 0U; j <= i; ++j)
+                *(T + i * N + j) = *(S + i * N + j);
+        for (i = 0U; i < N; ++i)
+            *(T + i * N + i) -= l1 - shift;
+        if (fem_cholesky(N, T))
+            break;
+        if (!(shift < rabs(l1)))
+            return false;
+    }
+    for (i = 0U; i < N; ++i)
+        *(c + i) = 1.0;
+    for (q = 0U; q < 3U; ++q)
+    {
+        fem_cholesky_solve(N, T, c);
+        r = 0.0;
+        for (i = 0U; i < N; ++i)
+            r += *(c + i) * *(c + i);
+        r = rsqrt(r);
+        for (i = 0U; i < N; ++i)
+            *(c + i) /= r;
+    }
+
+    /* Compute the squared dual norm of the residual. */
+    theta[3] = -l1;
+    for (q = 0U; q < RB_TERMS; ++q)
+        for (p = 0U; p < RB_TERMS; ++p)
+        {
+            C = model->C + (q * RB_TERMS + p) * L * L;
+            r = 0.0;
+            for (i = 0U; i < N; ++i)
+                for (j = 0U; j < N; ++j)
+                    r += *(c + i) * *(C + i * L + j) * *(c + j);
+            r2 += theta[q] * theta[p] * r;
+        }
+
+    /* Save the eigenvalue and the estimate of its error. */
+    *ev = l1;
+    *err = rmax(r2, 0.0) / alpha;
+    if (l1 < l2)
+        *err /= 1.0 - l1 / l2;
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Approximate the first eigenvalue on a triangle.
+ *
+ * @param model
+ *     Pointer to the model with a nonempty basis.
+ *
+ * @param T
+ *     Array of coordinates of the vertices of size 6.  The array is organised
+ *     as `{x_0, y_0, x_1, y_1, x_2, y_2}`, where `x_i` is the x-coordinate of
+ *     the `i`-th vertex and `y_i` is its y-coordinate.  The vertices may be
+ *     enumerated in any direction.
+ *
+ * @param ev
+ *     Memory location to store the approximation of the first eigenvalue.
+ *
+ * @param err
+ *     Memory location to store the estimate of its error.
+ *
+ * @param work
+ *     Array for auxiliary computations as in the function `rb_online`.
+ *
+ * @return
+ *     Value `true` if the approximation was computed, `false` otherwise.
+ *
+ * @see rb_online
+ *
+ */
+#if !defined(__cplusplus)
+bool rb_solve (
+    const rb_model_t* model,
+    const real_t* T,
+    real_t* ev,
+    real_t* err,
+    real_t* work
+)
+#else
+inline bool rb_solve (
+    const rb_model_t* model,
+    const real_t* T,
+    real_t* ev,
+    real_t* err,
+    real_t* work
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Differences in coordinates, lengths of edges and outer angles. */
+    real_t dx[3];
+    real_t dy[3];
+    real_t l[3];
+    real_t phi[3];
+
+    /* Characteristic point. */
+    real_t x;
+    real_t y;
+
+    /* Square of the length of the longest edge. */
+    real_t a2;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Differences in coordinates, lengths of edges and outer angles. */
+    memset(dx, 0, sizeof dx);
+    memset(dy, 0, sizeof dy);
+    memset(l, 0, sizeof l);
+    memset(phi, 0, sizeof phi);
+
+    /* Characteristic point. */
+    x = 0.0;
+    y = 0.0;
+
+    /* Square of the length of the longest edge. */
+    a2 = 0.0;
+
+    /* ALGORITHM */
+
+    /* Find the characteristic point and the length of the longest edge. */
+    describe_polygon(3U, T, dx, dy, l, phi);
+    char_triangle(l, phi, &x, &y, false);
+    a2 = rmax(l[0], rmax(l[1], l[2]));
+    a2 *= a2;
+
+    /* Approximate the eigenvalue on the canonical triangle and scale it. */
+    if (!(0.0 < a2 && rb_online(model, x, y, ev, err, work)))
+        return false;
+    *ev /= a2;
+    *err /= a2;
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Approximate the first eigenvalues on a batch of triangles.
+ *
+ * @param model
+ *     Pointer to the model with a nonempty basis.
+ *
+ * @param N
+ *     Number of triangles.
+ *
+ * @param P
+ *     Array of triangles of size at least 6 * `N` (each triangle organised as
+ *     in the function `rb_solve`).
+ *
+ * @param out
+ *     Array of size at least 2 * `N` to store the approximation of the first
+ *     eigenvalue and the estimate of its error for each triangle (in this
+ *     order).  Both are set to `lambda` (the undefined real number, see
+ *     "numeric.h") for triangles on which the approximation could not be
+ *     computed.
+ *
+ * @return
+ *     Number of triangles on which the approximation could not be computed,
+ *     or `N` + 1 if the memory allocation has failed.
+ *
+ * @see rb_solve
+ *
+ */
+#if !defined(__cplusplus)
+size_t rb_solve_batch (
+    const rb_model_t* model,
+    size_t N,
+    const real_t* P,
+    real_t* out
+)
+#else
+inline ::size_t rb_solve_batch (
+    const rb_model_t* model,
+    ::size_t N,
+    const real_t* P,
+    real_t* out
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Size of the workspace. */
+    size_t size;
+
+    /* Workspace. */
+    real_t* work;
+
+    /* Number of failed triangles. */
+    size_t failed;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Size of the workspace. */
+    size = ((model->N * model->N) << 1U) + 3U * model->N;
+
+    /* Workspace. */
+#if !defined(__cplusplus)
+    work = (real_t*)malloc(size * sizeof *work);
+#else
+    work = static_cast<real_t*>(::malloc(size * sizeof *work));
+#endif /* __cplusplus */
+
+    /* Number of failed triangles. */
+    failed = 0U;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If the memory allocation has failed, return `N` + 1. */
+    if (!work)
+        return N + 1U;
+
+    /* Approximate the eigenvalues. */
+    for (i = 0U; i < N; ++i)
+        if (
+            !rb_solve(
+                model,
+                P + 6U * i,
+                out + (i << 1U),
+                out + (i << 1U) + 1U,
+                work
+            )
+        )
+        {
+            *(out + (i << 1U)) = lambda;
+            *(out + (i << 1U) + 1U) = lambda;
+            ++failed;
+        }
+
+    /* Deallocate memory for the workspace. */
+    memset(work, 0, size * sizeof *work);
+    free(work);
+    work = (real_t*)(NULL);
+
+    /* Return the number of failed triangles. */
+    return failed;
+}
+
+/**
+ * Train a model.
+ *
+ * The characteristic points are sampled on the grid of `K` x `K` points
+ * (x_i, y_j), where x_i = i / (2 (K - 1)) and
+ * y_j = y_min + j (sqrt(3) / 2 - y_min) / (K - 1), restricted to the points
+ * of nondegenerate canonical triangles ((x + 1 / 2)^2 + y^2 <= 1).
+ *
+ * @param model
+ *     Pointer to the model to train.  The memory is allocated in the
+ *     function, the model must be freed by the function `rb_free`.
+ *
+ * @param m
+ *     Number of divisions of each edge of the reference triangle (at least 3).
+ *
+ * @param K
+ *     Number of samples of each coordinate of the characteristic point (at
+ *     least 2).
+ *
+ * @param y_min
+ *     Smallest sampled y-coordinate (strictly positive).
+ *
+ * @param N_max
+ *     Maximal size of the basis (at least 1).
+ *
+ * @param tol
+ *     Tolerance for the largest relative error estimate.
+ *
+ * @param log
+ *     File to print the size of the basis and the largest relative error
+ *     estimate after each step to, or a null-pointer.
+ *
+ * @return
+ *     Value 0 if the training succeeded, a non-zero value otherwise (if the
+ *     arguments are illegal, if the memory allocation has failed, or if a
+ *     finite element problem could not be solved).
+ *
+ * @see rb_free
+ *
+ */
+#if !defined(__cplusplus)
+int rb_train (
+    rb_model_t* model,
+    size_t m,
+    size_t K,
+    real_t y_min,
+    size_t N_max,
+    real_t tol,
+    FILE* log
+)
+#else
+inline int rb_train (
+    rb_model_t* model,
+    ::size_t m,
+    ::size_t K,
+    real_t y_min,
+    ::size_t N_max,
+    real_t tol,
+    ::FILE* log
+)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Tolerance and maximal number of iterations for the finite element
+     * eigenvalue problem. */
+    const real_t fem_tol = 8.0 * tolerance;
+    const size_t fem_maxit = 1000U;
+
+    /* Norm below which an orthogonalised eigenvector is considered to be in
+     * the span of the basis. */
+    const real_t span_tol = 8192.0 * tolerance;
+
+    /* The y-coordinate of the characteristic point of the equilateral
+     * triangle. */
+    const real_t y_max = 0.86602540378443864676;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Number of unknowns and its square. */
+    size_t n;
+    size_t nn;
+
+    /* Number of training points. */
+    size_t S;
+
+    /* Reference matrices, factorised reference Laplacian and factorised
+     * stiffness matrix. */
+    real_t* K3;
+    real_t* M;
+    real_t* X;
+    real_t* A;
+
+    /* Basis V, its images B_q = K_q V (with K_3 = M) and the Riesz
+     * representatives Z_q = X^(-1) B_q (each vector of size `n`). */
+    real_t* V;
+    real_t* B;
+    real_t* Z;
+
+    /* Training points. */
+    real_t* mu;
+
+    /* Auxiliary vectors and workspace for the online solution. */
+    real_t* u;
+    real_t* w;
+    real_t* work;
+
+    /* Coefficients. */
+    real_t theta[3];
+
+    /* Selected training point, its error estimate and the largest relative
+     * error estimate. */
+    size_t selected;
+    real_t worst;
+    real_t ev;
+    real_t err;
+
+    /* Accumulated value. */
+    real_t s;
+
+    /* Status of the training. */
+    int status;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t q;
+    size_t p;
+    size_t b;
+    size_t L;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Number of unknowns and its square. */
+    n = fem_size(m);
+    nn = n * n;
+
+    /* Number of training points. */
+    S = 0U;
+
+    /* Matrices. */
+    K3 = (real_t*)(NULL);
+    M = (real_t*)(NULL);
+    X = (real_t*)(NULL);
+    A = (real_t*)(NULL);
+
+    /* Basis and its images. */
+    V = (real_t*)(NULL);
+    B = (real_t*)(NULL);
+    Z = (real_t*)(NULL);
+
+    /* Training points. */
+    mu = (real_t*)(NULL);
+
+    /* Auxiliary vectors and workspace. */
+    u = (real_t*)(NULL);
+    w = (real_t*)(NULL);
+    work = (real_t*)(NULL);
+
+    /* Coefficients. */
+    memset(theta, 0, sizeof theta);
+
+    /* Selected training point and error estimates. */
+    selected = 0U;
+    worst = 0.0;
+    ev = 0.0;
+    err = 0.0;
+
+    /* Accumulated value. */
+    s = 0.0;
+
+    /* Status of the training. */
+    status = 1;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    q = 0U;
+    p = 0U;
+    b = 0U;
+    L = N_max;
+
+    /* ALGORITHM */
+
+    /* Check the arguments. */
+    if (!(model && n && K > 1U && 0.0 < y_min && y_min < y_max && N_max))
+        return 1;
+
+    /* Allocate memory for the model. */
+    if (!rb_allocate(model, m, L))
+        return 1;
+
+    /* Allocate memory for the matrices, the basis, the training points and
+     * the auxiliary vectors. */
+#if !defined(__cplusplus)
+    K3 = (real_t*)malloc(3U * nn * sizeof *K3);
+    M = (real_t*)malloc(nn * sizeof *M);
+    X = (real_t*)malloc(nn * sizeof *X);
+    A = (real_t*)malloc(nn * sizeof *A);
+    V = (real_t*)malloc(L * n * sizeof *V);
+    B = (real_t*)malloc(RB_TERMS * L * n * sizeof *B);
+    Z = (real_t*)malloc(RB_TERMS * L * n * sizeof *Z);
+    mu = (real_t*)malloc(((K * K) << 1U) * sizeof *mu);
+    u = (real_t*)malloc(n * sizeof *u);
+    w = (real_t*)malloc(n * sizeof *w);
+    work = (real_t*)malloc((((L * L) << 1U) + 3U * L) * sizeof *work);
+#else
+    K3 = static_cast<real_t*>(::malloc(3U * nn * sizeof *K3));
+    M = static_cast<real_t*>(::malloc(nn * sizeof *M));
+    X = static_cast<real_t*>(::malloc(nn * sizeof *X));
+    A = static_cast<real_t*>(::malloc(nn * sizeof *A));
+    V = static_cast<real_t*>(::malloc(L * n * sizeof *V));
+    B = static_cast<real_t*>(::malloc(RB_TERMS * L * n * sizeof *B));
+    Z = static_cast<real_t*>(::malloc(RB_TERMS * L * n * sizeof *Z));
+    mu = static_cast<real_t*>(::malloc(((K * K) << 1U) * sizeof *mu));
+    u = static_cast<real_t*>(::malloc(n * sizeof *u));
+    w = static_cast<real_t*>(::malloc(n * sizeof *w));
+    work =
+        static_cast<real_t*>(
+            ::malloc((((L * L) << 1U) + 3U * L) * sizeof *work)
+        );
+#endif /* __cplusplus */
+
+    /* Train the model in a `do-while (false)`-block so that the memory is
+     * deallocated after a `break`. */
+    do
+    {
+        /* If the memory allocation has failed, stop. */
+        if (!(K3 && M && X && A && V && B && Z && mu && u && w && work))
+            break;
+
+        /* Sample the training points.  The first point is the equilateral
+         * triangle. */
+        *mu = 0.0;
+        *(mu + 1U) = y_max;
+        S = 1U;
+        for (i = 0U; i < K; ++i)
+            for (j = 0U; j < K; ++j)
+            {
+                *(mu + (S << 1U)) = 0.5 * (real_t)i / (real_t)(K - 1U);
+                *(mu + (S << 1U) + 1U) =
+                    y_min + (y_max - y_min) * (real_t)j / (real_t)(K - 1U);
+                if (
+                    (*(mu + (S << 1U)) + 0.5) * (*(mu + (S << 1U)) + 0.5) +
+                        *(mu + (S << 1U) + 1U) * *(mu + (S << 1U) + 1U) <=
+                    1.0 + 64.0 * tolerance
+                )
+                    ++S;
+            }
+
+        /* Assemble the reference matrices and factorise the reference
+         * Laplacian. */
+        fem_assemble(m, K3, M);
+        for (i = 0U; i < nn; ++i)
+            *(X + i) = *(K3 + i) + *(K3 + (nn << 1U) + i);
+        if (!fem_cholesky(n, X))
+            break;
+
+        /* Build the basis greedily. */
+        status = 0;
+        for (selected = 0U; model->N < L; )
+        {
+            /* Solve the finite element problem on the selected point. */
+            rb_coefficients(
+                *(mu + (selected << 1U)),
+                *(mu + (selected << 1U) + 1U),
+                theta
+            );
+            fem_combine(n, K3, theta, A);
+            if (!fem_cholesky(n, A))
+            {
+                status = 1;
+
+                break;
+            }
+            fem_eigen(n, A, M, fem_tol, fem_maxit, u, w);
+
+            /* Orthonormalise the eigenvector against the basis in the
+             * M-inner product (twice, for numerical stability).  The images
+             * M v_b are stored in B_3. */
+            for (q = 0U; q < 2U; ++q)
+                for (b = 0U; b < model->N; ++b)
+                {
+                    s = 0.0;
+                    for (i = 0U; i < n; ++i)
+                        s += *(B + (3U * L + b) * n + i) * *(u + i);
+                    for (i = 0U; i < n; ++i)
+                        *(u + i) -= s * *(V + b * n + i);
+                }
+            for (i = 0U; i < n; ++i)
+            {
+                *(w + i) = 0.0;
+                for (j = 0U; j < n; ++j)
+                    *(w + i) += *(M + i * n + j) * *(u + j);
+            }
+            s = 0.0;
+            for (i = 0U; i < n; ++i)
+                s += *(u + i) * *(w + i);
+
+            /* If the eigenvector is (numerically) in the span of the basis,
+             * the basis cannot be improved. */
+            if (!(span_tol * span_tol < s))
+                break;
+
+            /* Add the normalised vector to the basis. */
+            b = model->N;
+            s = rsqrt(s);
+            for (i = 0U; i < n; ++i)
+                *(V + b * n + i) = *(u + i) / s;
+
+            /* Compute its images and their Riesz representatives. */
+            for (q = 0U; q < RB_TERMS; ++q)
+            {
+                for (i = 0U; i < n; ++i)
+                {
+                    s = 0.0;
+                    for (j = 0U; j < n; ++j)
+                        s += (
+                            (q < 3U) ?
+                                *(K3 + q * nn + i * n + j) :
+                                *(M + i * n + j)
+                        ) * *(V + b * n + j);
+                    *(B + (q * L + b) * n + i) = s;
+                }
+                memcpy(
+                    Z + (q * L + b) * n,
+                    B + (q * L + b) * n,
+                    n * sizeof *Z
+                );
+                fem_cholesky_solve(n, X, Z + (q * L + b) * n);
+            }
+
+            /* Update the reduced stiffness matrices and the Gram matrices. */
+            for (j = 0U; j <= b; ++j)
+            {
+                for (q = 0U; q < 3U; ++q)
+                {
+                    s = 0.0;
+                    for (i = 0U; i < n; ++i)
+                        s +=
+                            *(V + j * n + i) * *(B + (q * L + b) * n + i);
+                    *(model->A + q * L * L + j * L + b) = s;
+                    *(model->A + q * L * L + b * L + j) = s;
+                }
+                for (q = 0U; q < RB_TERMS; ++q)
+                    for (p = 0U; p < RB_TERMS; ++p)
+                    {
+                        s = 0.0;
+                        for (i = 0U; i < n; ++i)
+                            s +=
+                                *(B + (q * L + j) * n + i) *
+                                *(Z + (p * L + b) * n + i);
+                        *(model->C + (q * RB_TERMS + p) * L * L + j * L + b) =
+                            s;
+                        s = 0.0;
+                        for (i = 0U; i < n; ++i)
+                            s +=
+                                *(B + (q * L + b) * n + i) *
+                                *(Z + (p * L + j) * n + i);
+                        *(model->C + (q * RB_TERMS + p) * L * L + b * L + j) =
+                            s;
+                    }
+            }
+            ++model->N;
+
+            /* Find the training point with the largest relative error
+             * estimate. */
+            worst = 0.0;
+            for (i = 0U; i < S; ++i)
+                if (
+                    rb_online(
+                        model,
+                        *(mu + (i << 1U)),
+                        *(mu + (i << 1U) + 1U),
+                        &ev,
+                        &err,
+                        work
+                    ) &&
+                    worst < err / ev
+                )
+                {
+                    worst = err / ev;
+                    selected = i;
+                }
+
+            /* Print the progress. */
+            if (log)
+                fprintf(
+                    log,
+                    "Basis size %lu, largest relative error estimate %.3e.\n",
+                    (unsigned long)model->N,
+                    (double)worst
+                );
+
+            /* Stop if the tolerance is reached. */
+            if (!(tol < worst))
+                break;
+        }
+    }
+    while (false);
+
+    /* Deallocate memory. */
+    free(K3);
+    K3 = (real_t*)(NULL);
+    free(M);
+    M = (real_t*)(NULL);
+    free(X);
+    X = (real_t*)(NULL);
+    free(A);
+    A = (real_t*)(NULL);
+    free(V);
+    V = (real_t*)(NULL);
+    free(B);
+    B = (real_t*)(NULL);
+    free(Z);
+    Z = (real_t*)(NULL);
+    free(mu);
+    mu = (real_t*)(NULL);
+    free(u);
+    u = (real_t*)(NULL);
+    free(w);
+    w = (real_t*)(NULL);
+    free(work);
+    work = (real_t*)(NULL);
+
+    /* If the training failed, free the model. */
+    if (status || !model->N)
+    {
+        rb_free(model);
+
+        return 1;
+    }
+
+    /* Return 0. */
+    return 0;
+}
+
+/**
+ * Dump a model.
+ *
+ * @param model
+ *     Pointer to the model.
+ *
+ * @param out
+ *     File to dump the model to.
+ *
+ * @return
+ *     Value 0 if the model was dumped, a non-zero value otherwise.
+ *
+ */
+#if !defined(__cplusplus)
+int rb_dump (const rb_model_t* model, FILE* out)
+#else
+inline int rb_dump (const rb_model_t* model, ::FILE* out)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF VARIABLES */
+
+    /* Pointer to the current matrix. */
+    const real_t* C;
+
+    /* Iteration indices. */
+    size_t q;
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Pointer to the current matrix. */
+    C = (const real_t*)(NULL);
+
+    /* Iteration indices. */
+    q = 0U;
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If any of the pointers is a null-pointer, return a non-zero value. */
+    if (!(model && out))
+        return 1;
+
+    /* Dump the sizes. */
+    fprintf(
+        out,
+        "%lu\t%lu\n",
+        (unsigned long)model->m,
+        (unsigned long)model->N
+    );
+
+    /* Dump the matrices. */
+    for (q = 0U; q < 3U + RB_TERMS * RB_TERMS; ++q)
+    {
+        C = (q < 3U) ?
+            model->A + q * model->L * model->L :
+            model->C + (q - 3U) * model->L * model->L;
+        for (i = 0U; i < model->N; ++i)
+            for (j = 0U; j < model->N; ++j)
+                fprintf(
+                    out,
+                    (j + 1U < model->N) ? "%.17e\t" : "%.17e\n",
+                    (double)*(C + i * model->L + j)
+                );
+    }
+
+    /* Return 0 if no error occured. */
+    return ferror(out) ? 1 : 0;
+}
+
+/**
+ * Load a model.
+ *
+ * @param model
+ *     Pointer to the model.  The memory is allocated in the function, the
+ *     model must be freed by the function `rb_free`.
+ *
+ * @param in
+ *     File to load the model from.
+ *
+ * @return
+ *     Value 0 if the model was loaded, a non-zero value otherwise.
+ *
+ * @see rb_free
+ *
+ */
+#if !defined(__cplusplus)
+int rb_load (rb_model_t* model, FILE* in)
+#else
+inline int rb_load (rb_model_t* model, ::FILE* in)
+#endif /* __cplusplus */
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Format string for reading a real number. */
+    static const char* const format_input = REAL_FORMAT_INPUT;
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Sizes. */
+    unsigned long m;
+    unsigned long N;
+
+    /* Pointer to the current matrix. */
+    real_t* C;
+
+    /* Iteration indices. */
+    size_t q;
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Sizes. */
+    m = 0U;
+    N = 0U;
+
+    /* Pointer to the current matrix. */
+    C = (real_t*)(NULL);
+
+    /* Iteration indices. */
+    q = 0U;
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* Read the sizes and allocate memory for the model. */
+    if (!(model && in && fscanf(in, " %lu %lu", &m, &N) == 2))
+        return 1;
+    if (!rb_allocate(model, (size_t)m, (size_t)N))
+        return 1;
+    model->N = (size_t)N;
+
+    /* Read the matrices. */
+    for (q = 0U; q < 3U + RB_TERMS * RB_TERMS; ++q)
+    {
+        C = (q < 3U) ?
+            model->A + q * model->L * model->L :
+            model->C + (q - 3U) * model->L * model->L;
+        for (i = 0U; i < model->N * model->N; ++i)
+            if (!(fscanf(in, format_input, C + i) == 1))
+            {
+                rb_free(model);
+
+                return 1;
+            }
+    }
+
+    /* Return 0. */
+    return 0;
+}
+
+#endif /* __REDUCED_BASIS_H__INCLUDED */
@@ -0,0 +1,522 @@
+/**
+ * Stratified splitting of datasets and shuffling of their rows.
+ *
+ * The rows of a dataset are grouped into families of consecutive rows (for
+ * instance, a triangle and its rotations generated by the program compiled from
+ * "generators/triangles_rotator.c", or a polygon and its perturbations
+ * generated by the program compiled from "generators/perturbator.c"), and each
+ * family is assigned to one of `SPLIT_SETS` sets (the training, the validation
+ * and the test set) as a whole, so that no set contains a polygon derived from
+ * a polygon of another set.  The families are stratified by a key (such as the
+ * mean eigenvalue of the family):  the keys are divided into bins of (about)
+ * equal numbers of families by their quantiles, and the families of each bin
+ * are assigned to the sets at random in the given proportions (exactly up to
+ * rounding of the numbers of families of all bins together), so each set has
+ * the same distribution of the keys.
+ *
+ * Random numbers are generated by the xorshift128 generator of 32-bit words,
+ * so the split and the shuffle depend only on the seed (and not on the
+ * implementation of the `rand` function).
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__SPLIT_H__INCLUDED) && (__SPLIT_H__INCLUDED) == 1)
+
+/* Undefine __SPLIT_H__INCLUDED if it has already been defined. */
+#if defined(__SPLIT_H__INCLUDED)
+#undef __SPLIT_H__INCLUDED
+#endif /* __SPLIT_H__INCLUDED */
+
+/* Define __SPLIT_H__INCLUDED as 1. */
+#define __SPLIT_H__INCLUDED 1
+
+/* Import standard library headers. */
+
+#if !defined(__cplusplus)
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#else
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#endif /* __cplusplus */
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+
+/* Define the number of sets (the training, the validation and the test
+ * set). */
+#if defined(SPLIT_SETS)
+#undef SPLIT_SETS
+#endif /* SPLIT_SETS */
+#define SPLIT_SETS 3U
+
+/* Define the mask of a 32-bit word. */
+#if defined(SPLIT_WORD)
+#undef SPLIT_WORD
+#endif /* SPLIT_WORD */
+#define SPLIT_WORD 0xFFFFFFFFUL
+
+/* Define types. */
+
+/**
+ * State of the xorshift128 pseudorandom number generator.
+ *
+ */
+typedef struct split_random_struct
+{
+    /* Four 32-bit words of the state. */
+    unsigned long s[4U];
+}
+split_random_t;
+
+/* Define functions. */
+
+/**
+ * Seed a pseudorandom number generator.
+ *
+ * The words of the state are computed from the seed by an integer hash
+ * function, so close seeds give unrelated sequences.
+ *
+ * @param R
+ *     Pointer to the generator.
+ *
+ * @param seed
+ *     Seed.
+ *
+ */
+#if !defined(__cplusplus)
+void split_seed (split_random_t* R, unsigned long seed)
+#else
+inline void split_seed (split_random_t* R, unsigned long seed)
+#endif /* __cplusplus */
+{
+    /* Word of the state. */
+    unsigned long x;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* Initialise the word and the iteration index. */
+    x = 0UL;
+    i = 0U;
+
+    /* If the pointer `R` is a null-pointer, there is nothing to seed. */
+    if (!R)
+        return;
+
+    /* Hash the seed and the index of each word. */
+    for (i = 0U; i < 4U; ++i)
+    {
+        x = (seed + 0x9E3779B9UL * (unsigned long)(i + 1U)) & SPLIT_WORD;
+        x ^= x >> 16U;
+        x = (x * 0x7FEB352DUL) & SPLIT_WORD;
+        x ^= x >> 15U;
+        x = (x * 0x846CA68BUL) & SPLIT_WORD;
+        x ^= x >> 16U;
+        *(R->s + i) = x;
+    }
+
+    /* The state must not be zero. */
+    if (!(*R->s || *(R->s + 1U) || *(R->s + 2U) || *(R->s + 3U)))
+        *R->s = 1UL;
+}
+
+/**
+ * Generate a pseudorandom 32-bit word.
+ *
+ * @param R
+ *     Pointer to the generator.
+ *
+ * @return
+ *     Pseudorandom number from the interval [0, 2^32 - 1].
+ *
+ */
+#if !defined(__cplusplus)
+unsigned long split_next (split_random_t* R)
+#else
+inline unsigned long split_next (split_random_t* R)
+#endif /* __cplusplus */
+{
+    /* Temporary word. */
+    unsigned long t;
+
+    /* Compute the next state and return its last word. */
+    t = (*R->s ^ (*R->s << 11U)) & SPLIT_WORD;
+    *R->s = *(R->s + 1U);
+    *(R->s + 1U) = *(R->s + 2U);
+    *(R->s + 2U) = *(R->s + 3U);
+    *(R->s + 3U) =
+        (*(R->s + 3U) ^ (*(R->s + 3U) >> 19U) ^ t ^ (t >> 8U)) & SPLIT_WORD;
+
+    return *(R->s + 3U);
+}
+
+/**
+ * Generate a pseudorandom integer from a range.
+ *
+ * @param R
+ *     Pointer to the generator.
+ *
+ * @param n
+ *     Length of the range.
+ *
+ * @return
+ *     Uniformly distributed pseudorandom number from the range [0, `n`) (0 if
+ *     `n` is 0).  For `n` of at most 2^32 values are drawn by rejection, so
+ *     the distribution is exactly uniform;  larger ranges are drawn from two
+ *     words with a negligible bias.
+ *
+ */
+#if !defined(__cplusplus)
+size_t split_uniform (split_random_t* R, size_t n)
+#else
+inline ::size_t split_uniform (split_random_t* R, ::size_t n)
+#endif /* __cplusplus */
+{
+    /* Smallest accepted word and a word. */
+    unsigned long t;
+    unsigned long x;
+
+    /* Initialise the words. */
+    t = 0UL;
+    x = 0UL;
+
+    /* If the range is empty, return 0. */
+    if (!n)
+        return 0U;
+
+    /* Draw a large range from two words (the shifts are split so that they
+     * are defined for a 32-bit type `size_t`). */
+    if ((n - 1U) > (size_t)(SPLIT_WORD))
+        return (((size_t)split_next(R) << 16U << 16U) | split_next(R)) % n;
+
+    /* Reject the words below 2^32 mod n. */
+    t = ((SPLIT_WORD - (unsigned long)n) + 1UL) % (unsigned long)n;
+    do
+        x = split_next(R);
+    while (x < t);
+
+    return (size_t)(x % (unsigned long)n);
+}
+
+/**
+ * Compute the edges of the quantile bins of keys.
+ *
+ * @param n
+ *     Number of keys.
+ *
+ * @param K
+ *     Array of the keys of size at least `n`.  The keys are sorted
+ *     ascendingly.
+ *
+ * @param B
+ *     Number of bins (at least 1).
+ *
+ * @param E
+ *     Array of size at least `B` - 1 to store the edges:  the (b - 1)-th edge
+ *     is the (b / `B`)-th quantile of the keys (the (b `n` / `B`)-th smallest
+ *     key, rounded down).
+ *
+ * @see split_bin
+ *
+ */
+#if !defined(__cplusplus)
+void split_edges (size_t n, real_t* K, size_t B, real_t* E)
+#else
+inline void split_edges (::size_t n, real_t* K, ::size_t B, real_t* E)
+#endif /* __cplusplus */
+{
+    /* Iteration index. */
+    size_t b;
+
+    /* Initialise the iteration index. */
+    b = 0U;
+
+    /* If any of the pointers is a null-pointer or if there are no keys, there
+     * is nothing to compute. */
+    if (!(K && E && n))
+        return;
+
+    /* Sort the keys and read the edges. */
+    qsort(K, n, sizeof *K, rcompar);
+    for (b = 1U; b < B; ++b)
+        *(E + b - 1U) = *(K + (b * n) / B);
+}
+
+/**
+ * Find the quantile bin of a key.
+ *
+ * @param B
+ *     Number of bins (at least 1).
+ *
+ * @param E
+ *     Array of the `B` - 1 edges computed by the function `split_edges`.
+ *
+ * @param key
+ *     Key.
+ *
+ * @return
+ *     Index of the bin of the key, the number of edges not greater than the
+ *     key.
+ *
+ * @see split_edges
+ *
+ */
+#if !defined(__cplusplus)
+size_t split_bin (size_t B, const real_t* E, real_t key)
+#else
+inline ::size_t split_bin (::size_t B, const real_t* E, real_t key)
+#endif /* __cplusplus */
+{
+    /* Bounds of the binary search and its middle. */
+    size_t l;
+    size_t u;
+    size_t c;
+
+    /* Initialise the bounds and the middle. */
+    l = 0U;
+    u = B ? B - 1U : 0U;
+    c = 0U;
+
+    /* Search for the first edge greater than the key. */
+    while (l < u)
+    {
+        c = l + ((u - l) >> 1U);
+        if (*(E + c) <= key)
+            l = c + 1U;
+        else
+            u = c;
+    }
+
+    return l;
+}
+
+/**
+ * Compute the numbers of families of a bin to assign to each set.
+ *
+ * The numbers are counted by the global cumulative numbers of families of the
+ * sets, including the families of the preceding bins, instead of by rounding
+ * the proportions of the bin on its own, so the errors of rounding do not add
+ * up across bins.  The families of the bin are counted one by one, each to the
+ * set whose cumulative number is the furthest below its exact proportion of
+ * the cumulative number of families, so after each bin the cumulative number
+ * of families of each set differs from its exact proportion by less than 1
+ * (for instance, 200 families in 20 bins of 10 families in the proportions
+ * 0.7, 0.15 and 0.15 are split into 140, 30 and 30 families, not into 140, 40
+ * and 20 as by rounding each bin on its own).
+ *
+ * @param m
+ *     Number of families of the bin.
+ *
+ * @param p
+ *     Array of the proportions of the first `SPLIT_SETS` - 1 sets (the last
+ *     set takes the rest), nonnegative and of sum at most 1.
+ *
+ * @param C
+ *     Array of size at least `SPLIT_SETS` of the cumulative numbers of
+ *     families of the sets of the preceding bins (all zeros before the first
+ *     bin).  The numbers of the bin are added to the cumulative numbers.
+ *
+ * @param Q
+ *     Array of size at least `SPLIT_SETS` to store the numbers of families of
+ *     the sets.  The numbers sum to `m`.
+ *
+ */
+#if !defined(__cplusplus)
+void split_quotas (size_t m, const real_t* p, size_t* C, size_t* Q)
+#else
+inline void split_quotas (
+    ::size_t m,
+    const real_t* p,
+    ::size_t* C,
+    ::size_t* Q
+)
+#endif /* __cplusplus */
+{
+    /* Cumulative number of families, the proportion of a set and the
+     * deficits of a set and of the chosen set. */
+    size_t t;
+    real_t q;
+    real_t d;
+    real_t e;
+
+    /* Chosen set. */
+    size_t c;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t s;
+
+    /* Initialise the variables and the iteration indices. */
+    t = 0U;
+    q = 0.0;
+    d = 0.0;
+    e = 0.0;
+    c = 0U;
+    i = 0U;
+    s = 0U;
+
+    /* Count the cumulative number of families of the preceding bins. */
+    for (s = 0U; s < SPLIT_SETS; ++s)
+    {
+        t += *(C + s);
+        *(Q + s) = 0U;
+    }
+
+    /* Count each family to the set of the largest deficit. */
+    for (i = 0U; i < m; ++i)
+    {
+        ++t;
+        q = 1.0;
+        c = 0U;
+        for (s = 0U; s < SPLIT_SETS; ++s)
+        {
+            if (s + 1U < SPLIT_SETS)
+                q -= *(p + s);
+            d =
+                (real_t)t * ((s + 1U < SPLIT_SETS) ? *(p + s) : q) -
+                (real_t)(*(C + s));
+            if (!s || d > e)
+            {
+                c = s;
+                e = d;
+            }
+        }
+        ++*(C + c);
+        ++*(Q + c);
+    }
+}
+
+/**
+ * Assign a family to a set at random.
+ *
+ * Families of a bin assigned one by one by the function are a uniformly random
+ * assignment with the numbers of families given by the function
+ * `split_quotas` (sampling without replacement).
+ *
+ * @param R
+ *     Pointer to the generator.
+ *
+ * @param Q
+ *     Array of the numbers of families of the bin remaining to assign to each
+ *     of the `SPLIT_SETS` sets.  The number of the chosen set is decreased.
+ *
+ * @return
+ *     Index of the set (`SPLIT_SETS` if there are no families remaining).
+ *
+ * @see split_quotas
+ *
+ */
+#if !defined(__cplusplus)
+size_t split_choose (split_random_t* R, size_t* Q)
+#else
+inline ::size_t split_choose (split_random_t* R, ::size_t* Q)
+#endif /* __cplusplus */
+{
+    /* Number of families remaining and the pseudorandom rank. */
+    size_t r;
+    size_t u;
+
+    /* Iteration index. */
+    size_t s;
+
+    /* Initialise the numbers and the iteration index. */
+    r = 0U;
+    u = 0U;
+    s = 0U;
+
+    /* Draw a rank among the remaining families and find its set. */
+    for (s = 0U; s < SPLIT_SETS; ++s)
+        r += *(Q + s);
+    if (!r)
+        return SPLIT_SETS;
+    u = split_uniform(R, r);
+    for (s = 0U; !(u < *(Q + s)); ++s)
+        u -= *(Q + s);
+    --*(Q + s);
+
+    return s;
+}
+
+/**
+ * Shuffle rows of an array.
+ *
+ * The rows are shuffled by the Fisher-Yates algorithm, so all permutations are
+ * equally probable.
+ *
+ * @param R
+ *     Pointer to the generator.
+ *
+ * @param n
+ *     Number of rows.
+ *
+ * @param w
+ *     Number of values in each row.
+ *
+ * @param X
+ *     Array of size at least `n` `w` of the rows.
+ *
+ * @param W
+ *     Workspace of size at least `w`.
+ *
+ */
+#if !defined(__cplusplus)
+void split_shuffle (
+    split_random_t* R,
+    size_t n,
+    size_t w,
+    real_t* X,
+    real_t* W
+)
+#else
+inline void split_shuffle (
+    split_random_t* R,
+    ::size_t n,
+    ::size_t w,
+    real_t* X,
+    real_t* W
+)
+#endif /* __cplusplus */
+{
+    /* Index of the row to swap with. */
+    size_t j;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* Initialise the indices. */
+    j = 0U;
+    i = 0U;
+
+    /* If any of the pointers is a null-pointer, there is nothing to
+     * shuffle. */
+    if (!(R && X && W && w))
+        return;
+
+    /* Swap each row with a random row not after it. */
+    for (i = n; i > 1U; --i)
+    {
+        j = split_uniform(R, i);
+        if (j == i - 1U)
+            continue;
+        memcpy(W, X + (i - 1U) * w, w * sizeof *X);
+        memcpy(X + (i - 1U) * w, X + j * w, w * sizeof *X);
+        memcpy(X + j * w, W, w * sizeof *X);
+    }
+}
+
+#endif /* __SPLIT_H__INCLUDED */
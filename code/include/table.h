@@ -0,0 +1,427 @@
+/**
+ * Tables of real numbers stored as text files, as NumPy arrays or as
+ * compressed tables.
+ *
+ * A table is opened by the function `table_open` from a path.  If the path
+ * ends with ".npy", the table is a NumPy array (see "npy.h"):  an input array
+ * is mapped to memory and an output array is streamed to the file with a
+ * preallocated header.  If the path ends with ".pcz", the table is a
+ * losslessly compressed table streamed block by block (see "codec.h").
+ * Otherwise the table is a text file of values separated by whitespaces, read
+ * by the `fscanf` function and dumped by the `dump_polygons` function from
+ * "polygon.h" (the format used by all programs so far).  The programs
+ * therefore read and write NumPy arrays and compressed tables simply by giving
+ * them paths ending with ".npy" or ".pcz".
+ *
+ * If an input NumPy array is rejected (for instance, an array of integers),
+ * the function `table_open` prints the reason to the standard error stream
+ * (see the function `npy_error_message` in "npy.h") and keeps it in the table,
+ * so the generic error message of a program is preceded by the specific
+ * reason.
+ *
+ * Each row of an output array or of a compressed table is a single polygon (a
+ * set of points) dumped by the function `table_dump_polygons`, so the shape of
+ * the array is (N, 2 * n), where N is the number of dumped polygons and n is
+ * the number of their vertices.
+ *
+ * The header is intended for the programs, so it is written in C only.  As
+ * "npy.h" is included, the macro `_POSIX_C_SOURCE` must be defined (as at
+ * least 200112L) before any standard header is included.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Check if the header has already been imported. */
+#if !(defined(__TABLE_H__INCLUDED) && (__TABLE_H__INCLUDED) == 1)
+
+/* Undefine __TABLE_H__INCLUDED if it has already been defined. */
+#if defined(__TABLE_H__INCLUDED)
+#undef __TABLE_H__INCLUDED
+#endif /* __TABLE_H__INCLUDED */
+
+/* Define __TABLE_H__INCLUDED as 1. */
+#define __TABLE_H__INCLUDED 1
+
+/* The header is written in C only. */
+#if defined(__cplusplus)
+#error "table.h" is written in C only, use "npy.h" in C++.
+#endif /* __cplusplus */
+
+/* Import standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Import package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+#include "npy.h"
+#include "codec.h"
+
+/* Define types. */
+
+/**
+ * Table stored as a text file or as a NumPy array.
+ *
+ */
+typedef struct table_struct
+{
+    /* Text file or output NumPy array. */
+    FILE* file;
+
+    /* Input NumPy array. */
+    npy_array_t array;
+
+    /* Compressed table. */
+    codec_t codec;
+
+    /* Indicator of a NumPy array. */
+    bool npy;
+
+    /* Indicator of a compressed table. */
+    bool pcz;
+
+    /* Indicator of an output table. */
+    bool output;
+
+    /* Number of values in each row dumped to an output NumPy array. */
+    size_t columns;
+
+    /* Message of the error of opening an input NumPy array (the null-pointer
+     * if there was none). */
+    const char* error;
+}
+table_t;
+
+/* Define functions. */
+
+/**
+ * Open a table.
+ *
+ * @param T
+ *     Pointer to the table to open.
+ *
+ * @param path
+ *     Path to the file.  If it ends with ".npy", the table is a NumPy array;
+ *     otherwise it is a text file.
+ *
+ * @param output
+ *     If `true`, the table is opened for dumping (the file is truncated);
+ *     otherwise it is opened for reading.
+ *
+ * @return
+ *     Value `true` if the table was opened successfully; value `false`
+ *     otherwise.  If an input NumPy array exists but it is not supported (or
+ *     it is not a valid NumPy array), the message `T->error` describing the
+ *     reason is printed to the standard error stream as
+ *         path: message
+ *
+ * @see table_close
+ *
+ */
+bool table_open (table_t* T, const char* path, bool output)
+{
+    /* Mode of the input text file to open. */
+    static const char* const file_in_open_mode = "rt";
+
+    /* Mode of the output text file to open. */
+    static const char* const file_out_open_mode = "wt";
+
+    /* Mode of the output NumPy array to open. */
+    static const char* const npy_out_open_mode = "wb";
+
+    /* Format string for printing the reason of rejecting a NumPy array. */
+    static const char* const format_npy_error = "%s: %s\n";
+
+    /* Error of opening an input NumPy array. */
+    int error;
+
+    /* Initialise the error. */
+    error = 0;
+
+    /* If any of the pointers is a null-pointer, return `false`. */
+    if (!(T && path))
+        return false;
+
+    /* Initialise the table. */
+    memset(T, 0, sizeof *T);
+    T->file = (FILE*)(NULL);
+    T->npy = npy_path(path);
+    T->pcz = codec_path(path);
+    T->output = output;
+    T->columns = 0U;
+    T->error = (const char*)(NULL);
+
+    /* Open an input NumPy array.  If it exists but it is rejected, print the
+     * reason. */
+    if (T->npy && !output)
+    {
+        error = npy_open(path, &T->array);
+        T->error = npy_error_message(error);
+        if (error && !(error == NPY_ERROR_FILE))
+            fprintf(stderr, format_npy_error, path, T->error);
+
+        return error ? false : true;
+    }
+
+    /* Open a compressed table. */
+    if (T->pcz)
+        return codec_open(&T->codec, path, output) ? false : true;
+
+    /* Open the file. */
+    T->file =
+        fopen(
+            path,
+            output ?
+                (T->npy ? npy_out_open_mode : file_out_open_mode) :
+                file_in_open_mode
+        );
+    if (!T->file)
+        return false;
+
+    /* Reserve the header of an output NumPy array. */
+    if (T->npy && npy_begin(T->file))
+    {
+        fclose(T->file);
+        T->file = (FILE*)(NULL);
+
+        return false;
+    }
+
+    /* Return `true`. */
+    return true;
+}
+
+/**
+ * Read values from a table.
+ *
+ * @param T
+ *     Pointer to the table opened for reading.
+ *
+ * @param m
+ *     Number of values to read.
+ *
+ * @param x
+ *     Array of size at least `m` to store the values.
+ *
+ * @return
+ *     Number of values read (less than `m` if the end of the table has been
+ *     reached or if a value could not be read).
+ *
+ */
+size_t table_scan (table_t* T, size_t m, real_t* x)
+{
+    /* Format string for reading the values. */
+    static const char* const format_input = REAL_FORMAT_INPUT;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* Initialise the iteration index. */
+    i = 0U;
+
+    /* If any of the pointers is a null-pointer or if the table is an output
+     * table, there is nothing to read. */
+    if (!(T && x) || T->output)
+        return 0U;
+
+    /* Read the values from the NumPy array. */
+    if (T->npy)
+        return npy_read(&T->array, m, x);
+
+    /* Read the values from the compressed table. */
+    if (T->pcz)
+        return codec_read(&T->codec, m, x);
+
+    /* Read the values from the text file. */
+    if (T->file)
+        for (i = 0U; i < m; ++i)
+            if (!(fscanf(T->file, format_input, x + i) == 1))
+                break;
+
+    /* Return the number of values read. */
+    return i;
+}
+
+/**
+ * Dump polygons to a table.
+ *
+ * @param T
+ *     Pointer to the table opened for dumping.
+ *
+ * @param n
+ *     Number of points in each set.
+ *
+ * @param P
+ *     Array of points of size at least `N` * 2 * `n` organised as in the
+ *     `dump_polygons` function.
+ *
+ * @param N
+ *     Number of polygons.
+ *
+ * @see dump_polygons
+ * @see npy_dump_polygons
+ * @see codec_dump_polygons
+ *
+ */
+void table_dump_polygons (table_t* T, size_t n, const real_t* P, size_t N)
+{
+    /* If the pointer `T` is a null-pointer or if the table is not an output
+     * table, there is nothing to dump. */
+    if (!(T && T->output))
+        return;
+
+    /* Dump the polygons to the compressed table. */
+    if (T->pcz)
+        codec_dump_polygons(&T->codec, n, P, N);
+
+    /* Dump the polygons to the NumPy array and remember the length of the
+     * rows. */
+    else if (T->npy)
+    {
+        if (T->file && n && P && N)
+        {
+            npy_dump_polygons(T->file, n, P, N);
+            T->columns = n << 1U;
+        }
+    }
+
+    /* Dump the polygons to the text file. */
+    else if (T->file)
+        dump_polygons(T->file, n, P, N);
+}
+
+/**
+ * Dump rows of any number of values to a table.
+ *
+ * Unlike the function `table_dump_polygons`, the rows need not consist of
+ * pairs of coordinates (for instance, rows of a single eigenvalue).  Rows of a
+ * text file are dumped in the format of the `dump_polygons` function.
+ *
+ * @param T
+ *     Pointer to the table opened for dumping.
+ *
+ * @param m
+ *     Number of values in each row.
+ *
+ * @param x
+ *     Array of the values of size at least `N` * `m`, row by row.
+ *
+ * @param N
+ *     Number of rows.
+ *
+ * @see table_dump_polygons
+ * @see dump_polygons
+ *
+ */
+void table_dump (table_t* T, size_t m, const real_t* x, size_t N)
+{
+    /* Precision of the values dumped to a text file. */
+    static const int prec = 8;
+
+    /* Formats for the first value of a row and the rest. */
+    static const char* const format_first = "%.*f";
+    static const char* const format_rest = "\t%.*f";
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* Initialise the iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* If any of the pointers is a null-pointer, if there is nothing to dump or
+     * if the table is not an output table, there is nothing to dump. */
+    if (!(T && T->output && x && m && N))
+        return;
+
+    /* Dump the rows to the compressed table. */
+    if (T->pcz)
+        codec_dump(&T->codec, m, x, N);
+
+    /* Dump the rows to the NumPy array and remember the length of the rows. */
+    else if (T->npy)
+    {
+        if (T->file)
+        {
+            npy_dump(T->file, N * m, x);
+            T->columns = m;
+        }
+    }
+
+    /* Dump the rows to the text file. */
+    else if (T->file)
+        for (i = 0U; i < N; ++i)
+        {
+            for (j = 0U; j < m; ++j)
+                fprintf(
+                    T->file,
+                    j ? format_rest : format_first,
+                    prec,
+                    (double)(*(x + i * m + j))
+                );
+            fprintf(T->file, "\n");
+        }
+}
+
+/**
+ * Close a table.
+ *
+ * The header of an output NumPy array and the buffered rows of an output
+ * compressed table are written before the file is closed.
+ *
+ * @param T
+ *     Pointer to the table.
+ *
+ * @return
+ *     Value 0 if the table was closed successfully; a non-zero value
+ *     otherwise.
+ *
+ * @see table_open
+ *
+ */
+int table_close (table_t* T)
+{
+    /* Value to return. */
+    int ret;
+
+    /* Initialise the value to return. */
+    ret = 0;
+
+    /* If the pointer `T` is a null-pointer, return 0. */
+    if (!T)
+        return ret;
+
+    /* Write the header of an output NumPy array. */
+    if (T->npy && T->output && T->file)
+        ret = npy_end(T->file, T->columns);
+
+    /* Close the file. */
+    if (T->file && fclose(T->file))
+        ret = 1;
+    T->file = (FILE*)(NULL);
+
+    /* Unmap an input NumPy array. */
+    if (T->npy && !T->output)
+        npy_close(&T->array);
+
+    /* Close a compressed table. */
+    if (T->pcz && codec_close(&T->codec))
+        ret = 1;
+
+    /* Reset the table. */
+    memset(T, 0, sizeof *T);
+    T->file = (FILE*)(NULL);
+
+    /* Return the value. */
+    return ret;
+}
+
+#endif /* __TABLE_H__INCLUDED */
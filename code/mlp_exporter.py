@@ -0,0 +1,209 @@
+# -*- coding: utf-8 -*-
+
+"""
+Export of the dense neural network to a flat table of parameters.
+
+The model "models/neural_network.h5" is a Keras `Sequential` model of dense
+layers (created in the notebook "Models.ipynb") predicting the first eigenvalue
+of a triangle from 8 standardised features.  The script exports the
+architecture, the means and the standard deviations of the features and the
+kernels and the biases of the layers as a single row
+    L	n_0	...	n_L	a_1	...	a_L	mean	std	W_1	b_1	...	W_L	b_L
+(see "include/mlp.h"), so that the model is evaluated by the program compiled
+from "numeric/mlp_predictor.c" without Python.  The weights are read from the
+HDF5 file by H5py, so neither Keras nor TensorFlow are needed.
+
+Usage:
+    $ python mlp_exporter.py model mean std out
+where:
+    model is the path to the Keras model (such as "models/neural_network.h5"),
+    mean  is the path to the means of the features (such as
+          "models/neural_network_features_mean.npy"),
+    std   is the path to the standard deviations of the features (such as
+          "models/neural_network_features_std.npy"),
+    out   is the path to the output file (a NumPy array of shape (1, m) if it
+          ends with ".npy", a text file otherwise).
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import argparse as _argparse
+import json as _json
+import os as _os
+
+# Import SciPy packages.
+import numpy as _np
+
+# Import H5py.
+import h5py as _h5py
+
+# Define the codes of the activations.
+_activations = {'linear': 0, 'relu': 1, 'relu_mult_inv': 2}
+
+# Define the function to read the layers of a model.
+def layers (path):
+    """
+    Read the dense layers of a Keras model.
+
+    Parameters
+    ==========
+    path : str
+        Path to the Keras model saved in the HDF5 format.
+
+    Returns
+    =======
+    list
+        List of tuples `(W, b, a)` of the kernel, the bias and the code of the
+        activation of each layer in the order of the model.
+
+    Raises
+    ======
+    ValueError
+        The model has a layer which is not dense or whose activation is not
+        supported.
+
+    """
+
+    with _h5py.File(path, 'r') as f:
+        # Read the configuration of the model.
+        config = f.attrs['model_config']
+        if isinstance(config, bytes):
+            config = config.decode('utf-8')
+        config = _json.loads(config)['config']
+        if isinstance(config, dict):
+            config = config['layers']
+
+        # Read the layers.
+        weights = f['model_weights']
+        result = list()
+        for layer in config:
+            name = layer['config']['name']
+            if not layer['class_name'] == 'Dense':
+                raise ValueError(
+                    'Layer {0:s} is not dense.'.format(repr(name))
+                )
+            activation = layer['config']['activation']
+            if activation not in _activations:
+                raise ValueError(
+                    'Activation {0:s} of the layer {1:s} is not '
+                        'supported.'.format(repr(activation), repr(name))
+                )
+            group = weights[name][name]
+            result.append(
+                (
+                    _np.array(group['kernel:0'], dtype = float),
+                    _np.array(group['bias:0'], dtype = float),
+                    _activations[activation]
+                )
+            )
+
+    # Return the layers.
+    return result
+
+# Define the function to export a model.
+def export (path_model, path_mean, path_std, path_out):
+    """
+    Export a dense neural network to a table of parameters.
+
+    Parameters
+    ==========
+    path_model : str
+        Path to the Keras model.
+
+    path_mean : str
+        Path to the means of the features.
+
+    path_std : str
+        Path to the standard deviations of the features.
+
+    path_out : str
+        Path to the output file.
+
+    Returns
+    =======
+    tuple
+        Widths n_0, ..., n_L of the layers.
+
+    Raises
+    ======
+    ValueError
+        The widths of the layers, the means and the standard deviations do not
+        match.
+
+    """
+
+    # Read the layers, the means and the standard deviations.
+    model = layers(path_model)
+    mean = _np.ravel(_np.load(path_mean)).astype(float)
+    std = _np.ravel(_np.load(path_std)).astype(float)
+
+    # Check the widths.
+    widths = [mean.size] + [b.size for W, b, a in model]
+    if not std.size == mean.size:
+        raise ValueError(
+            'Numbers of means and standard deviations do not match.'
+        )
+    for l, (W, b, a) in enumerate(model):
+        if not W.shape == (widths[l], widths[l + 1]):
+            raise ValueError(
+                'Kernel of the layer {0:d} has shape {1:s} instead of '
+                    '{2:s}.'.format(
+                        l + 1,
+                        repr(W.shape),
+                        repr((widths[l], widths[l + 1]))
+                    )
+            )
+
+    # Concatenate the parameters.
+    F = _np.concatenate(
+        [
+            _np.array(
+                [len(model)] + widths + [a for W, b, a in model],
+                dtype = float
+            ),
+            mean,
+            std
+        ] +
+        [_np.concatenate([_np.ravel(W), b]) for W, b, a in model]
+    )
+
+    # Save the parameters atomically.
+    temporary = path_out + '.tmp' + _os.path.splitext(path_out)[1]
+    if path_out.endswith('.npy'):
+        _np.save(temporary, F.reshape((1, -1)))
+    else:
+        _np.savetxt(
+            temporary,
+            F.reshape((1, -1)),
+            fmt = '%.18e',
+            delimiter = '\t'
+        )
+    _os.rename(temporary, path_out)
+
+    # Return the widths of the layers.
+    return tuple(widths)
+
+# Export the model from the command line.
+if __name__ == '__main__':
+    parser = _argparse.ArgumentParser(
+        description = 'Export a dense neural network to a table of parameters.'
+    )
+    parser.add_argument('model', help = 'Keras model')
+    parser.add_argument('mean', help = 'means of the features')
+    parser.add_argument('std', help = 'standard deviations of the features')
+    parser.add_argument('out', help = 'output file of parameters')
+    arguments = parser.parse_args()
+    print(
+        'Widths of the layers: {0:s}.'.format(
+            ', '.join(
+                str(n) for n in export(
+                    arguments.model,
+                    arguments.mean,
+                    arguments.std,
+                    arguments.out
+                )
+            )
+        )
+    )
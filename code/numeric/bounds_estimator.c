@@ -0,0 +1,428 @@
+/**
+ * Program for computing analytic bounds and estimates of the first Laplace
+ * eigenvalues on convex polygons.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./bounds_estimate in N n out [ev]
+ * where:
+ *     in  is the path to the input file to read the coordinates of vertices,
+ *     N   is the number of polygons to read (at least 1),
+ *     n   is the number of vertices of each polygon (at least 3),
+ *     out is the path to the output file to print the bounds,
+ *     ev  is the (optional) path to the input file to read the computed
+ *         eigenvalues to check.
+ *
+ * Each polygon must be formated in the input file as
+ *     x_0	y_0	x_1	y_1	...	x_n_minus_1	y_n_minus_1
+ * where x_i denotes the x-coordinate of the i-th vertex and y_i denotes the
+ * y-coordinate of the i-th vertex.  Whitespaces may differ (they may even be
+ * spaces, tabs, line breaks...).  Polygons must be convex and their vertices
+ * must be enumerated in the mathematically positive order.
+ *
+ * Note that the input file must contain at least N polygons.  If, however, it
+ * contains more than N polygons, only the first N polygons are read.
+ *
+ * For each polygon a line
+ *     lower	upper	estimate	delta
+ * is printed to the output file (see the function `bounds_batch` in
+ * "bounds.h").  All four values are the undefined real number (see
+ * "numeric.h") for unsupported (non-convex or degenerate) polygons.
+ *
+ * If the file of eigenvalues is given, it must contain at least N values, one
+ * per polygon (for instance, the file "eigenvalues.tsv" of a dataset).  The
+ * indices of the polygons whose eigenvalues are outside of their bounds are
+ * printed to the console (one per line), followed by their number.
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the computation of the bounds.  Time needed to read and print is not
+ * measured.
+ *
+ * If the path to any of the files ends with ".npy" or ".pcz", the file is read
+ * or dumped as a NumPy array or as a compressed table with a single polygon
+ * per row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "bounds.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 4 or 5: input file path, "
+            "number of polygons to read, number of vertices, output file path "
+            "and optional eigenvalues file path.";
+
+    /* Error message for the illegal number of polygons to read. */
+    const char* const err_msg_npr =
+        "Number of polygons to read must be at least 1.";
+
+    /* Error message for the illegal number of vertices. */
+    const char* const err_msg_nv = "Number of vertices must be at least 3.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a coordinate. */
+    const char* const err_msg_rc = "Reading a coordinate failed.";
+
+    /* Error message for failing to read an eigenvalue. */
+    const char* const err_msg_re = "Reading an eigenvalue failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* Format string for printing the number of inconsistent eigenvalues. */
+    const char* const format_count =
+        "Eigenvalues outside of the bounds: %lu.\n";
+
+    /* Format string for printing an index of a polygon. */
+    const char* const format_index = "%lu\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of polygons to read. */
+    size_t N;
+
+    /* Number of vertices of each polygon. */
+    size_t n;
+
+    /* Array of vertices, array of bounds and array of eigenvalues. */
+    real_t* P;
+    real_t* E;
+    real_t* ev;
+
+    /* Number of eigenvalues outside of their bounds. */
+    size_t count;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Number of polygons to read. */
+    N = 0U;
+
+    /* Number of vertices of each polygon. */
+    n = 0U;
+
+    /* Array of vertices, array of bounds and array of eigenvalues. */
+    P = (real_t*)(NULL);
+    E = (real_t*)(NULL);
+    ev = (real_t*)(NULL);
+
+    /* Number of eigenvalues outside of their bounds. */
+    count = 0U;
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 4 or 5, print
+     * the error message and exit with a non-zero value. */
+    if (!(argc == 5 || argc == 6))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the command line arguments is a null-pointer, print
+     * the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            (argc == 5 || *(argv + 5U))
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of polygons to read and the number of vertices. */
+    N = (size_t)atoi(*(argv + 2U));
+    n = (size_t)atoi(*(argv + 3U));
+
+    /* If the number of polygons to read is 0, print the error message and
+     * exit with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of vertices is less than 3, print the error message and
+     * exit with a non-zero value. */
+    if (n < 3U)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nv);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory for the polygons, the bounds and the eigenvalues. */
+    P = (real_t*)malloc(((n * N) << 1U) * sizeof *P);
+    E = (real_t*)malloc((N << 2U) * sizeof *E);
+    ev = (real_t*)malloc(N * sizeof *ev);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(P && E && ev))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(ev);
+        ev = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(P, 0, ((n * N) << 1U) * sizeof *P);
+    memset(E, 0, (N << 2U) * sizeof *E);
+    memset(ev, 0, N * sizeof *ev);
+
+    /* Open the input file and read the polygons.  If the file could not be
+     * opened or if any of the coordinates could not be read, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 1U), false))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(ev);
+        ev = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0U; i < ((n * N) << 1U); ++i)
+        if (!(table_scan(&inout, 1U, P + i) == 1U))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_rc);
+
+            /* Close the input file. */
+            table_close(&inout);
+
+            /* Deallocate memory. */
+            memset(P, 0, ((n * N) << 1U) * sizeof *P);
+            free(P);
+            P = (real_t*)(NULL);
+            free(E);
+            E = (real_t*)(NULL);
+            free(ev);
+            ev = (real_t*)(NULL);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+
+    /* Close the input file. */
+    table_close(&inout);
+
+    /* Open the file of eigenvalues and read them (if it is given).  If the
+     * file could not be opened or if any of the eigenvalues could not be read,
+     * print the error message, deallocate memory and exit with a non-zero
+     * value. */
+    if (argc == 6)
+    {
+        if (!table_open(&inout, *(argv + 5U), false))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_in);
+
+            /* Deallocate memory. */
+            memset(P, 0, ((n * N) << 1U) * sizeof *P);
+            free(P);
+            P = (real_t*)(NULL);
+            free(E);
+            E = (real_t*)(NULL);
+            free(ev);
+            ev = (real_t*)(NULL);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0U; i < N; ++i)
+            if (!(table_scan(&inout, 1U, ev + i) == 1U))
+            {
+                /* Print the error message. */
+                fprintf(stderr, format_err_msg, err_msg_re);
+
+                /* Close the file of eigenvalues. */
+                table_close(&inout);
+
+                /* Deallocate memory. */
+                memset(P, 0, ((n * N) << 1U) * sizeof *P);
+                free(P);
+                P = (real_t*)(NULL);
+                free(E);
+                E = (real_t*)(NULL);
+                memset(ev, 0, N * sizeof *ev);
+                free(ev);
+                ev = (real_t*)(NULL);
+
+                /* Exit with a non-zero value. */
+                exit(EXIT_FAILURE);
+            }
+
+        /* Close the file of eigenvalues. */
+        table_close(&inout);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Compute the bounds. */
+    bounds_batch(n, N, P, E);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Print the time elapsed during the computation of the bounds. */
+    printf(
+        format_time,
+        (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+    );
+
+    /* Check the eigenvalues (if they are given), print the indices of the
+     * polygons whose eigenvalues are outside of their bounds and their number.
+     * Eigenvalues of unsupported polygons are not checked. */
+    if (argc == 6)
+    {
+        for (i = 0U; i < N; ++i)
+            if (
+                *(E + (i << 2U)) != lambda &&
+                !(
+                    *(E + (i << 2U)) * (1.0 - BOUNDS_SLACK) <= *(ev + i) &&
+                    *(ev + i) <= *(E + (i << 2U) + 1U) * (1.0 + BOUNDS_SLACK)
+                )
+            )
+            {
+                printf(format_index, (unsigned long)i);
+                ++count;
+            }
+        printf(format_count, (unsigned long)count);
+    }
+
+    /* Open the output file and dump the bounds (4 values per polygon, so the
+     * `table_dump_polygons` function is used as for 2-gons).  If the file
+     * could not be opened, print the error message, deallocate memory and
+     * exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 4U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        memset(P, 0, ((n * N) << 1U) * sizeof *P);
+        free(P);
+        P = (real_t*)(NULL);
+        memset(E, 0, (N << 2U) * sizeof *E);
+        free(E);
+        E = (real_t*)(NULL);
+        memset(ev, 0, N * sizeof *ev);
+        free(ev);
+        ev = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    table_dump_polygons(&inout, 2U, E, N);
+
+    /* Close the output file. */
+    table_close(&inout);
+
+    /* Deallocate memory. */
+    memset(P, 0, ((n * N) << 1U) * sizeof *P);
+    free(P);
+    P = (real_t*)(NULL);
+    memset(E, 0, (N << 2U) * sizeof *E);
+    free(E);
+    E = (real_t*)(NULL);
+    memset(ev, 0, N * sizeof *ev);
+    free(ev);
+    ev = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
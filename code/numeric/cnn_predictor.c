@@ -0,0 +1,479 @@
+/**
+ * Program for predicting the first Laplace eigenvalues of polygons by the
+ * convolutional neural network.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./cnn_predict model in N T out
+ * where:
+ *     model is the path to the input file to read the parameters of the
+ *           network (as exported by the script "cnn_exporter.py"),
+ *     in    is the path to the input file to read the rasterised polygons,
+ *     N     is the number of polygons to read (at least 1),
+ *     T     is the number of threads (at least 1),
+ *     out   is the path to the output file to print the predictions.
+ *
+ * The model file must contain the parameters of a network of 1 output ordered
+ * as described in "cnn.h".  The model "models/convolutional_neural_network.h5"
+ * is exported by
+ *     $ python cnn_exporter.py models/convolutional_neural_network.h5 \
+ *         models/convolutional_neural_network_normalisation_factor.txt \
+ *         models/convolutional_neural_network.npy
+ *
+ * Each polygon must be given in the input file as a raster of H x W pixels of
+ * C channels (the shape of the input of the network), stored by rows of pixels
+ * with the channels of a pixel stored consecutively, such as the rows of a
+ * NumPy array of shape (N, H * W * C) of the visualisations of triangles
+ * computed by the function `visualise_triangle` from "usefulness.py" (without
+ * the normalisation factor, which is a part of the exported model).
+ *
+ * For each polygon a line
+ *     p	lambda
+ * is printed to the output file, where lambda is the predicted eigenvalue and
+ * p = 1 / lambda is its inverse (the same format as of the program compiled
+ * from "polynomial_predictor.c").
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the prediction.  Time needed to read and print is not measured.
+ *
+ * If the path to any of the files ends with ".npy" or ".pcz", the file is read
+ * or dumped as a NumPy array or as a compressed table with a single polygon
+ * per row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "cnn.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 5: model file path, input file "
+            "path, number of polygons to read, number of threads and output "
+            "file path.";
+
+    /* Error message for the illegal number of polygons to read. */
+    const char* const err_msg_npr =
+        "Number of polygons to read must be at least 1.";
+
+    /* Error message for the illegal number of threads. */
+    const char* const err_msg_nt = "Number of threads must be at least 1.";
+
+    /* Error message for the illegal model. */
+    const char* const err_msg_mod =
+        "Model must be a valid network of 1 output.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of layers, number of parameters of the network and numbers of
+     * values of an image and of an output. */
+    size_t L;
+    size_t m;
+    size_t n_in;
+    size_t n_out;
+
+    /* Number of polygons to read. */
+    size_t N;
+
+    /* Number of threads. */
+    size_t T;
+
+    /* Array of parameters of the network and a pointer for reallocation. */
+    real_t* F;
+    real_t* G;
+
+    /* Array of images, array of predictions and array of lines to print. */
+    real_t* X;
+    real_t* Y;
+    real_t* D;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Indicator of success and the error message of a fail. */
+    bool success;
+    const char* err_msg;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Numbers of layers, parameters and values. */
+    L = 0U;
+    m = 0U;
+    n_in = 0U;
+    n_out = 0U;
+
+    /* Number of polygons to read. */
+    N = 0U;
+
+    /* Number of threads. */
+    T = 0U;
+
+    /* Arrays. */
+    F = (real_t*)(NULL);
+    G = (real_t*)(NULL);
+    X = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+    D = (real_t*)(NULL);
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Indicator of success and the error message of a fail. */
+    success = true;
+    err_msg = err_msg_env;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 5, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 6))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 6 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of polygons to read and the number of threads. */
+    N = (size_t)atoi(*(argv + 3U));
+    T = (size_t)atoi(*(argv + 4U));
+
+    /* If the number of polygons to read is 0, print the error message and exit
+     * with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of threads is 0, print the error message and exit with a
+     * non-zero value. */
+    if (!T)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nt);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Open the model file.  If the file could not be opened, print the error
+     * message and exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 1U), false))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Read the parameters of the network:  the shape of the input and the
+     * number of layers, the descriptions of the layers and the rest of the
+     * parameters, reallocating the array once the length of each part is
+     * known. */
+    m = 4U;
+    for (j = 0U; success && j < 3U; ++j)
+    {
+        /* Reallocate memory. */
+        G = (real_t*)realloc(F, m * sizeof *F);
+        success = (G != NULL);
+        if (success)
+            F = G;
+        else
+            err_msg = err_msg_mem;
+        G = (real_t*)(NULL);
+
+        /* Read the values. */
+        for (; success && i < m; ++i)
+            if (!(table_scan(&inout, 1U, F + i) == 1U))
+            {
+                success = false;
+                err_msg = err_msg_rv;
+            }
+
+        /* Find the length of the next part. */
+        if (success && !j)
+        {
+            L = (*(F + 3U) >= 1.0) ? (size_t)*(F + 3U) : 0U;
+            m = 4U + CNN_LAYER * L;
+            success = (L != 0U);
+            err_msg = err_msg_mod;
+        }
+        else if (success && j == 1U)
+        {
+            m = cnn_length(F, NULL, NULL, &n_out);
+            success = (m && n_out == 1U);
+            err_msg = err_msg_mod;
+        }
+    }
+
+    /* Close the model file. */
+    table_close(&inout);
+
+    /* If the network could not be read or is not valid, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!success)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    n_in = (size_t)*F * (size_t)*(F + 1U) * (size_t)*(F + 2U);
+
+    /* Allocate memory. */
+    X = (real_t*)malloc(n_in * N * sizeof *X);
+    Y = (real_t*)malloc(N * sizeof *Y);
+    D = (real_t*)malloc((N << 1U) * sizeof *D);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(X && Y && D))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Y);
+        Y = (real_t*)(NULL);
+        free(D);
+        D = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(X, 0, n_in * N * sizeof *X);
+    memset(Y, 0, N * sizeof *Y);
+    memset(D, 0, (N << 1U) * sizeof *D);
+
+    /* Open the input file and read the images.  If the file could not be
+     * opened or if any of the values could not be read, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 2U), false))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Y);
+        Y = (real_t*)(NULL);
+        free(D);
+        D = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0U; i < N; ++i)
+        if (!(table_scan(&inout, n_in, X + i * n_in) == n_in))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_rv);
+
+            /* Close the input file. */
+            table_close(&inout);
+
+            /* Deallocate memory. */
+            free(F);
+            F = (real_t*)(NULL);
+            free(X);
+            X = (real_t*)(NULL);
+            free(Y);
+            Y = (real_t*)(NULL);
+            free(D);
+            D = (real_t*)(NULL);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+
+    /* Close the input file. */
+    table_close(&inout);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Evaluate the network. */
+    success = cnn_batch(F, N, X, Y, T);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Print the time elapsed during the prediction. */
+    printf(
+        format_time,
+        (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+    );
+
+    /* If the network could not be evaluated, print the error message,
+     * deallocate memory and exit with a non-zero value. */
+    if (!success)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Y);
+        Y = (real_t*)(NULL);
+        free(D);
+        D = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Store the inverses of the eigenvalues and the eigenvalues in the array
+     * `D` (2 values per polygon, so the `table_dump_polygons` function is
+     * used as for 1-gons). */
+    for (i = 0U; i < N; ++i)
+    {
+        *(D + (i << 1U)) = 1.0 / *(Y + i);
+        *(D + (i << 1U) + 1U) = *(Y + i);
+    }
+
+    /* Open the output file and dump the predictions.  If the file could not be
+     * opened, print the error message, deallocate memory and exit with a
+     * non-zero value. */
+    if (!table_open(&inout, *(argv + 5U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Y);
+        Y = (real_t*)(NULL);
+        free(D);
+        D = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    table_dump_polygons(&inout, 1U, D, N);
+
+    /* Close the output file. */
+    table_close(&inout);
+
+    /* Deallocate memory. */
+    memset(F, 0, m * sizeof *F);
+    free(F);
+    F = (real_t*)(NULL);
+    memset(X, 0, n_in * N * sizeof *X);
+    free(X);
+    X = (real_t*)(NULL);
+    memset(Y, 0, N * sizeof *Y);
+    free(Y);
+    Y = (real_t*)(NULL);
+    memset(D, 0, (N << 1U) * sizeof *D);
+    free(D);
+    D = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,549 @@
+/**
+ * Program for predicting the first Laplace eigenvalues of perturbed polygons
+ * from the eigenvalues and the boundary fluxes of their base polygons.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./hadamard_label in N0 n N1 ev flux tol out rest
+ * where:
+ *     in   is the path to the input file to read the coordinates of vertices
+ *          of the perturbed polygons (as printed by the program
+ *          "generators/perturbator.c"),
+ *     N0   is the number of base polygons (at least 1),
+ *     n    is the number of vertices of each polygon (at least 3),
+ *     N1   is the number of polygons generated from each base polygon (at
+ *          least 1),
+ *     ev   is the path to the input file to read the eigenvalues of the base
+ *          polygons,
+ *     flux is the path to the input file to read the moments of the squared
+ *          boundary fluxes of the base polygons,
+ *     tol  is the tolerance for the estimated relative error of a prediction
+ *          (strictly positive),
+ *     out  is the path to the output file to print the eigenvalues,
+ *     rest is the path to the output file to print the polygons whose
+ *          eigenvalues must be computed by a full solver.
+ *
+ * The input file must contain N0 * N1 polygons formated as
+ *     x_0	y_0	x_1	y_1	...	x_n_minus_1	y_n_minus_1
+ * where x_i denotes the x-coordinate of the i-th vertex and y_i denotes the
+ * y-coordinate of the i-th vertex (whitespaces may differ).  The polygons are
+ * grouped by N1 and the first polygon of each group is its base polygon, as
+ * printed by the program "generators/perturbator.c".  The eigenvalues and the
+ * moments of the base polygons (one polygon per line, in the order of the
+ * groups) are computed by the script "numeric/computer.edp" with the option
+ * "-flux" run on the base polygons only (every N1-th polygon of the input
+ * file, starting from the first).
+ *
+ * For each polygon a line
+ *     lambda	err
+ * is printed to the output file, where lambda is the prediction of the first
+ * eigenvalue by Hadamard's formula and err is the estimate of its absolute
+ * error (see "hadamard.h").  Both are the undefined real number (see
+ * "numeric.h") if the eigenvalue or the moments of the base polygon are not
+ * finite.  The polygons whose estimated relative error err / lambda exceeds
+ * tol (or whose prediction is undefined) are also printed, in the order of the
+ * input file, to the rest file;  their eigenvalues should be computed by a
+ * full solver and put in place of the predictions.  The number of such
+ * polygons is printed to the console.
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the prediction of the eigenvalues.  Time needed to read and print is not
+ * measured.
+ *
+ * If the path to any of the files ends with ".npy" or ".pcz", the file is read
+ * or dumped as a NumPy array or as a compressed table with a single polygon
+ * per row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "hadamard.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 9: input file path, number of "
+            "base polygons, number of vertices, number of polygons per base "
+            "polygon, eigenvalues file path, fluxes file path, tolerance, "
+            "output file path and rest file path.";
+
+    /* Error message for the illegal number of base polygons. */
+    const char* const err_msg_npr =
+        "Number of base polygons must be at least 1.";
+
+    /* Error message for the illegal number of vertices. */
+    const char* const err_msg_nv = "Number of vertices must be at least 3.";
+
+    /* Error message for the illegal number of polygons per base polygon. */
+    const char* const err_msg_npg =
+        "Number of polygons per base polygon must be at least 1.";
+
+    /* Error message for the illegal tolerance. */
+    const char* const err_msg_tol = "Tolerance must be strictly positive.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* Format string for printing the number of polygons to solve. */
+    const char* const format_count = "Polygons left for full solving: %lu.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of base polygons. */
+    size_t N0;
+
+    /* Number of vertices of each polygon. */
+    size_t n;
+
+    /* Number of polygons per base polygon. */
+    size_t N1;
+
+    /* Tolerance. */
+    real_t tol;
+
+    /* Array of vertices, array of eigenvalues, array of moments, array of
+     * gradients, array of predictions and their errors, and the workspace. */
+    real_t* P;
+    real_t* ev;
+    real_t* M;
+    real_t* G;
+    real_t* E;
+    real_t* R;
+
+    /* Number of polygons left for full solving. */
+    size_t count;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Number of base polygons. */
+    N0 = 0U;
+
+    /* Number of vertices of each polygon. */
+    n = 0U;
+
+    /* Number of polygons per base polygon. */
+    N1 = 0U;
+
+    /* Tolerance. */
+    tol = 0.0;
+
+    /* Arrays. */
+    P = (real_t*)(NULL);
+    ev = (real_t*)(NULL);
+    M = (real_t*)(NULL);
+    G = (real_t*)(NULL);
+    E = (real_t*)(NULL);
+    R = (real_t*)(NULL);
+
+    /* Number of polygons left for full solving. */
+    count = 0U;
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 9, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 10))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 10 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U) &&
+            *(argv + 6U) &&
+            *(argv + 7U) &&
+            *(argv + 8U) &&
+            *(argv + 9U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the numbers of polygons, the number of vertices and the
+     * tolerance. */
+    N0 = (size_t)atoi(*(argv + 2U));
+    n = (size_t)atoi(*(argv + 3U));
+    N1 = (size_t)atoi(*(argv + 4U));
+    tol = (real_t)atof(*(argv + 7U));
+
+    /* If the number of base polygons is 0, print the error message and exit
+     * with a non-zero value. */
+    if (!N0)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of vertices is less than 3, print the error message and
+     * exit with a non-zero value. */
+    if (n < 3U)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nv);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of polygons per base polygon is 0, print the error
+     * message and exit with a non-zero value. */
+    if (!N1)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npg);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the tolerance is not strictly positive, print the error message and
+     * exit with a non-zero value. */
+    if (!(0.0 < tol))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_tol);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory. */
+    P = (real_t*)malloc(((N0 * N1 * n) << 1U) * sizeof *P);
+    ev = (real_t*)malloc(N0 * sizeof *ev);
+    M = (real_t*)malloc(((N0 * n) << 1U) * sizeof *M);
+    G = (real_t*)malloc(((N0 * n) << 1U) * sizeof *G);
+    E = (real_t*)malloc(((N0 * N1) << 1U) * sizeof *E);
+    R = (real_t*)malloc((n << 1U) * sizeof *R);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(P && ev && M && G && E && R))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(ev);
+        ev = (real_t*)(NULL);
+        free(M);
+        M = (real_t*)(NULL);
+        free(G);
+        G = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(R);
+        R = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(P, 0, ((N0 * N1 * n) << 1U) * sizeof *P);
+    memset(ev, 0, N0 * sizeof *ev);
+    memset(M, 0, ((N0 * n) << 1U) * sizeof *M);
+    memset(G, 0, ((N0 * n) << 1U) * sizeof *G);
+    memset(E, 0, ((N0 * N1) << 1U) * sizeof *E);
+    memset(R, 0, (n << 1U) * sizeof *R);
+
+    /* Read the polygons, the eigenvalues and the moments (the `j`-th file
+     * fills the `j`-th array).  If any of the files could not be opened or if
+     * any of the values could not be read, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    for (j = 0U; j < 3U; ++j)
+    {
+        if (!table_open(&inout, *(argv + (j ? 4U + j : 1U)), false))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_in);
+
+            /* Deallocate memory. */
+            free(P);
+            P = (real_t*)(NULL);
+            free(ev);
+            ev = (real_t*)(NULL);
+            free(M);
+            M = (real_t*)(NULL);
+            free(G);
+            G = (real_t*)(NULL);
+            free(E);
+            E = (real_t*)(NULL);
+            free(R);
+            R = (real_t*)(NULL);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+        for (
+            i = 0U;
+            i < (
+                (j == 0U) ?
+                    ((N0 * N1 * n) << 1U) :
+                    ((j == 1U) ? N0 : ((N0 * n) << 1U))
+            );
+            ++i
+        )
+            if (
+                !(
+                    table_scan(
+                        &inout,
+                        1U,
+                        ((j == 0U) ? P : ((j == 1U) ? ev : M)) + i
+                    ) == 1U
+                )
+            )
+            {
+                /* Print the error message. */
+                fprintf(stderr, format_err_msg, err_msg_rv);
+
+                /* Close the input file. */
+                table_close(&inout);
+
+                /* Deallocate memory. */
+                free(P);
+                P = (real_t*)(NULL);
+                free(ev);
+                ev = (real_t*)(NULL);
+                free(M);
+                M = (real_t*)(NULL);
+                free(G);
+                G = (real_t*)(NULL);
+                free(E);
+                E = (real_t*)(NULL);
+                free(R);
+                R = (real_t*)(NULL);
+
+                /* Exit with a non-zero value. */
+                exit(EXIT_FAILURE);
+            }
+
+        /* Close the input file. */
+        table_close(&inout);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Predict the eigenvalues group by group.  Non-finite eigenvalues or
+     * moments (NaN printed by the script for failed computations) make the
+     * predictions of the group undefined. */
+    for (i = 0U; i < N0; ++i)
+    {
+        hadamard_gradient(
+            n,
+            P + ((i * N1 * n) << 1U),
+            M + ((i * n) << 1U),
+            G + ((i * n) << 1U)
+        );
+        for (j = 0U; j < N1; ++j)
+        {
+            *(E + ((i * N1 + j) << 1U)) = hadamard_predict(
+                n,
+                P + ((i * N1 * n) << 1U),
+                *(ev + i),
+                G + ((i * n) << 1U),
+                P + (((i * N1 + j) * n) << 1U),
+                R,
+                E + ((i * N1 + j) << 1U) + 1U
+            );
+            if (
+                !(
+                    rabs(*(E + ((i * N1 + j) << 1U))) < lambda &&
+                    rabs(*(E + ((i * N1 + j) << 1U) + 1U)) < lambda
+                )
+            )
+            {
+                *(E + ((i * N1 + j) << 1U)) = lambda;
+                *(E + ((i * N1 + j) << 1U) + 1U) = lambda;
+            }
+        }
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Print the time elapsed during the prediction of the eigenvalues. */
+    printf(
+        format_time,
+        (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+    );
+
+    /* Open the output file and dump the predictions (2 values per polygon, so
+     * the `table_dump_polygons` function is used as for 1-gons).  If the file
+     * could not be opened, print the error message, deallocate memory and
+     * exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 8U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(ev);
+        ev = (real_t*)(NULL);
+        free(M);
+        M = (real_t*)(NULL);
+        free(G);
+        G = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(R);
+        R = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    table_dump_polygons(&inout, 1U, E, N0 * N1);
+
+    /* Close the output file. */
+    table_close(&inout);
+
+    /* Open the rest file and dump the polygons whose predictions are not
+     * accurate enough.  If the file could not be opened, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 9U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(ev);
+        ev = (real_t*)(NULL);
+        free(M);
+        M = (real_t*)(NULL);
+        free(G);
+        G = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(R);
+        R = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0U; i < N0 * N1; ++i)
+        if (
+            *(E + (i << 1U)) == lambda ||
+            *(E + (i << 1U) + 1U) > tol * rabs(*(E + (i << 1U)))
+        )
+        {
+            table_dump_polygons(&inout, n, P + ((i * n) << 1U), 1U);
+            ++count;
+        }
+
+    /* Close the rest file. */
+    table_close(&inout);
+
+    /* Print the number of polygons left for full solving. */
+    printf(format_count, (unsigned long)count);
+
+    /* Deallocate memory. */
+    memset(P, 0, ((N0 * N1 * n) << 1U) * sizeof *P);
+    free(P);
+    P = (real_t*)(NULL);
+    memset(ev, 0, N0 * sizeof *ev);
+    free(ev);
+    ev = (real_t*)(NULL);
+    memset(M, 0, ((N0 * n) << 1U) * sizeof *M);
+    free(M);
+    M = (real_t*)(NULL);
+    memset(G, 0, ((N0 * n) << 1U) * sizeof *G);
+    free(G);
+    G = (real_t*)(NULL);
+    memset(E, 0, ((N0 * N1) << 1U) * sizeof *E);
+    free(E);
+    E = (real_t*)(NULL);
+    memset(R, 0, (n << 1U) * sizeof *R);
+    free(R);
+    R = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,268 @@
+/**
+ * Program for building a KD-tree index of the nearest neighbours of points in
+ * a feature space.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./knn_index m in N out
+ * where:
+ *     m   is the number of values (dimensions) in each row (at least 1 and at
+ *         most 255),
+ *     in  is the path to the input file to read the points,
+ *     N   is the number of points to read (at least 1),
+ *     out is the path to the output file to save the index.
+ *
+ * Each row of the input file is a point of m values (such as a row of
+ * "singular_values.tsv", "sorted_descriptions.tsv" or "characteristics.tsv" in
+ * "data/numerical"), and the index of a point is the index of its row.  The
+ * features are used as they are, so features of different scales should be
+ * standardised beforehand (see "sketch.py").
+ *
+ * The index is saved as the block of the tree described in "kdtree.h" and is
+ * mapped to memory by the program "numeric/knn_searcher.c" without parsing.
+ * It may only be opened on a host of the same byte order and of the same type
+ * `real_t` (see "numeric.h").
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the building of the tree.  Time needed to read and save is not measured.
+ *
+ * If the path to the input file ends with ".npy" or ".pcz", the file is read
+ * as a NumPy array or as a compressed table instead of a text file (see
+ * "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "kdtree.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 4: number of values in each "
+            "row, input file path, number of points to read and output file "
+            "path.";
+
+    /* Error message for the illegal number of values in each row. */
+    const char* const err_msg_nv =
+        "Number of values in each row must be at least 1 and at most 255.";
+
+    /* Error message for the illegal number of points to read. */
+    const char* const err_msg_npr =
+        "Number of points to read must be at least 1.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Error message for failing to save the index. */
+    const char* const err_msg_out = "Index cannot be saved.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of values in each row and the number of points to read. */
+    size_t m;
+    size_t N;
+
+    /* Array of points. */
+    real_t* X;
+
+    /* Input file. */
+    table_t in;
+
+    /* Tree. */
+    kdtree_t tree;
+
+    /* Indicator of success and the error message of a fail. */
+    bool success;
+    const char* err_msg;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Number of values in each row and the number of points to read. */
+    m = 0U;
+    N = 0U;
+
+    /* Array of points. */
+    X = (real_t*)(NULL);
+
+    /* Input file. */
+    memset(&in, 0, sizeof in);
+
+    /* Tree. */
+    memset(&tree, 0, sizeof tree);
+
+    /* Indicator of success and the error message of a fail. */
+    success = true;
+    err_msg = err_msg_env;
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 4, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 5))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 5 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of values in each row and the number of points to
+     * read. */
+    m = (size_t)atoi(*(argv + 1U));
+    N = (size_t)atoi(*(argv + 3U));
+
+    /* Check the numbers and select the error message. */
+    if (!(m && m < 256U))
+        err_msg = err_msg_nv;
+    else if (!N)
+        err_msg = err_msg_npr;
+    else
+        err_msg = (const char*)(NULL);
+
+    /* If any of the numbers is illegal, print the error message and exit with
+     * a non-zero value. */
+    if (err_msg)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory for the points. */
+    X = (real_t*)malloc(N * m * sizeof *X);
+    success = X ? true : false;
+    err_msg = err_msg_mem;
+    if (success)
+        memset(X, 0, N * m * sizeof *X);
+
+    /* Read the points. */
+    if (success)
+    {
+        success = table_open(&in, *(argv + 2U), false);
+        err_msg = err_msg_in;
+    }
+    if (success)
+    {
+        for (i = 0U; success && i < N; ++i)
+            success = (table_scan(&in, m, X + i * m) == m);
+        err_msg = err_msg_rv;
+        table_close(&in);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Build the tree. */
+    if (success)
+    {
+        success = !kdtree_build(&tree, m, N, X);
+        err_msg = err_msg_mem;
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Save the tree. */
+    if (success)
+    {
+        success = !kdtree_save(&tree, *(argv + 4U));
+        err_msg = err_msg_out;
+    }
+
+    /* Print the time elapsed during the building of the tree. */
+    if (success)
+        printf(
+            format_time,
+            (double)(t1.tv_sec - t0.tv_sec) +
+                1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+        );
+
+    /* If anything has failed, print the error message. */
+    else
+        fprintf(stderr, format_err_msg, err_msg);
+
+    /* Close the tree. */
+    kdtree_close(&tree);
+
+    /* Deallocate memory. */
+    if (X)
+        memset(X, 0, N * m * sizeof *X);
+    free(X);
+    X = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value) on success. */
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,366 @@
+/**
+ * Program for finding the nearest neighbours of points in a feature space by
+ * a KD-tree index.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./knn_search index in N k r T out
+ * where:
+ *     index is the path to the index (as saved by the program
+ *           "numeric/knn_indexer.c"),
+ *     in    is the path to the input file to read the points of the queries,
+ *     N     is the number of queries to read (at least 1),
+ *     k     is the number of neighbours of each query (0 to count the points
+ *           within the radius instead),
+ *     r     is the radius (only points within the radius are neighbours; a
+ *           negative radius is unbounded),
+ *     T     is the number of threads (at least 1),
+ *     out   is the path to the output file to print the neighbours.
+ *
+ * Each row of the input file is a point of as many values as the points of
+ * the index.  If k is at least 1, a line
+ *     i_1	i_2	...	i_k	d_1	d_2	...	d_k
+ * is printed to the output file for each query, where i_j is the index of the
+ * j-th nearest point of the index (the index of its row in the file from which
+ * the index was built) and d_j is its (Euclidean) distance to the query.  If
+ * fewer than k points are within the radius, the remaining indices and
+ * distances are -1.  If k is 0, a line
+ *     c
+ * is printed instead, where c is the number of points of the index within the
+ * radius of the query.
+ *
+ * Querying an index by the file from which it was built with k = 2 finds the
+ * nearest other polygon of each polygon, and with k = 0 and a small radius the
+ * number of (near) duplicates of each polygon (counting the polygon itself),
+ * for instance to check that no polygon of the test set has a near duplicate
+ * in the training set.
+ *
+ * The index is mapped to memory (see "kdtree.h"), so it is read only as far as
+ * the queries visit it and it is shared by all processes searching it.  The
+ * queries are answered in T threads.
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the search.  Time needed to read and print is not measured.
+ *
+ * If the path to the input or the output file ends with ".npy" or ".pcz", the
+ * file is read or dumped as a NumPy array or as a compressed table instead of
+ * a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "kdtree.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 7: index file path, input file "
+            "path, number of queries to read, number of neighbours, radius, "
+            "number of threads and output file path.";
+
+    /* Error message for the illegal number of queries to read. */
+    const char* const err_msg_npr =
+        "Number of queries to read must be at least 1.";
+
+    /* Error message for the illegal number of threads. */
+    const char* const err_msg_nt = "Number of threads must be at least 1.";
+
+    /* Error message for index opening fail. */
+    const char* const err_msg_index =
+        "Index cannot be opened (or was built on an incompatible host).";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of queries, the number of neighbours, the radius and the number
+     * of threads. */
+    size_t N;
+    size_t k;
+    real_t r;
+    size_t T;
+
+    /* Number of values in each output row. */
+    size_t w;
+
+    /* Array of the points of the queries and array of the output rows. */
+    real_t* Q;
+    real_t* Y;
+
+    /* Arrays of the numbers of neighbours found, of their indices and of their
+     * distances. */
+    size_t* C;
+    size_t* I;
+    real_t* D;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Tree. */
+    kdtree_t tree;
+
+    /* Indicator of success and the error message of a fail. */
+    bool success;
+    const char* err_msg;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Number of queries, the number of neighbours, the radius and the number
+     * of threads. */
+    N = 0U;
+    k = 0U;
+    r = -1.0;
+    T = 0U;
+
+    /* Number of values in each output row. */
+    w = 0U;
+
+    /* Arrays. */
+    Q = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+    C = (size_t*)(NULL);
+    I = (size_t*)(NULL);
+    D = (real_t*)(NULL);
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Tree. */
+    memset(&tree, 0, sizeof tree);
+
+    /* Indicator of success and the error message of a fail. */
+    success = true;
+    err_msg = err_msg_env;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 7, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 8))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 8 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    for (i = 0U; argv && i < (size_t)argc; ++i)
+        if (!*(argv + i))
+            break;
+    if (!(argv && i == (size_t)argc))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the numbers and the radius. */
+    N = (size_t)atoi(*(argv + 3U));
+    k = (size_t)atoi(*(argv + 4U));
+    r = (real_t)atof(*(argv + 5U));
+    T = (size_t)atoi(*(argv + 6U));
+    w = k ? k << 1U : 1U;
+
+    /* Check the numbers and select the error message. */
+    if (!N)
+        err_msg = err_msg_npr;
+    else if (!T)
+        err_msg = err_msg_nt;
+    else
+        err_msg = (const char*)(NULL);
+
+    /* If any of the numbers is illegal, print the error message and exit with
+     * a non-zero value. */
+    if (err_msg)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Open the index. */
+    success = !kdtree_open(&tree, *(argv + 1U));
+    err_msg = err_msg_index;
+
+    /* Allocate memory (the arrays `I` and `D` are not needed to count the
+     * points within the radius). */
+    if (success)
+    {
+        Q = (real_t*)malloc(N * tree.d * sizeof *Q);
+        Y = (real_t*)malloc(N * w * sizeof *Y);
+        C = (size_t*)malloc(N * sizeof *C);
+        if (k)
+        {
+            I = (size_t*)malloc(N * k * sizeof *I);
+            D = (real_t*)malloc(N * k * sizeof *D);
+        }
+        success = (Q && Y && C && (!k || (I && D))) ? true : false;
+        err_msg = err_msg_mem;
+    }
+    if (success)
+    {
+        memset(Q, 0, N * tree.d * sizeof *Q);
+        memset(Y, 0, N * w * sizeof *Y);
+        memset(C, 0, N * sizeof *C);
+        if (k)
+        {
+            memset(I, 0, N * k * sizeof *I);
+            memset(D, 0, N * k * sizeof *D);
+        }
+    }
+
+    /* Read the points of the queries. */
+    if (success)
+    {
+        success = table_open(&inout, *(argv + 2U), false);
+        err_msg = err_msg_in;
+    }
+    if (success)
+    {
+        for (i = 0U; success && i < N; ++i)
+            success = (table_scan(&inout, tree.d, Q + i * tree.d) == tree.d);
+        err_msg = err_msg_rv;
+        table_close(&inout);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Answer the queries. */
+    if (success)
+        kdtree_batch(&tree, N, Q, k, r, C, I, D, T);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Store the indices and the distances of the neighbours (or the numbers of
+     * points within the radius) in the output rows. */
+    if (success)
+        for (i = 0U; i < N; ++i)
+        {
+            if (!k)
+                *(Y + i) = (real_t)(*(C + i));
+            for (j = 0U; j < k; ++j)
+            {
+                *(Y + i * w + j) =
+                    (j < *(C + i)) ? (real_t)(*(I + i * k + j)) : -1.0;
+                *(Y + i * w + k + j) =
+                    (j < *(C + i)) ? *(D + i * k + j) : -1.0;
+            }
+        }
+
+    /* Open the output file and dump the output rows. */
+    if (success)
+    {
+        success = table_open(&inout, *(argv + 7U), true);
+        err_msg = err_msg_out;
+    }
+    if (success)
+    {
+        table_dump(&inout, w, Y, N);
+        table_close(&inout);
+    }
+
+    /* Print the time elapsed during the search. */
+    if (success)
+        printf(
+            format_time,
+            (double)(t1.tv_sec - t0.tv_sec) +
+                1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+        );
+
+    /* If anything has failed, print the error message. */
+    else
+        fprintf(stderr, format_err_msg, err_msg);
+
+    /* Deallocate memory. */
+    if (Q)
+        memset(Q, 0, N * tree.d * sizeof *Q);
+    free(Q);
+    Q = (real_t*)(NULL);
+    if (Y)
+        memset(Y, 0, N * w * sizeof *Y);
+    free(Y);
+    Y = (real_t*)(NULL);
+    if (C)
+        memset(C, 0, N * sizeof *C);
+    free(C);
+    C = (size_t*)(NULL);
+    if (I)
+        memset(I, 0, N * k * sizeof *I);
+    free(I);
+    I = (size_t*)(NULL);
+    if (D)
+        memset(D, 0, N * k * sizeof *D);
+    free(D);
+    D = (real_t*)(NULL);
+
+    /* Close the tree. */
+    kdtree_close(&tree);
+
+    /* Return a zero value (exit with a zero value) on success. */
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,490 @@
+/**
+ * Program for predicting the first Laplace eigenvalues of triangles by the
+ * dense neural network.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./mlp_predict model desc sv N T out
+ * where:
+ *     model is the path to the input file to read the parameters of the
+ *           network (as exported by the script "mlp_exporter.py"),
+ *     desc  is the path to the input file to read the sorted descriptions of
+ *           triangles,
+ *     sv    is the path to the input file to read the singular values of
+ *           triangles,
+ *     N     is the number of triangles to read (at least 1),
+ *     T     is the number of threads (at least 1),
+ *     out   is the path to the output file to print the predictions.
+ *
+ * The model file must contain the parameters of a network of 8 features and 1
+ * output ordered as described in "mlp.h".  The model
+ * "models/neural_network.npy" is the model "models/neural_network.h5" exported
+ * to a NumPy array.
+ *
+ * Each triangle must be formated in the file of descriptions as
+ *     a	c	b	alpha	gamma	beta
+ * and in the file of singular values as
+ *     s_0	s_1	s_2	s_3	s_4	s_5
+ * (as in the files "sorted_descriptions.tsv" and "singular_values.tsv" of the
+ * datasets in "data/numerical", whitespaces may differ).  The features of the
+ * network are
+ *     c	b	alpha	gamma	beta	s_0	s_1	s_4
+ * (as in the notebook "Models.ipynb").
+ *
+ * For each triangle a line
+ *     p	lambda
+ * is printed to the output file, where lambda is the predicted eigenvalue and
+ * p = 1 / lambda is its inverse (the same format as of the program compiled
+ * from "polynomial_predictor.c").
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the prediction.  Time needed to read and print is not measured.
+ *
+ * If the path to any of the files ends with ".npy" or ".pcz", the file is read
+ * or dumped as a NumPy array or as a compressed table with a single polygon
+ * per row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "mlp.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 6: model file path, "
+            "descriptions file path, singular values file path, number of "
+            "triangles to read, number of threads and output file path.";
+
+    /* Error message for the illegal number of triangles to read. */
+    const char* const err_msg_npr =
+        "Number of triangles to read must be at least 1.";
+
+    /* Error message for the illegal number of threads. */
+    const char* const err_msg_nt = "Number of threads must be at least 1.";
+
+    /* Error message for the illegal model. */
+    const char* const err_msg_mod =
+        "Model must be a valid network of 8 features and 1 output.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* Columns of the features in the files of descriptions (if less than 6)
+     * and of singular values (6 added to the column). */
+    const size_t features[8U] = { 1U, 2U, 3U, 4U, 5U, 6U, 7U, 10U };
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of layers and number of parameters of the network. */
+    size_t L;
+    size_t m;
+
+    /* Number of triangles to read. */
+    size_t N;
+
+    /* Number of threads. */
+    size_t T;
+
+    /* Array of parameters of the network and a pointer for reallocation. */
+    real_t* F;
+    real_t* G;
+
+    /* Array of descriptions and singular values, array of features and array
+     * of predictions. */
+    real_t* D;
+    real_t* X;
+    real_t* Y;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Indicator of success and the error message of a fail. */
+    bool success;
+    const char* err_msg;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Number of layers and number of parameters of the network. */
+    L = 0U;
+    m = 0U;
+
+    /* Number of triangles to read. */
+    N = 0U;
+
+    /* Number of threads. */
+    T = 0U;
+
+    /* Arrays. */
+    F = (real_t*)(NULL);
+    G = (real_t*)(NULL);
+    D = (real_t*)(NULL);
+    X = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Indicator of success and the error message of a fail. */
+    success = true;
+    err_msg = err_msg_env;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 6, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 7))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 7 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U) &&
+            *(argv + 6U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of triangles to read and the number of threads. */
+    N = (size_t)atoi(*(argv + 4U));
+    T = (size_t)atoi(*(argv + 5U));
+
+    /* If the number of triangles to read is 0, print the error message and
+     * exit with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of threads is 0, print the error message and exit with a
+     * non-zero value. */
+    if (!T)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nt);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Open the model file.  If the file could not be opened, print the error
+     * message and exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 1U), false))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Read the parameters of the network:  the number of layers, the rest of
+     * the header and the rest of the parameters, reallocating the array once
+     * the length of each part is known. */
+    m = 1U;
+    for (j = 0U; success && j < 3U; ++j)
+    {
+        /* Reallocate memory. */
+        G = (real_t*)realloc(F, m * sizeof *F);
+        success = (G != NULL);
+        if (success)
+            F = G;
+        else
+            err_msg = err_msg_mem;
+        G = (real_t*)(NULL);
+
+        /* Read the values. */
+        for (; success && i < m; ++i)
+            if (!(table_scan(&inout, 1U, F + i) == 1U))
+            {
+                success = false;
+                err_msg = err_msg_rv;
+            }
+
+        /* Find the length of the next part. */
+        if (success && !j)
+        {
+            L = (*F >= 1.0) ? (size_t)*F : 0U;
+            m = 2U + (L << 1U);
+            success = (L != 0U);
+            err_msg = err_msg_mod;
+        }
+        else if (success && j == 1U)
+        {
+            m = mlp_length(F, NULL);
+            success = (m && *(F + 1U) == 8.0 && *(F + 1U + L) == 1.0);
+            err_msg = err_msg_mod;
+        }
+    }
+
+    /* Close the model file. */
+    table_close(&inout);
+
+    /* If the network could not be read or is not valid, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!success)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory. */
+    D = (real_t*)malloc(12U * N * sizeof *D);
+    X = (real_t*)malloc(8U * N * sizeof *X);
+    Y = (real_t*)malloc(N * sizeof *Y);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(D && X && Y))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+        free(D);
+        D = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Y);
+        Y = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(D, 0, 12U * N * sizeof *D);
+    memset(X, 0, 8U * N * sizeof *X);
+    memset(Y, 0, N * sizeof *Y);
+
+    /* Read the descriptions (if `j` is 0) and the singular values (if `j` is
+     * 1) into the first and the second half of each row of the array `D`.  If
+     * any of the files could not be opened or if any of the values could not
+     * be read, print the error message, deallocate memory and exit with a
+     * non-zero value. */
+    for (j = 0U; j < 2U; ++j)
+    {
+        if (!table_open(&inout, *(argv + (j ? 3U : 2U)), false))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_in);
+
+            /* Deallocate memory. */
+            free(F);
+            F = (real_t*)(NULL);
+            free(D);
+            D = (real_t*)(NULL);
+            free(X);
+            X = (real_t*)(NULL);
+            free(Y);
+            Y = (real_t*)(NULL);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0U; i < N; ++i)
+            if (!(table_scan(&inout, 6U, D + 12U * i + 6U * j) == 6U))
+            {
+                /* Print the error message. */
+                fprintf(stderr, format_err_msg, err_msg_rv);
+
+                /* Close the input file. */
+                table_close(&inout);
+
+                /* Deallocate memory. */
+                free(F);
+                F = (real_t*)(NULL);
+                free(D);
+                D = (real_t*)(NULL);
+                free(X);
+                X = (real_t*)(NULL);
+                free(Y);
+                Y = (real_t*)(NULL);
+
+                /* Exit with a non-zero value. */
+                exit(EXIT_FAILURE);
+            }
+
+        /* Close the input file. */
+        table_close(&inout);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Gather the features and evaluate the network. */
+    for (i = 0U; i < N; ++i)
+        for (j = 0U; j < 8U; ++j)
+            *(X + (i << 3U) + j) = *(D + 12U * i + features[j]);
+    success = mlp_batch(F, N, X, Y, T);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Print the time elapsed during the prediction. */
+    printf(
+        format_time,
+        (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+    );
+
+    /* If the network could not be evaluated, print the error message,
+     * deallocate memory and exit with a non-zero value. */
+    if (!success)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+        free(D);
+        D = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Y);
+        Y = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Store the inverses of the eigenvalues and the eigenvalues in the array
+     * `D` (2 values per triangle, so the `table_dump_polygons` function is
+     * used as for 1-gons). */
+    for (i = 0U; i < N; ++i)
+    {
+        *(D + (i << 1U)) = 1.0 / *(Y + i);
+        *(D + (i << 1U) + 1U) = *(Y + i);
+    }
+
+    /* Open the output file and dump the predictions.  If the file could not be
+     * opened, print the error message, deallocate memory and exit with a
+     * non-zero value. */
+    if (!table_open(&inout, *(argv + 6U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        free(F);
+        F = (real_t*)(NULL);
+        free(D);
+        D = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Y);
+        Y = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    table_dump_polygons(&inout, 1U, D, N);
+
+    /* Close the output file. */
+    table_close(&inout);
+
+    /* Deallocate memory. */
+    memset(F, 0, m * sizeof *F);
+    free(F);
+    F = (real_t*)(NULL);
+    memset(D, 0, 12U * N * sizeof *D);
+    free(D);
+    D = (real_t*)(NULL);
+    memset(X, 0, 8U * N * sizeof *X);
+    free(X);
+    X = (real_t*)(NULL);
+    memset(Y, 0, N * sizeof *Y);
+    free(Y);
+    Y = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
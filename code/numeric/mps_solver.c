@@ -0,0 +1,370 @@
+/**
+ * Program for computing the first Laplace eigenvalues on convex polygons by
+ * the method of particular solutions.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./mps_solve in N n p T out
+ * where:
+ *     in  is the path to the input file to read the coordinates of vertices,
+ *     N   is the number of polygons to read (at least 1),
+ *     n   is the number of vertices of each polygon (at least 3),
+ *     p   is the number of basis functions per vertex (at least 1, 12 is
+ *         enough for about 13 significant digits on triangles),
+ *     T   is the number of threads (at least 1),
+ *     out is the path to the output file to print the eigenvalues.
+ *
+ * Each polygon must be formated in the input file as
+ *     x_0	y_0	x_1	y_1	...	x_n_minus_1	y_n_minus_1
+ * where x_i denotes the x-coordinate of the i-th vertex and y_i denotes the
+ * y-coordinate of the i-th vertex.  Whitespaces may differ (they may even be
+ * spaces, tabs, line breaks...).  Polygons must be convex and their vertices
+ * must be enumerated in the mathematically positive order.
+ *
+ * Note that the input file must contain at least N polygons.  If, however, it
+ * contains more than N polygons, only the first N polygons are read.
+ *
+ * For each polygon a line
+ *     lambda	sigma
+ * is printed to the output file, where lambda is the approximation of the
+ * first eigenvalue and sigma is its error indicator (see "mps.h").  Both are
+ * the undefined real number (see "numeric.h") for unsupported polygons.
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the computation of the eigenvalues.  Time needed to read and print is not
+ * measured.
+ *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single polygon per row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Compile using the DGESVD driver. */
+#define _USE_SVD_DRIVER 1
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "mps.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 6: input file path, number of "
+            "polygons to read, number of vertices, number of basis functions, "
+            "number of threads and output file path.";
+
+    /* Error message for the illegal number of polygons to read. */
+    const char* const err_msg_npr =
+        "Number of polygons to read must be at least 1.";
+
+    /* Error message for the illegal number of vertices. */
+    const char* const err_msg_nv = "Number of vertices must be at least 3.";
+
+    /* Error message for the illegal number of basis functions. */
+    const char* const err_msg_nb =
+        "Number of basis functions must be at least 1.";
+
+    /* Error message for the illegal number of threads. */
+    const char* const err_msg_nt = "Number of threads must be at least 1.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a coordinate. */
+    const char* const err_msg_rc = "Reading a coordinate failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of polygons to read. */
+    size_t N;
+
+    /* Number of vertices of each polygon. */
+    size_t n;
+
+    /* Number of basis functions per vertex. */
+    size_t p;
+
+    /* Number of threads. */
+    size_t T;
+
+    /* Array of vertices and array of eigenvalues and their errors. */
+    real_t* P;
+    real_t* E;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Number of polygons to read. */
+    N = 0U;
+
+    /* Number of vertices of each polygon. */
+    n = 0U;
+
+    /* Number of basis functions per vertex. */
+    p = 0U;
+
+    /* Number of threads. */
+    T = 0U;
+
+    /* Arrays of vertices and of eigenvalues. */
+    P = (real_t*)(NULL);
+    E = (real_t*)(NULL);
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 6, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 7))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 7 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U) &&
+            *(argv + 6U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of polygons to read, the number of vertices, the number
+     * of basis functions and the number of threads. */
+    N = (size_t)atoi(*(argv + 2U));
+    n = (size_t)atoi(*(argv + 3U));
+    p = (size_t)atoi(*(argv + 4U));
+    T = (size_t)atoi(*(argv + 5U));
+
+    /* If the number of polygons to read is 0, print the error message and
+     * exit with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of vertices is less than 3, print the error message and
+     * exit with a non-zero value. */
+    if (n < 3U)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nv);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of basis functions is 0, print the error message and exit
+     * with a non-zero value. */
+    if (!p)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nb);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of threads is 0, print the error message and exit with a
+     * non-zero value. */
+    if (!T)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nt);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory for the polygons and the eigenvalues. */
+    P = (real_t*)malloc(((n * N) << 1U) * sizeof *P);
+    E = (real_t*)malloc((N << 1U) * sizeof *E);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(P && E))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(P, 0, ((n * N) << 1U) * sizeof *P);
+    memset(E, 0, (N << 1U) * sizeof *E);
+
+    /* Open the input file and read the polygons.  If the file could not be
+     * opened or if any of the coordinates could not be read, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 1U), false))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0U; i < ((n * N) << 1U); ++i)
+        if (!(table_scan(&inout, 1U, P + i) == 1U))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_rc);
+
+            /* Close the input file. */
+            table_close(&inout);
+
+            /* Deallocate memory. */
+            memset(P, 0, ((n * N) << 1U) * sizeof *P);
+            free(P);
+            P = (real_t*)(NULL);
+            free(E);
+            E = (real_t*)(NULL);
+    
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+
+    /* Close the input file. */
+    table_close(&inout);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Compute the eigenvalues. */
+    mps_solve_batch(n, N, P, p, E, T);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Print the time elapsed during the computation of the eigenvalues. */
+    printf(
+        format_time,
+        (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+    );
+
+    /* Open the output file and dump the eigenvalues (2 values per polygon, so
+     * the `table_dump_polygons` function is used as for 1-gons).  If the file
+     * could not be opened, print the error message, deallocate memory and
+     * exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 6U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        memset(P, 0, ((n * N) << 1U) * sizeof *P);
+        free(P);
+        P = (real_t*)(NULL);
+        memset(E, 0, (N << 1U) * sizeof *E);
+        free(E);
+        E = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    table_dump_polygons(&inout, 1U, E, N);
+
+    /* Close the output file. */
+    table_close(&inout);
+
+    /* Deallocate memory. */
+    memset(P, 0, ((n * N) << 1U) * sizeof *P);
+    free(P);
+    P = (real_t*)(NULL);
+    memset(E, 0, (N << 1U) * sizeof *E);
+    free(E);
+    E = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
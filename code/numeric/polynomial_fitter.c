@@ -0,0 +1,586 @@
+/**
+ * Program for fitting the polynomial regression models of the first Laplace
+ * eigenvalues of triangles with the degree chosen by cross-validation.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./polynomial_fit in ev N D k T out
+ * where:
+ *     in  is the path to the input file to read the second vertices,
+ *     ev  is the path to the input file to read the eigenvalues,
+ *     N   is the number of triangles to read (at least 1),
+ *     D   is the largest degree of the polynomial to try,
+ *     k   is the number of folds of the cross-validation (at least 2),
+ *     T   is the number of threads (at least 1),
+ *     out is the path to the output file to print the coefficients.
+ *
+ * Each triangle must be formated in the input file as
+ *     x_1	y_1
+ * where (x_1, y_1) is the second vertex of the triangle with vertices
+ * (1 / 2, 0), (x_1, y_1), (-1 / 2, 0) (as in the files "characteristics.tsv"
+ * of the datasets in "data/numerical", whitespaces may differ), and its first
+ * eigenvalue must be the corresponding value in the file of eigenvalues.  As in
+ * the notebook "Models.ipynb", the polynomials predict the inverse of the
+ * eigenvalue.
+ *
+ * The triangles are read and accumulated block by block (see "gram.h"), so
+ * the memory used does not depend on the number of triangles.  The i-th
+ * triangle belongs to the fold i mod k, and for each degree d = 0, 1, ..., D
+ * the root mean squared error of the inverse of the eigenvalue over all folds
+ * (each predicted by the polynomial fitted on the other folds) is printed to
+ * the console.  The degree of the smallest error is then fitted on all
+ * triangles and its (d + 1) (d + 2) / 2 coefficients are printed to the output
+ * file as a single row in the order described in "polynomial.h" (the format
+ * of the script "polynomial_exporter.py", so the output is read by the
+ * program compiled from "polynomial_predictor.c" and by `numpy.loadtxt` or
+ * `numpy.load`).
+ *
+ * The pogram prints to the console the (wall clock) time elapsed during the
+ * accumulation and the solving.  As the triangles are streamed, time needed to
+ * read them is included.
+ *
+ * If the path to any of the input files ends with ".npy" or ".pcz", the file
+ * is read as a NumPy array or as a compressed table instead of a text file
+ * (see "table.h").  If the path to the output file ends with ".npy", the
+ * coefficients are dumped as a NumPy array of shape (1, (d + 1) (d + 2) / 2).
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "polynomial.h"
+#include "gram.h"
+#include "npy.h"
+#include "table.h"
+
+/* Define the number of triangles of a block. */
+#define POLYNOMIAL_FIT_BLOCK 16384U
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 7: input file path, "
+            "eigenvalues file path, number of triangles to read, largest "
+            "degree of the polynomial, number of folds, number of threads and "
+            "output file path.";
+
+    /* Error message for the illegal number of triangles to read. */
+    const char* const err_msg_npr =
+        "Number of triangles to read must be at least 1.";
+
+    /* Error message for the illegal number of folds. */
+    const char* const err_msg_nf = "Number of folds must be at least 2.";
+
+    /* Error message for the illegal number of threads. */
+    const char* const err_msg_nt = "Number of threads must be at least 1.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Error message for failing to fit any of the polynomials. */
+    const char* const err_msg_fit = "No polynomial could be fitted.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the cross-validated error of a degree. */
+    const char* const format_cv =
+        "Degree %lu: cross-validated RMSE of 1 / lambda %.8e.\n";
+
+    /* Format string for printing a degree that could not be fitted. */
+    const char* const format_cv_fail = "Degree %lu: singular normal system.\n";
+
+    /* Format string for printing the selected degree. */
+    const char* const format_degree = "Selected degree: %lu.\n";
+
+    /* Format strings for printing the coefficients to a text file. */
+    const char* const format_first = "%.18e";
+    const char* const format_next = "\t%.18e";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Largest degree, the number of its coefficients, the number of folds and
+     * a degree. */
+    size_t D;
+    size_t m;
+    size_t k;
+    size_t d;
+
+    /* Number of triangles to read, the number of triangles read so far and
+     * the number of triangles of the current block. */
+    size_t N;
+    size_t done;
+    size_t n;
+
+    /* Number of threads. */
+    size_t T;
+
+    /* Arrays of features, of targets, of accumulators and the workspace. */
+    real_t* Z;
+    real_t* y;
+    real_t* A;
+    real_t* W;
+
+    /* Arrays of the Cholesky factor, of the scaling factors, of the
+     * coefficients and of the squared errors of the degrees. */
+    real_t* L;
+    real_t* s;
+    real_t* b;
+    real_t* E;
+
+    /* Point read and the eigenvalue read. */
+    real_t x[2U];
+    real_t lambda_1;
+
+    /* Largest number of features factorised and the indicator of degrees that
+     * could be fitted. */
+    size_t r;
+    bool* fitted;
+
+    /* Input files and the output file. */
+    table_t in;
+    table_t ev;
+    FILE* out;
+
+    /* Indicator of success and the error message of a fail. */
+    bool success;
+    const char* err_msg;
+
+    /* Selected degree. */
+    size_t e;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Degrees, numbers of coefficients and folds. */
+    D = 0U;
+    m = 0U;
+    k = 0U;
+    d = 0U;
+
+    /* Numbers of triangles. */
+    N = 0U;
+    done = 0U;
+    n = 0U;
+
+    /* Number of threads. */
+    T = 0U;
+
+    /* Arrays. */
+    Z = (real_t*)(NULL);
+    y = (real_t*)(NULL);
+    A = (real_t*)(NULL);
+    W = (real_t*)(NULL);
+    L = (real_t*)(NULL);
+    s = (real_t*)(NULL);
+    b = (real_t*)(NULL);
+    E = (real_t*)(NULL);
+
+    /* Point and eigenvalue read. */
+    memset(x, 0, 2U * sizeof *x);
+    lambda_1 = 0.0;
+
+    /* Factorised features and fitted degrees. */
+    r = 0U;
+    fitted = (bool*)(NULL);
+
+    /* Files. */
+    memset(&in, 0, sizeof in);
+    memset(&ev, 0, sizeof ev);
+    out = (FILE*)(NULL);
+
+    /* Indicator of success and the error message of a fail. */
+    success = true;
+    err_msg = err_msg_env;
+
+    /* Selected degree. */
+    e = 0U;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 7, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 8))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 8 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U) &&
+            *(argv + 6U) &&
+            *(argv + 7U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of triangles to read, the largest degree, the number of
+     * folds and the number of threads. */
+    N = (size_t)atoi(*(argv + 3U));
+    D = (size_t)atoi(*(argv + 4U));
+    m = polynomial_size(D);
+    k = (size_t)atoi(*(argv + 5U));
+    T = (size_t)atoi(*(argv + 6U));
+
+    /* If the number of triangles to read is 0, print the error message and
+     * exit with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of folds is less than 2, print the error message and exit
+     * with a non-zero value. */
+    if (k < 2U)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nf);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of threads is 0, print the error message and exit with a
+     * non-zero value. */
+    if (!T)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nt);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory. */
+    Z = (real_t*)malloc(m * POLYNOMIAL_FIT_BLOCK * sizeof *Z);
+    y = (real_t*)malloc(POLYNOMIAL_FIT_BLOCK * sizeof *y);
+    A = (real_t*)malloc(T * (k + 1U) * gram_slot(m) * sizeof *A);
+    W = (real_t*)malloc((m + 1U) * POLYNOMIAL_FIT_BLOCK * sizeof *W);
+    L = (real_t*)malloc(m * m * sizeof *L);
+    s = (real_t*)malloc(m * sizeof *s);
+    b = (real_t*)malloc(m * sizeof *b);
+    E = (real_t*)malloc((D + 1U) * sizeof *E);
+    fitted = (bool*)malloc((D + 1U) * sizeof *fitted);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(Z && y && A && W && L && s && b && E && fitted))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(Z);
+        Z = (real_t*)(NULL);
+        free(y);
+        y = (real_t*)(NULL);
+        free(A);
+        A = (real_t*)(NULL);
+        free(W);
+        W = (real_t*)(NULL);
+        free(L);
+        L = (real_t*)(NULL);
+        free(s);
+        s = (real_t*)(NULL);
+        free(b);
+        b = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(fitted);
+        fitted = (bool*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(Z, 0, m * POLYNOMIAL_FIT_BLOCK * sizeof *Z);
+    memset(y, 0, POLYNOMIAL_FIT_BLOCK * sizeof *y);
+    memset(A, 0, T * (k + 1U) * gram_slot(m) * sizeof *A);
+    memset(W, 0, (m + 1U) * POLYNOMIAL_FIT_BLOCK * sizeof *W);
+    memset(L, 0, m * m * sizeof *L);
+    memset(s, 0, m * sizeof *s);
+    memset(b, 0, m * sizeof *b);
+    memset(E, 0, (D + 1U) * sizeof *E);
+    for (d = 0U; d <= D; ++d)
+        *(fitted + d) = true;
+
+    /* Open the input files (the file of eigenvalues only if the first file was
+     * opened). */
+    success = table_open(&in, *(argv + 1U), false);
+    if (success && !table_open(&ev, *(argv + 2U), false))
+    {
+        table_close(&in);
+        success = false;
+    }
+    err_msg = err_msg_in;
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Read the triangles and the eigenvalues block by block and accumulate
+     * the monomials and the inverses of the eigenvalues. */
+    for (done = 0U; success && done < N; done += n)
+    {
+        n = (N - done < POLYNOMIAL_FIT_BLOCK) ? N - done : POLYNOMIAL_FIT_BLOCK;
+        for (i = 0U; success && i < n; ++i)
+        {
+            success =
+                (table_scan(&in, 2U, x) == 2U) &&
+                (table_scan(&ev, 1U, &lambda_1) == 1U);
+            polynomial_terms(D, *x, *(x + 1U), Z + i * m);
+            *(y + i) = 1.0 / lambda_1;
+        }
+        if (success)
+            gram_accumulate(m, k, done, n, Z, y, T, A, W);
+        else
+            err_msg = err_msg_rv;
+    }
+
+    /* Close the input files (unless they could not be opened). */
+    if (success || err_msg == err_msg_rv)
+    {
+        table_close(&in);
+        table_close(&ev);
+    }
+
+    /* Reduce the accumulators and compute the squared errors of all degrees
+     * fold by fold, factorising the matrix of the largest degree once per
+     * fold. */
+    if (success)
+    {
+        gram_reduce(m, k, T, A);
+        for (j = 0U; j < k; ++j)
+        {
+            r = gram_factor(m, k, j, A, L, s);
+            for (d = 0U; d <= D; ++d)
+            {
+                *(fitted + d) =
+                    *(fitted + d) &&
+                    polynomial_size(d) <= r &&
+                    gram_solve(m, k, j, polynomial_size(d), A, L, s, b);
+                if (*(fitted + d))
+                    *(E + d) += gram_error(m, j, polynomial_size(d), A, b);
+            }
+        }
+
+        /* Select the degree of the smallest error. */
+        e = D + 1U;
+        for (d = 0U; d <= D; ++d)
+            if (*(fitted + d) && (e > D || *(E + d) < *(E + e)))
+                e = d;
+
+        /* Fit the selected degree on all triangles. */
+        success =
+            (e <= D) &&
+            polynomial_size(e) <= gram_factor(m, k, k, A, L, s) &&
+            gram_solve(m, k, k, polynomial_size(e), A, L, s, b);
+        if (!success)
+            err_msg = err_msg_fit;
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* If the triangles could not be read or no polynomial could be fitted,
+     * print the error message, deallocate memory and exit with a non-zero
+     * value. */
+    if (!success)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg);
+
+        /* Deallocate memory. */
+        free(Z);
+        Z = (real_t*)(NULL);
+        free(y);
+        y = (real_t*)(NULL);
+        free(A);
+        A = (real_t*)(NULL);
+        free(W);
+        W = (real_t*)(NULL);
+        free(L);
+        L = (real_t*)(NULL);
+        free(s);
+        s = (real_t*)(NULL);
+        free(b);
+        b = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(fitted);
+        fitted = (bool*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Print the cross-validated errors, the selected degree and the time
+     * elapsed. */
+    for (d = 0U; d <= D; ++d)
+        if (*(fitted + d))
+            printf(
+                format_cv,
+                (unsigned long)d,
+                (double)rsqrt(rabs(*(E + d)) / (real_t)N)
+            );
+        else
+            printf(format_cv_fail, (unsigned long)d);
+    printf(format_degree, (unsigned long)e);
+    printf(
+        format_time,
+        (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+    );
+
+    /* Open the output file and dump the coefficients.  If the file could not
+     * be opened, print the error message, deallocate memory and exit with a
+     * non-zero value. */
+    out = fopen(*(argv + 7U), npy_path(*(argv + 7U)) ? "wb" : "wt");
+    if (!out)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        free(Z);
+        Z = (real_t*)(NULL);
+        free(y);
+        y = (real_t*)(NULL);
+        free(A);
+        A = (real_t*)(NULL);
+        free(W);
+        W = (real_t*)(NULL);
+        free(L);
+        L = (real_t*)(NULL);
+        free(s);
+        s = (real_t*)(NULL);
+        free(b);
+        b = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(fitted);
+        fitted = (bool*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    if (npy_path(*(argv + 7U)))
+    {
+        npy_begin(out);
+        npy_dump(out, polynomial_size(e), b);
+        npy_end(out, polynomial_size(e));
+    }
+    else
+    {
+        for (i = 0U; i < polynomial_size(e); ++i)
+            fprintf(out, i ? format_next : format_first, (double)*(b + i));
+        fprintf(out, "\n");
+    }
+
+    /* Close the output file. */
+    fclose(out);
+    out = (FILE*)(NULL);
+
+    /* Deallocate memory. */
+    memset(Z, 0, m * POLYNOMIAL_FIT_BLOCK * sizeof *Z);
+    free(Z);
+    Z = (real_t*)(NULL);
+    memset(y, 0, POLYNOMIAL_FIT_BLOCK * sizeof *y);
+    free(y);
+    y = (real_t*)(NULL);
+    memset(A, 0, T * (k + 1U) * gram_slot(m) * sizeof *A);
+    free(A);
+    A = (real_t*)(NULL);
+    memset(W, 0, (m + 1U) * POLYNOMIAL_FIT_BLOCK * sizeof *W);
+    free(W);
+    W = (real_t*)(NULL);
+    memset(L, 0, m * m * sizeof *L);
+    free(L);
+    L = (real_t*)(NULL);
+    memset(s, 0, m * sizeof *s);
+    free(s);
+    s = (real_t*)(NULL);
+    memset(b, 0, m * sizeof *b);
+    free(b);
+    b = (real_t*)(NULL);
+    memset(E, 0, (D + 1U) * sizeof *E);
+    free(E);
+    E = (real_t*)(NULL);
+    memset(fitted, 0, (D + 1U) * sizeof *fitted);
+    free(fitted);
+    fitted = (bool*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,379 @@
+/**
+ * Program for predicting the first Laplace eigenvalues of triangles by a
+ * polynomial regression model.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./polynomial_predict model d in N out
+ * where:
+ *     model is the path to the input file to read the coefficients of the
+ *           model (as exported by the script "polynomial_exporter.py"),
+ *     d     is the degree of the polynomial of the model,
+ *     in    is the path to the input file to read the coordinates of vertices,
+ *     N     is the number of triangles to read (at least 1),
+ *     out   is the path to the output file to print the predictions.
+ *
+ * The model file must contain (d + 1) (d + 2) / 2 coefficients of the
+ * polynomial ordered as described in "polynomial.h".  The models
+ * "models/polynomial_4.npy" and "models/polynomial_5.npy" are the models
+ * "models/polynomial_4.gz" and "models/polynomial_5.gz" of degrees 4 and 5
+ * exported to NumPy arrays.
+ *
+ * Each triangle must be formated in the input file as
+ *     x_0	y_0	x_1	y_1	x_2	y_2
+ * where x_i denotes the x-coordinate of the i-th vertex and y_i denotes the
+ * y-coordinate of the i-th vertex (whitespaces may differ).  The triangles must
+ * have vertices (1 / 2, 0), V_2, (-1 / 2, 0), as printed by the program
+ * "generators/triangles_generator.c", since the models are polynomials in the
+ * coordinates of V_2 only.
+ *
+ * For each triangle a line
+ *     p	lambda
+ * is printed to the output file, where p is the value of the polynomial (the
+ * models predict the inverse of the eigenvalue) and lambda = 1 / p is the
+ * predicted eigenvalue.
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the prediction.  Time needed to read and print is not measured.
+ *
+ * If the path to any of the files ends with ".npy" or ".pcz", the file is read
+ * or dumped as a NumPy array or as a compressed table with a single polygon
+ * per row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "batch.h"
+#include "polynomial.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 5: model file path, degree of "
+            "the polynomial, input file path, number of triangles to read and "
+            "output file path.";
+
+    /* Error message for the illegal number of triangles to read. */
+    const char* const err_msg_npr =
+        "Number of triangles to read must be at least 1.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Degree of the polynomial and the number of its coefficients. */
+    size_t d;
+    size_t m;
+
+    /* Number of triangles to read. */
+    size_t N;
+
+    /* Array of coefficients and array of rearranged coefficients. */
+    real_t* c;
+    real_t* H;
+
+    /* Array of vertices, arrays of coordinates of the batch and array of
+     * values of the polynomial. */
+    real_t* P;
+    real_t* X;
+    real_t* Y;
+    real_t* Z;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Degree of the polynomial and the number of its coefficients. */
+    d = 0U;
+    m = 0U;
+
+    /* Number of triangles to read. */
+    N = 0U;
+
+    /* Arrays. */
+    c = (real_t*)(NULL);
+    H = (real_t*)(NULL);
+    P = (real_t*)(NULL);
+    X = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+    Z = (real_t*)(NULL);
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 5, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 6))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 6 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the degree of the polynomial and the number of triangles to
+     * read. */
+    d = (size_t)atoi(*(argv + 2U));
+    m = polynomial_size(d);
+    N = (size_t)atoi(*(argv + 4U));
+
+    /* If the number of triangles to read is 0, print the error message and
+     * exit with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory (the arrays `Y` and `H` are the second halves of the
+     * arrays `X` and `c`). */
+    c = (real_t*)malloc((m << 1U) * sizeof *c);
+    P = (real_t*)malloc(6U * N * sizeof *P);
+    X = (real_t*)malloc(6U * N * sizeof *X);
+    Z = (real_t*)malloc(N * sizeof *Z);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(c && P && X && Z))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(c);
+        c = (real_t*)(NULL);
+        free(P);
+        P = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        free(Z);
+        Z = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(c, 0, (m << 1U) * sizeof *c);
+    memset(P, 0, 6U * N * sizeof *P);
+    memset(X, 0, 6U * N * sizeof *X);
+    memset(Z, 0, N * sizeof *Z);
+    H = c + m;
+    Y = X + 3U * N;
+
+    /* Read the coefficients (if `j` is 0) and the triangles (if `j` is 1).  If
+     * any of the files could not be opened or if any of the values could not
+     * be read, print the error message, deallocate memory and exit with a
+     * non-zero value. */
+    for (j = 0U; j < 2U; ++j)
+    {
+        if (!table_open(&inout, *(argv + (j ? 3U : 1U)), false))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_in);
+
+            /* Deallocate memory. */
+            free(c);
+            c = (real_t*)(NULL);
+            H = (real_t*)(NULL);
+            free(P);
+            P = (real_t*)(NULL);
+            free(X);
+            X = (real_t*)(NULL);
+            Y = (real_t*)(NULL);
+            free(Z);
+            Z = (real_t*)(NULL);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0U; i < (j ? 6U * N : m); ++i)
+            if (!(table_scan(&inout, 1U, (j ? P : c) + i) == 1U))
+            {
+                /* Print the error message. */
+                fprintf(stderr, format_err_msg, err_msg_rv);
+
+                /* Close the input file. */
+                table_close(&inout);
+
+                /* Deallocate memory. */
+                free(c);
+                c = (real_t*)(NULL);
+                H = (real_t*)(NULL);
+                free(P);
+                P = (real_t*)(NULL);
+                free(X);
+                X = (real_t*)(NULL);
+                Y = (real_t*)(NULL);
+                free(Z);
+                Z = (real_t*)(NULL);
+
+                /* Exit with a non-zero value. */
+                exit(EXIT_FAILURE);
+            }
+
+        /* Close the input file. */
+        table_close(&inout);
+    }
+
+    /* Rearrange the coefficients. */
+    polynomial_prepare(d, c, H);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Transpose the triangles into a batch and evaluate the polynomial at the
+     * second vertices (the second rows of the arrays `X` and `Y`). */
+    batch_transpose_polygons(3U, N, P, X, Y);
+    polynomial_batch(d, H, N, X + N, Y + N, Z);
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Print the time elapsed during the prediction. */
+    printf(
+        format_time,
+        (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+    );
+
+    /* Store the values of the polynomial and the eigenvalues in the array `P`
+     * (2 values per triangle, so the `table_dump_polygons` function is used
+     * as for 1-gons). */
+    for (i = 0U; i < N; ++i)
+    {
+        *(P + (i << 1U)) = *(Z + i);
+        *(P + (i << 1U) + 1U) = 1.0 / *(Z + i);
+    }
+
+    /* Open the output file and dump the predictions.  If the file could not be
+     * opened, print the error message, deallocate memory and exit with a
+     * non-zero value. */
+    if (!table_open(&inout, *(argv + 5U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        free(c);
+        c = (real_t*)(NULL);
+        H = (real_t*)(NULL);
+        free(P);
+        P = (real_t*)(NULL);
+        free(X);
+        X = (real_t*)(NULL);
+        Y = (real_t*)(NULL);
+        free(Z);
+        Z = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    table_dump_polygons(&inout, 1U, P, N);
+
+    /* Close the output file. */
+    table_close(&inout);
+
+    /* Deallocate memory. */
+    memset(c, 0, (m << 1U) * sizeof *c);
+    free(c);
+    c = (real_t*)(NULL);
+    H = (real_t*)(NULL);
+    memset(P, 0, 6U * N * sizeof *P);
+    free(P);
+    P = (real_t*)(NULL);
+    memset(X, 0, 6U * N * sizeof *X);
+    free(X);
+    X = (real_t*)(NULL);
+    Y = (real_t*)(NULL);
+    memset(Z, 0, N * sizeof *Z);
+    free(Z);
+    Z = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,351 @@
+/**
+ * Program for approximating the first Laplace eigenvalues on triangles by a
+ * reduced basis model.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./rb_solve in N model out
+ * where:
+ *     in    is the path to the input file to read the coordinates of vertices
+ *           of triangles,
+ *     N     is the number of triangles to read (at least 1),
+ *     model is the path to the model dumped by the program
+ *           "reduced_basis_trainer.c",
+ *     out   is the path to the output file to print the eigenvalues.
+ *
+ * Each triangle must be formated in the input file as
+ *     x_0	y_0	x_1	y_1	x_2	y_2
+ * where x_i denotes the x-coordinate of the i-th vertex and y_i denotes the
+ * y-coordinate of the i-th vertex.  Whitespaces may differ (they may even be
+ * spaces, tabs, line breaks...).  Vertices may be enumerated in any direction.
+ *
+ * Note that the input file must contain at least N triangles.  If, however, it
+ * contains more than N triangles, only the first N triangles are read.
+ *
+ * For each triangle a line
+ *     lambda	delta
+ * is printed to the output file, where lambda is the approximation of the
+ * first eigenvalue and delta is the estimate of its error (see
+ * "reduced_basis.h").  Both are the undefined real number (see "numeric.h")
+ * for degenerate triangles.
+ *
+ * The pogram prints to the console the time elapsed only during the computation
+ * of the eigenvalues.  Time needed to read and print is not measured.
+ *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single triangle per row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "reduced_basis.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Number of clock ticks per second as `double`. */
+    const double clocks_per_sec = (double)(CLOCKS_PER_SEC);
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 4: input file path, number of "
+            "triangles to read, model file path and output file path.";
+
+    /* Error message for the illegal number of triangles to read. */
+    const char* const err_msg_npr =
+        "Number of triangles to read must be at least 1.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for model loading fail. */
+    const char* const err_msg_model = "Model cannot be loaded.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a coordinate. */
+    const char* const err_msg_rc = "Reading a coordinate failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Clock ticks. */
+    clock_t t0;
+    clock_t t1;
+
+    /* Number of triangles to read. */
+    size_t N;
+
+    /* Array of vertices and array of eigenvalues and their errors. */
+    real_t* P;
+    real_t* E;
+
+    /* Model. */
+    rb_model_t model;
+
+    /* Model file. */
+    FILE* in;
+
+    /* Input/output file. */
+    table_t inout;
+
+    /* Iteration index. */
+    size_t i;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Clock ticks. */
+    t0 = 0U;
+    t1 = 0U;
+
+    /* Number of triangles to read. */
+    N = 0U;
+
+    /* Arrays of vertices and of eigenvalues. */
+    P = (real_t*)(NULL);
+    E = (real_t*)(NULL);
+
+    /* Model. */
+    memset(&model, 0, sizeof model);
+
+    /* Model file. */
+    in = (FILE*)(NULL);
+
+    /* Input/output file. */
+    memset(&inout, 0, sizeof inout);
+
+    /* Iteration index. */
+    i = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 4, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 5))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 5 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of triangles to read. */
+    N = (size_t)atoi(*(argv + 2U));
+
+    /* If the number of triangles to read is 0, print the error message and
+     * exit with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Load the model.  If it could not be loaded, print the error message and
+     * exit with a non-zero value. */
+    in = fopen(*(argv + 3U), "rt");
+    if (!(in && !rb_load(&model, in)))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_model);
+
+        /* Close the model file. */
+        if (in)
+            fclose(in);
+        in = (FILE*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    fclose(in);
+    in = (FILE*)(NULL);
+
+    /* Allocate memory for the triangles and the eigenvalues. */
+    P = (real_t*)malloc(6U * N * sizeof *P);
+    E = (real_t*)malloc((N << 1U) * sizeof *E);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(P && E))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        rb_free(&model);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(P, 0, 6U * N * sizeof *P);
+    memset(E, 0, (N << 1U) * sizeof *E);
+
+    /* Open the input file and read the triangles.  If the file could not be
+     * opened or if any of the coordinates could not be read, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 1U), false))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Deallocate memory. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        rb_free(&model);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0U; i < 6U * N; ++i)
+        if (!(table_scan(&inout, 1U, P + i) == 1U))
+        {
+            /* Print the error message. */
+            fprintf(stderr, format_err_msg, err_msg_rc);
+
+            /* Close the input file. */
+            table_close(&inout);
+
+            /* Deallocate memory. */
+            memset(P, 0, 6U * N * sizeof *P);
+            free(P);
+            P = (real_t*)(NULL);
+            free(E);
+            E = (real_t*)(NULL);
+            rb_free(&model);
+
+            /* Exit with a non-zero value. */
+            exit(EXIT_FAILURE);
+        }
+
+    /* Close the input file. */
+    table_close(&inout);
+
+    /* Get the current clock ticks. */
+    t0 = clock();
+
+    /* Approximate the eigenvalues.  If the memory allocation has failed, print
+     * the error message, deallocate memory and exit with a non-zero value. */
+    if (rb_solve_batch(&model, N, P, E) > N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        memset(P, 0, 6U * N * sizeof *P);
+        free(P);
+        P = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        rb_free(&model);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Get the current clock ticks. */
+    t1 = clock();
+
+    /* Print the time elapsed during the computation of the eigenvalues. */
+    printf(format_time, (double)(t1 - t0) / clocks_per_sec);
+
+    /* Open the output file and dump the eigenvalues (2 values per triangle, so
+     * the `table_dump_polygons` function is used as for 1-gons).  If the file
+     * could not be opened, print the error message, deallocate memory and
+     * exit with a non-zero value. */
+    if (!table_open(&inout, *(argv + 4U), true))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Deallocate memory. */
+        memset(P, 0, 6U * N * sizeof *P);
+        free(P);
+        P = (real_t*)(NULL);
+        memset(E, 0, (N << 1U) * sizeof *E);
+        free(E);
+        E = (real_t*)(NULL);
+        rb_free(&model);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    table_dump_polygons(&inout, 1U, E, N);
+
+    /* Close the output file. */
+    table_close(&inout);
+
+    /* Deallocate memory. */
+    memset(P, 0, 6U * N * sizeof *P);
+    free(P);
+    P = (real_t*)(NULL);
+    memset(E, 0, (N << 1U) * sizeof *E);
+    free(E);
+    E = (real_t*)(NULL);
+    rb_free(&model);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+/**
+ * Program for training a reduced basis model of the first Laplace eigenvalue
+ * on triangles.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./rb_train m K y_min N_max tol out
+ * where:
+ *     m     is the number of divisions of each edge of the reference triangle
+ *           of the finite element mesh (at least 3),
+ *     K     is the number of samples of each coordinate of the characteristic
+ *           point of a triangle (at least 2),
+ *     y_min is the smallest sampled y-coordinate of the characteristic point
+ *           (in the range (0, sqrt(3) / 2)),
+ *     N_max is the maximal size of the basis (at least 1),
+ *     tol   is the tolerance for the largest relative error estimate on the
+ *           training points,
+ *     out   is the path to the output file to dump the model.
+ *
+ * The model is trained greedily on the grid of characteristic points (see the
+ * function `rb_train` in "reduced_basis.h") and dumped as a text file to be
+ * read by the program "reduced_basis_solver.c".  The size of the basis and the
+ * largest relative error estimate are printed to the console after each step
+ * of the training.  For instance, the arguments
+ *     32 40 0.05 40 1.0e-8 model.tsv
+ * cover the characteristic points of the file "data/auxiliary_coordinates.tsv".
+ *
+ * The pogram prints to the console the time elapsed only during the training.
+ * Time needed to print is not measured.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "reduced_basis.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Number of clock ticks per second as `double`. */
+    const double clocks_per_sec = (double)(CLOCKS_PER_SEC);
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 6: number of divisions, "
+            "number of samples, smallest y-coordinate, maximal size of the "
+            "basis, tolerance and output file path.";
+
+    /* Error message for the failed training. */
+    const char* const err_msg_train =
+        "Training failed (illegal arguments or memory allocation fail).";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for dumping fail. */
+    const char* const err_msg_dump = "Dumping the model failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Clock ticks. */
+    clock_t t0;
+    clock_t t1;
+
+    /* Model. */
+    rb_model_t model;
+
+    /* Status of the training. */
+    int status;
+
+    /* Output file. */
+    FILE* out;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Clock ticks. */
+    t0 = 0U;
+    t1 = 0U;
+
+    /* Model. */
+    memset(&model, 0, sizeof model);
+
+    /* Status of the training. */
+    status = 0;
+
+    /* Output file. */
+    out = (FILE*)(NULL);
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 6, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 7))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the 7 command line arguments is a null-pointer,
+     * print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argv &&
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U) &&
+            *(argv + 6U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Get the current clock ticks. */
+    t0 = clock();
+
+    /* Train the model. */
+    status = rb_train(
+        &model,
+        (size_t)atoi(*(argv + 1U)),
+        (size_t)atoi(*(argv + 2U)),
+        (real_t)atof(*(argv + 3U)),
+        (size_t)atoi(*(argv + 4U)),
+        (real_t)atof(*(argv + 5U)),
+        stdout
+    );
+
+    /* Get the current clock ticks. */
+    t1 = clock();
+
+    /* If the training failed, print the error message and exit with a
+     * non-zero value. */
+    if (status)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_train);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Print the time elapsed during the training. */
+    printf(format_time, (double)(t1 - t0) / clocks_per_sec);
+
+    /* Open the output file.  If it could not be opened, print the error
+     * message, free the model and exit with a non-zero value. */
+    out = fopen(*(argv + 6U), "wt");
+    if (!out)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Free the model. */
+        rb_free(&model);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Dump the model and close the output file.  If dumping failed, print the
+     * error message, free the model and exit with a non-zero value. */
+    status = rb_dump(&model, out);
+    if (fclose(out))
+        status = 1;
+    out = (FILE*)(NULL);
+    if (status)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_dump);
+
+        /* Free the model. */
+        rb_free(&model);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Free the model. */
+    rb_free(&model);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+# -*- coding: utf-8 -*-
+
+"""
+Reading compressed tables (".pcz" files) dumped by the C programs.
+
+The module depends only on NumPy, so it is imported by the data layer (see
+"dataset.py") without importing the plotting and the symbolic packages of
+"usefulness.py", which imports the function `read_pcz` from here.
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import SciPy packages.
+import numpy as _np
+
+# Define the function to read compressed tables dumped by the C programs.
+def read_pcz (filepath):
+    """
+    Read a compressed table (a ".pcz" file) dumped by the C programs.
+
+    The format and the compression are described in "include/codec.h".  The
+    table is decompressed block by block by vectorised NumPy operations.
+
+    Parameters
+    ==========
+    filepath : str
+        Path to the compressed table.
+
+    Returns
+    =======
+    ndarray
+        Two-dimensional array of the values (of type `float32` or `float64` as
+        dumped), each row of the table being a row of the array.
+
+    Raises
+    ======
+    ValueError
+        The file is not a compressed table or it is corrupted.
+
+    others
+        Exceptions thrown by the `numpy.fromfile` function are not caught.
+
+    """
+
+    # Read the bytes of the file.
+    data = _np.fromfile(filepath, dtype = _np.uint8)
+
+    # Read and check the header.
+    if not (
+        data.size >= 16 and
+        data[:4].tobytes() == b'\x93PCZ' and
+        data[4] == 1 and
+        data[5] in (4, 8)
+    ):
+        raise ValueError('File is not a compressed table.')
+    size = int(data[5])
+    columns = int(data[8:12].view('<u4')[0])
+    dtype = _np.dtype('<f{0:d}'.format(size))
+
+    # Decompress the blocks.
+    blocks = list()
+    p = 16
+    while p < data.size:
+        # Read the header of the block and its compressed planes.
+        if p + 8 > data.size:
+            raise ValueError('Compressed table is corrupted.')
+        rows, length = (int(x) for x in data[p:p + 8].view('<u4'))
+        block = data[p + 8:p + 8 + length]
+        if not (block.size == length):
+            raise ValueError('Compressed table is corrupted.')
+        p += 8 + length
+
+        # Load the planes.
+        planes = _np.zeros((columns * size, rows), dtype = _np.uint8)
+        m = (rows + 7) >> 3
+        q = 0
+        for k in range(columns * size):
+            if q >= length:
+                raise ValueError('Compressed table is corrupted.')
+            mode = block[q]
+            q += 1
+            if mode == 1:
+                mask = _np.unpackbits(
+                    block[q:q + m],
+                    bitorder = 'little'
+                )[:rows].astype(bool)
+                q += m
+                z = int(mask.sum())
+                planes[k, mask] = block[q:q + z]
+                q += z
+            elif mode == 2:
+                planes[k] = block[q:q + rows]
+                q += rows
+            elif not (mode == 0):
+                raise ValueError('Compressed table is corrupted.')
+        if not (q == length):
+            raise ValueError('Compressed table is corrupted.')
+
+        # Accumulate the exclusive disjunctions and gather the bytes of the
+        # values.
+        planes = _np.bitwise_xor.accumulate(planes, axis = 1)
+        blocks.append(
+            _np.ascontiguousarray(
+                planes.reshape((columns, size, rows)).transpose((2, 0, 1))
+            ).view(dtype).reshape((rows, columns))
+        )
+
+    # Return the array of values.
+    return (
+        _np.concatenate(blocks) if blocks
+            else _np.zeros((0, columns), dtype = dtype)
+    )
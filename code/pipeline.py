@@ -0,0 +1,868 @@
+# -*- coding: utf-8 -*-
+
+"""
+Incremental pipelines of programs with content-addressed outputs.
+
+A pipeline is a set of stages, each of which runs a single command (such as a
+generator, a preprocessor or the FreeFEM++ script computing the eigenvalues)
+on input files and produces output files.  The inputs of a stage are either
+files or outputs of other stages.  Each stage is identified by a hash of
+everything its outputs depend on:
+    1.  the command and the parameters substituted into it,
+    2.  the contents of the executables (the compiled programs and scripts
+        named in the command, or given explicitly),
+    3.  the contents of its input files and the hashes of the stages whose
+        outputs it reads.
+Outputs are stored in the directory of the pipeline under that hash, so a
+stage is run only if no outputs are stored under its current hash:  changing a
+parameter (for instance, `sd` of "generators/perturbator.c") reruns the stage
+and the stages depending on it, while outputs of all other stages (for
+instance, the eigenvalues when only the features downstream change) are reused.
+Outputs of previous versions remain stored until they are removed by the
+method `Pipeline.prune`, so switching back to a previous version is free.
+
+A stage may also be sharded:  the rows (polygons) of one of its inputs are
+split into shards of a fixed number of rows, the command is run on each shard
+separately and the outputs are concatenated.  Each shard is stored under a
+hash of the stage and of the contents of the shard only, so if the input
+changes only in some shards, only these shards are recomputed.  Rows of a text
+file are its lines and rows of a NumPy array are its rows along the first
+axis; the command of a sharded stage must dump exactly one row of each output
+per row of the input, in the same order (a shard is stored only if it does).
+Compressed tables (".pcz" files, see "include/codec.h") are read as outputs
+(their rows are counted and sketched), but they cannot be split or
+concatenated, so the sharded input and the outputs of a sharded stage must be
+NumPy arrays or text files (see the function `table_format` in "sketch.py").
+Shards may be run by several concurrent processes, and each of them is stored
+as soon as it is completed, so an interrupted run resumes from the completed
+shards.
+
+Several runs (for instance, of different experiments) may share a store:  the
+shards of inputs and the outputs are written to unique temporary files and
+directories in the store and published by renaming them, and an output which
+has been published meanwhile by another run is kept.  The sharded input is
+read row by row, so only a single shard of it is held in memory.
+
+Outputs of a stage may also be sketched (see "sketch.py"):  the sketch of the
+mean and the standard deviation of the columns and of the quantiles of some of
+the columns of an output is computed as soon as the output (of a shard) is
+written, while it is small, and stored next to it.  Sketches of the shards are
+merged when their outputs are concatenated, so the statistics of the output of
+a stage (see the method `Pipeline.sketch`) are obtained without another pass
+through the whole output.  The sketched columns are not a part of the hash of a
+stage:  changing them recomputes only the sketches.
+
+Example:
+    >>> stages = [
+    ...     Stage(
+    ...         'perturbed',
+    ...         [
+    ...             'bin/perturbate', '{N0}', '3', '{coordinates}', '{N1}',
+    ...             '{sd}', '{out}'
+    ...         ],
+    ...         inputs = {'coordinates': 'data/auxiliary_coordinates.tsv'},
+    ...         outputs = {'out': 'coordinates.tsv'},
+    ...         parameters = {'N0': 8165, 'N1': 16330, 'sd': 0.01}
+    ...     ),
+    ...     Stage(
+    ...         'descriptions',
+    ...         ['bin/describe', '{coordinates}', '{N}', '3', '{out}'],
+    ...         inputs = {'coordinates': ('perturbed', 'out')},
+    ...         outputs = {'out': 'descriptions.tsv'},
+    ...         shard = ('coordinates', 4096),
+    ...         sketches = {'out': [3]}
+    ...     )
+    ... ]
+    >>> pipeline = Pipeline(stages, '.pipeline')
+    >>> paths = pipeline.run()
+    >>> mean = pipeline.sketch('descriptions').mean
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import hashlib as _hashlib
+import json as _json
+import os as _os
+import shutil as _shutil
+import six as _six
+import subprocess as _subprocess
+import tempfile as _tempfile
+from concurrent import futures as _futures
+
+# Import SciPy packages.
+import numpy as _np
+
+# Import package modules.
+from sketch import Sketch as _Sketch
+from sketch import merge as _merge
+from sketch import sketch_table as _sketch_table
+from sketch import table_format as _table_format
+from pcz import read_pcz as _read_pcz
+
+# Define the class of stages of pipelines.
+class Stage (object):
+    """
+    Stage of a pipeline.
+
+    Parameters
+    ==========
+    name : str
+        Name of the stage (unique in the pipeline).
+
+    command : list of str
+        Command to run.  Each argument is formatted by the `str.format` method
+        with the fields named by the inputs (paths to the input files), by the
+        outputs (paths to the output files) and by the parameters.  The field
+        "N" is the number of rows of the shard in a sharded stage.
+
+    inputs : dict, optional
+        Inputs of the stage by their field names.  Each input is either a path
+        to a file or a tuple (stage, output) of the name of another stage and
+        the field name of its output (default is no inputs).
+
+    outputs : dict, optional
+        Names of the output files by their field names (default is a single
+        output "out" named "out.tsv").
+
+    parameters : dict, optional
+        Parameters of the stage by their field names (default is no
+        parameters).
+
+    executables : list of str, optional
+        Paths to the files whose contents identify the version of the command.
+        If `None`, all arguments of the command without fields which are paths
+        to existing files are used, as well as the first argument found in the
+        system path (default is `None`).
+
+    shard : tuple, optional
+        Tuple (input, rows) of the field name of the input to split and the
+        number of rows in a shard.  If `None`, the stage is not sharded
+        (default is `None`).
+
+    sketches : dict, optional
+        Outputs to sketch by their field names, each with the list of the
+        indices of its columns whose quantiles are sketched (default is no
+        sketched outputs).  The mean and the standard deviation of all columns
+        of a sketched output are sketched.
+
+    Raises
+    ======
+    ValueError
+        A sketched output is not a table, or an output of a sharded stage is
+        not a NumPy array or a text file (see the function `table_format` in
+        "sketch.py").
+
+    """
+
+    def __init__ (
+        self,
+        name,
+        command,
+        inputs = None,
+        outputs = None,
+        parameters = None,
+        executables = None,
+        shard = None,
+        sketches = None
+    ):
+        # Sanitise the parameters.
+        if not isinstance(name, _six.string_types):
+            raise TypeError('Parameter `name` must be a string.')
+        inputs = dict() if inputs is None else dict(inputs)
+        outputs = {'out': 'out.tsv'} if outputs is None else dict(outputs)
+        parameters = dict() if parameters is None else dict(parameters)
+        if shard is not None:
+            shard = (shard[0], int(shard[1]))
+            if not (shard[0] in inputs and shard[1] > 0):
+                raise ValueError(
+                    'Parameter `shard` must name an input and a positive ' +
+                    'number of rows.'
+                )
+        sketches = dict(
+            (field, [int(c) for c in columns])
+                for field, columns in (
+                    dict() if sketches is None else dict(sketches)
+                ).items()
+        )
+        if not all(field in outputs for field in sketches):
+            raise ValueError('Parameter `sketches` must name outputs.')
+        for field in sketches:
+            _table_format(outputs[field])
+        if shard is not None:
+            for output in outputs.values():
+                if _table_format(output) == 'pcz':
+                    raise ValueError(
+                        'Outputs of a sharded stage must be NumPy arrays or ' +
+                        'text files.'
+                    )
+
+        # Find the executables.
+        if executables is None:
+            executables = [
+                a for a in command
+                    if '{' not in a and _os.path.isfile(a)
+            ]
+            if command and not executables:
+                found = _shutil.which(command[0])
+                if found is not None:
+                    executables = [found]
+
+        # Set the attributes.
+        self.name = name
+        self.command = list(command)
+        self.inputs = inputs
+        self.outputs = outputs
+        self.parameters = parameters
+        self.executables = list(executables)
+        self.shard = shard
+        self.sketches = sketches
+
+    def depends (self):
+        """
+        Find the names of the stages whose outputs the stage reads.
+
+        """
+
+        return sorted(
+            set(
+                i[0] for i in self.inputs.values()
+                    if not isinstance(i, _six.string_types)
+            )
+        )
+
+# Define the class of pipelines.
+class Pipeline (object):
+    """
+    Pipeline of stages with content-addressed outputs.
+
+    Parameters
+    ==========
+    stages : list of Stage
+        Stages of the pipeline (in any order).
+
+    store : str, optional
+        Directory of the stored outputs (default is ".pipeline").
+
+    verbose : bool, optional
+        True if the run and reused stages and shards should be printed, false
+        otherwise (default is true).
+
+    processes : int, optional
+        Maximal number of shards of a sharded stage run concurrently (as
+        separate processes) (default is 1).
+
+    """
+
+    def __init__ (
+        self,
+        stages,
+        store = '.pipeline',
+        verbose = True,
+        processes = 1
+    ):
+        # Set the attributes.
+        self.stages = dict((stage.name, stage) for stage in stages)
+        self.store = store
+        self.verbose = bool(verbose)
+        self.processes = max(1, int(processes))
+        if not (len(self.stages) == len(stages)):
+            raise ValueError('Names of stages must be unique.')
+
+        # Initialise the memoised hashes of stages and the index of hashes of
+        # files.
+        self._keys = dict()
+        self._files = None
+
+    def _hash_file (self, path):
+        """
+        Compute the SHA-256 hash of the contents of a file.
+
+        Hashes are remembered in the index "files.json" in the store by the
+        path, the size and the time of the last modification of the file, so
+        unchanged files are not read again.
+
+        """
+
+        # Load the index.
+        index = _os.path.join(self.store, 'files.json')
+        if self._files is None:
+            self._files = dict()
+            if _os.path.isfile(index):
+                with open(index, 'r') as f:
+                    self._files = _json.load(f)
+
+        # Return the remembered hash if the file has not changed.
+        info = _os.stat(path)
+        path = _os.path.abspath(path)
+        stamp = [info.st_size, info.st_mtime]
+        if path in self._files and self._files[path][0] == stamp:
+            return self._files[path][1]
+
+        # Compute, remember and return the hash.
+        h = _hashlib.sha256()
+        with open(path, 'rb') as f:
+            for block in iter(lambda: f.read(1 << 20), b''):
+                h.update(block)
+        self._files[path] = [stamp, h.hexdigest()]
+        if not _os.path.isdir(self.store):
+            _os.makedirs(self.store)
+        fd, temporary = _tempfile.mkstemp(
+            suffix = '.tmp',
+            prefix = '.files.json.',
+            dir = self.store
+        )
+        with _os.fdopen(fd, 'w') as f:
+            _json.dump(self._files, f)
+        _os.rename(temporary, index)
+
+        return self._files[path][1]
+
+    def _recipe (self, name):
+        """
+        Hash everything the outputs of a stage depend on except the contents
+        of the sharded input.
+
+        """
+
+        stage = self.stages[name]
+        h = _hashlib.sha256()
+        h.update(
+            _json.dumps(
+                [
+                    stage.command,
+                    sorted(stage.outputs.items()),
+                    sorted(
+                        (k, repr(v)) for k, v in stage.parameters.items()
+                    ),
+                    stage.shard
+                ]
+            ).encode('utf-8')
+        )
+        for executable in stage.executables:
+            h.update(self._hash_file(executable).encode('utf-8'))
+        for field in sorted(stage.inputs):
+            if stage.shard is not None and field == stage.shard[0]:
+                continue
+            h.update(field.encode('utf-8'))
+            h.update(self._hash_input(stage.inputs[field]).encode('utf-8'))
+
+        return h
+
+    def _hash_input (self, i):
+        """
+        Hash an input (a file or an output of another stage).
+
+        """
+
+        if isinstance(i, _six.string_types):
+            return self._hash_file(i)
+
+        return self.key(i[0]) + '/' + i[1]
+
+    def key (self, name):
+        """
+        Compute the hash of a stage.
+
+        Returns
+        =======
+        str
+            Hexadecimal SHA-256 hash.
+
+        """
+
+        # Return the memoised hash if it exists.
+        if name in self._keys:
+            return self._keys[name]
+
+        # Hash the recipe and the sharded input.
+        stage = self.stages[name]
+        h = self._recipe(name)
+        if stage.shard is not None:
+            h.update(
+                self._hash_input(stage.inputs[stage.shard[0]]).encode('utf-8')
+            )
+
+        # Memoise and return the hash.
+        self._keys[name] = h.hexdigest()
+
+        return self._keys[name]
+
+    def directory (self, name):
+        """
+        Find the directory of the stored outputs of a stage.
+
+        """
+
+        return _os.path.join(
+            self.store,
+            '{0:s}-{1:.16s}'.format(name, self.key(name))
+        )
+
+    def path (self, name, output = 'out'):
+        """
+        Find the path to a stored output of a stage.
+
+        """
+
+        return _os.path.join(
+            self.directory(name),
+            self.stages[name].outputs[output]
+        )
+
+    def _input_path (self, i):
+        """
+        Find the path to an input.
+
+        """
+
+        return i if isinstance(i, _six.string_types) else self.path(*i)
+
+    def _execute (self, stage, inputs, directory, fields = None, rows = None):
+        """
+        Run the command of a stage with outputs written to a unique temporary
+        directory which is published as `directory` on success (see the method
+        `_publish`) and removed otherwise.
+
+        If `rows` is not `None`, the outputs are published only if each of
+        them has exactly `rows` rows.
+
+        """
+
+        # Prepare the temporary directory.
+        temporary = self._temporary(directory)
+        try:
+            self._run(stage, inputs, temporary, fields, rows)
+        except BaseException:
+            _shutil.rmtree(temporary, ignore_errors = True)
+            raise
+
+        # Move the outputs to their final directory.
+        self._publish(temporary, directory)
+
+    def _temporary (self, directory):
+        """
+        Create a unique temporary directory next to a directory of outputs.
+
+        """
+
+        parent, base = _os.path.split(directory)
+        if not _os.path.isdir(parent):
+            _os.makedirs(parent)
+
+        return _tempfile.mkdtemp(
+            suffix = '.tmp',
+            prefix = '.' + base + '.',
+            dir = parent
+        )
+
+    def _publish (self, temporary, directory):
+        """
+        Rename a temporary directory of outputs to their final directory.
+
+        If the outputs have been published meanwhile (by a concurrent run on
+        the same store), the published outputs are kept and the temporary
+        directory is removed.
+
+        """
+
+        try:
+            _os.rename(temporary, directory)
+        except OSError:
+            if not _os.path.isdir(directory):
+                raise
+            _shutil.rmtree(temporary, ignore_errors = True)
+
+    def _run (self, stage, inputs, temporary, fields = None, rows = None):
+        """
+        Run the command of a stage with outputs written to a directory, check
+        the numbers of rows of the outputs and sketch them.
+
+        """
+
+        # Format and run the command.
+        values = dict(stage.parameters)
+        values.update(inputs)
+        values.update(
+            (field, _os.path.join(temporary, output))
+                for field, output in stage.outputs.items()
+        )
+        if fields is not None:
+            values.update(fields)
+        _subprocess.check_call([a.format(**values) for a in stage.command])
+
+        # Check the number of rows of the outputs.
+        if rows is not None:
+            for output in stage.outputs.values():
+                path = _os.path.join(temporary, output)
+                form = _table_format(output)
+                if form == 'npy':
+                    m = _np.load(path, mmap_mode = 'r').shape[0]
+                elif form == 'pcz':
+                    m = _read_pcz(path).shape[0]
+                else:
+                    with open(path, 'rb') as f:
+                        m = sum(1 for line in f if line.strip())
+                if not (m == rows):
+                    raise RuntimeError(
+                        'Output `{0:s}` has {1:d} rows, not {2:d}.'.format(
+                            path,
+                            m,
+                            rows
+                        )
+                    )
+
+        # Sketch the outputs.
+        self._sketch(stage, temporary)
+
+    def _sketch (self, stage, directory):
+        """
+        Sketch the outputs of a stage stored in a directory whose sketches are
+        not stored (or are sketches of other columns).
+
+        """
+
+        for field, columns in stage.sketches.items():
+            output = _os.path.join(directory, stage.outputs[field])
+            path = output + '.sketch.npz'
+            if _os.path.isfile(path) and \
+                    _Sketch.load(path).columns == columns:
+                continue
+            _sketch_table(output, columns).save(path)
+
+    def _shards (self, stage, source):
+        """
+        Split the sharded input of a stage into shards.
+
+        The input is read row by row (a text file) or mapped to memory (a NumPy
+        array), so only a single shard is held in memory.  Each shard is saved
+        to a unique temporary file in the store and hashed.  The generator
+        yields tuples (start, stop, path, directory) of the range of rows of
+        the shard, the path to the temporary file (which should be removed by
+        the caller) and the directory of its stored outputs.
+
+        """
+
+        # Check the format of the sharded input.
+        form = _table_format(source)
+        if form == 'pcz':
+            raise ValueError(
+                'Sharded input `{0:s}` must be a NumPy array or a text '
+                'file.'.format(source)
+            )
+
+        # Hash everything except the contents of the shards.
+        recipe = self._recipe(stage.name).hexdigest()
+
+        # Define the function to save and hash a shard.
+        shards = _os.path.join(self.store, 'shards')
+        if not _os.path.isdir(shards):
+            _os.makedirs(shards)
+
+        def save (start, stop, rows):
+            fd, path = _tempfile.mkstemp(
+                suffix = _os.path.splitext(source)[1],
+                prefix = '.{0:s}-input-{1:d}-'.format(stage.name, start),
+                dir = shards
+            )
+            with _os.fdopen(fd, 'wb') as f:
+                if form == 'npy':
+                    _np.save(f, _np.asarray(rows))
+                else:
+                    f.write(b''.join(rows))
+            h = _hashlib.sha256(recipe.encode('utf-8'))
+            with open(path, 'rb') as f:
+                for block in iter(lambda: f.read(1 << 20), b''):
+                    h.update(block)
+
+            return (
+                start,
+                stop,
+                path,
+                _os.path.join(
+                    shards,
+                    '{0:s}-{1:.16s}'.format(stage.name, h.hexdigest())
+                )
+            )
+
+        # Save, hash and yield the shards of a NumPy array.
+        if form == 'npy':
+            data = _np.load(source, mmap_mode = 'r')
+            for start in range(0, data.shape[0], stage.shard[1]):
+                stop = min(start + stage.shard[1], data.shape[0])
+                yield save(start, stop, data[start:stop])
+
+            return
+
+        # Save, hash and yield the shards of a text file.
+        start = 0
+        rows = list()
+        with open(source, 'rb') as f:
+            for line in f:
+                if not line.strip():
+                    continue
+                rows.append(line.rstrip(b'\r\n') + b'\n')
+                if len(rows) == stage.shard[1]:
+                    yield save(start, start + len(rows), rows)
+                    start += len(rows)
+                    rows = list()
+        if rows:
+            yield save(start, start + len(rows), rows)
+
+    def _run_sharded (self, stage, inputs, directory):
+        """
+        Run a sharded stage shard by shard and concatenate the outputs.
+
+        Shards which are not stored are run by at most `processes` concurrent
+        processes.  Each shard is stored as soon as it is completed, so if
+        running is interrupted or a shard fails, the completed shards are
+        reused by the next run.
+
+        """
+
+        # Find the shards to run and reuse the stored shards.  Shards of the
+        # same contents share their directory, so each of them is run only
+        # once (concurrent runs would write to the same temporary directory).
+        field = stage.shard[0]
+        shards = list()
+        pending = list()
+        running = set()
+        for start, stop, path, shard in self._shards(stage, inputs[field]):
+            shards.append(shard)
+            if shard in running:
+                _os.remove(path)
+            elif _os.path.isdir(shard):
+                _os.remove(path)
+                self._sketch(stage, shard)
+                if self.verbose:
+                    print(
+                        'Reusing {0:s} [{1:d}, {2:d}).'.format(
+                            stage.name,
+                            start,
+                            stop
+                        )
+                    )
+            else:
+                pending.append((start, stop, path, shard))
+                running.add(shard)
+
+        # Define the function running a shard.
+        def run_shard (start, stop, path, shard):
+            if self.verbose:
+                print(
+                    'Running {0:s} [{1:d}, {2:d}).'.format(
+                        stage.name,
+                        start,
+                        stop
+                    )
+                )
+            shard_inputs = dict(inputs)
+            shard_inputs[field] = path
+            try:
+                self._execute(
+                    stage,
+                    shard_inputs,
+                    shard,
+                    {'N': stop - start},
+                    stop - start
+                )
+            finally:
+                _os.remove(path)
+
+        # Run the shards and raise the first error after all of them end.
+        with _futures.ThreadPoolExecutor(self.processes) as executor:
+            errors = [
+                f.exception() for f in [
+                    executor.submit(run_shard, *p) for p in pending
+                ]
+            ]
+        for error in errors:
+            if error is not None:
+                raise error
+
+        # Concatenate the outputs of the shards.
+        temporary = self._temporary(directory)
+        try:
+            self._concatenate(stage, shards, temporary)
+        except BaseException:
+            _shutil.rmtree(temporary, ignore_errors = True)
+            raise
+        self._publish(temporary, directory)
+
+    def _concatenate (self, stage, shards, temporary):
+        """
+        Concatenate the outputs and merge the sketches of the shards of a stage
+        into a directory.
+
+        """
+
+        # Concatenate the outputs of the shards.
+        for output in stage.outputs.values():
+            path = _os.path.join(temporary, output)
+            if _table_format(output) == 'npy':
+                _np.save(
+                    path,
+                    _np.concatenate(
+                        [
+                            _np.load(_os.path.join(shard, output))
+                                for shard in shards
+                        ]
+                    ) if shards else _np.zeros((0, ), dtype = float)
+                )
+            else:
+                with open(path, 'wb') as f:
+                    for shard in shards:
+                        with open(_os.path.join(shard, output), 'rb') as g:
+                            for line in g.read().splitlines():
+                                if line.strip():
+                                    f.write(line + b'\n')
+
+        # Merge the sketches of the shards.
+        for field, columns in stage.sketches.items():
+            output = stage.outputs[field]
+            sketch = _merge(
+                _os.path.join(shard, output + '.sketch.npz')
+                    for shard in shards
+            )
+            if sketch is None:
+                sketch = _Sketch(0, columns)
+            sketch.save(_os.path.join(temporary, output + '.sketch.npz'))
+
+    def run (self, targets = None):
+        """
+        Run the stages (and the stages they depend on) whose outputs are not
+        stored.
+
+        Parameters
+        ==========
+        targets : list of str, optional
+            Names of the stages to run (default is all stages).
+
+        Returns
+        =======
+        dict
+            Dictionary of dictionaries of paths to the stored outputs of the
+            stages by their field names, by the names of the stages.
+
+        Raises
+        ======
+        subprocess.CalledProcessError
+            A command has failed.  Outputs of all stages (and shards) which
+            completed successfully remain stored.
+
+        ValueError
+            The sharded input of a stage is not a NumPy array or a text file.
+
+        """
+
+        # Forget the hashes of stages (the inputs may have changed).
+        self._keys = dict()
+
+        # Run the stages in the order of their dependencies.
+        done = dict()
+        visiting = set()
+
+        def visit (name):
+            if name in done:
+                return
+            if name in visiting:
+                raise ValueError(
+                    'Stage `{0:s}` depends on itself.'.format(name)
+                )
+            visiting.add(name)
+            stage = self.stages[name]
+            for depend in stage.depends():
+                visit(depend)
+            directory = self.directory(name)
+            if _os.path.isdir(directory):
+                if self.verbose:
+                    print('Reusing {0:s}.'.format(name))
+                self._sketch(stage, directory)
+            else:
+                inputs = dict(
+                    (field, self._input_path(i))
+                        for field, i in stage.inputs.items()
+                )
+                if stage.shard is not None:
+                    self._run_sharded(stage, inputs, directory)
+                else:
+                    if self.verbose:
+                        print('Running {0:s}.'.format(name))
+                    self._execute(stage, inputs, directory)
+            done[name] = dict(
+                (field, self.path(name, field)) for field in stage.outputs
+            )
+            visiting.discard(name)
+
+        for name in (sorted(self.stages) if targets is None else targets):
+            visit(name)
+
+        # Return the paths to the outputs.
+        return done
+
+    def sketch (self, name, output = 'out'):
+        """
+        Load the stored sketch of an output of a stage.
+
+        Parameters
+        ==========
+        name : str
+            Name of the stage (which has been run).
+
+        output : str, optional
+            Field name of the sketched output (default is "out").
+
+        Returns
+        =======
+        Sketch
+            Sketch of the output (see "sketch.py").
+
+        """
+
+        return _Sketch.load(self.path(name, output) + '.sketch.npz')
+
+    def prune (self):
+        """
+        Remove stored outputs of stages and shards which are not used by the
+        current version of the pipeline.
+
+        Returns
+        =======
+        int
+            Number of removed directories.
+
+        """
+
+        # Find the current directories of stages.
+        self._keys = dict()
+        current = set(
+            _os.path.basename(self.directory(name)) for name in self.stages
+        )
+
+        # Find the shards of the current sharded inputs.
+        shards = set()
+        for name, stage in self.stages.items():
+            if stage.shard is None:
+                continue
+            source = self._input_path(stage.inputs[stage.shard[0]])
+            if _os.path.isfile(source):
+                for _, _, path, shard in self._shards(stage, source):
+                    _os.remove(path)
+                    shards.add(_os.path.basename(shard))
+
+        # Remove all other directories.
+        removed = 0
+        for parent, keep in (
+            (self.store, current | set(['shards'])),
+            (_os.path.join(self.store, 'shards'), shards)
+        ):
+            if not _os.path.isdir(parent):
+                continue
+            for d in _os.listdir(parent):
+                path = _os.path.join(parent, d)
+                if _os.path.isdir(path) and d not in keep:
+                    _shutil.rmtree(path)
+                    removed += 1
+
+        return removed
@@ -0,0 +1,196 @@
+# -*- coding: utf-8 -*-
+
+"""
+Export of the polynomial regression models to flat tables of coefficients.
+
+The models "models/polynomial_4.gz" and "models/polynomial_5.gz" are pickled
+Scikit-learn `LinearRegression` objects over the polynomial terms of the
+coordinates of the second vertex of a triangle (created by the function
+`polynomial_terms_creator` in the notebook "Models.ipynb").  The script exports
+the intercept and the coefficients of a model as a single row
+    c_0	c_1_0	c_1_1	c_2_0	c_2_1	c_2_2	...	c_d_d
+(see "include/polynomial.h"), so that the model is evaluated by the program
+compiled from "numeric/polynomial_predictor.c" without Python.  The degree of
+the polynomial is deduced from the number of coefficients.
+
+The model is loaded by Joblib if it is available.  Otherwise it is read by a
+minimal unpickler which needs neither Joblib nor Scikit-learn:  the classes of
+the pickle are replaced by plain objects holding their attributes and the
+NumPy arrays, which Joblib writes as raw bytes following their pickled
+descriptions, are read directly from the stream.
+
+Usage:
+    $ python polynomial_exporter.py model out
+where:
+    model is the path to the pickled model (such as
+          "models/polynomial_4.gz"),
+    out   is the path to the output file (a NumPy array of shape (1, m) if it
+          ends with ".npy", a text file otherwise).
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import argparse as _argparse
+import gzip as _gzip
+import io as _io
+import os as _os
+import pickle as _pickle
+
+# Import SciPy packages.
+import numpy as _np
+
+# Define the class of attributes of unpickled objects.
+class _Attributes (object):
+    """
+    Plain object holding the attributes of an unpickled object.
+
+    """
+
+    def __setstate__ (self, state):
+        self.__dict__.update(state)
+
+# Define the class of descriptions of arrays written by Joblib.
+class _ArrayWrapper (_Attributes):
+    """
+    Description (shape and type) of an array written by Joblib.
+
+    """
+
+    pass
+
+# Define the minimal unpickler of the models.
+class _Unpickler (_pickle._Unpickler):
+    """
+    Unpickler of the models without Joblib and Scikit-learn.
+
+    """
+
+    def find_class (self, module, name):
+        if module.split('.')[0] == 'numpy':
+            return super(_Unpickler, self).find_class(module, name)
+        if name == 'NumpyArrayWrapper':
+            return _ArrayWrapper
+
+        return _Attributes
+
+    def load_build (self):
+        # Build the object and replace the description of an array by the
+        # array read from the stream.
+        _pickle._Unpickler.load_build(self)
+        wrapper = self.stack[-1]
+        if isinstance(wrapper, _ArrayWrapper):
+            dtype = _np.dtype(wrapper.dtype)
+            size = int(_np.prod(wrapper.shape))
+            self.stack[-1] = _np.frombuffer(
+                self.read(size * dtype.itemsize),
+                dtype = dtype
+            ).reshape(wrapper.shape, order = wrapper.order)
+
+    dispatch = dict(_pickle._Unpickler.dispatch)
+    dispatch[_pickle.BUILD[0]] = load_build
+
+# Define the function to load a model.
+def load (path):
+    """
+    Load a pickled polynomial model.
+
+    Parameters
+    ==========
+    path : str
+        Path to the model compressed by Joblib.
+
+    Returns
+    =======
+    object
+        Model with the attributes `intercept_` and `coef_`.
+
+    """
+
+    try:
+        import joblib as _joblib
+    except ImportError:
+        _joblib = None
+    if _joblib is not None:
+        return _joblib.load(path)
+
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:2] == b'\x1f\x8b':
+        data = _gzip.decompress(data)
+
+    return _Unpickler(_io.BytesIO(data)).load()
+
+# Define the function to export a model.
+def export (path_model, path_out):
+    """
+    Export a polynomial model to a table of coefficients.
+
+    Parameters
+    ==========
+    path_model : str
+        Path to the pickled model.
+
+    path_out : str
+        Path to the output file.
+
+    Returns
+    =======
+    int
+        Degree of the polynomial.
+
+    Raises
+    ======
+    ValueError
+        The number of coefficients is not the number of terms of a polynomial
+        in two variables.
+
+    """
+
+    # Load the model and concatenate the intercept and the coefficients.
+    model = load(path_model)
+    c = _np.concatenate(
+        [
+            _np.ravel(_np.asarray(model.intercept_, dtype = float)),
+            _np.ravel(_np.asarray(model.coef_, dtype = float))
+        ]
+    )
+
+    # Deduce the degree of the polynomial.
+    d = int(round((_np.sqrt(8.0 * c.size + 1.0) - 3.0) / 2.0))
+    if not ((d + 1) * (d + 2) // 2 == c.size):
+        raise ValueError(
+            'Model has {0:d} coefficients, which is not the number of terms '
+                'of a polynomial in two variables.'.format(c.size)
+        )
+
+    # Save the coefficients atomically.
+    temporary = path_out + '.tmp' + _os.path.splitext(path_out)[1]
+    if path_out.endswith('.npy'):
+        _np.save(temporary, c.reshape((1, -1)))
+    else:
+        _np.savetxt(
+            temporary,
+            c.reshape((1, -1)),
+            fmt = '%.18e',
+            delimiter = '\t'
+        )
+    _os.rename(temporary, path_out)
+
+    # Return the degree of the polynomial.
+    return d
+
+# Export the model from the command line.
+if __name__ == '__main__':
+    parser = _argparse.ArgumentParser(
+        description = 'Export a polynomial model to a table of coefficients.'
+    )
+    parser.add_argument('model', help = 'pickled model')
+    parser.add_argument('out', help = 'output file of coefficients')
+    arguments = parser.parse_args()
+    print(
+        'Degree of the polynomial: {0:d}.'.format(
+            export(arguments.model, arguments.out)
+        )
+    )
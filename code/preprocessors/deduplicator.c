@@ -0,0 +1,374 @@
+/**
+ * Program for filtering near duplicates out of polygons.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./dedup in N n tol K seed out [known M]
+ * where:
+ *     in    is the path to the input file to read the coordinates of vertices,
+ *     N     is the number of polygons to read (at least 1),
+ *     n     is the number of vertices of each polygon (at least 3),
+ *     tol   is the tolerance of near duplicates (positive),
+ *     K     is the number of projections of the hashing (at least 1 and at
+ *           most 16),
+ *     seed  is the seed of the pseudorandom number generator,
+ *     out   is the path to the output file to print the novel polygons,
+ *     known is the path to the input file to read the coordinates of vertices
+ *           of already labelled polygons (optional),
+ *     M     is the number of already labelled polygons to read (at least 1 if
+ *           known is given).
+ *
+ * Each polygon must be formated in the input files as
+ *     x_0	y_0	x_1	y_1	...	x_n_minus_1	y_n_minus_1
+ * where x_i denotes the x-coordinate of the i-th vertex and y_i denotes the
+ * y-coordinate of the i-th vertex (whitespaces may differ).  It is believed
+ * that each polygon truly represents a polygon of n vertices with vertices
+ * enumerated positively---this is not checked and if any polygon does not
+ * satisfy this, results may be unexpected.
+ *
+ * A polygon is a near duplicate if the distance of its signature (see the
+ * function `lsh_signature` in "lsh.h") to the signature of an already
+ * labelled polygon or of a preceding novel polygon of the input file is at
+ * most tol.  The signatures do not depend on the position, the rotation, the
+ * size, the reflection or the first vertex of a polygon, so tol = 1e-6 only
+ * filters the polygons of the same shape, while tol = 1e-3 filters
+ * perturbations of the size of approximately 1e-3 of the diameter (such as the
+ * polygons generated by the program "generators/perturbator.c" of a small
+ * standard deviation).  All near duplicates within the tolerance are found;
+ * the number of projections K only affects the speed (K = 8 is a sensible
+ * choice for polygons of up to 10 vertices).
+ *
+ * The polygons are streamed:  each polygon is read, hashed and printed to the
+ * output file (in its original form) if it is novel before the next polygon is
+ * read, so the output file is the input of the labelling (for instance, by the
+ * script "eigen_runner.py") and only novel shapes are labelled.
+ *
+ * The pogram prints to the console the number of novel polygons and the (wall
+ * clock) time elapsed during the filtering (including reading and printing, as
+ * the polygons are streamed).
+ *
+ * If the path to any of the files ends with ".npy" or ".pcz", the file is read
+ * or dumped as a NumPy array or as a compressed table with a single polygon per
+ * row instead of a text file (see "table.h").
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Compile with mathematical constants from "math.h". */
+#define _USE_MATH_DEFINES   1
+
+/* Compile using the DGESVD driver. */
+#define _USE_SVD_DRIVER 1
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "array.h"
+#include "boolean.h"
+#include "numeric.h"
+#include "polygon.h"
+#include "lsh.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 7 or 9: input file path, "
+            "number of polygons to read, number of vertices, tolerance, number "
+            "of projections, seed and output file path, optionally followed "
+            "by the file path and the number of already labelled polygons.";
+
+    /* Error message for the illegal number of polygons to read. */
+    const char* const err_msg_npr =
+        "Number of polygons to read must be at least 1.";
+
+    /* Error message for the illegal number of vertices. */
+    const char* const err_msg_nv = "Number of vertices must be at least 3.";
+
+    /* Error message for the illegal tolerance. */
+    const char* const err_msg_tol = "Tolerance must be positive.";
+
+    /* Error message for the illegal number of projections. */
+    const char* const err_msg_nk =
+        "Number of projections must be at least 1 and at most 16.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a coordinate. */
+    const char* const err_msg_rc = "Reading a coordinate failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for printing the number of novel polygons. */
+    const char* const format_novel = "Novel polygons: %lu of %lu.\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of polygons to read, the number of already labelled polygons and
+     * the number of novel polygons. */
+    size_t N;
+    size_t M;
+    size_t novel;
+
+    /* Number of vertices. */
+    size_t n;
+
+    /* Tolerance and the number of projections. */
+    real_t tol;
+    size_t K;
+
+    /* Leading dimension of the auxiliary matrix. */
+    size_t ld_A;
+
+    /* Array of vertices, workspace, auxiliary matrix and the signature. */
+    real_t* P;
+    real_t* W;
+    real_t* A;
+    real_t* s;
+
+    /* Input and output files. */
+    table_t in;
+    table_t out;
+
+    /* Hash table of signatures. */
+    lsh_t hashes;
+
+    /* Indicator of success and the error message of a fail. */
+    bool success;
+    const char* err_msg;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Numbers of polygons. */
+    N = 0U;
+    M = 0U;
+    novel = 0U;
+
+    /* Number of vertices. */
+    n = 0U;
+
+    /* Tolerance and the number of projections. */
+    tol = 0.0;
+    K = 0U;
+
+    /* Leading dimension of the auxiliary matrix. */
+    ld_A = 0U;
+
+    /* Arrays. */
+    P = (real_t*)(NULL);
+    W = (real_t*)(NULL);
+    A = (real_t*)(NULL);
+    s = (real_t*)(NULL);
+
+    /* Input and output files. */
+    memset(&in, 0, sizeof in);
+    memset(&out, 0, sizeof out);
+
+    /* Hash table of signatures. */
+    memset(&hashes, 0, sizeof hashes);
+
+    /* Indicator of success and the error message of a fail. */
+    success = true;
+    err_msg = err_msg_env;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 7 or 9, print
+     * the error message and exit with a non-zero value. */
+    if (!(argc == 8 || argc == 10))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the command line arguments is a null-pointer, print
+     * the error message and exit with a non-zero value. */
+    for (i = 0U; argv && i < (size_t)argc; ++i)
+        if (!*(argv + i))
+            break;
+    if (!(argv && i == (size_t)argc))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the numbers, the tolerance and the seed. */
+    N = (size_t)atoi(*(argv + 2U));
+    n = (size_t)atoi(*(argv + 3U));
+    tol = (real_t)atof(*(argv + 4U));
+    K = (size_t)atoi(*(argv + 5U));
+    srand((unsigned int)strtoul(*(argv + 6U), (char**)(NULL), 10));
+    M = (argc == 10) ? (size_t)atoi(*(argv + 9U)) : 0U;
+
+    /* Check the numbers and the tolerance and select the error message. */
+    if (!(N && (argc == 8 || M)))
+        err_msg = err_msg_npr;
+    else if (n < 3U)
+        err_msg = err_msg_nv;
+    else if (!(tol > 0.0))
+        err_msg = err_msg_tol;
+    else if (!(K && K <= LSH_PROJECTIONS))
+        err_msg = err_msg_nk;
+    else
+        err_msg = (const char*)(NULL);
+
+    /* If any of the numbers or the tolerance is illegal, print the error
+     * message and exit with a non-zero value. */
+    if (err_msg)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Allocate memory for the arrays and create the hash table. */
+    ld_A = ((n + 63U) >> 6U) << 6U;
+    P = (real_t*)malloc((n << 1U) * sizeof *P);
+    W = (real_t*)malloc((n << 2U) * sizeof *W);
+    A = (real_t*)malloc(((n * ld_A) << 1U) * sizeof *A);
+    s = (real_t*)malloc((n << 2U) * sizeof *s);
+    success =
+        (P && W && A && s && !lsh_init(&hashes, n << 2U, K, tol, N + M)) ?
+            true :
+            false;
+    err_msg = err_msg_mem;
+    if (success)
+    {
+        memset(P, 0, (n << 1U) * sizeof *P);
+        memset(W, 0, (n << 2U) * sizeof *W);
+        memset(A, 0, ((n * ld_A) << 1U) * sizeof *A);
+        memset(s, 0, (n << 2U) * sizeof *s);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Hash the already labelled polygons (if `j` is 0) and filter the input
+     * polygons to the output file (if `j` is 1). */
+    for (j = (argc == 10) ? 0U : 1U; success && j < 2U; ++j)
+    {
+        success = table_open(&in, *(argv + (j ? 1U : 8U)), false);
+        err_msg = err_msg_in;
+        if (success && j)
+        {
+            success = table_open(&out, *(argv + 7U), true);
+            err_msg = err_msg_out;
+            if (!success)
+                table_close(&in);
+        }
+        if (!success)
+            break;
+        for (i = 0U; success && i < (j ? N : M); ++i)
+        {
+            success = (table_scan(&in, n << 1U, P) == (n << 1U));
+            err_msg = err_msg_rc;
+            if (!success)
+                break;
+            lsh_signature(n, P, W, A, s);
+            if (lsh_insert(&hashes, s) && j)
+            {
+                table_dump_polygons(&out, n, P, 1U);
+                ++novel;
+            }
+        }
+        table_close(&in);
+        if (j)
+            table_close(&out);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Print the number of novel polygons and the time elapsed during the
+     * filtering. */
+    if (success)
+    {
+        printf(format_novel, (unsigned long)novel, (unsigned long)N);
+        printf(
+            format_time,
+            (double)(t1.tv_sec - t0.tv_sec) +
+                1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+        );
+    }
+
+    /* If anything has failed, print the error message. */
+    else
+        fprintf(stderr, format_err_msg, err_msg);
+
+    /* Free the hash table. */
+    lsh_free(&hashes);
+
+    /* Deallocate memory. */
+    if (P)
+        memset(P, 0, (n << 1U) * sizeof *P);
+    free(P);
+    P = (real_t*)(NULL);
+    if (W)
+        memset(W, 0, (n << 2U) * sizeof *W);
+    free(W);
+    W = (real_t*)(NULL);
+    if (A)
+        memset(A, 0, ((n * ld_A) << 1U) * sizeof *A);
+    free(A);
+    A = (real_t*)(NULL);
+    if (s)
+        memset(s, 0, (n << 2U) * sizeof *s);
+    free(s);
+    s = (real_t*)(NULL);
+
+    /* Return a zero value (exit with a zero value) on success. */
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
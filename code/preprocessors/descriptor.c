@@ -35,12 +35,19 @@
  * The pogram prints to the console the time elapsed only during the computation
  * of the information.  Time needed to read and print is not measured.
  *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single polygon per row instead of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -56,6 +63,8 @@
 #include "boolean.h"
 #include "numeric.h"
 #include "polygon.h"
+#include "batch.h"
+#include "table.h"
 
 int main (int argc, char** argv)
 {
@@ -94,15 +103,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the input file to open. */
-    const char* const file_in_open_mode = "rt";
-
-    /* Mode of the output file to open. */
-    const char* const file_out_open_mode = "wt";
-
-    /* Format string for reading the coordinates. */
-    const char* const format_input = " %lf";
-
     /* Format string for printing the time elapsed. */
     const char* const format_time = "Time elapsed: %.6f s.\n";
 
@@ -129,7 +129,7 @@ int main (int argc, char** argv)
     real_t* phi;
 
     /* Input/output file. */
-    FILE* inout;
+    table_t inout;
 
     /* Iteration indices. */
     size_t i;
@@ -158,7 +158,7 @@ int main (int argc, char** argv)
     phi = (real_t*)(NULL);
 
     /* Input/output file. */
-    inout = (FILE*)(NULL);
+    memset(&inout, 0, sizeof inout);
 
     /* Iteration indices. */
     i = 0U;
@@ -289,15 +289,15 @@ int main (int argc, char** argv)
      * outer angles to zeros. */
     memset(dx, 0, ((N * n) << 1U) * sizeof *dx);
     memset(l, 0, ((N * n) << 1U) * sizeof *l);
-    dy = dx + n;
-    phi = l + n;
 
-    /* Open the input file. */
-    inout = fopen(*(argv + 1U), file_in_open_mode);
+    /* The arrays are organised as batches (see "batch.h"): the second halves
+     * of the arrays `dx` and `l` are the arrays `dy` and `phi`. */
+    dy = dx + N * n;
+    phi = l + N * n;
 
-    /* If the input file could not be opened, print the error message,
+    /* Open the input file.  If it could not be opened, print the error message,
      * deallocate memory and exit with a non-zero value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 1U), false))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_in);
@@ -334,14 +334,13 @@ int main (int argc, char** argv)
          * coordinates could not be read, print the error message, close the
          * input file, deallocate memory and exit with a non-zero value. */
         for (j = 0U; (j >> 1U) < n; ++j)
-            if (!(fscanf(inout, format_input, P + ((i * n) << 1U) + j) == 1))
+            if (!(table_scan(&inout, 1U, P + ((i * n) << 1U) + j) == 1U))
             {
                 /* Print the error message. */
                 fprintf(stderr, format_err_msg, err_msg_rc);
 
                 /* Close the input file. */
-                fclose(inout);
-                inout = (FILE*)(NULL);
+                table_close(&inout);
 
                 /* Clear the memory in the arrays of the differences in
                  * coordinates, the lengths of edges and the outer angles. */
@@ -370,22 +369,24 @@ int main (int argc, char** argv)
     }
 
     /* Close the input file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
 
     /* Get the current clock ticks. */
     t0 = clock();
 
+    /* Transpose the polygons into a batch stored in the arrays `dx` and `dy`.
+     * The array of points `P` is not needed after this, so it is used to store
+     * the differences in coordinates computed in the batch. */
+    batch_transpose_polygons(n, N, P, dx, dy);
+
     /* Describe all polygons. */
-    for (i = 0U; i < N; ++i)
-        describe_polygon(
-            n,
-            P + ((i * n) << 1U),
-            dx + ((i * n) << 1U),
-            dy + ((i * n) << 1U),
-            l + ((i * n) << 1U),
-            phi + ((i * n) << 1U)
-        );
+    batch_describe_polygon(n, N, dx, dy, P, P + N * n, l, phi);
+
+    /* Transpose the lengths of edges and the outer angles from the batch into
+     * the array `P` and copy them back to the array `l`. */
+    batch_untranspose(n, N, l, P, n << 1U);
+    batch_untranspose(n, N, phi, P + n, n << 1U);
+    memcpy(l, P, ((N * n) << 1U) * sizeof *l);
 
     /* Get the current clock ticks. */
     t1 = clock();
@@ -393,13 +394,10 @@ int main (int argc, char** argv)
     /* Print the time elapsed during the description of polygons. */
     printf(format_time, (double)(t1 - t0) / clocks_per_sec);
 
-    /* Open the output file. */
-    inout = fopen(*(argv + 4U), file_out_open_mode);
-
-    /* If the output file could not be opened, print the error message,
-     * close the input file, deallocate memory and exit with a non-zero
+    /* Open the output file.  If it could not be opened, print the error
+     * message, close the input file, deallocate memory and exit with a non-zero
      * value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 4U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
@@ -433,11 +431,10 @@ int main (int argc, char** argv)
      * polygons have exactly 2 * `n` bits of information stored in the array
      * `l`, so the `dump_polygons` function can be used to dump the
      * information. */
-    dump_polygons(inout, n, l, N);
+    table_dump_polygons(&inout, n, l, N);
 
     /* Close the output file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
 
     /* Clear the memory in the arrays of the differences in coordinates,
      * the lengths of edges and the outer angles. */
@@ -35,6 +35,9 @@ Dimensions of the PNG images are hard coded (global parameters `w` for width and
 The pogram prints to the console the time elapsed only during the generation of
 PNG images.  Time needed to read is not measured.
 
+To rasterise polygons directly into a single NumPy array without generating
+images one by one, use "rasteriser.c" instead.
+
 """
 
 # Import standard library modules.
@@ -21,6 +21,9 @@
 ##  The pogram prints to the console the time elapsed during the conversion of
 ##  images.
 ##
+##  To rasterise polygons directly into a single NumPy array without generating
+##  and converting images one by one, use "rasteriser.c" instead.
+##
 
 # Variable to save the value returned by the `slashise_directory` function.
 dirpath=""
@@ -0,0 +1,514 @@
+/**
+ * Program for rasterising polygons into a NumPy array.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./rasterise in N n R T type out
+ * where:
+ *     in   is the path to the input file to read the coordinates of vertices,
+ *     N    is the number of polygons to read (at least 1),
+ *     n    is the number of vertices of each polygon (at least 3),
+ *     R    is the resolution of images (at least 1),
+ *     T    is the number of threads (at least 1),
+ *     type is the type of values in the output array ("u1" for `uint8` or
+ *          "f4" for `float32`),
+ *     out  is the path to the output ".npy" file.
+ *
+ * Each polygon must be formated in the input file as
+ *     x_0	y_0	x_1	y_1	...	x_n_minus_1	y_n_minus_1
+ * where x_i denotes the x-coordinate of the i-th vertex and y_i denotes the
+ * y-coordinate of the i-th vertex.  Whitespaces may differ (they may even be
+ * spaces, tabs, line breaks...).  It is believed that each input polygon
+ * truly represents a polygon of n vertices---this is not checked and if any
+ * input polygon does not satisfy this, results may be unexpected.
+ *
+ * If the path to the input file ends with ".npy" or ".pcz", the coordinates are
+ * read from a NumPy array of shape (N, 2 * n) or from a compressed table
+ * instead (see "table.h").
+ *
+ * Note that the input file must contain at least N polygons.  If, however, it
+ * contains more than N polygons, only the first N polygons are read and
+ * rasterised.
+ *
+ * Each polygon is rasterised on the window [-0.64, 0.64] x [-0.64, 0.64] (the
+ * same window as in "direct_pngise.py") with the resolution R x R.  The value
+ * of each pixel is the exact area of the part of the pixel covered by the
+ * polygon divided by the area of the pixel (see "raster.h"); if the type is
+ * "u1", the value is multiplied by 255 and rounded.  The images are dumped to
+ * the output file as a single NumPy array of shape (N, R, R), which may be
+ * loaded in Python by `numpy.load(out)` or `numpy.load(out, mmap_mode = 'r')`.
+ * Polygons are rasterised in chunks and each chunk is dumped before the next
+ * one is rasterised, so the images of all polygons are never held in memory
+ * at once.
+ *
+ * The program replaces the generation of images by "direct_pngise.py" and by
+ * "svgise.py" followed by "pngise.sh".  Unlike the PNG images, the values are
+ * coverages of polygons (1 inside, 0 outside), not the brightness of pixels
+ * of black polygons on a white background.
+ *
+ * The pogram prints to the console the (wall clock) time elapsed only during
+ * the rasterisation.  Time needed to read and dump is not measured.
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Compile with mathematical constants from "math.h". */
+#define _USE_MATH_DEFINES   1
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "raster.h"
+#include "table.h"
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Number of polygons per thread in a single chunk. */
+    const size_t chunk_per_thread = 32U;
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 7: input file path, number of "
+            "polygons to read, number of vertices, resolution, number of "
+            "threads, type and output file path.";
+
+    /* Error message for the illegal number of polygons to read. */
+    const char* const err_msg_npr =
+        "Number of polygons to read must be at least 1.";
+
+    /* Error message for the illegal number of vertices. */
+    const char* const err_msg_nv = "Number of vertices must be at least 3.";
+
+    /* Error message for the illegal resolution. */
+    const char* const err_msg_res = "Resolution must be at least 1.";
+
+    /* Error message for the illegal number of threads. */
+    const char* const err_msg_nt = "Number of threads must be at least 1.";
+
+    /* Error message for the illegal type. */
+    const char* const err_msg_type = "Type must be \"u1\" or \"f4\".";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for failing to read a coordinate. */
+    const char* const err_msg_rc = "Reading a coordinate failed.";
+
+    /* Error message for failing to dump the images. */
+    const char* const err_msg_dump = "Dumping the images failed.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Mode of the output file to open. */
+    const char* const file_out_open_mode = "wb";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Time points. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Time elapsed during the rasterisation. */
+    double elapsed;
+
+    /* Number of polygons to read. */
+    size_t N;
+
+    /* Number of vertices. */
+    size_t n;
+
+    /* Resolution of images. */
+    size_t R;
+
+    /* Number of threads. */
+    size_t T;
+
+    /* Indicator of the type `uint8`. */
+    bool bytes;
+
+    /* Number of polygons in a chunk and in the current chunk. */
+    size_t C;
+    size_t c;
+
+    /* Array of vertices. */
+    real_t* P;
+
+    /* Array of images of a chunk. */
+    real_t* A;
+
+    /* Input file. */
+    table_t in;
+
+    /* Output file. */
+    FILE* out;
+
+    /* Indicator of an error while dumping. */
+    bool err;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Time points. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Time elapsed during the rasterisation. */
+    elapsed = 0.0;
+
+    /* Number of polygons to read. */
+    N = 0U;
+
+    /* Number of vertices. */
+    n = 0U;
+
+    /* Resolution of images. */
+    R = 0U;
+
+    /* Number of threads. */
+    T = 0U;
+
+    /* Indicator of the type `uint8`. */
+    bytes = false;
+
+    /* Number of polygons in a chunk and in the current chunk. */
+    C = 0U;
+    c = 0U;
+
+    /* Array of vertices. */
+    P = (real_t*)(NULL);
+
+    /* Array of images of a chunk. */
+    A = (real_t*)(NULL);
+
+    /* Input file. */
+    memset(&in, 0, sizeof in);
+
+    /* Output file. */
+    out = (FILE*)(NULL);
+
+    /* Indicator of an error while dumping. */
+    err = false;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 7, print the
+     * error message and exit with a non-zero value. */
+    if (!(argc == 8))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` is a null-pointer, print the error message and exit with a
+     * non-zero value. */
+    if (!argv)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If any of the 8 command line arguments is a null-pointer, print the error
+     * message and exit with a non-zero value. */
+    if (
+        !(
+            *argv &&
+            *(argv + 1U) &&
+            *(argv + 2U) &&
+            *(argv + 3U) &&
+            *(argv + 4U) &&
+            *(argv + 5U) &&
+            *(argv + 6U) &&
+            *(argv + 7U)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the number of polygons to read. */
+    N = (size_t)atoi(*(argv + 2U));
+
+    /* Scan the number of vertices. */
+    n = (size_t)atoi(*(argv + 3U));
+
+    /* Scan the resolution. */
+    R = (size_t)atoi(*(argv + 4U));
+
+    /* Scan the number of threads. */
+    T = (size_t)atoi(*(argv + 5U));
+
+    /* If the number of polygons to read is 0, print the error message and exit
+     * with a non-zero value. */
+    if (!N)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_npr);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of vertices is strictly less than 3, print the error
+     * message and exit with a non-zero value. */
+    if (n < 3U)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nv);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the resolution is 0, print the error message and exit with a non-zero
+     * value. */
+    if (!R)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_res);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If the number of threads is 0, print the error message and exit with a
+     * non-zero value. */
+    if (!T)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_nt);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the type.  If it is not "u1" or "f4", print the error message and
+     * exit with a non-zero value. */
+    if (!strcmp(*(argv + 6U), "u1"))
+        bytes = true;
+    else if (!strcmp(*(argv + 6U), "f4"))
+        bytes = false;
+    else
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_type);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Compute the number of polygons in a chunk. */
+    C = T * chunk_per_thread;
+    if (C > N)
+        C = N;
+
+    /* Allocate memory for the polygons and for the images of a chunk. */
+    P = (real_t*)malloc(((N * n) << 1U) * sizeof *P);
+    A = (real_t*)malloc(C * R * R * sizeof *A);
+
+    /* If the memory allocation has failed, deallocate memory, print the error
+     * message and exit with a non-zero value. */
+    if (!(P && A))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory for the polygons and for the images. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(A);
+        A = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise coordinates of vertices of polygons and the images to
+     * zeros. */
+    memset(P, 0, ((N * n) << 1U) * sizeof *P);
+    memset(A, 0, C * R * R * sizeof *A);
+
+    /* Open the input file.  If it could not be opened, print the error
+     * message, deallocate memory and exit with a non-zero value. */
+    if (!table_open(&in, *(argv + 1U), false))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_in);
+
+        /* Clear the memory in the arrays of points and images. */
+        memset(P, 0, ((N * n) << 1U) * sizeof *P);
+        memset(A, 0, C * R * R * sizeof *A);
+
+        /* Deallocate memory for the polygons and for the images. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(A);
+        A = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Read the input polygons. */
+    for (i = 0; i < N; ++i)
+    {
+        /* Read the coordinates of the `i`-th input polygon.  If any of the
+         * coordinates could not be read, print the error message, close the
+         * input file, deallocate memory and exit with a non-zero value. */
+        for (j = 0U; (j >> 1U) < n; ++j)
+            if (!(table_scan(&in, 1U, P + ((i * n) << 1U) + j) == 1U))
+            {
+                /* Print the error message. */
+                fprintf(stderr, format_err_msg, err_msg_rc);
+
+                /* Close the input file. */
+                table_close(&in);
+
+                /* Clear the memory in the arrays of points and images. */
+                memset(P, 0, ((N * n) << 1U) * sizeof *P);
+                memset(A, 0, C * R * R * sizeof *A);
+
+                /* Deallocate memory for the polygons and for the images. */
+                free(P);
+                P = (real_t*)(NULL);
+                free(A);
+                A = (real_t*)(NULL);
+
+                /* Exit with a non-zero value. */
+                exit(EXIT_FAILURE);
+            }
+    }
+
+    /* Close the input file. */
+    table_close(&in);
+
+    /* Open the output file. */
+    out = fopen(*(argv + 7U), file_out_open_mode);
+
+    /* If the output file could not be opened, print the error message,
+     * deallocate memory and exit with a non-zero value. */
+    if (!out)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_out);
+
+        /* Clear the memory in the arrays of points and images. */
+        memset(P, 0, ((N * n) << 1U) * sizeof *P);
+        memset(A, 0, C * R * R * sizeof *A);
+
+        /* Deallocate memory for the polygons and for the images. */
+        free(P);
+        P = (real_t*)(NULL);
+        free(A);
+        A = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Dump the header of the array. */
+    err = dump_raster_header(out, N, R, bytes) ? true : false;
+
+    /* Rasterise and dump the polygons in chunks.  If dumping fails, break the
+     * `for`-loop. */
+    for (i = 0U; !err && i < N; i += c)
+    {
+        /* Compute the number of polygons in the current chunk. */
+        c = (N - i < C) ? N - i : C;
+
+        /* Get the current time. */
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+
+        /* Rasterise the polygons in the current chunk. */
+        raster_polygons(n, c, P + ((i * n) << 1U), raster_half_side, R, A, T);
+
+        /* Get the current time. */
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        /* Add the time elapsed during the rasterisation of the chunk. */
+        elapsed +=
+            (double)(t1.tv_sec - t0.tv_sec) +
+            1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec);
+
+        /* Dump the images of the current chunk. */
+        if (dump_raster(out, c * R * R, A, bytes) != c * R * R)
+            err = true;
+    }
+
+    /* Close the output file. */
+    if (fclose(out))
+        err = true;
+    out = (FILE*)(NULL);
+
+    /* Clear the memory in the arrays of points and images. */
+    memset(P, 0, ((N * n) << 1U) * sizeof *P);
+    memset(A, 0, C * R * R * sizeof *A);
+
+    /* Deallocate memory for the polygons and for the images. */
+    free(P);
+    P = (real_t*)(NULL);
+    free(A);
+    A = (real_t*)(NULL);
+
+    /* If dumping has failed, print the error message and exit with a non-zero
+     * value. */
+    if (err)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_dump);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Print the time elapsed during the rasterisation of polygons. */
+    printf(format_time, elapsed);
+
+    /* Return a zero value (exit with a zero value). */
+    return EXIT_SUCCESS;
+}
@@ -34,12 +34,19 @@
  * The pogram prints to the console the time elapsed only during sorting the
  * values.  Time needed to read and print is not measured.
  *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single polygon per row instead of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -55,6 +62,7 @@
 #include "boolean.h"
 #include "numeric.h"
 #include "polygon.h"
+#include "table.h"
 
 int main (int argc, char** argv)
 {
@@ -93,15 +101,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the input file to open. */
-    const char* const file_in_open_mode = "rt";
-
-    /* Mode of the output file to open. */
-    const char* const file_out_open_mode = "wt";
-
-    /* Format string for reading the numbers. */
-    const char* const format_input = " %lf";
-
     /* Format string for printing the time elapsed. */
     const char* const format_time = "Time elapsed: %.6f s.\n";
 
@@ -122,7 +121,7 @@ int main (int argc, char** argv)
     real_t* phi;
 
     /* Input/output file. */
-    FILE* inout;
+    table_t inout;
 
     /* Iteration indices. */
     size_t i;
@@ -145,7 +144,7 @@ int main (int argc, char** argv)
     phi = (real_t*)(NULL);
 
     /* Input/output file. */
-    inout = (FILE*)(NULL);
+    memset(&inout, 0, sizeof inout);
 
     /* Iteration indices. */
     i = 0U;
@@ -244,12 +243,9 @@ int main (int argc, char** argv)
     memset(l, 0, ((N * n) << 1U) * sizeof *l);
     phi = l + n;
 
-    /* Open the input file. */
-    inout = fopen(*(argv + 1U), file_in_open_mode);
-
-    /* If the input file could not be opened, print the error message,
+    /* Open the input file.  If it could not be opened, print the error message,
      * deallocate memory and exit with a non-zero value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 1U), false))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_in);
@@ -276,14 +272,13 @@ int main (int argc, char** argv)
          * error message, close the input file, deallocate memory and exit with
          * a non-zero value. */
         for (j = 0U; (j >> 1U) < n; ++j)
-            if (!(fscanf(inout, format_input, l + ((i * n) << 1U) + j) == 1))
+            if (!(table_scan(&inout, 1U, l + ((i * n) << 1U) + j) == 1U))
             {
                 /* Print the error message. */
                 fprintf(stderr, format_err_msg, err_msg_rn);
 
                 /* Close the input file. */
-                fclose(inout);
-                inout = (FILE*)(NULL);
+                table_close(&inout);
 
                 /* Clear the memory in the arrays of the lengths of edges and
                  * the outer angles. */
@@ -301,8 +296,7 @@ int main (int argc, char** argv)
     }
 
     /* Close the input file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
 
     /* Get the current clock ticks. */
     t0 = clock();
@@ -323,13 +317,10 @@ int main (int argc, char** argv)
     /* Print the time elapsed during the description of polygons. */
     printf(format_time, (double)(t1 - t0) / clocks_per_sec);
 
-    /* Open the output file. */
-    inout = fopen(*(argv + 4U), file_out_open_mode);
-
-    /* If the output file could not be opened, print the error message,
-     * close the input file, deallocate memory and exit with a non-zero
+    /* Open the output file.  If it could not be opened, print the error
+     * message, close the input file, deallocate memory and exit with a non-zero
      * value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 4U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
@@ -352,11 +343,10 @@ int main (int argc, char** argv)
      * all polygons have exactly 2 * `n` bits of information stored in the array
      * `l`, so the `dump_polygons` function can be used to dump the
      * information. */
-    dump_polygons(inout, n, l, N);
+    table_dump_polygons(&inout, n, l, N);
 
     /* Close the output file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
 
     /* Clear the memory in the arrays of the lengths of edges and the outer
      * angles. */
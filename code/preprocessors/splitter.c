@@ -0,0 +1,767 @@
+/**
+ * Program for splitting a dataset into the training, the validation and the
+ * test set.
+ *
+ * This file is part of Davor Penzar's master thesis programing.
+ *
+ * Usage:
+ *     ./split N F B log seed p_train p_validation M tmp train validation \
+ *         test m_1 in_1 [m_2 in_2 ...]
+ * where:
+ *     N            is the number of rows (polygons) to read (at least 1),
+ *     F            is the number of rows of a family (at least 1),
+ *     B            is the number of quantile bins of the stratification (at
+ *                  least 1),
+ *     log          is 1 if the families are stratified by the mean logarithm
+ *                  of their eigenvalues and 0 if by the mean eigenvalue,
+ *     seed         is the seed of the pseudorandom number generator,
+ *     p_train      is the proportion of the training set,
+ *     p_validation is the proportion of the validation set (the test set
+ *                  takes the rest),
+ *     M            is the number of rows to hold in memory at once (at least
+ *                  1),
+ *     tmp          is the path to the directory of the temporary files,
+ *     train        is the path to the directory of the training set,
+ *     validation   is the path to the directory of the validation set,
+ *     test         is the path to the directory of the test set,
+ *     m_j          is the number of values in each row of the j-th column (at
+ *                  least 1),
+ *     in_j         is the path to the input file of the j-th column.
+ *
+ * A column is a table of a row per polygon (such as "coordinates.tsv",
+ * "sorted_descriptions.tsv" or "eigenvalues.tsv" in "data/numerical"), and all
+ * columns must have at least N rows.  The first value of each row of the first
+ * column must be the eigenvalue of the polygon (for instance, the first column
+ * is "eigenvalues.tsv").
+ *
+ * The i-th row belongs to the family i / F (rounded down):  the generators
+ * dump all polygons generated from a polygon consecutively (see
+ * "generators/triangles_rotator.c" and "generators/perturbator.c"), so with F
+ * equal to the number of polygons generated from each polygon (for instance,
+ * 3 for the rotations of triangles) all rotations and perturbations of a
+ * polygon end up in the same set and no set leaks into another.  The families
+ * are stratified by their mean eigenvalues (or the mean logarithms of their
+ * eigenvalues) into B bins of quantiles (B = 20 gives the 5 % quantiles of
+ * "data/arrays/l_quantiles.npy") and the families of each bin are assigned to
+ * the sets at random in the given proportions (see "split.h").
+ *
+ * The rows of each set are shuffled by an external shuffle in two passes:  the
+ * columns are read once, row by row, and each row (of all columns) is appended
+ * to a random temporary file (a bucket) of its set in the directory tmp.  The
+ * buckets are then read one by one, shuffled in memory and appended to the
+ * output files.  The number of buckets of a set of n rows is 2 n / M (rounded
+ * up), so a bucket holds M / 2 rows on average and hardly ever more than M
+ * rows.  The j-th column of each set is dumped to the file of the same name as
+ * in_j in the directory of the set (the directories must exist), so the
+ * datasets are laid out as in "data/numerical".  The same seed and the same
+ * arguments give the same sets in the same order.
+ *
+ * The pogram prints to the console the numbers of families and of rows of the
+ * sets and the (wall clock) time elapsed.
+ *
+ * Caution: all buckets and all input files are opened at once, so their
+ * number must not exceed the limit of open files.  The temporary files are
+ * removed at the end.
+ *
+ * If the path to any of the input files ends with ".npy" or ".pcz", the file
+ * is read or dumped as a NumPy array or as a compressed table instead of a text
+ * file (see "table.h").  Values of text files are dumped with 8 decimals (as
+ * by the `dump_polygons` function).
+ *
+ * @author Davor Penzar <davor.penzar@gmail.com>
+ * @version 1.0
+ * @package polygon
+ *
+ */
+
+/* Compile with POSIX functions (`clock_gettime`, `mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
+/* Include standard library headers. */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Include package headers. */
+#include "boolean.h"
+#include "numeric.h"
+#include "split.h"
+#include "table.h"
+
+/* Define the number of fixed additional arguments. */
+#define SPLIT_ARGUMENTS 12U
+
+int main (int argc, char** argv)
+{
+    /* DECLARATION OF CONSTANTS */
+
+    /* Error message for an unknown environment error. */
+    const char* const err_msg_env = "Unknown environment error.";
+
+    /* Error message for the illegal number of additional arguments. */
+    const char* const err_msg_argc =
+        "Number of additional arguments must be 12 followed by pairs of the "
+            "number of values and the input file path of each column (at "
+            "least one):  number of rows, number of rows of a family, number "
+            "of bins, logarithm indicator, seed, proportions of the training "
+            "and of the validation set, number of rows in memory, directory "
+            "of temporary files and directories of the training, of the "
+            "validation and of the test set.";
+
+    /* Error message for the illegal number of rows to read. */
+    const char* const err_msg_npr =
+        "Number of rows to read must be at least 1.";
+
+    /* Error message for the illegal number of rows of a family. */
+    const char* const err_msg_nf =
+        "Number of rows of a family must be at least 1.";
+
+    /* Error message for the illegal number of bins. */
+    const char* const err_msg_nb = "Number of bins must be at least 1.";
+
+    /* Error message for illegal proportions. */
+    const char* const err_msg_p =
+        "Proportions must be nonnegative and of sum at most 1.";
+
+    /* Error message for the illegal number of rows in memory. */
+    const char* const err_msg_nm =
+        "Number of rows in memory must be at least 1.";
+
+    /* Error message for the illegal number of values of a column. */
+    const char* const err_msg_nv =
+        "Number of values of each column must be at least 1.";
+
+    /* Error message for the memory allocation fail. */
+    const char* const err_msg_mem = "Memory allocation fail.";
+
+    /* Error message for input file opening fail. */
+    const char* const err_msg_in = "Input file cannot be opened.";
+
+    /* Error message for output file opening fail. */
+    const char* const err_msg_out = "Output file cannot be opened.";
+
+    /* Error message for temporary file opening, writing or reading fail. */
+    const char* const err_msg_tmp = "Temporary file cannot be used.";
+
+    /* Error message for failing to read a value. */
+    const char* const err_msg_rv = "Reading a value failed.";
+
+    /* Error message for an illegal eigenvalue. */
+    const char* const err_msg_ev =
+        "Eigenvalues must be strictly positive to take logarithms.";
+
+    /* Format string for printing error messages. */
+    const char* const format_err_msg = "%s\n";
+
+    /* Format string for the paths to the files. */
+    const char* const format_path = "%s/%s";
+
+    /* Format string for the paths to the temporary files. */
+    const char* const format_tmp = "%s/split_%lu_%lu.tmp";
+
+    /* Format string for printing the sizes of the sets. */
+    const char* const format_set = "%s set: %lu families, %lu rows.\n";
+
+    /* Format string for printing the time elapsed. */
+    const char* const format_time = "Time elapsed: %.6f s.\n";
+
+    /* Names of the sets. */
+    const char* const names[SPLIT_SETS] = { "Training", "Validation", "Test" };
+
+    /* DECLARATION OF VARIABLES */
+
+    /* Times. */
+    struct timespec t0;
+    struct timespec t1;
+
+    /* Number of rows to read, the number of rows of a family and the number
+     * of families. */
+    size_t N;
+    size_t F;
+    size_t n_f;
+
+    /* Number of bins and the indicator of the logarithms. */
+    size_t B;
+    bool logarithm;
+
+    /* Pseudorandom number generator. */
+    split_random_t R;
+
+    /* Proportions of the sets and the cumulative numbers of their
+     * families. */
+    real_t p[SPLIT_SETS];
+    size_t C[SPLIT_SETS];
+
+    /* Number of rows in memory. */
+    size_t M;
+
+    /* Number of columns, the numbers of their values and the number of values
+     * of all columns. */
+    size_t k;
+    size_t* m;
+    size_t w;
+
+    /* Offset of a column in a row. */
+    size_t o;
+
+    /* Keys of the families, the sorted keys and the edges of the bins. */
+    real_t* key;
+    real_t* sorted;
+    real_t* E;
+
+    /* Numbers of families of the bins to assign to the sets and the sets of
+     * the families. */
+    size_t* Q;
+    unsigned char* S;
+
+    /* Numbers of families and of rows of the sets. */
+    size_t families[SPLIT_SETS];
+    size_t rows[SPLIT_SETS];
+
+    /* Index of the first bucket and the number of buckets of each set, the
+     * number of all buckets and the largest number of rows of a bucket. */
+    size_t first[SPLIT_SETS];
+    size_t K[SPLIT_SETS];
+    size_t K_all;
+    size_t largest;
+
+    /* Buckets and their numbers of rows. */
+    FILE** bucket;
+    size_t* count;
+
+    /* Input and output tables. */
+    table_t* table;
+
+    /* Row of all columns, the rows of a bucket and the workspace. */
+    real_t* row;
+    real_t* X;
+    real_t* W;
+
+    /* Path to a file and its length. */
+    char* path;
+    size_t length;
+
+    /* Indicator of success and the error message of a fail. */
+    bool success;
+    const char* err_msg;
+
+    /* Iteration indices. */
+    size_t i;
+    size_t j;
+    size_t s;
+    size_t b;
+
+    /* INITIALISATION OF VARIABLES */
+
+    /* Times. */
+    memset(&t0, 0, sizeof t0);
+    memset(&t1, 0, sizeof t1);
+
+    /* Numbers of rows and of families. */
+    N = 0U;
+    F = 0U;
+    n_f = 0U;
+
+    /* Number of bins and the indicator of the logarithms. */
+    B = 0U;
+    logarithm = false;
+
+    /* Pseudorandom number generator. */
+    memset(&R, 0, sizeof R);
+
+    /* Proportions and cumulative numbers. */
+    memset(p, 0, SPLIT_SETS * sizeof *p);
+    memset(C, 0, SPLIT_SETS * sizeof *C);
+
+    /* Number of rows in memory. */
+    M = 0U;
+
+    /* Columns. */
+    k = 0U;
+    m = (size_t*)(NULL);
+    w = 0U;
+
+    /* Offset of a column. */
+    o = 0U;
+
+    /* Keys and edges. */
+    key = (real_t*)(NULL);
+    sorted = (real_t*)(NULL);
+    E = (real_t*)(NULL);
+
+    /* Assignment. */
+    Q = (size_t*)(NULL);
+    S = (unsigned char*)(NULL);
+
+    /* Sizes of the sets. */
+    memset(families, 0, SPLIT_SETS * sizeof *families);
+    memset(rows, 0, SPLIT_SETS * sizeof *rows);
+
+    /* Buckets. */
+    memset(first, 0, SPLIT_SETS * sizeof *first);
+    memset(K, 0, SPLIT_SETS * sizeof *K);
+    K_all = 0U;
+    largest = 0U;
+    bucket = (FILE**)(NULL);
+    count = (size_t*)(NULL);
+
+    /* Tables. */
+    table = (table_t*)(NULL);
+
+    /* Rows. */
+    row = (real_t*)(NULL);
+    X = (real_t*)(NULL);
+    W = (real_t*)(NULL);
+
+    /* Path. */
+    path = (char*)(NULL);
+    length = 0U;
+
+    /* Indicator of success and the error message of a fail. */
+    success = true;
+    err_msg = err_msg_env;
+
+    /* Iteration indices. */
+    i = 0U;
+    j = 0U;
+    s = 0U;
+    b = 0U;
+
+    /* ALGORITHM */
+
+    /* If the number of additional command line arguments is not 12 followed
+     * by pairs, print the error message and exit with a non-zero value. */
+    if (
+        !(
+            argc >= (int)(SPLIT_ARGUMENTS + 3U) &&
+            !((argc - (int)(SPLIT_ARGUMENTS + 1U)) & 1)
+        )
+    )
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_argc);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* If `argv` or any of the command line arguments is a null-pointer, print
+     * the error message and exit with a non-zero value. */
+    for (i = 0U; argv && i < (size_t)argc; ++i)
+        if (!*(argv + i))
+            break;
+    if (!(argv && i == (size_t)argc))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_env);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Scan the numbers, the seed and the proportions. */
+    N = (size_t)atoi(*(argv + 1U));
+    F = (size_t)atoi(*(argv + 2U));
+    B = (size_t)atoi(*(argv + 3U));
+    logarithm = atoi(*(argv + 4U)) ? true : false;
+    split_seed(&R, strtoul(*(argv + 5U), (char**)(NULL), 10));
+    *p = (real_t)atof(*(argv + 6U));
+    *(p + 1U) = (real_t)atof(*(argv + 7U));
+    *(p + 2U) = 1.0 - *p - *(p + 1U);
+    M = (size_t)atoi(*(argv + 8U));
+    k = ((size_t)argc - SPLIT_ARGUMENTS - 1U) >> 1U;
+
+    /* Check the numbers and the proportions and select the error message. */
+    if (!N)
+        err_msg = err_msg_npr;
+    else if (!F)
+        err_msg = err_msg_nf;
+    else if (!B)
+        err_msg = err_msg_nb;
+    else if (!(*p >= 0.0 && *(p + 1U) >= 0.0 && *(p + 2U) >= -1.0e-12))
+        err_msg = err_msg_p;
+    else if (!M)
+        err_msg = err_msg_nm;
+    else
+        err_msg = (const char*)(NULL);
+
+    /* If any of the numbers or the proportions is illegal, print the error
+     * message and exit with a non-zero value. */
+    if (err_msg)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+    if (*(p + 2U) < 0.0)
+        *(p + 2U) = 0.0;
+    n_f = (N + F - 1U) / F;
+
+    /* Allocate memory for the numbers of values of the columns, the tables,
+     * the keys, the edges and the assignment. */
+    m = (size_t*)malloc(k * sizeof *m);
+    table = (table_t*)malloc(k * sizeof *table);
+    key = (real_t*)malloc(n_f * sizeof *key);
+    sorted = (real_t*)malloc(n_f * sizeof *sorted);
+    E = (real_t*)malloc(B * sizeof *E);
+    Q = (size_t*)malloc(B * SPLIT_SETS * sizeof *Q);
+    S = (unsigned char*)malloc(n_f * sizeof *S);
+
+    /* If the memory allocation has failed, print the error message, deallocate
+     * memory and exit with a non-zero value. */
+    if (!(m && table && key && sorted && E && Q && S))
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Deallocate memory. */
+        free(m);
+        m = (size_t*)(NULL);
+        free(table);
+        table = (table_t*)(NULL);
+        free(key);
+        key = (real_t*)(NULL);
+        free(sorted);
+        sorted = (real_t*)(NULL);
+        free(E);
+        E = (real_t*)(NULL);
+        free(Q);
+        Q = (size_t*)(NULL);
+        free(S);
+        S = (unsigned char*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the arrays to zeros. */
+    memset(m, 0, k * sizeof *m);
+    memset(table, 0, k * sizeof *table);
+    memset(key, 0, n_f * sizeof *key);
+    memset(sorted, 0, n_f * sizeof *sorted);
+    memset(E, 0, B * sizeof *E);
+    memset(Q, 0, B * SPLIT_SETS * sizeof *Q);
+    memset(S, 0, n_f * sizeof *S);
+
+    /* Scan the numbers of values of the columns and find the length of the
+     * longest path. */
+    for (j = 0U; j < k; ++j)
+    {
+        *(m + j) = (size_t)atoi(*(argv + SPLIT_ARGUMENTS + 1U + (j << 1U)));
+        if (!*(m + j))
+            success = false;
+        w += *(m + j);
+        for (s = 0U; s < SPLIT_SETS; ++s)
+            if (
+                strlen(*(argv + 10U + s)) +
+                    strlen(*(argv + SPLIT_ARGUMENTS + 2U + (j << 1U))) >
+                length
+            )
+                length =
+                    strlen(*(argv + 10U + s)) +
+                    strlen(*(argv + SPLIT_ARGUMENTS + 2U + (j << 1U)));
+    }
+    if (strlen(*(argv + 9U)) + 64U > length)
+        length = strlen(*(argv + 9U)) + 64U;
+    err_msg = err_msg_nv;
+
+    /* Allocate memory for the row and the path. */
+    if (success)
+    {
+        row = (real_t*)malloc(w * sizeof *row);
+        W = (real_t*)malloc(w * sizeof *W);
+        path = (char*)malloc((length + 2U) * sizeof *path);
+        success = (row && W && path) ? true : false;
+        err_msg = err_msg_mem;
+        if (success)
+        {
+            memset(row, 0, w * sizeof *row);
+            memset(W, 0, w * sizeof *W);
+            memset(path, 0, (length + 2U) * sizeof *path);
+        }
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    /* Read the eigenvalues from the first column and compute the keys of the
+     * families. */
+    if (success)
+    {
+        success = table_open(table, *(argv + SPLIT_ARGUMENTS + 2U), false);
+        err_msg = err_msg_in;
+    }
+    if (success)
+    {
+        for (i = 0U; success && i < N; ++i)
+        {
+            success = (table_scan(table, *m, row) == *m);
+            if (!success)
+                err_msg = err_msg_rv;
+            else if (logarithm && !(*row > 0.0))
+            {
+                success = false;
+                err_msg = err_msg_ev;
+            }
+            else
+                *(key + i / F) += logarithm ? rlog(*row) : *row;
+        }
+        table_close(table);
+    }
+
+    /* Compute the bins of the families and assign the families of each bin to
+     * the sets. */
+    if (success)
+    {
+        for (i = 0U; i < n_f; ++i)
+        {
+            *(key + i) /= (real_t)((i + 1U < n_f) ? F : N - i * F);
+            *(sorted + i) = *(key + i);
+        }
+        split_edges(n_f, sorted, B, E);
+        for (i = 0U; i < n_f; ++i)
+            ++*(Q + split_bin(B, E, *(key + i)) * SPLIT_SETS);
+        for (b = 0U; b < B; ++b)
+            split_quotas(*(Q + b * SPLIT_SETS), p, C, Q + b * SPLIT_SETS);
+        for (i = 0U; i < n_f; ++i)
+        {
+            s = split_choose(&R, Q + split_bin(B, E, *(key + i)) * SPLIT_SETS);
+            *(S + i) = (unsigned char)s;
+            ++*(families + s);
+            *(rows + s) += (i + 1U < n_f) ? F : N - i * F;
+        }
+    }
+
+    /* Count the buckets and allocate memory for them. */
+    if (success)
+    {
+        for (s = 0U; s < SPLIT_SETS; ++s)
+        {
+            *(first + s) = K_all;
+            *(K + s) = ((*(rows + s) << 1U) + M - 1U) / M;
+            K_all += *(K + s);
+        }
+        bucket = (FILE**)malloc(K_all * sizeof *bucket);
+        count = (size_t*)malloc(K_all * sizeof *count);
+        success = (bucket && count) ? true : false;
+        err_msg = err_msg_mem;
+        if (success)
+        {
+            for (b = 0U; b < K_all; ++b)
+                *(bucket + b) = (FILE*)(NULL);
+            memset(count, 0, K_all * sizeof *count);
+        }
+    }
+
+    /* Open the buckets. */
+    if (success)
+    {
+        for (s = 0U; success && s < SPLIT_SETS; ++s)
+            for (b = 0U; success && b < *(K + s); ++b)
+            {
+                sprintf(
+                    path,
+                    format_tmp,
+                    *(argv + 9U),
+                    (unsigned long)s,
+                    (unsigned long)b
+                );
+                *(bucket + *(first + s) + b) = fopen(path, "w+b");
+                success = *(bucket + *(first + s) + b) ? true : false;
+            }
+        err_msg = err_msg_tmp;
+    }
+
+    /* Open the input files. */
+    if (success)
+    {
+        for (j = 0U; success && j < k; ++j)
+        {
+            success =
+                table_open(
+                    table + j,
+                    *(argv + SPLIT_ARGUMENTS + 2U + (j << 1U)),
+                    false
+                );
+            if (!success)
+                while (j--)
+                    table_close(table + j);
+        }
+        err_msg = err_msg_in;
+    }
+
+    /* Read the rows of all columns and append each of them to a random bucket
+     * of its set. */
+    if (success)
+    {
+        for (i = 0U; success && i < N; ++i)
+        {
+            for (j = 0U, o = 0U; success && j < k; o += *(m + j++))
+                success =
+                    (table_scan(table + j, *(m + j), row + o) == *(m + j));
+            if (!success)
+            {
+                err_msg = err_msg_rv;
+                break;
+            }
+            s = (size_t)(*(S + i / F));
+            b = *(first + s) + split_uniform(&R, *(K + s));
+            success = (fwrite(row, sizeof *row, w, *(bucket + b)) == w);
+            ++*(count + b);
+            if (!success)
+                err_msg = err_msg_tmp;
+        }
+        for (j = 0U; j < k; ++j)
+            table_close(table + j);
+    }
+
+    /* Allocate memory for the largest bucket. */
+    if (success)
+    {
+        for (b = 0U; b < K_all; ++b)
+            if (*(count + b) > largest)
+                largest = *(count + b);
+        X = (real_t*)malloc((largest ? largest : 1U) * w * sizeof *X);
+        success = X ? true : false;
+        err_msg = err_msg_mem;
+    }
+
+    /* Shuffle the buckets of each set and dump them to the output files. */
+    for (s = 0U; success && s < SPLIT_SETS; ++s)
+    {
+        /* Open the output files of the set. */
+        for (j = 0U; success && j < k; ++j)
+        {
+            sprintf(
+                path,
+                format_path,
+                *(argv + 10U + s),
+                strrchr(*(argv + SPLIT_ARGUMENTS + 2U + (j << 1U)), '/') ?
+                    strrchr(*(argv + SPLIT_ARGUMENTS + 2U + (j << 1U)), '/') +
+                        1 :
+                    *(argv + SPLIT_ARGUMENTS + 2U + (j << 1U))
+            );
+            success = table_open(table + j, path, true);
+            if (!success)
+                while (j--)
+                    table_close(table + j);
+        }
+        err_msg = err_msg_out;
+        if (!success)
+            break;
+
+        /* Read, shuffle and dump the buckets. */
+        for (b = *(first + s); success && b < *(first + s) + *(K + s); ++b)
+        {
+            rewind(*(bucket + b));
+            success =
+                (
+                    fread(X, sizeof *X, *(count + b) * w, *(bucket + b)) ==
+                        *(count + b) * w
+                );
+            if (!success)
+            {
+                err_msg = err_msg_tmp;
+                break;
+            }
+            split_shuffle(&R, *(count + b), w, X, W);
+            for (i = 0U; i < *(count + b); ++i)
+                for (j = 0U, o = 0U; j < k; o += *(m + j++))
+                    table_dump(table + j, *(m + j), X + i * w + o, 1U);
+        }
+
+        /* Close the output files of the set. */
+        for (j = 0U; j < k; ++j)
+            table_close(table + j);
+    }
+
+    /* Get the current time. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    /* Close and remove the buckets. */
+    if (bucket)
+        for (s = 0U; s < SPLIT_SETS; ++s)
+            for (b = 0U; b < *(K + s); ++b)
+                if (*(bucket + *(first + s) + b))
+                {
+                    fclose(*(bucket + *(first + s) + b));
+                    *(bucket + *(first + s) + b) = (FILE*)(NULL);
+                    sprintf(
+                        path,
+                        format_tmp,
+                        *(argv + 9U),
+                        (unsigned long)s,
+                        (unsigned long)b
+                    );
+                    remove(path);
+                }
+
+    /* Print the sizes of the sets and the time elapsed. */
+    if (success)
+    {
+        for (s = 0U; s < SPLIT_SETS; ++s)
+            printf(
+                format_set,
+                *(names + s),
+                (unsigned long)(*(families + s)),
+                (unsigned long)(*(rows + s))
+            );
+        printf(
+            format_time,
+            (double)(t1.tv_sec - t0.tv_sec) +
+                1.0e-9 * (double)(t1.tv_nsec - t0.tv_nsec)
+        );
+    }
+
+    /* If anything has failed, print the error message. */
+    else
+        fprintf(stderr, format_err_msg, err_msg);
+
+    /* Deallocate memory. */
+    if (X)
+        memset(X, 0, (largest ? largest : 1U) * w * sizeof *X);
+    free(X);
+    X = (real_t*)(NULL);
+    if (row)
+        memset(row, 0, w * sizeof *row);
+    free(row);
+    row = (real_t*)(NULL);
+    if (W)
+        memset(W, 0, w * sizeof *W);
+    free(W);
+    W = (real_t*)(NULL);
+    free(path);
+    path = (char*)(NULL);
+    free(bucket);
+    bucket = (FILE**)(NULL);
+    free(count);
+    count = (size_t*)(NULL);
+    memset(m, 0, k * sizeof *m);
+    free(m);
+    m = (size_t*)(NULL);
+    memset(table, 0, k * sizeof *table);
+    free(table);
+    table = (table_t*)(NULL);
+    memset(key, 0, n_f * sizeof *key);
+    free(key);
+    key = (real_t*)(NULL);
+    memset(sorted, 0, n_f * sizeof *sorted);
+    free(sorted);
+    sorted = (real_t*)(NULL);
+    memset(E, 0, B * sizeof *E);
+    free(E);
+    E = (real_t*)(NULL);
+    memset(Q, 0, B * SPLIT_SETS * sizeof *Q);
+    free(Q);
+    Q = (size_t*)(NULL);
+    memset(S, 0, n_f * sizeof *S);
+    free(S);
+    S = (unsigned char*)(NULL);
+
+    /* Return a zero value (exit with a zero value) on success. */
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
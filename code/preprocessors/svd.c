@@ -37,12 +37,19 @@
  * The pogram prints to the console the time elapsed only during the computation
  * of the singular values.  Time needed to read and print is not measured.
  *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single polygon per row instead of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -61,6 +68,7 @@
 #include "boolean.h"
 #include "numeric.h"
 #include "polygon.h"
+#include "table.h"
 
 int main (int argc, char** argv)
 {
@@ -99,15 +107,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the input file to open. */
-    const char* const file_in_open_mode = "rt";
-
-    /* Mode of the output file to open. */
-    const char* const file_out_open_mode = "wt";
-
-    /* Format string for reading the numbers. */
-    const char* const format_input = " %lf";
-
     /* Format string for printing the time elapsed. */
     const char* const format_time = "Time elapsed: %.6f s.\n";
 
@@ -143,7 +142,7 @@ int main (int argc, char** argv)
     int info;
 
     /* Input/output file. */
-    FILE* inout;
+    table_t inout;
 
     /* Iteration indices. */
     size_t i;
@@ -181,7 +180,7 @@ int main (int argc, char** argv)
     info = 0;
 
     /* Input/output file. */
-    inout = (FILE*)(NULL);
+    memset(&inout, 0, sizeof inout);
 
     /* Iteration indices. */
     i = 0U;
@@ -350,12 +349,9 @@ int main (int argc, char** argv)
     /* Initialise the auxiliary matrix to zeros. */
     memset(A, 0, ((n * ld_A) << 1U) * sizeof *A);
 
-    /* Open the input file. */
-    inout = fopen(*(argv + 1U), file_in_open_mode);
-
-    /* If the input file could not be opened, print the error message,
+    /* Open the input file.  If it could not be opened, print the error message,
      * deallocate memory and exit with a non-zero value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 1U), false))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_in);
@@ -399,14 +395,13 @@ int main (int argc, char** argv)
          * error message, close the input file, deallocate memory and exit with
          * a non-zero value. */
         for (j = 0U; (j >> 1U) < n; ++j)
-            if (!(fscanf(inout, format_input, l + ((i * n) << 1U) + j) == 1))
+            if (!(table_scan(&inout, 1U, l + ((i * n) << 1U) + j) == 1U))
             {
                 /* Print the error message. */
                 fprintf(stderr, format_err_msg, err_msg_rn);
 
                 /* Close the input file. */
-                fclose(inout);
-                inout = (FILE*)(NULL);
+                table_close(&inout);
 
                 /* Clear the memory in the auxiliary matrix. */
                 memset(A, 0, ((n * ld_A) << 1U) * sizeof *A);
@@ -441,8 +436,7 @@ int main (int argc, char** argv)
     }
 
     /* Close the input file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
 
     /* Get the current clock ticks. */
     t0 = clock();
@@ -487,13 +481,10 @@ int main (int argc, char** argv)
     /* Print the time elapsed during the description of polygons. */
     printf(format_time, (double)(t1 - t0) / clocks_per_sec);
 
-    /* Open the output file. */
-    inout = fopen(*(argv + 4U), file_out_open_mode);
-
-    /* If the output file could not be opened, print the error message,
-     * close the input file, deallocate memory and exit with a non-zero
+    /* Open the output file.  If it could not be opened, print the error
+     * message, close the input file, deallocate memory and exit with a non-zero
      * value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 4U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
@@ -532,11 +523,10 @@ int main (int argc, char** argv)
     /* Dump the singular values to the output file.  Note that all polygons have
      * exactly 2 * `n` singular values stored in the array `s_l`, so the
      * `dump_polygons` function can be used to dump the singular values. */
-    dump_polygons(inout, n, s_l, N);
+    table_dump_polygons(&inout, n, s_l, N);
 
     /* Close the output file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
 
     /* Clear the memory in the auxiliary matrix. */
     memset(A, 0, ((n * ld_A) << 1U) * sizeof *A);
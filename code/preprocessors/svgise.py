@@ -32,6 +32,9 @@ each SVG file is [-0.6, 0.6] x [-0.6, 0.6] px2.
 The pogram prints to the console the time elapsed only during the generation of
 SVG images.  Time needed to read is not measured.
 
+To rasterise polygons directly into a single NumPy array without generating
+images one by one, use "rasteriser.c" instead.
+
 The code was inspired by ewcz's answer on
 https://stackoverflow.com/questions/49147707/how-can-i-convert-a-shapely-polygon-to-an-svg.
 
@@ -31,12 +31,19 @@
  * The pogram prints to the console the time elapsed only during the computation
  * of the information.  Time needed to read and print is not measured.
  *
+ * If the path to the input or to the output file ends with ".npy" or ".pcz",
+ * the file is read or dumped as a NumPy array or as a compressed table with a
+ * single polygon per row instead of a text file (see "table.h").
+ *
  * @author Davor Penzar <davor.penzar@gmail.com>
  * @version 1.0
  * @package polygon
  *
  */
 
+/* Compile with POSIX functions (`mmap`, see "npy.h"). */
+#define _POSIX_C_SOURCE 200112L
+
 /* Compile with mathematical constants from "math.h". */
 #define _USE_MATH_DEFINES   1
 
@@ -53,6 +60,8 @@
 #include "numeric.h"
 #include "polygon.h"
 #include "triangle.h"
+#include "batch.h"
+#include "table.h"
 
 int main (int argc, char** argv)
 {
@@ -88,15 +97,6 @@ int main (int argc, char** argv)
     /* Format string for printing error messages. */
     const char* const format_err_msg = "%s\n";
 
-    /* Mode of the input file to open. */
-    const char* const file_in_open_mode = "rt";
-
-    /* Mode of the output file to open. */
-    const char* const file_out_open_mode = "wt";
-
-    /* Format string for reading the numbers. */
-    const char* const format_input = " %lf";
-
     /* Format string for printing the time elapsed. */
     const char* const format_time = "Time elapsed: %.6f s.\n";
 
@@ -116,8 +116,12 @@ int main (int argc, char** argv)
     /* Array of characteristic points of triangles. */
     real_t* C;
 
+    /* Batch of the lengths of edges, the outer angles and the characteristic
+     * points of triangles. */
+    real_t* S;
+
     /* Input/output file. */
-    FILE* inout;
+    table_t inout;
 
     /* Iteration indices. */
     size_t i;
@@ -139,8 +143,12 @@ int main (int argc, char** argv)
     /* Array of characteristic points of triangles. */
     C = (real_t*)(NULL);
 
+    /* Batch of the lengths of edges, the outer angles and the characteristic
+     * points of triangles. */
+    S = (real_t*)(NULL);
+
     /* Input/output file. */
-    inout = (FILE*)(NULL);
+    memset(&inout, 0, sizeof inout);
 
     /* Iteration indices. */
     i = 0U;
@@ -251,16 +259,56 @@ int main (int argc, char** argv)
     /* Initialise coordinates of characteristic points of triangles to zeros. */
     memset(C, 0, (N << 1U) * sizeof *C);
 
-    /* Open the input file. */
-    inout = fopen(*(argv + 1U), file_in_open_mode);
+    /* Allocate memory for the batch. */
+    S = (real_t*)malloc((N << 3U) * sizeof *S);
+
+    /* If the memory allocation has failed, deallocate memory, print the error
+     * message and exit with a non-zero value. */
+    if (!S)
+    {
+        /* Print the error message. */
+        fprintf(stderr, format_err_msg, err_msg_mem);
+
+        /* Clear the memory in the array of characteristic points of
+         * triangles. */
+        memset(C, 0, (N << 1U) * sizeof *C);
+
+        /* Deallocate memory for the array of characteristic points of
+         * triangles. */
+        free(C);
+        C = (real_t*)(NULL);
+
+        /* Clear the memory in the arrays of the lengths of edges and the outer
+         * angles. */
+        memset(l, 0, ((3U * N) << 1U) * sizeof *l);
+
+        /* Deallocate memory for the arrays of the lengths of edges and the
+         * outer angles. */
+        free(l);
+        l = (real_t*)(NULL);
+        phi = (real_t*)(NULL);
+
+        /* Exit with a non-zero value. */
+        exit(EXIT_FAILURE);
+    }
+
+    /* Initialise the batch to zeros. */
+    memset(S, 0, (N << 3U) * sizeof *S);
 
-    /* If the input file could not be opened, print the error message,
+    /* Open the input file.  If it could not be opened, print the error message,
      * deallocate memory and exit with a non-zero value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 1U), false))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_in);
 
+        /* Clear the memory in the batch. */
+        memset(S, 0, (N << 3U) * sizeof *S);
+
+        /* Deallocate memory for the batch. */
+        free(S);
+        S = (real_t*)(NULL);
+
         /* Clear the memory in the array of characteristic points of
          * triangles. */
         memset(C, 0, (N << 1U) * sizeof *C);
@@ -292,14 +340,20 @@ int main (int argc, char** argv)
          * error message, close the input file, deallocate memory and exit with
          * a non-zero value. */
         for (j = 0U; (j >> 1U) < 3U; ++j)
-            if (!(fscanf(inout, format_input, l + ((3U * i) << 1U) + j) == 1))
+            if (!(table_scan(&inout, 1U, l + ((3U * i) << 1U) + j) == 1U))
             {
                 /* Print the error message. */
                 fprintf(stderr, format_err_msg, err_msg_rn);
 
                 /* Close the input file. */
-                fclose(inout);
-                inout = (FILE*)(NULL);
+                table_close(&inout);
+
+                /* Clear the memory in the batch. */
+                memset(S, 0, (N << 3U) * sizeof *S);
+
+                /* Deallocate memory for the batch. */
+                free(S);
+                S = (real_t*)(NULL);
 
                 /* Clear the memory in the array of characteristic points of
                  * triangles. */
@@ -326,21 +380,20 @@ int main (int argc, char** argv)
     }
 
     /* Close the input file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
 
     /* Get the current clock ticks. */
     t0 = clock();
 
+    /* Transpose the lengths of edges and the outer angles into the batch. */
+    batch_transpose(3U, N, l, 6U, S);
+    batch_transpose(3U, N, phi, 6U, S + 3U * N);
+
     /* Characterise all triangles. */
-    for (i = 0U; i < N; ++i)
-        char_triangle(
-            l + ((3U * i) << 1U),
-            phi + ((3U * i) << 1U),
-            C + (i << 1U),
-            C + (i << 1U) + 1U,
-            true
-        );
+    batch_char_triangle(N, S, S + 3U * N, S + 6U * N, S + 7U * N, true);
+
+    /* Transpose the characteristic points from the batch. */
+    batch_untranspose(2U, N, S + 6U * N, C, 2U);
 
     /* Get the current clock ticks. */
     t1 = clock();
@@ -348,17 +401,21 @@ int main (int argc, char** argv)
     /* Print the time elapsed during the description of polygons. */
     printf(format_time, (double)(t1 - t0) / clocks_per_sec);
 
-    /* Open the output file. */
-    inout = fopen(*(argv + 3U), file_out_open_mode);
-
-    /* If the output file could not be opened, print the error message,
-     * close the input file, deallocate memory and exit with a non-zero
+    /* Open the output file.  If it could not be opened, print the error
+     * message, close the input file, deallocate memory and exit with a non-zero
      * value. */
-    if (!inout)
+    if (!table_open(&inout, *(argv + 3U), true))
     {
         /* Print the error message. */
         fprintf(stderr, format_err_msg, err_msg_out);
 
+        /* Clear the memory in the batch. */
+        memset(S, 0, (N << 3U) * sizeof *S);
+
+        /* Deallocate memory for the batch. */
+        free(S);
+        S = (real_t*)(NULL);
+
         /* Clear the memory in the array of characteristic points of
          * triangles. */
         memset(C, 0, (N << 1U) * sizeof *C);
@@ -386,11 +443,17 @@ int main (int argc, char** argv)
      * have exactly 2 coordinates stored in the array `C`, so the
      * `dump_polygons` function can be used to dump the characteristic
      * points. */
-    dump_polygons(inout, 1U, C, N);
+    table_dump_polygons(&inout, 1U, C, N);
 
     /* Close the output file. */
-    fclose(inout);
-    inout = (FILE*)(NULL);
+    table_close(&inout);
+
+    /* Clear the memory in the batch. */
+    memset(S, 0, (N << 3U) * sizeof *S);
+
+    /* Deallocate memory for the batch. */
+    free(S);
+    S = (real_t*)(NULL);
 
     /* Clear the memory in the array of characteristic points of triangles. */
     memset(C, 0, (N << 1U) * sizeof *C);
@@ -0,0 +1,628 @@
+# -*- coding: utf-8 -*-
+
+"""
+Mergeable sketches of the statistics of tables computed while they are written.
+
+The mean and the standard deviation of the features (such as
+"models/neural_network_features_mean.npy" and
+"models/neural_network_features_std.npy") and the 5 % quantiles of the
+eigenvalues (such as "data/arrays/l_quantiles.npy" and
+"data/arrays/l_log10_quantiles.npy") are computed from sketches of the rows
+instead of from whole tables.  A sketch of a table is the number of its rows,
+the mean and the sum of squared deviations from the mean of each column
+(updated block by block by the parallel version of Welford's algorithm) and a
+KLL sketch of the values of some of its columns, from which any quantile is
+estimated with a small error in rank.  Sketches of different parts of a table
+(for instance, of the shards of a stage of a pipeline, computed by different
+threads, see "pipeline.py") are merged into the sketch of the whole table, so
+the statistics of a multi-gigabyte table are obtained without reading it
+again.  Rows with a non-finite value (such as a NaN eigenvalue of a failed
+solve) are counted but not sketched.  A KLL sketch of a table of fewer rows
+than its capacity `k` holds all the values, so its quantiles are exact.
+
+The quantiles of the logarithms of the values are the logarithms of the
+quantiles of the values (the logarithm is increasing), so a single KLL sketch
+of a column yields both.
+
+Sketches are stored as compressed NumPy archives (".npz" files).
+
+Usage:
+    $ python sketch.py in [in ...] [--columns c [c ...]] [--mean mean] \
+          [--std std] [--column column] [--step step] \
+          [--quantiles quantiles] [--log10-quantiles log10_quantiles]
+where:
+    in                is the path to a stored sketch (all of them are merged),
+    --columns         are the indices of the columns of the mean and the
+                      standard deviation (default is all columns),
+    --mean            is the path to the output file of the mean,
+    --std             is the path to the output file of the standard deviation,
+    --column          is the index of the column of the quantiles (default is
+                      0),
+    --step            is the step of the quantiles (default is 0.05),
+    --quantiles       is the path to the output file of the quantiles,
+    --log10-quantiles is the path to the output file of the quantiles of the
+                      logarithms (to the base 10) of the values.
+All output files are NumPy arrays.
+
+Example:
+    >>> s = Sketch(1, [0])
+    >>> s.update(np.loadtxt('data/numerical/test/eigenvalues.tsv', ndmin = 2))
+    >>> s.quantiles(0, np.linspace(0.0, 1.0, 21))
+
+This file is part of Davor Penzar's master thesis programing.
+
+"""
+
+# Import standard library.
+import argparse as _argparse
+import os as _os
+import tempfile as _tempfile
+
+# Import SciPy packages.
+import numpy as _np
+
+# Import package modules.
+from pcz import read_pcz as _read_pcz
+
+# Define the extensions of text tables.
+TEXT_EXTENSIONS = ('', '.tsv', '.txt', '.csv', '.dat')
+
+# Define the class of KLL sketches.
+class Quantiles (object):
+    """
+    KLL sketch of the quantiles of a stream of values.
+
+    Values are kept in compactors of increasing levels;  a value at the level
+    h stands for 2^h values of the stream.  When the values kept exceed the
+    capacity of the sketch, the lowest full compactor is sorted and every
+    second of its values (starting from the first or the second one at random)
+    is moved to the next level.  The capacity of the level h of a sketch of H
+    levels is about k (2 / 3)^(H - 1 - h), so the sketch keeps O(k) values and
+    the error in the rank of an estimated quantile is O(n / k) for a stream of
+    n values.
+
+    Parameters
+    ==========
+    k : int, optional
+        Capacity of the highest level (default is 2048).
+
+    seed : int, optional
+        Seed of the generator of the random offsets (default is 0).
+
+    """
+
+    def __init__ (self, k = 2048, seed = 0):
+        # Sanitise the parameters.
+        k = int(k)
+        if not (k >= 8):
+            raise ValueError('Parameter `k` must be at least 8.')
+
+        # Set the attributes.
+        self.k = k
+        self.n = 0
+        self.minimum = _np.inf
+        self.maximum = -_np.inf
+        self.levels = [_np.zeros((0, ), dtype = float)]
+        self._random = _np.random.RandomState(int(seed))
+
+    def _capacity (self, h):
+        """
+        Compute the capacity of a level.
+
+        """
+
+        return max(
+            2,
+            int(_np.ceil(self.k * (2.0 / 3.0) ** (len(self.levels) - 1 - h)))
+        )
+
+    def _compress (self):
+        """
+        Compact the levels until the values kept fit the capacity.
+
+        """
+
+        while sum(l.size for l in self.levels) > sum(
+            self._capacity(h) for h in range(len(self.levels))
+        ):
+            # Find the lowest full level.
+            h = 0
+            while self.levels[h].size < self._capacity(h):
+                h += 1
+            if h + 1 == len(self.levels):
+                self.levels.append(_np.zeros((0, ), dtype = float))
+
+            # Move every second of its (sorted) values to the next level and
+            # keep the last value if their number is odd.
+            l = _np.sort(self.levels[h])
+            m = l.size & ~1
+            self.levels[h + 1] = _np.concatenate(
+                [self.levels[h + 1], l[self._random.randint(2):m:2]]
+            )
+            self.levels[h] = l[m:]
+
+    def update (self, x):
+        """
+        Add values to the sketch.
+
+        Parameters
+        ==========
+        x : array_like
+            Values (the array is flattened).  NaN values are ignored.
+
+        """
+
+        x = _np.asarray(x, dtype = float).ravel()
+        x = x[~_np.isnan(x)]
+        if not x.size:
+            return
+        self.n += int(x.size)
+        self.minimum = min(self.minimum, float(_np.min(x)))
+        self.maximum = max(self.maximum, float(_np.max(x)))
+        self.levels[0] = _np.concatenate([self.levels[0], x])
+        self._compress()
+
+    def merge (self, other):
+        """
+        Merge another sketch into the sketch.
+
+        The result is a sketch of the values of both sketches (of the capacity
+        of the sketch).
+
+        Parameters
+        ==========
+        other : Quantiles
+            Sketch to merge.
+
+        """
+
+        if not other.n:
+            return
+        self.n += other.n
+        self.minimum = min(self.minimum, other.minimum)
+        self.maximum = max(self.maximum, other.maximum)
+        while len(self.levels) < len(other.levels):
+            self.levels.append(_np.zeros((0, ), dtype = float))
+        for h, l in enumerate(other.levels):
+            self.levels[h] = _np.concatenate([self.levels[h], l])
+        self._compress()
+
+    def quantiles (self, q):
+        """
+        Estimate the quantiles of the values.
+
+        The values kept are placed at the middles of the ranges of ranks they
+        stand for and the quantiles are interpolated linearly between them as
+        by the function `numpy.quantile`, with the exact minimum and maximum at
+        the ranks 0 and n - 1.  While no level has been compacted, the
+        quantiles are the same as the quantiles computed by the function
+        `numpy.quantile`.
+
+        Parameters
+        ==========
+        q : array_like
+            Probabilities (in the interval [0, 1]).
+
+        Returns
+        =======
+        ndarray
+            Estimated quantiles (NaN if the sketch is empty).
+
+        """
+
+        q = _np.asarray(q, dtype = float)
+        if not self.n:
+            return _np.full(q.shape, _np.nan)
+
+        # Sort the values kept by their values and compute their ranks.
+        x = _np.concatenate(self.levels)
+        w = _np.concatenate(
+            [_np.full(l.size, 2.0 ** h) for h, l in enumerate(self.levels)]
+        )
+        I = _np.argsort(x, kind = 'mergesort')
+        x = x[I]
+        w = w[I]
+        r = _np.cumsum(w) - 0.5 * (w + 1.0)
+
+        # Pin the minimum and the maximum.
+        x = _np.concatenate([[self.minimum], x, [self.maximum]])
+        r = _np.clip(
+            _np.concatenate([[0.0], r, [self.n - 1.0]]),
+            0.0,
+            self.n - 1.0
+        )
+
+        return _np.interp(q * (self.n - 1.0), r, x)
+
+# Define the class of sketches of tables.
+class Sketch (object):
+    """
+    Sketch of the rows of a table.
+
+    Parameters
+    ==========
+    m : int
+        Number of columns (0 for a sketch of an empty table of an unknown
+        number of columns).
+
+    columns : list of int, optional
+        Indices of the columns whose quantiles are sketched (default is none).
+
+    k : int, optional
+        Capacity of the KLL sketches (default is 2048).
+
+    Rows with a non-finite value (such as the NaN eigenvalue of a failed
+    solve) are not sketched; they are only counted by the attribute
+    `invalid`, so the moments and the quantiles are sketched from the same
+    rows.
+
+    """
+
+    def __init__ (self, m, columns = None, k = 2048):
+        # Set the attributes.
+        self.m = int(m)
+        self.n = 0
+        self.invalid = 0
+        self.mean = _np.zeros((self.m, ), dtype = float)
+        self.M2 = _np.zeros((self.m, ), dtype = float)
+        self.columns = [] if columns is None else [int(c) for c in columns]
+        self.sketches = [Quantiles(k, c) for c in self.columns]
+        if self.m and not all(0 <= c < self.m for c in self.columns):
+            raise IndexError('Columns of the quantiles are out of range.')
+
+    def _combine (self, n, mean, M2):
+        """
+        Combine the moments of another set of rows into the sketch.
+
+        """
+
+        if not n:
+            return
+        N = self.n + n
+        delta = mean - self.mean
+        self.mean = self.mean + delta * (float(n) / N)
+        self.M2 = self.M2 + M2 + delta * delta * (float(self.n) * n / N)
+        self.n = N
+
+    def update (self, X):
+        """
+        Add a block of rows to the sketch.
+
+        Parameters
+        ==========
+        X : array_like
+            Rows of the table (an array of shape (n, m)).
+
+        """
+
+        X = _np.asarray(X, dtype = float).reshape((-1, self.m))
+        finite = _np.all(_np.isfinite(X), axis = 1)
+        self.invalid += int(X.shape[0] - _np.count_nonzero(finite))
+        X = X[finite]
+        if not X.shape[0]:
+            return
+        mean = _np.mean(X, axis = 0)
+        self._combine(
+            X.shape[0],
+            mean,
+            _np.sum((X - mean) ** 2, axis = 0)
+        )
+        for c, s in zip(self.columns, self.sketches):
+            s.update(X[:, c])
+
+    def merge (self, other):
+        """
+        Merge another sketch of the same columns into the sketch.
+
+        Parameters
+        ==========
+        other : Sketch
+            Sketch to merge.
+
+        Raises
+        ======
+        ValueError
+            The sketches are not sketches of the same columns.
+
+        """
+
+        if not (other.m == self.m and other.columns == self.columns):
+            raise ValueError('Sketches must be sketches of the same columns.')
+        self._combine(other.n, other.mean, other.M2)
+        self.invalid += other.invalid
+        for s, t in zip(self.sketches, other.sketches):
+            s.merge(t)
+
+    def std (self, ddof = 1):
+        """
+        Compute the standard deviation of the columns.
+
+        As in the notebook "Models.ipynb", the standard deviation of a constant
+        column is replaced by 1 so that the column can be standardised.
+
+        Parameters
+        ==========
+        ddof : int, optional
+            Delta degrees of freedom (default is 1).
+
+        Returns
+        =======
+        ndarray
+            Standard deviation of each column.
+
+        """
+
+        std = _np.sqrt(self.M2 / max(self.n - ddof, 1))
+        std[_np.isclose(1.0, 1.0 + std)] = 1.0
+
+        return std
+
+    def quantiles (self, column, q):
+        """
+        Estimate the quantiles of a column.
+
+        Parameters
+        ==========
+        column : int
+            Index of the column (one of the columns whose quantiles are
+            sketched).
+
+        q : array_like
+            Probabilities (in the interval [0, 1]).
+
+        Returns
+        =======
+        ndarray
+            Estimated quantiles.
+
+        """
+
+        return self.sketches[self.columns.index(int(column))].quantiles(q)
+
+    def save (self, path):
+        """
+        Save the sketch atomically as a compressed NumPy archive.
+
+        Parameters
+        ==========
+        path : str
+            Path to the output file (ending with ".npz").
+
+        """
+
+        arrays = {
+            'moments': _np.concatenate([[self.m, self.n], self.mean, self.M2]),
+            'columns': _np.array(self.columns, dtype = int),
+            'invalid': _np.array([self.invalid], dtype = int)
+        }
+        for i, s in enumerate(self.sketches):
+            arrays['quantiles_{0:d}'.format(i)] = _np.concatenate(
+                [[s.k, s.n, s.minimum, s.maximum, len(s.levels)]] +
+                    [[l.size for l in s.levels]] + s.levels
+            )
+        fd, temporary = _tempfile.mkstemp(
+            suffix = '.tmp.npz',
+            prefix = '.' + _os.path.basename(path) + '.',
+            dir = _os.path.dirname(path) or '.'
+        )
+        with _os.fdopen(fd, 'wb') as f:
+            _np.savez_compressed(f, **arrays)
+        _os.rename(temporary, path)
+
+    @classmethod
+    def load (cls, path):
+        """
+        Load a sketch saved by the method `save`.
+
+        Parameters
+        ==========
+        path : str
+            Path to the stored sketch.
+
+        Returns
+        =======
+        Sketch
+            Loaded sketch.
+
+        """
+
+        with _np.load(path) as f:
+            moments = f['moments']
+            m = int(moments[0])
+            sketch = cls(m, f['columns'].tolist())
+            sketch.n = int(moments[1])
+            sketch.mean = moments[2:2 + m].copy()
+            sketch.M2 = moments[2 + m:2 + 2 * m].copy()
+            if 'invalid' in f.files:
+                sketch.invalid = int(f['invalid'][0])
+            for i, s in enumerate(sketch.sketches):
+                a = f['quantiles_{0:d}'.format(i)]
+                s.k, s.n = int(a[0]), int(a[1])
+                s.minimum, s.maximum = float(a[2]), float(a[3])
+                H = int(a[4])
+                sizes = a[5:5 + H].astype(int)
+                offsets = 5 + H + _np.concatenate([[0], _np.cumsum(sizes)])
+                s.levels = [
+                    a[offsets[h]:offsets[h + 1]].copy() for h in range(H)
+                ]
+
+        return sketch
+
+# Define the function to find the format of a table stored in a file.
+def table_format (path):
+    """
+    Find the format of a table stored in a file by its extension.
+
+    Parameters
+    ==========
+    path : str
+        Path to the table.
+
+    Returns
+    =======
+    str
+        Value "npy" for a NumPy array (a ".npy" file), "pcz" for a compressed
+        table (a ".pcz" file, see "include/codec.h") or "text" for a text file
+        of a row per line (a file of an extension in `TEXT_EXTENSIONS`).
+
+    Raises
+    ======
+    ValueError
+        The extension is not an extension of a table.
+
+    """
+
+    extension = _os.path.splitext(path)[1].lower()
+    if extension in ('.npy', '.pcz'):
+        return extension[1:]
+    if extension in TEXT_EXTENSIONS:
+        return 'text'
+
+    raise ValueError(
+        'Table `{0:s}` is neither a NumPy array, a compressed table nor a '
+        'text file.'.format(path)
+    )
+
+# Define the function to sketch a table.
+def sketch_table (path, columns = None, k = 2048):
+    """
+    Sketch a table stored in a file.
+
+    Parameters
+    ==========
+    path : str
+        Path to the table (see the function `table_format`).
+
+    columns : list of int, optional
+        Indices of the columns whose quantiles are sketched (default is none).
+
+    k : int, optional
+        Capacity of the KLL sketches (default is 2048).
+
+    Returns
+    =======
+    Sketch
+        Sketch of the rows of the table.
+
+    Raises
+    ======
+    ValueError
+        The file is not a table (see the function `table_format`).
+
+    """
+
+    # Load the table.
+    form = table_format(path)
+    if form == 'npy':
+        X = _np.load(path, mmap_mode = 'r')
+        X = X.reshape((X.shape[0], -1))
+    elif form == 'pcz':
+        X = _read_pcz(path)
+    else:
+        X = _np.loadtxt(path, dtype = float, ndmin = 2)
+
+    # Sketch the rows.
+    sketch = Sketch(X.shape[1] if X.shape[0] else 0, columns, k)
+    if X.shape[0]:
+        sketch.update(X)
+
+    return sketch
+
+# Define the function to merge sketches.
+def merge (sketches):
+    """
+    Merge sketches (of the same columns) into a single sketch.
+
+    Parameters
+    ==========
+    sketches : iterable
+        Sketches or paths to stored sketches.  Empty sketches of no columns (of
+        empty tables) are skipped.
+
+    Returns
+    =======
+    Sketch
+        Merged sketch (`None` if there are no nonempty sketches).
+
+    """
+
+    result = None
+    for sketch in sketches:
+        if not isinstance(sketch, Sketch):
+            sketch = Sketch.load(sketch)
+        if not sketch.n:
+            continue
+        if result is None:
+            result = sketch
+        else:
+            result.merge(sketch)
+
+    return result
+
+# Define the function to save statistics.
+def save (path, x):
+    """
+    Save an array atomically as a NumPy array.
+
+    """
+
+    temporary = path + '.tmp.npy'
+    _np.save(temporary, _np.asarray(x, dtype = float))
+    _os.rename(temporary, path)
+
+# Save the statistics of stored sketches from the command line.
+if __name__ == '__main__':
+    parser = _argparse.ArgumentParser(
+        description = 'Merge stored sketches and save their statistics.'
+    )
+    parser.add_argument('sketches', nargs = '+', help = 'stored sketches')
+    parser.add_argument(
+        '--columns',
+        type = int,
+        nargs = '+',
+        help = 'columns of the mean and the standard deviation'
+    )
+    parser.add_argument('--mean', help = 'output file of the mean')
+    parser.add_argument(
+        '--std',
+        help = 'output file of the standard deviation'
+    )
+    parser.add_argument(
+        '--column',
+        type = int,
+        default = 0,
+        help = 'column of the quantiles'
+    )
+    parser.add_argument(
+        '--step',
+        type = float,
+        default = 0.05,
+        help = 'step of the quantiles'
+    )
+    parser.add_argument('--quantiles', help = 'output file of the quantiles')
+    parser.add_argument(
+        '--log10-quantiles',
+        dest = 'log10_quantiles',
+        help = 'output file of the quantiles of the logarithms'
+    )
+    arguments = parser.parse_args()
+    sketch = merge(arguments.sketches)
+    if sketch is None:
+        raise ValueError('Sketches are empty.')
+    columns = (
+        list(range(sketch.m)) if arguments.columns is None
+            else arguments.columns
+    )
+    if arguments.mean is not None:
+        save(arguments.mean, sketch.mean[columns])
+    if arguments.std is not None:
+        save(arguments.std, sketch.std()[columns])
+    q = _np.linspace(0.0, 1.0, int(round(1.0 / arguments.step)) + 1)
+    if arguments.quantiles is not None:
+        save(arguments.quantiles, sketch.quantiles(arguments.column, q))
+    if arguments.log10_quantiles is not None:
+        save(
+            arguments.log10_quantiles,
+            _np.log10(sketch.quantiles(arguments.column, q))
+        )
+    print('Rows: {0:d} (invalid: {1:d}).'.format(sketch.n, sketch.invalid))
@@ -29,6 +29,9 @@ from pandas.api.types import is_numeric_dtype as _is_numeric_dtype
 from pandas.core.frame import DataFrame as _DataFrame
 from pandas.core.series import Series as _Series
 
+# Import package modules.
+from pcz import read_pcz
+
 # Define the function to read TSV dataframes of format in the master thesis
 # project.
 def read_tsv (
@@ -45,6 +48,17 @@ def read_tsv (
     function actually returns
         >>> pandas.read_csv(filepath_or_buffer, sep = "\t", header = 0 if header else None, index_col = 0 if index else None, dtype = str if as_str else float, **kwargs)
 
+    If the source is a path ending with ".npy" (a NumPy array dumped by the C
+    programs, see "include/table.h"), the array is mapped to memory by the
+    `numpy.load` function instead of parsing a text file and the function
+    returns
+        >>> pandas.DataFrame(numpy.load(filepath_or_buffer, mmap_mode = 'r'))
+    (converted to strings if `as_str` is true).  NumPy arrays have neither a
+    header nor an index, so parameters `header` and `index` are then ignored,
+    as well as additional keyword arguments.  Likewise, if the source is a path
+    ending with ".pcz" (a compressed table, see "include/codec.h"), the table
+    is read by the function `read_pcz`.
+
     Parameters
     ==========
     filepath_or_buffer
@@ -200,6 +214,24 @@ def read_tsv (
     except (TypeError, ValueError, AttributeError):
         raise TypeError('Parameter `as_str` must be of type `bool`.')
 
+    # Read the NumPy array and return it as a dataframe.
+    if (
+        isinstance(filepath_or_buffer, _six.string_types) and
+        filepath_or_buffer.endswith('.npy')
+    ):
+        df = _pd.DataFrame(_np.load(filepath_or_buffer, mmap_mode = 'r'))
+
+        return df.astype(str) if as_str else df
+
+    # Read the compressed table and return it as a dataframe.
+    if (
+        isinstance(filepath_or_buffer, _six.string_types) and
+        filepath_or_buffer.endswith('.pcz')
+    ):
+        df = _pd.DataFrame(read_pcz(filepath_or_buffer))
+
+        return df.astype(str) if as_str else df
+
     # Read the TSV and return the read dataframe.
     return _pd.read_csv(
         filepath_or_buffer,